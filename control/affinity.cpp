@@ -8,11 +8,26 @@
        @author Raffaele Solca
 
 */
-#ifndef MAGMA_NOAFFINITY
-
 #include "affinity.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#ifndef MAGMA_NOAFFINITY
+#include <dirent.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#else
+#include <thread>
+#endif
+
+#ifndef MAGMA_NOAFFINITY
 
 affinity_set::affinity_set()
 {
@@ -81,3 +96,383 @@ void affinity_set::print_set(int id, const char* s)
 }
 
 #endif  // MAGMA_NOAFFINITY
+
+
+// =============================================================================
+// Topology
+
+#ifndef MAGMA_NOAFFINITY
+
+// @return integer in file, or default_value if it can't be read.
+static int read_int( const char* path, int default_value )
+{
+    int value = default_value;
+    FILE* f = fopen( path, "r" );
+    if ( f != NULL ) {
+        if ( fscanf( f, "%d", &value ) != 1 ) {
+            value = default_value;
+        }
+        fclose( f );
+    }
+    return value;
+}
+
+// @return CPUs in a sysfs cpu list file, e.g., "0-3,8-11".
+static std::vector<int> read_cpulist( const char* path )
+{
+    std::vector<int> list;
+    FILE* f = fopen( path, "r" );
+    if ( f != NULL ) {
+        char buf[ 4096 ];
+        if ( fgets( buf, sizeof(buf), f ) != NULL ) {
+            char* p = buf;
+            while ( *p != '\0' && *p != '\n' ) {
+                char* end;
+                int first = (int) strtol( p, &end, 10 );
+                if ( end == p ) {
+                    break;
+                }
+                int last = first;
+                p = end;
+                if ( *p == '-' ) {
+                    last = (int) strtol( p+1, &end, 10 );
+                    p = end;
+                }
+                for( int c = first; c <= last; ++c ) {
+                    list.push_back( c );
+                }
+                if ( *p == ',' ) {
+                    ++p;
+                }
+            }
+        }
+        fclose( f );
+    }
+    return list;
+}
+
+#endif  // MAGMA_NOAFFINITY
+
+
+// Renumbers ids in field of cpus to 0, 1, ..., in increasing order.
+// @return number of distinct ids.
+static int renumber( std::vector< magma_cpu_info >& cpus, int magma_cpu_info::* field )
+{
+    std::map< int, int > ids;
+    for( size_t i = 0; i < cpus.size(); ++i ) {
+        ids[ cpus[i].*field ] = 0;
+    }
+    int n = 0;
+    for( auto iter = ids.begin(); iter != ids.end(); ++iter ) {
+        iter->second = n++;
+    }
+    for( size_t i = 0; i < cpus.size(); ++i ) {
+        cpus[i].*field = ids[ cpus[i].*field ];
+    }
+    return n;
+}
+
+
+/***************************************************************************//**
+    Discovers the CPUs in this process' affinity mask, and their core,
+    socket, NUMA node, and L3 cache, from /sys/devices/system.
+    Missing information puts CPUs in the same domain, e.g., one NUMA node.
+*******************************************************************************/
+magma_topology::magma_topology():
+    cpus( NULL ),
+    ncpu( 0 ), ncore( 0 ), npackage( 0 ), nnode( 0 ), nl3( 0 )
+{
+    std::vector< magma_cpu_info > list;
+    memset( node_mask, 0, sizeof(node_mask) );
+
+#ifndef MAGMA_NOAFFINITY
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    if ( sched_getaffinity( 0, sizeof(set), &set ) != 0 ) {
+        std::vector<int> online = read_cpulist( "/sys/devices/system/cpu/online" );
+        for( size_t i = 0; i < online.size(); ++i ) {
+            if ( online[i] < CPU_SETSIZE ) {
+                CPU_SET( online[i], &set );
+            }
+        }
+    }
+
+    // NUMA node of each CPU; kernels without NUMA have no node directory
+    std::map< int, int > cpu_node;
+    DIR* dir = opendir( "/sys/devices/system/node" );
+    if ( dir != NULL ) {
+        struct dirent* entry;
+        while ( (entry = readdir( dir )) != NULL ) {
+            int node;
+            char path[ 256 ];
+            if ( sscanf( entry->d_name, "node%d", &node ) == 1 ) {
+                snprintf( path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node );
+                std::vector<int> node_cpus = read_cpulist( path );
+                for( size_t i = 0; i < node_cpus.size(); ++i ) {
+                    cpu_node[ node_cpus[i] ] = node;
+                }
+            }
+        }
+        closedir( dir );
+    }
+
+    for( int c = 0; c < CPU_SETSIZE; ++c ) {
+        if ( ! CPU_ISSET( c, &set )) {
+            continue;
+        }
+        char path[ 256 ];
+        magma_cpu_info info;
+        info.cpu = c;
+
+        snprintf( path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", c );
+        info.package = read_int( path, 0 );
+
+        // core_id is unique only within a package
+        snprintf( path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/core_id", c );
+        info.core = info.package * 65536 + read_int( path, c );
+
+        info.node = (cpu_node.count( c ) ? cpu_node[ c ] : 0);
+
+        // L3 is identified by the first CPU sharing it; else by package
+        info.l3 = -1 - info.package;
+        for( int index = 0; index < 16; ++index ) {
+            snprintf( path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/level", c, index );
+            int level = read_int( path, -1 );
+            if ( level < 0 ) {
+                break;
+            }
+            if ( level == 3 ) {
+                snprintf( path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/shared_cpu_list", c, index );
+                std::vector<int> shared = read_cpulist( path );
+                if ( ! shared.empty() ) {
+                    info.l3 = *std::min_element( shared.begin(), shared.end() );
+                }
+                break;
+            }
+        }
+        list.push_back( info );
+
+        if ( info.node >= 0 && info.node < (int) (8*sizeof(node_mask)) ) {
+            node_mask[ info.node / (8*sizeof(unsigned long)) ]
+                |= 1UL << (info.node % (8*sizeof(unsigned long)));
+        }
+    }
+#endif
+
+    if ( list.empty() ) {
+        // MAGMA_NOAFFINITY, or discovery failed: one domain
+        #ifdef MAGMA_NOAFFINITY
+        int n = (int) std::thread::hardware_concurrency();
+        #else
+        int n = (int) sysconf( _SC_NPROCESSORS_ONLN );
+        #endif
+        for( int c = 0; c < std::max( n, 1 ); ++c ) {
+            magma_cpu_info info = { c, c, 0, 0, 0 };
+            list.push_back( info );
+        }
+    }
+
+    ncore    = renumber( list, &magma_cpu_info::core    );
+    npackage = renumber( list, &magma_cpu_info::package );
+    nnode    = renumber( list, &magma_cpu_info::node    );
+    nl3      = renumber( list, &magma_cpu_info::l3      );
+
+    std::sort( list.begin(), list.end(),
+        []( const magma_cpu_info& a, const magma_cpu_info& b ) {
+            if ( a.package != b.package ) return a.package < b.package;
+            if ( a.node    != b.node    ) return a.node    < b.node;
+            if ( a.l3      != b.l3      ) return a.l3      < b.l3;
+            if ( a.core    != b.core    ) return a.core    < b.core;
+            return a.cpu < b.cpu;
+        });
+
+    ncpu = (int) list.size();
+    cpus = new magma_cpu_info[ ncpu ];
+    std::copy( list.begin(), list.end(), cpus );
+}
+
+
+/***************************************************************************//**
+    @return topology of this machine, discovered on first call.
+    It is never freed.
+*******************************************************************************/
+const magma_topology& magma_topology::get()
+{
+    static const magma_topology* topo = new magma_topology();
+    return *topo;
+}
+
+
+/***************************************************************************//**
+    Assigns a CPU to each of nthread threads.
+    Threads first get one hyperthread per core, in the order the policy
+    gives; with more threads than cores they get the remaining hyperthreads,
+    and with more threads than CPUs they wrap around.
+
+    @param[in] policy      Placement policy. With MagmaPlacementNone,
+                           each entry is -1, meaning not bound.
+    @param[in] nthread     Number of threads.
+    @param[out] cpu_list   Array of length nthread; CPU of each thread.
+*******************************************************************************/
+void magma_topology::placement(
+    magma_placement_t policy, int nthread, int* cpu_list ) const
+{
+    if ( policy == MagmaPlacementNone ) {
+        std::fill( cpu_list, cpu_list + nthread, -1 );
+        return;
+    }
+
+    // rounds of hyperthreads: first CPU of each core, then the second, ...
+    std::vector< std::vector< int > > rounds;
+    std::map< int, int > core_count;
+    for( int i = 0; i < ncpu; ++i ) {
+        int r = core_count[ cpus[i].core ]++;
+        if ( r >= (int) rounds.size() ) {
+            rounds.resize( r+1 );
+        }
+        rounds[r].push_back( i );
+    }
+
+    std::vector< int > order;
+    for( size_t r = 0; r < rounds.size(); ++r ) {
+        if ( policy == MagmaPlacementCompact ) {
+            order.insert( order.end(), rounds[r].begin(), rounds[r].end() );
+        }
+        else {
+            // round-robin over domains, keeping the sorted order within each
+            int magma_cpu_info::* field =
+                (policy == MagmaPlacementScatter ? &magma_cpu_info::node
+                                                 : &magma_cpu_info::l3);
+            int ndomain = (policy == MagmaPlacementScatter ? nnode : nl3);
+            std::vector< std::vector< int > > domains( ndomain );
+            for( size_t j = 0; j < rounds[r].size(); ++j ) {
+                int i = rounds[r][j];
+                domains[ cpus[i].*field ].push_back( i );
+            }
+            for( size_t k = 0; order.size() < (size_t) ncpu; ++k ) {
+                bool any = false;
+                for( int d = 0; d < ndomain; ++d ) {
+                    if ( k < domains[d].size() ) {
+                        order.push_back( domains[d][k] );
+                        any = true;
+                    }
+                }
+                if ( ! any ) {
+                    break;
+                }
+            }
+        }
+    }
+
+    for( int t = 0; t < nthread; ++t ) {
+        cpu_list[t] = cpus[ order[ t % ncpu ] ].cpu;
+    }
+}
+
+
+/***************************************************************************//**
+    Prints a summary, e.g.,
+    "% topology: 2 sockets, 2 NUMA nodes, 2 L3, 40 cores, 80 CPUs".
+*******************************************************************************/
+void magma_topology::print() const
+{
+    printf( "%% topology: %d sockets, %d NUMA nodes, %d L3, %d cores, %d CPUs; placement %s\n",
+            npackage, nnode, nl3, ncore, ncpu,
+            magma_placement_name( magma_get_placement() ));
+}
+
+
+/***************************************************************************//**
+    Sets pages of [ptr, ptr + size) to be interleaved over the NUMA nodes
+    of this process' CPUs, moving pages already touched.
+    Partial pages at either end are not changed.
+    Does nothing with one NUMA node.
+
+    @return 0 on success, else errno.
+*******************************************************************************/
+int magma_topology::interleave( void* ptr, size_t size ) const
+{
+    if ( nnode <= 1 || ptr == NULL || size == 0 ) {
+        return 0;
+    }
+#if ! defined(MAGMA_NOAFFINITY) && defined(SYS_mbind)
+    const int    mpol_interleave = 3;       // MPOL_INTERLEAVE in linux/mempolicy.h
+    const int    mpol_mf_move    = 1 << 1;  // MPOL_MF_MOVE
+    const size_t page = (size_t) sysconf( _SC_PAGESIZE );
+    size_t begin = ((size_t) ptr + page - 1) / page * page;
+    size_t end   = ((size_t) ptr + size) / page * page;
+    if ( end <= begin ) {
+        return 0;
+    }
+    // maxnode + 1, as the kernel uses one less than maxnode
+    long err = syscall( SYS_mbind, (void*) begin, end - begin, mpol_interleave,
+                        node_mask, 8*sizeof(node_mask) + 1, mpol_mf_move );
+    return (err == 0 ? 0 : errno);
+#else
+    return 0;
+#endif
+}
+
+
+// =============================================================================
+// Placement
+
+/***************************************************************************//**
+    @return placement policy for worker threads, from $MAGMA_PLACEMENT,
+    which is one of "none" (default), "compact", "scatter", or "l3".
+*******************************************************************************/
+magma_placement_t magma_get_placement()
+{
+    const char* env = getenv( "MAGMA_PLACEMENT" );
+    if ( env != NULL ) {
+        if ( strcmp( env, "compact" ) == 0 ) return MagmaPlacementCompact;
+        if ( strcmp( env, "scatter" ) == 0 ) return MagmaPlacementScatter;
+        if ( strcmp( env, "l3"      ) == 0 ) return MagmaPlacementL3;
+    }
+    return MagmaPlacementNone;
+}
+
+
+/******************************************************************************/
+const char* magma_placement_name( magma_placement_t policy )
+{
+    switch ( policy ) {
+        case MagmaPlacementCompact: return "compact";
+        case MagmaPlacementScatter: return "scatter";
+        case MagmaPlacementL3:      return "l3";
+        default:                    return "none";
+    }
+}
+
+
+/***************************************************************************//**
+    Binds the calling thread to a CPU.
+    @param[in] cpu    CPU number; if < 0, does nothing.
+    @return 0 on success, else error from sched_setaffinity.
+*******************************************************************************/
+int magma_bind_thread( int cpu )
+{
+#ifndef MAGMA_NOAFFINITY
+    if ( cpu >= 0 ) {
+        affinity_set set( cpu );
+        return set.set_affinity();
+    }
+#endif
+    return 0;
+}
+
+
+/***************************************************************************//**
+    Interleaves pages of [ptr, ptr + size) over the NUMA nodes,
+    see magma_topology::interleave. For data shared by all threads,
+    e.g., the V, T, TAU workspaces in bulge chasing, this spreads memory
+    traffic over all sockets instead of the one where the data was first
+    touched. The memory policy stays with the pages after the call, so use
+    it only on memory the caller of the MAGMA routine handed over as
+    workspace, not on its input matrices.
+    @return 0 on success, else errno.
+*******************************************************************************/
+int magma_numa_interleave( void* ptr, size_t size )
+{
+    return magma_topology::get().interleave( ptr, size );
+}
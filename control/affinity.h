@@ -50,4 +50,68 @@ private:
 
 #endif  // MAGMA_NOAFFINITY
 
+
+// =============================================================================
+// Topology and thread placement.
+// Available with MAGMA_NOAFFINITY too, where all CPUs are in one domain
+// and binding does nothing.
+
+#include <stddef.h>
+
+/// Placement of worker threads on CPUs, set by $MAGMA_PLACEMENT.
+enum magma_placement_t {
+    MagmaPlacementNone,     ///< not bound; OS schedules threads (default)
+    MagmaPlacementCompact,  ///< fill cores of one NUMA node, then the next
+    MagmaPlacementScatter,  ///< round-robin over NUMA nodes
+    MagmaPlacementL3        ///< round-robin over L3 caches, i.e., one per L3 first
+};
+
+/// A CPU (hardware thread) and the domains it belongs to.
+/// Domain ids are numbered from 0 in each topology.
+struct magma_cpu_info
+{
+    int cpu;        ///< OS CPU number, as in sched_setaffinity
+    int core;       ///< physical core; hyperthreads of a core share it
+    int package;    ///< socket
+    int node;       ///< NUMA node
+    int l3;         ///< L3 cache domain
+};
+
+/// CPUs this process may run on, from /sys/devices/system/cpu,
+/// discovered once on first use.
+class magma_topology
+{
+public:
+    static const magma_topology& get();
+
+    int num_cpus()     const { return ncpu;     }
+    int num_cores()    const { return ncore;    }
+    int num_packages() const { return npackage; }
+    int num_nodes()    const { return nnode;    }
+    int num_l3()       const { return nl3;      }
+
+    const magma_cpu_info& cpu( int i ) const { return cpus[i]; }
+
+    void placement( magma_placement_t policy, int nthread, int* cpu_list ) const;
+
+    void print() const;
+
+    int interleave( void* ptr, size_t size ) const;
+
+private:
+    magma_topology();
+
+    magma_cpu_info* cpus;  ///< sorted by package, node, l3, core, cpu
+    int ncpu, ncore, npackage, nnode, nl3;
+    unsigned long node_mask[ 16 ];  ///< OS NUMA node numbers, for mbind
+};
+
+magma_placement_t magma_get_placement();
+
+const char* magma_placement_name( magma_placement_t policy );
+
+int magma_bind_thread( int cpu );
+
+int magma_numa_interleave( void* ptr, size_t size );
+
 #endif  // MAGMA_AFFINITY_H
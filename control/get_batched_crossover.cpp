@@ -12,6 +12,7 @@
 #include <vector>
 #include <cmath>
 #include "magma_internal.h"
+#include "magma_tune.h"
 #include "geqrf_batched_panel_decision.h"
 
 #ifdef __cplusplus
@@ -194,24 +195,28 @@ void magma_get_sgetrf_vbatched_nbparam(magma_int_t max_m, magma_int_t max_n, mag
 // TODO: get_geqrf_nb takes (m,n); this should do likewise
 magma_int_t magma_get_zgeqrf_batched_nb(magma_int_t m)
 {
+    MAGMA_TUNE_LOOKUP( m, 0 );
     return 32;
 }
 
 /// @see magma_get_zgeqrf_batched_nb
 magma_int_t magma_get_cgeqrf_batched_nb(magma_int_t m)
 {
+    MAGMA_TUNE_LOOKUP( m, 0 );
     return 32;
 }
 
 /// @see magma_get_zgeqrf_batched_nb
 magma_int_t magma_get_dgeqrf_batched_nb(magma_int_t m)
 {
+    MAGMA_TUNE_LOOKUP( m, 0 );
     return 32;
 }
 
 /// @see magma_get_zgeqrf_batched_nb
 magma_int_t magma_get_sgeqrf_batched_nb(magma_int_t m)
 {
+    MAGMA_TUNE_LOOKUP( m, 0 );
     return 32;
 }
 
@@ -328,6 +333,7 @@ magma_int_t magma_use_sgeqrf_batched_fused_update(magma_int_t m, magma_int_t n,
 *******************************************************************************/
 magma_int_t magma_get_zgeqr2_fused_sm_batched_nthreads(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     #ifdef MAGMA_HAVE_HIP
     // based on MI100, rocm-4.5.0
     if ( n <= 4 ) {
@@ -368,6 +374,7 @@ magma_int_t magma_get_zgeqr2_fused_sm_batched_nthreads(magma_int_t m, magma_int_
 
 magma_int_t magma_get_cgeqr2_fused_sm_batched_nthreads(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     #ifdef MAGMA_HAVE_HIP
     // based on MI100, rocm-4.5.0
     if ( n <= 4 ) {
@@ -415,6 +422,7 @@ magma_int_t magma_get_cgeqr2_fused_sm_batched_nthreads(magma_int_t m, magma_int_
 
 magma_int_t magma_get_dgeqr2_fused_sm_batched_nthreads(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     #ifdef MAGMA_HAVE_HIP
     // based on MI100, rocm-4.5.0
     if ( n <= 4 ) {
@@ -461,6 +469,7 @@ magma_int_t magma_get_dgeqr2_fused_sm_batched_nthreads(magma_int_t m, magma_int_
 
 magma_int_t magma_get_sgeqr2_fused_sm_batched_nthreads(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     #ifdef MAGMA_HAVE_HIP
     // based on MI100, rocm-4.5.0
     if ( n <= 4 ) {
@@ -510,6 +519,7 @@ magma_int_t magma_get_sgeqr2_fused_sm_batched_nthreads(magma_int_t m, magma_int_
 *******************************************************************************/
 magma_int_t magma_get_zpotrf_batched_crossover()
 {
+    MAGMA_TUNE_LOOKUP( 0, 0 );
     magma_int_t arch = magma_getdevice_arch();
     if(arch >= 700){
         return 352;
@@ -525,6 +535,7 @@ magma_int_t magma_get_zpotrf_batched_crossover()
 /// @see magma_get_zpotrf_batched_crossover
 magma_int_t magma_get_cpotrf_batched_crossover()
 {
+    MAGMA_TUNE_LOOKUP( 0, 0 );
     magma_int_t arch = magma_getdevice_arch();
     if(arch >= 700){
         return 576;
@@ -540,6 +551,7 @@ magma_int_t magma_get_cpotrf_batched_crossover()
 /// @see magma_get_zpotrf_batched_crossover
 magma_int_t magma_get_dpotrf_batched_crossover()
 {
+    MAGMA_TUNE_LOOKUP( 0, 0 );
     magma_int_t arch = magma_getdevice_arch();
     if(arch >= 700){
         return 640;
@@ -555,6 +567,7 @@ magma_int_t magma_get_dpotrf_batched_crossover()
 /// @see magma_get_zpotrf_batched_crossover
 magma_int_t magma_get_spotrf_batched_crossover()
 {
+    MAGMA_TUNE_LOOKUP( 0, 0 );
     magma_int_t arch = magma_getdevice_arch();
     if(arch >= 700){
         return 608;
@@ -571,24 +584,28 @@ magma_int_t magma_get_spotrf_batched_crossover()
 *******************************************************************************/
 magma_int_t magma_get_zpotrf_vbatched_crossover()
 {
+    MAGMA_TUNE_LOOKUP( 0, 0 );
     return ZPOTRF_VBATCHED_SWITCH;
 }
 
 /// @see magma_get_zpotrf_vbatched_crossover
 magma_int_t magma_get_cpotrf_vbatched_crossover()
 {
+    MAGMA_TUNE_LOOKUP( 0, 0 );
     return CPOTRF_VBATCHED_SWITCH;
 }
 
 /// @see magma_get_zpotrf_vbatched_crossover
 magma_int_t magma_get_dpotrf_vbatched_crossover()
 {
+    MAGMA_TUNE_LOOKUP( 0, 0 );
     return DPOTRF_VBATCHED_SWITCH;
 }
 
 /// @see magma_get_zpotrf_vbatched_crossover
 magma_int_t magma_get_spotrf_vbatched_crossover()
 {
+    MAGMA_TUNE_LOOKUP( 0, 0 );
     return SPOTRF_VBATCHED_SWITCH;
 }
 
@@ -598,6 +615,7 @@ magma_int_t magma_get_spotrf_vbatched_crossover()
 *******************************************************************************/
 magma_int_t magma_get_zgetri_batched_ntcol(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t ntcol = 1;
 
     // TODO: conduct tuning experiment for ntcol in z precision
@@ -613,6 +631,7 @@ magma_int_t magma_get_zgetri_batched_ntcol(magma_int_t m, magma_int_t n)
 /// @see magma_get_zgetri_batched_ntcol
 magma_int_t magma_get_cgetri_batched_ntcol(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t ntcol = 1;
 
     // TODO: conduct tuning experiment for ntcol in z precision
@@ -628,6 +647,7 @@ magma_int_t magma_get_cgetri_batched_ntcol(magma_int_t m, magma_int_t n)
 /// @see magma_get_zgetri_batched_ntcol
 magma_int_t magma_get_dgetri_batched_ntcol(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
 
     // TODO: conduct tuning experiment for ntcol on Kepler
     magma_int_t arch = magma_getdevice_arch();
@@ -675,6 +695,7 @@ magma_int_t magma_get_dgetri_batched_ntcol(magma_int_t m, magma_int_t n)
 /// @see magma_get_zgetri_batched_ntcol
 magma_int_t magma_get_sgetri_batched_ntcol(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     // TODO: conduct tuning experiment for ntcol on Kepler
     magma_int_t arch = magma_getdevice_arch();
     magma_int_t ntcol = 1;
@@ -11,6 +11,7 @@
 */
 
 #include "magma_internal.h"
+#include "magma_tune.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,6 +33,7 @@ extern "C" {
 /// @return nb for spotrf based on n
 magma_int_t magma_get_spotrf_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler
@@ -53,6 +55,7 @@ magma_int_t magma_get_spotrf_nb( magma_int_t n )
 /// @return nb for dpotrf based on n
 magma_int_t magma_get_dpotrf_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler
@@ -74,6 +77,7 @@ magma_int_t magma_get_dpotrf_nb( magma_int_t n )
 /// @return nb for cpotrf based on n
 magma_int_t magma_get_cpotrf_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler
@@ -92,6 +96,7 @@ magma_int_t magma_get_cpotrf_nb( magma_int_t n )
 /// @return nb for zpotrf based on n
 magma_int_t magma_get_zpotrf_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler
@@ -112,24 +117,28 @@ magma_int_t magma_get_zpotrf_nb( magma_int_t n )
 /// @return nb for zpotrf_right based on n
 magma_int_t magma_get_zpotrf_right_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 128;
 }
 
 /// @return nb for cpotrf_right based on n
 magma_int_t magma_get_cpotrf_right_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 128;
 }
 
 /// @return nb for dpotrf_right based on n
 magma_int_t magma_get_dpotrf_right_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 320;
 }
 
 /// @return nb for spotrf_right based on n
 magma_int_t magma_get_spotrf_right_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 128;
 }
 
@@ -138,24 +147,28 @@ magma_int_t magma_get_spotrf_right_nb( magma_int_t n )
 /// @return nb for sgeqp3 based on m, n
 magma_int_t magma_get_sgeqp3_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     return 32;
 }
 
 /// @return nb for dgeqp3 based on m, n
 magma_int_t magma_get_dgeqp3_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     return 32;
 }
 
 /// @return nb for cgeqp3 based on m, n
 magma_int_t magma_get_cgeqp3_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     return 32;
 }
 
 /// @return nb for zgeqp3 based on m, n
 magma_int_t magma_get_zgeqp3_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     return 32;
 }
 
@@ -164,6 +177,7 @@ magma_int_t magma_get_zgeqp3_nb( magma_int_t m, magma_int_t n )
 /// @return nb for sgeqrf based on m, n
 magma_int_t magma_get_sgeqrf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -189,6 +203,7 @@ magma_int_t magma_get_sgeqrf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for dgeqrf based on m, n
 magma_int_t magma_get_dgeqrf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -208,6 +223,7 @@ magma_int_t magma_get_dgeqrf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for cgeqrf based on m, n
 magma_int_t magma_get_cgeqrf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -226,6 +242,7 @@ magma_int_t magma_get_cgeqrf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for zgeqrf based on m, n
 magma_int_t magma_get_zgeqrf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -250,6 +267,7 @@ magma_int_t magma_get_zgeqrf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for sgeqlf based on m, n
 magma_int_t magma_get_sgeqlf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -267,6 +285,7 @@ magma_int_t magma_get_sgeqlf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for dgeqlf based on m, n
 magma_int_t magma_get_dgeqlf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -284,6 +303,7 @@ magma_int_t magma_get_dgeqlf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for cgeqlf based on m, n
 magma_int_t magma_get_cgeqlf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     if      (minmn <  2048) nb = 32;
@@ -295,6 +315,7 @@ magma_int_t magma_get_cgeqlf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for zgeqlf based on m, n
 magma_int_t magma_get_zgeqlf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     if      (minmn <  1024) nb = 64;
@@ -307,12 +328,14 @@ magma_int_t magma_get_zgeqlf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for sgelqf based on m, n
 magma_int_t magma_get_sgelqf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     return magma_get_sgeqrf_nb( m, n );
 }
 
 /// @return nb for dgelqf based on m, n
 magma_int_t magma_get_dgelqf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -330,6 +353,7 @@ magma_int_t magma_get_dgelqf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for cgelqf based on m, n
 magma_int_t magma_get_cgelqf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     if      (minmn <  2048) nb = 32;
@@ -341,6 +365,7 @@ magma_int_t magma_get_cgelqf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for zgelqf based on m, n
 magma_int_t magma_get_zgelqf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     if      (minmn <  1024) nb = 64;
@@ -565,6 +590,7 @@ magma_int_t magma_get_xgetrf_nb(
 //-------------------------------------------------------------------------------
 magma_int_t magma_get_hgetrf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     //magma_int_t arch = magma_getdevice_arch();
@@ -630,6 +656,7 @@ magma_int_t magma_get_hgetrf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for sgetrf based on m, n
 magma_int_t magma_get_sgetrf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -653,6 +680,7 @@ magma_int_t magma_get_sgetrf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for dgetrf based on m, n
 magma_int_t magma_get_dgetrf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -677,6 +705,7 @@ magma_int_t magma_get_dgetrf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for cgetrf based on m, n
 magma_int_t magma_get_cgetrf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -699,6 +728,7 @@ magma_int_t magma_get_cgetrf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for zgetrf based on m, n
 magma_int_t magma_get_zgetrf_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -722,6 +752,7 @@ magma_int_t magma_get_zgetrf_nb( magma_int_t m, magma_int_t n )
 /// @return nb for native sgetrf based on m, n
 magma_int_t magma_get_sgetrf_native_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -746,6 +777,7 @@ magma_int_t magma_get_sgetrf_native_nb( magma_int_t m, magma_int_t n )
 /// @return nb for native dgetrf based on m, n
 magma_int_t magma_get_dgetrf_native_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -770,6 +802,7 @@ magma_int_t magma_get_dgetrf_native_nb( magma_int_t m, magma_int_t n )
 /// @return nb for native cgetrf based on m, n
 magma_int_t magma_get_cgetrf_native_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -792,6 +825,7 @@ magma_int_t magma_get_cgetrf_native_nb( magma_int_t m, magma_int_t n )
 /// @return nb for native zgetrf based on m, n
 magma_int_t magma_get_zgetrf_native_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t nb;
     magma_int_t minmn = min( m, n );
     magma_int_t arch = magma_getdevice_arch();
@@ -817,6 +851,7 @@ magma_int_t magma_get_zgetrf_native_nb( magma_int_t m, magma_int_t n )
 /// @return nb for sgehrd based on n
 magma_int_t magma_get_sgehrd_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 200 ) {       // 2.x Fermi
@@ -833,6 +868,7 @@ magma_int_t magma_get_sgehrd_nb( magma_int_t n )
 /// @return nb for dgehrd based on n
 magma_int_t magma_get_dgehrd_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     if      (n <  2048) nb = 32;
     else                nb = 64;
@@ -842,6 +878,7 @@ magma_int_t magma_get_dgehrd_nb( magma_int_t n )
 /// @return nb for cgehrd based on n
 magma_int_t magma_get_cgehrd_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     if      (n <  1024) nb = 32;
     else                nb = 64;
@@ -851,6 +888,7 @@ magma_int_t magma_get_cgehrd_nb( magma_int_t n )
 /// @return nb for zgehrd based on n
 magma_int_t magma_get_zgehrd_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     if      (n <  2048) nb = 32;
     else                nb = 64;
@@ -864,24 +902,28 @@ magma_int_t magma_get_zgehrd_nb( magma_int_t n )
 /// @return nb for ssytrd based on n
 magma_int_t magma_get_ssytrd_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 64;
 }
 
 /// @return nb for dsytrd based on n
 magma_int_t magma_get_dsytrd_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 64;
 }
 
 /// @return nb for chetrd based on n
 magma_int_t magma_get_chetrd_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 64;
 }
 
 /// @return nb for zhetrd based on n
 magma_int_t magma_get_zhetrd_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 64;
 }
 
@@ -890,24 +932,28 @@ magma_int_t magma_get_zhetrd_nb( magma_int_t n )
 /// @return nb for zhetrf based on n
 magma_int_t magma_get_zhetrf_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 256;
 }
 
 /// @return nb for chetrf based on n
 magma_int_t magma_get_chetrf_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 256;
 }
 
 /// @return nb for dsytrf based on n
 magma_int_t magma_get_dsytrf_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 96;
 }
 
 /// @return nb for ssytrf based on n
 magma_int_t magma_get_ssytrf_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 256;
 }
 
@@ -916,24 +962,28 @@ magma_int_t magma_get_ssytrf_nb( magma_int_t n )
 /// @return nb for zhetrf_aasen based on n
 magma_int_t magma_get_zhetrf_aasen_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 256;
 }
 
 /// @return nb for chetrf_aasen based on n
 magma_int_t magma_get_chetrf_aasen_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 256;
 }
 
 /// @return nb for dsytrf_aasen based on n
 magma_int_t magma_get_dsytrf_aasen_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 256;
 }
 
 /// @return nb for ssytrf_aasen based on n
 magma_int_t magma_get_ssytrf_aasen_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 256;
 }
 
@@ -942,24 +992,28 @@ magma_int_t magma_get_ssytrf_aasen_nb( magma_int_t n )
 /// @return nb for zhetrf_nopiv based on n
 magma_int_t magma_get_zhetrf_nopiv_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 320;
 }
 
 /// @return nb for chetrf_nopiv based on n
 magma_int_t magma_get_chetrf_nopiv_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 320;
 }
 
 /// @return nb for dsytrf_nopiv based on n
 magma_int_t magma_get_dsytrf_nopiv_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 320;
 }
 
 /// @return nb for ssytrf_nopiv based on n
 magma_int_t magma_get_ssytrf_nopiv_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 320;
 }
 
@@ -968,24 +1022,28 @@ magma_int_t magma_get_ssytrf_nopiv_nb( magma_int_t n )
 /// @return nb for sgebrd based on m, n
 magma_int_t magma_get_sgebrd_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     return 32;
 }
 
 /// @return nb for dgebrd based on m, n
 magma_int_t magma_get_dgebrd_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     return 32;
 }
 
 /// @return nb for cgebrd based on m, n
 magma_int_t magma_get_cgebrd_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     return 32;
 }
 
 /// @return nb for zgebrd based on m, n
 magma_int_t magma_get_zgebrd_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     return 32;
 }
 
@@ -994,6 +1052,7 @@ magma_int_t magma_get_zgebrd_nb( magma_int_t m, magma_int_t n )
 /// @return nb for ssygst based on n
 magma_int_t magma_get_ssygst_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler
@@ -1013,6 +1072,7 @@ magma_int_t magma_get_ssygst_nb( magma_int_t n )
 /// @return nb for dsygst based on n
 magma_int_t magma_get_dsygst_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler
@@ -1031,6 +1091,7 @@ magma_int_t magma_get_dsygst_nb( magma_int_t n )
 /// @return nb for chegst based on n
 magma_int_t magma_get_chegst_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler
@@ -1049,6 +1110,7 @@ magma_int_t magma_get_chegst_nb( magma_int_t n )
 /// @return nb for zhegst based on n
 magma_int_t magma_get_zhegst_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler
@@ -1068,24 +1130,28 @@ magma_int_t magma_get_zhegst_nb( magma_int_t n )
 /// @return nb for sgetri based on n
 magma_int_t magma_get_sgetri_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 64;
 }
 
 /// @return nb for dgetri based on n
 magma_int_t magma_get_dgetri_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 64;
 }
 
 /// @return nb for cgetri based on n
 magma_int_t magma_get_cgetri_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 64;
 }
 
 /// @return nb for zgetri based on n
 magma_int_t magma_get_zgetri_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 64;
 }
 
@@ -1094,24 +1160,28 @@ magma_int_t magma_get_zgetri_nb( magma_int_t n )
 /// @return nb for sgesvd based on m, n
 magma_int_t magma_get_sgesvd_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     return magma_get_sgebrd_nb( m, n );
 }
 
 /// @return nb for dgesvd based on m, n
 magma_int_t magma_get_dgesvd_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     return magma_get_dgebrd_nb( m, n );
 }
 
 /// @return nb for cgesvd based on m, n
 magma_int_t magma_get_cgesvd_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     return magma_get_cgebrd_nb( m, n );
 }
 
 /// @return nb for zgesvd based on m, n
 magma_int_t magma_get_zgesvd_nb( magma_int_t m, magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     return magma_get_zgebrd_nb( m, n );
 }
 
@@ -1120,6 +1190,7 @@ magma_int_t magma_get_zgesvd_nb( magma_int_t m, magma_int_t n )
 /// @return nb for ssygst_m based on n
 magma_int_t magma_get_ssygst_m_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 256; //to be updated
 
     /*
@@ -1143,6 +1214,7 @@ magma_int_t magma_get_ssygst_m_nb( magma_int_t n )
 /// @return nb for dsygst_m based on n
 magma_int_t magma_get_dsygst_m_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 256; //to be updated
 
     /*
@@ -1165,6 +1237,7 @@ magma_int_t magma_get_dsygst_m_nb( magma_int_t n )
 /// @return nb for chegst_m based on n
 magma_int_t magma_get_chegst_m_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 256; //to be updated
 
     /*
@@ -1187,6 +1260,7 @@ magma_int_t magma_get_chegst_m_nb( magma_int_t n )
 /// @return nb for zhegst_m based on n
 magma_int_t magma_get_zhegst_m_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     return 256; //to be updated
 
     /*
@@ -1213,6 +1287,7 @@ magma_int_t magma_get_zhegst_m_nb( magma_int_t n )
 /// @return gpu over cpu performance for 2 stage TRD
 magma_int_t magma_get_sbulge_gcperf( )
 {
+    MAGMA_TUNE_LOOKUP( 0, 0 );
     magma_int_t perf;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1230,6 +1305,7 @@ magma_int_t magma_get_sbulge_gcperf( )
 /// @return gpu over cpu performance for 2 stage TRD
 magma_int_t magma_get_dbulge_gcperf( )
 {
+    MAGMA_TUNE_LOOKUP( 0, 0 );
     magma_int_t perf;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1247,6 +1323,7 @@ magma_int_t magma_get_dbulge_gcperf( )
 /// @return gpu over cpu performance for 2 stage TRD
 magma_int_t magma_get_cbulge_gcperf( )
 {
+    MAGMA_TUNE_LOOKUP( 0, 0 );
     magma_int_t perf;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1264,6 +1341,7 @@ magma_int_t magma_get_cbulge_gcperf( )
 /// @return gpu over cpu performance for 2 stage TRD
 magma_int_t magma_get_zbulge_gcperf( )
 {
+    MAGMA_TUNE_LOOKUP( 0, 0 );
     magma_int_t perf;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1283,15 +1361,33 @@ magma_int_t magma_get_zbulge_gcperf( )
 /// @return smlsiz for the divide and conquewr routine dlaex0 dstedx zstedx
 magma_int_t magma_get_smlsize_divideconquer()
 {
+    MAGMA_TUNE_LOOKUP_HOST( 0, 0 );
     return 128;
 }
 
 
+/******************************************************************************/
+/// @return nb for the GEMM blocks (back-transform of eigenvectors)
+/// in trevc3_mt, based on n and number of threads.
+/// Default is n/nthread, rounded up to multiple of 16,
+/// but avoiding multiples of page size, e.g., 512*8 bytes = 4096.
+magma_int_t magma_get_trevc3_gemm_nb( magma_int_t n, magma_int_t nthread )
+{
+    MAGMA_TUNE_LOOKUP_HOST_THREADS( nthread, 0, n );
+    magma_int_t nb = magma_roundup( magma_ceildiv( n, max( 1, nthread )), 16 );
+    if ( nb % 512 == 0 ) {
+        nb += 32;
+    }
+    return nb;
+}
+
+
 
 /******************************************************************************/
 /// @return nb for 2 stage TRD
 magma_int_t magma_get_sbulge_nb( magma_int_t n, magma_int_t nbthreads  )
 {
+    MAGMA_TUNE_LOOKUP_THREADS( nbthreads, 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1309,6 +1405,7 @@ magma_int_t magma_get_sbulge_nb( magma_int_t n, magma_int_t nbthreads  )
 /// @return nb for 2 stage TRD
 magma_int_t magma_get_dbulge_nb( magma_int_t n, magma_int_t nbthreads  )
 {
+    MAGMA_TUNE_LOOKUP_THREADS( nbthreads, 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1326,6 +1423,7 @@ magma_int_t magma_get_dbulge_nb( magma_int_t n, magma_int_t nbthreads  )
 /// @return nb for 2 stage TRD
 magma_int_t magma_get_cbulge_nb( magma_int_t n, magma_int_t nbthreads  )
 {
+    MAGMA_TUNE_LOOKUP_THREADS( nbthreads, 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1346,6 +1444,7 @@ magma_int_t magma_get_cbulge_nb( magma_int_t n, magma_int_t nbthreads  )
 /// @return nb for 2 stage TRD
 magma_int_t magma_get_zbulge_nb( magma_int_t n, magma_int_t nbthreads )
 {
+    MAGMA_TUNE_LOOKUP_THREADS( nbthreads, 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1368,6 +1467,7 @@ magma_int_t magma_get_zbulge_nb( magma_int_t n, magma_int_t nbthreads )
 /// @return Vblksiz for 2 stage TRD
 magma_int_t magma_get_sbulge_vblksiz( magma_int_t n, magma_int_t nb, magma_int_t nbthreads  )
 {
+    MAGMA_TUNE_LOOKUP( nb, n );
     magma_int_t size;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1382,6 +1482,7 @@ magma_int_t magma_get_sbulge_vblksiz( magma_int_t n, magma_int_t nb, magma_int_t
 /// @return Vblksiz for 2 stage TRD
 magma_int_t magma_get_dbulge_vblksiz( magma_int_t n, magma_int_t nb, magma_int_t nbthreads  )
 {
+    MAGMA_TUNE_LOOKUP( nb, n );
     magma_int_t size;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1396,6 +1497,7 @@ magma_int_t magma_get_dbulge_vblksiz( magma_int_t n, magma_int_t nb, magma_int_t
 /// @return Vblksiz for 2 stage TRD
 magma_int_t magma_get_cbulge_vblksiz( magma_int_t n, magma_int_t nb, magma_int_t nbthreads )
 {
+    MAGMA_TUNE_LOOKUP( nb, n );
     magma_int_t size;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1413,6 +1515,7 @@ magma_int_t magma_get_cbulge_vblksiz( magma_int_t n, magma_int_t nb, magma_int_t
 /// @return Vblksiz for 2 stage TRD
 magma_int_t magma_get_zbulge_vblksiz( magma_int_t n, magma_int_t nb, magma_int_t nbthreads )
 {
+    MAGMA_TUNE_LOOKUP( nb, n );
     magma_int_t size;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1432,6 +1535,7 @@ magma_int_t magma_get_zbulge_vblksiz( magma_int_t n, magma_int_t nb, magma_int_t
 /// @return nb for 2 stage TRD_MGPU
 magma_int_t magma_get_sbulge_mgpu_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1449,6 +1553,7 @@ magma_int_t magma_get_sbulge_mgpu_nb( magma_int_t n )
 /// @return nb for 2 stage TRD_MGPU
 magma_int_t magma_get_dbulge_mgpu_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1466,6 +1571,7 @@ magma_int_t magma_get_dbulge_mgpu_nb( magma_int_t n )
 /// @return nb for 2 stage TRD_MGPU
 magma_int_t magma_get_cbulge_mgpu_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -1483,6 +1589,7 @@ magma_int_t magma_get_cbulge_mgpu_nb( magma_int_t n )
 /// @return nb for 2 stage TRD_MGPU
 magma_int_t magma_get_zbulge_mgpu_nb( magma_int_t n )
 {
+    MAGMA_TUNE_LOOKUP( 0, n );
     magma_int_t nb;
     magma_int_t arch = magma_getdevice_arch();
     if ( arch >= 300 ) {       // 3.x Kepler + SB
@@ -12,6 +12,7 @@
 */
 
 #include "magma_internal.h"
+#include "magma_tune.h"
 
 // for every size [1:32], how many 1D configs can a warp hold?
 #define NTCOL_1D_DEFAULT 32, 16, 10, 8, 6, 5, 4, 4, 3, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1
@@ -98,6 +99,7 @@ extern "C" {
 *******************************************************************************/
 magma_int_t magma_get_zgemm_batched_ntcol(magma_int_t m)
 {
+    MAGMA_TUNE_LOOKUP( m, 0 );
     magma_int_t* ntcol_array; 
 
     if(m < 0 || m > 32) return 1;
@@ -114,6 +116,7 @@ magma_int_t magma_get_zgemm_batched_ntcol(magma_int_t m)
 /// @see magma_get_zgemm_batched_ntcol
 magma_int_t magma_get_cgemm_batched_ntcol(magma_int_t m)
 {
+    MAGMA_TUNE_LOOKUP( m, 0 );
     magma_int_t* ntcol_array; 
 
     if(m < 0 || m > 32) return 1;
@@ -130,6 +133,7 @@ magma_int_t magma_get_cgemm_batched_ntcol(magma_int_t m)
 /// @see magma_get_zgemm_batched_ntcol
 magma_int_t magma_get_dgemm_batched_ntcol(magma_int_t m)
 {
+    MAGMA_TUNE_LOOKUP( m, 0 );
     magma_int_t* ntcol_array; 
 
     if(m < 0 || m > 32) return 1;
@@ -146,6 +150,7 @@ magma_int_t magma_get_dgemm_batched_ntcol(magma_int_t m)
 /// @see magma_get_zgemm_batched_ntcol
 magma_int_t magma_get_sgemm_batched_ntcol(magma_int_t m)
 {
+    MAGMA_TUNE_LOOKUP( m, 0 );
     magma_int_t* ntcol_array; 
 
     if(m < 0 || m > 32) return 1;
@@ -164,6 +169,7 @@ magma_int_t magma_get_sgemm_batched_ntcol(magma_int_t m)
 *******************************************************************************/
 magma_int_t magma_get_zgetrf_batched_ntcol(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t* ntcol_array; 
 
     if(m != n || m < 0 || m > 32) return 1;
@@ -180,6 +186,7 @@ magma_int_t magma_get_zgetrf_batched_ntcol(magma_int_t m, magma_int_t n)
 /// @see magma_get_zgetrf_batched_ntcol
 magma_int_t magma_get_cgetrf_batched_ntcol(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t* ntcol_array; 
 
     if(m != n || m < 0 || m > 32) return 1;
@@ -196,6 +203,7 @@ magma_int_t magma_get_cgetrf_batched_ntcol(magma_int_t m, magma_int_t n)
 /// @see magma_get_zgetrf_batched_ntcol
 magma_int_t magma_get_dgetrf_batched_ntcol(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t* ntcol_array; 
 
     if(m != n || m < 0 || m > 32) return 1;
@@ -212,6 +220,7 @@ magma_int_t magma_get_dgetrf_batched_ntcol(magma_int_t m, magma_int_t n)
 /// @see magma_get_zgetrf_batched_ntcol
 magma_int_t magma_get_sgetrf_batched_ntcol(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t* ntcol_array; 
 
     if(m != n || m < 0 || m > 32) return 1;
@@ -230,6 +239,7 @@ magma_int_t magma_get_sgetrf_batched_ntcol(magma_int_t m, magma_int_t n)
 *******************************************************************************/
 magma_int_t magma_get_zgeqrf_batched_ntcol(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t* ntcol_array; 
 
     if(m != n || m < 0 || m > 32) return 1;
@@ -246,6 +256,7 @@ magma_int_t magma_get_zgeqrf_batched_ntcol(magma_int_t m, magma_int_t n)
 /// @see magma_get_zgeqrf_batched_ntcol
 magma_int_t magma_get_cgeqrf_batched_ntcol(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t* ntcol_array; 
 
     if(m != n || m < 0 || m > 32) return 1;
@@ -262,6 +273,7 @@ magma_int_t magma_get_cgeqrf_batched_ntcol(magma_int_t m, magma_int_t n)
 /// @see magma_get_zgeqrf_batched_ntcol
 magma_int_t magma_get_dgeqrf_batched_ntcol(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t* ntcol_array; 
 
     if(m != n || m < 0 || m > 32) return 1;
@@ -278,6 +290,7 @@ magma_int_t magma_get_dgeqrf_batched_ntcol(magma_int_t m, magma_int_t n)
 /// @see magma_get_zgeqrf_batched_ntcol
 magma_int_t magma_get_sgeqrf_batched_ntcol(magma_int_t m, magma_int_t n)
 {
+    MAGMA_TUNE_LOOKUP( m, n );
     magma_int_t* ntcol_array; 
 
     if(m != n || m < 0 || m > 32) return 1;
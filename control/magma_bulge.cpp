@@ -189,6 +189,29 @@ magma_int_t magma_bulge_get_blkcnt(magma_int_t n, magma_int_t nb, magma_int_t Vb
 }
 
 
+/******************************************************************************/
+/// @return number of consecutive kernels of a sweep that one task of the
+/// bulge chasing (hetrd_hb2st) runs. Larger groups improve locality, smaller
+/// groups give more sweeps in flight; a sweep of 2*nbtiles kernels keeps
+/// about 2*nbtiles / (grsiz + 2) sweeps busy, which should exceed
+/// 2*nbthreads. $MAGMA_BULGE_GRSIZ overrides this.
+magma_int_t magma_bulge_get_grsiz(magma_int_t n, magma_int_t nb, magma_int_t nbthreads)
+{
+    const char *grsiz_str = getenv("MAGMA_BULGE_GRSIZ");
+    if ( grsiz_str != NULL ) {
+        char* endptr;
+        magma_int_t grsiz = strtol( grsiz_str, &endptr, 10 );
+        if ( grsiz >= 1 && *endptr == '\0' ) {
+            return grsiz;
+        }
+        fprintf( stderr, "$MAGMA_BULGE_GRSIZ='%s' is an invalid number; ignored.\n",
+                 grsiz_str );
+    }
+    magma_int_t nbtiles = magma_ceildiv(n, nb);
+    return max( 1, min( 8, nbtiles / max( 1, nbthreads ) - 2 ));
+}
+
+
 /******************************************************************************/
 magma_int_t magma_bulge_getlwstg1(magma_int_t n, magma_int_t nb, magma_int_t *lda2)
 {
@@ -8,6 +8,9 @@
        @author Azzam Haidar
        @author Mark Gates
 */
+#include <atomic>
+#include <mutex>
+
 #include "magma_internal.h"
 
 #if defined(_OPENMP)
@@ -245,3 +248,192 @@ void magma_set_omp_numthreads(magma_int_t threads)
     omp_set_num_threads( threads );
 #endif
 }
+
+
+/******************************************************************************/
+// Process-wide thread budget.
+// g_budget_free counts cores not held by any top-level acquire.
+// t_budget_share is the number of cores the calling thread may use: set by
+// acquire for the nested calls it makes, and by MAGMA worker threads;
+// 0 at top level.
+static std::once_flag             g_budget_once;
+static magma_int_t                g_budget_total = 1;
+static std::atomic< magma_int_t > g_budget_free( 0 );
+static thread_local magma_int_t   t_budget_share = 0;
+
+
+/******************************************************************************/
+// @return number of threads in the caller's OpenMP teams, the product of the
+// team sizes of all enclosing parallel regions; 1 outside parallel regions.
+static magma_int_t budget_omp_team()
+{
+    magma_int_t team = 1;
+#if defined(_OPENMP)
+    int level = omp_get_level();
+    for( int l = 1; l <= level; ++l ) {
+        team *= omp_get_team_size( l );
+    }
+#endif
+    return team;
+}
+
+
+/******************************************************************************/
+// Sizes the budget on first use. Inside a parallel region, nested regions
+// get one thread, so magma_get_parallel_numthreads may see only 1;
+// the caller's teams already run that many threads, so take the larger.
+static void budget_init()
+{
+    g_budget_total = max( magma_get_parallel_numthreads(), budget_omp_team() );
+    g_budget_free.store( g_budget_total );
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Reserves host threads for a parallel section of MAGMA, so that MAGMA
+    workers, OpenMP regions, and BLAS do not together run more threads than
+    there are cores. Example use:
+
+        magma_thread_budget_t budget;
+        magma_int_t nthread = magma_thread_budget_acquire( -1, &budget );
+        magma_set_lapack_numthreads( 1 );
+
+        ... launch nthread workers, each single-threaded BLAS ...
+
+        magma_thread_budget_release( &budget );
+
+    The budget is magma_get_parallel_numthreads when first used.
+    The number granted depends on where the caller runs:
+    -   at top level, cores are taken from the process-wide budget,
+        so concurrent callers on different threads partition the cores;
+    -   nested in another acquire, or in a MAGMA worker thread,
+        up to the caller's share;
+    -   in the caller's own OpenMP parallel region, an equal part of the
+        budget for each thread of the team.
+
+    At least 1 thread, the caller itself, is always granted.
+    LAPACK/BLAS and OpenMP are set to use the threads granted, and nested
+    acquires on the calling thread see them as its share, until release.
+
+    Arguments
+    ---------
+    @param[in]
+    nthread INTEGER
+            Number of threads wanted. If nthread <= 0, all that are available.
+
+    @param[out]
+    budget  magma_thread_budget_t
+            Holds what is needed to release the threads.
+
+    @return Number of threads granted, >= 1.
+
+    @sa magma_thread_budget_release
+    @sa magma_get_parallel_numthreads
+    @ingroup magma_thread
+*******************************************************************************/
+extern "C"
+magma_int_t magma_thread_budget_acquire(
+    magma_int_t nthread, magma_thread_budget_t* budget )
+{
+    std::call_once( g_budget_once, budget_init );
+
+    magma_int_t want = (nthread > 0 ? nthread : g_budget_total);
+    magma_int_t team = budget_omp_team();
+    magma_int_t avail;
+    budget->taken = 0;
+    if ( t_budget_share > 0 ) {
+        avail = t_budget_share;
+    }
+    else if ( team > 1 ) {
+        avail = g_budget_total / team;
+    }
+    else {
+        magma_int_t nfree = g_budget_free.load();
+        magma_int_t take;
+        do {
+            take = max( 0, min( want, nfree ));
+        } while( ! g_budget_free.compare_exchange_weak( nfree, nfree - take ));
+        budget->taken = take;
+        avail = take;
+    }
+    budget->nthread    = max( 1, min( want, avail ));
+    budget->prev_share = t_budget_share;
+    budget->lapack_nthread = magma_get_lapack_numthreads();
+    budget->omp_nthread    = magma_get_omp_numthreads();
+
+    t_budget_share = budget->nthread;
+    magma_set_lapack_numthreads( budget->nthread );
+    magma_set_omp_numthreads( budget->nthread );
+    return budget->nthread;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Returns threads reserved by magma_thread_budget_acquire, and restores
+    the LAPACK/BLAS and OpenMP threads and the caller's share.
+    Acquires on one thread must be released in reverse order.
+
+    Arguments
+    ---------
+    @param[in]
+    budget  magma_thread_budget_t
+            As set by magma_thread_budget_acquire.
+
+    @sa magma_thread_budget_acquire
+    @ingroup magma_thread
+*******************************************************************************/
+extern "C"
+void magma_thread_budget_release( magma_thread_budget_t* budget )
+{
+    magma_set_omp_numthreads( budget->omp_nthread );
+    magma_set_lapack_numthreads( budget->lapack_nthread );
+    t_budget_share = budget->prev_share;
+    g_budget_free += budget->taken;
+    budget->taken = 0;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Sets the number of cores the calling thread may use for nested parallel
+    sections. Worker threads set this when they start, e.g., to 1 when
+    there is one worker per core.
+
+    Arguments
+    ---------
+    @param[in]
+    nthread INTEGER
+            Share of the calling thread; 0 resets it to top level.
+
+    @return Previous share.
+
+    @sa magma_thread_budget_acquire
+    @ingroup magma_thread
+*******************************************************************************/
+extern "C"
+magma_int_t magma_thread_budget_set_share( magma_int_t nthread )
+{
+    magma_int_t prev = t_budget_share;
+    t_budget_share = max( 0, nthread );
+    return prev;
+}
+
+
+/***************************************************************************//**
+    @return Number of threads in the process-wide budget.
+    Unlike magma_get_parallel_numthreads, it is computed only once.
+
+    @sa magma_thread_budget_acquire
+    @ingroup magma_thread
+*******************************************************************************/
+extern "C"
+magma_int_t magma_thread_budget_total()
+{
+    std::call_once( g_budget_once, budget_init );
+    return g_budget_total;
+}
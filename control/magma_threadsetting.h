@@ -24,6 +24,26 @@ magma_int_t magma_get_lapack_numthreads();
 magma_int_t magma_get_parallel_numthreads();
 magma_int_t magma_get_omp_numthreads();
 
+// -----------------------------------------------------------------------------
+// Process-wide budget of host threads, shared by MAGMA worker threads,
+// OpenMP regions, and the BLAS/LAPACK library; see magma_thread_budget_acquire.
+typedef struct magma_thread_budget
+{
+    magma_int_t nthread;            // threads granted to the caller
+    magma_int_t taken;              // cores taken from the process-wide pool
+    magma_int_t prev_share;         // caller's share before acquire
+    magma_int_t lapack_nthread;     // LAPACK/BLAS threads before acquire
+    magma_int_t omp_nthread;        // OpenMP threads before acquire
+} magma_thread_budget_t;
+
+magma_int_t magma_thread_budget_acquire( magma_int_t nthread, magma_thread_budget_t* budget );
+void        magma_thread_budget_release( magma_thread_budget_t* budget );
+magma_int_t magma_thread_budget_set_share( magma_int_t nthread );
+magma_int_t magma_thread_budget_total();
+
+// Persistent worker threads of magma_thread_queue, see thread_queue.cpp.
+void magma_thread_pool_finalize();
+
 #ifdef __cplusplus
 }
 #endif
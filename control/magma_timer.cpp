@@ -6,8 +6,20 @@
        @date February 2023
 */
 
+#include <errno.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "magma_internal.h"
 
+#if defined(HAVE_PAPI)
+#include <papi.h>
+#endif
+
 #if defined( _WIN32 ) || defined( _WIN64 )
 #  include <time.h>
 #  include <sys/timeb.h>
@@ -116,3 +128,433 @@ void magmaf_wtime(double *time)
 {
     *time = magma_wtime();
 }
+
+
+// =============================================================================
+// Profiling regions.
+
+// max. number of PAPI counters per region
+const int MAX_REGION_COUNTERS = 4;
+
+/******************************************************************************/
+// Region in the tree of one thread; children are regions begun inside it.
+struct magma_region_node
+{
+    std::string                        name;
+    magma_region_node*                 parent;
+    std::vector< magma_region_node* >  children;
+    long long  calls;
+    double     time;                                // inclusive
+    double     start;                               // of current call
+    long long  counters     [ MAX_REGION_COUNTERS ];
+    long long  counter_start[ MAX_REGION_COUNTERS ];
+};
+
+struct magma_region_thread
+{
+    int                 id;
+    magma_region_node   root;
+    magma_region_node*  current;
+    int                 papi_set;
+};
+
+// -1 not initialized, 0 off, 1 on
+static std::atomic< int > g_region_state( -1 );
+static std::string g_region_output;
+static std::vector< std::string > g_region_counters;
+static std::vector< magma_region_thread* > g_region_threads;
+static std::mutex g_region_mutex;
+
+static thread_local magma_region_thread* t_region_thread = NULL;
+
+
+/******************************************************************************/
+static magma_region_node* region_node_new( const char* name, magma_region_node* parent )
+{
+    magma_region_node* node = new magma_region_node;
+    node->name   = name;
+    node->parent = parent;
+    node->calls  = 0;
+    node->time   = 0;
+    node->start  = 0;
+    for( int i = 0; i < MAX_REGION_COUNTERS; ++i ) {
+        node->counters[i] = 0;
+        node->counter_start[i] = 0;
+    }
+    return node;
+}
+
+
+/******************************************************************************/
+static void region_node_clear( magma_region_node* node )
+{
+    for( size_t i = 0; i < node->children.size(); ++i ) {
+        region_node_clear( node->children[i] );
+        delete node->children[i];
+    }
+    node->children.clear();
+}
+
+
+/******************************************************************************/
+// Reads PAPI counters of the calling thread into values.
+static void region_read_counters( magma_region_thread* self, long long* values )
+{
+    #if defined(HAVE_PAPI)
+    if ( self->papi_set != PAPI_NULL ) {
+        PAPI_read( self->papi_set, values );
+    }
+    #endif
+}
+
+
+/******************************************************************************/
+// Returns the calling thread's tree, registering the thread on first use.
+static magma_region_thread* region_self()
+{
+    magma_region_thread* self = t_region_thread;
+    if ( self == NULL ) {
+        self = new magma_region_thread;
+        self->root.name   = "";
+        self->root.parent = NULL;
+        self->current     = &self->root;
+        self->papi_set    = -1;  // i.e., PAPI_NULL
+
+        #if defined(HAVE_PAPI)
+        if ( ! g_region_counters.empty() ) {
+            int err = PAPI_create_eventset( &self->papi_set );
+            for( size_t i = 0; i < g_region_counters.size() && err == PAPI_OK; ++i ) {
+                err = PAPI_add_named_event( self->papi_set, g_region_counters[i].c_str() );
+            }
+            if ( err == PAPI_OK ) {
+                err = PAPI_start( self->papi_set );
+            }
+            if ( err != PAPI_OK ) {
+                fprintf( stderr, "Error: PAPI counters for regions failed: %s (%d)\n",
+                         PAPI_strerror(err), err );
+                self->papi_set = PAPI_NULL;
+            }
+        }
+        #endif
+
+        std::lock_guard< std::mutex > lock( g_region_mutex );
+        self->id = (int) g_region_threads.size();
+        g_region_threads.push_back( self );
+        t_region_thread = self;
+    }
+    return self;
+}
+
+
+/******************************************************************************/
+static void region_report_atexit()
+{
+    magma_region_report( g_region_output.c_str() );
+}
+
+
+/******************************************************************************/
+// Reads $MAGMA_REGIONS and $MAGMA_REGIONS_PAPI; returns new state.
+static int region_init()
+{
+    std::lock_guard< std::mutex > lock( g_region_mutex );
+    int state = g_region_state.load();
+    if ( state >= 0 ) {
+        return state;
+    }
+
+    const char* env = getenv( "MAGMA_REGIONS" );
+    state = (env != NULL && env[0] != '\0' && strcmp( env, "0" ) != 0);
+    if ( state ) {
+        // "1" or "table" prints a table to stdout, else env is a file name
+        if ( strcmp( env, "1" ) != 0 && strcmp( env, "table" ) != 0 ) {
+            g_region_output = env;
+        }
+        atexit( region_report_atexit );
+
+        #if defined(HAVE_PAPI)
+        const char* papi = getenv( "MAGMA_REGIONS_PAPI" );
+        if ( papi != NULL && papi[0] != '\0' ) {
+            if ( PAPI_is_initialized() == PAPI_NOT_INITED ) {
+                PAPI_library_init( PAPI_VER_CURRENT );
+            }
+            PAPI_thread_init( (unsigned long (*)(void)) pthread_self );
+            std::string list = papi;
+            size_t begin = 0;
+            while( begin <= list.size()
+                   && (int) g_region_counters.size() < MAX_REGION_COUNTERS )
+            {
+                size_t end = std::min( list.find( ',', begin ), list.size() );
+                if ( end > begin ) {
+                    g_region_counters.push_back( list.substr( begin, end - begin ));
+                }
+                begin = end + 1;
+            }
+        }
+        #endif
+    }
+    g_region_state = state;
+    return state;
+}
+
+
+/***************************************************************************//**
+    Begins a profiling region on the calling thread. Regions nest: a region
+    begun inside another is its child. Each thread aggregates the number
+    of calls, inclusive and exclusive time, and optionally PAPI counters
+    of each region; see magma_region_report().
+
+    Regions are enabled by setting $MAGMA_REGIONS, and reported at exit:
+    - "1" or "table" prints a table to stdout,
+    - a file name ending in ".json" writes JSON to that file,
+    - any other file name writes a table to that file.
+
+    If MAGMA was compiled with HAVE_PAPI, $MAGMA_REGIONS_PAPI can be a comma
+    separated list of up to 4 PAPI events, e.g., "PAPI_DP_OPS,PAPI_L2_TCM".
+
+    When disabled, begin and end return after checking a flag.
+    In C++, the magma_region class in magma_timer.h ends the region when it
+    goes out of scope.
+
+    @param[in]
+    name    Name of region. Regions with the same name and parent are the
+            same region.
+
+    @ingroup magma_timer
+*******************************************************************************/
+extern "C"
+void magma_region_begin( const char* name )
+{
+    int state = g_region_state.load( std::memory_order_relaxed );
+    if ( state <= 0 ) {
+        if ( state == 0 || region_init() == 0 ) {
+            return;
+        }
+    }
+
+    magma_region_thread* self = region_self();
+    magma_region_node* parent = self->current;
+    magma_region_node* node = NULL;
+    for( size_t i = 0; i < parent->children.size(); ++i ) {
+        if ( parent->children[i]->name == name ) {
+            node = parent->children[i];
+            break;
+        }
+    }
+    if ( node == NULL ) {
+        node = region_node_new( name, parent );
+        std::lock_guard< std::mutex > lock( g_region_mutex );
+        parent->children.push_back( node );
+    }
+    self->current = node;
+    region_read_counters( self, node->counter_start );
+    node->start = magma_wtime();
+}
+
+
+/***************************************************************************//**
+    Ends the innermost region named name on the calling thread, and any
+    regions begun inside it that are still open, e.g., after an error
+    jumped past their end.
+
+    @param[in]
+    name    Name of region, as passed to magma_region_begin().
+            If NULL, ends the innermost region.
+
+    @ingroup magma_timer
+*******************************************************************************/
+extern "C"
+void magma_region_end( const char* name )
+{
+    if ( g_region_state.load( std::memory_order_relaxed ) <= 0 ) {
+        return;
+    }
+
+    double time = magma_wtime();
+    magma_region_thread* self = region_self();
+    magma_region_node* last = self->current;
+    if ( name != NULL ) {
+        while( last != &self->root && last->name != name ) {
+            last = last->parent;
+        }
+    }
+    if ( last == &self->root ) {
+        return;  // not open
+    }
+
+    long long values[ MAX_REGION_COUNTERS ] = { 0 };
+    region_read_counters( self, values );
+    magma_region_node* node = self->current;
+    while( true ) {
+        node->calls += 1;
+        node->time  += time - node->start;
+        for( int i = 0; i < MAX_REGION_COUNTERS; ++i ) {
+            node->counters[i] += values[i] - node->counter_start[i];
+        }
+        if ( node == last ) {
+            break;
+        }
+        node = node->parent;
+    }
+    self->current = last->parent;
+}
+
+
+/******************************************************************************/
+static void region_print_table( FILE* file, const magma_region_node* node,
+                                int thread, int depth )
+{
+    double exclusive = node->time;
+    for( size_t i = 0; i < node->children.size(); ++i ) {
+        exclusive -= node->children[i]->time;
+    }
+    fprintf( file, "%6d  %10lld  %12.6f  %12.6f", thread, node->calls, node->time, exclusive );
+    for( size_t i = 0; i < g_region_counters.size(); ++i ) {
+        fprintf( file, "  %14lld", node->counters[i] );
+    }
+    fprintf( file, "  %*s%s\n", 2*depth, "", node->name.c_str() );
+    for( size_t i = 0; i < node->children.size(); ++i ) {
+        region_print_table( file, node->children[i], thread, depth + 1 );
+    }
+}
+
+
+/******************************************************************************/
+// Writes str as a JSON string, with quotes.
+static void region_json_string( FILE* file, const std::string& str )
+{
+    fputc( '"', file );
+    for( size_t i = 0; i < str.size(); ++i ) {
+        unsigned char c = str[i];
+        if ( c == '"' || c == '\\' )
+            fprintf( file, "\\%c", c );
+        else if ( c < 0x20 )
+            fprintf( file, "\\u%04x", c );
+        else
+            fputc( c, file );
+    }
+    fputc( '"', file );
+}
+
+
+/******************************************************************************/
+static void region_print_json( FILE* file, const magma_region_node* node, int indent )
+{
+    double exclusive = node->time;
+    for( size_t i = 0; i < node->children.size(); ++i ) {
+        exclusive -= node->children[i]->time;
+    }
+    fprintf( file, "%*s{\"name\": ", indent, "" );
+    region_json_string( file, node->name );
+    fprintf( file, ", \"calls\": %lld, \"inclusive\": %.9g, \"exclusive\": %.9g",
+             node->calls, node->time, exclusive );
+    if ( ! g_region_counters.empty() ) {
+        fprintf( file, ", \"counters\": [" );
+        for( size_t i = 0; i < g_region_counters.size(); ++i ) {
+            fprintf( file, "%s%lld", (i > 0 ? ", " : ""), node->counters[i] );
+        }
+        fprintf( file, "]" );
+    }
+    fprintf( file, ", \"children\": [" );
+    for( size_t i = 0; i < node->children.size(); ++i ) {
+        fprintf( file, "%s\n", (i > 0 ? "," : "") );
+        region_print_json( file, node->children[i], indent + 2 );
+    }
+    fprintf( file, "]}" );
+}
+
+
+/***************************************************************************//**
+    Writes the regions of all threads, as a table or JSON.
+    Times are in seconds; exclusive time excludes the child regions.
+    Regions still open are not counted. Threads should not be in regions
+    while the report is written.
+
+    @param[in]
+    filename    If NULL or empty, prints a table to stdout.
+                If it ends in ".json", writes JSON,
+                else writes a table.
+
+    @ingroup magma_timer
+*******************************************************************************/
+extern "C"
+void magma_region_report( const char* filename )
+{
+    if ( g_region_state.load() <= 0 ) {
+        return;
+    }
+
+    FILE* file = stdout;
+    bool json = false;
+    if ( filename != NULL && filename[0] != '\0' ) {
+        size_t len = strlen( filename );
+        json = (len >= 5 && strcmp( filename + len - 5, ".json" ) == 0);
+        file = fopen( filename, "w" );
+        if ( file == NULL ) {
+            fprintf( stderr, "Can't open file '%s': %s (%d)\n",
+                     filename, strerror( errno ), errno );
+            return;
+        }
+    }
+
+    std::lock_guard< std::mutex > lock( g_region_mutex );
+    if ( json ) {
+        fprintf( file, "{\n\"unit\": \"s\",\n\"counters\": [" );
+        for( size_t i = 0; i < g_region_counters.size(); ++i ) {
+            fprintf( file, "%s", (i > 0 ? ", " : "") );
+            region_json_string( file, g_region_counters[i] );
+        }
+        fprintf( file, "],\n\"threads\": [" );
+        bool first = true;
+        for( size_t t = 0; t < g_region_threads.size(); ++t ) {
+            const magma_region_node* root = &g_region_threads[t]->root;
+            if ( root->children.empty() ) {
+                continue;
+            }
+            fprintf( file, "%s\n  {\"thread\": %d, \"regions\": [",
+                     (first ? "" : ","), g_region_threads[t]->id );
+            for( size_t i = 0; i < root->children.size(); ++i ) {
+                fprintf( file, "%s\n", (i > 0 ? "," : "") );
+                region_print_json( file, root->children[i], 4 );
+            }
+            fprintf( file, "]}" );
+            first = false;
+        }
+        fprintf( file, "\n]\n}\n" );
+    }
+    else {
+        fprintf( file, "%% MAGMA regions, times in seconds\n" );
+        fprintf( file, "%%thread       calls     inclusive     exclusive" );
+        for( size_t i = 0; i < g_region_counters.size(); ++i ) {
+            fprintf( file, "  %14.14s", g_region_counters[i].c_str() );
+        }
+        fprintf( file, "  region\n" );
+        for( size_t t = 0; t < g_region_threads.size(); ++t ) {
+            const magma_region_node* root = &g_region_threads[t]->root;
+            for( size_t i = 0; i < root->children.size(); ++i ) {
+                region_print_table( file, root->children[i], g_region_threads[t]->id, 0 );
+            }
+        }
+    }
+    fflush( file );
+    if ( file != stdout ) {
+        fclose( file );
+    }
+}
+
+
+/***************************************************************************//**
+    Clears the regions of all threads, e.g., between runs of a tester.
+    Threads must not be in regions.
+
+    @ingroup magma_timer
+*******************************************************************************/
+extern "C"
+void magma_region_reset( void )
+{
+    std::lock_guard< std::mutex > lock( g_region_mutex );
+    for( size_t t = 0; t < g_region_threads.size(); ++t ) {
+        region_node_clear( &g_region_threads[t]->root );
+        g_region_threads[t]->current = &g_region_threads[t]->root;
+    }
+}
@@ -244,4 +244,39 @@ static inline int timer_snprintf( char* str, size_t size, const char* format, ..
     return len;
 }
 
+
+/***************************************************************************//**
+    Profiling region that ends when it goes out of scope, e.g.,
+
+        {
+            magma_region region( "factor" );
+            ...
+        }
+
+    Do not use in functions that jump past it with goto; use
+    magma_region_begin() and magma_region_end() there.
+
+    @ingroup magma_timer
+*******************************************************************************/
+class magma_region
+{
+public:
+    explicit magma_region( const char* in_name ):
+        name( in_name )
+    {
+        magma_region_begin( name );
+    }
+
+    ~magma_region()
+    {
+        magma_region_end( name );
+    }
+
+private:
+    magma_region( const magma_region& );
+    magma_region& operator = ( const magma_region& );
+
+    const char* name;
+};
+
 #endif        //  #ifndef MAGMA_TIMER_H
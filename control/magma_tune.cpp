@@ -0,0 +1,319 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Mark Gates
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "magma_internal.h"
+#include "magma_threadsetting.h"
+#include "magma_tune.h"
+
+// Increment when the meaning of a cached value changes;
+// files with another version are ignored, and overwritten by magma_tune_save.
+static const int tune_version = 2;
+
+// 0: not loaded; 1: loaded, no entries for this CPU; 2: has entries.
+// While 1, lookups return after one atomic load.
+static std::atomic< int > g_tune_state( 0 );
+static std::once_flag     g_tune_once;
+static std::mutex         g_tune_mutex;
+
+static std::string        g_tune_cpu;
+static magma_int_t        g_tune_threads = 0;
+
+// entries for this CPU, key is (threads, arch, name, m, n);
+// arch is the GPU architecture for device-dependent queries, else 0
+typedef std::tuple< magma_int_t, magma_int_t, std::string, magma_int_t, magma_int_t > tune_key_t;
+static std::map< tune_key_t, magma_int_t > g_tune_entries;
+
+// lines for other CPUs, written back unchanged on save
+static std::vector< std::string > g_tune_other;
+
+
+/******************************************************************************/
+// @return cache file name, or empty string if the cache is disabled.
+static std::string tune_filename()
+{
+    const char* env = getenv( "MAGMA_TUNE_CACHE" );
+    if ( env != NULL ) {
+        return std::string( env );
+    }
+    const char* home = getenv( "HOME" );
+    if ( home == NULL || home[0] == '\0' ) {
+        return std::string();
+    }
+    return std::string( home ) + "/.magma_tune";
+}
+
+
+/******************************************************************************/
+// @return CPU model, e.g., "Intel(R) Xeon(R) Gold 6140 CPU @ 2.30GHz",
+// or "unknown". Tabs are replaced, since they separate fields in the file.
+static std::string tune_cpu_model()
+{
+    std::string model;
+    FILE* f = fopen( "/proc/cpuinfo", "r" );
+    if ( f != NULL ) {
+        char line[ 1024 ];
+        while ( fgets( line, sizeof(line), f ) != NULL ) {
+            if ( strncmp( line, "model name", 10 ) == 0 ) {
+                const char* colon = strchr( line, ':' );
+                if ( colon != NULL ) {
+                    model = colon + 1;
+                }
+                break;
+            }
+        }
+        fclose( f );
+    }
+    for( size_t i = 0; i < model.size(); ++i ) {
+        if ( model[i] == '\t' || model[i] == '\n' ) {
+            model[i] = ' ';
+        }
+    }
+    size_t begin = model.find_first_not_of( ' ' );
+    size_t end   = model.find_last_not_of( ' ' );
+    if ( begin == std::string::npos ) {
+        return std::string( "unknown" );
+    }
+    return model.substr( begin, end - begin + 1 );
+}
+
+
+/******************************************************************************/
+// Sizes are rounded up to a power of 2, so a value tuned for one size
+// applies to nearby sizes. Sizes <= 0 (queries without a size) give 0.
+static magma_int_t tune_bucket( magma_int_t x )
+{
+    if ( x <= 0 ) {
+        return 0;
+    }
+    magma_int_t b = 1;
+    while ( b < x ) {
+        b *= 2;
+    }
+    return b;
+}
+
+
+/******************************************************************************/
+// Reads the cache file. Called once, by the first query.
+//
+// File format: a version line, then one entry per line, with tab-separated
+//     cpu model, threads, arch, query name, m, n, value
+// Lines starting with # are comments.
+static void tune_load()
+{
+    g_tune_cpu     = tune_cpu_model();
+    g_tune_threads = magma_get_parallel_numthreads();
+
+    std::string filename = tune_filename();
+    FILE* f = NULL;
+    if ( ! filename.empty() ) {
+        f = fopen( filename.c_str(), "r" );
+    }
+    if ( f != NULL ) {
+        char line[ 1024 ];
+        int version = 0;
+        if ( fgets( line, sizeof(line), f ) != NULL
+             && sscanf( line, "# magma_tune version %d", &version ) == 1
+             && version == tune_version )
+        {
+            while ( fgets( line, sizeof(line), f ) != NULL ) {
+                line[ strcspn( line, "\r\n" ) ] = '\0';
+                if ( line[0] == '#' || line[0] == '\0' ) {
+                    continue;
+                }
+                // split into 7 fields
+                char* field[ 7 ];
+                int nfield = 0;
+                char* p = line;
+                while ( nfield < 7 ) {
+                    field[ nfield++ ] = p;
+                    p = strchr( p, '\t' );
+                    if ( p == NULL ) {
+                        break;
+                    }
+                    *p++ = '\0';
+                }
+                if ( nfield != 7 || p != NULL ) {
+                    continue;  // malformed
+                }
+                if ( g_tune_cpu == field[0] ) {
+                    tune_key_t key( atoll( field[1] ), atoll( field[2] ), field[3],
+                                    atoll( field[4] ), atoll( field[5] ));
+                    g_tune_entries[ key ] = atoll( field[6] );
+                }
+                else {
+                    std::string other = field[0];
+                    for( int i = 1; i < 7; ++i ) {
+                        other += '\t';
+                        other += field[i];
+                    }
+                    g_tune_other.push_back( other );
+                }
+            }
+        }
+        fclose( f );
+    }
+    g_tune_state.store( g_tune_entries.empty() ? 1 : 2, std::memory_order_release );
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Looks up a tuned value in the cache, for the current CPU and number of
+    threads, and for device-dependent queries the architecture of the
+    current GPU.
+    Called at the top of magma_get_* queries via MAGMA_TUNE_LOOKUP,
+    MAGMA_TUNE_LOOKUP_HOST, or their _THREADS variants; if nothing is
+    found, the query uses its built-in table.
+
+    Arguments
+    ---------
+    @param[in]
+    name    Query name, e.g., "magma_get_zbulge_nb".
+
+    @param[in]
+    device  1 if the value depends on the GPU, so it is kept per
+            magma_getdevice_arch; 0 if it only sizes host work.
+
+    @param[in]
+    threads Number of threads the query is for, e.g., its nbthreads
+            argument, or 0 for magma_get_parallel_numthreads when the
+            cache was first used.
+
+    @param[in]
+    m       Size the query depends on, or 0. Rounded up to a power of 2.
+
+    @param[in]
+    n       Size the query depends on, or 0. Rounded up to a power of 2.
+
+    @param[out]
+    value   On success, the tuned value.
+
+    @return 1 if found, else 0.
+
+    @ingroup magma_tuning
+*******************************************************************************/
+extern "C"
+magma_int_t magma_tune_lookup(
+    const char* name, magma_int_t device, magma_int_t threads,
+    magma_int_t m, magma_int_t n, magma_int_t* value )
+{
+    int state = g_tune_state.load( std::memory_order_acquire );
+    if ( state == 0 ) {
+        std::call_once( g_tune_once, tune_load );
+        state = g_tune_state.load( std::memory_order_acquire );
+    }
+    if ( state != 2 ) {
+        return 0;
+    }
+
+    tune_key_t key( (threads > 0 ? threads : g_tune_threads),
+                    (device ? magma_getdevice_arch() : 0), name,
+                    tune_bucket( m ), tune_bucket( n ));
+    std::lock_guard< std::mutex > lock( g_tune_mutex );
+    auto iter = g_tune_entries.find( key );
+    if ( iter == g_tune_entries.end() ) {
+        return 0;
+    }
+    *value = iter->second;
+    return 1;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Sets a tuned value for the current CPU and the given number of threads,
+    and for device-dependent queries the current GPU architecture.
+    It is used by subsequent queries in this process;
+    call magma_tune_save to keep it for future runs.
+    Arguments are as for magma_tune_lookup.
+
+    @ingroup magma_tuning
+*******************************************************************************/
+extern "C"
+void magma_tune_set(
+    const char* name, magma_int_t device, magma_int_t threads,
+    magma_int_t m, magma_int_t n, magma_int_t value )
+{
+    std::call_once( g_tune_once, tune_load );
+
+    tune_key_t key( (threads > 0 ? threads : g_tune_threads),
+                    (device ? magma_getdevice_arch() : 0), name,
+                    tune_bucket( m ), tune_bucket( n ));
+    std::lock_guard< std::mutex > lock( g_tune_mutex );
+    g_tune_entries[ key ] = value;
+    g_tune_state.store( 2, std::memory_order_release );
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Writes the cache to $MAGMA_TUNE_CACHE (default $HOME/.magma_tune),
+    keeping entries for other CPUs that were in the file.
+    The file is written to a temporary file, then renamed,
+    so concurrent readers see either the old or new file.
+
+    @return MAGMA_SUCCESS, or MAGMA_ERR_FILESYSTEM if the file can't be
+    written or the cache is disabled.
+
+    @ingroup magma_tuning
+*******************************************************************************/
+extern "C"
+magma_int_t magma_tune_save()
+{
+    std::call_once( g_tune_once, tune_load );
+
+    std::string filename = tune_filename();
+    if ( filename.empty() ) {
+        return MAGMA_ERR_FILESYSTEM;
+    }
+    std::string tmpname = filename + ".tmp";
+
+    std::lock_guard< std::mutex > lock( g_tune_mutex );
+    FILE* f = fopen( tmpname.c_str(), "w" );
+    if ( f == NULL ) {
+        return MAGMA_ERR_FILESYSTEM;
+    }
+    fprintf( f, "# magma_tune version %d\n", tune_version );
+    fprintf( f, "# MAGMA %d.%d.%d; cpu, threads, arch, query, m, n, value\n",
+             MAGMA_VERSION_MAJOR, MAGMA_VERSION_MINOR, MAGMA_VERSION_MICRO );
+    for( size_t i = 0; i < g_tune_other.size(); ++i ) {
+        fprintf( f, "%s\n", g_tune_other[i].c_str() );
+    }
+    for( auto iter = g_tune_entries.begin(); iter != g_tune_entries.end(); ++iter ) {
+        const tune_key_t& key = iter->first;
+        fprintf( f, "%s\t%lld\t%lld\t%s\t%lld\t%lld\t%lld\n", g_tune_cpu.c_str(),
+                 (long long) std::get<0>( key ), (long long) std::get<1>( key ),
+                 std::get<2>( key ).c_str(),
+                 (long long) std::get<3>( key ), (long long) std::get<4>( key ),
+                 (long long) iter->second );
+    }
+    bool ok = (ferror( f ) == 0);
+    ok = (fclose( f ) == 0) && ok;
+    if ( ! ok || rename( tmpname.c_str(), filename.c_str() ) != 0 ) {
+        remove( tmpname.c_str() );
+        return MAGMA_ERR_FILESYSTEM;
+    }
+    return MAGMA_SUCCESS;
+}
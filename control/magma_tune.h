@@ -0,0 +1,66 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Mark Gates
+*/
+
+#ifndef MAGMA_TUNE_H
+#define MAGMA_TUNE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// Internal routines
+//
+// Cache of tuned values for the magma_get_* queries, keyed by CPU model,
+// number of threads, GPU architecture (for device-dependent queries),
+// query name, and m, n rounded up to a power of 2.
+// It is read from $MAGMA_TUNE_CACHE (default $HOME/.magma_tune) on first use;
+// set MAGMA_TUNE_CACHE to an empty string to disable it.
+// Values are found by testing/testing_ztune_cpu.
+
+magma_int_t magma_tune_lookup( const char* name, magma_int_t device,
+                               magma_int_t threads,
+                               magma_int_t m, magma_int_t n,
+                               magma_int_t* value );
+
+void magma_tune_set( const char* name, magma_int_t device,
+                     magma_int_t threads,
+                     magma_int_t m, magma_int_t n,
+                     magma_int_t value );
+
+magma_int_t magma_tune_save();
+
+#ifdef __cplusplus
+}
+#endif
+
+// -----------------------------------------------------------------------------
+// At the top of a magma_get_* query, returns the cached value, if any.
+// MAGMA_TUNE_LOOKUP keeps values per GPU architecture;
+// MAGMA_TUNE_LOOKUP_HOST is for queries that only size host work.
+// The _THREADS variants are for queries that take the number of threads
+// as an argument; the others use the number of threads of the process.
+#define MAGMA_TUNE_LOOKUP_DEVICE_( device, threads, m, n )              \
+    do {                                                                \
+        magma_int_t tune_value_;                                        \
+        if ( magma_tune_lookup( __func__, (device), (threads),          \
+                                (m), (n), &tune_value_ ))               \
+            return tune_value_;                                         \
+    } while( 0 )
+
+#define MAGMA_TUNE_LOOKUP( m, n )       MAGMA_TUNE_LOOKUP_DEVICE_( 1, 0, m, n )
+#define MAGMA_TUNE_LOOKUP_HOST( m, n )  MAGMA_TUNE_LOOKUP_DEVICE_( 0, 0, m, n )
+
+#define MAGMA_TUNE_LOOKUP_THREADS( threads, m, n )       \
+    MAGMA_TUNE_LOOKUP_DEVICE_( 1, threads, m, n )
+#define MAGMA_TUNE_LOOKUP_HOST_THREADS( threads, m, n )  \
+    MAGMA_TUNE_LOOKUP_DEVICE_( 0, threads, m, n )
+
+#endif  // MAGMA_TUNE_H
@@ -0,0 +1,394 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Mark Gates
+*/
+
+#include "task_graph.hpp"
+#include "trace.h"
+
+// If err, prints error and throws exception.
+static void check( int err )
+{
+    if ( err != 0 ) {
+        fprintf( stderr, "Error: %s (%d)\n", strerror(err), err );
+        throw std::exception();
+    }
+}
+
+
+/***************************************************************************//**
+    @class magma_task_graph
+
+    Purpose
+    -------
+    Implements a task graph (DAG) runtime on top of \ref magma_thread_queue.
+
+    A single thread inserts tasks in a sequential order, declaring for each
+    task the data regions it reads and writes. The runtime infers the
+    dependencies from that order: a task that reads a region waits for the
+    last task that wrote it; a task that writes a region also waits for the
+    tasks that read it since. A task is handed to the thread queue as soon as
+    all its predecessors finished, so there are no barriers between phases;
+    the result is the same as executing the tasks one after another in
+    insertion order.
+
+    Regions are identified by address only, e.g., the first element of a
+    tile or column. Tasks are deleted after they run.
+
+    The inserting thread can wait for particular data with acquire(),
+    or for all tasks with wait(). With a window, insert_task() blocks while
+    too many tasks are unfinished, which bounds the memory of large graphs.
+
+    Example
+    -------
+    @code
+    magma_task_graph graph;
+    graph.launch( nthread );
+    for( int k=0; k < nt; ++k ) {
+        graph.insert_task( new panel_task( k ), { magma_readwrite( A(k,k) ) });
+        for( int j=k+1; j < nt; ++j ) {
+            graph.insert_task( new update_task( k, j ),
+                               { magma_read( A(k,k) ), magma_readwrite( A(k,j) ) });
+        }
+    }
+    graph.wait();
+    @endcode
+
+    @ingroup magma_thread
+*******************************************************************************/
+
+
+/******************************************************************************/
+// successor of a node; edges are freed by the thread that finishes the node
+struct magma_task_graph_edge
+{
+    magma_task_graph::node* succ;
+    magma_task_graph_edge*  next;
+};
+
+// marks the successor list of a finished node
+static magma_task_graph_edge g_closed;
+
+
+/******************************************************************************/
+struct magma_task_graph::node
+{
+    magma_task*                            task;    ///<  NULL for acquire
+    std::atomic< magma_int_t >             npred;   ///<  unfinished predecessors, +1 while inserting
+    std::atomic< magma_int_t >             nref;    ///<  references from regions, +1 until finished
+    std::atomic< magma_task_graph_edge* >  succ;    ///<  successors; &g_closed once finished
+    bool                                   done;    ///<  acquire only, protected by mutex
+};
+
+
+/***************************************************************************//**
+    Task pushed to the thread queue once a node is ready.
+    Runs the node's task, then releases its successors.
+*******************************************************************************/
+class magma_task_graph_run: public magma_task
+{
+public:
+    magma_task_graph_run( magma_task_graph* in_graph, magma_task_graph::node* in_node ):
+        graph( in_graph ),
+        n    ( in_node  )
+    {}
+
+    virtual void run()
+    {
+        trace_cpu_start( 0, "task", "task" );
+        n->task->run();
+        trace_cpu_end( 0 );
+        delete n->task;
+        n->task = NULL;
+        graph->complete( n );
+    }
+
+private:
+    magma_task_graph*       graph;
+    magma_task_graph::node* n;
+};
+
+
+/***************************************************************************//**
+    Creates graph with NO threads. Use launch() to create threads.
+*******************************************************************************/
+magma_task_graph::magma_task_graph():
+    queue    (),
+    regions  (),
+    ninflight( 0 ),
+    throttled( false ),
+    window   ( 0 )
+{
+    check( pthread_mutex_init( &mutex, NULL ));
+    check( pthread_cond_init(  &cond,  NULL ));
+}
+
+
+/***************************************************************************//**
+    Calls quit(), then deallocates data.
+*******************************************************************************/
+magma_task_graph::~magma_task_graph()
+{
+    quit();
+    check( pthread_mutex_destroy( &mutex ));
+    check( pthread_cond_destroy( &cond ));
+}
+
+
+/***************************************************************************//**
+    Creates threads.
+    @param[in] in_nthread    Number of threads to launch.
+    @param[in] in_window     Max. number of unfinished tasks before insert_task
+                             blocks; 0 is unlimited.
+*******************************************************************************/
+void magma_task_graph::launch( magma_int_t in_nthread, magma_int_t in_window )
+{
+    window = max( 0, in_window );
+    queue.launch( in_nthread );
+}
+
+
+/***************************************************************************//**
+    Makes succ wait for pred, unless pred already finished.
+*******************************************************************************/
+void magma_task_graph::add_edge( node* pred, node* succ )
+{
+    if ( pred == NULL || pred == succ ) {
+        return;
+    }
+    magma_task_graph_edge* e = new magma_task_graph_edge;
+    e->succ = succ;
+    succ->npred += 1;
+    magma_task_graph_edge* head = pred->succ.load();
+    do {
+        if ( head == &g_closed ) {
+            succ->npred -= 1;
+            delete e;
+            return;
+        }
+        e->next = head;
+    } while( ! pred->succ.compare_exchange_weak( head, e ));
+}
+
+
+/***************************************************************************//**
+    Drops one reference; deletes the node when it was the last.
+*******************************************************************************/
+void magma_task_graph::release( node* n )
+{
+    if ( n != NULL && n->nref.fetch_sub( 1 ) == 1 ) {
+        delete n;
+    }
+}
+
+
+/***************************************************************************//**
+    Called when all predecessors of n finished.
+*******************************************************************************/
+void magma_task_graph::ready( node* n )
+{
+    if ( n->task == NULL ) {
+        // acquire; inserting thread deletes the node
+        check( pthread_mutex_lock( &mutex ));
+        n->done = true;
+        check( pthread_cond_broadcast( &cond ));
+        check( pthread_mutex_unlock( &mutex ));
+    }
+    else {
+        queue.push_task( new magma_task_graph_run( this, n ));
+    }
+}
+
+
+/***************************************************************************//**
+    Called by the worker after the task of n finished.
+    Closes the successor list and starts successors that became ready.
+*******************************************************************************/
+void magma_task_graph::complete( node* n )
+{
+    magma_task_graph_edge* e = n->succ.exchange( &g_closed );
+    while( e != NULL ) {
+        // e belongs to n, but e->succ may finish and be deleted once released
+        magma_task_graph_edge* next = e->next;
+        node* succ = e->succ;
+        delete e;
+        if ( succ->npred.fetch_sub( 1 ) == 1 ) {
+            ready( succ );
+        }
+        e = next;
+    }
+
+    magma_int_t left = --ninflight;
+    if ( left == window/2 && throttled.load() ) {
+        check( pthread_mutex_lock( &mutex ));
+        check( pthread_cond_broadcast( &cond ));
+        check( pthread_mutex_unlock( &mutex ));
+    }
+    release( n );
+}
+
+
+/***************************************************************************//**
+    Inserts task, which runs once all previously inserted tasks that
+    access the same regions in a conflicting mode finished.
+    Task must be allocated with C++ new; it is deleted after it runs.
+
+    @param[in] task    Task to insert.
+    @param[in] deps    Regions read and written by the task.
+*******************************************************************************/
+void magma_task_graph::insert_task( magma_task* task, std::initializer_list< magma_task_dep > deps )
+{
+    insert_task( task, deps.size(), deps.begin() );
+}
+
+
+/***************************************************************************//**
+    @param[in] task    Task to insert.
+    @param[in] ndep    Number of regions.
+    @param[in] deps    Array of ndep regions read and written by the task.
+*******************************************************************************/
+void magma_task_graph::insert_task( magma_task* task, magma_int_t ndep, const magma_task_dep* deps )
+{
+    // throttle until half of the window finished
+    if ( window > 0 && ninflight.load() >= window ) {
+        check( pthread_mutex_lock( &mutex ));
+        throttled = true;
+        while( ninflight.load() > window/2 ) {
+            check( pthread_cond_wait( &cond, &mutex ));
+        }
+        throttled = false;
+        check( pthread_mutex_unlock( &mutex ));
+    }
+    ninflight += 1;
+
+    node* n = new node;
+    n->task  = task;
+    n->npred = 1;
+    n->nref  = 1;
+    n->succ  = NULL;
+    n->done  = false;
+
+    for( magma_int_t i=0; i < ndep; ++i ) {
+        region& r = regions[ deps[i].ptr ];
+        if ( deps[i].access & MagmaAccessWrite ) {
+            // write after write and write after read
+            add_edge( r.last_writer, n );
+            for( size_t j=0; j < r.readers.size(); ++j ) {
+                add_edge( r.readers[j], n );
+                release( r.readers[j] );
+            }
+            r.readers.clear();
+            release( r.last_writer );
+            r.last_writer = n;
+            n->nref += 1;
+        }
+        else {
+            // read after write
+            add_edge( r.last_writer, n );
+            r.readers.push_back( n );
+            n->nref += 1;
+        }
+    }
+
+    if ( n->npred.fetch_sub( 1 ) == 1 ) {
+        ready( n );
+    }
+}
+
+
+/***************************************************************************//**
+    Blocks until the inserting thread may access the given regions:
+    for read, until their last writers finished;
+    for write, also until their readers finished.
+    Unlike wait(), tasks on other data continue to run.
+
+    @param[in] deps    Regions the caller will read or write.
+*******************************************************************************/
+void magma_task_graph::acquire( std::initializer_list< magma_task_dep > deps )
+{
+    acquire( deps.size(), deps.begin() );
+}
+
+
+/***************************************************************************//**
+    @param[in] ndep    Number of regions.
+    @param[in] deps    Array of ndep regions the caller will read or write.
+*******************************************************************************/
+void magma_task_graph::acquire( magma_int_t ndep, const magma_task_dep* deps )
+{
+    node* n = new node;
+    n->task  = NULL;
+    n->npred = 1;
+    n->nref  = 1;
+    n->succ  = NULL;
+    n->done  = false;
+
+    for( magma_int_t i=0; i < ndep; ++i ) {
+        std::unordered_map< const void*, region >::iterator it = regions.find( deps[i].ptr );
+        if ( it == regions.end() ) {
+            continue;
+        }
+        region& r = it->second;
+        add_edge( r.last_writer, n );
+        if ( deps[i].access & MagmaAccessWrite ) {
+            for( size_t j=0; j < r.readers.size(); ++j ) {
+                add_edge( r.readers[j], n );
+            }
+        }
+    }
+
+    if ( n->npred.fetch_sub( 1 ) != 1 ) {
+        check( pthread_mutex_lock( &mutex ));
+        while( ! n->done ) {
+            check( pthread_cond_wait( &cond, &mutex ));
+        }
+        check( pthread_mutex_unlock( &mutex ));
+    }
+    delete n;
+}
+
+
+/***************************************************************************//**
+    Drops the references of the regions, so finished nodes are deleted.
+*******************************************************************************/
+void magma_task_graph::clear_regions()
+{
+    std::unordered_map< const void*, region >::iterator it;
+    for( it = regions.begin(); it != regions.end(); ++it ) {
+        release( it->second.last_writer );
+        for( size_t j=0; j < it->second.readers.size(); ++j ) {
+            release( it->second.readers[j] );
+        }
+    }
+    regions.clear();
+}
+
+
+/***************************************************************************//**
+    Block until all inserted tasks have been finished.
+    Threads continue to be alive; more tasks can be inserted after wait.
+*******************************************************************************/
+void magma_task_graph::wait()
+{
+    // a task releases its successors before it counts as done in the queue,
+    // so the queue is empty only when the whole graph finished.
+    queue.sync();
+    clear_regions();
+}
+
+
+/***************************************************************************//**
+    Waits for all tasks, then exits all worker threads.
+    It is safe to call quit multiple times.
+    (Destructor also calls quit, but you may prefer to call it explicitly.)
+*******************************************************************************/
+void magma_task_graph::quit()
+{
+    wait();
+    queue.quit();
+}
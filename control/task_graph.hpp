@@ -0,0 +1,104 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Mark Gates
+*/
+
+#ifndef MAGMA_TASK_GRAPH_HPP
+#define MAGMA_TASK_GRAPH_HPP
+
+#include <atomic>
+#include <initializer_list>
+#include <unordered_map>
+#include <vector>
+
+#include "thread_queue.hpp"
+
+
+/***************************************************************************//**
+    Access mode of a task to a data region, see \ref magma_task_graph.
+    @ingroup magma_thread
+*******************************************************************************/
+enum magma_access_t {
+    MagmaAccessRead      = 1,
+    MagmaAccessWrite     = 2,
+    MagmaAccessReadWrite = 3
+};
+
+
+/***************************************************************************//**
+    Data region accessed by a task. The region is identified by its address
+    only; tasks that access the same data must use the same address.
+    @ingroup magma_thread
+*******************************************************************************/
+struct magma_task_dep
+{
+    const void*    ptr;
+    magma_access_t access;
+};
+
+inline magma_task_dep magma_read( const void* ptr )
+{
+    magma_task_dep dep = { ptr, MagmaAccessRead };
+    return dep;
+}
+
+inline magma_task_dep magma_write( const void* ptr )
+{
+    magma_task_dep dep = { ptr, MagmaAccessWrite };
+    return dep;
+}
+
+inline magma_task_dep magma_readwrite( const void* ptr )
+{
+    magma_task_dep dep = { ptr, MagmaAccessReadWrite };
+    return dep;
+}
+
+
+/******************************************************************************/
+class magma_task_graph
+{
+public:
+    magma_task_graph();
+    ~magma_task_graph();
+
+    void launch( magma_int_t in_nthread, magma_int_t in_window=0 );
+    void insert_task( magma_task* task, std::initializer_list< magma_task_dep > deps );
+    void insert_task( magma_task* task, magma_int_t ndep, const magma_task_dep* deps );
+    void acquire( std::initializer_list< magma_task_dep > deps );
+    void acquire( magma_int_t ndep, const magma_task_dep* deps );
+    void wait();
+    void quit();
+
+    struct node;
+
+protected:
+    friend class magma_task_graph_run;
+    void complete( node* n );
+
+private:
+    struct region {
+        node*                last_writer;
+        std::vector< node* > readers;   ///<  readers since last_writer
+    };
+
+    void add_edge( node* pred, node* succ );
+    void release( node* n );
+    void ready( node* n );
+    void clear_regions();
+
+    magma_thread_queue queue;
+    std::unordered_map< const void*, region > regions;  ///<  inserting thread only
+    std::atomic< magma_int_t > ninflight;   ///<  inserted tasks that are not finished
+    std::atomic< bool >        throttled;   ///<  inserting thread waits in insert_task
+    magma_int_t     window;                 ///<  max. ninflight; 0 is unlimited
+    pthread_mutex_t mutex;                  ///<  mutex for cond
+    pthread_cond_t  cond;                   ///<  signals acquire and throttled inserts
+};
+
+#endif        //  #ifndef MAGMA_TASK_GRAPH_HPP
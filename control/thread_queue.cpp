@@ -8,7 +8,12 @@
        @author Mark Gates
 */
 
+#include <stdlib.h>
+#include <new>
+#include <vector>
+
 #include "thread_queue.hpp"
+#include "affinity.h"
 
 // If err, prints error and throws exception.
 static void check( int err )
@@ -23,11 +28,9 @@ static void check( int err )
 /***************************************************************************//**
     @class magma_thread_queue
     
-    TODO: replace with OpenMP tasks.
-    
     Purpose
     -------
-    Implements a thread pool with a multi-producer, multi-consumer queue.
+    Implements a thread pool with work-stealing task deques.
     
     Typical use:
     A main thread creates the queue and tells it to launch worker threads. Then
@@ -78,6 +81,21 @@ static void check( int err )
     }
     @endcode
     
+    Each worker owns a Chase-Lev deque (magma_task_deque). Tasks pushed by a
+    worker (i.e., from inside a task's run) go to its own deque; tasks pushed
+    by other threads go to a shared deque, which is taken in FIFO order.
+    An idle worker takes tasks from its own deque, then from the shared deque,
+    then steals from the other workers. Only idle workers that found no work
+    after spinning touch the mutex, and sync() helps to execute tasks instead
+    of waiting for each task to finish.
+    
+    Worker threads come from a process-wide pool: launch() borrows idle
+    workers, creating more only if needed, and quit() returns them, so
+    repeated launches do not create threads. Pool workers are created bound
+    to CPUs as $MAGMA_PLACEMENT gives, so queues launched concurrently
+    (e.g., under separate magma_thread_budget_acquire grants) run on
+    disjoint cores. magma_finalize exits the pool's threads.
+
     This is similar to python's queue class, but also implements worker threads
     and adds quit() mechanism. sync() is like python's join, but threads do not
     exit, so join would be a misleading name.
@@ -86,8 +104,445 @@ static void check( int err )
 *******************************************************************************/
 
 
+
+
+/******************************************************************************/
+// Pooled allocation of tasks.
+// Tasks are typically created by one thread and deleted by a worker, so each
+// thread keeps free lists of blocks per size class. A block freed by another
+// thread is pushed onto the lock-free remote list of its owner, which takes
+// over the whole list in one exchange when its local list runs empty.
+// The pool of an exited thread is kept and reused by the next new thread.
+namespace {
+
+const size_t pool_nclass   = 4;     // block sizes 64, 128, 256, 512 bytes
+const size_t pool_min_size = 64;
+const size_t header_size   = 16;    // keeps tasks 16-byte aligned
+
+class task_pool;
+
+struct task_header {
+    task_pool* pool;    // NULL if allocated outside the pools
+    size_t     cls;
+};
+
+struct pool_block {
+    pool_block* next;
+};
+
+class task_pool
+{
+public:
+    task_pool():
+        next_orphan( NULL )
+    {
+        for( size_t c=0; c < pool_nclass; ++c ) {
+            local[c] = NULL;
+            remote[c].store( NULL );
+        }
+    }
+
+    void* alloc( size_t cls )
+    {
+        pool_block* block = local[cls];
+        if ( block == NULL ) {
+            block = remote[cls].exchange( NULL, std::memory_order_acquire );
+        }
+        if ( block == NULL ) {
+            block = (pool_block*) malloc( header_size + (pool_min_size << cls) );
+            if ( block == NULL ) {
+                throw std::bad_alloc();
+            }
+            block->next = NULL;
+        }
+        local[cls] = block->next;
+        return block;
+    }
+
+    void free_local( void* ptr, size_t cls )
+    {
+        pool_block* block = (pool_block*) ptr;
+        block->next = local[cls];
+        local[cls] = block;
+    }
+
+    void free_remote( void* ptr, size_t cls )
+    {
+        pool_block* block = (pool_block*) ptr;
+        pool_block* head = remote[cls].load( std::memory_order_relaxed );
+        do {
+            block->next = head;
+        } while( ! remote[cls].compare_exchange_weak(
+                     head, block, std::memory_order_release, std::memory_order_relaxed ));
+    }
+
+    pool_block*                 local [ pool_nclass ];  ///<  owner only
+    std::atomic< pool_block* >  remote[ pool_nclass ];  ///<  blocks freed by other threads
+    task_pool*                  next_orphan;
+};
+
+pthread_mutex_t g_orphan_mutex = PTHREAD_MUTEX_INITIALIZER;
+task_pool*      g_orphans      = NULL;
+
+// Owns the calling thread's pool; hands it over for reuse when the thread exits.
+class task_pool_holder
+{
+public:
+    task_pool_holder():
+        pool( NULL )
+    {}
+
+    ~task_pool_holder()
+    {
+        if ( pool != NULL ) {
+            pthread_mutex_lock( &g_orphan_mutex );
+            pool->next_orphan = g_orphans;
+            g_orphans = pool;
+            pthread_mutex_unlock( &g_orphan_mutex );
+        }
+    }
+
+    task_pool* get()
+    {
+        if ( pool == NULL ) {
+            pthread_mutex_lock( &g_orphan_mutex );
+            if ( g_orphans != NULL ) {
+                pool = g_orphans;
+                g_orphans = pool->next_orphan;
+            }
+            pthread_mutex_unlock( &g_orphan_mutex );
+            if ( pool == NULL ) {
+                pool = new task_pool();
+            }
+        }
+        return pool;
+    }
+
+    task_pool* pool;
+};
+
+thread_local task_pool_holder tls_pool;
+
+// queue and index of the calling thread if it is a worker, see push_task
+thread_local magma_thread_queue* tls_queue = NULL;
+thread_local magma_int_t         tls_index = -1;
+
+// rounds of find_task before an idle worker goes to sleep
+const magma_int_t max_spin = 64;
+
+
+/******************************************************************************/
+// Persistent worker threads, shared by all queues.
+// A worker waits on its own cond until take() assigns it a queue, runs
+// magma_thread_main for that queue until the queue quits, then returns
+// itself to the idle list. All fields are protected by g_pool_mutex.
+struct pool_worker
+{
+    pthread_t           thread;
+    pthread_cond_t      cond;
+    magma_thread_queue* queue;      ///<  assigned queue; NULL while idle
+    int                 cpu;        ///<  CPU it is bound to, or -1
+    bool                quit;       ///<  set by magma_thread_pool_finalize
+    pool_worker*        next_idle;
+};
+
+pthread_mutex_t             g_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+pool_worker*                g_pool_idle  = NULL;
+std::vector< pool_worker* > g_pool_all;     ///<  all workers, in creation order
+std::vector< int >          g_pool_cpus;    ///<  placement order of CPUs
+
+// Assigns n workers to queue, creating workers if too few are idle;
+// stores their threads in threads. Idle workers are reused most recent
+// first, while their caches are warm. New workers take the next CPU in the
+// placement order, so concurrently launched queues get disjoint CPUs as
+// long as the pool has at most one worker per CPU.
+void pool_take( magma_thread_queue* queue, magma_int_t n, pthread_t* threads )
+{
+    check( pthread_mutex_lock( &g_pool_mutex ));
+    if ( g_pool_cpus.empty() ) {
+        const magma_topology& topo = magma_topology::get();
+        g_pool_cpus.resize( topo.num_cpus() );
+        topo.placement( magma_get_placement(), topo.num_cpus(), &g_pool_cpus[0] );
+    }
+    for( magma_int_t i=0; i < n; ++i ) {
+        pool_worker* w = g_pool_idle;
+        if ( w != NULL ) {
+            g_pool_idle = w->next_idle;
+            w->queue = queue;
+            check( pthread_cond_signal( &w->cond ));
+        }
+        else {
+            w = new pool_worker;
+            check( pthread_cond_init( &w->cond, NULL ));
+            w->queue     = queue;
+            w->cpu       = g_pool_cpus[ g_pool_all.size() % g_pool_cpus.size() ];
+            w->quit      = false;
+            w->next_idle = NULL;
+            check( pthread_create( &w->thread, NULL, magma_thread_pool_main, w ));
+            g_pool_all.push_back( w );
+        }
+        threads[i] = w->thread;
+    }
+    check( pthread_mutex_unlock( &g_pool_mutex ));
+}
+
+}  // end namespace
+
+
+/***************************************************************************//**
+    Pool worker's main routine, executed by pthread_create.
+    Binds itself to its CPU once, then serves queues assigned by launch()
+    until magma_thread_pool_finalize.
+    @param[in,out] arg    pool_worker.
+*******************************************************************************/
+extern "C"
+void* magma_thread_pool_main( void* arg )
+{
+    pool_worker* w = (pool_worker*) arg;
+    magma_bind_thread( w->cpu );
+
+    check( pthread_mutex_lock( &g_pool_mutex ));
+    while( true ) {
+        while( w->queue == NULL && ! w->quit ) {
+            check( pthread_cond_wait( &w->cond, &g_pool_mutex ));
+        }
+        magma_thread_queue* queue = w->queue;
+        if ( queue == NULL ) {
+            break;
+        }
+        check( pthread_mutex_unlock( &g_pool_mutex ));
+
+        magma_thread_main( queue );
+
+        // become idle before detaching, so a launch right after the
+        // queue's quit() finds this worker instead of creating another
+        check( pthread_mutex_lock( &g_pool_mutex ));
+        w->queue = NULL;
+        w->next_idle = g_pool_idle;
+        g_pool_idle = w;
+        check( pthread_mutex_unlock( &g_pool_mutex ));
+
+        queue->detach();  // last access to queue
+
+        check( pthread_mutex_lock( &g_pool_mutex ));
+    }
+    check( pthread_mutex_unlock( &g_pool_mutex ));
+    return NULL;
+}
+
+
+/***************************************************************************//**
+    Exits and joins the threads of the worker pool; called by magma_finalize.
+    No queue may be running. Later launches create new workers.
+    @ingroup magma_thread
+*******************************************************************************/
+extern "C"
+void magma_thread_pool_finalize()
+{
+    check( pthread_mutex_lock( &g_pool_mutex ));
+    std::vector< pool_worker* > all;
+    all.swap( g_pool_all );
+    g_pool_idle = NULL;
+    for( size_t i=0; i < all.size(); ++i ) {
+        all[i]->quit = true;
+        check( pthread_cond_signal( &all[i]->cond ));
+    }
+    check( pthread_mutex_unlock( &g_pool_mutex ));
+
+    for( size_t i=0; i < all.size(); ++i ) {
+        check( pthread_join( all[i]->thread, NULL ));
+        check( pthread_cond_destroy( &all[i]->cond ));
+        delete all[i];
+    }
+}
+
+
+/***************************************************************************//**
+    Allocates a task from the calling thread's pool.
+    Tasks larger than the largest size class use malloc.
+*******************************************************************************/
+void* magma_task::operator new( size_t size )
+{
+    size_t cls = 0;
+    while( cls < pool_nclass && (pool_min_size << cls) < size ) {
+        cls += 1;
+    }
+    task_header* header;
+    if ( cls < pool_nclass ) {
+        task_pool* pool = tls_pool.get();
+        header = (task_header*) pool->alloc( cls );
+        header->pool = pool;
+    }
+    else {
+        header = (task_header*) malloc( header_size + size );
+        if ( header == NULL ) {
+            throw std::bad_alloc();
+        }
+        header->pool = NULL;
+    }
+    header->cls = cls;
+    return (char*) header + header_size;
+}
+
+
+/***************************************************************************//**
+    Returns a task to the pool it was allocated from.
+*******************************************************************************/
+void magma_task::operator delete( void* ptr )
+{
+    if ( ptr == NULL ) {
+        return;
+    }
+    task_header* header = (task_header*) ((char*) ptr - header_size);
+    task_pool* pool = header->pool;
+    if ( pool == NULL ) {
+        free( header );
+    }
+    else if ( pool == tls_pool.pool ) {
+        pool->free_local( header, header->cls );
+    }
+    else {
+        pool->free_remote( header, header->cls );
+    }
+}
+
+
+/***************************************************************************//**
+    Creates empty deque.
+*******************************************************************************/
+magma_task_deque::magma_task_deque():
+    top   ( 0 ),
+    bottom( 0 ),
+    arr   ( NULL )
+{
+    array* a = new array;
+    a->size = 256;
+    a->buf  = new std::atomic< magma_task* >[ a->size ];
+    a->prev = NULL;
+    arr.store( a );
+}
+
+
+/***************************************************************************//**
+    Deallocates arrays. Tasks left in the deque are not deleted.
+*******************************************************************************/
+magma_task_deque::~magma_task_deque()
+{
+    array* a = arr.load();
+    while( a != NULL ) {
+        array* prev = a->prev;
+        delete[] a->buf;
+        delete a;
+        a = prev;
+    }
+}
+
+
+/***************************************************************************//**
+    Doubles the capacity. Old arrays are kept until the deque is destroyed,
+    since concurrent thieves may still read from them.
+*******************************************************************************/
+magma_task_deque::array* magma_task_deque::grow( array* a, int64_t b, int64_t t )
+{
+    array* a2 = new array;
+    a2->size = 2*a->size;
+    a2->buf  = new std::atomic< magma_task* >[ a2->size ];
+    a2->prev = a;
+    for( int64_t i = t; i < b; ++i ) {
+        a2->buf[ i & (a2->size - 1) ].store(
+            a->buf[ i & (a->size - 1) ].load( std::memory_order_relaxed ),
+            std::memory_order_relaxed );
+    }
+    arr.store( a2, std::memory_order_release );
+    return a2;
+}
+
+
+/***************************************************************************//**
+    Owner adds task at the bottom.
+    @param[in] task    Task to add.
+*******************************************************************************/
+void magma_task_deque::push( magma_task* task )
+{
+    int64_t b = bottom.load( std::memory_order_relaxed );
+    int64_t t = top.load( std::memory_order_acquire );
+    array*  a = arr.load( std::memory_order_relaxed );
+    if ( b - t > a->size - 1 ) {
+        a = grow( a, b, t );
+    }
+    a->buf[ b & (a->size - 1) ].store( task, std::memory_order_relaxed );
+    bottom.store( b + 1, std::memory_order_release );
+}
+
+
+/***************************************************************************//**
+    Owner takes the most recently pushed task.
+    @return task, or NULL if the deque is empty.
+*******************************************************************************/
+magma_task* magma_task_deque::pop()
+{
+    int64_t b = bottom.load( std::memory_order_relaxed ) - 1;
+    array*  a = arr.load( std::memory_order_relaxed );
+    bottom.store( b, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    int64_t t = top.load( std::memory_order_relaxed );
+
+    magma_task* task = NULL;
+    if ( t <= b ) {
+        task = a->buf[ b & (a->size - 1) ].load( std::memory_order_relaxed );
+        if ( t == b ) {
+            // last task; race against thieves
+            if ( ! top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst,
+                                                std::memory_order_relaxed )) {
+                task = NULL;
+            }
+            bottom.store( b + 1, std::memory_order_relaxed );
+        }
+    }
+    else {
+        bottom.store( b + 1, std::memory_order_relaxed );
+    }
+    return task;
+}
+
+
 /***************************************************************************//**
-    Thread's main routine, executed by pthread_create.
+    Any thread takes the oldest task.
+    @return task, or NULL if the deque is empty or another thread won the race.
+*******************************************************************************/
+magma_task* magma_task_deque::steal()
+{
+    int64_t t = top.load( std::memory_order_acquire );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    int64_t b = bottom.load( std::memory_order_acquire );
+
+    magma_task* task = NULL;
+    if ( t < b ) {
+        array* a = arr.load( std::memory_order_acquire );
+        task = a->buf[ t & (a->size - 1) ].load( std::memory_order_relaxed );
+        if ( ! top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed )) {
+            task = NULL;
+        }
+    }
+    return task;
+}
+
+
+/***************************************************************************//**
+    @return true if the deque has no tasks. Only a hint if other threads
+    are pushing or popping concurrently.
+*******************************************************************************/
+bool magma_task_deque::empty() const
+{
+    int64_t t = top.load( std::memory_order_acquire );
+    int64_t b = bottom.load( std::memory_order_acquire );
+    return b <= t;
+}
+
+
+/***************************************************************************//**
+    Worker's routine for one queue, called by magma_thread_pool_main.
     Executes tasks from queue (given as arg), until a NULL task is returned.
     Deletes each task when it is done.
     @param[in,out] arg    magma_thread_queue to get tasks from.
@@ -96,20 +551,27 @@ extern "C"
 void* magma_thread_main( void* arg )
 {
     magma_thread_queue* queue = (magma_thread_queue*) arg;
+    magma_int_t index = queue->nstarted++;
     magma_task* task;
-    
+
+    // one worker per core, so MAGMA routines called by tasks run serially
+    magma_thread_budget_set_share( 1 );
+    tls_queue = queue;
+    tls_index = index;
     while( true ) {
-        task = queue->pop_task();
+        task = queue->pop_task( index );
         if ( task == NULL ) {
             break;
         }
-        
+
         task->run();
         queue->task_done();
         delete task;
         task = NULL;
     }
-    
+    tls_queue = NULL;
+    tls_index = -1;
+
     return NULL;  // implicitly does pthread_exit
 }
 
@@ -118,12 +580,18 @@ void* magma_thread_main( void* arg )
     Creates queue with NO threads. Use launch() to create threads.
 *******************************************************************************/
 magma_thread_queue::magma_thread_queue():
-    q        (),
+    ext      (),
+    deques   ( NULL  ),
     quit_flag( false ),
     ntask    ( 0     ),
+    epoch    ( 0     ),
+    nsleep   ( 0     ),
+    nstarted ( 0     ),
+    nrunning ( 0     ),
     threads  ( NULL  ),
     nthread  ( 0     )
 {
+    check( pthread_mutex_init( &push_mutex, NULL ));
     check( pthread_mutex_init( &mutex,      NULL ));
     check( pthread_cond_init(  &cond,       NULL ));
     check( pthread_cond_init(  &cond_ntask, NULL ));
@@ -136,6 +604,7 @@ magma_thread_queue::magma_thread_queue():
 magma_thread_queue::~magma_thread_queue()
 {
     quit();
+    check( pthread_mutex_destroy( &push_mutex ));
     check( pthread_mutex_destroy( &mutex ));
     check( pthread_cond_destroy( &cond ));
     check( pthread_cond_destroy( &cond_ntask ));
@@ -143,7 +612,9 @@ magma_thread_queue::~magma_thread_queue()
 
 
 /***************************************************************************//**
-    Creates threads.
+    Takes threads from the worker pool, creating them if too few are idle.
+    With $MAGMA_PLACEMENT set, pool threads are bound to CPUs as the
+    placement policy gives, see magma_topology::placement.
     @param[in] in_nthread    Number of threads to launch.
 *******************************************************************************/
 void magma_thread_queue::launch( magma_int_t in_nthread )
@@ -153,86 +624,166 @@ void magma_thread_queue::launch( magma_int_t in_nthread )
     if ( nthread < 1 ) {
         nthread = 1;
     }
-    threads = new pthread_t[ nthread ];
-    for( magma_int_t i=0; i < nthread; ++i ) {
-        check( pthread_create( &threads[i], NULL, magma_thread_main, this ));
-        //printf( "launch %d (%lx)\n", i, (long) threads[i] );
-    }
+    deques   = new magma_task_deque[ nthread ];
+    threads  = new pthread_t[ nthread ];
+    nrunning = nthread;
+    pool_take( this, nthread, threads );
 }
 
 
 /***************************************************************************//**
     Add task to queue. Task must be allocated with C++ new.
     Increments number of outstanding tasks.
-    Signals threads that are waiting in pop_task().
+    A worker thread pushes onto its own deque, other threads onto the shared
+    deque. Wakes one sleeping worker, if any.
     @param[in] task    Task to queue.
 *******************************************************************************/
 void magma_thread_queue::push_task( magma_task* task )
 {
-    check( pthread_mutex_lock( &mutex ));
-    if ( quit_flag ) {
+    if ( quit_flag.load() ) {
         fprintf( stderr, "Error: push_task() called after quit()\n" );
         throw std::exception();
     }
-    q.push( task );
     ntask += 1;
+    if ( tls_queue == this ) {
+        deques[ tls_index ].push( task );
+    }
+    else {
+        check( pthread_mutex_lock( &push_mutex ));
+        ext.push( task );
+        check( pthread_mutex_unlock( &push_mutex ));
+    }
     //printf( "push; ntask %d\n", ntask );
-    check( pthread_cond_broadcast( &cond ));
-    check( pthread_mutex_unlock( &mutex ));
+
+    // epoch and nsleep are sequentially consistent: either this thread sees
+    // the sleeper, or the sleeper sees the new epoch and does not wait.
+    epoch += 1;
+    if ( nsleep.load() > 0 ) {
+        check( pthread_mutex_lock( &mutex ));
+        check( pthread_cond_signal( &cond ));
+        check( pthread_mutex_unlock( &mutex ));
+    }
+}
+
+
+/***************************************************************************//**
+    Looks once for a task: own deque (newest first), then the shared deque,
+    then steals from the other workers (oldest first).
+    @param[in] index    worker index, or -1 for a thread outside the pool.
+    @return task, or NULL if none was found.
+*******************************************************************************/
+magma_task* magma_thread_queue::find_task( magma_int_t index )
+{
+    magma_task* task = NULL;
+    if ( index >= 0 ) {
+        task = deques[ index ].pop();
+    }
+    if ( task == NULL ) {
+        task = ext.steal();
+    }
+    for( magma_int_t k=1; task == NULL && k <= nthread; ++k ) {
+        magma_int_t victim = (index + k) % nthread;
+        if ( victim != index ) {
+            task = deques[ victim ].steal();
+        }
+    }
+    return task;
+}
+
+
+/***************************************************************************//**
+    @return true if no deque has a task.
+*******************************************************************************/
+bool magma_thread_queue::all_empty() const
+{
+    if ( ! ext.empty() ) {
+        return false;
+    }
+    for( magma_int_t i=0; i < nthread; ++i ) {
+        if ( ! deques[i].empty() ) {
+            return false;
+        }
+    }
+    return true;
 }
 
 
 /***************************************************************************//**
-    Get next task from queue.
+    Get next task for worker index.
     @return next task, blocking until a task is inserted if necesary.
     @return NULL if queue is empty *and* quit() has been called.
-    
+
+    An idle worker retries for a while, then sleeps until the next push.
+
     This does *not* decrement number of outstanding tasks;
     thread should call task_done() when task is completed.
 *******************************************************************************/
-magma_task* magma_thread_queue::pop_task()
+magma_task* magma_thread_queue::pop_task( magma_int_t index )
 {
-    magma_task* task = NULL;
-    check( pthread_mutex_lock( &mutex ));
-    while( q.empty() && ! quit_flag ) {
-        check( pthread_cond_wait( &cond, &mutex ));
-    }
-    // q has item or quit is set (or both)
-    if ( ! q.empty()) {
-        task = q.front();
-        q.pop();
+    magma_int_t spin = 0;
+    while( true ) {
+        magma_int_t e = epoch.load();
+        magma_task* task = find_task( index );
+        if ( task != NULL ) {
+            return task;
+        }
+        if ( quit_flag.load() && all_empty() ) {
+            return NULL;
+        }
+        if ( spin < max_spin ) {
+            spin += 1;
+            magma_yield();
+            continue;
+        }
+        check( pthread_mutex_lock( &mutex ));
+        nsleep += 1;
+        while( epoch.load() == e && ! quit_flag.load() && all_empty() ) {
+            check( pthread_cond_wait( &cond, &mutex ));
+        }
+        nsleep -= 1;
+        check( pthread_mutex_unlock( &mutex ));
+        spin = 0;
     }
-    //printf( "pop;  ntask %d\n", ntask );
-    check( pthread_mutex_unlock( &mutex ));
-    return task;
 }
 
 
 /***************************************************************************//**
     Marks task as finished, decrementing number of outstanding tasks.
-    Signals threads that are waiting in sync().
+    The last task signals threads that are waiting in sync().
 *******************************************************************************/
 void magma_thread_queue::task_done()
 {
-    check( pthread_mutex_lock( &mutex ));
-    ntask -= 1;
-    //printf( "fini; ntask %d\n", ntask );
-    check( pthread_cond_broadcast( &cond_ntask ));
-    check( pthread_mutex_unlock( &mutex ));
+    if ( ntask.fetch_sub( 1 ) == 1 ) {
+        //printf( "fini; ntask 0\n" );
+        check( pthread_mutex_lock( &mutex ));
+        check( pthread_cond_broadcast( &cond_ntask ));
+        check( pthread_mutex_unlock( &mutex ));
+    }
 }
 
 
 /***************************************************************************//**
     Block until all outstanding tasks have been finished.
+    While tasks are waiting, the calling thread executes them itself;
+    then it waits for the tasks still running on workers.
     Threads continue to be alive; more tasks can be pushed after sync.
 *******************************************************************************/
 void magma_thread_queue::sync()
 {
+    magma_int_t index = (tls_queue == this ? tls_index : -1);
+    while( ntask.load() > 0 ) {
+        magma_task* task = find_task( index );
+        if ( task == NULL ) {
+            break;
+        }
+        task->run();
+        task_done();
+        delete task;
+    }
     check( pthread_mutex_lock( &mutex ));
     //printf( "sync; ntask %d [start]\n", ntask );
-    while( ntask > 0 ) {
+    while( ntask.load() > 0 ) {
         check( pthread_cond_wait( &cond_ntask, &mutex ));
-        //printf( "sync; ntask %d\n", ntask );
     }
     //printf( "sync; ntask %d [done]\n", ntask );
     check( pthread_mutex_unlock( &mutex ));
@@ -240,38 +791,54 @@ void magma_thread_queue::sync()
 
 
 /***************************************************************************//**
-    Sets quit_flag, so pop_task() will return NULL once queue is empty,
-    telling threads to exit.
+    Called by a pool worker after it leaves the queue.
+    The last one signals quit(), which may then destroy the queue,
+    so the worker must not access the queue afterwards.
+*******************************************************************************/
+void magma_thread_queue::detach()
+{
+    check( pthread_mutex_lock( &mutex ));
+    nrunning -= 1;
+    if ( nrunning == 0 ) {
+        check( pthread_cond_broadcast( &cond_ntask ));
+    }
+    check( pthread_mutex_unlock( &mutex ));
+}
+
+
+/***************************************************************************//**
+    Sets quit_flag, so pop_task() will return NULL once all deques are empty,
+    telling threads to leave the queue.
     Signals all threads that are waiting in pop_task().
-    Waits for all threads to exit (i.e., joins them).
+    Waits for all threads to leave; they return to the worker pool.
     It is safe to call quit multiple times -- the first time all the threads are
-    joined; subsequent times it does nothing.
+    waited for; subsequent times it does nothing.
     (Destructor also calls quit, but you may prefer to call it explicitly.)
 *******************************************************************************/
 void magma_thread_queue::quit()
 {
     // first, set quit_flag and signal waiting threads
-    bool join = true;
-    check( pthread_mutex_lock( &mutex ));
-    //printf( "quit %d\n", quit_flag );
-    if ( quit_flag ) {
-        join = false;  // quit previously called; don't join again.
-    }
-    else {
-        quit_flag = true;
+    bool join = ! quit_flag.exchange( true );  // false if quit previously called
+    //printf( "quit %d\n", ! join );
+    if ( join ) {
+        check( pthread_mutex_lock( &mutex ));
         check( pthread_cond_broadcast( &cond ));
+        check( pthread_mutex_unlock( &mutex ));
     }
-    check( pthread_mutex_unlock( &mutex ));
-    
-    // next, join all threads
+
+    // next, wait for all threads to leave
     if ( join ) {
         assert( threads != NULL );
-        for( magma_int_t i=0; i < nthread; ++i ) {
-            check( pthread_join( threads[i], NULL ));
-            //printf( "joined %d (%lx)\n", i, (long) threads[i] );
+        check( pthread_mutex_lock( &mutex ));
+        while( nrunning > 0 ) {
+            check( pthread_cond_wait( &cond_ntask, &mutex ));
         }
+        check( pthread_mutex_unlock( &mutex ));
         delete[] threads;
         threads = NULL;
+        delete[] deques;
+        deques = NULL;
+        nthread = 0;
     }
 }
 
@@ -11,7 +11,7 @@
 #ifndef MAGMA_THREAD_HPP
 #define MAGMA_THREAD_HPP
 
-#include <queue>
+#include <atomic>
 
 #include "magma_internal.h"
 
@@ -20,10 +20,15 @@
 extern "C"
 void* magma_thread_main( void* arg );
 
+extern "C"
+void* magma_thread_pool_main( void* arg );
+
 
 /***************************************************************************//**
     Super class for tasks used with \ref magma_thread_queue.
     Each task should sub-class this and implement the run() method.
+    Tasks are allocated from per-thread pools (see operator new),
+    so creating many small tasks is cheap.
     @ingroup magma_thread
 *******************************************************************************/
 class magma_task
@@ -31,8 +36,45 @@ class magma_task
 public:
     magma_task() {}
     virtual ~magma_task() {}
-    
+
     virtual void run() = 0;  // pure virtual function to execute task
+
+    static void* operator new( size_t size );
+    static void  operator delete( void* ptr );
+};
+
+
+/***************************************************************************//**
+    Chase-Lev work-stealing deque of tasks.
+    The owner pushes and pops at the bottom; other threads steal from the top.
+    push() and pop() may be called by only one thread at a time,
+    steal() by any number of threads concurrently.
+    @ingroup magma_thread
+*******************************************************************************/
+class magma_task_deque
+{
+public:
+    magma_task_deque();
+    ~magma_task_deque();
+
+    void        push( magma_task* task );
+    magma_task* pop();
+    magma_task* steal();
+    bool        empty() const;
+
+private:
+    struct array {
+        int64_t size;                   ///<  capacity, a power of 2
+        std::atomic< magma_task* >* buf;
+        array* prev;                    ///<  previous (smaller) array, freed in destructor
+    };
+    array* grow( array* a, int64_t b, int64_t t );
+
+    std::atomic< int64_t > top;         ///<  next task to steal
+    char pad1[ 64 - sizeof(std::atomic< int64_t >) ];
+    std::atomic< int64_t > bottom;      ///<  next free slot of owner
+    std::atomic< array* >  arr;
+    char pad2[ 64 - sizeof(std::atomic< int64_t >) - sizeof(std::atomic< array* >) ];
 };
 
 
@@ -42,28 +84,38 @@ class magma_thread_queue
 public:
     magma_thread_queue();
     ~magma_thread_queue();
-    
+
     void launch( magma_int_t in_nthread );
     void push_task( magma_task* task );
     void sync();
     void quit();
-    
+
 protected:
     friend void* magma_thread_main( void* arg );
-    magma_task* pop_task();
+    friend void* magma_thread_pool_main( void* arg );
+    magma_task* pop_task( magma_int_t index );
+    magma_task* find_task( magma_int_t index );
     void task_done();
-    
+    void detach();
+    bool all_empty() const;
+
     magma_int_t get_thread_index( pthread_t thread ) const;
-    
+
 private:
-    std::queue< magma_task* > q;  ///<  queue of tasks
-    bool            quit_flag;    ///<  quit() sets this to true; after this, pop returns NULL
-    magma_int_t     ntask;        ///<  number of unfinished tasks (in queue or currently executing)
-    pthread_mutex_t mutex;        ///<  mutex lock for queue, quit, ntask
-    pthread_cond_t  cond;         ///<  condition variable for changes to queue and quit (see push, pop, quit)
-    pthread_cond_t  cond_ntask;   ///<  condition variable for changes to ntask (see sync, task_done)
-    pthread_t*      threads;      ///<  array of threads
-    magma_int_t     nthread;      ///<  number of threads
+    magma_task_deque  ext;                  ///<  tasks pushed by threads outside the pool
+    magma_task_deque* deques;               ///<  array of nthread deques, one per worker
+    pthread_mutex_t   push_mutex;           ///<  serializes pushes into ext
+    std::atomic< bool >        quit_flag;   ///<  quit() sets this to true; after this, pop returns NULL
+    std::atomic< magma_int_t > ntask;       ///<  number of unfinished tasks (in deques or currently executing)
+    std::atomic< magma_int_t > epoch;       ///<  incremented by every push; sleeping workers wait for it to change
+    std::atomic< magma_int_t > nsleep;      ///<  number of workers waiting in cond
+    std::atomic< magma_int_t > nstarted;    ///<  gives each worker its index
+    magma_int_t     nrunning;               ///<  workers not yet detached; protected by mutex
+    pthread_mutex_t mutex;                  ///<  mutex for sleeping workers and sync
+    pthread_cond_t  cond;                   ///<  condition variable for idle workers (see push, pop, quit)
+    pthread_cond_t  cond_ntask;             ///<  signaled when ntask drops to 0 (see sync, task_done, detach)
+    pthread_t*      threads;                ///<  array of threads, borrowed from the worker pool
+    magma_int_t     nthread;                ///<  number of threads
 };
 
 #endif        //  #ifndef MAGMA_THREAD_HPP
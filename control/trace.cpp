@@ -3,8 +3,13 @@
 #include <errno.h>
 #include <string.h>      // strerror_r
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "trace.h"
 
@@ -12,7 +17,12 @@
 // gcc -DTRACING -c trace.cpp
 #ifdef TRACING
 
+#ifdef MAGMA_HAVE_HIP
+#include <hip/hip_runtime.h>
+#define cudaEventElapsedTime hipEventElapsedTime
+#else
 #include <cuda_runtime.h>
+#endif
 #include "magma_internal.h"
 #include "magmablas_v1.h"
 
@@ -22,17 +32,50 @@
 #define TRACE_METHOD 2
 
 
+/******************************************************************************/
+// One CPU event. Spans are recorded as begin and end events, so they nest.
+struct cpu_event
+{
+    double time;
+    double value;                   // counter value
+    char   type;                    // 'B' begin, 'E' end, 'C' counter
+    char   tag  [ MAX_LABEL_LEN ];  // CSS class, or counter name
+    char   label[ MAX_LABEL_LEN ];
+};
+
+struct cpu_chunk
+{
+    cpu_event  events[ TRACE_CHUNK ];
+    cpu_chunk* next;
+};
+
+// Event buffer of one thread. Only the owning thread appends events;
+// trace_finalize reads them after the traced threads are done.
+// Buffers are never freed, as the thread keeps a pointer to its buffer;
+// trace_finalize frees their chunks.
+struct cpu_buffer
+{
+    int         id;
+    char        name[ MAX_LABEL_LEN ];
+    cpu_chunk*  first;
+    cpu_chunk*  last;
+    magma_int_t nlast;              // events in last chunk
+    cpu_buffer* next;
+};
+
+
 /******************************************************************************/
 struct event_log
 {
-    int    ncore;
-    int    cpu_id   [ MAX_CORES ];
+    // CPU threads register with a lock-free push onto this list
+    std::atomic< cpu_buffer* > cpu_buffers;
+    std::atomic< int >         ncpu;
     double cpu_first;
-    double cpu_start[ MAX_CORES ][ MAX_EVENTS ];
-    double cpu_end  [ MAX_CORES ][ MAX_EVENTS ];
-    char   cpu_tag  [ MAX_CORES ][ MAX_EVENTS ][ MAX_LABEL_LEN ];
-    char   cpu_label[ MAX_CORES ][ MAX_EVENTS ][ MAX_LABEL_LEN ];
-    
+
+    // metadata, protected by mutex
+    std::vector< std::pair< std::string, std::string > > metadata;
+    std::mutex mutex;
+
     int           ngpu;
     int           nqueue;
     magma_queue_t queues   [ MAX_GPU_QUEUES ];
@@ -51,29 +94,70 @@ struct event_log
 // global log object
 struct event_log glog;
 
+std::atomic< bool > g_trace_on( false );
+
+static thread_local cpu_buffer* t_buffer = NULL;
+
 
 /******************************************************************************/
-void trace_init( int ncore, int ngpu, int nqueue, magma_queue_t* queues )
+// Returns the calling thread's buffer, registering the thread on first use.
+static cpu_buffer* trace_self()
 {
-    if ( ncore > MAX_CORES ) {
-        fprintf( stderr, "Error in trace_init: ncore %d > MAX_CORES %d\n",
-                 ncore, MAX_CORES );
-        exit(1);
+    cpu_buffer* buf = t_buffer;
+    if ( buf == NULL ) {
+        buf = new cpu_buffer;
+        buf->id    = glog.ncpu.fetch_add( 1 );
+        buf->first = NULL;
+        buf->last  = NULL;
+        buf->nlast = TRACE_CHUNK;
+        snprintf( buf->name, sizeof(buf->name), "CPU %d", buf->id );
+        buf->next = glog.cpu_buffers.load();
+        while( ! glog.cpu_buffers.compare_exchange_weak( buf->next, buf )) {}
+        t_buffer = buf;
     }
+    return buf;
+}
+
+
+/******************************************************************************/
+// Appends an event to the calling thread's buffer, adding a chunk if full.
+static cpu_event* trace_append( char type )
+{
+    cpu_buffer* buf = trace_self();
+    if ( buf->nlast == TRACE_CHUNK ) {
+        cpu_chunk* chunk = new cpu_chunk;
+        chunk->next = NULL;
+        if ( buf->last == NULL )
+            buf->first = chunk;
+        else
+            buf->last->next = chunk;
+        buf->last  = chunk;
+        buf->nlast = 0;
+    }
+    cpu_event* event = &buf->last->events[ buf->nlast++ ];
+    event->type = type;
+    event->time = magma_wtime();
+    return event;
+}
+
+
+/******************************************************************************/
+void trace_init( magma_int_t ncore, magma_int_t ngpu, magma_int_t nqueue, magma_queue_t* queues )
+{
     if ( ngpu*nqueue > MAX_GPU_QUEUES ) {
-        fprintf( stderr, "Error in trace_init: (ngpu=%d)*(nqueue=%d) > MAX_GPU_QUEUES=%d\n",
-                 ngpu, nqueue, MAX_GPU_QUEUES );
+        fprintf( stderr, "Error in trace_init: (ngpu=%lld)*(nqueue=%lld) > MAX_GPU_QUEUES=%lld\n",
+                 (long long) ngpu, (long long) nqueue, (long long) MAX_GPU_QUEUES );
         exit(1);
     }
-    
-    glog.ncore  = ncore;
+    const char* env = getenv( "MAGMA_TRACE" );
+    if ( env != NULL && strcmp( env, "0" ) == 0 ) {
+        return;
+    }
+
     glog.ngpu   = ngpu;
     glog.nqueue = nqueue;
-    
+
     // initialize ID = 0
-    for( int core = 0; core < ncore; ++core ) {
-        glog.cpu_id[core] = 0;
-    }
     for( int dev = 0; dev < ngpu; ++dev ) {
         for( int s = 0; s < nqueue; ++s ) {
             int t = dev*glog.nqueue + s;
@@ -98,35 +182,53 @@ void trace_init( int ncore, int ngpu, int nqueue, magma_queue_t* queues )
         magma_device_sync();
     }
     glog.cpu_first = magma_wtime();
+    g_trace_on = true;
 }
 
 
 /******************************************************************************/
-void trace_cpu_start( int core, const char* tag, const char* lbl )
+void trace_thread_name_internal( const char* name )
 {
-    int id = glog.cpu_id[core];
-    glog.cpu_start[core][id] = magma_wtime();
-    magma_strlcpy( glog.cpu_tag  [core][id], tag, MAX_LABEL_LEN );
-    magma_strlcpy( glog.cpu_label[core][id], lbl, MAX_LABEL_LEN );
+    magma_strlcpy( trace_self()->name, name, MAX_LABEL_LEN );
 }
 
 
 /******************************************************************************/
-void trace_cpu_end( int core )
+void trace_cpu_start_internal( const char* tag, const char* lbl )
 {
-    int id = glog.cpu_id[core];
-    glog.cpu_end[core][id] = magma_wtime();
-    if ( id+1 < MAX_EVENTS ) {
-        glog.cpu_id[core] = id+1;
-    }
-    else {
-        fprintf( stderr, "Error in %s: not enough CPU events.\n", __func__ );
-    }
+    cpu_event* event = trace_append( 'B' );
+    magma_strlcpy( event->tag,   tag, MAX_LABEL_LEN );
+    magma_strlcpy( event->label, lbl, MAX_LABEL_LEN );
 }
 
 
 /******************************************************************************/
-void trace_gpu_start( int dev, int s, const char* tag, const char* lbl )
+void trace_cpu_end_internal()
+{
+    trace_append( 'E' );
+}
+
+
+/******************************************************************************/
+void trace_counter_internal( const char* name, double value )
+{
+    cpu_event* event = trace_append( 'C' );
+    event->value = value;
+    magma_strlcpy( event->tag,   name, MAX_LABEL_LEN );
+    magma_strlcpy( event->label, name, MAX_LABEL_LEN );
+}
+
+
+/******************************************************************************/
+void trace_metadata_internal( const char* key, const char* value )
+{
+    std::lock_guard< std::mutex > lock( glog.mutex );
+    glog.metadata.push_back( std::make_pair( std::string( key ), std::string( value )));
+}
+
+
+/******************************************************************************/
+void trace_gpu_start_internal( magma_int_t dev, magma_int_t s, const char* tag, const char* lbl )
 {
     int t = dev*glog.nqueue + s;
     int id = glog.gpu_id[t];
@@ -142,7 +244,7 @@ void trace_gpu_start( int dev, int s, const char* tag, const char* lbl )
 
 
 /******************************************************************************/
-void trace_gpu_end( int dev, int s )
+void trace_gpu_end_internal( magma_int_t dev, magma_int_t s )
 {
     int t = dev*glog.nqueue + s;
     int id = glog.gpu_id[t];
@@ -152,13 +254,159 @@ void trace_gpu_end( int dev, int s )
         glog.gpu_id[t] = id+1;
     }
     else {
-        fprintf( stderr, "Error in %s: not enough GPU events (dev %d, queue %d).\n", __func__, dev, s );
+        fprintf( stderr, "Error in %s: not enough GPU events (dev %lld, queue %lld).\n",
+                 __func__, (long long) dev, (long long) s );
     }
 }
 
 
 /******************************************************************************/
-void trace_finalize( const char* filename, const char* cssfile )
+// Span of a CPU thread or GPU queue, in seconds since trace_init.
+struct trace_span
+{
+    double      start, end;
+    int         depth;      // nesting level
+    const char* tag;
+    const char* label;
+};
+
+
+/******************************************************************************/
+// Pairs begin and end events of a CPU buffer into spans.
+// Spans still open end at time end.
+static void cpu_spans( cpu_buffer* buf, double end, std::vector< trace_span >& spans )
+{
+    std::vector< size_t > stack;
+    for( cpu_chunk* chunk = buf->first; chunk != NULL; chunk = chunk->next ) {
+        magma_int_t n = (chunk == buf->last ? buf->nlast : TRACE_CHUNK);
+        for( magma_int_t i = 0; i < n; ++i ) {
+            cpu_event* e = &chunk->events[i];
+            if ( e->type == 'B' ) {
+                trace_span span = { e->time - glog.cpu_first, end, (int) stack.size(),
+                                    e->tag, e->label };
+                stack.push_back( spans.size() );
+                spans.push_back( span );
+            }
+            else if ( e->type == 'E' && ! stack.empty() ) {
+                spans[ stack.back() ].end = e->time - glog.cpu_first;
+                stack.pop_back();
+            }
+        }
+    }
+}
+
+
+/******************************************************************************/
+// Spans of GPU queue t.
+static void gpu_spans( int t, std::vector< trace_span >& spans )
+{
+    float start, end = 0;
+    for( int i = 0; i < glog.gpu_id[t]; ++i ) {
+        #if TRACE_METHOD == 2
+            start = glog.gpu_start[t][i] - glog.cpu_first;
+            if ( i > 0 ) {
+                // later of task's CPU start time and previous task's end time
+                start = max( start, end );
+            }
+        #else
+            cudaEventElapsedTime( &start, glog.gpu_first[t], glog.gpu_start[t][i] );
+            start *= 1e-3;  // ms to seconds
+        #endif
+        cudaEventElapsedTime( &end, glog.gpu_first[t], glog.gpu_end[t][i] );
+        end   *= 1e-3;  // ms to seconds
+        trace_span span = { start, end, 0, glog.gpu_tag[t][i], glog.gpu_label[t][i] };
+        spans.push_back( span );
+    }
+}
+
+
+/******************************************************************************/
+// Writes str as a JSON string, with quotes.
+static void json_string( FILE* file, const char* str )
+{
+    fputc( '"', file );
+    for( const char* c = str; *c != '\0'; ++c ) {
+        if ( *c == '"' || *c == '\\' )
+            fprintf( file, "\\%c", *c );
+        else if ( (unsigned char) *c < 0x20 )
+            fprintf( file, "\\u%04x", (unsigned char) *c );
+        else
+            fputc( *c, file );
+    }
+    fputc( '"', file );
+}
+
+
+/******************************************************************************/
+// Chrome trace-event format, readable by chrome://tracing and Perfetto.
+// CPU threads are in process 0, GPU queues of device d are in process d+1.
+static void write_json( FILE* file, const std::vector< cpu_buffer* >& cpus )
+{
+    fprintf( file, "{\n\"displayTimeUnit\": \"ms\",\n\"otherData\": {" );
+    for( size_t i = 0; i < glog.metadata.size(); ++i ) {
+        fprintf( file, "%s\n    ", (i > 0 ? "," : "") );
+        json_string( file, glog.metadata[i].first.c_str() );
+        fprintf( file, ": " );
+        json_string( file, glog.metadata[i].second.c_str() );
+    }
+    fprintf( file, "},\n\"traceEvents\": [\n" );
+    fprintf( file, "{\"ph\": \"M\", \"pid\": 0, \"name\": \"process_name\", \"args\": {\"name\": \"CPU\"}}" );
+
+    // output CPU events
+    for( size_t k = 0; k < cpus.size(); ++k ) {
+        cpu_buffer* buf = cpus[k];
+        fprintf( file, ",\n{\"ph\": \"M\", \"pid\": 0, \"tid\": %d, \"name\": \"thread_name\", \"args\": {\"name\": ",
+                 buf->id );
+        json_string( file, buf->name );
+        fprintf( file, "}}" );
+        for( cpu_chunk* chunk = buf->first; chunk != NULL; chunk = chunk->next ) {
+            magma_int_t n = (chunk == buf->last ? buf->nlast : TRACE_CHUNK);
+            for( magma_int_t i = 0; i < n; ++i ) {
+                cpu_event* e = &chunk->events[i];
+                fprintf( file, ",\n{\"ph\": \"%c\", \"pid\": 0, \"tid\": %d, \"ts\": %.3f",
+                         e->type, buf->id, (e->time - glog.cpu_first)*1e6 );
+                if ( e->type == 'B' ) {
+                    fprintf( file, ", \"cat\": " );
+                    json_string( file, e->tag );
+                    fprintf( file, ", \"name\": " );
+                    json_string( file, e->label );
+                }
+                else if ( e->type == 'C' ) {
+                    fprintf( file, ", \"name\": " );
+                    json_string( file, e->tag );
+                    fprintf( file, ", \"args\": {\"value\": %.17g}", e->value );
+                }
+                fprintf( file, "}" );
+            }
+        }
+    }
+
+    // output GPU events
+    for( int dev = 0; dev < glog.ngpu; ++dev ) {
+        fprintf( file, ",\n{\"ph\": \"M\", \"pid\": %d, \"name\": \"process_name\", \"args\": {\"name\": \"GPU %d\"}}",
+                 dev+1, dev );
+        magma_setdevice( dev );
+        for( int s = 0; s < glog.nqueue; ++s ) {
+            int t = dev*glog.nqueue + s;
+            std::vector< trace_span > spans;
+            gpu_spans( t, spans );
+            for( size_t i = 0; i < spans.size(); ++i ) {
+                fprintf( file, ",\n{\"ph\": \"X\", \"pid\": %d, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f, \"cat\": ",
+                         dev+1, s, spans[i].start*1e6, (spans[i].end - spans[i].start)*1e6 );
+                json_string( file, spans[i].tag );
+                fprintf( file, ", \"name\": " );
+                json_string( file, spans[i].label );
+                fprintf( file, "}" );
+            }
+        }
+    }
+    fprintf( file, "\n]\n}\n" );
+}
+
+
+/******************************************************************************/
+static void write_svg( FILE* trace_file, const char* cssfile, double time,
+                       const std::vector< cpu_buffer* >& cpus )
 {
     // these are all in SVG "pixels"
     double xscale = 200.; // pixels per second
@@ -170,25 +418,11 @@ void trace_finalize( const char* filename, const char* cssfile )
     double left   = 2*margin + label;
     double xtick  = 0.5;  // interval of xticks (in seconds)
     char buf[ 1024 ];
-    
-    // sync devices
-    for( int dev = 0; dev < glog.ngpu; ++dev ) {
-        magma_setdevice( dev );
-        magma_device_sync();
-    }
-    double time = magma_wtime() - glog.cpu_first;
-    
-    FILE* trace_file = fopen( filename, "w" );
-    if ( trace_file == NULL ) {
-        strerror_r( errno, buf, sizeof(buf) );
-        fprintf( stderr, "Can't open file '%s': %s (%d)\n", filename, buf, errno );
-        return;
-    }
-    fprintf( stderr, "writing trace to '%s'\n", filename );
-    
+
     // row for each CPU and GPU/queue (with space between), time scale, legend
     // 4 margins: at top, above time scale, above legend, at bottom
-    int h = (int)( (glog.ncore + glog.ngpu*glog.nqueue)*(height + space) - space + 2*height + 4*margin );
+    int ncore = (int) cpus.size();
+    int h = (int)( (ncore + glog.ngpu*glog.nqueue)*(height + space) - space + 2*height + 4*margin );
     int w = (int)( left + time*xscale + margin );
     fprintf( trace_file,
              "<?xml version=\"1.0\" standalone=\"no\"?>\n"
@@ -199,7 +433,7 @@ void trace_finalize( const char* filename, const char* cssfile )
              "    xmlns:inkscape=\"http://www.inkscape.org/namespaces/inkscape\"\n"
              "    viewBox=\"0 0 %d %d\" width=\"%d\" height=\"%d\" preserveAspectRatio=\"none\">\n\n",
              w, h, w, h );
-    
+
     // Inkscape does not currently (Jan 2012) support external CSS;
     // see http://wiki.inkscape.org/wiki/index.php/CSS_Support
     // So embed CSS file here
@@ -216,45 +450,41 @@ void trace_finalize( const char* filename, const char* cssfile )
         fclose( css_file );
         fprintf( trace_file, "</style>\n\n" );
     }
-    
+
     // format takes: x, y, width, height, class (tag), id (label)
     const char* format =
         "<rect x=\"%8.3f\" y=\"%4.0f\" width=\"%8.3f\" height=\"%2.0f\" class=\"%-8s\" inkscape:label=\"%s\"/>\n";
-    
+
     // accumulate unique legend entries
     std::set< std::string > legend;
-    
-    // output CPU events
+
+    // output CPU events; nested spans are drawn inside their parent
     double top = margin;
-    for( int core = 0; core < glog.ncore; ++core ) {
-        if ( glog.cpu_id[core] > MAX_EVENTS ) {
-            glog.cpu_id[core] += 1;  // count last event
-            fprintf( stderr, "WARNING: trace on core %d, reached limit of %d events; output will be truncated.\n",
-                     core, glog.cpu_id[core] );
-        }
-        fprintf( trace_file, "<!-- core %d, nevents %d -->\n", core, glog.cpu_id[core] );
+    for( int core = 0; core < ncore; ++core ) {
+        std::vector< trace_span > spans;
+        cpu_spans( cpus[core], time, spans );
+        fprintf( trace_file, "<!-- core %d, nevents %d -->\n", core, (int) spans.size() );
         fprintf( trace_file, "<g inkscape:groupmode=\"layer\" inkscape:label=\"core %d\">\n", core );
-        fprintf( trace_file, "<text x=\"%8.3f\" y=\"%4.0f\" width=\"%4.0f\" height=\"%2.0f\">CPU %d:</text>\n",
+        fprintf( trace_file, "<text x=\"%8.3f\" y=\"%4.0f\" width=\"%4.0f\" height=\"%2.0f\">%s:</text>\n",
                  margin,
                  top + height - pad,
                  label, height,
-                 core );
-        for( int i = 0; i < glog.cpu_id[core]; ++i ) {
-            double start  = glog.cpu_start[core][i] - glog.cpu_first;
-            double end    = glog.cpu_end  [core][i] - glog.cpu_first;
+                 cpus[core]->name );
+        for( size_t i = 0; i < spans.size(); ++i ) {
+            double inset = min( 2*space*spans[i].depth, height/2 - space );
             fprintf( trace_file, format,
-                     left + start*xscale,
-                     top,
-                     (end - start)*xscale,
-                     height,
-                     glog.cpu_tag[core][i],
-                     glog.cpu_label[core][i] );
-            legend.insert( glog.cpu_tag[core][i] );
+                     left + spans[i].start*xscale,
+                     top + inset,
+                     (spans[i].end - spans[i].start)*xscale,
+                     height - 2*inset,
+                     spans[i].tag,
+                     spans[i].label );
+            legend.insert( spans[i].tag );
         }
         top += (height + space);
         fprintf( trace_file, "</g>\n\n" );
     }
-    
+
     // output GPU events
     for( int dev = 0; dev < glog.ngpu; ++dev ) {
         for( int s = 0; s < glog.nqueue; ++s ) {
@@ -268,38 +498,27 @@ void trace_finalize( const char* filename, const char* cssfile )
             fprintf( trace_file, "<g inkscape:groupmode=\"layer\" inkscape:label=\"gpu %d queue %d\">\n", dev, s );
             fprintf( trace_file, "<text x=\"%8.3f\" y=\"%4.0f\" width=\"%4.0f\" height=\"%2.0f\">GPU %d (s%d):</text>\n",
                      margin,
-                     margin + (dev*glog.nqueue + s + glog.ncore)*(height + space) + height - pad,
+                     margin + (dev*glog.nqueue + s + ncore)*(height + space) + height - pad,
                      label, height,
                      dev, s );
             magma_setdevice( dev );
-            float start, end;
-            for( int i = 0; i < glog.gpu_id[t]; ++i ) {
-                #if TRACE_METHOD == 2
-                    start = glog.gpu_start[t][i] - glog.cpu_first;
-                    if ( i > 0 ) {
-                        // later of task's CPU start time and previous task's end time
-                        start = max( start, end );
-                    }
-                #else
-                    cudaEventElapsedTime( &start, glog.gpu_first[t], glog.gpu_start[t][i] );
-                    start *= 1e-3;  // ms to seconds
-                #endif
-                cudaEventElapsedTime( &end, glog.gpu_first[t], glog.gpu_end  [t][i] );
-                end   *= 1e-3;  // ms to seconds
+            std::vector< trace_span > spans;
+            gpu_spans( t, spans );
+            for( size_t i = 0; i < spans.size(); ++i ) {
                 fprintf( trace_file, format,
-                         left + start*xscale,
+                         left + spans[i].start*xscale,
                          top,
-                         (end - start)*xscale,
+                         (spans[i].end - spans[i].start)*xscale,
                          height,
-                         glog.gpu_tag[t][i],
-                         glog.gpu_label[t][i] );
-                legend.insert( glog.gpu_tag[t][i] );
+                         spans[i].tag,
+                         spans[i].label );
+                legend.insert( spans[i].tag );
             }
             top += (height + space);
             fprintf( trace_file, "</g>\n\n" );
         }
     }
-    
+
     // output time scale
     top += (-space + margin);
     fprintf( trace_file, "<g inkscape:groupmode=\"layer\" inkscape:label=\"scale\">\n" );
@@ -318,7 +537,7 @@ void trace_finalize( const char* filename, const char* cssfile )
     }
     fprintf( trace_file, "</g>\n\n" );
     top += (height + margin);
-    
+
     // output legend
     fprintf( trace_file, "<g inkscape:groupmode=\"layer\" inkscape:label=\"legend\">\n" );
     fprintf( trace_file, "<text x=\"%8.1f\" y=\"%4.0f\" width=\"%2.0f\" height=\"%2.0f\">Legend:</text>\n",
@@ -333,10 +552,73 @@ void trace_finalize( const char* filename, const char* cssfile )
         x += label + margin;
     }
     fprintf( trace_file, "</g>\n\n" );
-    
+
     fprintf( trace_file, "</svg>\n" );
-    
-    fclose( trace_file );
+}
+
+
+/******************************************************************************/
+static bool cpu_buffer_less( const cpu_buffer* a, const cpu_buffer* b )
+{
+    return a->id < b->id;
+}
+
+
+/******************************************************************************/
+// Writes the trace and stops tracing; the traced threads must be done.
+// Writes Chrome trace-event JSON if filename ends in ".json", else SVG
+// using cssfile for the styles.
+void trace_finalize( const char* filename, const char* cssfile )
+{
+    char buf[ 1024 ];
+
+    if ( ! trace_is_on() ) {
+        return;
+    }
+    g_trace_on = false;
+
+    // sync devices
+    for( int dev = 0; dev < glog.ngpu; ++dev ) {
+        magma_setdevice( dev );
+        magma_device_sync();
+    }
+    double time = magma_wtime() - glog.cpu_first;
+
+    // threads in the order they registered
+    std::vector< cpu_buffer* > cpus;
+    for( cpu_buffer* cpu = glog.cpu_buffers.load(); cpu != NULL; cpu = cpu->next ) {
+        cpus.push_back( cpu );
+    }
+    std::sort( cpus.begin(), cpus.end(), cpu_buffer_less );
+
+    FILE* trace_file = fopen( filename, "w" );
+    if ( trace_file == NULL ) {
+        strerror_r( errno, buf, sizeof(buf) );
+        fprintf( stderr, "Can't open file '%s': %s (%d)\n", filename, buf, errno );
+    }
+    else {
+        fprintf( stderr, "writing trace to '%s'\n", filename );
+        size_t len = strlen( filename );
+        if ( len >= 5 && strcmp( filename + len - 5, ".json" ) == 0 )
+            write_json( trace_file, cpus );
+        else
+            write_svg( trace_file, cssfile, time, cpus );
+        fclose( trace_file );
+    }
+
+    // free events, keeping buffers for the next trace
+    for( size_t k = 0; k < cpus.size(); ++k ) {
+        cpu_chunk* chunk = cpus[k]->first;
+        while( chunk != NULL ) {
+            cpu_chunk* next = chunk->next;
+            delete chunk;
+            chunk = next;
+        }
+        cpus[k]->first = NULL;
+        cpus[k]->last  = NULL;
+        cpus[k]->nlast = TRACE_CHUNK;
+    }
+    glog.metadata.clear();
 }
 
 #endif // TRACING
@@ -17,33 +17,95 @@
 #endif
 
 // =============================================================================
-const magma_int_t MAX_CORES       = 1;                 // CPU cores
+// CPU events are kept in per-thread buffers that grow by TRACE_CHUNK events,
+// so there is no limit on CPU threads or events.
 const magma_int_t MAX_GPU_QUEUES  = MagmaMaxGPUs * 4;  // #devices * #queues per device
-const magma_int_t MAX_EVENTS      = 20000;
+const magma_int_t MAX_EVENTS      = 20000;             // per GPU queue
 const magma_int_t MAX_LABEL_LEN   = 16;
+const magma_int_t TRACE_CHUNK     = 4096;              // CPU events per chunk
 
 
 // =============================================================================
 #ifdef TRACING
 
+#include <atomic>
+
+// Tracing is on between trace_init and trace_finalize, unless
+// $MAGMA_TRACE=0. When off, each trace call costs one branch.
+extern std::atomic< bool > g_trace_on;
+
+inline bool trace_is_on()
+{
+    return g_trace_on.load( std::memory_order_relaxed );
+}
+
 void trace_init     ( magma_int_t ncore, magma_int_t ngpu, magma_int_t nqueue, magma_queue_t *queues );
 
-void trace_cpu_start( magma_int_t core, const char* tag, const char* label );
-void trace_cpu_end  ( magma_int_t core );
+void trace_thread_name_internal( const char* name );
+void trace_cpu_start_internal  ( const char* tag, const char* label );
+void trace_cpu_end_internal    ();
+void trace_counter_internal    ( const char* name, double value );
+void trace_metadata_internal   ( const char* key, const char* value );
+
+void trace_gpu_start_internal( magma_int_t dev, magma_int_t queue_num, const char* tag, const char* label );
+void trace_gpu_end_internal  ( magma_int_t dev, magma_int_t queue_num );
 
 magma_event_t*
      trace_gpu_event( magma_int_t dev, magma_int_t queue_num, const char* tag, const char* label );
-void trace_gpu_start( magma_int_t dev, magma_int_t queue_num, const char* tag, const char* label );
-void trace_gpu_end  ( magma_int_t dev, magma_int_t queue_num );
 
+// Writes Chrome trace-event JSON if filename ends in ".json", else SVG.
 void trace_finalize ( const char* filename, const char* cssfile );
 
+// Names the calling thread in the trace; otherwise it is "CPU <n>",
+// numbered in the order threads first record an event.
+inline void trace_thread_name( const char* name )
+{
+    if ( trace_is_on() ) trace_thread_name_internal( name );
+}
+
+// Spans on the calling thread; they nest. core is no longer used,
+// as each thread records into its own buffer.
+inline void trace_cpu_start( magma_int_t core, const char* tag, const char* label )
+{
+    if ( trace_is_on() ) trace_cpu_start_internal( tag, label );
+}
+
+inline void trace_cpu_end( magma_int_t core )
+{
+    if ( trace_is_on() ) trace_cpu_end_internal();
+}
+
+// Counter track, e.g., flops or bytes, sampled on the calling thread.
+inline void trace_counter( const char* name, double value )
+{
+    if ( trace_is_on() ) trace_counter_internal( name, value );
+}
+
+// Key-value pair written in the trace header, e.g., matrix size.
+inline void trace_metadata( const char* key, const char* value )
+{
+    if ( trace_is_on() ) trace_metadata_internal( key, value );
+}
+
+inline void trace_gpu_start( magma_int_t dev, magma_int_t queue_num, const char* tag, const char* label )
+{
+    if ( trace_is_on() ) trace_gpu_start_internal( dev, queue_num, tag, label );
+}
+
+inline void trace_gpu_end( magma_int_t dev, magma_int_t queue_num )
+{
+    if ( trace_is_on() ) trace_gpu_end_internal( dev, queue_num );
+}
+
 #else
 
 #define trace_init(      x1, x2, x3, x4 ) ((void)(0))
 
+#define trace_thread_name( x1           ) ((void)(0))
 #define trace_cpu_start( x1, x2, x3     ) ((void)(0))
 #define trace_cpu_end(   x1             ) ((void)(0))
+#define trace_counter(   x1, x2         ) ((void)(0))
+#define trace_metadata(  x1, x2         ) ((void)(0))
 
 #define trace_gpu_event( x1, x2, x3, x4 ) (NULL)
 #define trace_gpu_start( x1, x2, x3, x4 ) ((void)(0))
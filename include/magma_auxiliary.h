@@ -48,6 +48,12 @@ void magma_print_environment();
 real_Double_t magma_wtime( void );
 real_Double_t magma_sync_wtime( magma_queue_t queue );
 
+// profiling regions, enabled by $MAGMA_REGIONS
+void magma_region_begin( const char* name );
+void magma_region_end( const char* name );
+void magma_region_report( const char* filename );
+void magma_region_reset( void );
+
 
 // =============================================================================
 // misc. functions
@@ -74,6 +80,8 @@ void magma_swp2pswp(
 
 magma_int_t magma_get_smlsize_divideconquer();
 
+magma_int_t magma_get_trevc3_gemm_nb( magma_int_t n, magma_int_t nthread );
+
 
 // =============================================================================
 // memory allocation
@@ -757,6 +757,9 @@ typedef enum {
     Magma_PQMR         = 464,
     Magma_QMRMERGE     = 465,
     Magma_PQMRMERGE    = 466,
+    Magma_SGS          = 467,
+    Magma_SOR          = 468,
+    Magma_SSOR         = 469,
     Magma_BOMBARD      = 490,
     Magma_BOMBARDMERGE = 491,
     Magma_PCGMERGE     = 492,
@@ -820,6 +823,17 @@ typedef enum {
     Magma_UNITDIAGCOL  = 516, // to be deprecated
 } magma_scale_t;
 
+typedef enum {
+    Magma_NOREORDER    = 521,
+    Magma_RCM          = 522,
+    Magma_ND           = 523
+} magma_reorder_t;
+
+typedef enum {
+    Magma_GREEDYCOLOR  = 531,
+    Magma_JPCOLOR      = 532
+} magma_coloring_t;
+
 
 typedef enum {
     Magma_SOLVE        = 801,
@@ -39,6 +39,7 @@
 
 #include "magma_internal.h"
 #include "error.h"
+#include "affinity.h"
 
 #define MAX_BATCHCOUNT    (65534)
 
@@ -294,6 +295,9 @@ magma_finalize()
                 #endif
                 #endif // MAGMA_NO_V1
 
+                // worker threads kept by magma_thread_queue between launches
+                magma_thread_pool_finalize();
+
                 #ifdef DEBUG_MEMORY
                 magma_warn_leaks( g_pointers_dev, "device" );
                 magma_warn_leaks( g_pointers_cpu, "CPU" );
@@ -427,6 +431,9 @@ magma_print_environment()
 
     printf( "\n" );
 
+    // CPU topology and thread placement ($MAGMA_PLACEMENT)
+    magma_topology::get().print();
+
     // print devices
     int ndevices = 0;
     err = hipGetDeviceCount( &ndevices );
@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/blas/zparilu.cpp, normal z -> c, Wed Feb 22 15:21:40 2023
+       @generated from sparse/blas/zparilu.cpp, normal z -> c, Sun Oct 18 06:54:11 2026
 */
 #include "magmasparse_internal.h"
 
@@ -70,7 +70,7 @@ magma_cparilusetup(
     CHECK( magma_cmtransfer( hA, &hAcopy, Magma_CPU, Magma_CPU , queue ));
 
     // in case using fill-in
-    CHECK( magma_csymbilu( &hAcopy, precond->levels, &hAL, &hAUt,  queue ));
+    CHECK( magma_csymbilu_stats( &hAcopy, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
     // add a unit diagonal to L for the algorithm
     CHECK( magma_cmLdiagadd( &hAL , queue ));
     // transpose U for the algorithm
@@ -247,7 +247,7 @@ magma_cpariluupdate(
     if ( updates > 0 ){
         CHECK( magma_cmtransfer( precond->M, &hAcopy, Magma_DEV, Magma_CPU , queue ));
         // in case using fill-in
-        CHECK( magma_csymbilu( &hAcopy, precond->levels, &hAL, &hAUt,  queue ));
+        CHECK( magma_csymbilu_stats( &hAcopy, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
         // add a unit diagonal to L for the algorithm
         CHECK( magma_cmLdiagadd( &hAL , queue ));
         // transpose U for the algorithm
@@ -357,7 +357,7 @@ magma_cparicsetup(
     magma_cmfree(&hAh, queue );
 
     // in case using fill-in
-    CHECK( magma_csymbilu( &hA, precond->levels, &hAL, &hAUt , queue ));
+    CHECK( magma_csymbilu_stats( &hA, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
 
     // need only lower triangular
     magma_cmfree(&hAUt, queue );
@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/blas/zilu.cpp, normal z -> d, Wed Feb 22 15:21:39 2023
+       @generated from sparse/blas/zilu.cpp, normal z -> d, Sun Oct 18 06:54:11 2026
 */
 #include "magmasparse_internal.h"
 #include <cuda.h>  // for CUDA_VERSION
@@ -204,7 +204,7 @@ magma_dcumilusetup(
     // in case using fill-in
     if( precond->levels > 0 ){
         magma_d_matrix hAL={Magma_CSR}, hAUt={Magma_CSR};
-        CHECK( magma_dsymbilu( &hACSR, precond->levels, &hAL, &hAUt,  queue ));
+        CHECK( magma_dsymbilu_stats( &hACSR, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
         magma_dmfree(&hAL, queue);
         magma_dmfree(&hAUt, queue);
     }
@@ -805,7 +805,7 @@ magma_dcumiccsetup(
     // in case using fill-in
     if( precond->levels > 0 ){
             magma_d_matrix hAL={Magma_CSR}, hAUt={Magma_CSR};
-            CHECK( magma_dsymbilu( &hACSR, precond->levels, &hAL, &hAUt,  queue ));
+            CHECK( magma_dsymbilu_stats( &hACSR, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
             magma_dmfree(&hAL, queue);
             magma_dmfree(&hAUt, queue);
     }
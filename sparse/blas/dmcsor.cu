@@ -0,0 +1,118 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @generated from sparse/blas/zmcsor.cu, normal z -> d, Sun Oct 18 03:59:12 2026
+       @author Hartwig Anzt
+
+*/
+#include "magmasparse_internal.h"
+
+#define BLOCK_SIZE 256
+
+
+// relaxes rows first ... last-1 of M, row k of M is row perm[k] of A
+__global__ void
+zmcsor_kernel(
+    int first,
+    int last,
+    double omega,
+    const magma_index_t * __restrict__ row,
+    const magma_index_t * __restrict__ col,
+    const double * __restrict__ val,
+    const double * __restrict__ dinv,
+    const magma_index_t * __restrict__ perm,
+    const double * __restrict__ b,
+    double *x )
+{
+    int k = first + blockDim.x * blockIdx.x + threadIdx.x;
+
+    if ( k < last ) {
+        magma_index_t i = perm[k];
+        double r = b[i];
+        for( magma_index_t j=row[k]; j < row[k+1]; j++ ) {
+            r -= val[j] * x[ col[j] ];
+        }
+        x[i] += omega * dinv[k] * r;
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    One relaxation step on the rows of one color of the multicolor
+    Gauss-Seidel / SOR smoother:
+
+        x(perm[k]) += omega * d[k] * ( b - A x )(perm[k]),   first <= k < last
+
+    where row k of M is row perm[k] of A and d holds the inverse diagonal.
+    The rows of one color are not coupled, so they are updated in parallel.
+
+    Arguments
+    ---------
+
+    @param[in]
+    first       magma_int_t
+                first row of M
+
+    @param[in]
+    last        magma_int_t
+                last row of M plus one
+
+    @param[in]
+    omega       double
+                relaxation parameter
+
+    @param[in]
+    M           magma_d_matrix
+                rows of A in color order, CSR on the device
+
+    @param[in]
+    d           magma_d_matrix
+                inverse diagonal in the order of M
+
+    @param[in]
+    perm        magma_index_t*
+                row of A for every row of M, on the device
+
+    @param[in]
+    b           magma_d_matrix
+                right-hand side
+
+    @param[in,out]
+    x           magma_d_matrix*
+                iteration vector
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dmcsor_sweep(
+    magma_int_t first,
+    magma_int_t last,
+    double omega,
+    magma_d_matrix M,
+    magma_d_matrix d,
+    magma_index_t *perm,
+    magma_d_matrix b,
+    magma_d_matrix *x,
+    magma_queue_t queue )
+{
+    if ( last > first ) {
+        dim3 grid( magma_ceildiv( last - first, BLOCK_SIZE ));
+        magma_int_t threads = BLOCK_SIZE;
+        zmcsor_kernel<<< grid, threads, 0, queue->cuda_stream() >>>
+            ( first, last, omega, M.drow, M.dcol, M.dval, d.dval, perm,
+              b.dval, x->dval );
+    }
+    return MAGMA_SUCCESS;
+}
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/blas/magma_z_blaswrapper.cpp, normal z -> c, Wed Feb 22 15:21:33 2023
+       @generated from sparse/blas/magma_z_blaswrapper.cpp, normal z -> c, Sun Oct 18 02:56:31 2026
        @author Hartwig Anzt
 
 */
@@ -327,19 +327,9 @@ magma_c_spmv(
             }
         }
     }
-    // CPU case missing!
+    // CPU case
     else {
-        CHECK( magma_cmtransfer( x, &dx, x.memory_location, Magma_DEV, queue ));
-        CHECK( magma_cmtransfer( y, &dy, y.memory_location, Magma_DEV, queue ));
-        CHECK( magma_cmtransfer( A, &dA, A.memory_location, Magma_DEV, queue ));
-        CHECK( magma_c_spmv( alpha, dA, dx, beta, dy, queue ) );
-        magma_cmfree(&x, queue );
-        magma_cmfree(&y, queue );
-        magma_cmfree(&A, queue );
-        CHECK( magma_cmtransfer( dx, &x, dx.memory_location, Magma_CPU, queue ));
-        CHECK( magma_cmtransfer( dy, &y, dy.memory_location, Magma_CPU, queue ));
-        CHECK( magma_cmtransfer( dA, &A, dA.memory_location, Magma_CPU, queue ));
-
+        CHECK( magma_c_spmv_cpu( alpha, A, x, beta, y, queue ));
     }
 
 cleanup:
@@ -466,10 +456,10 @@ magma_c_spmv_shift(
             info = MAGMA_ERR_NOT_SUPPORTED;
         }
     }
-    // CPU case missing!
+    // CPU case
     else {
-        printf("error: CPU not yet supported.\n");
-        info = MAGMA_ERR_NOT_SUPPORTED;
+        CHECK( magma_c_spmv_shift_cpu( alpha, A, lambda, x, beta, offset,
+                                       blocksize, add_rows, y, queue ));
     }
 cleanup:
     return info;
@@ -546,14 +536,20 @@ magma_c_spmm(
             }
         }
     }
-    // CPU case missing!
+    // CPU case
     else {
-        A.storage_type = Magma_CSR;
-        B.storage_type = Magma_CSR;
-        CHECK( magma_cmtransfer( A, &dA, Magma_CPU, Magma_DEV, queue ) );
-        CHECK( magma_cmtransfer( B, &dB, Magma_CPU, Magma_DEV, queue ) );
-        CHECK(  magma_ccuspmm( dA, dB, &dC, queue ) );
-        CHECK( magma_cmtransfer( dC, C, Magma_DEV, Magma_CPU, queue ) );
+        if ( A.num_cols == B.num_rows ) {
+            if ( A.storage_type == Magma_CSR  ||
+                 A.storage_type == Magma_CSRL ||
+                 A.storage_type == Magma_CSRU ||
+                 A.storage_type == Magma_CSRCOO ) {
+               CHECK( magma_c_spmm_cpu( alpha, A, B, C, queue ));
+            }
+            else {
+                printf("error: format not supported.\n");
+                info = MAGMA_ERR_NOT_SUPPORTED;
+            }
+        }
     }
     
 cleanup:
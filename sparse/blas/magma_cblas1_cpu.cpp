@@ -0,0 +1,461 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @generated from sparse/blas/magma_zblas1_cpu.cpp, normal z -> c, Sun Oct 18 03:18:37 2026
+       @author Hartwig Anzt
+
+*/
+#include "magmasparse_internal.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// rows of the multi-vector handled at once by magma_cmdotc_cpu,
+// so that the chunk of r stays in cache across the k dot products
+#define BLOCK_ROWS 512
+
+
+/**
+    Purpose
+    -------
+
+    Computes the dot product <x,y> = x^H y of two vectors in host memory.
+    The partial sums are reduced with OpenMP.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of x and y
+
+    @param[in]
+    x           const magmaFloatComplex*
+                input vector
+
+    @param[in]
+    y           const magmaFloatComplex*
+                input vector
+
+    @ingroup magmasparse_cblas
+    ********************************************************************/
+
+extern "C" magmaFloatComplex
+magma_cdotc_cpu(
+    magma_int_t n,
+    const magmaFloatComplex *x,
+    const magmaFloatComplex *y )
+{
+    float re = 0.0, im = 0.0;
+
+    #pragma omp parallel for reduction(+:re,im) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        magmaFloatComplex t = MAGMA_C_CONJ( x[i] ) * y[i];
+        re += MAGMA_C_REAL( t );
+        im += MAGMA_C_IMAG( t );
+    }
+    return MAGMA_C_MAKE( re, im );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes two independent dot products in one sweep:
+
+    skp[0] = <v0,w0>,   skp[1] = <v1,w1>.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    v0          const magmaFloatComplex*
+                input vector
+
+    @param[in]
+    w0          const magmaFloatComplex*
+                input vector
+
+    @param[in]
+    v1          const magmaFloatComplex*
+                input vector
+
+    @param[in]
+    w1          const magmaFloatComplex*
+                input vector
+
+    @param[out]
+    skp         magmaFloatComplex*
+                array[2] of scalar products
+
+    @ingroup magmasparse_cblas
+    ********************************************************************/
+
+extern "C" void
+magma_cdotc2_cpu(
+    magma_int_t n,
+    const magmaFloatComplex *v0,
+    const magmaFloatComplex *w0,
+    const magmaFloatComplex *v1,
+    const magmaFloatComplex *w1,
+    magmaFloatComplex *skp )
+{
+    float re0 = 0.0, im0 = 0.0, re1 = 0.0, im1 = 0.0;
+
+    #pragma omp parallel for reduction(+:re0,im0,re1,im1) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        magmaFloatComplex t0 = MAGMA_C_CONJ( v0[i] ) * w0[i];
+        magmaFloatComplex t1 = MAGMA_C_CONJ( v1[i] ) * w1[i];
+        re0 += MAGMA_C_REAL( t0 );
+        im0 += MAGMA_C_IMAG( t0 );
+        re1 += MAGMA_C_REAL( t1 );
+        im1 += MAGMA_C_IMAG( t1 );
+    }
+    skp[0] = MAGMA_C_MAKE( re0, im0 );
+    skp[1] = MAGMA_C_MAKE( re1, im1 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the scalar products of the k columns of v with r in a single
+    sweep over r:
+
+    skp[j] = <v_j,r>,   j = 0, ..., k-1.
+
+    This is the host counterpart of magma_cmdotc, used for the
+    orthogonalization in GMRES and IDR.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of v_j and r
+
+    @param[in]
+    k           magma_int_t
+                number of vectors v_j
+
+    @param[in]
+    v           const magmaFloatComplex*
+                n-by-k matrix stored column-major with leading dimension n
+
+    @param[in]
+    r           const magmaFloatComplex*
+                input vector
+
+    @param[out]
+    skp         magmaFloatComplex*
+                array[k] of scalar products
+
+    @ingroup magmasparse_cblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cmdotc_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    const magmaFloatComplex *v,
+    const magmaFloatComplex *r,
+    magmaFloatComplex *skp )
+{
+    magma_int_t info = 0;
+    magma_int_t nthreads = 1;
+    magmaFloatComplex *partial = NULL;
+
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    CHECK( magma_cmalloc_cpu( &partial, nthreads*k ));
+    // the team may be smaller than nthreads, unused slots stay zero
+    for( magma_int_t j=0; j < nthreads*k; j++ ) {
+        partial[j] = MAGMA_C_ZERO;
+    }
+
+    #pragma omp parallel
+    {
+#ifdef _OPENMP
+        magma_int_t tid = omp_get_thread_num();
+#else
+        magma_int_t tid = 0;
+#endif
+        magmaFloatComplex *sum = partial + tid*k;
+        #pragma omp for schedule(static)
+        for( magma_int_t i0=0; i0 < n; i0 += BLOCK_ROWS ) {
+            magma_int_t i1 = min( i0 + BLOCK_ROWS, n );
+            for( magma_int_t j=0; j < k; j++ ) {
+                const magmaFloatComplex *vj = v + j*n;
+                magmaFloatComplex t = MAGMA_C_ZERO;
+                for( magma_int_t i=i0; i < i1; i++ ) {
+                    t += MAGMA_C_CONJ( vj[i] ) * r[i];
+                }
+                sum[j] += t;
+            }
+        }
+    }
+    for( magma_int_t j=0; j < k; j++ ) {
+        skp[j] = MAGMA_C_ZERO;
+        for( magma_int_t t=0; t < nthreads; t++ ) {
+            skp[j] += partial[t*k + j];
+        }
+    }
+
+cleanup:
+    magma_free_cpu( partial );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes y = alpha * V c + beta * y with V an n-by-k column-major
+    multi-vector, in a single sweep over y. This is the host counterpart of
+    a non-transposed gemv for tall-skinny V, used to update the iterates of
+    GMRES and IDR from their bases.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the columns of V and of y
+
+    @param[in]
+    k           magma_int_t
+                number of columns of V
+
+    @param[in]
+    alpha       magmaFloatComplex
+                scalar
+
+    @param[in]
+    v           const magmaFloatComplex*
+                n-by-k matrix stored column-major with leading dimension n
+
+    @param[in]
+    c           const magmaFloatComplex*
+                array[k] of coefficients
+
+    @param[in]
+    beta        magmaFloatComplex
+                scalar
+
+    @param[in,out]
+    y           magmaFloatComplex*
+                input/output vector
+
+    @ingroup magmasparse_cblas
+    ********************************************************************/
+
+extern "C" void
+magma_cmaxpy_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    magmaFloatComplex alpha,
+    const magmaFloatComplex *v,
+    const magmaFloatComplex *c,
+    magmaFloatComplex beta,
+    magmaFloatComplex *y )
+{
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        magmaFloatComplex t = MAGMA_C_ZERO;
+        for( magma_int_t j=0; j < k; j++ ) {
+            t += v[j*n + i] * c[j];
+        }
+        y[i] = MAGMA_C_EQUAL( beta, MAGMA_C_ZERO ) ? alpha * t : alpha * t + beta * y[i];
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the Euclidean norm of a vector in host memory.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of x
+
+    @param[in]
+    x           const magmaFloatComplex*
+                input vector
+
+    @ingroup magmasparse_cblas
+    ********************************************************************/
+
+extern "C" float
+magma_scnrm2_cpu(
+    magma_int_t n,
+    const magmaFloatComplex *x )
+{
+    float sum = 0.0;
+
+    #pragma omp parallel for reduction(+:sum) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        sum += MAGMA_C_REAL( x[i] ) * MAGMA_C_REAL( x[i] )
+             + MAGMA_C_IMAG( x[i] ) * MAGMA_C_IMAG( x[i] );
+    }
+    return sqrt( sum );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes y = alpha * x + beta * y for vectors in host memory.
+    beta = 1 is an axpy, beta = 0 overwrites y.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of x and y
+
+    @param[in]
+    alpha       magmaFloatComplex
+                scalar
+
+    @param[in]
+    x           const magmaFloatComplex*
+                input vector
+
+    @param[in]
+    beta        magmaFloatComplex
+                scalar
+
+    @param[in,out]
+    y           magmaFloatComplex*
+                input/output vector
+
+    @ingroup magmasparse_cblas
+    ********************************************************************/
+
+extern "C" void
+magma_caxpby_cpu(
+    magma_int_t n,
+    magmaFloatComplex alpha,
+    const magmaFloatComplex *x,
+    magmaFloatComplex beta,
+    magmaFloatComplex *y )
+{
+    if ( MAGMA_C_EQUAL( beta, MAGMA_C_ZERO ) ) {
+        #pragma omp parallel for simd schedule(static)
+        for( magma_int_t i=0; i < n; i++ ) {
+            y[i] = alpha * x[i];
+        }
+    }
+    else if ( MAGMA_C_EQUAL( beta, MAGMA_C_ONE ) ) {
+        #pragma omp parallel for simd schedule(static)
+        for( magma_int_t i=0; i < n; i++ ) {
+            y[i] += alpha * x[i];
+        }
+    }
+    else {
+        #pragma omp parallel for simd schedule(static)
+        for( magma_int_t i=0; i < n; i++ ) {
+            y[i] = alpha * x[i] + beta * y[i];
+        }
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Copies x into y, both in host memory.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of x and y
+
+    @param[in]
+    x           const magmaFloatComplex*
+                input vector
+
+    @param[out]
+    y           magmaFloatComplex*
+                output vector
+
+    @ingroup magmasparse_cblas
+    ********************************************************************/
+
+extern "C" void
+magma_ccopy_cpu(
+    magma_int_t n,
+    const magmaFloatComplex *x,
+    magmaFloatComplex *y )
+{
+    #pragma omp parallel for simd schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        y[i] = x[i];
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the elementwise product x = d .* b, e.g. to apply a Jacobi
+    preconditioner stored as the inverse of the diagonal.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    d           const magmaFloatComplex*
+                scaling vector
+
+    @param[in]
+    b           const magmaFloatComplex*
+                input vector
+
+    @param[out]
+    x           magmaFloatComplex*
+                output vector
+
+    @ingroup magmasparse_cblas
+    ********************************************************************/
+
+extern "C" void
+magma_cdiagscal_cpu(
+    magma_int_t n,
+    const magmaFloatComplex *d,
+    const magmaFloatComplex *b,
+    magmaFloatComplex *x )
+{
+    #pragma omp parallel for simd schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        x[i] = d[i] * b[i];
+    }
+}
@@ -0,0 +1,1149 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @generated from sparse/blas/magma_zmergekrylov_cpu.cpp, normal z -> c, Sun Oct 18 03:37:07 2026
+       @author Hartwig Anzt
+
+       Fused host kernels for the merged Krylov solvers.
+
+       Each kernel is a single OpenMP sweep over blocks of rows. Where the
+       SpMV input is a linear combination of vectors (e.g. p = r + beta p),
+       the combination is formed on the fly inside the SpMV gather instead
+       of being written and read back, and the new vector is written for
+       the rows owned by the block. The dot products needed by the
+       following scalar update are accumulated in the same sweep.
+       Only CSR and SELLP are supported, the solvers convert other formats.
+*/
+#include "magmasparse_internal.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// rows processed per OpenMP chunk
+#define BLOCK_ROWS 512
+
+
+// gathers row i of A against the vector returned entry-wise by x(j)
+template< typename Gather >
+static inline magmaFloatComplex
+magma_cmerge_rowdot(
+    const magma_c_matrix &A,
+    magma_int_t i,
+    Gather x )
+{
+    magmaFloatComplex dot = MAGMA_C_ZERO;
+    if ( A.storage_type == Magma_SELLP ) {
+        magma_int_t C = A.blocksize;
+        magma_int_t s = i / C;
+        for( magma_int_t k = A.row[s] + i%C; k < A.row[s+1]; k += C ) {
+            dot += A.val[k] * x( A.col[k] );
+        }
+    } else {
+        for( magma_int_t k = A.row[i]; k < A.row[i+1]; k++ ) {
+            dot += A.val[k] * x( A.col[k] );
+        }
+    }
+    return dot;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Returns an estimate of the bytes read from memory by one host SpMV
+    with A (values, column indices and row pointers of the stored entries,
+    including SELLP padding). Used by the merged solvers to report the
+    memory traffic per iteration through solver_par->iter_bytes.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                sparse matrix in CSR or SELLP
+
+    @ingroup magmasparse_cblas
+    ********************************************************************/
+
+extern "C" float
+magma_cmergebytes_cpu(
+    magma_c_matrix A )
+{
+    bool sellp = ( A.storage_type == Magma_SELLP );
+    float stored = sellp ? (float) A.row[ A.numblocks ] : (float) A.nnz;
+    float ptrs   = sellp ? (float) A.numblocks + 1 : (float) A.num_rows + 1;
+
+    return stored * ( sizeof(magmaFloatComplex) + sizeof(magma_index_t) )
+           + ptrs * sizeof(magma_index_t);
+}
+
+
+/**
+    Purpose
+    -------
+
+    Fused search direction update and SpMV of CG:
+
+    pn = r + beta * p
+    q  = A * pn
+    skp[0] = <pn,q>
+
+    A * pn is computed from r and p directly, pn and p must not alias.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                system matrix in CSR or SELLP on the CPU
+
+    @param[in]
+    beta        magmaFloatComplex
+                scalar
+
+    @param[in]
+    r           const magmaFloatComplex*
+                residual
+
+    @param[in]
+    p           const magmaFloatComplex*
+                previous search direction
+
+    @param[out]
+    pn          magmaFloatComplex*
+                new search direction
+
+    @param[out]
+    q           magmaFloatComplex*
+                q = A pn
+
+    @param[out]
+    skp         magmaFloatComplex*
+                array[1] of scalar products
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_ccgmerge_spmv_cpu(
+    magma_c_matrix A,
+    magmaFloatComplex beta,
+    const magmaFloatComplex *r,
+    const magmaFloatComplex *p,
+    magmaFloatComplex *pn,
+    magmaFloatComplex *q,
+    magmaFloatComplex *skp )
+{
+    magma_int_t n = A.num_rows;
+    float re = 0.0, im = 0.0;
+
+    #pragma omp parallel for reduction(+:re,im) schedule(dynamic)
+    for( magma_int_t i0=0; i0 < n; i0 += BLOCK_ROWS ) {
+        magma_int_t i1 = min( i0 + BLOCK_ROWS, n );
+        for( magma_int_t i=i0; i < i1; i++ ) {
+            magmaFloatComplex qi = magma_cmerge_rowdot( A, i,
+                [&]( magma_index_t j ) { return r[j] + beta * p[j]; } );
+            magmaFloatComplex pi = r[i] + beta * p[i];
+            magmaFloatComplex t = MAGMA_C_CONJ( pi ) * qi;
+            pn[i] = pi;
+            q[i] = qi;
+            re += MAGMA_C_REAL( t );
+            im += MAGMA_C_IMAG( t );
+        }
+    }
+    skp[0] = MAGMA_C_MAKE( re, im );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Fused solution and residual update of CG:
+
+    x = x + alpha * p
+    r = r - alpha * q
+    skp[0] = <r,r>
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    alpha       magmaFloatComplex
+                scalar
+
+    @param[in]
+    p           const magmaFloatComplex*
+                search direction
+
+    @param[in]
+    q           const magmaFloatComplex*
+                q = A p
+
+    @param[in,out]
+    x           magmaFloatComplex*
+                solution approximation
+
+    @param[in,out]
+    r           magmaFloatComplex*
+                residual
+
+    @param[out]
+    skp         magmaFloatComplex*
+                array[1] of scalar products
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_ccgmerge_xr_cpu(
+    magma_int_t n,
+    magmaFloatComplex alpha,
+    const magmaFloatComplex *p,
+    const magmaFloatComplex *q,
+    magmaFloatComplex *x,
+    magmaFloatComplex *r,
+    magmaFloatComplex *skp )
+{
+    float re = 0.0;
+
+    #pragma omp parallel for reduction(+:re) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        magmaFloatComplex ri = r[i] - alpha * q[i];
+        x[i] += alpha * p[i];
+        r[i] = ri;
+        re += MAGMA_C_REAL( MAGMA_C_CONJ( ri ) * ri );
+    }
+    skp[0] = MAGMA_C_MAKE( re, 0.0 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    First fused sweep of BiCGSTAB:
+
+    pn = r + beta * ( p - omega * v )
+    vn = A * pn
+    skp[0] = <rr,vn>
+
+    pn and vn must not alias p and v.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                system matrix in CSR or SELLP on the CPU
+
+    @param[in]
+    beta        magmaFloatComplex
+                scalar
+
+    @param[in]
+    omega       magmaFloatComplex
+                scalar
+
+    @param[in]
+    r           const magmaFloatComplex*
+                residual
+
+    @param[in]
+    rr          const magmaFloatComplex*
+                shadow residual
+
+    @param[in]
+    p           const magmaFloatComplex*
+                previous search direction
+
+    @param[in]
+    v           const magmaFloatComplex*
+                previous A p
+
+    @param[out]
+    pn          magmaFloatComplex*
+                new search direction
+
+    @param[out]
+    vn          magmaFloatComplex*
+                vn = A pn
+
+    @param[out]
+    skp         magmaFloatComplex*
+                array[1] of scalar products
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_cbicgmerge_spmv1_cpu(
+    magma_c_matrix A,
+    magmaFloatComplex beta,
+    magmaFloatComplex omega,
+    const magmaFloatComplex *r,
+    const magmaFloatComplex *rr,
+    const magmaFloatComplex *p,
+    const magmaFloatComplex *v,
+    magmaFloatComplex *pn,
+    magmaFloatComplex *vn,
+    magmaFloatComplex *skp )
+{
+    magma_int_t n = A.num_rows;
+    float re = 0.0, im = 0.0;
+
+    #pragma omp parallel for reduction(+:re,im) schedule(dynamic)
+    for( magma_int_t i0=0; i0 < n; i0 += BLOCK_ROWS ) {
+        magma_int_t i1 = min( i0 + BLOCK_ROWS, n );
+        for( magma_int_t i=i0; i < i1; i++ ) {
+            magmaFloatComplex vi = magma_cmerge_rowdot( A, i,
+                [&]( magma_index_t j ) { return r[j] + beta * ( p[j] - omega * v[j] ); } );
+            magmaFloatComplex t = MAGMA_C_CONJ( rr[i] ) * vi;
+            pn[i] = r[i] + beta * ( p[i] - omega * v[i] );
+            vn[i] = vi;
+            re += MAGMA_C_REAL( t );
+            im += MAGMA_C_IMAG( t );
+        }
+    }
+    skp[0] = MAGMA_C_MAKE( re, im );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Second fused sweep of BiCGSTAB:
+
+    s = r - alpha * v
+    t = A * s
+    skp[0] = <t,s>,   skp[1] = <t,t>
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                system matrix in CSR or SELLP on the CPU
+
+    @param[in]
+    alpha       magmaFloatComplex
+                scalar
+
+    @param[in]
+    r           const magmaFloatComplex*
+                residual
+
+    @param[in]
+    v           const magmaFloatComplex*
+                A p
+
+    @param[out]
+    s           magmaFloatComplex*
+                intermediate residual
+
+    @param[out]
+    t           magmaFloatComplex*
+                t = A s
+
+    @param[out]
+    skp         magmaFloatComplex*
+                array[2] of scalar products
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_cbicgmerge_spmv2_cpu(
+    magma_c_matrix A,
+    magmaFloatComplex alpha,
+    const magmaFloatComplex *r,
+    const magmaFloatComplex *v,
+    magmaFloatComplex *s,
+    magmaFloatComplex *t,
+    magmaFloatComplex *skp )
+{
+    magma_int_t n = A.num_rows;
+    float re0 = 0.0, im0 = 0.0, re1 = 0.0;
+
+    #pragma omp parallel for reduction(+:re0,im0,re1) schedule(dynamic)
+    for( magma_int_t i0=0; i0 < n; i0 += BLOCK_ROWS ) {
+        magma_int_t i1 = min( i0 + BLOCK_ROWS, n );
+        for( magma_int_t i=i0; i < i1; i++ ) {
+            magmaFloatComplex ti = magma_cmerge_rowdot( A, i,
+                [&]( magma_index_t j ) { return r[j] - alpha * v[j]; } );
+            magmaFloatComplex si = r[i] - alpha * v[i];
+            magmaFloatComplex ts = MAGMA_C_CONJ( ti ) * si;
+            s[i] = si;
+            t[i] = ti;
+            re0 += MAGMA_C_REAL( ts );
+            im0 += MAGMA_C_IMAG( ts );
+            re1 += MAGMA_C_REAL( MAGMA_C_CONJ( ti ) * ti );
+        }
+    }
+    skp[0] = MAGMA_C_MAKE( re0, im0 );
+    skp[1] = MAGMA_C_MAKE( re1, 0.0 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Fused solution and residual update of BiCGSTAB:
+
+    x = x + alpha * p + omega * s
+    r = s - omega * t
+    skp[0] = <r,r>,   skp[1] = <rr,r>
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    alpha       magmaFloatComplex
+                scalar
+
+    @param[in]
+    omega       magmaFloatComplex
+                scalar
+
+    @param[in]
+    p           const magmaFloatComplex*
+                search direction
+
+    @param[in]
+    s           const magmaFloatComplex*
+                intermediate residual
+
+    @param[in]
+    t           const magmaFloatComplex*
+                A s
+
+    @param[in]
+    rr          const magmaFloatComplex*
+                shadow residual
+
+    @param[in,out]
+    x           magmaFloatComplex*
+                solution approximation
+
+    @param[out]
+    r           magmaFloatComplex*
+                residual
+
+    @param[out]
+    skp         magmaFloatComplex*
+                array[2] of scalar products
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_cbicgmerge_xr_cpu(
+    magma_int_t n,
+    magmaFloatComplex alpha,
+    magmaFloatComplex omega,
+    const magmaFloatComplex *p,
+    const magmaFloatComplex *s,
+    const magmaFloatComplex *t,
+    const magmaFloatComplex *rr,
+    magmaFloatComplex *x,
+    magmaFloatComplex *r,
+    magmaFloatComplex *skp )
+{
+    float re0 = 0.0, re1 = 0.0, im1 = 0.0;
+
+    #pragma omp parallel for reduction(+:re0,re1,im1) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        magmaFloatComplex ri = s[i] - omega * t[i];
+        magmaFloatComplex rri = MAGMA_C_CONJ( rr[i] ) * ri;
+        x[i] += alpha * p[i] + omega * s[i];
+        r[i] = ri;
+        re0 += MAGMA_C_REAL( MAGMA_C_CONJ( ri ) * ri );
+        re1 += MAGMA_C_REAL( rri );
+        im1 += MAGMA_C_IMAG( rri );
+    }
+    skp[0] = MAGMA_C_MAKE( re0, 0.0 );
+    skp[1] = MAGMA_C_MAKE( re1, im1 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    First fused sweep of a TFQMR half step:
+
+    u_mp1 = u_m - alpha * v         (odd steps only)
+    w     = w - alpha * Au
+    d     = u_m + sigma * d
+    Ad    = Au + sigma * Ad
+    skp[0] = <w,w>,   skp[1] = <r_tld,w>
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    odd         magma_int_t
+                whether this is an odd half step
+
+    @param[in]
+    alpha       magmaFloatComplex
+                scalar
+
+    @param[in]
+    sigma       magmaFloatComplex
+                scalar
+
+    @param[in]
+    v           const magmaFloatComplex*
+                vector v
+
+    @param[in]
+    Au          const magmaFloatComplex*
+                A u_m
+
+    @param[in]
+    u_m         const magmaFloatComplex*
+                vector u_m
+
+    @param[in]
+    r_tld       const magmaFloatComplex*
+                shadow residual
+
+    @param[out]
+    u_mp1       magmaFloatComplex*
+                vector u_mp1, written on odd steps
+
+    @param[in,out]
+    w           magmaFloatComplex*
+                vector w
+
+    @param[in,out]
+    d           magmaFloatComplex*
+                vector d
+
+    @param[in,out]
+    Ad          magmaFloatComplex*
+                A d
+
+    @param[out]
+    skp         magmaFloatComplex*
+                array[2] of scalar products
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_ctfqmrmerge_1_cpu(
+    magma_int_t n,
+    magma_int_t odd,
+    magmaFloatComplex alpha,
+    magmaFloatComplex sigma,
+    const magmaFloatComplex *v,
+    const magmaFloatComplex *Au,
+    const magmaFloatComplex *u_m,
+    const magmaFloatComplex *r_tld,
+    magmaFloatComplex *u_mp1,
+    magmaFloatComplex *w,
+    magmaFloatComplex *d,
+    magmaFloatComplex *Ad,
+    magmaFloatComplex *skp )
+{
+    float re0 = 0.0, re1 = 0.0, im1 = 0.0;
+
+    #pragma omp parallel for reduction(+:re0,re1,im1) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        if ( odd ) {
+            u_mp1[i] = u_m[i] - alpha * v[i];
+        }
+        magmaFloatComplex wi = w[i] - alpha * Au[i];
+        magmaFloatComplex wr = MAGMA_C_CONJ( r_tld[i] ) * wi;
+        w[i] = wi;
+        d[i] = u_m[i] + sigma * d[i];
+        Ad[i] = Au[i] + sigma * Ad[i];
+        re0 += MAGMA_C_REAL( MAGMA_C_CONJ( wi ) * wi );
+        re1 += MAGMA_C_REAL( wr );
+        im1 += MAGMA_C_IMAG( wr );
+    }
+    skp[0] = MAGMA_C_MAKE( re0, 0.0 );
+    skp[1] = MAGMA_C_MAKE( re1, im1 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Second fused sweep of a TFQMR half step:
+
+    x = x + eta * d
+    r = r - eta * Ad
+    skp[0] = <r,r>
+
+    and on even steps additionally
+
+    u_mp1 = w + beta * u_m
+    v     = beta * ( Au + beta * v )
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    even        magma_int_t
+                whether this is an even half step
+
+    @param[in]
+    eta         magmaFloatComplex
+                scalar
+
+    @param[in]
+    beta        magmaFloatComplex
+                scalar, only referenced on even steps
+
+    @param[in]
+    d           const magmaFloatComplex*
+                vector d
+
+    @param[in]
+    Ad          const magmaFloatComplex*
+                A d
+
+    @param[in]
+    w           const magmaFloatComplex*
+                vector w
+
+    @param[in]
+    u_m         const magmaFloatComplex*
+                vector u_m
+
+    @param[in]
+    Au          const magmaFloatComplex*
+                A u_m
+
+    @param[in,out]
+    x           magmaFloatComplex*
+                solution approximation
+
+    @param[in,out]
+    r           magmaFloatComplex*
+                residual
+
+    @param[out]
+    u_mp1       magmaFloatComplex*
+                vector u_mp1, written on even steps
+
+    @param[in,out]
+    v           magmaFloatComplex*
+                vector v, updated on even steps
+
+    @param[out]
+    skp         magmaFloatComplex*
+                array[1] of scalar products
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_ctfqmrmerge_2_cpu(
+    magma_int_t n,
+    magma_int_t even,
+    magmaFloatComplex eta,
+    magmaFloatComplex beta,
+    const magmaFloatComplex *d,
+    const magmaFloatComplex *Ad,
+    const magmaFloatComplex *w,
+    const magmaFloatComplex *u_m,
+    const magmaFloatComplex *Au,
+    magmaFloatComplex *x,
+    magmaFloatComplex *r,
+    magmaFloatComplex *u_mp1,
+    magmaFloatComplex *v,
+    magmaFloatComplex *skp )
+{
+    float re = 0.0;
+
+    #pragma omp parallel for reduction(+:re) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        magmaFloatComplex ri = r[i] - eta * Ad[i];
+        x[i] += eta * d[i];
+        r[i] = ri;
+        re += MAGMA_C_REAL( MAGMA_C_CONJ( ri ) * ri );
+        if ( even ) {
+            u_mp1[i] = w[i] + beta * u_m[i];
+            v[i] = beta * ( Au[i] + beta * v[i] );
+        }
+    }
+    skp[0] = MAGMA_C_MAKE( re, 0.0 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    SpMV sweep of a TFQMR half step:
+
+    Au = A * u_mp1
+
+    and on even steps additionally
+
+    v = v + Au
+    skp[0] = <r_tld,v>
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                system matrix in CSR or SELLP on the CPU
+
+    @param[in]
+    even        magma_int_t
+                whether this is an even half step
+
+    @param[in]
+    u_mp1       const magmaFloatComplex*
+                vector u_mp1
+
+    @param[in]
+    r_tld       const magmaFloatComplex*
+                shadow residual
+
+    @param[out]
+    Au          magmaFloatComplex*
+                A u_mp1
+
+    @param[in,out]
+    v           magmaFloatComplex*
+                vector v, updated on even steps
+
+    @param[out]
+    skp         magmaFloatComplex*
+                array[1] of scalar products, written on even steps
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_ctfqmrmerge_spmv_cpu(
+    magma_c_matrix A,
+    magma_int_t even,
+    const magmaFloatComplex *u_mp1,
+    const magmaFloatComplex *r_tld,
+    magmaFloatComplex *Au,
+    magmaFloatComplex *v,
+    magmaFloatComplex *skp )
+{
+    magma_int_t n = A.num_rows;
+    float re = 0.0, im = 0.0;
+
+    #pragma omp parallel for reduction(+:re,im) schedule(dynamic)
+    for( magma_int_t i0=0; i0 < n; i0 += BLOCK_ROWS ) {
+        magma_int_t i1 = min( i0 + BLOCK_ROWS, n );
+        for( magma_int_t i=i0; i < i1; i++ ) {
+            magmaFloatComplex ai = magma_cmerge_rowdot( A, i,
+                [&]( magma_index_t j ) { return u_mp1[j]; } );
+            Au[i] = ai;
+            if ( even ) {
+                magmaFloatComplex vi = v[i] + ai;
+                magmaFloatComplex t = MAGMA_C_CONJ( r_tld[i] ) * vi;
+                v[i] = vi;
+                re += MAGMA_C_REAL( t );
+                im += MAGMA_C_IMAG( t );
+            }
+        }
+    }
+    if ( even ) {
+        skp[0] = MAGMA_C_MAKE( re, im );
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Fused SpMV and shadow space projection of IDR(s):
+
+    y = A * x
+    skp[j] = <P_j,y>,   j = 0, ..., s-1
+    skp[s] = <y,y>,  skp[s+1] = <y,x>,  skp[s+2] = <x,x>   (if dots is nonzero)
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                system matrix in CSR or SELLP on the CPU
+
+    @param[in]
+    s           magma_int_t
+                number of columns of P, may be 0
+
+    @param[in]
+    P           const magmaFloatComplex*
+                n-by-s shadow space, column-major
+
+    @param[in]
+    dots        magma_int_t
+                whether to compute <y,y>, <y,x> and <x,x>
+
+    @param[in]
+    x           const magmaFloatComplex*
+                input vector
+
+    @param[out]
+    y           magmaFloatComplex*
+                y = A x
+
+    @param[out]
+    skp         magmaFloatComplex*
+                array[s+3] of scalar products
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cidrmerge_spmv_cpu(
+    magma_c_matrix A,
+    magma_int_t s,
+    const magmaFloatComplex *P,
+    magma_int_t dots,
+    const magmaFloatComplex *x,
+    magmaFloatComplex *y,
+    magmaFloatComplex *skp )
+{
+    magma_int_t info = 0;
+    magma_int_t n = A.num_rows;
+    magma_int_t k = s + 3;
+    magma_int_t nthreads = 1;
+    magmaFloatComplex *partial = NULL;
+
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    CHECK( magma_cmalloc_cpu( &partial, nthreads*k ));
+    for( magma_int_t j=0; j < nthreads*k; j++ ) {
+        partial[j] = MAGMA_C_ZERO;
+    }
+
+    #pragma omp parallel
+    {
+#ifdef _OPENMP
+        magma_int_t tid = omp_get_thread_num();
+#else
+        magma_int_t tid = 0;
+#endif
+        magmaFloatComplex *sum = partial + tid*k;
+        #pragma omp for schedule(dynamic)
+        for( magma_int_t i0=0; i0 < n; i0 += BLOCK_ROWS ) {
+            magma_int_t i1 = min( i0 + BLOCK_ROWS, n );
+            for( magma_int_t i=i0; i < i1; i++ ) {
+                y[i] = magma_cmerge_rowdot( A, i,
+                    [&]( magma_index_t j ) { return x[j]; } );
+            }
+            // the block of y is still in cache for the projections
+            for( magma_int_t j=0; j < s; j++ ) {
+                const magmaFloatComplex *pj = P + j*n;
+                magmaFloatComplex t = MAGMA_C_ZERO;
+                for( magma_int_t i=i0; i < i1; i++ ) {
+                    t += MAGMA_C_CONJ( pj[i] ) * y[i];
+                }
+                sum[j] += t;
+            }
+            if ( dots ) {
+                magmaFloatComplex yy = MAGMA_C_ZERO, yx = MAGMA_C_ZERO;
+                magmaFloatComplex xx = MAGMA_C_ZERO;
+                for( magma_int_t i=i0; i < i1; i++ ) {
+                    yy += MAGMA_C_CONJ( y[i] ) * y[i];
+                    yx += MAGMA_C_CONJ( y[i] ) * x[i];
+                    xx += MAGMA_C_CONJ( x[i] ) * x[i];
+                }
+                sum[s]   += yy;
+                sum[s+1] += yx;
+                sum[s+2] += xx;
+            }
+        }
+    }
+    for( magma_int_t j=0; j < k; j++ ) {
+        skp[j] = MAGMA_C_ZERO;
+        for( magma_int_t t=0; t < nthreads; t++ ) {
+            skp[j] += partial[t*k + j];
+        }
+    }
+
+cleanup:
+    magma_free_cpu( partial );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Fused biorthogonalization and iterate update of IDR(s):
+
+    g = g - G alpha,   u = u - U alpha     (G, U n-by-k, skipped if k = 0)
+    r = r - beta * g
+    x = x + beta * u
+    skp[0] = <rs-r,rs>,   skp[1] = <rs-r,rs-r>   (if rs is not NULL)
+
+    u may alias r, in which case x is updated with the old residual.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    k           magma_int_t
+                number of columns of G and U
+
+    @param[in]
+    alpha       const magmaFloatComplex*
+                array[k] of coefficients
+
+    @param[in]
+    beta        magmaFloatComplex
+                scalar
+
+    @param[in]
+    G           const magmaFloatComplex*
+                n-by-k matrix, column-major
+
+    @param[in]
+    U           const magmaFloatComplex*
+                n-by-k matrix, column-major
+
+    @param[in,out]
+    g           magmaFloatComplex*
+                vector g
+
+    @param[in,out]
+    u           magmaFloatComplex*
+                vector u
+
+    @param[in,out]
+    r           magmaFloatComplex*
+                residual
+
+    @param[in,out]
+    x           magmaFloatComplex*
+                solution approximation
+
+    @param[in]
+    rs          const magmaFloatComplex*
+                smoothed residual or NULL
+
+    @param[out]
+    skp         magmaFloatComplex*
+                array[2] of scalar products
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_cidrmerge_update_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    const magmaFloatComplex *alpha,
+    magmaFloatComplex beta,
+    const magmaFloatComplex *G,
+    const magmaFloatComplex *U,
+    magmaFloatComplex *g,
+    magmaFloatComplex *u,
+    magmaFloatComplex *r,
+    magmaFloatComplex *x,
+    const magmaFloatComplex *rs,
+    magmaFloatComplex *skp )
+{
+    float re0 = 0.0, im0 = 0.0, re1 = 0.0;
+
+    #pragma omp parallel for reduction(+:re0,im0,re1) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        magmaFloatComplex gi = g[i], ui = u[i];
+        for( magma_int_t j=0; j < k; j++ ) {
+            gi -= G[j*n + i] * alpha[j];
+            ui -= U[j*n + i] * alpha[j];
+        }
+        magmaFloatComplex ri = r[i] - beta * gi;
+        g[i] = gi;
+        u[i] = ui;
+        r[i] = ri;
+        x[i] += beta * ui;
+        if ( rs != NULL ) {
+            magmaFloatComplex ti = rs[i] - ri;
+            magmaFloatComplex t = MAGMA_C_CONJ( ti ) * rs[i];
+            re0 += MAGMA_C_REAL( t );
+            im0 += MAGMA_C_IMAG( t );
+            re1 += MAGMA_C_REAL( MAGMA_C_CONJ( ti ) * ti );
+        }
+    }
+    skp[0] = MAGMA_C_MAKE( re0, im0 );
+    skp[1] = MAGMA_C_MAKE( re1, 0.0 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Fused new direction of IDR(s):
+
+    u = omega * ( r - G c ) + U c
+
+    with G and U n-by-k. u may be a column of U: every entry is read
+    before it is written.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    k           magma_int_t
+                number of columns of G and U
+
+    @param[in]
+    omega       magmaFloatComplex
+                scalar
+
+    @param[in]
+    c           const magmaFloatComplex*
+                array[k] of coefficients
+
+    @param[in]
+    r           const magmaFloatComplex*
+                residual
+
+    @param[in]
+    G           const magmaFloatComplex*
+                n-by-k matrix, column-major
+
+    @param[in]
+    U           const magmaFloatComplex*
+                n-by-k matrix, column-major
+
+    @param[out]
+    u           magmaFloatComplex*
+                new direction
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_cidrmerge_dir_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    magmaFloatComplex omega,
+    const magmaFloatComplex *c,
+    const magmaFloatComplex *r,
+    const magmaFloatComplex *G,
+    const magmaFloatComplex *U,
+    magmaFloatComplex *u )
+{
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        magmaFloatComplex vi = r[i], ui = MAGMA_C_ZERO;
+        for( magma_int_t j=0; j < k; j++ ) {
+            vi -= G[j*n + i] * c[j];
+            ui += U[j*n + i] * c[j];
+        }
+        u[i] = omega * vi + ui;
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Fused residual smoothing of IDR(s):
+
+    rs = rs - gamma * ( rs - r )
+    xs = xs - gamma * ( xs - x )
+    skp[0] = <rs,rs>
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    gamma       magmaFloatComplex
+                scalar
+
+    @param[in]
+    r           const magmaFloatComplex*
+                residual
+
+    @param[in]
+    x           const magmaFloatComplex*
+                solution approximation
+
+    @param[in,out]
+    rs          magmaFloatComplex*
+                smoothed residual
+
+    @param[in,out]
+    xs          magmaFloatComplex*
+                smoothed solution
+
+    @param[out]
+    skp         magmaFloatComplex*
+                array[1] of scalar products
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_cidrmerge_smooth_cpu(
+    magma_int_t n,
+    magmaFloatComplex gamma,
+    const magmaFloatComplex *r,
+    const magmaFloatComplex *x,
+    magmaFloatComplex *rs,
+    magmaFloatComplex *xs,
+    magmaFloatComplex *skp )
+{
+    float re = 0.0;
+
+    #pragma omp parallel for reduction(+:re) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        magmaFloatComplex ri = rs[i] - gamma * ( rs[i] - r[i] );
+        rs[i] = ri;
+        xs[i] = xs[i] - gamma * ( xs[i] - x[i] );
+        re += MAGMA_C_REAL( MAGMA_C_CONJ( ri ) * ri );
+    }
+    skp[0] = MAGMA_C_MAKE( re, 0.0 );
+}
@@ -0,0 +1,461 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @generated from sparse/blas/magma_zblas1_cpu.cpp, normal z -> d, Sun Oct 18 03:18:37 2026
+       @author Hartwig Anzt
+
+*/
+#include "magmasparse_internal.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// rows of the multi-vector handled at once by magma_dmdotc_cpu,
+// so that the chunk of r stays in cache across the k dot products
+#define BLOCK_ROWS 512
+
+
+/**
+    Purpose
+    -------
+
+    Computes the dot product <x,y> = x^H y of two vectors in host memory.
+    The partial sums are reduced with OpenMP.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of x and y
+
+    @param[in]
+    x           const double*
+                input vector
+
+    @param[in]
+    y           const double*
+                input vector
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" double
+magma_ddot_cpu(
+    magma_int_t n,
+    const double *x,
+    const double *y )
+{
+    double re = 0.0, im = 0.0;
+
+    #pragma omp parallel for reduction(+:re,im) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        double t = MAGMA_D_CONJ( x[i] ) * y[i];
+        re += MAGMA_D_REAL( t );
+        im += MAGMA_D_IMAG( t );
+    }
+    return MAGMA_D_MAKE( re, im );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes two independent dot products in one sweep:
+
+    skp[0] = <v0,w0>,   skp[1] = <v1,w1>.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    v0          const double*
+                input vector
+
+    @param[in]
+    w0          const double*
+                input vector
+
+    @param[in]
+    v1          const double*
+                input vector
+
+    @param[in]
+    w1          const double*
+                input vector
+
+    @param[out]
+    skp         double*
+                array[2] of scalar products
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" void
+magma_ddot2_cpu(
+    magma_int_t n,
+    const double *v0,
+    const double *w0,
+    const double *v1,
+    const double *w1,
+    double *skp )
+{
+    double re0 = 0.0, im0 = 0.0, re1 = 0.0, im1 = 0.0;
+
+    #pragma omp parallel for reduction(+:re0,im0,re1,im1) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        double t0 = MAGMA_D_CONJ( v0[i] ) * w0[i];
+        double t1 = MAGMA_D_CONJ( v1[i] ) * w1[i];
+        re0 += MAGMA_D_REAL( t0 );
+        im0 += MAGMA_D_IMAG( t0 );
+        re1 += MAGMA_D_REAL( t1 );
+        im1 += MAGMA_D_IMAG( t1 );
+    }
+    skp[0] = MAGMA_D_MAKE( re0, im0 );
+    skp[1] = MAGMA_D_MAKE( re1, im1 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the scalar products of the k columns of v with r in a single
+    sweep over r:
+
+    skp[j] = <v_j,r>,   j = 0, ..., k-1.
+
+    This is the host counterpart of magma_dmdotc, used for the
+    orthogonalization in GMRES and IDR.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of v_j and r
+
+    @param[in]
+    k           magma_int_t
+                number of vectors v_j
+
+    @param[in]
+    v           const double*
+                n-by-k matrix stored column-major with leading dimension n
+
+    @param[in]
+    r           const double*
+                input vector
+
+    @param[out]
+    skp         double*
+                array[k] of scalar products
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dmdotc_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    const double *v,
+    const double *r,
+    double *skp )
+{
+    magma_int_t info = 0;
+    magma_int_t nthreads = 1;
+    double *partial = NULL;
+
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    CHECK( magma_dmalloc_cpu( &partial, nthreads*k ));
+    // the team may be smaller than nthreads, unused slots stay zero
+    for( magma_int_t j=0; j < nthreads*k; j++ ) {
+        partial[j] = MAGMA_D_ZERO;
+    }
+
+    #pragma omp parallel
+    {
+#ifdef _OPENMP
+        magma_int_t tid = omp_get_thread_num();
+#else
+        magma_int_t tid = 0;
+#endif
+        double *sum = partial + tid*k;
+        #pragma omp for schedule(static)
+        for( magma_int_t i0=0; i0 < n; i0 += BLOCK_ROWS ) {
+            magma_int_t i1 = min( i0 + BLOCK_ROWS, n );
+            for( magma_int_t j=0; j < k; j++ ) {
+                const double *vj = v + j*n;
+                double t = MAGMA_D_ZERO;
+                for( magma_int_t i=i0; i < i1; i++ ) {
+                    t += MAGMA_D_CONJ( vj[i] ) * r[i];
+                }
+                sum[j] += t;
+            }
+        }
+    }
+    for( magma_int_t j=0; j < k; j++ ) {
+        skp[j] = MAGMA_D_ZERO;
+        for( magma_int_t t=0; t < nthreads; t++ ) {
+            skp[j] += partial[t*k + j];
+        }
+    }
+
+cleanup:
+    magma_free_cpu( partial );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes y = alpha * V c + beta * y with V an n-by-k column-major
+    multi-vector, in a single sweep over y. This is the host counterpart of
+    a non-transposed gemv for tall-skinny V, used to update the iterates of
+    GMRES and IDR from their bases.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the columns of V and of y
+
+    @param[in]
+    k           magma_int_t
+                number of columns of V
+
+    @param[in]
+    alpha       double
+                scalar
+
+    @param[in]
+    v           const double*
+                n-by-k matrix stored column-major with leading dimension n
+
+    @param[in]
+    c           const double*
+                array[k] of coefficients
+
+    @param[in]
+    beta        double
+                scalar
+
+    @param[in,out]
+    y           double*
+                input/output vector
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" void
+magma_dmaxpy_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    double alpha,
+    const double *v,
+    const double *c,
+    double beta,
+    double *y )
+{
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        double t = MAGMA_D_ZERO;
+        for( magma_int_t j=0; j < k; j++ ) {
+            t += v[j*n + i] * c[j];
+        }
+        y[i] = MAGMA_D_EQUAL( beta, MAGMA_D_ZERO ) ? alpha * t : alpha * t + beta * y[i];
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the Euclidean norm of a vector in host memory.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of x
+
+    @param[in]
+    x           const double*
+                input vector
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" double
+magma_dnrm2_cpu(
+    magma_int_t n,
+    const double *x )
+{
+    double sum = 0.0;
+
+    #pragma omp parallel for reduction(+:sum) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        sum += MAGMA_D_REAL( x[i] ) * MAGMA_D_REAL( x[i] )
+             + MAGMA_D_IMAG( x[i] ) * MAGMA_D_IMAG( x[i] );
+    }
+    return sqrt( sum );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes y = alpha * x + beta * y for vectors in host memory.
+    beta = 1 is an axpy, beta = 0 overwrites y.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of x and y
+
+    @param[in]
+    alpha       double
+                scalar
+
+    @param[in]
+    x           const double*
+                input vector
+
+    @param[in]
+    beta        double
+                scalar
+
+    @param[in,out]
+    y           double*
+                input/output vector
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" void
+magma_daxpby_cpu(
+    magma_int_t n,
+    double alpha,
+    const double *x,
+    double beta,
+    double *y )
+{
+    if ( MAGMA_D_EQUAL( beta, MAGMA_D_ZERO ) ) {
+        #pragma omp parallel for simd schedule(static)
+        for( magma_int_t i=0; i < n; i++ ) {
+            y[i] = alpha * x[i];
+        }
+    }
+    else if ( MAGMA_D_EQUAL( beta, MAGMA_D_ONE ) ) {
+        #pragma omp parallel for simd schedule(static)
+        for( magma_int_t i=0; i < n; i++ ) {
+            y[i] += alpha * x[i];
+        }
+    }
+    else {
+        #pragma omp parallel for simd schedule(static)
+        for( magma_int_t i=0; i < n; i++ ) {
+            y[i] = alpha * x[i] + beta * y[i];
+        }
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Copies x into y, both in host memory.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of x and y
+
+    @param[in]
+    x           const double*
+                input vector
+
+    @param[out]
+    y           double*
+                output vector
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" void
+magma_dcopy_cpu(
+    magma_int_t n,
+    const double *x,
+    double *y )
+{
+    #pragma omp parallel for simd schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        y[i] = x[i];
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the elementwise product x = d .* b, e.g. to apply a Jacobi
+    preconditioner stored as the inverse of the diagonal.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    d           const double*
+                scaling vector
+
+    @param[in]
+    b           const double*
+                input vector
+
+    @param[out]
+    x           double*
+                output vector
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" void
+magma_ddiagscal_cpu(
+    magma_int_t n,
+    const double *d,
+    const double *b,
+    double *x )
+{
+    #pragma omp parallel for simd schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        x[i] = d[i] * b[i];
+    }
+}
@@ -0,0 +1,1149 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @generated from sparse/blas/magma_zmergekrylov_cpu.cpp, normal z -> d, Sun Oct 18 03:37:07 2026
+       @author Hartwig Anzt
+
+       Fused host kernels for the merged Krylov solvers.
+
+       Each kernel is a single OpenMP sweep over blocks of rows. Where the
+       SpMV input is a linear combination of vectors (e.g. p = r + beta p),
+       the combination is formed on the fly inside the SpMV gather instead
+       of being written and read back, and the new vector is written for
+       the rows owned by the block. The dot products needed by the
+       following scalar update are accumulated in the same sweep.
+       Only CSR and SELLP are supported, the solvers convert other formats.
+*/
+#include "magmasparse_internal.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// rows processed per OpenMP chunk
+#define BLOCK_ROWS 512
+
+
+// gathers row i of A against the vector returned entry-wise by x(j)
+template< typename Gather >
+static inline double
+magma_dmerge_rowdot(
+    const magma_d_matrix &A,
+    magma_int_t i,
+    Gather x )
+{
+    double dot = MAGMA_D_ZERO;
+    if ( A.storage_type == Magma_SELLP ) {
+        magma_int_t C = A.blocksize;
+        magma_int_t s = i / C;
+        for( magma_int_t k = A.row[s] + i%C; k < A.row[s+1]; k += C ) {
+            dot += A.val[k] * x( A.col[k] );
+        }
+    } else {
+        for( magma_int_t k = A.row[i]; k < A.row[i+1]; k++ ) {
+            dot += A.val[k] * x( A.col[k] );
+        }
+    }
+    return dot;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Returns an estimate of the bytes read from memory by one host SpMV
+    with A (values, column indices and row pointers of the stored entries,
+    including SELLP padding). Used by the merged solvers to report the
+    memory traffic per iteration through solver_par->iter_bytes.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                sparse matrix in CSR or SELLP
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" double
+magma_dmergebytes_cpu(
+    magma_d_matrix A )
+{
+    bool sellp = ( A.storage_type == Magma_SELLP );
+    double stored = sellp ? (double) A.row[ A.numblocks ] : (double) A.nnz;
+    double ptrs   = sellp ? (double) A.numblocks + 1 : (double) A.num_rows + 1;
+
+    return stored * ( sizeof(double) + sizeof(magma_index_t) )
+           + ptrs * sizeof(magma_index_t);
+}
+
+
+/**
+    Purpose
+    -------
+
+    Fused search direction update and SpMV of CG:
+
+    pn = r + beta * p
+    q  = A * pn
+    skp[0] = <pn,q>
+
+    A * pn is computed from r and p directly, pn and p must not alias.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                system matrix in CSR or SELLP on the CPU
+
+    @param[in]
+    beta        double
+                scalar
+
+    @param[in]
+    r           const double*
+                residual
+
+    @param[in]
+    p           const double*
+                previous search direction
+
+    @param[out]
+    pn          double*
+                new search direction
+
+    @param[out]
+    q           double*
+                q = A pn
+
+    @param[out]
+    skp         double*
+                array[1] of scalar products
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_dcgmerge_spmv_cpu(
+    magma_d_matrix A,
+    double beta,
+    const double *r,
+    const double *p,
+    double *pn,
+    double *q,
+    double *skp )
+{
+    magma_int_t n = A.num_rows;
+    double re = 0.0, im = 0.0;
+
+    #pragma omp parallel for reduction(+:re,im) schedule(dynamic)
+    for( magma_int_t i0=0; i0 < n; i0 += BLOCK_ROWS ) {
+        magma_int_t i1 = min( i0 + BLOCK_ROWS, n );
+        for( magma_int_t i=i0; i < i1; i++ ) {
+            double qi = magma_dmerge_rowdot( A, i,
+                [&]( magma_index_t j ) { return r[j] + beta * p[j]; } );
+            double pi = r[i] + beta * p[i];
+            double t = MAGMA_D_CONJ( pi ) * qi;
+            pn[i] = pi;
+            q[i] = qi;
+            re += MAGMA_D_REAL( t );
+            im += MAGMA_D_IMAG( t );
+        }
+    }
+    skp[0] = MAGMA_D_MAKE( re, im );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Fused solution and residual update of CG:
+
+    x = x + alpha * p
+    r = r - alpha * q
+    skp[0] = <r,r>
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    alpha       double
+                scalar
+
+    @param[in]
+    p           const double*
+                search direction
+
+    @param[in]
+    q           const double*
+                q = A p
+
+    @param[in,out]
+    x           double*
+                solution approximation
+
+    @param[in,out]
+    r           double*
+                residual
+
+    @param[out]
+    skp         double*
+                array[1] of scalar products
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_dcgmerge_xr_cpu(
+    magma_int_t n,
+    double alpha,
+    const double *p,
+    const double *q,
+    double *x,
+    double *r,
+    double *skp )
+{
+    double re = 0.0;
+
+    #pragma omp parallel for reduction(+:re) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        double ri = r[i] - alpha * q[i];
+        x[i] += alpha * p[i];
+        r[i] = ri;
+        re += MAGMA_D_REAL( MAGMA_D_CONJ( ri ) * ri );
+    }
+    skp[0] = MAGMA_D_MAKE( re, 0.0 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    First fused sweep of BiCGSTAB:
+
+    pn = r + beta * ( p - omega * v )
+    vn = A * pn
+    skp[0] = <rr,vn>
+
+    pn and vn must not alias p and v.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                system matrix in CSR or SELLP on the CPU
+
+    @param[in]
+    beta        double
+                scalar
+
+    @param[in]
+    omega       double
+                scalar
+
+    @param[in]
+    r           const double*
+                residual
+
+    @param[in]
+    rr          const double*
+                shadow residual
+
+    @param[in]
+    p           const double*
+                previous search direction
+
+    @param[in]
+    v           const double*
+                previous A p
+
+    @param[out]
+    pn          double*
+                new search direction
+
+    @param[out]
+    vn          double*
+                vn = A pn
+
+    @param[out]
+    skp         double*
+                array[1] of scalar products
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_dbicgmerge_spmv1_cpu(
+    magma_d_matrix A,
+    double beta,
+    double omega,
+    const double *r,
+    const double *rr,
+    const double *p,
+    const double *v,
+    double *pn,
+    double *vn,
+    double *skp )
+{
+    magma_int_t n = A.num_rows;
+    double re = 0.0, im = 0.0;
+
+    #pragma omp parallel for reduction(+:re,im) schedule(dynamic)
+    for( magma_int_t i0=0; i0 < n; i0 += BLOCK_ROWS ) {
+        magma_int_t i1 = min( i0 + BLOCK_ROWS, n );
+        for( magma_int_t i=i0; i < i1; i++ ) {
+            double vi = magma_dmerge_rowdot( A, i,
+                [&]( magma_index_t j ) { return r[j] + beta * ( p[j] - omega * v[j] ); } );
+            double t = MAGMA_D_CONJ( rr[i] ) * vi;
+            pn[i] = r[i] + beta * ( p[i] - omega * v[i] );
+            vn[i] = vi;
+            re += MAGMA_D_REAL( t );
+            im += MAGMA_D_IMAG( t );
+        }
+    }
+    skp[0] = MAGMA_D_MAKE( re, im );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Second fused sweep of BiCGSTAB:
+
+    s = r - alpha * v
+    t = A * s
+    skp[0] = <t,s>,   skp[1] = <t,t>
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                system matrix in CSR or SELLP on the CPU
+
+    @param[in]
+    alpha       double
+                scalar
+
+    @param[in]
+    r           const double*
+                residual
+
+    @param[in]
+    v           const double*
+                A p
+
+    @param[out]
+    s           double*
+                intermediate residual
+
+    @param[out]
+    t           double*
+                t = A s
+
+    @param[out]
+    skp         double*
+                array[2] of scalar products
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_dbicgmerge_spmv2_cpu(
+    magma_d_matrix A,
+    double alpha,
+    const double *r,
+    const double *v,
+    double *s,
+    double *t,
+    double *skp )
+{
+    magma_int_t n = A.num_rows;
+    double re0 = 0.0, im0 = 0.0, re1 = 0.0;
+
+    #pragma omp parallel for reduction(+:re0,im0,re1) schedule(dynamic)
+    for( magma_int_t i0=0; i0 < n; i0 += BLOCK_ROWS ) {
+        magma_int_t i1 = min( i0 + BLOCK_ROWS, n );
+        for( magma_int_t i=i0; i < i1; i++ ) {
+            double ti = magma_dmerge_rowdot( A, i,
+                [&]( magma_index_t j ) { return r[j] - alpha * v[j]; } );
+            double si = r[i] - alpha * v[i];
+            double ts = MAGMA_D_CONJ( ti ) * si;
+            s[i] = si;
+            t[i] = ti;
+            re0 += MAGMA_D_REAL( ts );
+            im0 += MAGMA_D_IMAG( ts );
+            re1 += MAGMA_D_REAL( MAGMA_D_CONJ( ti ) * ti );
+        }
+    }
+    skp[0] = MAGMA_D_MAKE( re0, im0 );
+    skp[1] = MAGMA_D_MAKE( re1, 0.0 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Fused solution and residual update of BiCGSTAB:
+
+    x = x + alpha * p + omega * s
+    r = s - omega * t
+    skp[0] = <r,r>,   skp[1] = <rr,r>
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    alpha       double
+                scalar
+
+    @param[in]
+    omega       double
+                scalar
+
+    @param[in]
+    p           const double*
+                search direction
+
+    @param[in]
+    s           const double*
+                intermediate residual
+
+    @param[in]
+    t           const double*
+                A s
+
+    @param[in]
+    rr          const double*
+                shadow residual
+
+    @param[in,out]
+    x           double*
+                solution approximation
+
+    @param[out]
+    r           double*
+                residual
+
+    @param[out]
+    skp         double*
+                array[2] of scalar products
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_dbicgmerge_xr_cpu(
+    magma_int_t n,
+    double alpha,
+    double omega,
+    const double *p,
+    const double *s,
+    const double *t,
+    const double *rr,
+    double *x,
+    double *r,
+    double *skp )
+{
+    double re0 = 0.0, re1 = 0.0, im1 = 0.0;
+
+    #pragma omp parallel for reduction(+:re0,re1,im1) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        double ri = s[i] - omega * t[i];
+        double rri = MAGMA_D_CONJ( rr[i] ) * ri;
+        x[i] += alpha * p[i] + omega * s[i];
+        r[i] = ri;
+        re0 += MAGMA_D_REAL( MAGMA_D_CONJ( ri ) * ri );
+        re1 += MAGMA_D_REAL( rri );
+        im1 += MAGMA_D_IMAG( rri );
+    }
+    skp[0] = MAGMA_D_MAKE( re0, 0.0 );
+    skp[1] = MAGMA_D_MAKE( re1, im1 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    First fused sweep of a TFQMR half step:
+
+    u_mp1 = u_m - alpha * v         (odd steps only)
+    w     = w - alpha * Au
+    d     = u_m + sigma * d
+    Ad    = Au + sigma * Ad
+    skp[0] = <w,w>,   skp[1] = <r_tld,w>
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    odd         magma_int_t
+                whether this is an odd half step
+
+    @param[in]
+    alpha       double
+                scalar
+
+    @param[in]
+    sigma       double
+                scalar
+
+    @param[in]
+    v           const double*
+                vector v
+
+    @param[in]
+    Au          const double*
+                A u_m
+
+    @param[in]
+    u_m         const double*
+                vector u_m
+
+    @param[in]
+    r_tld       const double*
+                shadow residual
+
+    @param[out]
+    u_mp1       double*
+                vector u_mp1, written on odd steps
+
+    @param[in,out]
+    w           double*
+                vector w
+
+    @param[in,out]
+    d           double*
+                vector d
+
+    @param[in,out]
+    Ad          double*
+                A d
+
+    @param[out]
+    skp         double*
+                array[2] of scalar products
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_dtfqmrmerge_1_cpu(
+    magma_int_t n,
+    magma_int_t odd,
+    double alpha,
+    double sigma,
+    const double *v,
+    const double *Au,
+    const double *u_m,
+    const double *r_tld,
+    double *u_mp1,
+    double *w,
+    double *d,
+    double *Ad,
+    double *skp )
+{
+    double re0 = 0.0, re1 = 0.0, im1 = 0.0;
+
+    #pragma omp parallel for reduction(+:re0,re1,im1) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        if ( odd ) {
+            u_mp1[i] = u_m[i] - alpha * v[i];
+        }
+        double wi = w[i] - alpha * Au[i];
+        double wr = MAGMA_D_CONJ( r_tld[i] ) * wi;
+        w[i] = wi;
+        d[i] = u_m[i] + sigma * d[i];
+        Ad[i] = Au[i] + sigma * Ad[i];
+        re0 += MAGMA_D_REAL( MAGMA_D_CONJ( wi ) * wi );
+        re1 += MAGMA_D_REAL( wr );
+        im1 += MAGMA_D_IMAG( wr );
+    }
+    skp[0] = MAGMA_D_MAKE( re0, 0.0 );
+    skp[1] = MAGMA_D_MAKE( re1, im1 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Second fused sweep of a TFQMR half step:
+
+    x = x + eta * d
+    r = r - eta * Ad
+    skp[0] = <r,r>
+
+    and on even steps additionally
+
+    u_mp1 = w + beta * u_m
+    v     = beta * ( Au + beta * v )
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    even        magma_int_t
+                whether this is an even half step
+
+    @param[in]
+    eta         double
+                scalar
+
+    @param[in]
+    beta        double
+                scalar, only referenced on even steps
+
+    @param[in]
+    d           const double*
+                vector d
+
+    @param[in]
+    Ad          const double*
+                A d
+
+    @param[in]
+    w           const double*
+                vector w
+
+    @param[in]
+    u_m         const double*
+                vector u_m
+
+    @param[in]
+    Au          const double*
+                A u_m
+
+    @param[in,out]
+    x           double*
+                solution approximation
+
+    @param[in,out]
+    r           double*
+                residual
+
+    @param[out]
+    u_mp1       double*
+                vector u_mp1, written on even steps
+
+    @param[in,out]
+    v           double*
+                vector v, updated on even steps
+
+    @param[out]
+    skp         double*
+                array[1] of scalar products
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_dtfqmrmerge_2_cpu(
+    magma_int_t n,
+    magma_int_t even,
+    double eta,
+    double beta,
+    const double *d,
+    const double *Ad,
+    const double *w,
+    const double *u_m,
+    const double *Au,
+    double *x,
+    double *r,
+    double *u_mp1,
+    double *v,
+    double *skp )
+{
+    double re = 0.0;
+
+    #pragma omp parallel for reduction(+:re) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        double ri = r[i] - eta * Ad[i];
+        x[i] += eta * d[i];
+        r[i] = ri;
+        re += MAGMA_D_REAL( MAGMA_D_CONJ( ri ) * ri );
+        if ( even ) {
+            u_mp1[i] = w[i] + beta * u_m[i];
+            v[i] = beta * ( Au[i] + beta * v[i] );
+        }
+    }
+    skp[0] = MAGMA_D_MAKE( re, 0.0 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    SpMV sweep of a TFQMR half step:
+
+    Au = A * u_mp1
+
+    and on even steps additionally
+
+    v = v + Au
+    skp[0] = <r_tld,v>
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                system matrix in CSR or SELLP on the CPU
+
+    @param[in]
+    even        magma_int_t
+                whether this is an even half step
+
+    @param[in]
+    u_mp1       const double*
+                vector u_mp1
+
+    @param[in]
+    r_tld       const double*
+                shadow residual
+
+    @param[out]
+    Au          double*
+                A u_mp1
+
+    @param[in,out]
+    v           double*
+                vector v, updated on even steps
+
+    @param[out]
+    skp         double*
+                array[1] of scalar products, written on even steps
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_dtfqmrmerge_spmv_cpu(
+    magma_d_matrix A,
+    magma_int_t even,
+    const double *u_mp1,
+    const double *r_tld,
+    double *Au,
+    double *v,
+    double *skp )
+{
+    magma_int_t n = A.num_rows;
+    double re = 0.0, im = 0.0;
+
+    #pragma omp parallel for reduction(+:re,im) schedule(dynamic)
+    for( magma_int_t i0=0; i0 < n; i0 += BLOCK_ROWS ) {
+        magma_int_t i1 = min( i0 + BLOCK_ROWS, n );
+        for( magma_int_t i=i0; i < i1; i++ ) {
+            double ai = magma_dmerge_rowdot( A, i,
+                [&]( magma_index_t j ) { return u_mp1[j]; } );
+            Au[i] = ai;
+            if ( even ) {
+                double vi = v[i] + ai;
+                double t = MAGMA_D_CONJ( r_tld[i] ) * vi;
+                v[i] = vi;
+                re += MAGMA_D_REAL( t );
+                im += MAGMA_D_IMAG( t );
+            }
+        }
+    }
+    if ( even ) {
+        skp[0] = MAGMA_D_MAKE( re, im );
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Fused SpMV and shadow space projection of IDR(s):
+
+    y = A * x
+    skp[j] = <P_j,y>,   j = 0, ..., s-1
+    skp[s] = <y,y>,  skp[s+1] = <y,x>,  skp[s+2] = <x,x>   (if dots is nonzero)
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                system matrix in CSR or SELLP on the CPU
+
+    @param[in]
+    s           magma_int_t
+                number of columns of P, may be 0
+
+    @param[in]
+    P           const double*
+                n-by-s shadow space, column-major
+
+    @param[in]
+    dots        magma_int_t
+                whether to compute <y,y>, <y,x> and <x,x>
+
+    @param[in]
+    x           const double*
+                input vector
+
+    @param[out]
+    y           double*
+                y = A x
+
+    @param[out]
+    skp         double*
+                array[s+3] of scalar products
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_didrmerge_spmv_cpu(
+    magma_d_matrix A,
+    magma_int_t s,
+    const double *P,
+    magma_int_t dots,
+    const double *x,
+    double *y,
+    double *skp )
+{
+    magma_int_t info = 0;
+    magma_int_t n = A.num_rows;
+    magma_int_t k = s + 3;
+    magma_int_t nthreads = 1;
+    double *partial = NULL;
+
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    CHECK( magma_dmalloc_cpu( &partial, nthreads*k ));
+    for( magma_int_t j=0; j < nthreads*k; j++ ) {
+        partial[j] = MAGMA_D_ZERO;
+    }
+
+    #pragma omp parallel
+    {
+#ifdef _OPENMP
+        magma_int_t tid = omp_get_thread_num();
+#else
+        magma_int_t tid = 0;
+#endif
+        double *sum = partial + tid*k;
+        #pragma omp for schedule(dynamic)
+        for( magma_int_t i0=0; i0 < n; i0 += BLOCK_ROWS ) {
+            magma_int_t i1 = min( i0 + BLOCK_ROWS, n );
+            for( magma_int_t i=i0; i < i1; i++ ) {
+                y[i] = magma_dmerge_rowdot( A, i,
+                    [&]( magma_index_t j ) { return x[j]; } );
+            }
+            // the block of y is still in cache for the projections
+            for( magma_int_t j=0; j < s; j++ ) {
+                const double *pj = P + j*n;
+                double t = MAGMA_D_ZERO;
+                for( magma_int_t i=i0; i < i1; i++ ) {
+                    t += MAGMA_D_CONJ( pj[i] ) * y[i];
+                }
+                sum[j] += t;
+            }
+            if ( dots ) {
+                double yy = MAGMA_D_ZERO, yx = MAGMA_D_ZERO;
+                double xx = MAGMA_D_ZERO;
+                for( magma_int_t i=i0; i < i1; i++ ) {
+                    yy += MAGMA_D_CONJ( y[i] ) * y[i];
+                    yx += MAGMA_D_CONJ( y[i] ) * x[i];
+                    xx += MAGMA_D_CONJ( x[i] ) * x[i];
+                }
+                sum[s]   += yy;
+                sum[s+1] += yx;
+                sum[s+2] += xx;
+            }
+        }
+    }
+    for( magma_int_t j=0; j < k; j++ ) {
+        skp[j] = MAGMA_D_ZERO;
+        for( magma_int_t t=0; t < nthreads; t++ ) {
+            skp[j] += partial[t*k + j];
+        }
+    }
+
+cleanup:
+    magma_free_cpu( partial );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Fused biorthogonalization and iterate update of IDR(s):
+
+    g = g - G alpha,   u = u - U alpha     (G, U n-by-k, skipped if k = 0)
+    r = r - beta * g
+    x = x + beta * u
+    skp[0] = <rs-r,rs>,   skp[1] = <rs-r,rs-r>   (if rs is not NULL)
+
+    u may alias r, in which case x is updated with the old residual.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    k           magma_int_t
+                number of columns of G and U
+
+    @param[in]
+    alpha       const double*
+                array[k] of coefficients
+
+    @param[in]
+    beta        double
+                scalar
+
+    @param[in]
+    G           const double*
+                n-by-k matrix, column-major
+
+    @param[in]
+    U           const double*
+                n-by-k matrix, column-major
+
+    @param[in,out]
+    g           double*
+                vector g
+
+    @param[in,out]
+    u           double*
+                vector u
+
+    @param[in,out]
+    r           double*
+                residual
+
+    @param[in,out]
+    x           double*
+                solution approximation
+
+    @param[in]
+    rs          const double*
+                smoothed residual or NULL
+
+    @param[out]
+    skp         double*
+                array[2] of scalar products
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_didrmerge_update_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    const double *alpha,
+    double beta,
+    const double *G,
+    const double *U,
+    double *g,
+    double *u,
+    double *r,
+    double *x,
+    const double *rs,
+    double *skp )
+{
+    double re0 = 0.0, im0 = 0.0, re1 = 0.0;
+
+    #pragma omp parallel for reduction(+:re0,im0,re1) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        double gi = g[i], ui = u[i];
+        for( magma_int_t j=0; j < k; j++ ) {
+            gi -= G[j*n + i] * alpha[j];
+            ui -= U[j*n + i] * alpha[j];
+        }
+        double ri = r[i] - beta * gi;
+        g[i] = gi;
+        u[i] = ui;
+        r[i] = ri;
+        x[i] += beta * ui;
+        if ( rs != NULL ) {
+            double ti = rs[i] - ri;
+            double t = MAGMA_D_CONJ( ti ) * rs[i];
+            re0 += MAGMA_D_REAL( t );
+            im0 += MAGMA_D_IMAG( t );
+            re1 += MAGMA_D_REAL( MAGMA_D_CONJ( ti ) * ti );
+        }
+    }
+    skp[0] = MAGMA_D_MAKE( re0, im0 );
+    skp[1] = MAGMA_D_MAKE( re1, 0.0 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Fused new direction of IDR(s):
+
+    u = omega * ( r - G c ) + U c
+
+    with G and U n-by-k. u may be a column of U: every entry is read
+    before it is written.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    k           magma_int_t
+                number of columns of G and U
+
+    @param[in]
+    omega       double
+                scalar
+
+    @param[in]
+    c           const double*
+                array[k] of coefficients
+
+    @param[in]
+    r           const double*
+                residual
+
+    @param[in]
+    G           const double*
+                n-by-k matrix, column-major
+
+    @param[in]
+    U           const double*
+                n-by-k matrix, column-major
+
+    @param[out]
+    u           double*
+                new direction
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_didrmerge_dir_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    double omega,
+    const double *c,
+    const double *r,
+    const double *G,
+    const double *U,
+    double *u )
+{
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        double vi = r[i], ui = MAGMA_D_ZERO;
+        for( magma_int_t j=0; j < k; j++ ) {
+            vi -= G[j*n + i] * c[j];
+            ui += U[j*n + i] * c[j];
+        }
+        u[i] = omega * vi + ui;
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Fused residual smoothing of IDR(s):
+
+    rs = rs - gamma * ( rs - r )
+    xs = xs - gamma * ( xs - x )
+    skp[0] = <rs,rs>
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    gamma       double
+                scalar
+
+    @param[in]
+    r           const double*
+                residual
+
+    @param[in]
+    x           const double*
+                solution approximation
+
+    @param[in,out]
+    rs          double*
+                smoothed residual
+
+    @param[in,out]
+    xs          double*
+                smoothed solution
+
+    @param[out]
+    skp         double*
+                array[1] of scalar products
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" void
+magma_didrmerge_smooth_cpu(
+    magma_int_t n,
+    double gamma,
+    const double *r,
+    const double *x,
+    double *rs,
+    double *xs,
+    double *skp )
+{
+    double re = 0.0;
+
+    #pragma omp parallel for reduction(+:re) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        double ri = rs[i] - gamma * ( rs[i] - r[i] );
+        rs[i] = ri;
+        xs[i] = xs[i] - gamma * ( xs[i] - x[i] );
+        re += MAGMA_D_REAL( MAGMA_D_CONJ( ri ) * ri );
+    }
+    skp[0] = MAGMA_D_MAKE( re, 0.0 );
+}
@@ -0,0 +1,553 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @generated from sparse/blas/magma_zspmm_cpu.cpp, normal z -> d, Sun Oct 18 06:07:38 2026
+       @author Hartwig Anzt
+
+       Sparse matrix-matrix product (SpGEMM) on the host.
+
+       The product is computed in two phases: a symbolic phase that sizes
+       every row of C, and a numeric phase that fills in the values. Every
+       row is accumulated either in a dense array over the columns of B or,
+       for short rows, in a hash table with linear probing sized to twice
+       the number of products of the row. Both accumulators are thread-local
+       and reused over the rows, so the scratch memory is independent of
+       the number of rows.
+*/
+#include <algorithm>
+#include <vector>
+
+#include "magmasparse_internal.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// a row uses the dense accumulator if it has at least
+// num_cols / DENSE_RATIO products
+#define DENSE_RATIO 16
+
+// multiplicative hash of a column index
+#define HASH(c) ( (magma_uindex_t)(c) * 2654435761u )
+
+
+/*******************************************************************************
+    Thread-local accumulator. slot lists the occupied hash slots, or the
+    columns in the dense case, of the current row.
+*/
+typedef struct {
+    bool dense;
+    magma_uindex_t mask;
+    std::vector< magma_index_t > key;
+    std::vector< double > hval;
+    std::vector< magma_index_t > mark;
+    std::vector< double > dval;
+    std::vector< magma_index_t > slot;
+} magma_dspmm_acc;
+
+
+/*******************************************************************************
+    Number of products in every row of A * B, an upper bound for the
+    nonzeros of the row of C.
+*/
+static void
+magma_dspmm_rowflops(
+    magma_d_matrix A,
+    magma_d_matrix B,
+    std::vector< magma_int_t > &flops )
+{
+    flops.resize( A.num_rows );
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i < A.num_rows; i++ ) {
+        magma_int_t f = 0;
+        for( magma_int_t j=A.row[i]; j < A.row[i+1]; j++ ) {
+            f += B.row[ A.col[j]+1 ] - B.row[ A.col[j] ];
+        }
+        flops[i] = f;
+    }
+}
+
+
+/*******************************************************************************
+    Accumulates row i of alpha * A * B, values only if values != 0.
+    Returns the number of distinct columns.
+*/
+static magma_int_t
+magma_dspmm_accumulate(
+    magma_int_t i,
+    magma_int_t flops,
+    double alpha,
+    const magma_d_matrix &A,
+    const magma_d_matrix &B,
+    int values,
+    magma_dspmm_acc &s )
+{
+    s.slot.clear();
+    s.dense = ( flops * DENSE_RATIO >= B.num_cols );
+    if ( s.dense ) {
+        if ( (magma_int_t) s.mark.size() < B.num_cols ) {
+            s.mark.assign( B.num_cols, -1 );
+            if ( values )
+                s.dval.resize( B.num_cols );
+        }
+        for( magma_int_t j=A.row[i]; j < A.row[i+1]; j++ ) {
+            magma_index_t k = A.col[j];
+            double a = values ? alpha * A.val[j] : MAGMA_D_ZERO;
+            for( magma_int_t l=B.row[k]; l < B.row[k+1]; l++ ) {
+                magma_index_t c = B.col[l];
+                if ( s.mark[c] != i ) {
+                    s.mark[c] = i;
+                    s.slot.push_back( c );
+                    if ( values )
+                        s.dval[c] = a * B.val[l];
+                }
+                else if ( values ) {
+                    s.dval[c] += a * B.val[l];
+                }
+            }
+        }
+    }
+    else {
+        magma_uindex_t size = 1;
+        while ( size < (magma_uindex_t) 2*flops ) {
+            size <<= 1;
+        }
+        if ( s.key.size() < size ) {
+            s.key.assign( size, -1 );
+            if ( values )
+                s.hval.resize( size );
+        }
+        s.mask = size - 1;
+        for( magma_int_t j=A.row[i]; j < A.row[i+1]; j++ ) {
+            magma_index_t k = A.col[j];
+            double a = values ? alpha * A.val[j] : MAGMA_D_ZERO;
+            for( magma_int_t l=B.row[k]; l < B.row[k+1]; l++ ) {
+                magma_index_t c = B.col[l];
+                magma_uindex_t h = HASH( c ) & s.mask;
+                while ( s.key[h] != -1 && s.key[h] != c ) {
+                    h = ( h + 1 ) & s.mask;
+                }
+                if ( s.key[h] == -1 ) {
+                    s.key[h] = c;
+                    s.slot.push_back( h );
+                    if ( values )
+                        s.hval[h] = a * B.val[l];
+                }
+                else if ( values ) {
+                    s.hval[h] += a * B.val[l];
+                }
+            }
+        }
+    }
+    return s.slot.size();
+}
+
+
+/*******************************************************************************
+    Value of column c in the accumulated row, zero if not present.
+*/
+static inline double
+magma_dspmm_lookup(
+    magma_int_t i,
+    magma_index_t c,
+    const magma_dspmm_acc &s )
+{
+    if ( s.dense ) {
+        return ( s.mark[c] == i ) ? s.dval[c] : MAGMA_D_ZERO;
+    }
+    magma_uindex_t h = HASH( c ) & s.mask;
+    while ( s.key[h] != -1 ) {
+        if ( s.key[h] == c )
+            return s.hval[h];
+        h = ( h + 1 ) & s.mask;
+    }
+    return MAGMA_D_ZERO;
+}
+
+
+/*******************************************************************************
+    Writes the sorted columns and, if val != NULL, the values of the
+    accumulated row i and clears the hash table.
+*/
+static void
+magma_dspmm_gather(
+    magma_int_t i,
+    magma_index_t *col,
+    double *val,
+    magma_dspmm_acc &s )
+{
+    magma_int_t count = s.slot.size();
+    for( magma_int_t k=0; k < count; k++ ) {
+        col[k] = s.dense ? s.slot[k] : s.key[ s.slot[k] ];
+    }
+    std::sort( col, col + count );
+    if ( val != NULL ) {
+        for( magma_int_t k=0; k < count; k++ ) {
+            val[k] = magma_dspmm_lookup( i, col[k], s );
+        }
+    }
+}
+
+
+/*******************************************************************************
+    Frees the hash slots of the current row.
+*/
+static inline void
+magma_dspmm_clear(
+    magma_dspmm_acc &s )
+{
+    if ( ! s.dense ) {
+        for( size_t k=0; k < s.slot.size(); k++ ) {
+            s.key[ s.slot[k] ] = -1;
+        }
+    }
+}
+
+
+/*******************************************************************************
+    Checks that A and B are on the CPU and that A * B is defined.
+    Has to come before anything reads B.row at the columns of A.
+*/
+static magma_int_t
+magma_dspmm_check(
+    magma_d_matrix A,
+    magma_d_matrix B )
+{
+    if ( A.memory_location != Magma_CPU || B.memory_location != Magma_CPU ) {
+        printf("error: host SpMM needs all objects in CPU memory.\n");
+        return MAGMA_ERR_INVALID_PTR;
+    }
+    if ( A.num_cols != B.num_rows ) {
+        printf("error: dimensions do not match.\n");
+        return MAGMA_ERR_NOT_SUPPORTED;
+    }
+    return MAGMA_SUCCESS;
+}
+
+
+/*******************************************************************************
+    Sets up the row pointer of C = A * B: sizes of the rows in the symbolic
+    phase, then the prefix sum. A and B are checked by magma_dspmm_check.
+*/
+static magma_int_t
+magma_dspmm_symbolic_rows(
+    magma_d_matrix A,
+    magma_d_matrix B,
+    const std::vector< magma_int_t > &flops,
+    magma_d_matrix *C,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    C->storage_type = Magma_CSR;
+    C->memory_location = Magma_CPU;
+    C->num_rows = A.num_rows;
+    C->num_cols = B.num_cols;
+    C->ownership = MagmaTrue;
+    CHECK( magma_index_malloc_cpu( &C->row, A.num_rows+1 ));
+
+    #pragma omp parallel
+    {
+        magma_dspmm_acc s;
+        #pragma omp for schedule(dynamic, 64)
+        for( magma_int_t i=0; i < A.num_rows; i++ ) {
+            C->row[i+1] = magma_dspmm_accumulate( i, flops[i], MAGMA_D_ZERO,
+                                                  A, B, 0, s );
+            magma_dspmm_clear( s );
+        }
+    }
+    C->row[0] = 0;
+    for( magma_int_t i=0; i < A.num_rows; i++ ) {
+        C->row[i+1] += C->row[i];
+    }
+    C->nnz = C->row[ A.num_rows ];
+    C->true_nnz = C->nnz;
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the sparse matrix product C = alpha * A * B on the host.
+    A and B are CSR matrices on the CPU (CSRL, CSRU and CSRCOO are read as
+    CSR), C is returned in CSR with sorted column indices.
+
+    The rows of C are first sized, then computed, both in parallel. Rows
+    with many products relative to the columns of B use a dense
+    accumulator, the others a hash table.
+
+    Arguments
+    ---------
+
+    @param[in]
+    alpha       double
+                scalar alpha
+
+    @param[in]
+    A           magma_d_matrix
+                sparse matrix A on the CPU
+
+    @param[in]
+    B           magma_d_matrix
+                sparse matrix B on the CPU
+
+    @param[out]
+    C           magma_d_matrix*
+                output sparse matrix C on the CPU
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_d_spmm_cpu(
+    double alpha,
+    magma_d_matrix A,
+    magma_d_matrix B,
+    magma_d_matrix *C,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    std::vector< magma_int_t > flops;
+
+    // make sure the target structure is empty
+    magma_dmfree( C, queue );
+
+    CHECK( magma_dspmm_check( A, B ));
+    magma_dspmm_rowflops( A, B, flops );
+    CHECK( magma_dspmm_symbolic_rows( A, B, flops, C, queue ));
+    CHECK( magma_index_malloc_cpu( &C->col, C->nnz ));
+    CHECK( magma_dmalloc_cpu( &C->val, C->nnz ));
+
+    #pragma omp parallel
+    {
+        magma_dspmm_acc s;
+        #pragma omp for schedule(dynamic, 64)
+        for( magma_int_t i=0; i < A.num_rows; i++ ) {
+            magma_dspmm_accumulate( i, flops[i], alpha, A, B, 1, s );
+            magma_dspmm_gather( i, C->col + C->row[i], C->val + C->row[i], s );
+            magma_dspmm_clear( s );
+        }
+    }
+
+cleanup:
+    if ( info != 0 ) {
+        magma_dmfree( C, queue );
+    }
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Symbolic phase of the host sparse matrix product: computes the
+    nonzero pattern of C = A * B in CSR with sorted column indices. The
+    values of C are set to zero; magma_d_spmm_numeric_cpu fills them in,
+    which allows to recompute products with the same pattern cheaply.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                sparse matrix A on the CPU
+
+    @param[in]
+    B           magma_d_matrix
+                sparse matrix B on the CPU
+
+    @param[out]
+    C           magma_d_matrix*
+                pattern of A * B on the CPU
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_d_spmm_symbolic_cpu(
+    magma_d_matrix A,
+    magma_d_matrix B,
+    magma_d_matrix *C,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    std::vector< magma_int_t > flops;
+
+    magma_dmfree( C, queue );
+
+    CHECK( magma_dspmm_check( A, B ));
+    magma_dspmm_rowflops( A, B, flops );
+    CHECK( magma_dspmm_symbolic_rows( A, B, flops, C, queue ));
+    CHECK( magma_index_malloc_cpu( &C->col, C->nnz ));
+    CHECK( magma_dmalloc_cpu( &C->val, C->nnz ));
+
+    #pragma omp parallel
+    {
+        magma_dspmm_acc s;
+        #pragma omp for schedule(dynamic, 64)
+        for( magma_int_t i=0; i < A.num_rows; i++ ) {
+            magma_dspmm_accumulate( i, flops[i], MAGMA_D_ZERO, A, B, 0, s );
+            magma_dspmm_gather( i, C->col + C->row[i], NULL, s );
+            magma_dspmm_clear( s );
+            for( magma_int_t j=C->row[i]; j < C->row[i+1]; j++ ) {
+                C->val[j] = MAGMA_D_ZERO;
+            }
+        }
+    }
+
+cleanup:
+    if ( info != 0 ) {
+        magma_dmfree( C, queue );
+    }
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Numeric phase of the host sparse matrix product: overwrites the values
+    of C with the entries of alpha * A * B at the positions of the pattern
+    of C. Typically C comes from magma_d_spmm_symbolic_cpu with the same
+    patterns of A and B. Entries of the product outside the pattern of C
+    are dropped, entries of C not in the product are set to zero.
+
+    Arguments
+    ---------
+
+    @param[in]
+    alpha       double
+                scalar alpha
+
+    @param[in]
+    A           magma_d_matrix
+                sparse matrix A on the CPU
+
+    @param[in]
+    B           magma_d_matrix
+                sparse matrix B on the CPU
+
+    @param[in,out]
+    C           magma_d_matrix*
+                CSR matrix on the CPU, the pattern is not changed
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_d_spmm_numeric_cpu(
+    double alpha,
+    magma_d_matrix A,
+    magma_d_matrix B,
+    magma_d_matrix *C,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    std::vector< magma_int_t > flops;
+
+    CHECK( magma_dspmm_check( A, B ));
+    if ( C->memory_location != Magma_CPU ) {
+        printf("error: host SpMM needs all objects in CPU memory.\n");
+        info = MAGMA_ERR_INVALID_PTR;
+        goto cleanup;
+    }
+    if ( C->num_rows != A.num_rows || C->num_cols != B.num_cols ) {
+        printf("error: dimensions do not match.\n");
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
+    magma_dspmm_rowflops( A, B, flops );
+    #pragma omp parallel
+    {
+        magma_dspmm_acc s;
+        #pragma omp for schedule(dynamic, 64)
+        for( magma_int_t i=0; i < A.num_rows; i++ ) {
+            magma_dspmm_accumulate( i, flops[i], alpha, A, B, 1, s );
+            for( magma_int_t j=C->row[i]; j < C->row[i+1]; j++ ) {
+                C->val[j] = magma_dspmm_lookup( i, C->col[j], s );
+            }
+            magma_dspmm_clear( s );
+        }
+    }
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Galerkin triple product Ac = R * A * P on the host, e.g. the coarse
+    grid operator of a multigrid hierarchy with restriction R and
+    prolongation P (R = P^H in the symmetric case). Computed as two
+    sparse matrix products, R * ( A * P ).
+
+    Arguments
+    ---------
+
+    @param[in]
+    R           magma_d_matrix
+                restriction in CSR on the CPU
+
+    @param[in]
+    A           magma_d_matrix
+                fine grid operator in CSR on the CPU
+
+    @param[in]
+    P           magma_d_matrix
+                prolongation in CSR on the CPU
+
+    @param[out]
+    Ac          magma_d_matrix*
+                coarse grid operator in CSR on the CPU
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_d_spmm_rap_cpu(
+    magma_d_matrix R,
+    magma_d_matrix A,
+    magma_d_matrix P,
+    magma_d_matrix *Ac,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_d_matrix AP={Magma_CSR};
+
+    CHECK( magma_d_spmm_cpu( MAGMA_D_ONE, A, P, &AP, queue ));
+    CHECK( magma_d_spmm_cpu( MAGMA_D_ONE, R, AP, Ac, queue ));
+
+cleanup:
+    magma_dmfree( &AP, queue );
+    return info;
+}
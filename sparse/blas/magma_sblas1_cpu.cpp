@@ -0,0 +1,461 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @generated from sparse/blas/magma_zblas1_cpu.cpp, normal z -> s, Sun Oct 18 03:18:37 2026
+       @author Hartwig Anzt
+
+*/
+#include "magmasparse_internal.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// rows of the multi-vector handled at once by magma_smdotc_cpu,
+// so that the chunk of r stays in cache across the k dot products
+#define BLOCK_ROWS 512
+
+
+/**
+    Purpose
+    -------
+
+    Computes the dot product <x,y> = x^H y of two vectors in host memory.
+    The partial sums are reduced with OpenMP.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of x and y
+
+    @param[in]
+    x           const float*
+                input vector
+
+    @param[in]
+    y           const float*
+                input vector
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" float
+magma_sdot_cpu(
+    magma_int_t n,
+    const float *x,
+    const float *y )
+{
+    float re = 0.0, im = 0.0;
+
+    #pragma omp parallel for reduction(+:re,im) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        float t = MAGMA_S_CONJ( x[i] ) * y[i];
+        re += MAGMA_S_REAL( t );
+        im += MAGMA_S_IMAG( t );
+    }
+    return MAGMA_S_MAKE( re, im );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes two independent dot products in one sweep:
+
+    skp[0] = <v0,w0>,   skp[1] = <v1,w1>.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    v0          const float*
+                input vector
+
+    @param[in]
+    w0          const float*
+                input vector
+
+    @param[in]
+    v1          const float*
+                input vector
+
+    @param[in]
+    w1          const float*
+                input vector
+
+    @param[out]
+    skp         float*
+                array[2] of scalar products
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" void
+magma_sdot2_cpu(
+    magma_int_t n,
+    const float *v0,
+    const float *w0,
+    const float *v1,
+    const float *w1,
+    float *skp )
+{
+    float re0 = 0.0, im0 = 0.0, re1 = 0.0, im1 = 0.0;
+
+    #pragma omp parallel for reduction(+:re0,im0,re1,im1) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        float t0 = MAGMA_S_CONJ( v0[i] ) * w0[i];
+        float t1 = MAGMA_S_CONJ( v1[i] ) * w1[i];
+        re0 += MAGMA_S_REAL( t0 );
+        im0 += MAGMA_S_IMAG( t0 );
+        re1 += MAGMA_S_REAL( t1 );
+        im1 += MAGMA_S_IMAG( t1 );
+    }
+    skp[0] = MAGMA_S_MAKE( re0, im0 );
+    skp[1] = MAGMA_S_MAKE( re1, im1 );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the scalar products of the k columns of v with r in a single
+    sweep over r:
+
+    skp[j] = <v_j,r>,   j = 0, ..., k-1.
+
+    This is the host counterpart of magma_smdotc, used for the
+    orthogonalization in GMRES and IDR.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of v_j and r
+
+    @param[in]
+    k           magma_int_t
+                number of vectors v_j
+
+    @param[in]
+    v           const float*
+                n-by-k matrix stored column-major with leading dimension n
+
+    @param[in]
+    r           const float*
+                input vector
+
+    @param[out]
+    skp         float*
+                array[k] of scalar products
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_smdotc_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    const float *v,
+    const float *r,
+    float *skp )
+{
+    magma_int_t info = 0;
+    magma_int_t nthreads = 1;
+    float *partial = NULL;
+
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    CHECK( magma_smalloc_cpu( &partial, nthreads*k ));
+    // the team may be smaller than nthreads, unused slots stay zero
+    for( magma_int_t j=0; j < nthreads*k; j++ ) {
+        partial[j] = MAGMA_S_ZERO;
+    }
+
+    #pragma omp parallel
+    {
+#ifdef _OPENMP
+        magma_int_t tid = omp_get_thread_num();
+#else
+        magma_int_t tid = 0;
+#endif
+        float *sum = partial + tid*k;
+        #pragma omp for schedule(static)
+        for( magma_int_t i0=0; i0 < n; i0 += BLOCK_ROWS ) {
+            magma_int_t i1 = min( i0 + BLOCK_ROWS, n );
+            for( magma_int_t j=0; j < k; j++ ) {
+                const float *vj = v + j*n;
+                float t = MAGMA_S_ZERO;
+                for( magma_int_t i=i0; i < i1; i++ ) {
+                    t += MAGMA_S_CONJ( vj[i] ) * r[i];
+                }
+                sum[j] += t;
+            }
+        }
+    }
+    for( magma_int_t j=0; j < k; j++ ) {
+        skp[j] = MAGMA_S_ZERO;
+        for( magma_int_t t=0; t < nthreads; t++ ) {
+            skp[j] += partial[t*k + j];
+        }
+    }
+
+cleanup:
+    magma_free_cpu( partial );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes y = alpha * V c + beta * y with V an n-by-k column-major
+    multi-vector, in a single sweep over y. This is the host counterpart of
+    a non-transposed gemv for tall-skinny V, used to update the iterates of
+    GMRES and IDR from their bases.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the columns of V and of y
+
+    @param[in]
+    k           magma_int_t
+                number of columns of V
+
+    @param[in]
+    alpha       float
+                scalar
+
+    @param[in]
+    v           const float*
+                n-by-k matrix stored column-major with leading dimension n
+
+    @param[in]
+    c           const float*
+                array[k] of coefficients
+
+    @param[in]
+    beta        float
+                scalar
+
+    @param[in,out]
+    y           float*
+                input/output vector
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" void
+magma_smaxpy_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    float alpha,
+    const float *v,
+    const float *c,
+    float beta,
+    float *y )
+{
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        float t = MAGMA_S_ZERO;
+        for( magma_int_t j=0; j < k; j++ ) {
+            t += v[j*n + i] * c[j];
+        }
+        y[i] = MAGMA_S_EQUAL( beta, MAGMA_S_ZERO ) ? alpha * t : alpha * t + beta * y[i];
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the Euclidean norm of a vector in host memory.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of x
+
+    @param[in]
+    x           const float*
+                input vector
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" float
+magma_snrm2_cpu(
+    magma_int_t n,
+    const float *x )
+{
+    float sum = 0.0;
+
+    #pragma omp parallel for reduction(+:sum) schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        sum += MAGMA_S_REAL( x[i] ) * MAGMA_S_REAL( x[i] )
+             + MAGMA_S_IMAG( x[i] ) * MAGMA_S_IMAG( x[i] );
+    }
+    return sqrt( sum );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes y = alpha * x + beta * y for vectors in host memory.
+    beta = 1 is an axpy, beta = 0 overwrites y.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of x and y
+
+    @param[in]
+    alpha       float
+                scalar
+
+    @param[in]
+    x           const float*
+                input vector
+
+    @param[in]
+    beta        float
+                scalar
+
+    @param[in,out]
+    y           float*
+                input/output vector
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" void
+magma_saxpby_cpu(
+    magma_int_t n,
+    float alpha,
+    const float *x,
+    float beta,
+    float *y )
+{
+    if ( MAGMA_S_EQUAL( beta, MAGMA_S_ZERO ) ) {
+        #pragma omp parallel for simd schedule(static)
+        for( magma_int_t i=0; i < n; i++ ) {
+            y[i] = alpha * x[i];
+        }
+    }
+    else if ( MAGMA_S_EQUAL( beta, MAGMA_S_ONE ) ) {
+        #pragma omp parallel for simd schedule(static)
+        for( magma_int_t i=0; i < n; i++ ) {
+            y[i] += alpha * x[i];
+        }
+    }
+    else {
+        #pragma omp parallel for simd schedule(static)
+        for( magma_int_t i=0; i < n; i++ ) {
+            y[i] = alpha * x[i] + beta * y[i];
+        }
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Copies x into y, both in host memory.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of x and y
+
+    @param[in]
+    x           const float*
+                input vector
+
+    @param[out]
+    y           float*
+                output vector
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" void
+magma_scopy_cpu(
+    magma_int_t n,
+    const float *x,
+    float *y )
+{
+    #pragma omp parallel for simd schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        y[i] = x[i];
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the elementwise product x = d .* b, e.g. to apply a Jacobi
+    preconditioner stored as the inverse of the diagonal.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                length of the vectors
+
+    @param[in]
+    d           const float*
+                scaling vector
+
+    @param[in]
+    b           const float*
+                input vector
+
+    @param[out]
+    x           float*
+                output vector
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" void
+magma_sdiagscal_cpu(
+    magma_int_t n,
+    const float *d,
+    const float *b,
+    float *x )
+{
+    #pragma omp parallel for simd schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        x[i] = d[i] * b[i];
+    }
+}
@@ -0,0 +1,693 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @generated from sparse/blas/magma_zspmv_cpu.cpp, normal z -> s, Sun Oct 18 04:59:01 2026
+       @author Hartwig Anzt
+
+*/
+#include "magmasparse_internal.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// rows handled by one block of the column-major (ELL, SELLP) kernels;
+// SELLP slices are at most 256 rows, see magma_smconvert
+#define BLOCK_ROWS 256
+
+
+/*******************************************************************************
+    y = alpha * dot + beta * y; beta == 0 overwrites y (which may hold NaNs).
+*/
+static inline void
+magma_sspmv_cpu_update(
+    float alpha,
+    float dot,
+    float beta,
+    bool overwrite,
+    float *y )
+{
+    if ( overwrite )
+        *y = alpha * dot;
+    else
+        *y = alpha * dot + beta * (*y);
+}
+
+
+/*******************************************************************************
+    Returns the first row of the part [tid/nthreads, (tid+1)/nthreads) of a CSR
+    matrix, balancing nonzeros plus one per row among the threads.
+*/
+static inline magma_int_t
+magma_sspmv_cpu_split(
+    magma_int_t num_rows,
+    const magma_index_t *row,
+    magma_int_t tid,
+    magma_int_t nthreads )
+{
+    if ( tid <= 0 )
+        return 0;
+    if ( tid >= nthreads )
+        return num_rows;
+    magma_int_t work = (magma_int_t) row[num_rows] + num_rows;
+    magma_int_t target = (magma_int_t) ( (float) work * tid / nthreads );
+    magma_int_t lo = 0, hi = num_rows;
+    while ( lo < hi ) {
+        magma_int_t mid = lo + (hi - lo) / 2;
+        if ( row[mid] + mid < target )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+
+/*******************************************************************************
+    CSR (and CSRL, CSRU, CSRD, CUCSR, CSRCOO) for nvecs vectors stored
+    row-major, i.e., x[ col*nvecs + v ]. nvecs = 1 is a plain SpMV.
+*/
+static void
+magma_scsrmv_cpu(
+    float alpha,
+    magma_s_matrix A,
+    const float *x,
+    float beta,
+    float *y,
+    magma_int_t nvecs )
+{
+    const bool overwrite = MAGMA_S_EQUAL( beta, MAGMA_S_ZERO );
+
+    #pragma omp parallel
+    {
+#ifdef _OPENMP
+        magma_int_t tid = omp_get_thread_num();
+        magma_int_t nthreads = omp_get_num_threads();
+#else
+        magma_int_t tid = 0;
+        magma_int_t nthreads = 1;
+#endif
+        magma_int_t begin = magma_sspmv_cpu_split( A.num_rows, A.row, tid, nthreads );
+        magma_int_t end   = magma_sspmv_cpu_split( A.num_rows, A.row, tid+1, nthreads );
+
+        if ( nvecs == 1 ) {
+            for( magma_int_t i=begin; i < end; i++ ) {
+                float dot = MAGMA_S_ZERO;
+                for( magma_int_t j=A.row[i]; j < A.row[i+1]; j++ ) {
+                    dot += A.val[j] * x[ A.col[j] ];
+                }
+                magma_sspmv_cpu_update( alpha, dot, beta, overwrite, &y[i] );
+            }
+        }
+        else {
+            for( magma_int_t i=begin; i < end; i++ ) {
+                float *yi = y + i*nvecs;
+                for( magma_int_t v=0; v < nvecs; v++ ) {
+                    if ( overwrite )
+                        yi[v] = MAGMA_S_ZERO;
+                    else
+                        yi[v] = beta * yi[v];
+                }
+                for( magma_int_t j=A.row[i]; j < A.row[i+1]; j++ ) {
+                    const float aval = alpha * A.val[j];
+                    const float *xj = x + A.col[j]*nvecs;
+                    #pragma omp simd
+                    for( magma_int_t v=0; v < nvecs; v++ ) {
+                        yi[v] += aval * xj[v];
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+    CSC and COO: scatter into y. Different nonzeros update the same entries
+    of y, so this one is serial.
+*/
+static void
+magma_sscattermv_cpu(
+    float alpha,
+    magma_s_matrix A,
+    const float *x,
+    float beta,
+    float *y )
+{
+    const bool overwrite = MAGMA_S_EQUAL( beta, MAGMA_S_ZERO );
+
+    #pragma omp parallel for
+    for( magma_int_t i=0; i < A.num_rows; i++ ) {
+        if ( overwrite )
+            y[i] = MAGMA_S_ZERO;
+        else
+            y[i] = beta * y[i];
+    }
+    if ( A.storage_type == Magma_CSC ) {
+        for( magma_int_t c=0; c < A.num_cols; c++ ) {
+            const float ax = alpha * x[c];
+            for( magma_int_t j=A.row[c]; j < A.row[c+1]; j++ ) {
+                y[ A.col[j] ] += A.val[j] * ax;
+            }
+        }
+    }
+    else { // COO: row holds the row index of every nonzero
+        for( magma_int_t j=0; j < A.nnz; j++ ) {
+            y[ A.row[j] ] += alpha * A.val[j] * x[ A.col[j] ];
+        }
+    }
+}
+
+
+/*******************************************************************************
+    ELL: column-major, padding has column 0 and value 0.
+*/
+static void
+magma_sellmv_cpu(
+    float alpha,
+    magma_s_matrix A,
+    const float *x,
+    float beta,
+    float *y )
+{
+    const bool overwrite = MAGMA_S_EQUAL( beta, MAGMA_S_ZERO );
+    const magma_int_t m = A.num_rows;
+
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i0=0; i0 < m; i0 += BLOCK_ROWS ) {
+        float dot[ BLOCK_ROWS ];
+        magma_int_t nb = min( (magma_int_t) BLOCK_ROWS, m - i0 );
+        for( magma_int_t i=0; i < nb; i++ ) {
+            dot[i] = MAGMA_S_ZERO;
+        }
+        for( magma_int_t k=0; k < A.max_nnz_row; k++ ) {
+            const float *val = A.val + k*m + i0;
+            const magma_index_t      *col = A.col + k*m + i0;
+            #pragma omp simd
+            for( magma_int_t i=0; i < nb; i++ ) {
+                dot[i] += val[i] * x[ col[i] ];
+            }
+        }
+        for( magma_int_t i=0; i < nb; i++ ) {
+            magma_sspmv_cpu_update( alpha, dot[i], beta, overwrite, &y[i0+i] );
+        }
+    }
+}
+
+
+/*******************************************************************************
+    ELLPACKT, ELLD and ELLRT: row-major with a fixed row stride.
+    ELLPACKT/ELLD pad with column -1, ELLRT stores the row lengths in A.row.
+*/
+static void
+magma_sellpacktmv_cpu(
+    float alpha,
+    magma_s_matrix A,
+    const float *x,
+    float beta,
+    float *y )
+{
+    const bool overwrite = MAGMA_S_EQUAL( beta, MAGMA_S_ZERO );
+    const bool ellrt = ( A.storage_type == Magma_ELLRT );
+    const magma_int_t stride = ellrt
+                             ? magma_roundup( A.max_nnz_row, A.alignment )
+                             : A.max_nnz_row;
+
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i < A.num_rows; i++ ) {
+        const float *val = A.val + i*stride;
+        const magma_index_t      *col = A.col + i*stride;
+        magma_int_t len = ellrt ? A.row[i] : A.max_nnz_row;
+        float dot = MAGMA_S_ZERO;
+        for( magma_int_t k=0; k < len; k++ ) {
+            if ( col[k] >= 0 )
+                dot += val[k] * x[ col[k] ];
+        }
+        magma_sspmv_cpu_update( alpha, dot, beta, overwrite, &y[i] );
+    }
+}
+
+
+/*******************************************************************************
+    SELLP: slices of A.blocksize rows, each stored column-major starting at
+    A.row[slice]; padding has column 0 and value 0.
+    nvecs vectors are stored row-major as in magma_scsrmv_cpu.
+*/
+static void
+magma_ssellpmv_cpu(
+    float alpha,
+    magma_s_matrix A,
+    const float *x,
+    float beta,
+    float *y,
+    magma_int_t nvecs )
+{
+    const bool overwrite = MAGMA_S_EQUAL( beta, MAGMA_S_ZERO );
+    const magma_int_t C = A.blocksize;
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for( magma_int_t s=0; s < A.numblocks; s++ ) {
+        float dot[ BLOCK_ROWS ];
+        const magma_int_t i0 = s*C;
+        const magma_int_t nb = min( C, A.num_rows - i0 );
+        const magma_int_t len = (A.row[s+1] - A.row[s]) / C;
+        for( magma_int_t v=0; v < nvecs; v++ ) {
+            for( magma_int_t i=0; i < C; i++ ) {
+                dot[i] = MAGMA_S_ZERO;
+            }
+            for( magma_int_t k=0; k < len; k++ ) {
+                const float *val = A.val + A.row[s] + k*C;
+                const magma_index_t      *col = A.col + A.row[s] + k*C;
+                #pragma omp simd
+                for( magma_int_t i=0; i < C; i++ ) {
+                    dot[i] += val[i] * x[ col[i]*nvecs + v ];
+                }
+            }
+            for( magma_int_t i=0; i < nb; i++ ) {
+                magma_sspmv_cpu_update( alpha, dot[i], beta, overwrite,
+                                        &y[ (i0+i)*nvecs + v ] );
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+    CSR5: A.row is the CSR row pointer, col/val are transposed within each
+    full tile (see magma_smconvert). Each row is traversed in CSR order and
+    every nonzero is looked up at its position in the tile.
+*/
+static void
+magma_scsr5mv_cpu(
+    float alpha,
+    magma_s_matrix A,
+    const float *x,
+    float beta,
+    float *y )
+{
+    const bool overwrite = MAGMA_S_EQUAL( beta, MAGMA_S_ZERO );
+    const magma_int_t sigma = A.csr5_sigma;
+    const magma_int_t tile = MAGMA_CSR5_OMEGA * sigma;
+
+    #pragma omp parallel
+    {
+#ifdef _OPENMP
+        magma_int_t tid = omp_get_thread_num();
+        magma_int_t nthreads = omp_get_num_threads();
+#else
+        magma_int_t tid = 0;
+        magma_int_t nthreads = 1;
+#endif
+        magma_int_t begin = magma_sspmv_cpu_split( A.num_rows, A.row, tid, nthreads );
+        magma_int_t end   = magma_sspmv_cpu_split( A.num_rows, A.row, tid+1, nthreads );
+
+        for( magma_int_t i=begin; i < end; i++ ) {
+            float dot = MAGMA_S_ZERO;
+            for( magma_int_t j=A.row[i]; j < A.row[i+1]; j++ ) {
+                magma_int_t par_id = j / tile;
+                magma_int_t pos = j;
+                // fast track tiles and the last tile are not transposed
+                if ( par_id < A.csr5_p-1 &&
+                     A.tile_ptr[par_id] != A.tile_ptr[par_id+1] ) {
+                    magma_int_t idx = j - par_id*tile;
+                    pos = par_id*tile + (idx % sigma) * MAGMA_CSR5_OMEGA
+                                      + idx / sigma;
+                }
+                dot += A.val[pos] * x[ A.col[pos] ];
+            }
+            magma_sspmv_cpu_update( alpha, dot, beta, overwrite, &y[i] );
+        }
+    }
+}
+
+
+/*******************************************************************************
+    BCSR: square blocks of A.blocksize, row-major within the block.
+*/
+static void
+magma_sbcsrmv_cpu(
+    float alpha,
+    magma_s_matrix A,
+    const float *x,
+    float beta,
+    float *y )
+{
+    const bool overwrite = MAGMA_S_EQUAL( beta, MAGMA_S_ZERO );
+    const magma_int_t bs = A.blocksize;
+    const magma_int_t mb = magma_ceildiv( A.num_rows, bs );
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for( magma_int_t I=0; I < mb; I++ ) {
+        for( magma_int_t r=0; r < bs && I*bs+r < A.num_rows; r++ ) {
+            float dot = MAGMA_S_ZERO;
+            for( magma_int_t b=A.row[I]; b < A.row[I+1]; b++ ) {
+                const float *val = A.val + b*bs*bs + r*bs;
+                const magma_int_t c0 = A.col[b]*bs;
+                const magma_int_t nc = min( bs, A.num_cols - c0 );
+                for( magma_int_t c=0; c < nc; c++ ) {
+                    dot += val[c] * x[ c0+c ];
+                }
+            }
+            magma_sspmv_cpu_update( alpha, dot, beta, overwrite, &y[ I*bs+r ] );
+        }
+    }
+}
+
+
+/*******************************************************************************
+    DENSE: row-major as produced by magma_smconvert.
+*/
+static void
+magma_sdensemv_cpu(
+    float alpha,
+    magma_s_matrix A,
+    const float *x,
+    float beta,
+    float *y )
+{
+    const bool overwrite = MAGMA_S_EQUAL( beta, MAGMA_S_ZERO );
+
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i < A.num_rows; i++ ) {
+        const float *val = A.val + i*A.num_cols;
+        float dot = MAGMA_S_ZERO;
+        for( magma_int_t j=0; j < A.num_cols; j++ ) {
+            dot += val[j] * x[j];
+        }
+        magma_sspmv_cpu_update( alpha, dot, beta, overwrite, &y[i] );
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes y = alpha * A * x + beta * y on the host using OpenMP, for
+    matrices in any storage format produced by magma_smconvert: CSR, CSRL,
+    CSRU, CSRD, CUCSR, CSRCOO, CSC, COO, ELL, ELLPACKT, ELLD, ELLRT, SELLP,
+    CSR5, BCSR and DENSE.
+
+    Multiple vectors (x.num_cols > 1, or x.num_rows a multiple of
+    A.num_cols) are supported in column-major order for all formats and in
+    row-major order for the CSR formats and SELLP.
+
+    If beta is zero, y is overwritten.
+
+    Arguments
+    ---------
+
+    @param[in]
+    alpha       float
+                scalar alpha
+
+    @param[in]
+    A           magma_s_matrix
+                sparse matrix A on the CPU
+
+    @param[in]
+    x           magma_s_matrix
+                input vector x on the CPU
+
+    @param[in]
+    beta        float
+                scalar beta
+
+    @param[in,out]
+    y           magma_s_matrix
+                output vector y on the CPU
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_s_spmv_cpu(
+    float alpha,
+    magma_s_matrix A,
+    magma_s_matrix x,
+    float beta,
+    magma_s_matrix y,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_int_t num_vecs = 1;
+    bool csr;
+
+    if ( A.memory_location != Magma_CPU || x.memory_location != Magma_CPU ||
+         y.memory_location != Magma_CPU ) {
+        printf("error: host SpMV needs all objects in CPU memory.\n");
+        info = MAGMA_ERR_INVALID_PTR;
+        goto cleanup;
+    }
+    if ( x.storage_type != Magma_DENSE ) {
+        printf("error: only dense vectors are supported for SpMV.\n");
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
+    csr = ( A.storage_type == Magma_CSR   || A.storage_type == Magma_CSRL  ||
+            A.storage_type == Magma_CSRU  || A.storage_type == Magma_CSRD  ||
+            A.storage_type == Magma_CUCSR || A.storage_type == Magma_CSRCOO );
+
+    if ( A.num_cols < x.num_rows || x.num_cols > 1 ) {
+        num_vecs = x.num_rows / A.num_cols * x.num_cols;
+    }
+
+    if ( num_vecs > 1 && x.major == MagmaRowMajor ) {
+        if ( csr ) {
+            magma_scsrmv_cpu( alpha, A, x.val, beta, y.val, num_vecs );
+        } else if ( A.storage_type == Magma_SELLP ) {
+            magma_ssellpmv_cpu( alpha, A, x.val, beta, y.val, num_vecs );
+        } else {
+            printf("error: format not supported.\n");
+            info = MAGMA_ERR_NOT_SUPPORTED;
+        }
+        goto cleanup;
+    }
+
+    // one vector, or column-major vectors one after another
+    for( magma_int_t v=0; v < num_vecs; v++ ) {
+        const float *xv = x.val + v*A.num_cols;
+        float *yv = y.val + v*A.num_rows;
+        if ( csr ) {
+            magma_scsrmv_cpu( alpha, A, xv, beta, yv, 1 );
+        }
+        else if ( A.storage_type == Magma_CSC || A.storage_type == Magma_COO ) {
+            magma_sscattermv_cpu( alpha, A, xv, beta, yv );
+        }
+        else if ( A.storage_type == Magma_ELL ) {
+            magma_sellmv_cpu( alpha, A, xv, beta, yv );
+        }
+        else if ( A.storage_type == Magma_ELLPACKT ||
+                  A.storage_type == Magma_ELLD     ||
+                  A.storage_type == Magma_ELLRT ) {
+            magma_sellpacktmv_cpu( alpha, A, xv, beta, yv );
+        }
+        else if ( A.storage_type == Magma_SELLP ) {
+            magma_ssellpmv_cpu( alpha, A, xv, beta, yv, 1 );
+        }
+        else if ( A.storage_type == Magma_CSR5 ) {
+            magma_scsr5mv_cpu( alpha, A, xv, beta, yv );
+        }
+        else if ( A.storage_type == Magma_BCSR ) {
+            magma_sbcsrmv_cpu( alpha, A, xv, beta, yv );
+        }
+        else if ( A.storage_type == Magma_DENSE ) {
+            magma_sdensemv_cpu( alpha, A, xv, beta, yv );
+        }
+        else {
+            printf("error: format not supported.\n");
+            info = MAGMA_ERR_NOT_SUPPORTED;
+            goto cleanup;
+        }
+    }
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes y = alpha * ( A - lambda I ) * x + beta * y on the host, with
+    the same conventions as the device kernels: for row < blocksize the
+    shift uses x[ offset+row ], otherwise x[ add_rows[row-blocksize] ].
+    All formats supported by magma_s_spmv_cpu are supported.
+
+    Arguments
+    ---------
+
+    @param[in]
+    alpha       float
+                scalar alpha
+
+    @param[in]
+    A           magma_s_matrix
+                sparse matrix A on the CPU
+
+    @param[in]
+    lambda      float
+                scalar lambda
+
+    @param[in]
+    x           magma_s_matrix
+                input vector x on the CPU
+
+    @param[in]
+    beta        float
+                scalar beta
+
+    @param[in]
+    offset      magma_int_t
+                in case not the main diagonal is scaled
+
+    @param[in]
+    blocksize   magma_int_t
+                in case of processing multiple vectors
+
+    @param[in]
+    add_rows    magma_index_t*
+                in case the matrixpowerskernel is used (CPU memory)
+
+    @param[in,out]
+    y           magma_s_matrix
+                output vector y on the CPU
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_s_spmv_shift_cpu(
+    float alpha,
+    magma_s_matrix A,
+    float lambda,
+    magma_s_matrix x,
+    float beta,
+    magma_int_t offset,
+    magma_int_t blocksize,
+    magma_index_t *add_rows,
+    magma_s_matrix y,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    CHECK( magma_s_spmv_cpu( alpha, A, x, beta, y, queue ));
+
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i < A.num_rows; i++ ) {
+        if ( i < blocksize )
+            y.val[i] -= lambda * x.val[ offset+i ];
+        else
+            y.val[i] -= lambda * x.val[ add_rows[i-blocksize] ];
+    }
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Copies the arrays of a CSR matrix on the host so that each OpenMP thread
+    first touches the rows it computes in magma_s_spmv_cpu. With threads
+    bound to cores (e.g., OMP_PROC_BIND=close), the operating system places
+    those pages on the thread's NUMA node, so the SpMV reads A from local
+    memory. Call it once after the matrix is assembled, with the same number
+    of threads as the SpMV.
+
+    Matrices in other formats, not in CPU memory, or that do not own their
+    arrays (e.g., a memory-mapped file, see magma_smunmap) are not changed.
+
+    Arguments
+    ---------
+
+    @param[in,out]
+    A           magma_s_matrix*
+                sparse matrix A on the CPU
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_smfirsttouch_cpu(
+    magma_s_matrix *A,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_index_t *row = NULL, *col = NULL;
+    float *val = NULL;
+    magma_int_t nnz;
+
+    if ( A->memory_location != Magma_CPU || A->num_rows <= 0 || ! A->ownership ||
+         ! ( A->storage_type == Magma_CSR  || A->storage_type == Magma_CSRL ||
+             A->storage_type == Magma_CSRU || A->storage_type == Magma_CSRD ||
+             A->storage_type == Magma_CUCSR )) {
+        goto cleanup;
+    }
+
+    nnz = A->row[ A->num_rows ];
+    CHECK( magma_index_malloc_cpu( &row, A->num_rows+1 ));
+    CHECK( magma_index_malloc_cpu( &col, nnz ));
+    CHECK( magma_smalloc_cpu( &val, nnz ));
+
+    // same split as magma_scsrmv_cpu
+    #pragma omp parallel
+    {
+#ifdef _OPENMP
+        magma_int_t tid = omp_get_thread_num();
+        magma_int_t nthreads = omp_get_num_threads();
+#else
+        magma_int_t tid = 0;
+        magma_int_t nthreads = 1;
+#endif
+        magma_int_t begin = magma_sspmv_cpu_split( A->num_rows, A->row, tid, nthreads );
+        magma_int_t end   = magma_sspmv_cpu_split( A->num_rows, A->row, tid+1, nthreads );
+
+        for( magma_int_t i=begin; i < end; i++ ) {
+            row[i] = A->row[i];
+        }
+        if ( tid == nthreads-1 ) {
+            row[ A->num_rows ] = A->row[ A->num_rows ];
+        }
+        for( magma_int_t j=A->row[begin]; j < A->row[end]; j++ ) {
+            col[j] = A->col[j];
+            val[j] = A->val[j];
+        }
+    }
+
+    magma_free_cpu( A->row );
+    magma_free_cpu( A->col );
+    magma_free_cpu( A->val );
+    A->row = row;
+    A->col = col;
+    A->val = val;
+    row = NULL;
+    col = NULL;
+    val = NULL;
+
+cleanup:
+    magma_free_cpu( row );
+    magma_free_cpu( col );
+    magma_free_cpu( val );
+    return info;
+}
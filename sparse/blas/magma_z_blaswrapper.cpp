@@ -327,19 +327,9 @@ magma_z_spmv(
             }
         }
     }
-    // CPU case missing!
+    // CPU case
     else {
-        CHECK( magma_zmtransfer( x, &dx, x.memory_location, Magma_DEV, queue ));
-        CHECK( magma_zmtransfer( y, &dy, y.memory_location, Magma_DEV, queue ));
-        CHECK( magma_zmtransfer( A, &dA, A.memory_location, Magma_DEV, queue ));
-        CHECK( magma_z_spmv( alpha, dA, dx, beta, dy, queue ) );
-        magma_zmfree(&x, queue );
-        magma_zmfree(&y, queue );
-        magma_zmfree(&A, queue );
-        CHECK( magma_zmtransfer( dx, &x, dx.memory_location, Magma_CPU, queue ));
-        CHECK( magma_zmtransfer( dy, &y, dy.memory_location, Magma_CPU, queue ));
-        CHECK( magma_zmtransfer( dA, &A, dA.memory_location, Magma_CPU, queue ));
-
+        CHECK( magma_z_spmv_cpu( alpha, A, x, beta, y, queue ));
     }
 
 cleanup:
@@ -466,10 +456,10 @@ magma_z_spmv_shift(
             info = MAGMA_ERR_NOT_SUPPORTED;
         }
     }
-    // CPU case missing!
+    // CPU case
     else {
-        printf("error: CPU not yet supported.\n");
-        info = MAGMA_ERR_NOT_SUPPORTED;
+        CHECK( magma_z_spmv_shift_cpu( alpha, A, lambda, x, beta, offset,
+                                       blocksize, add_rows, y, queue ));
     }
 cleanup:
     return info;
@@ -546,14 +536,20 @@ magma_z_spmm(
             }
         }
     }
-    // CPU case missing!
+    // CPU case
     else {
-        A.storage_type = Magma_CSR;
-        B.storage_type = Magma_CSR;
-        CHECK( magma_zmtransfer( A, &dA, Magma_CPU, Magma_DEV, queue ) );
-        CHECK( magma_zmtransfer( B, &dB, Magma_CPU, Magma_DEV, queue ) );
-        CHECK(  magma_zcuspmm( dA, dB, &dC, queue ) );
-        CHECK( magma_zmtransfer( dC, C, Magma_DEV, Magma_CPU, queue ) );
+        if ( A.num_cols == B.num_rows ) {
+            if ( A.storage_type == Magma_CSR  ||
+                 A.storage_type == Magma_CSRL ||
+                 A.storage_type == Magma_CSRU ||
+                 A.storage_type == Magma_CSRCOO ) {
+               CHECK( magma_z_spmm_cpu( alpha, A, B, C, queue ));
+            }
+            else {
+                printf("error: format not supported.\n");
+                info = MAGMA_ERR_NOT_SUPPORTED;
+            }
+        }
     }
     
 cleanup:
@@ -0,0 +1,380 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @precisions normal z -> s d c
+       @author Hartwig Anzt
+
+       Sample select on the host.
+
+       Like the GPU version (magma_zsampleselect.cu), every level draws a
+       sample of the values, sorts it, and takes equidistant splitters, which
+       are stored as an implicit binary search tree. Each thread then
+       classifies its part of the values into the buckets between the
+       splitters, walking the tree for a block of values at once, so the
+       compiler can vectorize the comparisons. Only the bucket that holds the
+       wanted rank is copied out and searched further, until it is small
+       enough for std::nth_element. The approximate mode stops after the
+       first level and returns the nearest splitter.
+*/
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+const magma_int_t sample_size   = 1024;
+const int         tree_height   = 8;
+const magma_int_t tree_width    = 1 << tree_height;    // number of buckets
+const magma_int_t basecase_size = 4096;                // nth_element below this
+const magma_int_t parallel_size = 32768;               // one thread below this
+const magma_int_t block_size    = 16;                  // values classified together
+
+
+/******************************************************************************/
+// Stores the sorted splitters as an implicit search tree: node i has
+// children 2i+1 and 2i+2, and an in-order walk visits the splitters in order.
+void fill_tree(
+    const double *splitters, double *tree, magma_int_t node, magma_int_t *next )
+{
+    if ( node < tree_width-1 ) {
+        fill_tree( splitters, tree, 2*node+1, next );
+        tree[ node ] = splitters[ (*next)++ ];
+        fill_tree( splitters, tree, 2*node+2, next );
+    }
+}
+
+
+/******************************************************************************/
+// Draws and sorts a sample of the n values get(0), ..., get(n-1), and builds
+// the tree of its tree_width-1 equidistant splitters.
+// The generator has a fixed seed, so the thresholds are reproducible.
+template< typename Get >
+void build_tree( magma_int_t n, Get get, double *splitters, double *tree )
+{
+    double sample[ sample_size ];
+    uint64_t state = 0x9e3779b97f4a7c15ull ^ (uint64_t) n;
+    for( magma_int_t i=0; i < sample_size; i++ ){
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        sample[ i ] = get( (magma_int_t) ((state >> 33) % (uint64_t) n) );
+    }
+    std::sort( sample, sample + sample_size );
+    for( magma_int_t i=0; i < tree_width-1; i++ ){
+        splitters[ i ] = sample[ (i+1) * sample_size / tree_width ];
+    }
+    magma_int_t next = 0;
+    fill_tree( splitters, tree, 0, &next );
+}
+
+
+/******************************************************************************/
+// Classifies get(begin), ..., get(end-1): bucket b holds the values x with
+// splitters[b-1] <= x < splitters[b]. Stores the bucket of every value in
+// oracle, and the number of values per bucket in counts.
+template< typename Get >
+void count_buckets(
+    magma_int_t begin, magma_int_t end, Get get, const double *tree,
+    unsigned char *oracle, magma_int_t *counts )
+{
+    for( magma_int_t b=0; b < tree_width; b++ ){
+        counts[ b ] = 0;
+    }
+    magma_int_t j = begin;
+    for( ; j + block_size <= end; j += block_size ){
+        double  x  [ block_size ];
+        int32_t idx[ block_size ];
+        for( magma_int_t k=0; k < block_size; k++ ){
+            x  [ k ] = get( j+k );
+            idx[ k ] = 0;
+        }
+        // one tree level for the whole block at a time
+        for( int level=0; level < tree_height; level++ ){
+            #pragma omp simd
+            for( magma_int_t k=0; k < block_size; k++ ){
+                idx[ k ] = 2*idx[ k ] + 1 + (x[ k ] >= tree[ idx[ k ] ]);
+            }
+        }
+        for( magma_int_t k=0; k < block_size; k++ ){
+            magma_int_t b = idx[ k ] - (tree_width-1);
+            oracle[ j+k ] = (unsigned char) b;
+            counts[ b ]++;
+        }
+    }
+    for( ; j < end; j++ ){
+        double x = get( j );
+        int32_t idx = 0;
+        for( int level=0; level < tree_height; level++ ){
+            idx = 2*idx + 1 + (x >= tree[ idx ]);
+        }
+        magma_int_t b = idx - (tree_width-1);
+        oracle[ j ] = (unsigned char) b;
+        counts[ b ]++;
+    }
+}
+
+
+/******************************************************************************/
+// One level: counts the n values in nchunk parts (one per thread), and finds
+// the bucket holding rank k. Returns the bucket, the number of values in it
+// in nb, and the number of values in lower buckets in nlow.
+// counts has nchunk*tree_width entries, bucket b of chunk c at c*tree_width + b.
+template< typename Get >
+magma_int_t select_bucket(
+    magma_int_t n, magma_int_t k, Get get, magma_int_t nchunk,
+    double *splitters, unsigned char *oracle, magma_int_t *counts,
+    magma_int_t *nlow, magma_int_t *nb )
+{
+    double tree[ tree_width-1 ];
+    build_tree( n, get, splitters, tree );
+
+    #pragma omp parallel for schedule(static, 1)
+    for( magma_int_t c=0; c < nchunk; c++ ){
+        count_buckets( c*n/nchunk, (c+1)*n/nchunk, get, tree, oracle,
+                       counts + c*tree_width );
+    }
+
+    magma_int_t low = 0;
+    for( magma_int_t b=0; b < tree_width; b++ ){
+        magma_int_t size = 0;
+        for( magma_int_t c=0; c < nchunk; c++ ){
+            size += counts[ c*tree_width + b ];
+        }
+        if ( k < low + size || b == tree_width-1 ) {
+            *nlow = low;
+            *nb   = size;
+            return b;
+        }
+        low += size;
+    }
+    return tree_width-1;  // not reached
+}
+
+
+/******************************************************************************/
+// Copies the values of bucket b to out, keeping their order.
+// Each chunk writes after the values of bucket b in the chunks before it.
+template< typename Get >
+void collect_bucket(
+    magma_int_t n, magma_int_t b, Get get, magma_int_t nchunk,
+    const unsigned char *oracle, const magma_int_t *counts, double *out )
+{
+    std::vector< magma_int_t > offset( nchunk+1, 0 );
+    for( magma_int_t c=0; c < nchunk; c++ ){
+        offset[ c+1 ] = offset[ c ] + counts[ c*tree_width + b ];
+    }
+
+    #pragma omp parallel for schedule(static, 1)
+    for( magma_int_t c=0; c < nchunk; c++ ){
+        magma_int_t o = offset[ c ];
+        for( magma_int_t j = c*n/nchunk; j < (c+1)*n/nchunk; j++ ){
+            if ( oracle[ j ] == b ) {
+                out[ o++ ] = get( j );
+            }
+        }
+    }
+}
+
+
+/******************************************************************************/
+// Magnitude of the value of rank subset_size; see magma_zsampleselect_cpu.
+// As on the GPU, it selects on squared magnitudes, which have the same order
+// and are cheaper than MAGMA_Z_ABS, and takes the square root of the result.
+magma_int_t sampleselect_cpu(
+    magma_int_t total_size,
+    magma_int_t subset_size,
+    const magmaDoubleComplex *val,
+    double *thrs,
+    bool exact )
+{
+    magma_int_t info = 0;
+
+    double *buf = NULL, *a, *tmp;
+    unsigned char *oracle = NULL;
+    magma_int_t *counts = NULL;
+    double splitters[ tree_width-1 ];
+    magma_int_t nthread = 1, nchunk, b, nlow, nb;
+    magma_int_t n = total_size;
+    magma_int_t k = max( 0, min( subset_size, n-1 ));
+
+    auto get_val = [val]( magma_int_t j ) {
+        return (double) (MAGMA_Z_REAL( val[ j ] ) * MAGMA_Z_REAL( val[ j ] )
+                       + MAGMA_Z_IMAG( val[ j ] ) * MAGMA_Z_IMAG( val[ j ] ));
+    };
+
+    if ( n <= 0 ) {
+        *thrs = 0.0;
+        goto cleanup;
+    }
+    if ( n <= basecase_size ) {
+        CHECK( magma_dmalloc_cpu( &buf, n ));
+        for( magma_int_t j=0; j < n; j++ ){
+            buf[ j ] = get_val( j );
+        }
+        std::nth_element( buf, buf + k, buf + n );
+        *thrs = sqrt( buf[ k ] );
+        goto cleanup;
+    }
+
+#ifdef _OPENMP
+    nthread = omp_get_max_threads();
+#endif
+    CHECK( magma_malloc_cpu( (void**) &oracle, n * sizeof(unsigned char) ));
+    CHECK( magma_malloc_cpu( (void**) &counts, nthread * tree_width * sizeof(magma_int_t) ));
+
+    // the first level computes the magnitudes on the fly
+    nchunk = (n >= parallel_size ? nthread : 1);
+    b = select_bucket( n, k, get_val, nchunk, splitters, oracle, counts, &nlow, &nb );
+
+    if ( ! exact ) {
+        // nearest bucket boundary: nlow values are below the lower one,
+        // nlow + nb below the upper one
+        double lower = (b > 0 ? splitters[ b-1 ] : 0.0);
+        if ( b == tree_width-1 || k - nlow <= nlow + nb - k ) {
+            *thrs = sqrt( lower );
+        }
+        else {
+            *thrs = sqrt( splitters[ b ] );
+        }
+        goto cleanup;
+    }
+
+    CHECK( magma_dmalloc_cpu( &buf, 2*nb ));
+    a   = buf;
+    tmp = buf + nb;
+    collect_bucket( n, b, get_val, nchunk, oracle, counts, a );
+
+    // if nothing was split off, e.g., all values are equal, go to the base case
+    if ( nb < n ) {
+        n = nb;
+        k -= nlow;
+        while( n > basecase_size ) {
+            auto get_a = [a]( magma_int_t j ) { return a[ j ]; };
+            nchunk = (n >= parallel_size ? nthread : 1);
+            b = select_bucket( n, k, get_a, nchunk, splitters, oracle, counts, &nlow, &nb );
+            if ( nb == n ) {
+                break;
+            }
+            collect_bucket( n, b, get_a, nchunk, oracle, counts, tmp );
+            std::swap( a, tmp );
+            n = nb;
+            k -= nlow;
+        }
+    }
+    else {
+        n = nb;
+    }
+    std::nth_element( a, a + k, a + n );
+    *thrs = sqrt( a[ k ] );
+
+cleanup:
+    magma_free_cpu( buf );
+    magma_free_cpu( oracle );
+    magma_free_cpu( counts );
+    return info;
+}
+
+}  // end namespace
+
+
+/**
+    Purpose
+    -------
+
+    This routine selects a threshold separating the subset_size smallest
+    magnitude elements from the rest, on the host:
+    thrs is the magnitude of the element of rank subset_size (counting from 0)
+    in ascending order of magnitude, as from magma_zselectrandom.
+    It is multithreaded with OpenMP; val is not changed.
+
+    Arguments
+    ---------
+
+    @param[in]
+    total_size  magma_int_t
+                size of array val
+
+    @param[in]
+    subset_size magma_int_t
+                number of smallest elements to separate
+
+    @param[in]
+    val         magmaDoubleComplex*
+                array containing the values
+
+    @param[out]
+    thrs        double*
+                computed threshold
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zsampleselect_cpu(
+    magma_int_t total_size,
+    magma_int_t subset_size,
+    magmaDoubleComplex *val,
+    double *thrs,
+    magma_queue_t queue )
+{
+    return sampleselect_cpu( total_size, subset_size, val, thrs, true );
+}
+
+
+/**
+    Purpose
+    -------
+
+    This routine selects an approximate threshold separating the subset_size
+    smallest magnitude elements from the rest, on the host.
+    It makes one pass over val and returns the splitter nearest to the
+    exact threshold; the number of elements below it differs from
+    subset_size by about total_size/512.
+
+    Arguments
+    ---------
+
+    @param[in]
+    total_size  magma_int_t
+                size of array val
+
+    @param[in]
+    subset_size magma_int_t
+                number of smallest elements to separate
+
+    @param[in]
+    val         magmaDoubleComplex*
+                array containing the values
+
+    @param[out]
+    thrs        double*
+                computed threshold
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zsampleselect_approx_cpu(
+    magma_int_t total_size,
+    magma_int_t subset_size,
+    magmaDoubleComplex *val,
+    double *thrs,
+    magma_queue_t queue )
+{
+    return sampleselect_cpu( total_size, subset_size, val, thrs, false );
+}
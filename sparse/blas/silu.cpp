@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/blas/zilu.cpp, normal z -> s, Wed Feb 22 15:21:39 2023
+       @generated from sparse/blas/zilu.cpp, normal z -> s, Sun Oct 18 06:54:11 2026
 */
 #include "magmasparse_internal.h"
 #include <cuda.h>  // for CUDA_VERSION
@@ -204,7 +204,7 @@ magma_scumilusetup(
     // in case using fill-in
     if( precond->levels > 0 ){
         magma_s_matrix hAL={Magma_CSR}, hAUt={Magma_CSR};
-        CHECK( magma_ssymbilu( &hACSR, precond->levels, &hAL, &hAUt,  queue ));
+        CHECK( magma_ssymbilu_stats( &hACSR, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
         magma_smfree(&hAL, queue);
         magma_smfree(&hAUt, queue);
     }
@@ -805,7 +805,7 @@ magma_scumiccsetup(
     // in case using fill-in
     if( precond->levels > 0 ){
             magma_s_matrix hAL={Magma_CSR}, hAUt={Magma_CSR};
-            CHECK( magma_ssymbilu( &hACSR, precond->levels, &hAL, &hAUt,  queue ));
+            CHECK( magma_ssymbilu_stats( &hACSR, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
             magma_smfree(&hAL, queue);
             magma_smfree(&hAUt, queue);
     }
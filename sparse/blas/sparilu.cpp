@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/blas/zparilu.cpp, normal z -> s, Wed Feb 22 15:21:39 2023
+       @generated from sparse/blas/zparilu.cpp, normal z -> s, Sun Oct 18 06:54:11 2026
 */
 #include "magmasparse_internal.h"
 
@@ -70,7 +70,7 @@ magma_sparilusetup(
     CHECK( magma_smtransfer( hA, &hAcopy, Magma_CPU, Magma_CPU , queue ));
 
     // in case using fill-in
-    CHECK( magma_ssymbilu( &hAcopy, precond->levels, &hAL, &hAUt,  queue ));
+    CHECK( magma_ssymbilu_stats( &hAcopy, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
     // add a unit diagonal to L for the algorithm
     CHECK( magma_smLdiagadd( &hAL , queue ));
     // transpose U for the algorithm
@@ -247,7 +247,7 @@ magma_spariluupdate(
     if ( updates > 0 ){
         CHECK( magma_smtransfer( precond->M, &hAcopy, Magma_DEV, Magma_CPU , queue ));
         // in case using fill-in
-        CHECK( magma_ssymbilu( &hAcopy, precond->levels, &hAL, &hAUt,  queue ));
+        CHECK( magma_ssymbilu_stats( &hAcopy, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
         // add a unit diagonal to L for the algorithm
         CHECK( magma_smLdiagadd( &hAL , queue ));
         // transpose U for the algorithm
@@ -357,7 +357,7 @@ magma_sparicsetup(
     magma_smfree(&hAh, queue );
 
     // in case using fill-in
-    CHECK( magma_ssymbilu( &hA, precond->levels, &hAL, &hAUt , queue ));
+    CHECK( magma_ssymbilu_stats( &hA, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
 
     // need only lower triangular
     magma_smfree(&hAUt, queue );
@@ -204,7 +204,7 @@ magma_zcumilusetup(
     // in case using fill-in
     if( precond->levels > 0 ){
         magma_z_matrix hAL={Magma_CSR}, hAUt={Magma_CSR};
-        CHECK( magma_zsymbilu( &hACSR, precond->levels, &hAL, &hAUt,  queue ));
+        CHECK( magma_zsymbilu_stats( &hACSR, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
         magma_zmfree(&hAL, queue);
         magma_zmfree(&hAUt, queue);
     }
@@ -805,7 +805,7 @@ magma_zcumiccsetup(
     // in case using fill-in
     if( precond->levels > 0 ){
             magma_z_matrix hAL={Magma_CSR}, hAUt={Magma_CSR};
-            CHECK( magma_zsymbilu( &hACSR, precond->levels, &hAL, &hAUt,  queue ));
+            CHECK( magma_zsymbilu_stats( &hACSR, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
             magma_zmfree(&hAL, queue);
             magma_zmfree(&hAUt, queue);
     }
@@ -0,0 +1,118 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @precisions normal z -> c d s
+       @author Hartwig Anzt
+
+*/
+#include "magmasparse_internal.h"
+
+#define BLOCK_SIZE 256
+
+
+// relaxes rows first ... last-1 of M, row k of M is row perm[k] of A
+__global__ void
+zmcsor_kernel(
+    int first,
+    int last,
+    magmaDoubleComplex omega,
+    const magma_index_t * __restrict__ row,
+    const magma_index_t * __restrict__ col,
+    const magmaDoubleComplex * __restrict__ val,
+    const magmaDoubleComplex * __restrict__ dinv,
+    const magma_index_t * __restrict__ perm,
+    const magmaDoubleComplex * __restrict__ b,
+    magmaDoubleComplex *x )
+{
+    int k = first + blockDim.x * blockIdx.x + threadIdx.x;
+
+    if ( k < last ) {
+        magma_index_t i = perm[k];
+        magmaDoubleComplex r = b[i];
+        for( magma_index_t j=row[k]; j < row[k+1]; j++ ) {
+            r -= val[j] * x[ col[j] ];
+        }
+        x[i] += omega * dinv[k] * r;
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    One relaxation step on the rows of one color of the multicolor
+    Gauss-Seidel / SOR smoother:
+
+        x(perm[k]) += omega * d[k] * ( b - A x )(perm[k]),   first <= k < last
+
+    where row k of M is row perm[k] of A and d holds the inverse diagonal.
+    The rows of one color are not coupled, so they are updated in parallel.
+
+    Arguments
+    ---------
+
+    @param[in]
+    first       magma_int_t
+                first row of M
+
+    @param[in]
+    last        magma_int_t
+                last row of M plus one
+
+    @param[in]
+    omega       magmaDoubleComplex
+                relaxation parameter
+
+    @param[in]
+    M           magma_z_matrix
+                rows of A in color order, CSR on the device
+
+    @param[in]
+    d           magma_z_matrix
+                inverse diagonal in the order of M
+
+    @param[in]
+    perm        magma_index_t*
+                row of A for every row of M, on the device
+
+    @param[in]
+    b           magma_z_matrix
+                right-hand side
+
+    @param[in,out]
+    x           magma_z_matrix*
+                iteration vector
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zmcsor_sweep(
+    magma_int_t first,
+    magma_int_t last,
+    magmaDoubleComplex omega,
+    magma_z_matrix M,
+    magma_z_matrix d,
+    magma_index_t *perm,
+    magma_z_matrix b,
+    magma_z_matrix *x,
+    magma_queue_t queue )
+{
+    if ( last > first ) {
+        dim3 grid( magma_ceildiv( last - first, BLOCK_SIZE ));
+        magma_int_t threads = BLOCK_SIZE;
+        zmcsor_kernel<<< grid, threads, 0, queue->cuda_stream() >>>
+            ( first, last, omega, M.drow, M.dcol, M.dval, d.dval, perm,
+              b.dval, x->dval );
+    }
+    return MAGMA_SUCCESS;
+}
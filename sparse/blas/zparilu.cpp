@@ -70,7 +70,7 @@ magma_zparilusetup(
     CHECK( magma_zmtransfer( hA, &hAcopy, Magma_CPU, Magma_CPU , queue ));
 
     // in case using fill-in
-    CHECK( magma_zsymbilu( &hAcopy, precond->levels, &hAL, &hAUt,  queue ));
+    CHECK( magma_zsymbilu_stats( &hAcopy, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
     // add a unit diagonal to L for the algorithm
     CHECK( magma_zmLdiagadd( &hAL , queue ));
     // transpose U for the algorithm
@@ -247,7 +247,7 @@ magma_zpariluupdate(
     if ( updates > 0 ){
         CHECK( magma_zmtransfer( precond->M, &hAcopy, Magma_DEV, Magma_CPU , queue ));
         // in case using fill-in
-        CHECK( magma_zsymbilu( &hAcopy, precond->levels, &hAL, &hAUt,  queue ));
+        CHECK( magma_zsymbilu_stats( &hAcopy, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
         // add a unit diagonal to L for the algorithm
         CHECK( magma_zmLdiagadd( &hAL , queue ));
         // transpose U for the algorithm
@@ -357,7 +357,7 @@ magma_zparicsetup(
     magma_zmfree(&hAh, queue );
 
     // in case using fill-in
-    CHECK( magma_zsymbilu( &hA, precond->levels, &hAL, &hAUt , queue ));
+    CHECK( magma_zsymbilu_stats( &hA, precond->levels, &hAL, &hAUt, &precond->symbilu, queue ));
 
     // need only lower triangular
     magma_zmfree(&hAUt, queue );
@@ -0,0 +1,282 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @generated from sparse/control/magma_zmcolor.cpp, normal z -> c, Sun Oct 18 03:57:49 2026
+       @author Hartwig Anzt
+
+       Coloring of the adjacency graph of a sparse matrix, the basis of the
+       multicolor Gauss-Seidel and SOR smoothers. Two rows get different
+       colors if A(i,j) or A(j,i) is nonzero, so all rows of one color can
+       be relaxed in parallel.
+*/
+#include <algorithm>
+#include <vector>
+
+#include "magmasparse_internal.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+/*******************************************************************************
+    Pattern of A + A^T without the diagonal, duplicates are kept.
+*/
+static void
+magma_cmcolor_graph(
+    magma_c_matrix A,
+    std::vector< magma_index_t > &xadj,
+    std::vector< magma_index_t > &adj )
+{
+    magma_int_t n = A.num_rows;
+
+    xadj.assign( n+1, 0 );
+    for( magma_int_t i=0; i < n; i++ ) {
+        for( magma_int_t k=A.row[i]; k < A.row[i+1]; k++ ) {
+            magma_index_t j = A.col[k];
+            if ( j != i && j < n ) {
+                xadj[i+1]++;
+                xadj[j+1]++;
+            }
+        }
+    }
+    for( magma_int_t i=0; i < n; i++ ) {
+        xadj[i+1] += xadj[i];
+    }
+    std::vector< magma_index_t > pos( xadj.begin(), xadj.end()-1 );
+    adj.resize( xadj[n] );
+    for( magma_int_t i=0; i < n; i++ ) {
+        for( magma_int_t k=A.row[i]; k < A.row[i+1]; k++ ) {
+            magma_index_t j = A.col[k];
+            if ( j != i && j < n ) {
+                adj[ pos[i]++ ] = j;
+                adj[ pos[j]++ ] = i;
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+    Smallest color not used by a colored neighbor of u. forbidden has to be
+    large enough for the degree of u plus one and is left with stamp marks.
+*/
+static magma_index_t
+magma_cmcolor_first_fit(
+    magma_index_t u,
+    const std::vector< magma_index_t > &xadj,
+    const std::vector< magma_index_t > &adj,
+    const magma_index_t *color,
+    std::vector< magma_index_t > &forbidden )
+{
+    magma_int_t deg = xadj[u+1] - xadj[u];
+    for( magma_int_t k=xadj[u]; k < xadj[u+1]; k++ ) {
+        magma_index_t c = color[ adj[k] ];
+        if ( c >= 0 && c <= deg ) {
+            forbidden[c] = u;
+        }
+    }
+    magma_index_t c = 0;
+    while ( forbidden[c] == u ) {
+        c++;
+    }
+    return c;
+}
+
+
+// random priority of vertex u for the Jones-Plassmann coloring
+static inline magma_uindex_t
+magma_cmcolor_weight( magma_index_t u )
+{
+    magma_uindex_t h = (magma_uindex_t) u * 2654435761u;
+    h ^= h >> 16;
+    h *= 2246822519u;
+    h ^= h >> 13;
+    return h;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes a coloring of the graph of A + A^T and groups the rows by
+    color: rows perm[color_ptr[c]] ... perm[color_ptr[c+1]-1] have color c,
+    in increasing order. No two rows of one color are coupled in A.
+
+    Magma_GREEDYCOLOR       sequential first-fit coloring in natural order,
+                            usually the fewest colors
+    Magma_JPCOLOR           Jones-Plassmann: every round colors the
+                            uncolored rows whose random weight is a local
+                            maximum, in parallel
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                square sparse matrix in any format and memory location
+
+    @param[in]
+    method      magma_coloring_t
+                coloring algorithm
+
+    @param[out]
+    ncolors     magma_int_t*
+                number of colors
+
+    @param[out]
+    perm        magma_index_t**
+                rows in color order, length A.num_rows, allocated on the CPU
+
+    @param[out]
+    color_ptr   magma_index_t**
+                first position of every color in perm, length ncolors+1,
+                allocated on the CPU
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cmcolor(
+    magma_c_matrix A,
+    magma_coloring_t method,
+    magma_int_t *ncolors,
+    magma_index_t **perm,
+    magma_index_t **color_ptr,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_c_matrix hA={Magma_CSR}, CSRA={Magma_CSR};
+    magma_index_t *color = NULL;
+    std::vector< magma_index_t > xadj, adj;
+    magma_int_t n = A.num_rows;
+    magma_int_t nc = 0;
+
+    *perm = NULL;
+    *color_ptr = NULL;
+    *ncolors = 0;
+    if ( A.num_rows != A.num_cols ) {
+        printf("%%error: coloring needs a square matrix.\n");
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
+    CHECK( magma_cmtransfer( A, &hA, A.memory_location, Magma_CPU, queue ));
+    CHECK( magma_cmconvert( hA, &CSRA, hA.storage_type, Magma_CSR, queue ));
+    magma_cmcolor_graph( CSRA, xadj, adj );
+
+    CHECK( magma_index_malloc_cpu( &color, n ));
+    for( magma_int_t i=0; i < n; i++ ) {
+        color[i] = -1;
+    }
+
+    if ( method == Magma_GREEDYCOLOR ) {
+        std::vector< magma_index_t > forbidden;
+        for( magma_int_t u=0; u < n; u++ ) {
+            magma_int_t deg = xadj[u+1] - xadj[u];
+            if ( (magma_int_t) forbidden.size() < deg+1 ) {
+                forbidden.resize( deg+1, -1 );
+            }
+            color[u] = magma_cmcolor_first_fit( u, xadj, adj, color, forbidden );
+        }
+    }
+    else {
+        // Jones-Plassmann: neighbors of equal weight are ordered by index
+        std::vector< magma_index_t > active( n ), next, ready;
+        for( magma_int_t u=0; u < n; u++ ) {
+            active[u] = u;
+        }
+        next.reserve( n );
+        ready.reserve( n );
+        while ( ! active.empty() ) {
+            magma_int_t na = active.size();
+            std::vector< char > isready( na );
+            #pragma omp parallel for schedule(dynamic, 1024)
+            for( magma_int_t a=0; a < na; a++ ) {
+                magma_index_t u = active[a];
+                magma_uindex_t wu = magma_cmcolor_weight( u );
+                char top = 1;
+                for( magma_int_t k=xadj[u]; k < xadj[u+1] && top; k++ ) {
+                    magma_index_t v = adj[k];
+                    if ( color[v] < 0 ) {
+                        magma_uindex_t wv = magma_cmcolor_weight( v );
+                        if ( wv > wu || ( wv == wu && v > u ) ) {
+                            top = 0;
+                        }
+                    }
+                }
+                isready[a] = top;
+            }
+            ready.clear();
+            next.clear();
+            for( magma_int_t a=0; a < na; a++ ) {
+                if ( isready[a] ) {
+                    ready.push_back( active[a] );
+                } else {
+                    next.push_back( active[a] );
+                }
+            }
+            // the ready rows are pairwise uncoupled
+            magma_int_t nr = ready.size();
+            #pragma omp parallel
+            {
+                std::vector< magma_index_t > forbidden;
+                #pragma omp for schedule(dynamic, 1024)
+                for( magma_int_t r=0; r < nr; r++ ) {
+                    magma_index_t u = ready[r];
+                    magma_int_t deg = xadj[u+1] - xadj[u];
+                    if ( (magma_int_t) forbidden.size() < deg+1 ) {
+                        forbidden.resize( deg+1, -1 );
+                    }
+                    color[u] = magma_cmcolor_first_fit( u, xadj, adj, color, forbidden );
+                }
+            }
+            active.swap( next );
+        }
+    }
+
+    // group the rows by color
+    for( magma_int_t u=0; u < n; u++ ) {
+        nc = max( nc, (magma_int_t) color[u]+1 );
+    }
+    CHECK( magma_index_malloc_cpu( color_ptr, nc+1 ));
+    CHECK( magma_index_malloc_cpu( perm, n ));
+    for( magma_int_t c=0; c <= nc; c++ ) {
+        (*color_ptr)[c] = 0;
+    }
+    for( magma_int_t u=0; u < n; u++ ) {
+        (*color_ptr)[ color[u]+1 ]++;
+    }
+    for( magma_int_t c=0; c < nc; c++ ) {
+        (*color_ptr)[c+1] += (*color_ptr)[c];
+    }
+    {
+        std::vector< magma_index_t > pos( *color_ptr, *color_ptr + nc );
+        for( magma_int_t u=0; u < n; u++ ) {
+            (*perm)[ pos[ color[u] ]++ ] = u;
+        }
+    }
+    *ncolors = nc;
+
+cleanup:
+    if ( info != 0 ) {
+        magma_free_cpu( *perm );
+        magma_free_cpu( *color_ptr );
+        *perm = NULL;
+        *color_ptr = NULL;
+    }
+    magma_free_cpu( color );
+    magma_cmfree( &hA, queue );
+    magma_cmfree( &CSRA, queue );
+    return info;
+}
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/control/magma_zmio.cpp, normal z -> c, Wed Feb 22 15:21:45 2023
+       @generated from sparse/control/magma_zmio.cpp, normal z -> c, Sun Oct 18 06:50:20 2026
        @author Hartwig Anzt
        @author Mark Gates
 */
@@ -13,26 +13,321 @@
 //  in this file, many routines are taken from
 //  the IO functions provided by MatrixMarket
 
-#include <algorithm>
-#include <vector>
-#include <utility>  // pair
+#include <map>
+#include <mutex>
 
 #include "magmasparse_internal.h"
 #include "magmasparse_mmio.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if ! defined( _WIN32 ) && ! defined( _WIN64 )
+#include <sys/mman.h>
+#endif
+
+#define PRECISION_c
+
+// Files loaded by magma_c_csr_binary, keyed by the row pointer of the
+// matrix: start and size of the data, and whether it is mmap'ed.
+// magma_cmunmap only releases matrices found here.
+namespace {
+struct binary_data {
+    char   *data;
+    int64_t size;
+    int     mapped;
+};
+std::map< const void*, binary_data > g_binary_data;
+std::mutex g_binary_mutex;
+}  // end namespace
 
 
 /**
     Purpose
     -------
-    Returns true if first element of a is less than first element of b.
-    Ignores second element. Used for sorting pairs,
-    std::pair< int, magmaFloatComplex >, of column indices and values.
-*/
-static bool compare_first(
-    const std::pair< magma_index_t, magmaFloatComplex >& a,
-    const std::pair< magma_index_t, magmaFloatComplex >& b )
+
+    Parses the body of a Matrix Market coordinate file in parallel and
+    assembles the CSR arrays.
+
+    The file is memory-mapped and split into a few chunks per thread on
+    line boundaries. Every chunk is parsed with the inline Matrix Market number
+    parsers into its slice of the COO arrays. CSR is then built with a
+    parallel counting sort: atomic row counts, prefix sum, atomic scatter,
+    followed by sorting every row with magma_ccsr_sort_rows.
+
+    Arguments
+    ---------
+
+    @param[in]
+    filename    const char*
+                filname of the mtx matrix
+
+    @param[in]
+    offset      long
+                byte offset of the first entry line, i.e., the position
+                after the size line
+
+    @param[in]
+    matcode     MM_typecode
+                Matrix Market typecode as read from the banner
+
+    @param[in]
+    num_rows    magma_index_t
+                number of rows in matrix
+
+    @param[in]
+    num_cols    magma_index_t
+                number of columns in matrix
+
+    @param[in]
+    num_entries magma_index_t
+                number of entries stored in the file
+
+    @param[in]
+    expand      magma_int_t
+                if nonzero, off-diagonal entries of symmetric and Hermitian
+                matrices are duplicated (conjugated in the Hermitian case)
+
+    @param[out]
+    nnz         magma_int_t*
+                number of nonzeros in the CSR output
+
+    @param[out]
+    val         magmaFloatComplex**
+                value array of CSR output
+
+    @param[out]
+    row         magma_index_t**
+                row pointer of CSR output
+
+    @param[out]
+    col         magma_index_t**
+                column indices of CSR output
+
+    @param[out]
+    zeros       magma_int_t*
+                set to 1 if the file contains explicit zeros (real and
+                integer files only), 0 otherwise
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+static magma_int_t
+magma_cmtx_read_body(
+    const char *filename,
+    long offset,
+    MM_typecode matcode,
+    magma_index_t num_rows,
+    magma_index_t num_cols,
+    magma_index_t num_entries,
+    magma_int_t expand,
+    magma_int_t *nnz,
+    magmaFloatComplex **val,
+    magma_index_t **row,
+    magma_index_t **col,
+    magma_int_t *zeros,
+    magma_queue_t queue )
 {
-    return (a.first < b.first);
+    magma_int_t info = 0;
+
+    mm_file_map map = { NULL, 0, 0 };
+    const char **part_begin = NULL;
+    magma_index_t *part_start = NULL;
+    magma_index_t *coo_row = NULL, *coo_col = NULL;
+    magma_index_t *cursor = NULL, *block_sum = NULL;
+    magmaFloatComplex *coo_val = NULL;
+    magma_int_t num_threads = 1, nparts;
+    magma_int_t conjugate = mm_is_hermitian(matcode);
+    magma_int_t symmetric = expand &&
+                            (mm_is_symmetric(matcode) || mm_is_hermitian(matcode));
+    magma_int_t cplx = mm_is_complex(matcode);
+    magma_int_t pattern = mm_is_pattern(matcode);
+    magma_int_t bad = 0, found_zero = 0;
+    magma_index_t off_diagonals = 0;
+
+    *nnz = 0;
+    *val = NULL;
+    *row = NULL;
+    *col = NULL;
+    *zeros = 0;
+
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    // a few chunks per thread to even out lines of different length
+    nparts = 4*num_threads;
+
+    if ( mm_map_file( filename, &map ) != 0 || offset < 0 ||
+         (size_t) offset > map.size ) {
+        printf("\n%% Unable to map file %s\n", filename);
+        info = MAGMA_ERR_NOT_FOUND;
+        goto cleanup;
+    }
+
+    CHECK( magma_malloc_cpu( (void**) &part_begin, (nparts+1)*sizeof(const char*) ));
+    CHECK( magma_index_malloc_cpu( &part_start, nparts+1 ));
+    mm_partition_entries( map.data + offset, map.data + map.size, nparts,
+                          part_begin, part_start );
+    if ( part_start[ nparts ] != num_entries ) {
+        printf("\n%% Expected %lld entries, found %lld.\n",
+               (long long) num_entries, (long long) part_start[ nparts ] );
+        info = MAGMA_ERR_UNKNOWN;
+        goto cleanup;
+    }
+
+    CHECK( magma_index_malloc_cpu( &coo_row, num_entries ));
+    CHECK( magma_index_malloc_cpu( &coo_col, num_entries ));
+    CHECK( magma_cmalloc_cpu( &coo_val, num_entries ));
+
+    // parse the chunks into their slices of the COO arrays
+    #pragma omp parallel for schedule(dynamic, 1) reduction(|:bad, found_zero)
+    for( magma_int_t k=0; k < nparts; k++ ) {
+        const char *p = part_begin[k];
+        const char *stop = part_begin[k+1];
+        magma_index_t i = part_start[k];
+        while ( p < stop ) {
+            p = mm_skip_blanks( p );
+            if ( *p == '\n' ) {
+                ++p;
+                continue;
+            }
+            magma_index_t r = mm_parse_index( &p ) - 1;
+            magma_index_t c = mm_parse_index( &p ) - 1;
+            if ( pattern ) {
+                coo_val[i] = MAGMA_C_MAKE( 1.0, 0. );
+            } else if ( cplx ) {
+                float re = mm_parse_float( &p );
+                float im = mm_parse_float( &p );
+                coo_val[i] = MAGMA_C_MAKE( re, im );
+                (void) im;  // unused in real precisions
+            } else {
+                float re = mm_parse_float( &p );
+                found_zero |= (re == 0.);
+                coo_val[i] = MAGMA_C_MAKE( re, 0. );
+            }
+            bad |= (r < 0 || r >= num_rows || c < 0 || c >= num_cols);
+            coo_row[i] = r;
+            coo_col[i] = c;
+            p = mm_next_line( p );
+            i++;
+        }
+    }
+    mm_unmap_file( &map );
+    if ( bad ) {
+        printf("\n%% Entry out of range in %s\n", filename);
+        info = MAGMA_ERR_UNKNOWN;
+        goto cleanup;
+    }
+    *zeros = found_zero;
+
+    if ( symmetric ) {
+        printf("\n%% Detected symmetric case.");
+        #pragma omp parallel for reduction(+:off_diagonals)
+        for( magma_int_t i=0; i < num_entries; i++ ) {
+            off_diagonals += (coo_row[i] != coo_col[i]);
+        }
+    }
+    *nnz = num_entries + off_diagonals;
+
+    CHECK( magma_index_malloc_cpu( row, num_rows+1 ));
+    CHECK( magma_index_malloc_cpu( &cursor, num_rows+1 ));
+    CHECK( magma_index_malloc_cpu( col, *nnz ));
+    CHECK( magma_cmalloc_cpu( val, *nnz ));
+
+    // count the entries of every row
+    #pragma omp parallel for
+    for( magma_int_t i=0; i < num_rows+1; i++ ) {
+        cursor[i] = 0;
+    }
+    #pragma omp parallel for
+    for( magma_int_t i=0; i < num_entries; i++ ) {
+        #pragma omp atomic
+        cursor[ coo_row[i] ]++;
+        if ( symmetric && coo_row[i] != coo_col[i] ) {
+            #pragma omp atomic
+            cursor[ coo_col[i] ]++;
+        }
+    }
+
+    // exclusive prefix sum: per-thread block sums, then local scans
+    CHECK( magma_index_malloc_cpu( &block_sum, num_threads+1 ));
+    #pragma omp parallel num_threads(num_threads)
+    {
+        magma_int_t nt = 1, id = 0;
+#ifdef _OPENMP
+        nt = omp_get_num_threads();
+        id = omp_get_thread_num();
+#endif
+        magma_int_t block = magma_ceildiv( num_rows, nt );
+        magma_int_t lo = min( id*block, (magma_int_t) num_rows );
+        magma_int_t hi = min( lo+block, (magma_int_t) num_rows );
+        magma_index_t sum = 0;
+        for( magma_int_t i=lo; i < hi; i++ ) {
+            sum += cursor[i];
+        }
+        block_sum[ id+1 ] = sum;
+        #pragma omp barrier
+        #pragma omp single
+        {
+            block_sum[0] = 0;
+            for( magma_int_t t=0; t < nt; t++ ) {
+                block_sum[ t+1 ] += block_sum[t];
+            }
+        }
+        sum = block_sum[ id ];
+        for( magma_int_t i=lo; i < hi; i++ ) {
+            magma_index_t tmp = cursor[i];
+            (*row)[i] = sum;
+            cursor[i] = sum;
+            sum += tmp;
+        }
+    }
+    (*row)[ num_rows ] = *nnz;
+
+    // scatter into the rows
+    #pragma omp parallel for
+    for( magma_int_t i=0; i < num_entries; i++ ) {
+        magma_index_t r = coo_row[i];
+        magma_index_t c = coo_col[i];
+        magma_index_t dest;
+        #pragma omp atomic capture
+        dest = cursor[ r ]++;
+        (*col)[ dest ] = c;
+        (*val)[ dest ] = coo_val[i];
+        if ( symmetric && r != c ) {
+            #pragma omp atomic capture
+            dest = cursor[ c ]++;
+            (*col)[ dest ] = r;
+            (*val)[ dest ] = (conjugate == 0) ? coo_val[i] : conj(coo_val[i]);
+        }
+    }
+
+    // sort column indices within each row
+    CHECK( magma_ccsr_sort_rows( num_rows, *row, *col, *val, queue ));
+
+cleanup:
+    if ( info != 0 ) {
+        magma_free_cpu( *val );
+        magma_free_cpu( *row );
+        magma_free_cpu( *col );
+        *val = NULL;
+        *row = NULL;
+        *col = NULL;
+        *nnz = 0;
+    }
+    mm_unmap_file( &map );
+    magma_free_cpu( part_begin );
+    magma_free_cpu( part_start );
+    magma_free_cpu( coo_row );
+    magma_free_cpu( coo_col );
+    magma_free_cpu( coo_val );
+    magma_free_cpu( cursor );
+    magma_free_cpu( block_sum );
+    return info;
 }
 
 
@@ -105,13 +400,8 @@ magma_int_t read_c_csr_from_mtx(
     char buffer[ 1024 ];
     magma_int_t info = 0;
     
-    magma_index_t *coo_col=NULL, *coo_row=NULL;
-    magmaFloatComplex *coo_val=NULL;
-    magma_index_t *new_col=NULL, *new_row=NULL;
-    magmaFloatComplex *new_val=NULL;
-    magma_int_t hermitian = 0;
-    
-    std::vector< std::pair< magma_index_t, magmaFloatComplex > > rowval;
+    magma_int_t zeros = 0;
+    long offset;
     
     FILE *fid = NULL;
     MM_typecode matcode;
@@ -164,162 +454,14 @@ magma_int_t read_c_csr_from_mtx(
     *n_col    = num_cols;
     *nnz      = num_nonzeros;
     
-    CHECK( magma_index_malloc_cpu( &coo_col, *nnz ) );
-    CHECK( magma_index_malloc_cpu( &coo_row, *nnz ) );
-    CHECK( magma_cmalloc_cpu( &coo_val, *nnz ) );
-
-    if (mm_is_real(matcode) || mm_is_integer(matcode)) {
-        for(magma_int_t i = 0; i < *nnz; ++i) {
-            magma_index_t ROW, COL;
-            float VAL;  // always read in a float and convert later if necessary
-            
-            fscanf(fid, " %d %d %f \n", &ROW, &COL, &VAL);
-            
-            coo_row[i] = ROW - 1;
-            coo_col[i] = COL - 1;
-            coo_val[i] = MAGMA_C_MAKE( VAL, 0.);
-        }
-    } else if (mm_is_pattern(matcode) ) {
-        for(magma_int_t i = 0; i < *nnz; ++i) {
-            magma_index_t ROW, COL;
-            
-            fscanf(fid, " %d %d \n", &ROW, &COL );
-            
-            coo_row[i] = ROW - 1;
-            coo_col[i] = COL - 1;
-            coo_val[i] = MAGMA_C_MAKE( 1.0, 0.);
-        }
-    } else if (mm_is_complex(matcode) ){
-        for (magma_int_t i = 0; i < *nnz; ++i) {
-            magma_index_t ROW, COL;
-            float VAL, VALC;  // always read in a float and convert later if necessary
-            
-            fscanf(fid, " %d %d %f %f\n", &ROW, &COL, &VAL, &VALC);
-            
-            coo_row[i] = ROW - 1;
-            coo_col[i] = COL - 1;
-            coo_val[i] = MAGMA_C_MAKE( VAL, VALC);
-        }
-        // printf(" ...successfully read complex matrix... ");
-    } else {
-        printf("\n%% Unrecognized data type\n");
-        info = MAGMA_ERR_NOT_SUPPORTED;
-        goto cleanup;
-    }
-    fclose(fid);
+    // the entries start right after the size line
+    offset = ftell( fid );
+    fclose( fid );
     fid = NULL;
-    printf(" done. Converting to CSR:");
-    fflush(stdout);
     
-
-    if( mm_is_hermitian(matcode) ) {
-        hermitian = 1;
-        printf("hermitian case!\n\n\n");
-    }
-    if ( mm_is_symmetric(matcode) || mm_is_hermitian(matcode) ) { 
-                                        // duplicate off diagonal entries
-        printf("\n%% Detected symmetric case.");
-        
-        magma_index_t off_diagonals = 0;
-        for(magma_int_t i = 0; i < *nnz; ++i) {
-            if (coo_row[i] != coo_col[i])
-                ++off_diagonals;
-        }
-        magma_index_t true_nonzeros = 2*off_diagonals + (*nnz - off_diagonals);
-        
-        //printf("%% total number of nonzeros: %d\n%%", int(*nnz));
-
-        CHECK( magma_index_malloc_cpu( &new_row, true_nonzeros ));
-        CHECK( magma_index_malloc_cpu( &new_col, true_nonzeros ));
-        CHECK( magma_cmalloc_cpu( &new_val, true_nonzeros ));
-    
-        magma_index_t ptr = 0;
-        for(magma_int_t i = 0; i < *nnz; ++i) {
-            if (coo_row[i] != coo_col[i]) {
-                new_row[ptr] = coo_row[i];
-                new_col[ptr] = coo_col[i];
-                new_val[ptr] = coo_val[i];
-                ptr++;
-                new_col[ptr] = coo_row[i];
-                new_row[ptr] = coo_col[i];
-                new_val[ptr] = (hermitian == 0) ? coo_val[i] : conj(coo_val[i]);
-                ptr++;
-            } else {
-                new_row[ptr] = coo_row[i];
-                new_col[ptr] = coo_col[i];
-                new_val[ptr] = coo_val[i];
-                ptr++;
-            }
-        }
-        
-        magma_free_cpu(coo_row); 
-        magma_free_cpu(coo_col); 
-        magma_free_cpu(coo_val);
-
-        coo_row = new_row;
-        coo_col = new_col;
-        coo_val = new_val;
-        
-        *nnz = true_nonzeros;
-    } // end symmetric case
-    
-    CHECK( magma_cmalloc_cpu( val, *nnz ) );
-    
-    CHECK( magma_index_malloc_cpu( col, *nnz ) );
-    CHECK( magma_index_malloc_cpu( row, (*n_row+1) ) );
-    CHECK( magma_cmalloc_cpu( val, *nnz ) );
-
-    // original code from  Nathan Bell and Michael Garland
-    for (magma_index_t i = 0; i < num_rows; i++)
-        (*row)[i] = 0;
-    
-    for (magma_index_t i = 0; i < *nnz; i++)
-        (*row)[coo_row[i]]++;
-    
-    // cumulative sum the nnz per row to get row[]
-    magma_int_t cumsum;
-    cumsum = 0;
-    for(magma_int_t i = 0; i < num_rows; i++) {
-        magma_index_t temp = (*row)[i];
-        (*row)[i] = cumsum;
-        cumsum += temp;
-    }
-    (*row)[num_rows] = *nnz;
-    
-    // write Aj,Ax into Bj,Bx
-    for(magma_int_t i = 0; i < *nnz; i++) {
-        magma_index_t row_  = coo_row[i];
-        magma_index_t dest = (*row)[row_];
-        (*col)[dest] = coo_col[i];
-        (*val)[dest] = coo_val[i];
-        (*row)[row_]++;
-    }
-    
-    int last;
-    last = 0;
-    for(int i = 0; i <= num_rows; i++) {
-        int temp  = (*row)[i];
-        (*row)[i] = last;
-        last      = temp;
-    }
-    
-    (*row)[*n_row] = *nnz;
-
-    // sort column indices within each row
-    // copy into vector of pairs (column index, value), sort by column index, then copy back
-    for (magma_index_t k=0; k < *n_row; ++k) {
-        int kk  = (*row)[k];
-        int len = (*row)[k+1] - (*row)[k];
-        rowval.resize( len );
-        for( int i=0; i < len; ++i ) {
-            rowval[i] = std::make_pair( (*col)[kk+i], (*val)[kk+i] );
-        }
-        std::sort( rowval.begin(), rowval.end(), compare_first );
-        for( int i=0; i < len; ++i ) {
-            (*col)[kk+i] = rowval[i].first;
-            (*val)[kk+i] = rowval[i].second;
-        }
-    }
+    CHECK( magma_cmtx_read_body( filename, offset, matcode,
+                                 num_rows, num_cols, num_nonzeros, 1,
+                                 nnz, val, row, col, &zeros, queue ));
 
     printf(" done.\n");
 cleanup:
@@ -327,9 +469,6 @@ cleanup:
         fclose( fid );
         fid = NULL;
     }
-    magma_free_cpu(coo_row);
-    magma_free_cpu(coo_col);
-    magma_free_cpu(coo_val);
     return info;
 }
 
@@ -948,23 +1087,15 @@ magma_c_csr_mtx(
     char buffer[ 1024 ];
     magma_int_t info = 0;
 
-    int csr_compressor = 0;       // checks for zeros in original file
+    magma_int_t csr_compressor = 0;       // checks for zeros in original file
     
     magma_c_matrix B={Magma_CSR};
 
-    magma_index_t *coo_col = NULL;
-    magma_index_t *coo_row = NULL;
-    magmaFloatComplex *coo_val = NULL;
-    magmaFloatComplex *new_val = NULL;
-    magma_index_t* new_row = NULL;
-    magma_index_t* new_col = NULL;
-    magma_int_t hermitian = 0;
+    long offset;
     
     // make sure the target structure is empty
     magma_cmfree( A, queue );
     A->ownership = MagmaTrue;
-    std::vector< std::pair< magma_index_t, magmaFloatComplex > > rowval;
-    
     FILE *fid = NULL;
     MM_typecode matcode;
     fid = fopen(filename, "r");
@@ -1017,167 +1148,20 @@ magma_c_csr_mtx(
     A->nnz             = num_nonzeros;
     A->fill_mode       = MagmaFull;
     
-    CHECK( magma_index_malloc_cpu( &coo_col, A->nnz ) );
-    CHECK( magma_index_malloc_cpu( &coo_row, A->nnz ) );
-    CHECK( magma_cmalloc_cpu( &coo_val, A->nnz ) );
-
-    if (mm_is_real(matcode) || mm_is_integer(matcode)) {
-        for(magma_int_t i = 0; i < A->nnz; ++i) {
-            magma_index_t ROW, COL;
-            float VAL;  // always read in a float and convert later if necessary
-            
-            fscanf(fid, " %d %d %f \n", &ROW, &COL, &VAL);
-            if ( VAL == 0 )
-                csr_compressor = 1;
-            coo_row[i] = ROW - 1;
-            coo_col[i] = COL - 1;
-            coo_val[i] = MAGMA_C_MAKE( VAL, 0.);
-        }
-    } else if (mm_is_pattern(matcode) ) {
-        for(magma_int_t i = 0; i < A->nnz; ++i) {
-            magma_index_t ROW, COL;
-            
-            fscanf(fid, " %d %d \n", &ROW, &COL );
-            
-            coo_row[i] = ROW - 1;
-            coo_col[i] = COL - 1;
-            coo_val[i] = MAGMA_C_MAKE( 1.0, 0.);
-        }
-    } else if (mm_is_complex(matcode) ){
-        for (magma_int_t i = 0; i < A->nnz; ++i) {
-            magma_index_t ROW, COL;
-            float VAL, VALC;  // always read in a float and convert later if necessary
-            
-            fscanf(fid, " %d %d %f %f\n", &ROW, &COL, &VAL, &VALC);
-            
-            coo_row[i] = ROW - 1;
-            coo_col[i] = COL - 1;
-            coo_val[i] = MAGMA_C_MAKE( VAL, VALC);
-        }
-        // printf(" ...successfully read complex matrix... ");
-    } else {
-        printf("\n%% Unrecognized data type\n");
-        info = MAGMA_ERR_NOT_SUPPORTED;
-        goto cleanup;
-    }
-    fclose(fid);
+    // the entries start right after the size line
+    offset = ftell( fid );
+    fclose( fid );
     fid = NULL;
-    printf(" done. Converting to CSR:");
-    fflush(stdout);
     
     A->sym = Magma_GENERAL;
-
-
-    if( mm_is_hermitian(matcode) ) {
-        hermitian = 1;
-    }
-    if ( mm_is_symmetric(matcode) || mm_is_hermitian(matcode) ) { 
-                                        // duplicate off diagonal entries
-        printf("\n%% Detected symmetric case.");
+    if ( mm_is_symmetric(matcode) || mm_is_hermitian(matcode) ) {
         A->sym = Magma_SYMMETRIC;
-        magma_index_t off_diagonals = 0;
-        for(magma_int_t i = 0; i < A->nnz; ++i) {
-            if (coo_row[i] != coo_col[i])
-                ++off_diagonals;
-        }
-        magma_index_t true_nonzeros = 2*off_diagonals + (A->nnz - off_diagonals);
-        
-        //printf("%% total number of nonzeros: %d\n%%", int(A->nnz));
-
-        CHECK( magma_index_malloc_cpu( &new_row, true_nonzeros ));
-        CHECK( magma_index_malloc_cpu( &new_col, true_nonzeros ));
-        CHECK( magma_cmalloc_cpu( &new_val, true_nonzeros ));
-        
-        magma_index_t ptr = 0;
-        for(magma_int_t i = 0; i < A->nnz; ++i) {
-            if (coo_row[i] != coo_col[i]) {
-                new_row[ptr] = coo_row[i];
-                new_col[ptr] = coo_col[i];
-                new_val[ptr] = coo_val[i];
-                ptr++;
-                new_col[ptr] = coo_row[i];
-                new_row[ptr] = coo_col[i];
-                new_val[ptr] = (hermitian == 0) ? coo_val[i] : conj(coo_val[i]);
-                ptr++;
-            } else {
-                new_row[ptr] = coo_row[i];
-                new_col[ptr] = coo_col[i];
-                new_val[ptr] = coo_val[i];
-                ptr++;
-            }
-        }
-        
-        magma_free_cpu(coo_row);
-        magma_free_cpu(coo_col);
-        magma_free_cpu(coo_val);
-
-        coo_row = new_row;
-        coo_col = new_col;
-        coo_val = new_val;
-        A->nnz = true_nonzeros;
-        //printf("total number of nonzeros: %d\n", A->nnz);
-    } // end symmetric case
-    
-    CHECK( magma_cmalloc_cpu( &A->val, A->nnz ));
-    CHECK( magma_index_malloc_cpu( &A->col, A->nnz ));
-    CHECK( magma_index_malloc_cpu( &A->row, A->num_rows+1 ));
-    
-    // original code from Nathan Bell and Michael Garland
-    for (magma_index_t i = 0; i < num_rows; i++)
-        (A->row)[i] = 0;
-    
-    for (magma_index_t i = 0; i < A->nnz; i++)
-        (A->row)[coo_row[i]]++;
-        
-    // cumulative sum the nnz per row to get row[]
-    magma_int_t cumsum;
-    cumsum = 0;
-    for(magma_int_t i = 0; i < num_rows; i++) {
-        magma_index_t temp = (A->row)[i];
-        (A->row)[i] = cumsum;
-        cumsum += temp;
-    }
-    (A->row)[num_rows] = A->nnz;
-    
-    // write Aj,Ax into Bj,Bx
-    for(magma_int_t i = 0; i < A->nnz; i++) {
-        magma_index_t row_ = coo_row[i];
-        magma_index_t dest = (A->row)[row_];
-        (A->col)[dest] = coo_col[i];
-        (A->val)[dest] = coo_val[i];
-        (A->row)[row_]++;
-    }    
-    magma_free_cpu(coo_row);
-    magma_free_cpu(coo_col);
-    magma_free_cpu(coo_val);
-    coo_row = NULL;
-    coo_col = NULL;
-    coo_val = NULL;
-
-    int last;
-    last = 0;
-    for(int i = 0; i <= num_rows; i++) {
-        int temp    = (A->row)[i];
-        (A->row)[i] = last;
-        last        = temp;
     }
-    (A->row)[A->num_rows] = A->nnz;
     
-    // sort column indices within each row
-    // copy into vector of pairs (column index, value), sort by column index, then copy back
-    for (magma_index_t k=0; k < A->num_rows; ++k) {
-        int kk  = (A->row)[k];
-        int len = (A->row)[k+1] - (A->row)[k];
-        rowval.resize( len );
-        for( int i=0; i < len; ++i ) {
-            rowval[i] = std::make_pair( (A->col)[kk+i], (A->val)[kk+i] );
-        }
-        std::sort( rowval.begin(), rowval.end(), compare_first );
-        for( int i=0; i < len; ++i ) {
-            (A->col)[kk+i] = rowval[i].first;
-            (A->val)[kk+i] = rowval[i].second;
-        }
-    }
+    CHECK( magma_cmtx_read_body( filename, offset, matcode,
+                                 num_rows, num_cols, num_nonzeros, 1,
+                                 &A->nnz, &A->val, &A->row, &A->col,
+                                 &csr_compressor, queue ));
 
     if ( csr_compressor > 0) { // run the CSR compressor to remove zeros
         //printf("removing zeros: ");
@@ -1202,9 +1186,6 @@ cleanup:
         fid = NULL;
     }
     magma_cmfree( &B, queue );
-    magma_free_cpu(coo_row);
-    magma_free_cpu(coo_col);
-    magma_free_cpu(coo_val);
     return info;
 }
 
@@ -1246,13 +1227,9 @@ magma_c_csr_mtxsymm(
     
     magma_c_matrix B={Magma_CSR};
         
-    int csr_compressor = 0;       // checks for zeros in original file
-    
-    magma_index_t *coo_col=NULL, *coo_row=NULL;
-    magmaFloatComplex *coo_val=NULL;
-
-    std::vector< std::pair< magma_index_t, magmaFloatComplex > > rowval;
+    magma_int_t csr_compressor = 0;       // checks for zeros in original file
     
+    long offset;
     FILE *fid = NULL;
     MM_typecode matcode;
     fid = fopen(filename, "r");
@@ -1307,123 +1284,20 @@ magma_c_csr_mtxsymm(
     A->nnz             = num_nonzeros;
     A->fill_mode       = MagmaFull;
   
-    CHECK( magma_index_malloc_cpu( &coo_col, A->nnz ) );
-    CHECK( magma_index_malloc_cpu( &coo_row, A->nnz ) );
-    CHECK( magma_cmalloc_cpu( &coo_val, A->nnz ) );
-    
-    if (mm_is_real(matcode) || mm_is_integer(matcode)) {
-        for(magma_int_t i = 0; i < A->nnz; ++i) {
-            magma_index_t ROW, COL;
-            float VAL;  // always read in a float and convert later if necessary
-            
-            fscanf(fid, " %d %d %f \n", &ROW, &COL, &VAL);
-            if ( VAL == 0 )
-                csr_compressor = 1;
-            coo_row[i] = ROW - 1;
-            coo_col[i] = COL - 1;
-            coo_val[i] = MAGMA_C_MAKE( VAL, 0.);
-        }
-    } else if (mm_is_pattern(matcode) ) {
-        for(magma_int_t i = 0; i < A->nnz; ++i) {
-            magma_index_t ROW, COL;
-            
-            fscanf(fid, " %d %d \n", &ROW, &COL);
-            
-            coo_row[i] = ROW - 1;
-            coo_col[i] = COL - 1;
-            coo_val[i] = MAGMA_C_MAKE( 1.0, 0.);
-        }
-    } else if (mm_is_complex(matcode) ){
-        for (magma_int_t i = 0; i < A->nnz; ++i) {
-            magma_index_t ROW, COL;
-            float VAL, VALC;  // always read in a float and convert later if necessary
-            
-            fscanf(fid, " %d %d %f %f\n", &ROW, &COL, &VAL, &VALC);
-            
-            coo_row[i] = ROW - 1;
-            coo_col[i] = COL - 1;
-            coo_val[i] = MAGMA_C_MAKE( VAL, VALC);
-        }
-        // printf(" ...successfully read complex matrix... ");
-    } else {
-        printf("Unrecognized data type\n");
-        info = MAGMA_ERR_NOT_SUPPORTED;
-        // TODO goto cleanup?
-    }
-    
-    fclose(fid);
+    // the entries start right after the size line
+    offset = ftell( fid );
+    fclose( fid );
     fid = NULL;
-    printf(" done. Converting to CSR:");
-    fflush(stdout);
     
     A->sym = Magma_GENERAL;
-
-    if ( mm_is_symmetric(matcode) || mm_is_hermitian(matcode) ) { 
-            // do not duplicate off diagonal entries!
+    if ( mm_is_symmetric(matcode) || mm_is_hermitian(matcode) ) {
         A->sym = Magma_SYMMETRIC;
-    } // end symmetric case
-    
-    CHECK( magma_index_malloc_cpu( &A->col, A->nnz ) );
-    CHECK( magma_index_malloc_cpu( &A->row, A->num_rows+1 ) );
-    CHECK( magma_cmalloc_cpu( &A->val, A->nnz ) );
-
-    // original code from  Nathan Bell and Michael Garland
-    for (magma_index_t i = 0; i < num_rows; i++)
-        (A->row)[i] = 0;
-    
-    for (magma_index_t i = 0; i < A->nnz; i++)
-        (A->row)[coo_row[i]]++;
-    
-    // cumulative sum the nnz per row to get row[]
-    magma_int_t cumsum;
-    cumsum = 0;
-    for(magma_int_t i = 0; i < num_rows; i++) {
-        magma_index_t temp = (A->row)[i];
-        (A->row)[i] = cumsum;
-        cumsum += temp;
-    }
-    (A->row)[num_rows] = A->nnz;
-    
-    // write Aj,Ax into Bj,Bx
-    for(magma_int_t i = 0; i < A->nnz; i++) {
-        magma_index_t row_  = coo_row[i];
-        magma_index_t dest = (A->row)[row_];
-        (A->col)[dest] = coo_col[i];
-        (A->val)[dest] = coo_val[i];
-        (A->row)[row_]++;
-    }
-    magma_free_cpu(coo_row);
-    magma_free_cpu(coo_col);
-    magma_free_cpu(coo_val);
-    coo_row = NULL;
-    coo_col = NULL;
-    coo_val = NULL;
-    
-    int last;
-    last = 0;
-    for(int i = 0; i <= num_rows; i++) {
-        int temp    = (A->row)[i];
-        (A->row)[i] = last;
-        last        = temp;
     }
     
-    (A->row)[A->num_rows]=A->nnz;
-    
-    // sort column indices within each row
-    // copy into vector of pairs (column index, value), sort by column index, then copy back
-    for (magma_index_t k=0; k < A->num_rows; ++k) {
-        int kk  = (A->row)[k];
-        int len = (A->row)[k+1] - (A->row)[k];
-        rowval.resize( len );
-        for( int i=0; i < len; ++i ) {
-            rowval[i] = std::make_pair( (A->col)[kk+i], (A->val)[kk+i] );
-        }
-        std::sort( rowval.begin(), rowval.end(), compare_first );
-        for( int i=0; i < len; ++i ) {
-            (A->col)[kk+i] = rowval[i].first;
-            (A->val)[kk+i] = rowval[i].second;
-        }
-    }
+    CHECK( magma_cmtx_read_body( filename, offset, matcode,
+                                 num_rows, num_cols, num_nonzeros, 0,
+                                 &A->nnz, &A->val, &A->row, &A->col,
+                                 &csr_compressor, queue ));
 
     if ( csr_compressor > 0) { // run the CSR compressor to remove zeros
         //printf("removing zeros: ");
@@ -1450,8 +1324,346 @@ cleanup:
         fid = NULL;
     }
     magma_cmfree( &B, queue );
-    magma_free_cpu(coo_row);
-    magma_free_cpu(coo_col);
-    magma_free_cpu(coo_val);
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Writes a CSR matrix to a file in the MAGMA binary CSR container format.
+    The header records storage type, symmetry, fill mode and precision,
+    followed by aligned row pointer, column index and value sections.
+    Such files can be loaded in milliseconds by magma_c_csr_binary.
+
+    Matrices not stored in CSR (or CSRL, CSRU, CSRD), or not stored on the
+    CPU, are converted/transferred to CPU CSR before writing.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                matrix to write out
+
+    @param[in]
+    filename    const char*
+                output-filname of the binary matrix
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C"
+magma_int_t
+magma_cwrite_csr_binary(
+    magma_c_matrix A,
+    const char *filename,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_c_matrix hA={Magma_CSR}, B={Magma_CSR};
+    magma_binary_header header;
+    char pad[ MAGMA_BINARY_ALIGN ] = { 0 };
+    int64_t pos;
+    FILE *fp = NULL;
+
+    if ( A.memory_location != Magma_CPU ) {
+        CHECK( magma_cmtransfer( A, &hA, A.memory_location, Magma_CPU, queue ));
+        A = hA;
+    }
+    if ( A.storage_type != Magma_CSR  && A.storage_type != Magma_CSRL &&
+         A.storage_type != Magma_CSRU && A.storage_type != Magma_CSRD ) {
+        CHECK( magma_cmconvert( A, &B, A.storage_type, Magma_CSR, queue ));
+        A = B;
+    }
+
+    memset( &header, 0, sizeof(header) );
+    memcpy( header.magic, MAGMA_BINARY_MAGIC, sizeof(header.magic) );
+    header.version      = MAGMA_BINARY_VERSION;
+    header.byte_order   = MAGMA_BINARY_BYTE_ORDER;
+    #if defined(PRECISION_z)
+    header.precision    = 'z';
+    #elif defined(PRECISION_c)
+    header.precision    = 'c';
+    #elif defined(PRECISION_d)
+    header.precision    = 'd';
+    #else
+    header.precision    = 's';
+    #endif
+    header.index_size   = sizeof(magma_index_t);
+    header.value_size   = sizeof(magmaFloatComplex);
+    header.storage_type = A.storage_type;
+    header.sym          = A.sym;
+    header.fill_mode    = A.fill_mode;
+    header.num_rows     = A.num_rows;
+    header.num_cols     = A.num_cols;
+    header.nnz          = A.nnz;
+    header.row_offset   = MAGMA_BINARY_HEADER_SIZE;
+    header.col_offset   = magma_roundup( header.row_offset
+                        + (A.num_rows+1)*sizeof(magma_index_t), MAGMA_BINARY_ALIGN );
+    header.val_offset   = magma_roundup( header.col_offset
+                        + A.nnz*sizeof(magma_index_t), MAGMA_BINARY_ALIGN );
+    header.file_size    = header.val_offset + A.nnz*sizeof(magmaFloatComplex);
+
+    printf("%% Writing sparse matrix to binary file (%s):", filename);
+    fflush(stdout);
+
+    fp = fopen( filename, "wb" );
+    if ( fp == NULL ) {
+        printf("\n%% error writing matrix: file exists or missing write permission\n");
+        info = MAGMA_ERR_FILESYSTEM;
+        goto cleanup;
+    }
+    pos = 0;
+    if ( fwrite( &header, sizeof(header), 1, fp ) != 1 ) {
+        info = MAGMA_ERR_FILESYSTEM;
+        goto cleanup;
+    }
+    pos += sizeof(header);
+    if ( fwrite( A.row, sizeof(magma_index_t), A.num_rows+1, fp ) != (size_t) (A.num_rows+1) ) {
+        info = MAGMA_ERR_FILESYSTEM;
+        goto cleanup;
+    }
+    pos += (A.num_rows+1)*sizeof(magma_index_t);
+    if ( fwrite( pad, 1, header.col_offset - pos, fp ) != (size_t) (header.col_offset - pos) ) {
+        info = MAGMA_ERR_FILESYSTEM;
+        goto cleanup;
+    }
+    pos = header.col_offset;
+    if ( fwrite( A.col, sizeof(magma_index_t), A.nnz, fp ) != (size_t) A.nnz ) {
+        info = MAGMA_ERR_FILESYSTEM;
+        goto cleanup;
+    }
+    pos += A.nnz*sizeof(magma_index_t);
+    if ( fwrite( pad, 1, header.val_offset - pos, fp ) != (size_t) (header.val_offset - pos) ) {
+        info = MAGMA_ERR_FILESYSTEM;
+        goto cleanup;
+    }
+    if ( fwrite( A.val, sizeof(magmaFloatComplex), A.nnz, fp ) != (size_t) A.nnz ) {
+        info = MAGMA_ERR_FILESYSTEM;
+        goto cleanup;
+    }
+
+cleanup:
+    if ( fp != NULL ) {
+        if ( fclose( fp ) != 0 && info == 0 ) {
+            info = MAGMA_ERR_FILESYSTEM;
+        }
+        if ( info == 0 )
+            printf(" done\n");
+        else
+            printf("\n%% error: writing matrix failed\n");
+    }
+    magma_cmfree( &hA, queue );
+    magma_cmfree( &B, queue );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Loads a matrix from a MAGMA binary CSR container file written by
+    magma_cwrite_csr_binary.
+
+    The file is memory-mapped (copy-on-write, so the matrix may be modified
+    in place without touching the file) and A points straight into the
+    mapping: nothing is parsed or copied. A is a CPU matrix with
+    ownership set to MagmaFalse; release it with magma_cmunmap, not
+    magma_cmfree.
+
+    Arguments
+    ---------
+
+    @param[out]
+    A           magma_c_matrix*
+                matrix in magma sparse matrix format
+
+    @param[in]
+    filename    const char*
+                filname of the binary matrix
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C"
+magma_int_t
+magma_c_csr_binary(
+    magma_c_matrix *A,
+    const char *filename,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_binary_header header;
+    char *data = NULL;
+    int mapped = 0;
+    int64_t size = 0;
+    FILE *fp = NULL;
+    #if defined(PRECISION_z)
+    const int32_t precision = 'z';
+    #elif defined(PRECISION_c)
+    const int32_t precision = 'c';
+    #elif defined(PRECISION_d)
+    const int32_t precision = 'd';
+    #else
+    const int32_t precision = 's';
+    #endif
+
+    // make sure the target structure is empty
+    magma_cmfree( A, queue );
+
+    printf("%% Reading sparse matrix from binary file (%s):", filename);
+    fflush(stdout);
+
+    fp = fopen( filename, "rb" );
+    if ( fp == NULL ) {
+        printf("\n%% Unable to open file %s\n", filename);
+        info = MAGMA_ERR_NOT_FOUND;
+        goto cleanup;
+    }
+    if ( fread( &header, sizeof(header), 1, fp ) != 1 ||
+         memcmp( header.magic, MAGMA_BINARY_MAGIC, sizeof(header.magic) ) != 0 ) {
+        printf("\n%% %s is not a MAGMA binary CSR file.\n", filename);
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+    fseek( fp, 0, SEEK_END );
+    size = ftell( fp );
+    if ( header.version    != MAGMA_BINARY_VERSION    ||
+         header.byte_order != MAGMA_BINARY_BYTE_ORDER ||
+         header.precision  != precision               ||
+         header.index_size != (int32_t) sizeof(magma_index_t) ||
+         header.value_size != (int32_t) sizeof(magmaFloatComplex) ) {
+        printf("\n%% %s: unsupported version %d, byte order, precision '%c',"
+               " or index/value size %d/%d.\n", filename, int(header.version),
+               int(header.precision), int(header.index_size), int(header.value_size) );
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+    if ( header.file_size != size ||
+         header.row_offset != MAGMA_BINARY_HEADER_SIZE ||
+         header.col_offset % MAGMA_BINARY_ALIGN != 0 ||
+         header.val_offset % MAGMA_BINARY_ALIGN != 0 ||
+         header.col_offset < header.row_offset + (header.num_rows+1)*header.index_size ||
+         header.val_offset < header.col_offset + header.nnz*header.index_size ||
+         header.file_size  < header.val_offset + header.nnz*header.value_size ) {
+        printf("\n%% %s: corrupt or truncated file.\n", filename);
+        info = MAGMA_ERR_UNKNOWN;
+        goto cleanup;
+    }
+
+#if ! defined( _WIN32 ) && ! defined( _WIN64 )
+    // private writable mapping: in-place changes never reach the file
+    data = (char*) mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                         fileno( fp ), 0 );
+    if ( data == MAP_FAILED ) {
+        data = NULL;
+    } else {
+        mapped = 1;
+    }
+#endif
+    if ( data == NULL ) {
+        // fallback: read the whole file
+        CHECK( magma_malloc_cpu( (void**) &data, size ));
+        fseek( fp, 0, SEEK_SET );
+        if ( fread( data, 1, size, fp ) != (size_t) size ) {
+            magma_free_cpu( data );
+            data = NULL;
+            info = MAGMA_ERR_FILESYSTEM;
+            goto cleanup;
+        }
+    }
+
+    A->storage_type    = (magma_storage_t)   header.storage_type;
+    A->memory_location = Magma_CPU;
+    A->sym             = (magma_symmetry_t)  header.sym;
+    A->fill_mode       = (magma_uplo_t)      header.fill_mode;
+    A->num_rows        = header.num_rows;
+    A->num_cols        = header.num_cols;
+    A->nnz             = header.nnz;
+    A->true_nnz        = header.nnz;
+    A->ownership       = MagmaFalse;
+    A->row = (magma_index_t*)      (data + header.row_offset);
+    A->col = (magma_index_t*)      (data + header.col_offset);
+    A->val = (magmaFloatComplex*) (data + header.val_offset);
+    {
+        std::lock_guard< std::mutex > lock( g_binary_mutex );
+        g_binary_data[ A->row ] = { data, size, mapped };
+    }
+
+    printf(" done.\n");
+cleanup:
+    if ( fp != NULL ) {
+        fclose( fp );
+    }
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Releases a matrix loaded with magma_c_csr_binary and resets A.
+    Any other matrix is passed to magma_cmfree, which frees its arrays
+    only if A owns them, so this may be called on any matrix that was
+    loaded either from a binary file or otherwise.
+
+    Arguments
+    ---------
+
+    @param[in,out]
+    A           magma_c_matrix*
+                matrix to release
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C"
+magma_int_t
+magma_cmunmap(
+    magma_c_matrix *A,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    binary_data block = { NULL, 0, 0 };
+    if ( ! A->ownership && A->memory_location == Magma_CPU && A->row != NULL ) {
+        std::lock_guard< std::mutex > lock( g_binary_mutex );
+        auto iter = g_binary_data.find( A->row );
+        if ( iter != g_binary_data.end() ) {
+            block = iter->second;
+            g_binary_data.erase( iter );
+        }
+    }
+    if ( block.data == NULL ) {
+        return magma_cmfree( A, queue );
+    }
+
+#if ! defined( _WIN32 ) && ! defined( _WIN64 )
+    if ( block.mapped ) {
+        munmap( block.data, block.size );
+    } else
+#endif
+    {
+        magma_free_cpu( block.data );
+    }
+    *A = {Magma_CSR};
+    A->memory_location = Magma_CPU;
+
     return info;
 }
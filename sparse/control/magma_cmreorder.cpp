@@ -0,0 +1,977 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @generated from sparse/control/magma_zmreorder.cpp, normal z -> c, Sun Oct 18 05:15:31 2026
+       @author Hartwig Anzt
+
+       Bandwidth- and fill-reducing orderings of sparse matrices.
+
+       Both orderings work on the graph of the symmetrized sparsity pattern
+       A + A^T without the diagonal. The reverse Cuthill-McKee ordering
+       numbers every connected component by a breadth-first search from a
+       pseudo-peripheral vertex. The nested dissection ordering bisects the
+       graph with a multilevel scheme (heavy-edge matching, graph growing on
+       the coarsest graph, greedy boundary refinement while uncoarsening),
+       turns the edge cut into a vertex separator, numbers the separator
+       last and recurses on the two halves as OpenMP tasks.
+
+       A permutation perm maps new to old indices: the reordered matrix is
+       B(i,j) = A(perm[i],perm[j]).
+*/
+#include <algorithm>
+#include <vector>
+
+#include "magmasparse_internal.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// subgraphs with at most ND_LEAF vertices are ordered with RCM
+#define ND_LEAF 128
+// coarsening stops at ND_COARSE vertices
+#define ND_COARSE 128
+// subgraphs larger than ND_TASK are dissected in a separate task
+#define ND_TASK 4096
+// number of graph growing starts on the coarsest graph
+#define ND_TRIES 4
+// number of refinement passes per level
+#define ND_PASSES 8
+
+
+// adjacency graph with vertex and edge weights
+typedef struct magma_cgraph
+{
+    magma_int_t n;
+    std::vector< magma_index_t > xadj;
+    std::vector< magma_index_t > adj;
+    std::vector< magma_index_t > ew;
+    std::vector< magma_index_t > vw;
+} magma_cgraph;
+
+
+/*******************************************************************************
+    Builds the graph of A + A^T without self loops from a CSR matrix on the
+    host. All vertex and edge weights are 1.
+*/
+static void
+magma_cgraph_create(
+    magma_c_matrix A,
+    magma_cgraph *G )
+{
+    magma_int_t n = A.num_rows;
+    std::vector< magma_index_t > cnt( n+1, 0 );
+
+    for( magma_int_t i=0; i < n; i++ ) {
+        for( magma_int_t k=A.row[i]; k < A.row[i+1]; k++ ) {
+            magma_index_t j = A.col[k];
+            if ( j != i && j < n ) {
+                cnt[i+1]++;
+                cnt[j+1]++;
+            }
+        }
+    }
+    for( magma_int_t i=0; i < n; i++ ) {
+        cnt[i+1] += cnt[i];
+    }
+    std::vector< magma_index_t > pos( cnt.begin(), cnt.end()-1 );
+    std::vector< magma_index_t > tmp( cnt[n] );
+    for( magma_int_t i=0; i < n; i++ ) {
+        for( magma_int_t k=A.row[i]; k < A.row[i+1]; k++ ) {
+            magma_index_t j = A.col[k];
+            if ( j != i && j < n ) {
+                tmp[ pos[i]++ ] = j;
+                tmp[ pos[j]++ ] = i;
+            }
+        }
+    }
+
+    // remove the duplicates of symmetric entries
+    std::vector< magma_index_t > len( n );
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for( magma_int_t i=0; i < n; i++ ) {
+        std::sort( tmp.begin() + cnt[i], tmp.begin() + cnt[i+1] );
+        len[i] = std::unique( tmp.begin() + cnt[i], tmp.begin() + cnt[i+1] )
+                 - ( tmp.begin() + cnt[i] );
+    }
+
+    G->n = n;
+    G->xadj.assign( n+1, 0 );
+    for( magma_int_t i=0; i < n; i++ ) {
+        G->xadj[i+1] = G->xadj[i] + len[i];
+    }
+    G->adj.resize( G->xadj[n] );
+    for( magma_int_t i=0; i < n; i++ ) {
+        std::copy( tmp.begin() + cnt[i], tmp.begin() + cnt[i] + len[i],
+                   G->adj.begin() + G->xadj[i] );
+    }
+    G->ew.assign( G->xadj[n], 1 );
+    G->vw.assign( n, 1 );
+}
+
+
+/*******************************************************************************
+    Breadth-first search from root. Appends the visited vertices to order
+    and sets their level, which has to be -1 for unvisited vertices.
+    Returns the number of levels.
+*/
+static magma_int_t
+magma_cgraph_bfs(
+    const magma_cgraph &G,
+    magma_index_t root,
+    std::vector< magma_index_t > &level,
+    std::vector< magma_index_t > &order )
+{
+    magma_int_t head = order.size();
+    magma_int_t nlevels = 0;
+
+    level[root] = 0;
+    order.push_back( root );
+    while ( head < (magma_int_t) order.size() ) {
+        magma_index_t u = order[head++];
+        nlevels = level[u] + 1;
+        for( magma_int_t k=G.xadj[u]; k < G.xadj[u+1]; k++ ) {
+            magma_index_t v = G.adj[k];
+            if ( level[v] < 0 ) {
+                level[v] = level[u] + 1;
+                order.push_back( v );
+            }
+        }
+    }
+    return nlevels;
+}
+
+
+/*******************************************************************************
+    Finds a pseudo-peripheral vertex in the component of root (George and
+    Liu): restart the search from a vertex of minimum degree in the last
+    level as long as the number of levels grows. level has to be -1 on the
+    component and is reset on return.
+*/
+static magma_index_t
+magma_cgraph_peripheral(
+    const magma_cgraph &G,
+    magma_index_t root,
+    std::vector< magma_index_t > &level )
+{
+    std::vector< magma_index_t > order;
+    magma_int_t nlevels = -1;
+    magma_index_t best = root;
+
+    for( magma_int_t it=0; it < 8; it++ ) {
+        order.clear();
+        magma_int_t nl = magma_cgraph_bfs( G, root, level, order );
+        if ( nl > nlevels ) {
+            nlevels = nl;
+            best = root;
+            magma_index_t cand = root;
+            magma_index_t mindeg = -1;
+            for( magma_int_t k=0; k < (magma_int_t) order.size(); k++ ) {
+                magma_index_t u = order[k];
+                magma_index_t deg = G.xadj[u+1] - G.xadj[u];
+                if ( level[u] == nl-1 && ( mindeg < 0 || deg < mindeg ) ) {
+                    mindeg = deg;
+                    cand = u;
+                }
+            }
+            root = cand;
+        } else {
+            it = 8;
+        }
+        for( magma_int_t k=0; k < (magma_int_t) order.size(); k++ ) {
+            level[ order[k] ] = -1;
+        }
+    }
+    return best;
+}
+
+
+/*******************************************************************************
+    Reverse Cuthill-McKee ordering of G: perm[new] = old.
+*/
+static void
+magma_cgraph_rcm(
+    const magma_cgraph &G,
+    std::vector< magma_index_t > &perm )
+{
+    magma_int_t n = G.n;
+    std::vector< magma_index_t > level( n, -1 ), mark( n, 0 ), nbr;
+
+    perm.clear();
+    perm.reserve( n );
+    for( magma_int_t s=0; s < n; s++ ) {
+        if ( mark[s] ) {
+            continue;
+        }
+        magma_index_t root = magma_cgraph_peripheral( G, s, level );
+        magma_int_t head = perm.size();
+        mark[root] = 1;
+        perm.push_back( root );
+        while ( head < (magma_int_t) perm.size() ) {
+            magma_index_t u = perm[head++];
+            nbr.clear();
+            for( magma_int_t k=G.xadj[u]; k < G.xadj[u+1]; k++ ) {
+                magma_index_t v = G.adj[k];
+                if ( ! mark[v] ) {
+                    mark[v] = 1;
+                    nbr.push_back( v );
+                }
+            }
+            // neighbors in order of increasing degree
+            std::sort( nbr.begin(), nbr.end(),
+                [&G]( magma_index_t a, magma_index_t b ) {
+                    magma_index_t da = G.xadj[a+1] - G.xadj[a];
+                    magma_index_t db = G.xadj[b+1] - G.xadj[b];
+                    return da < db || ( da == db && a < b );
+                });
+            perm.insert( perm.end(), nbr.begin(), nbr.end() );
+        }
+    }
+    std::reverse( perm.begin(), perm.end() );
+}
+
+
+/*******************************************************************************
+    Coarsens G by heavy-edge matching. cmap maps the vertices of G to the
+    vertices of the coarse graph C.
+*/
+static void
+magma_cgraph_coarsen(
+    const magma_cgraph &G,
+    magma_cgraph *C,
+    std::vector< magma_index_t > &cmap )
+{
+    magma_int_t n = G.n;
+    magma_int_t nc = 0;
+    std::vector< magma_index_t > match( n, -1 );
+
+    cmap.assign( n, -1 );
+    for( magma_int_t u=0; u < n; u++ ) {
+        if ( match[u] >= 0 ) {
+            continue;
+        }
+        magma_index_t best = -1, bw = 0;
+        for( magma_int_t k=G.xadj[u]; k < G.xadj[u+1]; k++ ) {
+            magma_index_t v = G.adj[k];
+            if ( match[v] < 0 && G.ew[k] > bw ) {
+                best = v;
+                bw = G.ew[k];
+            }
+        }
+        if ( best >= 0 ) {
+            match[u] = best;
+            match[best] = u;
+            cmap[best] = nc;
+        } else {
+            match[u] = u;
+        }
+        cmap[u] = nc++;
+    }
+
+    // every coarse vertex is represented by the smaller of its fine vertices
+    std::vector< magma_index_t > pos( nc, -1 );
+    C->n = nc;
+    C->xadj.assign( 1, 0 );
+    C->adj.clear();
+    C->ew.clear();
+    C->vw.assign( nc, 0 );
+    for( magma_int_t u=0; u < n; u++ ) {
+        if ( match[u] < u ) {
+            continue;
+        }
+        magma_index_t c = cmap[u];
+        magma_int_t start = C->adj.size();
+        for( magma_int_t f=0; f < 2; f++ ) {
+            magma_index_t w = ( f == 0 ) ? u : match[u];
+            if ( f == 1 && w == u ) {
+                break;
+            }
+            C->vw[c] += G.vw[w];
+            for( magma_int_t k=G.xadj[w]; k < G.xadj[w+1]; k++ ) {
+                magma_index_t cv = cmap[ G.adj[k] ];
+                if ( cv == c ) {
+                    continue;
+                }
+                if ( pos[cv] < 0 ) {
+                    pos[cv] = C->adj.size();
+                    C->adj.push_back( cv );
+                    C->ew.push_back( G.ew[k] );
+                } else {
+                    C->ew[ pos[cv] ] += G.ew[k];
+                }
+            }
+        }
+        for( magma_int_t k=start; k < (magma_int_t) C->adj.size(); k++ ) {
+            pos[ C->adj[k] ] = -1;
+        }
+        C->xadj.push_back( C->adj.size() );
+    }
+}
+
+
+/*******************************************************************************
+    Weight of the edges between part 0 and part 1.
+*/
+static magma_int_t
+magma_cgraph_cut(
+    const magma_cgraph &G,
+    const std::vector< magma_index_t > &part )
+{
+    magma_int_t cut = 0;
+    for( magma_int_t u=0; u < G.n; u++ ) {
+        for( magma_int_t k=G.xadj[u]; k < G.xadj[u+1]; k++ ) {
+            if ( part[ G.adj[k] ] != part[u] ) {
+                cut += G.ew[k];
+            }
+        }
+    }
+    return cut / 2;
+}
+
+
+/*******************************************************************************
+    Greedy boundary refinement of a bisection: moves vertices with positive
+    gain to the other part as long as the imbalance stays within 5% (or
+    does not grow), and zero-gain vertices if that improves the balance.
+*/
+static void
+magma_cgraph_refine(
+    const magma_cgraph &G,
+    std::vector< magma_index_t > &part )
+{
+    magma_int_t w[2] = { 0, 0 };
+    magma_int_t maxvw = 0;
+    for( magma_int_t u=0; u < G.n; u++ ) {
+        w[ part[u] ] += G.vw[u];
+        maxvw = max( maxvw, (magma_int_t) G.vw[u] );
+    }
+    magma_int_t tol = max( (w[0] + w[1]) / 20, maxvw );
+
+    for( magma_int_t pass=0; pass < ND_PASSES; pass++ ) {
+        magma_int_t moved = 0;
+        for( magma_int_t u=0; u < G.n; u++ ) {
+            magma_int_t ext = 0, in = 0;
+            for( magma_int_t k=G.xadj[u]; k < G.xadj[u+1]; k++ ) {
+                if ( part[ G.adj[k] ] == part[u] ) {
+                    in += G.ew[k];
+                } else {
+                    ext += G.ew[k];
+                }
+            }
+            if ( ext == 0 ) {
+                continue;
+            }
+            magma_int_t from = part[u], to = 1 - part[u];
+            magma_int_t diff = w[from] - w[to];
+            magma_int_t ndiff = w[from] - w[to] - 2*G.vw[u];
+            diff = ( diff < 0 ) ? -diff : diff;
+            ndiff = ( ndiff < 0 ) ? -ndiff : ndiff;
+            magma_int_t gain = ext - in;
+            if ( ( gain > 0 && ndiff <= max( tol, diff ) ) ||
+                 ( gain == 0 && ndiff < diff ) ) {
+                part[u] = to;
+                w[from] -= G.vw[u];
+                w[to] += G.vw[u];
+                moved++;
+            }
+        }
+        if ( moved == 0 ) {
+            break;
+        }
+    }
+}
+
+
+/*******************************************************************************
+    Bisection by graph growing: part 0 is grown breadth-first from seed
+    until it holds half of the vertex weight.
+*/
+static void
+magma_cgraph_grow(
+    const magma_cgraph &G,
+    magma_index_t seed,
+    std::vector< magma_index_t > &part )
+{
+    magma_int_t total = 0, w0 = 0;
+    magma_int_t head = 0, next = 0;
+    std::vector< magma_index_t > queue;
+
+    for( magma_int_t u=0; u < G.n; u++ ) {
+        total += G.vw[u];
+    }
+    part.assign( G.n, 1 );
+    queue.reserve( G.n );
+    part[seed] = 0;
+    w0 = G.vw[seed];
+    queue.push_back( seed );
+    while ( 2*w0 < total ) {
+        if ( head == (magma_int_t) queue.size() ) {
+            // component exhausted, continue in the next one
+            while ( next < G.n && part[next] == 0 ) {
+                next++;
+            }
+            if ( next == G.n ) {
+                break;
+            }
+            part[next] = 0;
+            w0 += G.vw[next];
+            queue.push_back( next );
+            continue;
+        }
+        magma_index_t u = queue[head++];
+        for( magma_int_t k=G.xadj[u]; k < G.xadj[u+1] && 2*w0 < total; k++ ) {
+            magma_index_t v = G.adj[k];
+            if ( part[v] == 1 ) {
+                part[v] = 0;
+                w0 += G.vw[v];
+                queue.push_back( v );
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+    Multilevel bisection of G into part 0 and part 1.
+*/
+static void
+magma_cgraph_bisect(
+    const magma_cgraph &G,
+    std::vector< magma_index_t > &part )
+{
+    std::vector< magma_cgraph > coarse;
+    std::vector< std::vector< magma_index_t > > cmap;
+    const magma_cgraph *cur = &G;
+
+    coarse.reserve( 64 );
+    cmap.reserve( 64 );
+    while ( cur->n > ND_COARSE && coarse.size() < 64 ) {
+        coarse.push_back( magma_cgraph() );
+        cmap.push_back( std::vector< magma_index_t >() );
+        magma_cgraph_coarsen( *cur, &coarse.back(), cmap.back() );
+        if ( 10 * coarse.back().n > 9 * cur->n ) {
+            // matching stalls, e.g. on star graphs
+            coarse.pop_back();
+            cmap.pop_back();
+            break;
+        }
+        cur = &coarse.back();
+    }
+
+    // initial bisection on the coarsest graph, best of several starts
+    std::vector< magma_index_t > level( cur->n, -1 ), trial;
+    magma_int_t best = -1;
+    for( magma_int_t t=0; t < ND_TRIES; t++ ) {
+        magma_index_t seed = ( t == 0 ) ?
+                magma_cgraph_peripheral( *cur, 0, level ) :
+                (magma_index_t) ( ( t * (magma_int_t) cur->n ) / ND_TRIES );
+        magma_cgraph_grow( *cur, seed, trial );
+        magma_cgraph_refine( *cur, trial );
+        magma_int_t cut = magma_cgraph_cut( *cur, trial );
+        if ( best < 0 || cut < best ) {
+            best = cut;
+            part = trial;
+        }
+    }
+
+    // project back and refine on every level
+    for( magma_int_t l = (magma_int_t) coarse.size() - 1; l >= 0; l-- ) {
+        const magma_cgraph &F = ( l == 0 ) ? G : coarse[l-1];
+        trial.resize( F.n );
+        for( magma_int_t u=0; u < F.n; u++ ) {
+            trial[u] = part[ cmap[l][u] ];
+        }
+        part.swap( trial );
+        magma_cgraph_refine( F, part );
+    }
+}
+
+
+/*******************************************************************************
+    Turns the edge separator of a bisection into a vertex separator
+    (part 2): a greedy vertex cover of the cut edges, boundary vertices
+    with many cut edges first. Separator vertices that are adjacent to
+    only one part are moved into it.
+*/
+static void
+magma_cgraph_separator(
+    const magma_cgraph &G,
+    std::vector< magma_index_t > &part )
+{
+    std::vector< magma_index_t > bnd, cdeg( G.n, 0 );
+
+    for( magma_int_t u=0; u < G.n; u++ ) {
+        for( magma_int_t k=G.xadj[u]; k < G.xadj[u+1]; k++ ) {
+            if ( part[ G.adj[k] ] != part[u] ) {
+                cdeg[u]++;
+            }
+        }
+        if ( cdeg[u] > 0 ) {
+            bnd.push_back( u );
+        }
+    }
+    std::sort( bnd.begin(), bnd.end(),
+        [&cdeg]( magma_index_t a, magma_index_t b ) {
+            return cdeg[a] > cdeg[b] || ( cdeg[a] == cdeg[b] && a < b );
+        });
+    for( magma_int_t i=0; i < (magma_int_t) bnd.size(); i++ ) {
+        magma_index_t u = bnd[i];
+        for( magma_int_t k=G.xadj[u]; k < G.xadj[u+1]; k++ ) {
+            magma_index_t v = G.adj[k];
+            if ( part[v] != 2 && part[v] != part[u] ) {
+                part[u] = 2;
+                break;
+            }
+        }
+    }
+    for( magma_int_t i=0; i < (magma_int_t) bnd.size(); i++ ) {
+        magma_index_t u = bnd[i];
+        if ( part[u] != 2 ) {
+            continue;
+        }
+        bool has[2] = { false, false };
+        for( magma_int_t k=G.xadj[u]; k < G.xadj[u+1]; k++ ) {
+            magma_index_t p = part[ G.adj[k] ];
+            if ( p < 2 ) {
+                has[p] = true;
+            }
+        }
+        if ( ! has[1] ) {
+            part[u] = 0;
+        } else if ( ! has[0] ) {
+            part[u] = 1;
+        }
+    }
+}
+
+
+/*******************************************************************************
+    Subgraph of G induced by the vertices u with part[u] == p, vertex i of
+    the subgraph is vertex map[i] of G.
+*/
+static void
+magma_cgraph_extract(
+    const magma_cgraph &G,
+    const std::vector< magma_index_t > &part,
+    magma_index_t p,
+    std::vector< magma_index_t > &local,
+    magma_cgraph *S,
+    std::vector< magma_index_t > &map )
+{
+    map.clear();
+    for( magma_int_t u=0; u < G.n; u++ ) {
+        if ( part[u] == p ) {
+            local[u] = map.size();
+            map.push_back( u );
+        }
+    }
+    S->n = map.size();
+    S->xadj.assign( 1, 0 );
+    S->adj.clear();
+    for( magma_int_t i=0; i < S->n; i++ ) {
+        magma_index_t u = map[i];
+        for( magma_int_t k=G.xadj[u]; k < G.xadj[u+1]; k++ ) {
+            if ( part[ G.adj[k] ] == p ) {
+                S->adj.push_back( local[ G.adj[k] ] );
+            }
+        }
+        S->xadj.push_back( S->adj.size() );
+    }
+    S->ew.assign( S->adj.size(), 1 );
+    S->vw.assign( S->n, 1 );
+}
+
+
+/*******************************************************************************
+    Nested dissection of G. Vertex i of G is vertex gid[i] of the input
+    graph, the G.n entries of perm receive the new order.
+*/
+static void
+magma_cgraph_nd(
+    const magma_cgraph &G,
+    const magma_index_t *gid,
+    magma_index_t *perm )
+{
+    std::vector< magma_index_t > part, local, map[2];
+    magma_cgraph S[2];
+
+    if ( G.n > ND_LEAF ) {
+        magma_cgraph_bisect( G, part );
+        magma_cgraph_separator( G, part );
+        local.resize( G.n );
+        magma_cgraph_extract( G, part, 0, local, &S[0], map[0] );
+        magma_cgraph_extract( G, part, 1, local, &S[1], map[1] );
+    }
+    if ( G.n <= ND_LEAF || S[0].n == 0 || S[1].n == 0 ) {
+        std::vector< magma_index_t > rcm;
+        magma_cgraph_rcm( G, rcm );
+        for( magma_int_t i=0; i < G.n; i++ ) {
+            perm[i] = gid[ rcm[i] ];
+        }
+        return;
+    }
+
+    // separator last
+    magma_int_t n0 = S[0].n, n1 = S[1].n, ns = n0 + n1;
+    for( magma_int_t u=0; u < G.n; u++ ) {
+        if ( part[u] == 2 ) {
+            perm[ns++] = gid[u];
+        }
+    }
+    for( magma_int_t p=0; p < 2; p++ ) {
+        for( magma_int_t i=0; i < S[p].n; i++ ) {
+            map[p][i] = gid[ map[p][i] ];
+        }
+    }
+    part.clear();
+    local.clear();
+
+    const magma_cgraph *S0 = &S[0], *S1 = &S[1];
+    const magma_index_t *g0 = map[0].data(), *g1 = map[1].data();
+    magma_index_t *p0 = perm, *p1 = perm + n0;
+    #pragma omp task if( n0 > ND_TASK ) firstprivate( S0, g0, p0 )
+    magma_cgraph_nd( *S0, g0, p0 );
+    #pragma omp task if( n1 > ND_TASK ) firstprivate( S1, g1, p1 )
+    magma_cgraph_nd( *S1, g1, p1 );
+    #pragma omp taskwait
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes a fill- or bandwidth-reducing symmetric ordering of A, based on
+    the sparsity pattern of A + A^T:
+
+    Magma_RCM       reverse Cuthill-McKee, reduces the bandwidth and profile
+    Magma_ND        multilevel nested dissection, reduces the fill of
+                    incomplete and complete factorizations
+    Magma_NOREORDER identity
+
+    The permutation maps new to old indices, the reordered matrix is
+    B(i,j) = A(perm[i],perm[j]), see magma_cmpermute.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                square sparse matrix in any format and memory location
+
+    @param[in]
+    order       magma_reorder_t
+                ordering type
+
+    @param[out]
+    perm        magma_index_t**
+                permutation of length A.num_rows, allocated on the CPU,
+                free with magma_free_cpu
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cmreorder(
+    magma_c_matrix A,
+    magma_reorder_t order,
+    magma_index_t **perm,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_c_matrix hA={Magma_CSR}, CSRA={Magma_CSR};
+    magma_cgraph G;
+    std::vector< magma_index_t > p, gid;
+
+    *perm = NULL;
+    if ( A.num_rows != A.num_cols ) {
+        printf("%%error: reordering needs a square matrix.\n");
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+    CHECK( magma_index_malloc_cpu( perm, A.num_rows ));
+
+    if ( order == Magma_NOREORDER ) {
+        for( magma_int_t i=0; i < A.num_rows; i++ ) {
+            (*perm)[i] = i;
+        }
+        goto cleanup;
+    }
+    if ( order != Magma_RCM && order != Magma_ND ) {
+        printf("%%error: ordering not supported.\n");
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
+    CHECK( magma_cmtransfer( A, &hA, A.memory_location, Magma_CPU, queue ));
+    CHECK( magma_cmconvert( hA, &CSRA, hA.storage_type, Magma_CSR, queue ));
+    magma_cgraph_create( CSRA, &G );
+
+    if ( order == Magma_RCM ) {
+        magma_cgraph_rcm( G, p );
+        std::copy( p.begin(), p.end(), *perm );
+    } else {
+        gid.resize( G.n );
+        for( magma_int_t i=0; i < G.n; i++ ) {
+            gid[i] = i;
+        }
+        #pragma omp parallel
+        #pragma omp single
+        magma_cgraph_nd( G, gid.data(), *perm );
+    }
+
+cleanup:
+    if ( info != 0 ) {
+        magma_free_cpu( *perm );
+        *perm = NULL;
+    }
+    magma_cmfree( &hA, queue );
+    magma_cmfree( &CSRA, queue );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Applies a symmetric permutation to a square matrix:
+
+    B(i,j) = A(perm[i],perm[j]),   i.e. B = P A P^T.
+
+    B has the storage format and memory location of A, the column indices
+    of every row are sorted.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                square sparse matrix
+
+    @param[in]
+    perm        const magma_index_t*
+                permutation on the CPU, new to old, see magma_cmreorder
+
+    @param[out]
+    B           magma_c_matrix*
+                permuted matrix
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cmpermute(
+    magma_c_matrix A,
+    const magma_index_t *perm,
+    magma_c_matrix *B,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_index_t *iperm = NULL;
+    magma_c_matrix hA={Magma_CSR}, CSRA={Magma_CSR}, CSRB={Magma_CSR};
+    magma_int_t n = A.num_rows;
+
+    if ( A.num_rows != A.num_cols ) {
+        printf("%%error: symmetric permutation needs a square matrix.\n");
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
+    if ( A.memory_location == Magma_CPU && A.storage_type == Magma_CSR ) {
+        CHECK( magma_index_malloc_cpu( &iperm, n ));
+        for( magma_int_t i=0; i < n; i++ ) {
+            iperm[ perm[i] ] = i;
+        }
+
+        magma_cmfree( B, queue );
+        B->ownership = MagmaTrue;
+        B->storage_type = Magma_CSR;
+        B->memory_location = Magma_CPU;
+        B->num_rows = n;
+        B->num_cols = n;
+        B->nnz = A.nnz;
+        B->true_nnz = A.true_nnz;
+        CHECK( magma_index_malloc_cpu( &B->row, n+1 ));
+        CHECK( magma_index_malloc_cpu( &B->col, A.nnz ));
+        CHECK( magma_cmalloc_cpu( &B->val, A.nnz ));
+
+        B->row[0] = 0;
+        for( magma_int_t i=0; i < n; i++ ) {
+            B->row[i+1] = B->row[i] + A.row[ perm[i]+1 ] - A.row[ perm[i] ];
+        }
+        #pragma omp parallel for schedule(dynamic, 256)
+        for( magma_int_t i=0; i < n; i++ ) {
+            magma_index_t k = B->row[i];
+            for( magma_int_t j=A.row[ perm[i] ]; j < A.row[ perm[i]+1 ]; j++ ) {
+                B->col[k] = iperm[ A.col[j] ];
+                B->val[k] = A.val[j];
+                k++;
+            }
+        }
+        CHECK( magma_ccsr_sort_rows( n, B->row, B->col, B->val, queue ));
+    }
+    else {
+        CHECK( magma_cmtransfer( A, &hA, A.memory_location, Magma_CPU, queue ));
+        CHECK( magma_cmconvert( hA, &CSRA, hA.storage_type, Magma_CSR, queue ));
+
+        CHECK( magma_cmpermute( CSRA, perm, &CSRB, queue ));
+
+        magma_cmfree( &hA, queue );
+        hA.blocksize = A.blocksize;
+        hA.alignment = A.alignment;
+        CHECK( magma_cmconvert( CSRB, &hA, Magma_CSR, A.storage_type, queue ));
+        CHECK( magma_cmtransfer( hA, B, Magma_CPU, A.memory_location, queue ));
+    }
+
+cleanup:
+    if ( info != 0 ) {
+        magma_cmfree( B, queue );
+    }
+    magma_free_cpu( iperm );
+    magma_cmfree( &hA, queue );
+    magma_cmfree( &CSRA, queue );
+    magma_cmfree( &CSRB, queue );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Permutes a vector into the order of a reordered system (gather):
+
+    y[i] = x[perm[i]],   i.e. y = P x.
+
+    Use it to map a right-hand side or initial guess to B = P A P^T.
+    x may have several columns, which are permuted independently.
+
+    Arguments
+    ---------
+
+    @param[in]
+    x           magma_c_matrix
+                dense vector in CPU or device memory
+
+    @param[in]
+    perm        const magma_index_t*
+                permutation on the CPU, new to old, see magma_cmreorder
+
+    @param[out]
+    y           magma_c_matrix*
+                permuted vector in the memory location of x, may be &x
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cvpermute(
+    magma_c_matrix x,
+    const magma_index_t *perm,
+    magma_c_matrix *y,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_c_matrix hx={Magma_CSR}, hy={Magma_CSR};
+    magma_int_t n = x.num_rows;
+
+    CHECK( magma_cmtransfer( x, &hx, x.memory_location, Magma_CPU, queue ));
+    CHECK( magma_cvinit( &hy, Magma_CPU, x.num_rows, x.num_cols, MAGMA_C_ZERO, queue ));
+    for( magma_int_t c=0; c < x.num_cols; c++ ) {
+        #pragma omp parallel for schedule(static)
+        for( magma_int_t i=0; i < n; i++ ) {
+            hy.val[ c*n + i ] = hx.val[ c*n + perm[i] ];
+        }
+    }
+    magma_cmfree( y, queue );
+    CHECK( magma_cmtransfer( hy, y, Magma_CPU, x.memory_location, queue ));
+
+cleanup:
+    magma_cmfree( &hx, queue );
+    magma_cmfree( &hy, queue );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Permutes a vector from the order of a reordered system back to the
+    original order (scatter):
+
+    y[perm[i]] = x[i],   i.e. y = P^T x.
+
+    Use it to map the solution of B = P A P^T back to A.
+    x may have several columns, which are permuted independently.
+
+    Arguments
+    ---------
+
+    @param[in]
+    x           magma_c_matrix
+                dense vector in CPU or device memory
+
+    @param[in]
+    perm        const magma_index_t*
+                permutation on the CPU, new to old, see magma_cmreorder
+
+    @param[out]
+    y           magma_c_matrix*
+                permuted vector in the memory location of x, may be &x
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cvpermute_inverse(
+    magma_c_matrix x,
+    const magma_index_t *perm,
+    magma_c_matrix *y,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_c_matrix hx={Magma_CSR}, hy={Magma_CSR};
+    magma_int_t n = x.num_rows;
+
+    CHECK( magma_cmtransfer( x, &hx, x.memory_location, Magma_CPU, queue ));
+    CHECK( magma_cvinit( &hy, Magma_CPU, x.num_rows, x.num_cols, MAGMA_C_ZERO, queue ));
+    for( magma_int_t c=0; c < x.num_cols; c++ ) {
+        #pragma omp parallel for schedule(static)
+        for( magma_int_t i=0; i < n; i++ ) {
+            hy.val[ c*n + perm[i] ] = hx.val[ c*n + i ];
+        }
+    }
+    magma_cmfree( y, queue );
+    CHECK( magma_cmtransfer( hy, y, Magma_CPU, x.memory_location, queue ));
+
+cleanup:
+    magma_cmfree( &hx, queue );
+    magma_cmfree( &hy, queue );
+    return info;
+}
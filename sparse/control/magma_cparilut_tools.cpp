@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/control/magma_zparilut_tools.cpp, normal z -> c, Wed Feb 22 15:21:50 2023
+       @generated from sparse/control/magma_zparilut_tools.cpp, normal z -> c, Sun Oct 18 06:50:54 2026
        @author Hartwig Anzt
 
 */
@@ -87,7 +87,7 @@ magma_cparilut_thrsrm(
                         A->col[i] = -1; // cheaper than val  
                         rm++;
                     } else {
-                        ;
+                        el++; // the diagonal is kept
                     }
                 } else {
                     el++;    
@@ -109,7 +109,7 @@ magma_cparilut_thrsrm(
                         A->col[i] = -1; // cheaper than val  
                         rm++;
                     } else {
-                        ;
+                        el++; // the diagonal is kept
                     }
                 } else {
                     el++;    
@@ -2883,7 +2883,8 @@ magma_cparilut_candidates(
     magma_int_t info = 0;
     magma_index_t *insertedL;
     magma_index_t *insertedU;
-    float thrs = 1e-8;
+    magma_index_t *marker = NULL;
+    magma_c_matrix LU={Magma_CSR};
     
     magma_int_t orig = 1; // the pattern L0 and U0 is considered
     magma_int_t existing = 0; // existing elements are also considered
@@ -2892,10 +2893,8 @@ magma_cparilut_candidates(
     magma_int_t num_threads;
     
 #ifdef _OPENMP
-    #pragma omp parallel
-    {
-        num_threads = omp_get_max_threads();
-    }
+    // outside of a parallel region, this bounds the teams below
+    num_threads = omp_get_max_threads();
 #else
     num_threads = 1;
 #endif
@@ -2925,6 +2924,16 @@ magma_cparilut_candidates(
     U_new->storage_type = Magma_CSR;
     U_new->memory_location = Magma_CPU;
     
+    // pattern of the ILU(1) fill-in and markers for the existing entries
+    if( ilufill == 1 ){
+        CHECK( magma_c_spmm_symbolic_cpu( L, U, &LU, queue ));
+        CHECK( magma_index_malloc_cpu( &marker, num_threads * L.num_cols ));
+        #pragma omp parallel for
+        for( magma_int_t i=0; i<num_threads * L.num_cols; i++ ){
+            marker[i] = -1;
+        }
+    }
+    
     // go over the original matrix - this is the only way to allow elements to come back...
     if( orig == 1 ){
        #pragma omp parallel for
@@ -3009,66 +3018,45 @@ magma_cparilut_candidates(
     } // end original
     if( ilufill == 1 ){
         // how to determine candidates:
-        // for each node i, look at any "intermediate" neighbor nodes numbered
-        // less, and then see if this neighbor has another neighbor j numbered
-        // more than the intermediate; if so, fill in is (i,j) if it is not
-        // already nonzero
-        #pragma omp parallel for
-        for( magma_index_t row=0; row<L.num_rows; row++){
-            magma_int_t numaddrowL = 0, numaddrowU = 0;
-            // loop first element over row - only for elements smaller the diagonal
-            for( magma_index_t el1=L.row[row]; el1<L.row[row+1]-1; el1++ ){
-                magma_index_t col1 = L.col[ el1 ];
-                // now check the upper triangular
-                // second loop first element over row - only for elements larger the intermediate
-                for( magma_index_t el2 = U.row[ col1 ]+1; el2 < U.row[ col1+1 ]; el2++ ){
-                    magma_index_t col2 = U.col[ el2 ];
-                    magma_index_t cand_row = row;
-                    magma_index_t cand_col = col2;
-                    // check whether this element already exists
-                    // first case: part of L
-                    if( cand_col < row ){
-                        // check whether this element already exists in L
-                        magma_int_t exist = 0;
-                        if( existing == 0 ){
-                            for(magma_index_t k=L.row[cand_row]; k<L.row[cand_row+1]; k++ ){
-                                if( L.col[ k ] == cand_col ){
-                                        exist = 1;
-                                        break;
-                                }
-                            }
-                        }
-                        // if it does not exist, increase counter for this location
-                        // use the entry one further down to allow for parallel insertion
-                        if( exist == 0 ){
-                            //printf("checked row: %d this element does not yet exist in L: (%d,%d)\n", cand_row, cand_col);
+        // the fill-in of ILU(1) is the pattern of L * U, the candidates are
+        // the entries of this product not yet part of L and U (or the
+        // original pattern, which was added above)
+        // at most num_threads markers were allocated
+        #pragma omp parallel num_threads( num_threads )
+        {
+#ifdef _OPENMP
+            magma_index_t *mark = marker + omp_get_thread_num() * L.num_cols;
+#else
+            magma_index_t *mark = marker;
+#endif
+            #pragma omp for schedule(dynamic, 64)
+            for( magma_index_t row=0; row<L.num_rows; row++){
+                magma_int_t numaddrowL = 0, numaddrowU = 0;
+                for( magma_index_t k=L.row[row]; k<L.row[row+1]; k++ ){
+                    mark[ L.col[k] ] = row;
+                }
+                for( magma_index_t k=U.row[row]; k<U.row[row+1]; k++ ){
+                    mark[ U.col[k] ] = row;
+                }
+                for( magma_index_t k=L0.row[row]; k<L0.row[row+1]; k++ ){
+                    mark[ L0.col[k] ] = row;
+                }
+                for( magma_index_t k=U0.row[row]; k<U0.row[row+1]; k++ ){
+                    mark[ U0.col[k] ] = row;
+                }
+                for( magma_index_t el=LU.row[row]; el<LU.row[row+1]; el++ ){
+                    magma_index_t cand_col = LU.col[ el ];
+                    if( mark[ cand_col ] != row ){
+                        if( cand_col < row ){
                             numaddrowL++;
-                            //numaddL[ row+1 ]++;
-                        }
-                    } else {
-                        // check whether this element already exists in U
-                        magma_int_t exist = 0;
-                        if( existing == 0 ){
-                            for(magma_index_t k=U.row[cand_row]; k<U.row[cand_row+1]; k++ ){
-                                if( U.col[ k ] == cand_col ){
-                                        exist = 1;
-                                        break;
-                                }
-                            }
-                        }
-                        // if it does not exist, increase counter for this location
-                        // use the entry one further down to allow for parallel insertion
-                        if( exist == 0 ){
-                            //printf("checked row: %d this element does not yet exist in L: (%d,%d)\n", cand_row, cand_col);
+                        } else {
                             numaddrowU++;
-                            //numaddL[ row+1 ]++;
                         }
                     }
                 }
-    
+                U_new->row[ row+1 ] = U_new->row[ row+1 ]+numaddrowU;
+                L_new->row[ row+1 ] = L_new->row[ row+1 ]+numaddrowL;
             }
-            U_new->row[ row+1 ] = U_new->row[ row+1 ]+numaddrowU;
-            L_new->row[ row+1 ] = L_new->row[ row+1 ]+numaddrowL;
         }
     } // end ilu-fill
     //end = magma_sync_wtime( queue ); printf("llop 1.2 : %.2e\n", end-start);
@@ -3246,112 +3234,57 @@ magma_cparilut_candidates(
     } // end original
     
     if( ilufill==1 ){
-        #pragma omp parallel for
-        for( magma_index_t row=0; row<L.num_rows; row++){
-            magma_int_t laddL = 0;
-            magma_int_t laddU = 0;
-            magma_int_t offsetL = L_new->row[row] + insertedL[row];
-            magma_int_t offsetU = U_new->row[row] + insertedU[row];
-            // loop first element over row - only for elements smaller the diagonal
-            for( magma_index_t el1=L.row[row]; el1<L.row[row+1]-1; el1++ ){
-                
-                magma_index_t col1 = L.col[ el1 ];
-                // now check the upper triangular
-                // second loop first element over row - only for elements larger the intermediate
-                for( magma_index_t el2 = U.row[ col1 ]+1; el2 < U.row[ col1+1 ]; el2++ ){
-                    magma_index_t col2 = U.col[ el2 ];
-                    magma_index_t cand_row = row;
-                    magma_index_t cand_col = col2;
-                    //$########### we now have the candidate cand_row cand_col
-                    
-                    
-                    // check whether this element already exists
-                    // first case: part of L
-                    if( cand_col < row ){
-                        magma_int_t exist = 0;
-                        if( existing == 0 ){
-                            for(magma_index_t k=L.row[cand_row]; k<L.row[cand_row+1]; k++ ){
-                                if( L.col[ k ] == cand_col ){
-                                        exist = 1;
-                                        break;
-                                }
-                            }
-                        }
-    #ifdef AVOID_DUPLICATES
-                        for( magma_int_t k=L_new->row[cand_row]; k<L_new->row[cand_row+1]; k++){
-                            if( L_new->col[ k ] == cand_col ){
-                                // element included in LU and nonzero
-                                exist = 1;
-                                break;
-                            }
-                        }
-    #endif
-                        // if it does not exist, increase counter for this location
-                        // use the entry one further down to allow for parallel insertion
-                        if( exist == 0 ){
-                            //  printf("---------------->>>  candidate in L at (%d, %d)\n", cand_row, cand_col);
-                            //add in the next location for this row
-                            // L_new->val[ numaddL[row] + laddL ] =  MAGMA_C_MAKE(1e-14,0.0);
-                            L_new->rowidx[ offsetL + laddL ] = cand_row;
+        // at most num_threads markers were allocated
+        #pragma omp parallel num_threads( num_threads )
+        {
+#ifdef _OPENMP
+            magma_index_t *mark = marker + omp_get_thread_num() * L.num_cols;
+#else
+            magma_index_t *mark = marker;
+#endif
+            // the markers of the counting phase are reused with row+n
+            #pragma omp for schedule(dynamic, 64)
+            for( magma_index_t row=0; row<L.num_rows; row++){
+                magma_index_t stamp = row + L.num_rows;
+                magma_int_t laddL = 0;
+                magma_int_t offsetL = L_new->row[row] + insertedL[row];
+                magma_int_t laddU = 0;
+                magma_int_t offsetU = U_new->row[row] + insertedU[row];
+                for( magma_index_t k=L.row[row]; k<L.row[row+1]; k++ ){
+                    mark[ L.col[k] ] = stamp;
+                }
+                for( magma_index_t k=U.row[row]; k<U.row[row+1]; k++ ){
+                    mark[ U.col[k] ] = stamp;
+                }
+                for( magma_index_t k=L0.row[row]; k<L0.row[row+1]; k++ ){
+                    mark[ L0.col[k] ] = stamp;
+                }
+                for( magma_index_t k=U0.row[row]; k<U0.row[row+1]; k++ ){
+                    mark[ U0.col[k] ] = stamp;
+                }
+                for( magma_index_t el=LU.row[row]; el<LU.row[row+1]; el++ ){
+                    magma_index_t cand_col = LU.col[ el ];
+                    if( mark[ cand_col ] != stamp ){
+                        if( cand_col < row ){
+                            L_new->rowidx[ offsetL + laddL ] = row;
                             L_new->col[ offsetL + laddL ] = cand_col;
                             L_new->val[ offsetL + laddL ] = MAGMA_C_ONE;
-                            // L_new->list[ numaddL[row] + laddL ] = -1;
-                            // L_new->row[ numaddL[row] + laddL ] = -1;
                             laddL++;
-                        }
-                    } else {
-                        // check whether this element already exists in U
-                        magma_int_t exist = 0;
-                        if( existing == 0 ){
-                            for(magma_index_t k=U.row[cand_row]; k<U.row[cand_row+1]; k++ ){
-                                if( U.col[ k ] == cand_col ){
-                                        exist = 1;
-                                        break;
-                                }
-                            }
-                        }
-    #ifdef AVOID_DUPLICATES
-                        for( magma_int_t k=U_new->row[cand_row]; k<U_new->row[cand_row+1]; k++){
-                            if( U_new->col[ k ] == cand_col ){
-                                // element included in LU and nonzero
-                                exist = 1;
-                                break;
-                            }
-                        }
-    #endif
-                        // if it does not exist, increase counter for this location
-                        // use the entry one further down to allow for parallel insertion
-                        if( exist == 0 ){
-                            //  printf("---------------->>>  candidate in U at (%d, %d) stored in %d\n", cand_row, cand_col, numaddU[row] + laddU);
-                            //add in the next location for this row
-                            // U_new->val[ numaddU[row] + laddU ] =  MAGMA_C_MAKE(1e-14,0.0);
-                            U_new->rowidx[ offsetU + laddU ] = cand_row;
+                        } else {
+                            U_new->rowidx[ offsetU + laddU ] = row;
                             U_new->col[ offsetU + laddU ] = cand_col;
                             U_new->val[ offsetU + laddU ] = MAGMA_C_ONE;
-                            // U_new->list[ numaddU[row] + laddU ] = -1;
-                            // U_new->row[ numaddU[row] + laddU ] = -1;
                             laddU++;
-                            //if( cand_row > cand_col )
-                             //   printf("inserted illegal candidate in case 4: (%d,%d) coming from (%d,%d)->(%d,%d)\n", cand_row, cand_col, row, col1, U.col[U.row[ cand_col ]], UR.col[ el2 ]);
                         }
                     }
                 }
             }
-            //insertedU[row] = insertedU[row] + laddU;
-            //insertedL[row] = insertedL[row] + laddL;
         }
     } //end ilufill
-    
-#ifdef AVOID_DUPLICATES
-        // #####################################################################
-        
-        CHECK( magma_cparilut_thrsrm( 1, L_new, &thrs, queue ) );
-        CHECK( magma_cparilut_thrsrm( 1, U_new, &thrs, queue ) );
-
-        // #####################################################################
-#endif
 
 cleanup:
+    magma_free_cpu( marker );
+    magma_cmfree( &LU, queue );
     magma_free_cpu( insertedL );
     magma_free_cpu( insertedU );
     return info;
@@ -4482,56 +4415,11 @@ magma_cparilut_set_approx_thrs(
     magma_queue_t queue )
 {
     magma_int_t info = 0;
-    
-    magma_int_t sample_size =  8192;
-    
-    magmaFloatComplex element;
-    magmaFloatComplex *val=NULL;
-    const magma_int_t incy = 1;
-    const magma_int_t incx = (int) (LU->nnz)/(sample_size);
-    magma_int_t loc_nnz;
-    float ratio;
-    magma_int_t loc_num_rm;
-    magma_int_t num_threads=1;
-    magmaFloatComplex *elements = NULL;
-    magma_int_t lsize;
-    magma_int_t lnum_rm;
-    magmaFloatComplex *lval;
-
-#ifdef _OPENMP
-    #pragma omp parallel
-    {
-        num_threads = omp_get_max_threads();
-    }
-#else
-    num_threads = 1;
-#endif
-     num_threads = 1;
-    loc_nnz = (int) LU->nnz/incx;
-    ratio = ((float)num_rm)/((float)LU->nnz);
-    loc_num_rm = (int) ((float)ratio*(float)loc_nnz);
-    CHECK( magma_cmalloc_cpu( &val, loc_nnz ));
-    blasf77_ccopy(&loc_nnz, LU->val, &incx, val, &incy );
-       
-    lsize = loc_nnz/num_threads;
-    lnum_rm = loc_num_rm/num_threads;
-
-    lval = val;
-    // compare with random select
-    if( order == 0 ){
-        magma_cselectrandom( lval, lsize, lnum_rm, queue );
-        element = (lval[lnum_rm]);
-    } else {
-         magma_cselectrandom( lval, lsize, lsize-lnum_rm, queue );
-        element = (lval[lsize-lnum_rm]);  
-    }
-               
+    magma_int_t rank = (order == 0 ? num_rm : LU->nnz - num_rm);
 
-    *thrs = MAGMA_C_ABS(element);
+    CHECK( magma_csampleselect_approx_cpu( LU->nnz, rank, LU->val, thrs, queue ));
 
 cleanup:
-    magma_free_cpu( val );
-    magma_free_cpu( elements );
     return info;
 }
 
@@ -4577,24 +4465,12 @@ magma_cparilut_set_thrs_randomselect(
     magma_queue_t queue )
 {
     magma_int_t info = 0;
-    
-    magma_int_t size =  LU->nnz;
-    const magma_int_t incx = 1;
-    // copy as we may change the elements
-    magmaFloatComplex *val=NULL;
-    CHECK( magma_cmalloc_cpu( &val, size ));
-    assert( size > num_rm );
-    blasf77_ccopy(&size, LU->val, &incx, val, &incx );
-    if( order == 0 ){
-        magma_cselectrandom( val, size, num_rm, queue );
-        *thrs = MAGMA_C_ABS(val[num_rm]);
-    } else {
-         magma_cselectrandom( val, size, size-num_rm, queue );
-        *thrs = MAGMA_C_ABS(val[size-num_rm]);  
-    }
+    magma_int_t rank = (order == 0 ? num_rm : LU->nnz - num_rm);
+
+    assert( LU->nnz > num_rm );
+    CHECK( magma_csampleselect_cpu( LU->nnz, rank, LU->val, thrs, queue ));
 
 cleanup:
-    magma_free_cpu( val );
     return info;
 }
 
@@ -4645,24 +4521,12 @@ magma_cparilut_set_thrs_L_scaled(
     magma_queue_t queue )
 {
     magma_int_t info = 0;
-    
-    magma_int_t size =  L->nnz;
-    const magma_int_t incx = 1;
-    // copy as we may change the elements
-    magmaFloatComplex *val=NULL;
-    CHECK( magma_cmalloc_cpu( &val, size ));
-    assert( size > num_rm );
-    blasf77_ccopy(&size, L->val, &incx, val, &incx );
-    if( order == 0 ){
-        magma_cselectrandom( val, size, num_rm, queue );
-        *thrs = MAGMA_C_ABS(val[num_rm]);
-    } else {
-         magma_cselectrandom( val, size, size-num_rm, queue );
-        *thrs = MAGMA_C_ABS(val[size-num_rm]);  
-    }
+    magma_int_t rank = (order == 0 ? num_rm : L->nnz - num_rm);
+
+    assert( L->nnz > num_rm );
+    CHECK( magma_csampleselect_cpu( L->nnz, rank, L->val, thrs, queue ));
 
 cleanup:
-    magma_free_cpu( val );
     return info;
 }
 
@@ -4709,43 +4573,11 @@ magma_cparilut_set_thrs_randomselect_approx2(
     magma_queue_t queue )
 {
     magma_int_t info = 0;
-    
-    magma_int_t size =  LU->nnz;
-    const magma_int_t incx = 1;
-    magma_int_t incy = 1;
-    // magma_int_t nz_copy = LU->nnz;
-    // copy as we may change the elements
-    magmaFloatComplex *val=NULL;
-    magma_int_t subset = num_rm *10;
-    if(LU->nnz <=subset){
-        CHECK( magma_cmalloc_cpu( &val, size ));
-        assert( size > num_rm );
-        blasf77_ccopy(&size, LU->val, &incx, val, &incx );
-        if( order == 0 ){
-            magma_cselectrandom( val, size, num_rm, queue );
-            *thrs = MAGMA_C_ABS(val[num_rm]);
-        } else {
-             magma_cselectrandom( val, size, size-num_rm, queue );
-            *thrs = MAGMA_C_ABS(val[size-num_rm]);  
-        }
-    } else {
-        incy = LU->nnz/subset;
-        size = subset;
-        magma_int_t num_rm_loc = 10;
-        assert( size > num_rm_loc );
-        CHECK( magma_cmalloc_cpu( &val, size ));
-        blasf77_ccopy(&size, LU->val, &incy, val, &incx );
-        if( order == 0 ){
-            magma_cselectrandom( val, size, num_rm_loc, queue );
-            *thrs = MAGMA_C_ABS(val[num_rm_loc]);
-        } else {
-             magma_cselectrandom( val, size, size-num_rm_loc, queue );
-            *thrs = MAGMA_C_ABS(val[size-num_rm_loc]);  
-        }
-    }
+    magma_int_t rank = (order == 0 ? num_rm : LU->nnz - num_rm);
+
+    CHECK( magma_csampleselect_approx_cpu( LU->nnz, rank, LU->val, thrs, queue ));
 
 cleanup:
-    magma_free_cpu( val );
     return info;
 }
 
@@ -4789,72 +4621,12 @@ magma_cparilut_set_thrs_randomselect_approx(
     magma_queue_t queue )
 {
     magma_int_t info = 0;
-    
-    magma_int_t size =  LU->nnz;
-    const magma_int_t incx = 1;
-    //magma_int_t incy = 1;
-    //magma_int_t nz_copy = LU->nnz;
-    magma_int_t num_threads = 1;
-    magma_int_t el_per_block;
-    //magma_int_t num_rm_loc;
-    magmaFloatComplex *dthrs;
-    magmaFloatComplex *val;
-    
+    magma_int_t rank = (order == 0 ? num_rm : LU->nnz - num_rm);
+
+    assert( LU->nnz > num_rm );
+    CHECK( magma_csampleselect_approx_cpu( LU->nnz, rank, LU->val, thrs, queue ));
 
-    if( LU->nnz <= 680){
-       CHECK( magma_cparilut_set_thrs_randomselect(
-           num_rm,
-           LU,
-           order,
-           thrs,
-           queue ) );
-    } else {
-        CHECK( magma_cmalloc_cpu( &val, size ));
-        blasf77_ccopy(&size, LU->val, &incx, val, &incx );
-        assert( size > num_rm );
-#ifdef _OPENMP
-    #pragma omp parallel
-    {
-        num_threads = omp_get_max_threads();
-    }
-#else
-    num_threads = 1;
-#endif
-        num_threads = 272;
-        CHECK( magma_cmalloc_cpu( &dthrs, num_threads ));
-        
-        
-        el_per_block = magma_ceildiv( LU->nnz, num_threads );
-        
-        #pragma omp parallel for
-        for( magma_int_t i=0; i<num_threads; i++ ){
-            magma_int_t start = min(i*el_per_block, size);
-            magma_int_t end = min((i+1)*el_per_block,LU->nnz);
-            magma_int_t loc_nz = end-start;
-            magma_int_t loc_rm = (int) (num_rm)/num_threads;
-            if( i == num_threads-1){
-                loc_rm = (int) (loc_nz * num_rm)/size;
-            }
-            if( loc_nz > loc_rm ){
-            if( order == 0 ){
-                magma_cselectrandom( val+start, loc_nz, loc_rm, queue );
-                dthrs[i] = val[start+loc_rm];
-            } else {
-                 magma_cselectrandom( val+start, loc_nz, loc_nz-loc_rm, queue );
-                dthrs[i] = val[start+loc_nz-loc_rm];  
-            }
-        }
-            
-        }
-        
-        // compute the median
-        magma_cselectrandom( dthrs, num_threads, (num_threads+1)/2, queue);
-        
-        *thrs = MAGMA_C_ABS(dthrs[(num_threads+1)/2]);
-    }
 cleanup:
-    magma_free_cpu( val );
-    magma_free_cpu( dthrs );
     return info;
 }
 
@@ -4903,19 +4675,14 @@ magma_cparilut_set_thrs_randomselect_factors(
     
     magma_int_t size =  L->nnz+U->nnz;
     const magma_int_t incx = 1;
-    // copy as we may change the elements
+    magma_int_t rank = (order == 0 ? num_rm : size - num_rm);
+    // L and U in one array
     magmaFloatComplex *val=NULL;
     CHECK( magma_cmalloc_cpu( &val, size ));
     assert( size > num_rm );
     blasf77_ccopy(&L->nnz, L->val, &incx, val, &incx );
     blasf77_ccopy(&U->nnz, U->val, &incx, val+L->nnz, &incx );
-    if( order == 0 ){
-        magma_cselectrandom( val, size, num_rm, queue );
-        *thrs = MAGMA_C_ABS(val[num_rm]);
-    } else {
-         magma_cselectrandom( val, size, size-num_rm, queue );
-        *thrs = MAGMA_C_ABS(val[size-num_rm]);  
-    }
+    CHECK( magma_csampleselect_cpu( size, rank, val, thrs, queue ));
 
 cleanup:
     magma_free_cpu( val );
@@ -4964,67 +4731,13 @@ magma_cparilut_set_exact_thrs(
     magma_queue_t queue )
 {
     magma_int_t info = 0;
-    magmaFloatComplex element;
-    magmaFloatComplex *val=NULL;
-    const magma_int_t incy = 1;
-    const magma_int_t incx = 1;
-    magma_int_t loc_nnz;
-    float ratio;
-    magma_int_t loc_num_rm;
-    magma_int_t num_threads=1;
-    magmaFloatComplex *elements = NULL;
+    float element = 0.0;
+    magma_int_t rank = (order == 0 ? num_rm : LU->nnz - num_rm);
 
-#ifdef _OPENMP
-    #pragma omp parallel
-    {
-        num_threads = omp_get_max_threads();
-    }
-#else
-    num_threads = 1;
-#endif
-    // two options: either there are enough candidates such that we can use
-    // a parallel first step of order-statistics, or not...
-    
-    ratio = ((float)num_rm)/((float)LU->nnz);
-    loc_num_rm = (int) ((float)ratio*(float)loc_nnz);
-    loc_num_rm = num_rm;
-    CHECK( magma_cmalloc_cpu( &val, loc_nnz ));
-    CHECK( magma_cmalloc_cpu( &elements, num_threads ));
-    
-    blasf77_ccopy(&loc_nnz, LU->val, &incx, val, &incy );
-    // first step: every thread sorts a chunk of the array
-    // extract the num_rm elements in this chunk
-    // this only works if num_rm > loc_nnz / num_threads
-    if( loc_nnz / num_threads > loc_num_rm ){
-        #pragma omp parallel
-        {
-    #ifdef _OPENMP
-    magma_int_t id = omp_get_thread_num();
-#else
-    magma_int_t id = 0;
-#endif
-            if(id<num_threads){
-                magma_corderstatistics(
-                    val + id*loc_nnz/num_threads, loc_nnz/num_threads, loc_num_rm, order, &elements[id], queue );
-            }
-        }
-        // Now copy the num_rm left-most elements of every chunk to the beginning of the array.
-        for( magma_int_t i=1; i<num_threads; i++){
-            blasf77_ccopy(&loc_num_rm, val+i*loc_nnz/num_threads, &incy, val+i*loc_num_rm, &incy );
-        }
-        // now we only look at the left num_threads*num_rm elements and use order stats
-        magma_corderstatistics(
-                    val, num_threads*loc_num_rm, loc_num_rm, order, &element, queue );
-    } else {
-        magma_corderstatistics(
-                    val, loc_nnz, loc_num_rm, order, &element, queue );
-    }
-
-    *thrs = element;
+    CHECK( magma_csampleselect_cpu( LU->nnz, rank, LU->val, &element, queue ));
+    *thrs = MAGMA_C_MAKE( element, 0.0 );
 
 cleanup:
-    magma_free_cpu( val );
-    magma_free_cpu( elements );
     return info;
 }
 
@@ -5071,43 +4784,13 @@ magma_cparilut_set_approx_thrs_inc(
     magma_queue_t queue )
 {
     magma_int_t info = 0;
-    magmaFloatComplex element;
-    magmaFloatComplex *val=NULL;
-    const magma_int_t incy = 1;
-    const magma_int_t incx = (int) (LU->nnz)/(1024);
-    magma_int_t loc_nnz;
-    magma_int_t inc = 100;
-    magma_int_t offset = 10;
-    float ratio;
-    magma_int_t loc_num_rm = num_rm;
-    // magma_int_t num_threads=1;
-    magmaFloatComplex *elements = NULL;
-    magma_int_t avg_count = 100;
-    loc_nnz = (int) LU->nnz/incx;
-    ratio = ((float)num_rm)/((float)LU->nnz);
-    loc_num_rm = (int) ((float)ratio*(float)loc_nnz);
-    
-    
-    CHECK( magma_cmalloc_cpu( &elements, avg_count ));
-    
-    CHECK( magma_cmalloc_cpu( &val, loc_nnz ));
-    blasf77_ccopy(&loc_nnz, LU->val, &incx, val, &incy );
-    for( magma_int_t i=1; i<avg_count; i++){
-        magma_corderstatistics_inc(
-                    val + offset*i, loc_nnz - offset*i, loc_num_rm/inc, inc, order, &elements[i], queue );
-    }
-    
-    
-    element = MAGMA_C_ZERO;
-    for( int z=0; z < avg_count; z++){
-        element = element+MAGMA_C_MAKE(MAGMA_C_ABS(elements[z]), 0.0);
-    }
-    element = element/MAGMA_C_MAKE((float)avg_count, 0.0);
-    
-    *thrs = element;
+    float element = 0.0;
+    magma_int_t rank = (order == 0 ? num_rm : LU->nnz - num_rm);
+
+    CHECK( magma_csampleselect_approx_cpu( LU->nnz, rank, LU->val, &element, queue ));
+    *thrs = MAGMA_C_MAKE( element, 0.0 );
+
 cleanup:
-    magma_free_cpu( val );
-    magma_free_cpu( elements );
     return info;
 }
 
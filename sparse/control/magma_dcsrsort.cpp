@@ -0,0 +1,434 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @generated from sparse/control/magma_zcsrsort.cpp, normal z -> d, Sun Oct 18 05:15:30 2026
+       @author Hartwig Anzt
+
+       Segmented sort of the rows of a CSR matrix by column index.
+
+       Every element is sorted as a 64-bit key, the column index in the upper
+       and the position in the row in the lower 32 bits, so the sort is stable
+       and the values are permuted once at the end. The method depends on
+       the row length: a sorting network for short rows, insertion sort for
+       medium rows, and a radix sort on the column index for longer rows.
+       Rows are split among the threads in parts with about the same number
+       of nonzeros. Very long rows are sorted by all threads: each sorts a
+       part, then the parts are merged pairwise, every merge being split
+       among the threads along its merge path.
+*/
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+typedef uint64_t sort_key_t;
+
+const magma_int_t network_size   = 16;        // sorting network up to this
+const magma_int_t insertion_size = 64;        // insertion sort up to this
+const int         radix_bits     = 8;
+const magma_int_t radix_width    = 1 << radix_bits;
+const magma_int_t long_size      = 1 << 16;   // all threads sort longer rows
+const magma_int_t parts_per_thread = 8;       // for load balance
+
+
+/******************************************************************************/
+inline sort_key_t make_key( magma_index_t col, magma_int_t pos )
+{
+    return ((sort_key_t) (uint32_t) col << 32) | (sort_key_t) pos;
+}
+
+inline magma_index_t key_col( sort_key_t key )
+{
+    return (magma_index_t) (uint32_t) (key >> 32);
+}
+
+inline magma_int_t key_pos( sort_key_t key )
+{
+    return (magma_int_t) (key & 0xffffffffull);
+}
+
+
+/******************************************************************************/
+// Bitonic sorting network on P keys, P a power of 2. All compare-exchanges
+// put the smaller key first; P is a template parameter so the network is
+// unrolled into branch-free min/max.
+template< int P >
+void network_sort( sort_key_t *keys )
+{
+    for( int k=2; k <= P; k *= 2 ){
+        for( int i=0; i < P; i++ ){
+            int l = i ^ (k-1);
+            if ( l > i ) {
+                sort_key_t a = keys[ i ], b = keys[ l ];
+                keys[ i ] = min( a, b );
+                keys[ l ] = max( a, b );
+            }
+        }
+        for( int j=k/4; j > 0; j /= 2 ){
+            for( int i=0; i < P; i++ ){
+                int l = i ^ j;
+                if ( l > i ) {
+                    sort_key_t a = keys[ i ], b = keys[ l ];
+                    keys[ i ] = min( a, b );
+                    keys[ l ] = max( a, b );
+                }
+            }
+        }
+    }
+}
+
+
+/******************************************************************************/
+void insertion_sort( sort_key_t *keys, magma_int_t n )
+{
+    for( magma_int_t i=1; i < n; i++ ){
+        sort_key_t key = keys[ i ];
+        magma_int_t j = i;
+        for( ; j > 0 && keys[ j-1 ] > key; j-- ){
+            keys[ j ] = keys[ j-1 ];
+        }
+        keys[ j ] = key;
+    }
+}
+
+
+/******************************************************************************/
+// LSD radix sort of n keys by column index, relative to the smallest one,
+// so only as many digits as the column range needs are sorted.
+// Digits with a single bucket are skipped. tmp has n entries.
+void radix_sort( sort_key_t *keys, magma_int_t n, sort_key_t *tmp )
+{
+    magma_int_t counts[ radix_width ];
+    uint32_t lo = (uint32_t) key_col( keys[ 0 ] ), hi = lo;
+    for( magma_int_t i=1; i < n; i++ ){
+        uint32_t c = (uint32_t) key_col( keys[ i ] );
+        lo = min( lo, c );
+        hi = max( hi, c );
+    }
+    uint32_t range = hi - lo;
+
+    sort_key_t *in = keys, *out = tmp;
+    for( int shift=0; shift < 32 && (range >> shift) != 0; shift += radix_bits ){
+        for( magma_int_t d=0; d < radix_width; d++ ){
+            counts[ d ] = 0;
+        }
+        for( magma_int_t i=0; i < n; i++ ){
+            counts[ (((uint32_t) (in[ i ] >> 32) - lo) >> shift) & (radix_width-1) ]++;
+        }
+        magma_int_t sum = 0, max_count = 0;
+        for( magma_int_t d=0; d < radix_width; d++ ){
+            magma_int_t c = counts[ d ];
+            max_count = max( max_count, c );
+            counts[ d ] = sum;
+            sum += c;
+        }
+        if ( max_count == n ) {
+            continue;
+        }
+        for( magma_int_t i=0; i < n; i++ ){
+            out[ counts[ (((uint32_t) (in[ i ] >> 32) - lo) >> shift) & (radix_width-1) ]++ ] = in[ i ];
+        }
+        std::swap( in, out );
+    }
+    if ( in != keys ) {
+        std::copy( in, in + n, keys );
+    }
+}
+
+
+/******************************************************************************/
+// Sorts one row of length len on the calling thread.
+// keys needs 2*len entries for rows longer than network_size,
+// and vtmp len entries.
+void sort_row(
+    magma_int_t len, magma_index_t *col, double *val,
+    std::vector< sort_key_t >& keys, std::vector< double >& vtmp )
+{
+    // rows are often sorted already, e.g., after a transpose
+    magma_int_t i = 1;
+    while( i < len && col[ i-1 ] <= col[ i ] ) {
+        i++;
+    }
+    if ( i >= len ) {
+        return;
+    }
+
+    sort_key_t net[ network_size ];
+    sort_key_t *k = net;
+    if ( len <= network_size ) {
+        magma_int_t p = 2;
+        while( p < len ) {
+            p *= 2;
+        }
+        for( i=0; i < len; i++ ){
+            net[ i ] = make_key( col[ i ], i );
+        }
+        for( ; i < p; i++ ){
+            net[ i ] = ~(sort_key_t) 0;  // padding, sorts last
+        }
+        switch( p ) {
+            case  2: network_sort<  2 >( net ); break;
+            case  4: network_sort<  4 >( net ); break;
+            case  8: network_sort<  8 >( net ); break;
+            default: network_sort< 16 >( net ); break;
+        }
+    }
+    else {
+        keys.resize( 2*len );
+        k = keys.data();
+        for( i=0; i < len; i++ ){
+            k[ i ] = make_key( col[ i ], i );
+        }
+        if ( len <= insertion_size ) {
+            insertion_sort( k, len );
+        }
+        else {
+            radix_sort( k, len, k + len );
+        }
+    }
+
+    if ( val != NULL ) {
+        vtmp.resize( len );
+        for( i=0; i < len; i++ ){
+            vtmp[ i ] = val[ key_pos( k[ i ] ) ];
+        }
+        std::copy( vtmp.begin(), vtmp.begin() + len, val );
+    }
+    for( i=0; i < len; i++ ){
+        col[ i ] = key_col( k[ i ] );
+    }
+}
+
+
+/******************************************************************************/
+// Number of elements taken from a among the first diag elements of the merge
+// of the sorted arrays a and b. Keys are unique, so there are no ties.
+magma_int_t merge_split(
+    const sort_key_t *a, magma_int_t na,
+    const sort_key_t *b, magma_int_t nb, magma_int_t diag )
+{
+    magma_int_t lo = max( 0, diag - nb );
+    magma_int_t hi = min( diag, na );
+    while( lo < hi ) {
+        magma_int_t i = (lo + hi) / 2;
+        if ( a[ i ] < b[ diag-i-1 ] ) {
+            lo = i + 1;
+        }
+        else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+
+/******************************************************************************/
+// Sorts one row of length len with all nthread threads.
+// keys and tmp have len entries, vtmp len entries if val is not NULL.
+void sort_long_row(
+    magma_int_t len, magma_index_t *col, double *val,
+    magma_int_t nthread, sort_key_t *keys, sort_key_t *tmp,
+    double *vtmp )
+{
+    magma_int_t nrun = nthread;
+    std::vector< magma_int_t > bound( nrun+1 );
+    for( magma_int_t r=0; r <= nrun; r++ ){
+        bound[ r ] = r*len/nrun;
+    }
+
+    #pragma omp parallel for schedule(static, 1)
+    for( magma_int_t r=0; r < nrun; r++ ){
+        for( magma_int_t i = bound[ r ]; i < bound[ r+1 ]; i++ ){
+            keys[ i ] = make_key( col[ i ], i );
+        }
+        radix_sort( keys + bound[ r ], bound[ r+1 ] - bound[ r ], tmp + bound[ r ] );
+    }
+
+    while( nrun > 1 ) {
+        magma_int_t npair = nrun / 2;
+        magma_int_t nseg  = max( 1, nthread / npair );
+        // the last task copies an odd run
+        #pragma omp parallel for schedule(dynamic, 1)
+        for( magma_int_t t=0; t < npair*nseg + 1; t++ ){
+            if ( t == npair*nseg ) {
+                if ( nrun % 2 == 1 ) {
+                    std::copy( keys + bound[ nrun-1 ], keys + len, tmp + bound[ nrun-1 ] );
+                }
+                continue;
+            }
+            magma_int_t q = t / nseg, s = t % nseg;
+            const sort_key_t *a = keys + bound[ 2*q ];
+            const sort_key_t *b = keys + bound[ 2*q+1 ];
+            magma_int_t na = bound[ 2*q+1 ] - bound[ 2*q ];
+            magma_int_t nb = bound[ 2*q+2 ] - bound[ 2*q+1 ];
+            magma_int_t d0 =  s    * (na + nb) / nseg;
+            magma_int_t d1 = (s+1) * (na + nb) / nseg;
+            magma_int_t i  = merge_split( a, na, b, nb, d0 );
+            magma_int_t i1 = merge_split( a, na, b, nb, d1 );
+            magma_int_t j  = d0 - i, j1 = d1 - i1;
+            sort_key_t *out = tmp + bound[ 2*q ] + d0;
+            while( i < i1 && j < j1 ) {
+                *out++ = (a[ i ] < b[ j ] ? a[ i++ ] : b[ j++ ]);
+            }
+            out = std::copy( a + i, a + i1, out );
+            std::copy( b + j, b + j1, out );
+        }
+        std::swap( keys, tmp );
+        for( magma_int_t r=0; r <= nrun/2; r++ ){
+            bound[ r ] = bound[ 2*r ];
+        }
+        if ( nrun % 2 == 1 ) {
+            bound[ nrun/2 + 1 ] = len;
+        }
+        nrun = (nrun + 1) / 2;
+    }
+
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i < len; i++ ){
+        col[ i ] = key_col( keys[ i ] );
+        if ( val != NULL ) {
+            vtmp[ i ] = val[ key_pos( keys[ i ] ) ];
+        }
+    }
+    if ( val != NULL ) {
+        #pragma omp parallel for schedule(static)
+        for( magma_int_t i=0; i < len; i++ ){
+            val[ i ] = vtmp[ i ];
+        }
+    }
+}
+
+}  // end namespace
+
+
+/**
+    Purpose
+    -------
+
+    Sorts the elements of every row of a CSR matrix for increasing column
+    index, and permutes the values accordingly. Elements with the same
+    column index keep their order.
+
+    The rows are distributed to the OpenMP threads in parts with about equal
+    numbers of nonzeros. Short rows are sorted with a sorting network,
+    medium rows with insertion sort, long rows with a radix sort on the
+    column index, and rows longer than 65536 elements by all threads,
+    with a parallel merge sort.
+
+    Arguments
+    ---------
+
+    @param[in]
+    num_rows    magma_int_t
+                number of rows
+
+    @param[in]
+    row         const magma_index_t*
+                row pointer, of size num_rows+1
+
+    @param[in,out]
+    col         magma_index_t*
+                column indices, sorted within each row on output
+
+    @param[in,out]
+    val         double*
+                values, permuted as col; may be NULL to sort col only
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_daux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dcsr_sort_rows(
+    magma_int_t num_rows,
+    const magma_index_t *row,
+    magma_index_t *col,
+    double *val,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    sort_key_t *keys = NULL, *tmp = NULL;
+    double *vtmp = NULL;
+    magma_int_t nthread = 1, nparts, nnz, max_long = 0;
+    std::vector< magma_int_t > part;
+
+    if ( num_rows <= 0 ) {
+        goto cleanup;
+    }
+    nnz = row[ num_rows ] - row[ 0 ];
+
+#ifdef _OPENMP
+    nthread = omp_get_max_threads();
+#endif
+    // with one thread, long rows take the radix sort in sort_row
+    if ( nthread > 1 ) {
+        for( magma_int_t r=0; r < num_rows; r++ ){
+            magma_int_t len = row[ r+1 ] - row[ r ];
+            if ( len > long_size ) {
+                max_long = max( max_long, len );
+            }
+        }
+    }
+
+    // split the rows into parts with about nnz/nparts nonzeros
+    nparts = max( 1, min( num_rows, nthread * parts_per_thread ));
+    part.resize( nparts+1 );
+    part[ 0 ] = 0;
+    part[ nparts ] = num_rows;
+    for( magma_int_t p=1; p < nparts; p++ ){
+        magma_index_t target = (magma_index_t) (row[ 0 ] + p*nnz/nparts);
+        part[ p ] = std::upper_bound( row, row + num_rows + 1, target ) - row - 1;
+        part[ p ] = max( part[ p ], part[ p-1 ] );
+    }
+
+    #pragma omp parallel
+    {
+        std::vector< sort_key_t > rkeys;
+        std::vector< double > rvtmp;
+        #pragma omp for schedule(dynamic, 1)
+        for( magma_int_t p=0; p < nparts; p++ ){
+            for( magma_int_t r = part[ p ]; r < part[ p+1 ]; r++ ){
+                magma_int_t len = row[ r+1 ] - row[ r ];
+                if ( max_long == 0 || len <= long_size ) {
+                    sort_row( len, col + row[ r ], (val == NULL ? NULL : val + row[ r ]),
+                              rkeys, rvtmp );
+                }
+            }
+        }
+    }
+
+    if ( max_long > 0 ) {
+        CHECK( magma_malloc_cpu( (void**) &keys, max_long * sizeof(sort_key_t) ));
+        CHECK( magma_malloc_cpu( (void**) &tmp,  max_long * sizeof(sort_key_t) ));
+        if ( val != NULL ) {
+            CHECK( magma_dmalloc_cpu( &vtmp, max_long ));
+        }
+        for( magma_int_t r=0; r < num_rows; r++ ){
+            magma_int_t len = row[ r+1 ] - row[ r ];
+            if ( len > long_size ) {
+                sort_long_row( len, col + row[ r ], (val == NULL ? NULL : val + row[ r ]),
+                               nthread, keys, tmp, vtmp );
+            }
+        }
+    }
+
+cleanup:
+    magma_free_cpu( keys );
+    magma_free_cpu( tmp );
+    magma_free_cpu( vtmp );
+    return info;
+}
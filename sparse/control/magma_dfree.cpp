@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/control/magma_zfree.cpp, normal z -> d, Wed Feb 22 15:21:44 2023
+       @generated from sparse/control/magma_zfree.cpp, normal z -> d, Sun Oct 18 03:57:50 2026
        @author Hartwig Anzt
 */
 #include "magmasparse_internal.h"
@@ -466,7 +466,12 @@ magma_dprecondfree(
     magma_queue_t queue ){
 
     if ( precond_par->d.val != NULL ) {
-        magma_free( precond_par->d.val );
+        // the host solvers keep the Jacobi scaling in CPU memory
+        if ( precond_par->d.memory_location == Magma_CPU ) {
+            magma_free_cpu( precond_par->d.val );
+        } else {
+            magma_free( precond_par->d.val );
+        }
         precond_par->d.val = NULL;
     }
     if ( precond_par->d2.val != NULL ) {
@@ -481,6 +486,19 @@ magma_dprecondfree(
         magma_free( precond_par->work2.val );
         precond_par->work2.val = NULL;
     }
+    if ( precond_par->perm != NULL ) {
+        // row order of the multicolor smoothers, stored with M
+        if ( precond_par->M.memory_location == Magma_DEV )
+            magma_free( precond_par->perm );
+        else
+            magma_free_cpu( precond_par->perm );
+        precond_par->perm = NULL;
+    }
+    if ( precond_par->color_ptr != NULL ) {
+        magma_free_cpu( precond_par->color_ptr );
+        precond_par->color_ptr = NULL;
+    }
+    precond_par->ncolors = 0;
     if ( precond_par->M.val != NULL ) {
         if ( precond_par->M.memory_location == Magma_DEV )
             magma_free( precond_par->M.dval );
@@ -5,15 +5,323 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/control/magma_zgeisai_tools.cpp, normal z -> d, Wed Feb 22 15:21:49 2023
+       @generated from sparse/control/magma_zgeisai_tools.cpp, normal z -> d, Sun Oct 18 05:30:56 2026
        @author Hartwig Anzt
 
 */
 
 #include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define WARP_SIZE 32
 
+// The host triangular solves take systems of equal size in batches of
+// ISAI_LANES, stored interleaved, so the solve vectorizes across the batch.
+// Systems up to ISAI_UNROLL use a solve unrolled for their size; systems
+// larger than ISAI_BATCH are solved one at a time.
+#define ISAI_LANES  8
+#define ISAI_UNROLL 8
+#define ISAI_BATCH  32
+
+
+/******************************************************************************/
+// Solves W lower triangular systems E x = b of size n, where N == n if N > 0.
+// The systems are interleaved: E(r,c) of system l is E[ (c*n + r)*W + l ]
+// (column-major), x(r) is x[ r*W + l ]. x holds b on entry, x on exit.
+template< int N, int W >
+static void
+magma_disai_trsv_batch(
+    magma_int_t n_,
+    const double * __restrict__ E,
+    double * __restrict__ x,
+    bool unit )
+{
+    const magma_int_t n = (N > 0 ? N : n_);
+    for( magma_int_t k=0; k < n; k++ ){
+        double *xk = x + k*W;
+        const double *ek = E + k*n*W;
+        if ( ! unit ) {
+            #pragma omp simd
+            for( int l=0; l < W; l++ ){
+                xk[ l ] = xk[ l ] / ek[ k*W + l ];
+            }
+        }
+        for( magma_int_t r=k+1; r < n; r++ ){
+            #pragma omp simd
+            for( int l=0; l < W; l++ ){
+                x[ r*W + l ] -= ek[ r*W + l ] * xk[ l ];
+            }
+        }
+    }
+}
+
+
+/******************************************************************************/
+// Where a system is gathered to and scattered from.
+// The system op(T) x = b is stored as a lower triangular E: transposed if
+// trans, and with rows and columns reversed if op(T) is upper triangular.
+// set() and set_rhs() take T and b in the original numbering.
+struct magma_disai_slot {
+    double *E;
+    double *x;
+    magma_int_t n;
+    magma_int_t w;
+    bool trans, conj, reverse;
+
+    // T(r,c) = v
+    void set( magma_int_t r, magma_int_t c, double v ) const
+    {
+        if ( trans ) {
+            magma_int_t t = r;  r = c;  c = t;
+        }
+        if ( conj ) {
+            v = MAGMA_D_CONJ( v );
+        }
+        if ( reverse ) {
+            r = n-1-r;
+            c = n-1-c;
+        }
+        E[ (c*n + r)*w ] = v;
+    }
+
+    // b(r) = v
+    void set_rhs( magma_int_t r, double v ) const
+    {
+        x[ (reverse ? n-1-r : r)*w ] = v;
+    }
+
+    // @return x(r)
+    double get( magma_int_t r ) const
+    {
+        return x[ (reverse ? n-1-r : r)*w ];
+    }
+};
+
+
+/******************************************************************************/
+// Solves the triangular systems of sys, like blasf77_dtrsv on each:
+// op(T_i) x_i = b_i, with T_i lower or upper triangular as given by uplotype.
+// sys provides
+//     size( i )           size of system i
+//     gather( i, slot )   sets T_i and b_i; the slot is zero on entry
+//     scatter( i, slot )  stores x_i
+// Systems are sorted by size, and systems of equal size are gathered into
+// interleaved batches, solved, and scattered, all by the same thread.
+template< typename Systems >
+static magma_int_t
+magma_disai_solve_systems(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_int_t num_systems,
+    const Systems &sys,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_index_t *count = NULL, *order = NULL, *batch = NULL;
+    double *work = NULL;
+    magma_int_t maxn = 0, nbatch = 0, lwork, nthread = 1;
+    const bool trans   = (transtype != MagmaNoTrans);
+    const bool conj    = (transtype == MagmaConjTrans);
+    const bool reverse = ((uplotype == MagmaUpper) != trans);
+    const bool unit    = (diagtype == MagmaUnit);
+
+    for( magma_int_t i=0; i < num_systems; i++ ){
+        maxn = max( maxn, sys.size( i ) );
+    }
+
+    // sort the systems by size
+    CHECK( magma_index_malloc_cpu( &count, maxn+2 ));
+    CHECK( magma_index_malloc_cpu( &order, num_systems+1 ));
+    for( magma_int_t s=0; s < maxn+2; s++ ){
+        count[ s ] = 0;
+    }
+    for( magma_int_t i=0; i < num_systems; i++ ){
+        count[ sys.size( i ) + 1 ]++;
+    }
+    for( magma_int_t s=0; s < maxn+1; s++ ){
+        count[ s+1 ] += count[ s ];
+    }
+    for( magma_int_t i=0; i < num_systems; i++ ){
+        order[ count[ sys.size( i ) ]++ ] = i;
+    }
+    // count[ s ] is now the end of size s in order
+
+    // batch b is order[ batch[ b ] : batch[ b+1 ] ]; empty systems are skipped
+    CHECK( magma_index_malloc_cpu( &batch, num_systems+1 ));
+    for( magma_int_t s=1; s <= maxn; s++ ){
+        magma_int_t w = (s <= ISAI_BATCH ? ISAI_LANES : 1);
+        for( magma_int_t i=count[ s-1 ]; i < count[ s ]; i += w ){
+            batch[ nbatch++ ] = i;
+        }
+    }
+    batch[ nbatch ] = num_systems;
+
+    // workspace per thread for one batch
+    lwork = max( ISAI_LANES * (min( maxn, ISAI_BATCH ) + 1) * min( maxn, ISAI_BATCH ),
+                 maxn * (maxn + 1) );
+#ifdef _OPENMP
+    nthread = omp_get_max_threads();
+#endif
+    CHECK( magma_dmalloc_cpu( &work, nthread * lwork ));
+
+    #pragma omp parallel
+    {
+        magma_int_t tid = 0;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
+        double *E = work + tid * lwork;
+
+        #pragma omp for schedule(dynamic, 16)
+        for( magma_int_t b=0; b < nbatch; b++ ){
+            magma_int_t first = batch[ b ];
+            magma_int_t n     = sys.size( order[ first ] );
+            magma_int_t w     = (n <= ISAI_BATCH ? ISAI_LANES : 1);
+            magma_int_t nsys  = min( w, batch[ b+1 ] - first );
+            double *x = E + n*n*w;
+
+            for( magma_int_t j=0; j < (n + 1)*n*w; j++ ){
+                E[ j ] = MAGMA_D_ZERO;
+            }
+            magma_disai_slot slot = { NULL, NULL, n, w, trans, conj, reverse };
+            for( magma_int_t l=0; l < nsys; l++ ){
+                slot.E = E + l;
+                slot.x = x + l;
+                sys.gather( order[ first + l ], slot );
+            }
+            // unused lanes get the identity
+            for( magma_int_t l=nsys; l < w; l++ ){
+                for( magma_int_t r=0; r < n; r++ ){
+                    E[ (r*n + r)*w + l ] = MAGMA_D_ONE;
+                }
+            }
+
+            switch( w == ISAI_LANES ? n : 0 ) {
+                case 1: magma_disai_trsv_batch< 1, ISAI_LANES >( n, E, x, unit ); break;
+                case 2: magma_disai_trsv_batch< 2, ISAI_LANES >( n, E, x, unit ); break;
+                case 3: magma_disai_trsv_batch< 3, ISAI_LANES >( n, E, x, unit ); break;
+                case 4: magma_disai_trsv_batch< 4, ISAI_LANES >( n, E, x, unit ); break;
+                case 5: magma_disai_trsv_batch< 5, ISAI_LANES >( n, E, x, unit ); break;
+                case 6: magma_disai_trsv_batch< 6, ISAI_LANES >( n, E, x, unit ); break;
+                case 7: magma_disai_trsv_batch< 7, ISAI_LANES >( n, E, x, unit ); break;
+                case 8: magma_disai_trsv_batch< 8, ISAI_LANES >( n, E, x, unit ); break;
+                default:
+                    if ( w == ISAI_LANES ) {
+                        magma_disai_trsv_batch< 0, ISAI_LANES >( n, E, x, unit );
+                    } else {
+                        magma_disai_trsv_batch< 0, 1 >( n, E, x, unit );
+                    }
+                    break;
+            }
+
+            for( magma_int_t l=0; l < nsys; l++ ){
+                slot.E = E + l;
+                slot.x = x + l;
+                sys.scatter( order[ first + l ], slot );
+            }
+        }
+    }
+
+cleanup:
+    magma_free_cpu( count );
+    magma_free_cpu( order );
+    magma_free_cpu( batch );
+    magma_free_cpu( work );
+    return info;
+}
+
+
+/******************************************************************************/
+// Systems padded to WARP_SIZE x WARP_SIZE, as from magma_dmprepare_batched.
+struct magma_disai_padded_systems {
+    magma_uplo_t uplotype;
+    const magma_index_t *sizes;
+    const double *trisystems;
+    double *rhs;
+
+    magma_int_t size( magma_int_t i ) const
+    {
+        return sizes[ i ];
+    }
+
+    void gather( magma_int_t i, const magma_disai_slot &slot ) const
+    {
+        const double *T = trisystems + i*WARP_SIZE*WARP_SIZE;
+        magma_int_t n = sizes[ i ];
+        // only the triangle that trsv references
+        for( magma_int_t c=0; c < n; c++ ){
+            magma_int_t rbegin = (uplotype == MagmaLower ? c   : 0);
+            magma_int_t rend   = (uplotype == MagmaLower ? n-1 : c);
+            for( magma_int_t r=rbegin; r <= rend; r++ ){
+                slot.set( r, c, T[ c*WARP_SIZE + r ] );
+            }
+        }
+        for( magma_int_t r=0; r < n; r++ ){
+            slot.set_rhs( r, rhs[ i*WARP_SIZE + r ] );
+        }
+    }
+
+    void scatter( magma_int_t i, const magma_disai_slot &slot ) const
+    {
+        for( magma_int_t r=0; r < sizes[ i ]; r++ ){
+            rhs[ i*WARP_SIZE + r ] = slot.get( r );
+        }
+    }
+};
+
+
+/******************************************************************************/
+// Systems taken directly from L and the ISAI pattern M, as in
+// magma_disai_generator_regs: for row i of M with column indices
+// loc[0:n], T(r,c) = L(loc[r], loc[c]), and b is the first unit vector
+// (lower) or the last (upper). x goes back to the values of row i of M.
+struct magma_disai_csr_systems {
+    magma_uplo_t uplotype;
+    const magma_d_matrix *L;
+    magma_d_matrix *M;
+
+    magma_int_t size( magma_int_t i ) const
+    {
+        return M->row[ i+1 ] - M->row[ i ];
+    }
+
+    void gather( magma_int_t i, const magma_disai_slot &slot ) const
+    {
+        const magma_index_t *loc = M->col + M->row[ i ];
+        magma_int_t n = M->row[ i+1 ] - M->row[ i ];
+        for( magma_int_t r=0; r < n; r++ ){
+            // merge row loc[r] of L with the pattern
+            magma_int_t k = L->row[ loc[ r ] ];
+            magma_int_t kend = L->row[ loc[ r ]+1 ];
+            magma_int_t c = 0;
+            while( k < kend && c < n ){
+                if( L->col[ k ] == loc[ c ] ){
+                    slot.set( r, c, L->val[ k ] );
+                    k++;
+                    c++;
+                } else if( L->col[ k ] < loc[ c ] ){
+                    k++;
+                } else {
+                    c++;
+                }
+            }
+        }
+        slot.set_rhs( uplotype == MagmaLower ? 0 : n-1, MAGMA_D_ONE );
+    }
+
+    void scatter( magma_int_t i, const magma_disai_slot &slot ) const
+    {
+        double *val = M->val + M->row[ i ];
+        for( magma_int_t r=0; r < M->row[ i+1 ] - M->row[ i ]; r++ ){
+            val[ r ] = slot.get( r );
+        }
+    }
+};
+
 
 /***************************************************************************//**
     Purpose
@@ -164,7 +472,9 @@ magma_dmprepare_batched(
 /***************************************************************************//**
     Purpose
     -------
-    Does all triangular solves
+    Does all triangular solves.
+    Systems of equal size are solved together in batches, which vectorize
+    across the systems.
 
     Arguments
     ---------
@@ -228,19 +538,12 @@ magma_dmtrisolve_batched(
 {
     magma_int_t info = 0;
 
-    magma_int_t warpsize = WARP_SIZE;
-    magma_int_t ione     = 1;
+    magma_disai_padded_systems sys = { uplotype, sizes, trisystems, rhs };
 
-    #pragma omp parallel for
-    for(magma_int_t i=0; i<L.num_rows; i++){
-        blasf77_dtrsv( lapack_uplo_const(uplotype),
-                        lapack_trans_const(transtype),
-                        lapack_diag_const(diagtype),
-                           (magma_int_t*)&sizes[i],
-                           &trisystems[i*warpsize*warpsize], &warpsize,
-                           &rhs[i*warpsize], &ione );
-    }
+    CHECK( magma_disai_solve_systems( uplotype, transtype, diagtype,
+                                      L.num_rows, sys, queue ));
 
+cleanup:
     return info;
 }
 
@@ -320,6 +623,72 @@ magma_dmbackinsert_batched(
 }
 
 
+/***************************************************************************//**
+    Purpose
+    -------
+    Computes the ISAI preconditioner on the host; this is the host
+    counterpart of magma_disai_generator_regs, and replaces the sequence
+    magma_dmprepare_batched, magma_dmtrisolve_batched,
+    magma_dmbackinsert_batched.
+    For every row of M, the triangular system is gathered from L directly
+    into a batch of systems of equal size, solved, and the solution is
+    stored in the values of M. The systems are not padded, and their size
+    is not limited to 32.
+
+    Arguments
+    ---------
+
+
+    @param[in]
+    uplotype    magma_uplo_t
+                lower or upper triangular
+
+    @param[in]
+    transtype   magma_trans_t
+                possibility for transposed matrix
+
+    @param[in]
+    diagtype    magma_diag_t
+                unit diagonal or not
+
+    @param[in]
+    L           magma_d_matrix
+                triangular factor for which the ISAI matrix is computed.
+                Col-Major CSR storage, on the host.
+
+    @param[in,out]
+    M           magma_d_matrix*
+                SPAI preconditioner CSR col-major, on the host.
+                Rows sorted by column index.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_daux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_disai_generator_cpu(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_d_matrix L,
+    magma_d_matrix *M,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_disai_csr_systems sys = { uplotype, &L, M };
+
+    CHECK( magma_disai_solve_systems( uplotype, transtype, diagtype,
+                                      M->num_rows, sys, queue ));
+
+cleanup:
+    return info;
+}
+
+
 /***************************************************************************//**
     Purpose
     -------
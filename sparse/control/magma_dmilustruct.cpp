@@ -5,15 +5,21 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/control/magma_zmilustruct.cpp, normal z -> d, Wed Feb 22 15:21:47 2023
+       @generated from sparse/control/magma_zmilustruct.cpp, normal z -> d, Sun Oct 18 06:06:07 2026
        @author Hartwig Anzt
 */
 
 //  in this file, many routines are taken from
 //  the IO functions provided by MatrixMarket
 
+#include <algorithm>
+#include <vector>
+
 #include "magmasparse_internal.h"
 
+// rows per task of the parallel symbolic factorization
+#define SYMBILU_CHUNK 256
+
 
 /******************************************************************************
  * ILU mex function from MATLAB:
@@ -50,15 +56,17 @@ void magma_dshell_sort(
 }
 
 /*
-// symbolic level ILU
+// symbolic level ILU, sequential linked-list version
 // factors magma_int_to separate upper and lower parts
 // sorts the entries in each row of A by index
 // assumes no zero rows
+// used by magma_dsymbolic_ilu for matrices with a missing diagonal entry,
+// and by the testers as reference for the parallel version
 */
 
 extern "C"
 magma_int_t
-magma_dsymbolic_ilu(
+magma_dsymbolic_ilu_list(
     const magma_int_t levfill,                 /* level of fill */
     const magma_int_t n,                       /* order of matrix */
     magma_int_t *nzl,                          /* input-output */
@@ -238,6 +246,202 @@ cleanup:
 
 
 
+/*
+// Vertices reachable from i by paths of length <= maxlen whose intermediate
+// vertices are all smaller than i, in breadth-first order. Edges are the
+// nonzeros of the pattern (ia, ja). stamp[v] == i marks visited vertices.
+*/
+
+static void
+magma_dsymbilu_reach(
+    magma_index_t i,
+    magma_int_t maxlen,
+    const mwIndex *ia,
+    const mwIndex *ja,
+    std::vector< magma_index_t > &stamp,
+    std::vector< magma_index_t > &dist,
+    std::vector< magma_index_t > &reach )
+{
+    magma_int_t head = 0;
+
+    reach.clear();
+    stamp[i] = i;
+    dist[i] = 0;
+    reach.push_back( i );
+    while ( head < (magma_int_t) reach.size() ) {
+        magma_index_t u = reach[head++];
+        if ( u > i || dist[u] >= maxlen ) {
+            continue;
+        }
+        for( magma_int_t k=ia[u]; k < ia[u+1]; k++ ) {
+            magma_index_t v = ja[k];
+            if ( stamp[v] != i ) {
+                stamp[v] = i;
+                dist[v] = dist[u] + 1;
+                reach.push_back( v );
+            }
+        }
+    }
+}
+
+
+/*
+// symbolic level ILU
+// factors magma_int_to separate upper and lower parts
+// the entries in each row of L and U are sorted by index
+//
+// Uses the fill path theorem: entry (i,j) has level of fill lev if the
+// shortest path from i to j in the graph of A with all intermediate vertices
+// smaller than min(i,j) has length lev+1. Row i of U is the set reachable
+// from i through vertices < i, column j of L the set reachable from j
+// through vertices < j in the graph of A^T. All searches are independent
+// and run in parallel on chunks of rows with thread-private workspace.
+// Matrices with a missing diagonal entry use the linked-list version,
+// which treats the first entry of every U row as the diagonal.
+*/
+
+extern "C"
+magma_int_t
+magma_dsymbolic_ilu(
+    const magma_int_t levfill,                 /* level of fill */
+    const magma_int_t n,                       /* order of matrix */
+    magma_int_t *nzl,                          /* input-output */
+    magma_int_t *nzu,                          /* input-output */
+    const mwIndex *ia,
+    const mwIndex *ja,    /* input */
+    mwIndex *ial,
+    mwIndex *jal,              /* output lower factor structure */
+    mwIndex *iau,
+    mwIndex *jau)              /* output upper factor structure */
+{
+    magma_int_t info = 0;
+
+    magma_int_t nchunks = magma_ceildiv( n, SYMBILU_CHUNK );
+    magma_int_t knzl = 0, knzu = 0;
+    magma_int_t nodiag = 0;
+
+    #pragma omp parallel for reduction(+:nodiag)
+    for( magma_int_t i=0; i < n; i++ ) {
+        magma_int_t found = 0;
+        for( magma_int_t k=ia[i]; k < ia[i+1]; k++ ) {
+            found = ( ja[k] == i ) ? 1 : found;
+        }
+        nodiag += 1 - found;
+    }
+    if ( nodiag > 0 ) {
+        return magma_dsymbolic_ilu_list( levfill, n, nzl, nzu, ia, ja,
+                                         ial, jal, iau, jau );
+    }
+
+    // pattern of A^T
+    std::vector< magma_index_t > iat( n+1, 0 ), jat( ia[n] );
+    for( magma_int_t k=0; k < ia[n]; k++ ) {
+        iat[ ja[k]+1 ]++;
+    }
+    for( magma_int_t i=0; i < n; i++ ) {
+        iat[i+1] += iat[i];
+    }
+    {
+        std::vector< magma_index_t > pos( iat.begin(), iat.end()-1 );
+        for( magma_int_t i=0; i < n; i++ ) {
+            for( magma_int_t k=ia[i]; k < ia[i+1]; k++ ) {
+                jat[ pos[ ja[k] ]++ ] = i;
+            }
+        }
+    }
+
+    // ucols[c] holds the U rows, lcols[c] the L columns of chunk c
+    std::vector< std::vector< magma_index_t > > ucols( nchunks ), lcols( nchunks );
+    std::vector< magma_index_t > ucnt( n ), lcnt( n );
+
+    #pragma omp parallel
+    {
+        // roots are unique per search direction, so stamps need no reset
+        std::vector< magma_index_t > ustamp( n, -1 ), lstamp( n, -1 ), dist( n ), reach;
+
+        #pragma omp for schedule(dynamic, 1)
+        for( magma_int_t c=0; c < nchunks; c++ ) {
+            magma_int_t last = min( n, (c+1) * SYMBILU_CHUNK );
+            for( magma_int_t i = c * SYMBILU_CHUNK; i < last; i++ ) {
+                magma_int_t start = ucols[c].size();
+                magma_dsymbilu_reach( i, levfill+1, ia, ja, ustamp, dist, reach );
+                for( magma_int_t k=0; k < (magma_int_t) reach.size(); k++ ) {
+                    if ( reach[k] >= i ) {
+                        ucols[c].push_back( reach[k] );
+                    }
+                }
+                std::sort( ucols[c].begin() + start, ucols[c].end() );
+                ucnt[i] = ucols[c].size() - start;
+            }
+            for( magma_int_t i = c * SYMBILU_CHUNK; i < last; i++ ) {
+                magma_int_t start = lcols[c].size();
+                magma_dsymbilu_reach( i, levfill+1, iat.data(), jat.data(),
+                                      lstamp, dist, reach );
+                for( magma_int_t k=0; k < (magma_int_t) reach.size(); k++ ) {
+                    if ( reach[k] > i ) {
+                        lcols[c].push_back( reach[k] );
+                    }
+                }
+                lcnt[i] = lcols[c].size() - start;
+            }
+        }
+    }
+
+    // U in row order, L transposed from columns to rows
+    iau[0] = 0;
+    ial[0] = 0;
+    for( magma_int_t i=0; i < n; i++ ) {
+        iau[i+1] = iau[i] + ucnt[i];
+        ial[i+1] = 0;
+    }
+    for( magma_int_t c=0; c < nchunks; c++ ) {
+        for( magma_int_t k=0; k < (magma_int_t) lcols[c].size(); k++ ) {
+            ial[ lcols[c][k]+1 ]++;
+        }
+    }
+    for( magma_int_t i=0; i < n; i++ ) {
+        ial[i+1] += ial[i];
+    }
+    knzu = iau[n];
+    knzl = ial[n];
+    if ( knzl > *nzl ) {
+        printf("ILU: STORAGE parameter value %d<%d too small.\n", int(*nzl), int(knzl));
+        printf("Increase STORAGE parameter.\n");
+        info = -1;
+        goto cleanup;
+    }
+    if ( knzu > *nzu ) {
+        printf("ILU: STORAGE parameter value %d < %d too small.\n", int(*nzu), int(knzu));
+        printf("Increase STORAGE parameter.\n");
+        info = -1;
+        goto cleanup;
+    }
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for( magma_int_t c=0; c < nchunks; c++ ) {
+        std::copy( ucols[c].begin(), ucols[c].end(), jau + iau[ c * SYMBILU_CHUNK ] );
+    }
+    {
+        std::vector< magma_index_t > pos( ial, ial+n );
+        for( magma_int_t c=0; c < nchunks; c++ ) {
+            magma_int_t k = 0;
+            magma_int_t last = min( n, (c+1) * SYMBILU_CHUNK );
+            for( magma_int_t j = c * SYMBILU_CHUNK; j < last; j++ ) {
+                for( magma_int_t l=0; l < lcnt[j]; l++ ) {
+                    jal[ pos[ lcols[c][k++] ]++ ] = j;
+                }
+            }
+        }
+    }
+
+    *nzl = knzl;
+    *nzu = knzu;
+
+cleanup:
+    return info;
+}
+
+
 /******************************************************************************
  *
  * MEX function
@@ -275,8 +479,9 @@ void magma_dmexFunction(magma_int_t nlhs, magma_int_t n, double omega,
     Purpose
     -------
 
-    This routine performs a symbolic ILU factorization.
-    The algorithm is taken from an implementation written by Edmond Chow.
+    This routine performs a symbolic ILU factorization and returns fill
+    statistics and the setup time. The rows of the level-of-fill pattern
+    are computed in parallel, see magma_dsymbolic_ilu.
 
     Arguments
     ---------
@@ -298,7 +503,12 @@ void magma_dmexFunction(magma_int_t nlhs, magma_int_t n, double omega,
     U           magma_d_matrix*
                 output upper triangular matrix in magma sparse matrix format
                 empty on function call
-                
+
+    @param[out]
+    stats       magma_symbilu_stats*
+                nonzeros of A, L, U, fill ratio and setup time,
+                may be NULL
+
     @param[in]
     queue       magma_queue_t
                 Queue to execute in.
@@ -308,14 +518,18 @@ void magma_dmexFunction(magma_int_t nlhs, magma_int_t n, double omega,
 
 extern "C"
 magma_int_t
-magma_dsymbilu(
+magma_dsymbilu_stats(
     magma_d_matrix *A,
     magma_int_t levels,
     magma_d_matrix *L,
     magma_d_matrix *U,
+    magma_symbilu_stats *stats,
     magma_queue_t queue )
 {
     magma_int_t info = 0;
+
+    real_Double_t start = magma_wtime();
+    magma_int_t nnz = A->nnz;
     
     magma_d_matrix A_copy={Magma_CSR}, B={Magma_CSR};
     magma_d_matrix hA={Magma_CSR}, CSRCOOA={Magma_CSR};
@@ -342,8 +556,8 @@ magma_dsymbilu(
         CHECK( magma_index_malloc_cpu( &L->col, num_lnnz ));
         CHECK( magma_index_malloc_cpu( &U->col, num_unnz ));
 
-        magma_dsymbolic_ilu( levels, A->num_rows, &num_lnnz, &num_unnz, B.row, B.col,
-                                            L->row, L->col, U->row, U->col );
+        CHECK( magma_dsymbolic_ilu( levels, A->num_rows, &num_lnnz, &num_unnz, B.row, B.col,
+                                            L->row, L->col, U->row, U->col ));
         L->nnz = num_lnnz;
         U->nnz = num_unnz;
         magma_free_cpu( L->val );
@@ -356,25 +570,28 @@ magma_dsymbilu(
         for( magma_int_t i=0; i<U->nnz; i++ )
             U->val[i] = MAGMA_D_MAKE( 0.0, 0.0 );
         // take the original values (scaled) as initial guess for L
+        #pragma omp parallel for schedule(dynamic, 1024)
         for(magma_int_t i=0; i<L->num_rows; i++){
+            // the rows of the pattern are sorted
             for(magma_int_t j=B.row[i]; j<B.row[i+1]; j++){
                 magma_index_t lcol = B.col[j];
-                for(magma_int_t k=L->row[i]; k<L->row[i+1]; k++){
-                    if( L->col[k] == lcol ){
-                        L->val[k] =  B.val[j];
-                    }
+                magma_index_t *k = std::lower_bound( L->col + L->row[i],
+                                                     L->col + L->row[i+1], lcol );
+                if( k != L->col + L->row[i+1] && *k == lcol ){
+                    L->val[ k - L->col ] =  B.val[j];
                 }
             }
         }
 
         // take the original values (scaled) as initial guess for U
+        #pragma omp parallel for schedule(dynamic, 1024)
         for(magma_int_t i=0; i<U->num_rows; i++){
             for(magma_int_t j=B.row[i]; j<B.row[i+1]; j++){
                 magma_index_t lcol = B.col[j];
-                for(magma_int_t k=U->row[i]; k<U->row[i+1]; k++){
-                    if( U->col[k] == lcol ){
-                        U->val[k] =  B.val[j];
-                    }
+                magma_index_t *k = std::lower_bound( U->col + U->row[i],
+                                                     U->col + U->row[i+1], lcol );
+                if( k != U->col + U->row[i+1] && *k == lcol ){
+                    U->val[ k - U->col ] =  B.val[j];
                 }
             }
         }
@@ -402,13 +619,14 @@ magma_dsymbilu(
         }
         A->row[A->num_rows] = z;
         // reset the values of A to the original entries
+        #pragma omp parallel for schedule(dynamic, 1024)
         for(magma_int_t i=0; i<A->num_rows; i++){
             for(magma_int_t j=A_copy.row[i]; j<A_copy.row[i+1]; j++){
                 magma_index_t lcol = A_copy.col[j];
-                for(magma_int_t k=A->row[i]; k<A->row[i+1]; k++){
-                    if( A->col[k] == lcol ){
-                        A->val[k] =  A_copy.val[j];
-                    }
+                magma_index_t *k = std::lower_bound( A->col + A->row[i],
+                                                     A->col + A->row[i+1], lcol );
+                if( k != A->col + A->row[i+1] && *k == lcol ){
+                    A->val[ k - A->col ] =  A_copy.val[j];
                 }
             }
         }
@@ -419,7 +637,7 @@ magma_dsymbilu(
         CHECK( magma_dmtransfer( *A, &hA, A->memory_location, Magma_CPU, queue ));
         CHECK( magma_dmconvert( hA, &CSRCOOA, hA.storage_type, Magma_CSR, queue ));
 
-        CHECK( magma_dsymbilu( &CSRCOOA, levels, L, U, queue ));
+        CHECK( magma_dsymbilu_stats( &CSRCOOA, levels, L, U, NULL, queue ));
 
         magma_dmfree( &hA, queue );
         magma_dmfree( A, queue );
@@ -427,6 +645,15 @@ magma_dsymbilu(
         CHECK( magma_dmtransfer( hA, A, Magma_CPU, A_location, queue ));
     }
     
+    if ( stats != NULL ) {
+        stats->levels = levels;
+        stats->nnz = nnz;
+        stats->nnzl = L->nnz;
+        stats->nnzu = U->nnz;
+        stats->fill = ( nnz > 0 ) ? (double) ( L->nnz + U->nnz ) / nnz : 0.0;
+        stats->runtime = magma_wtime() - start;
+    }
+
 cleanup:
     if( info != 0 ){
         magma_dmfree( L, queue );
@@ -438,3 +665,53 @@ cleanup:
     magma_dmfree( &CSRCOOA, queue );
     return info;
 }
+
+
+
+/**
+    Purpose
+    -------
+
+    This routine performs a symbolic ILU factorization.
+    The algorithm is taken from an implementation written by Edmond Chow.
+    Use magma_dsymbilu_stats to obtain fill statistics and the setup time.
+
+    Arguments
+    ---------
+    @param[in,out]
+    A           magma_d_matrix*
+                matrix in magma sparse matrix format containing the original
+                matrix on input, and L,U on output
+
+    @param[in]
+    levels      magma_magma_int_t_t
+                fill in level
+
+    @param[out]
+    L           magma_d_matrix*
+                output lower triangular matrix in magma sparse matrix format
+                empty on function call
+
+    @param[out]
+    U           magma_d_matrix*
+                output upper triangular matrix in magma sparse matrix format
+                empty on function call
+                
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_daux
+    ********************************************************************/
+
+extern "C"
+magma_int_t
+magma_dsymbilu(
+    magma_d_matrix *A,
+    magma_int_t levels,
+    magma_d_matrix *L,
+    magma_d_matrix *U,
+    magma_queue_t queue )
+{
+    return magma_dsymbilu_stats( A, levels, L, U, NULL, queue );
+}
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/control/magma_zmatrix_tools.cpp, normal z -> s, Wed Feb 22 15:21:49 2023
+       @generated from sparse/control/magma_zmatrix_tools.cpp, normal z -> s, Sun Oct 18 06:52:47 2026
        @author Hartwig Anzt
 
 */
@@ -972,17 +972,16 @@ magma_smatrix_createrowptr(
     magma_int_t loc_offset = 0;
     
 #ifdef _OPENMP
-    #pragma omp parallel
-    {
-        num_threads = omp_get_max_threads();
-    }
+    // outside of a parallel region, this bounds the team below
+    num_threads = omp_get_max_threads();
 #else
     num_threads = 1;
 #endif
     CHECK(magma_index_malloc_cpu(&offset, num_threads+1));
     el_per_block = magma_ceildiv(n, num_threads);
     
-    #pragma omp parallel
+    // one block per thread
+    #pragma omp parallel num_threads( num_threads )
     {
 #ifdef _OPENMP
     magma_int_t id = omp_get_thread_num();
@@ -1296,7 +1295,8 @@ magma_smatrix_abssum(
 /***************************************************************************//**
     Purpose
     -------
-    SOrts the elements in a CSR matrix for increasing column index.
+    Sorts the elements in a CSR matrix for increasing column index,
+    using magma_scsr_sort_rows. The values are permuted accordingly.
 
     Arguments
     ---------
@@ -1320,11 +1320,7 @@ magma_scsr_sort(
     magma_int_t info = 0;
     
     if (A->memory_location == Magma_CPU && A->storage_type == Magma_CSR){
-        #pragma omp parallel  
-        for (int row=0; row<A->num_rows; row++) {
-            magma_sindexsort(&A->col[A->row[row]], 0, 
-                A->row[row+1]-A->row[row]-1, queue);
-        }
+        info = magma_scsr_sort_rows(A->num_rows, A->row, A->col, A->val, queue);
     } else {
         info = MAGMA_ERR_NOT_SUPPORTED;
     }
@@ -5,13 +5,17 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/control/magma_zmconvert.cpp, normal z -> s, Wed Feb 22 15:21:44 2023
+       @generated from sparse/control/magma_zmconvert.cpp, normal z -> s, Sun Oct 18 05:15:31 2026
        @author Hartwig Anzt
 */
 #include "magmasparse_internal.h"
 
 #include <cuda.h>  // for CUDA_VERSION
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 /* For hipSPARSE, they use a separate real type than for hipBLAS */
 #ifdef MAGMA_HAVE_HIP
@@ -764,6 +768,7 @@ magma_smconvert(
                 CHECK( magma_index_malloc_cpu( &B->row, A.num_rows+1 ));
                 CHECK( magma_index_malloc_cpu( &B->col, A.nnz ));
 
+                #pragma omp parallel for
                 for( magma_int_t i=0; i < A.num_rows+1; i++) {
                     B->row[i] = A.row[i];
                 }
@@ -814,12 +819,14 @@ magma_smconvert(
                 //printf("sigma = %i, p = %i\n", B->csr5_sigma, B->csr5_p);
                 // malloc the newly added arrays for CSR5
                 CHECK( magma_uindex_malloc_cpu( &B->tile_ptr, B->csr5_p+1 ));
+                #pragma omp parallel for
                 for( magma_int_t i=0; i<B->csr5_p+1; i++) {
                     B->tile_ptr[i] = 0;
                 }
 
                 CHECK( magma_uindex_malloc_cpu( &B->tile_desc,
                           B->csr5_p * MAGMA_CSR5_OMEGA * B->csr5_num_packets ));
+                #pragma omp parallel for
                 for( magma_int_t i=0; i<B->csr5_p * MAGMA_CSR5_OMEGA
                                         * B->csr5_num_packets; i++) {
                     B->tile_desc[i] = 0;
@@ -827,12 +834,14 @@ magma_smconvert(
 
 
                 CHECK( magma_smalloc_cpu( &B->calibrator, B->csr5_p ));
+                #pragma omp parallel for
                 for( magma_int_t i=0; i<B->csr5_p; i++) {
                     B->calibrator[i] = MAGMA_S_MAKE(0., 0.);
                 }
 
                 CHECK( magma_index_malloc_cpu( &B->tile_desc_offset_ptr,
                                                B->csr5_p+1 ));
+                #pragma omp parallel for
                 for( magma_int_t i=0; i<B->csr5_p+1; i++) {
                     B->tile_desc_offset_ptr[i] = 0;
                 }
@@ -841,6 +850,7 @@ magma_smconvert(
                 // convert csr data to csr5 data (3 steps)
                 // step 1 generate tile pointer
                 // step 1.1 binary search row pointer
+                #pragma omp parallel for
                 for (magma_index_t global_id = 0; global_id <= B->csr5_p;
                      global_id++)
                 {
@@ -867,6 +877,10 @@ magma_smconvert(
                 }
                 
                 // step 1.2 check empty rows
+                // tile g reads tile_ptr[g+1], so the dirty flags are first
+                // collected in tile_desc_offset_ptr (still all zero) and
+                // folded into tile_ptr in a second pass
+                #pragma omp parallel for
                 for (magma_index_t group_id = 0; group_id < B->csr5_p; group_id++) {
                     int dirty = 0;
                 
@@ -885,10 +899,14 @@ magma_smconvert(
                         }
                     }
                 
-                    if (dirty) {
-                        start |= sizeof(magma_uindex_t) == 4
+                    B->tile_desc_offset_ptr[group_id] = dirty;
+                }
+                #pragma omp parallel for
+                for (magma_index_t group_id = 0; group_id < B->csr5_p; group_id++) {
+                    if (B->tile_desc_offset_ptr[group_id]) {
+                        B->tile_ptr[group_id] |= sizeof(magma_uindex_t) == 4
                                            ? 0x80000000 : 0x8000000000000000;
-                        B->tile_ptr[group_id] = start;
+                        B->tile_desc_offset_ptr[group_id] = 0;
                     }
                 }
                 B->csr5_tail_tile_start = (B->tile_ptr[B->csr5_p-1] << 1) >> 1;
@@ -899,6 +917,8 @@ magma_smconvert(
                                      + B->csr5_bit_scansum_offset;
                 
                 //generate_tile_descriptor_s1_kernel
+                // tile par_id only sets bits in its own descriptor
+                #pragma omp parallel for
                 for (int par_id = 0; par_id < B->csr5_p-1; par_id++) {
                     const magma_index_t row_start = B->tile_ptr[par_id]
                                                     & 0x7FFFFFFF;
@@ -927,7 +947,12 @@ magma_smconvert(
                 }
                 
                 //generate_tile_descriptor_s2_kernel
-                int num_thread = 1; //omp_get_max_threads();
+#ifdef _OPENMP
+                int num_thread = omp_get_max_threads();
+#else
+                int num_thread = 1;
+#endif
+                int any_empty_rows = 0;
                 magma_index_t *s_segn_scan_all, *s_present_all;
                 
                 CHECK( magma_index_malloc_cpu( &s_segn_scan_all,
@@ -946,9 +971,13 @@ magma_smconvert(
                 
                 //const int bit_all_offset = bit_y_offset + bit_scansum_offset;
                 
-                //#pragma omp parallel for
+                #pragma omp parallel for reduction(|:any_empty_rows)
                 for (int par_id = 0; par_id < B->csr5_p-1; par_id++) {
-                    int tid = 0; //omp_get_thread_num();
+#ifdef _OPENMP
+                    int tid = omp_get_thread_num();
+#else
+                    int tid = 0;
+#endif
                     int *s_segn_scan = &s_segn_scan_all[tid * 2
                                                         * MAGMA_CSR5_OMEGA];
                     int *s_present = &s_present_all[tid * 2
@@ -1022,7 +1051,7 @@ magma_smconvert(
                     if (with_empty_rows) {
                         B->tile_desc_offset_ptr[par_id]
                             = s_segn_scan[MAGMA_CSR5_OMEGA];
-                        B->tile_desc_offset_ptr[B->csr5_p] = 1;
+                        any_empty_rows = 1;
                     }
                 
                     //#pragma simd
@@ -1054,6 +1083,9 @@ magma_smconvert(
                 
                 magma_free_cpu(s_segn_scan_all);
                 magma_free_cpu(s_present_all);
+                if (any_empty_rows) {
+                    B->tile_desc_offset_ptr[B->csr5_p] = 1;
+                }
                 
                 if (B->tile_desc_offset_ptr[B->csr5_p]) {
                     //scan_single(B->tile_desc_offset_ptr, p+1);
@@ -1078,7 +1110,7 @@ magma_smconvert(
                     //err = generate_tile_descriptor_offset
                     const int bit_bitflag = 32 - bit_all_offset;
                 
-                    //#pragma omp parallel for
+                    #pragma omp parallel for
                     for (int par_id = 0; par_id < B->csr5_p-1; par_id++) {
                         bool with_empty_rows = (B->tile_ptr[par_id] >> 31)&0x1;
                         if (!with_empty_rows)
@@ -1176,7 +1208,7 @@ magma_smconvert(
                 }
                 
                 // step 3. transpose column_index and value arrays
-                //#pragma omp parallel for
+                #pragma omp parallel for
                 for (int par_id = 0; par_id < B->csr5_p; par_id++) {
                     // if this is fast track tile, do not transpose it
                     if (B->tile_ptr[par_id] == B->tile_ptr[par_id + 1]) {
@@ -1234,14 +1266,7 @@ magma_smconvert(
             // CSRD to CSR (diagonal elements first)
             else if ( old_format == Magma_CSRD ) {
                 CHECK( magma_smconvert( A, B, Magma_CSR, Magma_CSR, queue ));
-                for( magma_int_t i=0; i < A.num_rows; i++) {
-                    magma_sindexsortval(
-                    B->col,
-                    B->val,
-                    B->row[i],
-                    B->row[i+1]-1,
-                    queue );
-                }
+                CHECK( magma_scsr_sort_rows( B->num_rows, B->row, B->col, B->val, queue ));
             }
 
             // CSRCOO to CSR
@@ -1268,14 +1293,7 @@ magma_smconvert(
                     B->row[ row+1 ] = numnnz;
                 }
                 // sort elements in every row according to col
-                for( magma_int_t i=0; i < A.num_rows; i++) {
-                    magma_sindexsortval(
-                    B->col,
-                    B->val,
-                    B->row[i],
-                    B->row[i+1]-1,
-                    queue );
-                }
+                CHECK( magma_scsr_sort_rows( B->num_rows, B->row, B->col, B->val, queue ));
             }
 
             // ELL/ELLPACK to CSR
@@ -1509,7 +1527,7 @@ magma_smconvert(
                 }
 
                 // step 1. transpose column_index and value arrays
-                //#pragma omp parallel for
+                #pragma omp parallel for
                 for (int par_id = 0; par_id < A.csr5_p; par_id++)
                 {
                     // if this is fast track tile, do not transpose it
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/control/magma_zparict_tools.cpp, normal z -> s, Wed Feb 22 15:21:50 2023
+       @generated from sparse/control/magma_zparict_tools.cpp, normal z -> s, Sun Oct 18 06:50:55 2026
        @author Hartwig Anzt
 
 */
@@ -67,18 +67,20 @@ magma_sparict_candidates(
     
     magma_int_t info = 0;
     magma_index_t *insertedL;
-    float thrs = 1e-8;
+    magma_index_t *marker = NULL;
+    magma_s_matrix LU={Magma_CSR};
     
     magma_int_t orig = 1; // the pattern L0 and U0 is considered
     magma_int_t existing = 0; // existing elements are also considered
     magma_int_t ilufill = 1;
     
-    // magma_int_t num_threads;
-    // 
-    // #pragma omp parallel
-    // {
-    //     num_threads = omp_get_max_threads();
-    // }
+    magma_int_t num_threads;
+    
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#else
+    num_threads = 1;
+#endif
     
     // for now: also some part commented out. If it turns out
     // this being correct, I need to clean up the code.
@@ -96,6 +98,16 @@ magma_sparict_candidates(
     L_new->storage_type = Magma_CSR;
     L_new->memory_location = Magma_CPU;
     
+    // pattern of the ILU(1) fill-in and markers for the existing entries
+    if( ilufill == 1 ){
+        CHECK( magma_s_spmm_symbolic_cpu( L, LT, &LU, queue ));
+        CHECK( magma_index_malloc_cpu( &marker, num_threads * L.num_cols ));
+        #pragma omp parallel for
+        for( magma_int_t i=0; i<num_threads * L.num_cols; i++ ){
+            marker[i] = -1;
+        }
+    }
+    
     // go over the original matrix - this is the only way to allow elements to come back...
     if( orig == 1 ){
        #pragma omp parallel for
@@ -141,57 +153,36 @@ magma_sparict_candidates(
     
     if( ilufill == 1 ){
         // how to determine candidates:
-        // for each node i, look at any "intermediate" neighbor nodes numbered
-        // less, and then see if this neighbor has another neighbor j numbered
-        // more than the intermediate; if so, fill in is (i,j) if it is not
-        // already nonzero
-        #pragma omp parallel for
-        for( magma_index_t row=0; row<L.num_rows; row++){
-            magma_int_t numaddrowL = 0;
-            // loop first element over row - only for elements smaller the diagonal
-            for( magma_index_t el1=L.row[row]; el1<L.row[row+1]-1; el1++ ){
-                magma_index_t col1 = L.col[ el1 ];
-                // now check the upper triangular
-                // second loop first element over row - only for elements larger the intermediate
-                for( magma_index_t el2 = LT.row[ col1 ]+1; el2 < LT.row[ col1+1 ]; el2++ ){
-                    magma_index_t col2 = LT.col[ el2 ];
-                    magma_index_t cand_row = row;
-                    magma_index_t cand_col = col2;
-                    // check whether this element already exists
-                    // first case: part of L
-                    if( cand_col < row ){
-                        // check whether this element already exists in L
-                        magma_int_t exist = 0;
-                        if( existing == 0 ){
-                            for(magma_index_t k=L.row[cand_row]; k<L.row[cand_row+1]; k++ ){
-                                if( L.col[ k ] == cand_col ){
-                                        exist = 1;
-                                        break;
-                                }
-                            }
-                        }
-                        // if it does not exist, increase counter for this location
-                        // use the entry one further down to allow for parallel insertion
-                        if( exist == 0 ){
-                            //printf("checked row: %d this element does not yet exist in L: (%d,%d)\n", cand_row, cand_col);
+        // the fill-in of IC(1) is the pattern of L * L^T, the candidates are
+        // the entries of this product not yet part of L (or the
+        // original pattern, which was added above)
+        // at most num_threads markers were allocated
+        #pragma omp parallel num_threads( num_threads )
+        {
+#ifdef _OPENMP
+            magma_index_t *mark = marker + omp_get_thread_num() * L.num_cols;
+#else
+            magma_index_t *mark = marker;
+#endif
+            #pragma omp for schedule(dynamic, 64)
+            for( magma_index_t row=0; row<L.num_rows; row++){
+                magma_int_t numaddrowL = 0;
+                for( magma_index_t k=L.row[row]; k<L.row[row+1]; k++ ){
+                    mark[ L.col[k] ] = row;
+                }
+                for( magma_index_t k=L0.row[row]; k<L0.row[row+1]; k++ ){
+                    mark[ L0.col[k] ] = row;
+                }
+                for( magma_index_t el=LU.row[row]; el<LU.row[row+1]; el++ ){
+                    magma_index_t cand_col = LU.col[ el ];
+                    if( mark[ cand_col ] != row ){
+                        if( cand_col < row ){
                             numaddrowL++;
-                            //numaddL[ row+1 ]++;
                         }
-                    } else {
-                        ;
-                        // we don't check if row>col. The motivation is that the element
-                        // will in this case be identified as candidate from a differen row.
-                        // Due to symmetry we have:
-                        // Assume we have a fill-in element (i,j) with i<j
-                        // Then there exists a k such that A(i,k)\neq 0 and A(k,j)\neq 0.
-                        // Due to symmetry, we then also have A(k,i)\neq 0 and A(j,k)\neq 0.
-                        // as a result, A(j,i) will be identified as fill-in also from row j
-                        // in which i i the column and i<j. 
                     }
                 }
-    
+                L_new->row[ row+1 ] = L_new->row[ row+1 ]+numaddrowL;
             }
-            L_new->row[ row+1 ] = L_new->row[ row+1 ]+numaddrowL;
         }
     } // end ilu-fill
     //end = magma_sync_wtime( queue ); printf("llop 1.2 : %.2e\n", end-start);
@@ -294,74 +285,44 @@ magma_sparict_candidates(
     } // end original
     
     if( ilufill==1 ){
-        #pragma omp parallel for
-        for( magma_index_t row=0; row<L.num_rows; row++){
-            magma_int_t laddL = 0;
-            magma_int_t offsetL = L_new->row[row] + insertedL[row];
-            // loop first element over row - only for elements smaller the diagonal
-            for( magma_index_t el1=L.row[row]; el1<L.row[row+1]-1; el1++ ){
-                
-                magma_index_t col1 = L.col[ el1 ];
-                // now check the upper triangular
-                // second loop first element over row - only for elements larger the intermediate
-                for( magma_index_t el2 = LT.row[ col1 ]+1; el2 < LT.row[ col1+1 ]; el2++ ){
-                    magma_index_t col2 = LT.col[ el2 ];
-                    magma_index_t cand_row = row;
-                    magma_index_t cand_col = col2;
-                    //$########### we now have the candidate cand_row cand_col
-                    
-                    
-                    // check whether this element already exists
-                    // first case: part of L
-                    if( cand_col < row ){
-                        magma_int_t exist = 0;
-                        if( existing == 0 ){
-                            for(magma_index_t k=L.row[cand_row]; k<L.row[cand_row+1]; k++ ){
-                                if( L.col[ k ] == cand_col ){
-                                        exist = 1;
-                                        break;
-                                }
-                            }
-                        }
-    #ifdef AVOID_DUPLICATES
-                        for( magma_int_t k=L_new->row[cand_row]; k<L_new->row[cand_row+1]; k++){
-                            if( L_new->col[ k ] == cand_col ){
-                                // element included in LU and nonzero
-                                exist = 1;
-                                break;
-                            }
-                        }
-    #endif
-                        // if it does not exist, increase counter for this location
-                        // use the entry one further down to allow for parallel insertion
-                        if( exist == 0 ){
-                            //  printf("---------------->>>  candidate in L at (%d, %d)\n", cand_row, cand_col);
-                            //add in the next location for this row
-                            // L_new->val[ numaddL[row] + laddL ] =  MAGMA_S_MAKE(1e-14,0.0);
-                            L_new->rowidx[ offsetL + laddL ] = cand_row;
+        // at most num_threads markers were allocated
+        #pragma omp parallel num_threads( num_threads )
+        {
+#ifdef _OPENMP
+            magma_index_t *mark = marker + omp_get_thread_num() * L.num_cols;
+#else
+            magma_index_t *mark = marker;
+#endif
+            // the markers of the counting phase are reused with row+n
+            #pragma omp for schedule(dynamic, 64)
+            for( magma_index_t row=0; row<L.num_rows; row++){
+                magma_index_t stamp = row + L.num_rows;
+                magma_int_t laddL = 0;
+                magma_int_t offsetL = L_new->row[row] + insertedL[row];
+                for( magma_index_t k=L.row[row]; k<L.row[row+1]; k++ ){
+                    mark[ L.col[k] ] = stamp;
+                }
+                for( magma_index_t k=L0.row[row]; k<L0.row[row+1]; k++ ){
+                    mark[ L0.col[k] ] = stamp;
+                }
+                for( magma_index_t el=LU.row[row]; el<LU.row[row+1]; el++ ){
+                    magma_index_t cand_col = LU.col[ el ];
+                    if( mark[ cand_col ] != stamp ){
+                        if( cand_col < row ){
+                            L_new->rowidx[ offsetL + laddL ] = row;
                             L_new->col[ offsetL + laddL ] = cand_col;
                             L_new->val[ offsetL + laddL ] = MAGMA_S_ONE;
-                            // L_new->list[ numaddL[row] + laddL ] = -1;
-                            // L_new->row[ numaddL[row] + laddL ] = -1;
                             laddL++;
                         }
-                    } else {
-                        ;
                     }
                 }
             }
         }
     } //end ilufill
-    
-#ifdef AVOID_DUPLICATES
-        // #####################################################################
-        
-        CHECK( magma_sparilut_thrsrm( 1, L_new, &thrs, queue ) );
-
-        // #####################################################################
-#endif
 
 cleanup:
+    magma_free_cpu( marker );
+    magma_smfree( &LU, queue );
     magma_free_cpu( insertedL );
     return info;
 }
@@ -376,6 +337,9 @@ cleanup:
     -------
     This function does one synchronized ParILU sweep. Input and output are 
     different arrays.
+    The diagonal is updated first, and the off-diagonal elements are
+    scaled by the new diagonal; scaling by the diagonal from before the
+    sweep can diverge, e.g., on a 7-point stencil without unit diagonal.
 
     Arguments
     ---------
@@ -429,56 +393,62 @@ magma_sparict_sweep_sync(
     
     CHECK( magma_smalloc_cpu( &L_new_val, L->nnz ));
     
-    #pragma omp parallel for
-    for( magma_int_t e=0; e<L->nnz; e++){
-        magma_int_t i,j,icol,jcol;//,jold;
-
-        magma_index_t row = L->rowidx[ e ];
-        magma_index_t col = L->col[ e ];
-
-        float A_e = MAGMA_S_ZERO;
-        // check whether A contains element in this location
-        for( i = A->row[row]; i<A->row[row+1]; i++){
-            if( A->col[i] == col ){
-                A_e = A->val[i];
-                break;
+    // diagonal first, then the off-diagonal elements scaled by it
+    for( magma_int_t diag=1; diag >= 0; diag-- ){
+        #pragma omp parallel for
+        for( magma_int_t e=0; e<L->nnz; e++){
+            magma_int_t i,j,icol,jcol;//,jold;
+
+            magma_index_t row = L->rowidx[ e ];
+            magma_index_t col = L->col[ e ];
+            if( ( row == col ) != ( diag == 1 ) ){
+                continue;
             }
-        }
 
-        //now do the actual iteration
-        i = L->row[ row ];
-        j = L->row[ col ];
-        magma_int_t endi = L->row[ row+1 ];
-        magma_int_t endj = L->row[ col+1 ];
-        float sum = MAGMA_S_ZERO;
-        float lsum = MAGMA_S_ZERO;
-        while( i<endi && j<endj ){
-            lsum = MAGMA_S_ZERO;
-            //jold = j;
-            icol = L->col[i];
-            jcol = L->col[j];
-            if( icol == jcol ){
-                lsum = L->val[i] * L->val[j];
-                sum = sum + lsum;
-                i++;
-                j++;
+            float A_e = MAGMA_S_ZERO;
+            // check whether A contains element in this location
+            for( i = A->row[row]; i<A->row[row+1]; i++){
+                if( A->col[i] == col ){
+                    A_e = A->val[i];
+                    break;
+                }
             }
-            else if( icol<jcol ){
-                i++;
+
+            //now do the actual iteration
+            i = L->row[ row ];
+            j = L->row[ col ];
+            magma_int_t endi = L->row[ row+1 ];
+            magma_int_t endj = L->row[ col+1 ];
+            float sum = MAGMA_S_ZERO;
+            float lsum = MAGMA_S_ZERO;
+            while( i<endi && j<endj ){
+                lsum = MAGMA_S_ZERO;
+                //jold = j;
+                icol = L->col[i];
+                jcol = L->col[j];
+                if( icol == jcol ){
+                    lsum = L->val[i] * L->val[j];
+                    sum = sum + lsum;
+                    i++;
+                    j++;
+                }
+                else if( icol<jcol ){
+                    i++;
+                }
+                else {
+                    j++;
+                }
             }
-            else {
-                j++;
+            sum = sum - lsum;
+            if( row == col ){
+                // write back to location e
+                L_new_val[ e ] = MAGMA_S_MAKE( sqrt( fabs( MAGMA_S_REAL(A_e - sum) )), 0.0 );
+            } else {
+                // write back to location e
+                L_new_val[ e ] =  ( A_e - sum ) / L_new_val[endj-1];
             }
-        }
-        sum = sum - lsum;
-        if( row == col ){
-            // write back to location e
-            L_new_val[ e ] = MAGMA_S_MAKE( sqrt( fabs( MAGMA_S_REAL(A_e - sum) )), 0.0 );
-        } else {
-            // write back to location e
-            L_new_val[ e ] =  ( A_e - sum ) / L->val[endj-1];
-        }
-    }// end omp parallel section
+        }// end omp parallel section
+    }
     
     val_swap = L_new_val;
     L_new_val = L->val;
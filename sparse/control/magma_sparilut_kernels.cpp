@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/control/magma_zparilut_kernels.cpp, normal z -> s, Wed Feb 22 15:21:49 2023
+       @generated from sparse/control/magma_zparilut_kernels.cpp, normal z -> s, Sun Oct 18 06:15:25 2026
        @author Hartwig Anzt
 
 */
@@ -15,10 +15,208 @@
 #include <omp.h>
 #endif
 
-#define SWAP(a, b)  { val_swap = a; a = b; b = val_swap; }
 
 
 
+/***************************************************************************//**
+    Fused layout of the strictly lower triangular parts of L and U^T, used by
+    the ParILUT sweeps. Row i holds the union of the columns k < i of L(i,:)
+    and U^T(i,:), with l_ik and u_ki side by side (zero if not in the factor).
+    Both the L and the U update of an entry then take the same sparse dot
+    product of two rows of this layout.
+
+    U is passed as U^T in CSR, as in magma_sparilut_sweep, so the diagonal is
+    the last element of every row of L and U.
+*******************************************************************************/
+
+typedef struct {
+    magma_int_t num_rows;
+    magma_int_t nnz;
+    magma_index_t *row;
+    magma_index_t *col;
+    float *lval;   // l_ik
+    float *uval;   // u_ki
+    float *udiag;  // u_ii
+    magma_index_t *lidx;        // position of l_ik in L, or -1
+    magma_index_t *uidx;        // position of u_ki in U, or -1
+    magma_index_t *apos_l;      // position of a_ik in A, or -1
+    magma_index_t *apos_u;      // position of a_ki in A, or -1
+    magma_index_t *apos_d;      // position of a_ii in A, or -1
+} magma_sparilut_fused_t;
+
+
+static void
+magma_sparilut_fused_free(
+    magma_sparilut_fused_t *F )
+{
+    magma_free_cpu( F->row );
+    magma_free_cpu( F->col );
+    magma_free_cpu( F->lval );
+    magma_free_cpu( F->uval );
+    magma_free_cpu( F->udiag );
+    magma_free_cpu( F->lidx );
+    magma_free_cpu( F->uidx );
+    magma_free_cpu( F->apos_l );
+    magma_free_cpu( F->apos_u );
+    magma_free_cpu( F->apos_d );
+}
+
+
+/***************************************************************************//**
+    Position of column col in row row of the sorted CSR matrix A, or -1.
+    The binary search has no data-dependent branches; rows of A are short,
+    and mispredicted branches would dominate.
+*******************************************************************************/
+
+static inline magma_index_t
+magma_sparilut_find(
+    const magma_s_matrix *A,
+    magma_index_t row,
+    magma_index_t col )
+{
+    magma_index_t len = A->row[ row+1 ] - A->row[ row ];
+    if ( len == 0 ) {
+        return -1;
+    }
+    const magma_index_t *base = A->col + A->row[ row ];
+    while( len > 1 ) {
+        magma_index_t half = len / 2;
+        base = ( base[ half ] <= col ) ? base + half : base;
+        len -= half;
+    }
+    return ( *base == col ) ? (magma_index_t) (base - A->col) : -1;
+}
+
+
+/***************************************************************************//**
+    Setup of the fused layout for the patterns of L and U: merges the rows of
+    L and U^T, and records for every entry its position in A. The values are
+    gathered by magma_sparilut_fused_gather.
+*******************************************************************************/
+
+static magma_int_t
+magma_sparilut_fused_setup(
+    magma_s_matrix *A,
+    magma_s_matrix *L,
+    magma_s_matrix *U,
+    magma_sparilut_fused_t *F,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_int_t n = L->num_rows;
+
+    F->num_rows = n;
+    CHECK( magma_index_malloc_cpu( &F->row, n+1 ));
+    CHECK( magma_index_malloc_cpu( &F->apos_d, n ));
+    CHECK( magma_smalloc_cpu( &F->udiag, n ));
+
+    // count the union of the strictly lower parts of every row
+    F->row[0] = 0;
+    #pragma omp parallel for schedule(static)
+    for (magma_int_t i=0; i<n; i++) {
+        magma_index_t il = L->row[i], endil = L->row[i+1]-1;
+        magma_index_t iu = U->row[i], endiu = U->row[i+1]-1;
+        magma_index_t count = 0;
+        while (il < endil && iu < endiu) {
+            magma_index_t kl = L->col[il], ku = U->col[iu];
+            il += ( kl <= ku );
+            iu += ( ku <= kl );
+            count++;
+        }
+        F->row[i+1] = count + (endil - il) + (endiu - iu);
+        F->apos_d[i] = magma_sparilut_find( A, i, i );
+    }
+    CHECK( magma_smatrix_createrowptr( n, F->row, queue ));
+    F->nnz = F->row[n];
+
+    CHECK( magma_index_malloc_cpu( &F->col, F->nnz ));
+    CHECK( magma_index_malloc_cpu( &F->lidx, F->nnz ));
+    CHECK( magma_index_malloc_cpu( &F->uidx, F->nnz ));
+    CHECK( magma_index_malloc_cpu( &F->apos_l, F->nnz ));
+    CHECK( magma_index_malloc_cpu( &F->apos_u, F->nnz ));
+    CHECK( magma_smalloc_cpu( &F->lval, F->nnz ));
+    CHECK( magma_smalloc_cpu( &F->uval, F->nnz ));
+
+    #pragma omp parallel for schedule(static)
+    for (magma_int_t i=0; i<n; i++) {
+        magma_index_t il = L->row[i], endil = L->row[i+1]-1;
+        magma_index_t iu = U->row[i], endiu = U->row[i+1]-1;
+        magma_index_t ia = A->row[i], endia = A->row[i+1];
+        for (magma_index_t p = F->row[i]; p < F->row[i+1]; p++) {
+            magma_index_t kl = ( il < endil ) ? L->col[il] : i;
+            magma_index_t ku = ( iu < endiu ) ? U->col[iu] : i;
+            magma_index_t k = min( kl, ku );
+            F->col[p]  = k;
+            F->lidx[p] = ( kl == k ) ? il++ : -1;
+            F->uidx[p] = ( ku == k ) ? iu++ : -1;
+            // a_ik by merging with row i of A, a_ki by search in row k
+            while (ia < endia && A->col[ia] < k) {
+                ia++;
+            }
+            F->apos_l[p] = ( ia < endia && A->col[ia] == k ) ? ia : -1;
+            F->apos_u[p] = magma_sparilut_find( A, k, i );
+        }
+    }
+
+cleanup:
+    return info;
+}
+
+
+/***************************************************************************//**
+    Copies the current values of L and U into the fused layout.
+*******************************************************************************/
+
+static void
+magma_sparilut_fused_gather(
+    magma_s_matrix *L,
+    magma_s_matrix *U,
+    magma_sparilut_fused_t *F )
+{
+    #pragma omp parallel for schedule(static)
+    for (magma_int_t i=0; i<F->num_rows; i++) {
+        for (magma_index_t p = F->row[i]; p < F->row[i+1]; p++) {
+            F->lval[p] = ( F->lidx[p] >= 0 ) ? L->val[ F->lidx[p] ] : MAGMA_S_ZERO;
+            F->uval[p] = ( F->uidx[p] >= 0 ) ? U->val[ F->uidx[p] ] : MAGMA_S_ZERO;
+        }
+        F->udiag[i] = U->val[ U->row[i+1]-1 ];
+    }
+}
+
+
+/***************************************************************************//**
+    Sparse dot products of the elements [begin, end) of the fused layout with
+    row k of it, for the entry in row i, column k (all columns are < k):
+        sl = sum_m l_im u_mk,    su = sum_m u_mi l_km.
+    The merge advances without branches, and both products are computed for
+    every step and selected on a match, so the loop has no data-dependent
+    branches besides the exit test.
+*******************************************************************************/
+
+static inline void
+magma_sparilut_fused_dot(
+    const magma_sparilut_fused_t *F,
+    magma_index_t begin,
+    magma_index_t end,
+    magma_index_t k,
+    float *sl,
+    float *su )
+{
+    float suml = MAGMA_S_ZERO, sumu = MAGMA_S_ZERO;
+    magma_index_t a = begin, b = F->row[k], endb = F->row[k+1];
+    while (a < end && b < endb) {
+        magma_index_t ka = F->col[a], kb = F->col[b];
+        float pl = F->lval[a] * F->uval[b];
+        float pu = F->uval[a] * F->lval[b];
+        suml = ( ka == kb ) ? suml + pl : suml;
+        sumu = ( ka == kb ) ? sumu + pu : sumu;
+        a += ( ka <= kb );
+        b += ( kb <= ka );
+    }
+    *sl = suml;
+    *su = sumu;
+}
+
 
 /***************************************************************************//**
     Purpose
@@ -30,6 +228,10 @@
     of L and U, not A.
     
     This is the CPU version of the asynchronous ParILUT sweep.
+    A setup phase merges L and U^T into one row-major layout, and looks up
+    the position in A of every entry once. Each entry of the layout then
+    updates l_ik and u_ki with one sparse dot product of two of its rows.
+    Updated values are used by later updates as they become available.
 
     Arguments
     ---------
@@ -65,102 +267,41 @@ magma_sparilut_sweep(
     magma_queue_t queue)
 {
     magma_int_t info = 0;
-    #pragma omp parallel for
-    for (magma_int_t e=0; e<L->nnz; e++) {
-
-        magma_int_t i,j,icol,jcol,jold;
-
-        magma_index_t row = L->rowidx[ e ];
-        magma_index_t col = L->col[ e ];
-        // as we look at the lower triangular,
-        // col<row, i.e. disregard last element in row
-        if(col < row) {
-            float A_e = MAGMA_S_ZERO;
-            // check whether A contains element in this location
-            for (i = A->row[row]; i<A->row[row+1]; i++) {
-                if(A->col[i] == col) {
-                    A_e = A->val[i];
-                    break;
-                }
+    magma_sparilut_fused_t F = { 0 };
+
+    CHECK( magma_sparilut_fused_setup( A, L, U, &F, queue ));
+    magma_sparilut_fused_gather( L, U, &F );
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (magma_int_t i=0; i<F.num_rows; i++) {
+        for (magma_index_t p = F.row[i]; p < F.row[i+1]; p++) {
+            magma_index_t k = F.col[p];
+            float sl, su;
+            magma_sparilut_fused_dot( &F, F.row[i], p, k, &sl, &su );
+            if ( F.lidx[p] >= 0 ) {
+                float A_e = ( F.apos_l[p] >= 0 ) ? A->val[ F.apos_l[p] ] : MAGMA_S_ZERO;
+                F.lval[p] = (A_e - sl) / F.udiag[k];
+                L->val[ F.lidx[p] ] = F.lval[p];
             }
-            //now do the actual iteration
-            i = L->row[ row ];
-            j = U->row[ col ];
-            magma_int_t endi = L->row[ row+1 ];
-            magma_int_t endj = U->row[ col+1 ]; 
-            float sum = MAGMA_S_ZERO;
-            float lsum = MAGMA_S_ZERO;
-            do{
-                lsum = MAGMA_S_ZERO;
-                jold = j;
-                icol = L->col[i];
-                jcol = U->col[j];
-                if(icol == jcol) {
-                    lsum = L->val[i] * U->val[j];
-                    sum = sum + lsum;
-                    i++;
-                    j++;
-                }
-                else if(icol<jcol) {
-                    i++;
-                }
-                else {
-                    j++;
-                }
-            }while(i<endi && j<endj);
-            sum = sum - lsum;
-
-            // write back to location e
-            L->val[ e ] =  (A_e - sum)/ U->val[jold];
-        } else if(row == col) { // end check whether part of L
-            L->val[ e ] = MAGMA_S_ONE; // lower triangular has diagonal equal 1
-        }
-    }// end omp parallel section
-
-   #pragma omp parallel for
-    for (magma_int_t e=0; e<U->nnz; e++) {
-        {
-            magma_int_t i,j,icol,jcol;
-            magma_index_t row = U->col[ e ];
-            magma_index_t col = U->rowidx[ e ];
-            float A_e = MAGMA_S_ZERO;
-            // check whether A contains element in this location
-            for (i = A->row[row]; i<A->row[row+1]; i++) {
-                if(A->col[i] == col) {
-                    A_e = A->val[i];
-                    break;
-                }
+            if ( F.uidx[p] >= 0 ) {
+                float A_e = ( F.apos_u[p] >= 0 ) ? A->val[ F.apos_u[p] ] : MAGMA_S_ZERO;
+                F.uval[p] = A_e - su;
+                U->val[ F.uidx[p] ] = F.uval[p];
             }
-            //now do the actual iteration
-            i = L->row[ row ];
-            j = U->row[ col ];
-            magma_int_t endi = L->row[ row+1 ];
-            magma_int_t endj = U->row[ col+1 ];
-            float sum = MAGMA_S_ZERO;
-            float lsum = MAGMA_S_ZERO;
-            do{
-                lsum = MAGMA_S_ZERO;
-                icol = L->col[i];
-                jcol = U->col[j];
-                if(icol == jcol) {
-                    lsum = L->val[i] * U->val[j];
-                    sum = sum + lsum;
-                    i++;
-                    j++;
-                }
-                else if(icol<jcol) {
-                    i++;
-                }
-                else {
-                    j++;
-                }
-            }while(i<endi && j<endj);
-            sum = sum - lsum;
-            // write back to location e
-            U->val[ e ] =  (A_e - sum);
         }
-    }// end omp parallel section
+        // diagonal: l_ii = 1, u_ii = a_ii - sum_m l_im u_mi
+        float sd = MAGMA_S_ZERO;
+        for (magma_index_t p = F.row[i]; p < F.row[i+1]; p++) {
+            sd = sd + F.lval[p] * F.uval[p];
+        }
+        float A_d = ( F.apos_d[i] >= 0 ) ? A->val[ F.apos_d[i] ] : MAGMA_S_ZERO;
+        F.udiag[i] = A_d - sd;
+        L->val[ L->row[i+1]-1 ] = MAGMA_S_ONE;
+        U->val[ U->row[i+1]-1 ] = F.udiag[i];
+    }
 
+cleanup:
+    magma_sparilut_fused_free( &F );
     return info;
 }
 
@@ -175,6 +316,13 @@ magma_sparilut_sweep(
     of L and U, not A.
     
     This is the CPU version of the synchronous ParILUT sweep.
+    It uses the fused layout and A lookup of magma_sparilut_sweep, but all
+    updates use the values of L and U from before the sweep (Jacobi style),
+    which the layout holds as a copy, so L and U are updated in place and
+    the result does not depend on the number of threads.
+    The diagonal of U is updated first, and L is scaled by the new
+    diagonal; scaling by the diagonal from before the sweep can diverge,
+    e.g., on a 27-point stencil started from tril(A) and triu(A).
 
     Arguments
     ---------
@@ -211,116 +359,44 @@ magma_sparilut_sweep_sync(
     magma_queue_t queue)
 {
     magma_int_t info = 0;
-    float *L_new_val = NULL, *U_new_val = NULL, *val_swap = NULL;
-    CHECK(magma_smalloc_cpu(&L_new_val, L->nnz));
-    CHECK(magma_smalloc_cpu(&U_new_val, U->nnz));
-    
-    #pragma omp parallel for
-    for (magma_int_t e=0; e<U->nnz; e++) {
-        magma_int_t i,j,icol,jcol;
+    magma_sparilut_fused_t F = { 0 };
 
-        magma_index_t row = U->col[ e ];
-        magma_index_t col = U->rowidx[ e ];
-        {   
-            float A_e = MAGMA_S_ZERO;
-            // check whether A contains element in this location
-            for (i = A->row[row]; i<A->row[row+1]; i++) {
-                if(A->col[i] == col) {
-                    A_e = A->val[i];
-                    break;
-                }
-            }
-            //now do the actual iteration
-            i = L->row[ row ];
-            j = U->row[ col ];
-            magma_int_t endi = L->row[ row+1 ];
-            magma_int_t endj = U->row[ col+1 ];
-            float sum = MAGMA_S_ZERO;
-            float lsum = MAGMA_S_ZERO;
-            do{
-                lsum = MAGMA_S_ZERO;
-                icol = L->col[i];
-                jcol = U->col[j];
-                if(icol == jcol) {
-                    lsum = L->val[i] * U->val[j];
-                    sum = sum + lsum;
-                    i++;
-                    j++;
-                }
-                else if(icol<jcol) {
-                    i++;
-                }
-                else {
-                    j++;
-                }
-            }while(i<endi && j<endj);
-            sum = sum - lsum;
+    CHECK( magma_sparilut_fused_setup( A, L, U, &F, queue ));
+    magma_sparilut_fused_gather( L, U, &F );
 
-            // write back to location e
-            U_new_val[ e ] =  (A_e - sum);
+    // diagonal first: u_ii = a_ii - sum_m l_im u_mi
+    #pragma omp parallel for schedule(static, 1024)
+    for (magma_int_t i=0; i<F.num_rows; i++) {
+        float sd = MAGMA_S_ZERO;
+        for (magma_index_t p = F.row[i]; p < F.row[i+1]; p++) {
+            sd = sd + F.lval[p] * F.uval[p];
         }
-    }// end omp parallel section
-    
-    
-    #pragma omp parallel for
-    for (magma_int_t e=0; e<L->nnz; e++) {
-        magma_int_t i,j,icol,jcol,jold;
-        magma_index_t row = L->rowidx[ e ];
-        magma_index_t col = L->col[ e ];
-        
-        // as we look at the lower triangular,
-        // col<row, i.e. disregard last element in row
-        if(row == col) { 
-            L_new_val[ e ] = MAGMA_S_ONE; // lower triangular has 1-diagonal
-        } else {
-            float A_e = MAGMA_S_ZERO;
-            // check whether A contains element in this location
-            for (i = A->row[row]; i<A->row[row+1]; i++) {
-                if(A->col[i] == col) {
-                    A_e = A->val[i];
-                    break;
-                }
+        float A_d = ( F.apos_d[i] >= 0 ) ? A->val[ F.apos_d[i] ] : MAGMA_S_ZERO;
+        F.udiag[i] = A_d - sd;
+    }
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (magma_int_t i=0; i<F.num_rows; i++) {
+        for (magma_index_t p = F.row[i]; p < F.row[i+1]; p++) {
+            magma_index_t k = F.col[p];
+            float sl, su;
+            magma_sparilut_fused_dot( &F, F.row[i], p, k, &sl, &su );
+            if ( F.lidx[p] >= 0 ) {
+                float A_e = ( F.apos_l[p] >= 0 ) ? A->val[ F.apos_l[p] ] : MAGMA_S_ZERO;
+                L->val[ F.lidx[p] ] = (A_e - sl) / F.udiag[k];
+            }
+            if ( F.uidx[p] >= 0 ) {
+                float A_e = ( F.apos_u[p] >= 0 ) ? A->val[ F.apos_u[p] ] : MAGMA_S_ZERO;
+                U->val[ F.uidx[p] ] = A_e - su;
             }
-            //now do the actual iteration
-            i = L->row[ row ];
-            j = U->row[ col ];
-            magma_int_t endi = L->row[ row+1 ];
-            magma_int_t endj = U->row[ col+1 ]; 
-            float sum = MAGMA_S_ZERO;
-            float lsum = MAGMA_S_ZERO;
-            do{
-                lsum = MAGMA_S_ZERO;
-                jold = j;
-                icol = L->col[i];
-                jcol = U->col[j];
-                
-                if(icol == jcol) {
-                    lsum = L->val[i] * U_new_val[j];
-                    sum = sum + lsum;
-                    i++;
-                    j++;
-                }
-                else if(icol<jcol) {
-                    i++;
-                }
-                else {
-                    j++;
-                }
-            }while(i<endi && j<endj);
-            sum = sum - lsum;
-            // write back to location e
-            L_new_val[ e ] =  (A_e - sum)/ U->val[jold];
         }
+        // l_ii = 1
+        L->val[ L->row[i+1]-1 ] = MAGMA_S_ONE;
+        U->val[ U->row[i+1]-1 ] = F.udiag[i];
+    }
 
-    }// end omp parallel section
-
-    // swap old and new values
-    SWAP(L_new_val, L->val);
-    SWAP(U_new_val, U->val);
-    
 cleanup:
-    magma_free_cpu(L_new_val);
-    magma_free_cpu(U_new_val);
+    magma_sparilut_fused_free( &F );
     return info;
 }
 
@@ -415,3 +491,81 @@ magma_sparilut_residuals(
 
     return info;
 }
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    This function computes the Frobenius norm of the ILU residual A - LU
+    on the sparsity pattern of A.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                System matrix A. The format is sorted CSR.
+
+    @param[in]
+    L           magma_s_matrix
+                Current approximation for the lower triangular factor.
+                The format is sorted CSR.
+
+    @param[in]
+    U           magma_s_matrix
+                Current approximation for the upper triangular factor,
+                transposed: U^T in sorted CSR, as in magma_sparilut_sweep.
+
+    @param[out]
+    res         float*
+                Frobenius norm of the residual.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_saux
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_sparilut_residual_norm(
+    magma_s_matrix A,
+    magma_s_matrix L,
+    magma_s_matrix U,
+    float *res,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    float sum = 0.0;
+
+    #pragma omp parallel for reduction(+:sum) schedule(dynamic,64)
+    for (magma_int_t row=0; row<A.num_rows; row++) {
+        for (magma_int_t e=A.row[row]; e<A.row[row+1]; e++) {
+            magma_index_t col = A.col[ e ];
+            // (LU)_{row,col} = sum_k L(row,k) U^T(col,k)
+            magma_int_t i = L.row[ row ];
+            magma_int_t j = U.row[ col ];
+            magma_int_t endi = L.row[ row+1 ];
+            magma_int_t endj = U.row[ col+1 ];
+            float lu = MAGMA_S_ZERO;
+            while (i<endi && j<endj) {
+                if (L.col[i] == U.col[j]) {
+                    lu = lu + L.val[i] * U.val[j];
+                    i++;
+                    j++;
+                }
+                else if (L.col[i] < U.col[j]) {
+                    i++;
+                }
+                else {
+                    j++;
+                }
+            }
+            float r = MAGMA_S_ABS( A.val[ e ] - lu );
+            sum += r*r;
+        }
+    }
+    *res = sqrt( sum );
+
+    return info;
+}
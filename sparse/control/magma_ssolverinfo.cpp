@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/control/magma_zsolverinfo.cpp, normal z -> s, Wed Feb 22 15:21:45 2023
+       @generated from sparse/control/magma_zsolverinfo.cpp, normal z -> s, Sun Oct 18 06:54:13 2026
        @author Hartwig Anzt
 
 */
@@ -241,6 +241,18 @@ magma_ssolverinfo(
             case Magma_ISAI:
                 printf("%%   Preconditioner used: ParILU-SPAI.\n" );
                 break;
+            case Magma_GS:
+            case Magma_SGS:
+                printf("%%   Preconditioner used: multicolor %sGauss-Seidel, %lld colors.\n",
+                        ( precond_par->solver == Magma_SGS ) ? "symmetric " : "",
+                        (long long) precond_par->ncolors );
+                break;
+            case Magma_SOR:
+            case Magma_SSOR:
+                printf("%%   Preconditioner used: multicolor %s(%.2f), %lld colors.\n",
+                        ( precond_par->solver == Magma_SSOR ) ? "SSOR" : "SOR",
+                        precond_par->omega, (long long) precond_par->ncolors );
+                break;
             default:
                 break;
         }
@@ -416,8 +428,24 @@ magma_ssolverinfo(
     }
     printf("%%    initial residual: %e\n", solver_par->init_res );
     printf("%%    preconditioner setup: %.4f sec\n", precond_par->setuptime );
+    if ( precond_par->symbilu.levels > 0 ) {
+        printf("%%    symbolic ILU(%lld): nnz(L) = %lld, nnz(U) = %lld, fill = %.2f, %.4f sec\n",
+                (long long) precond_par->symbilu.levels,
+                (long long) precond_par->symbilu.nnzl,
+                (long long) precond_par->symbilu.nnzu,
+                precond_par->symbilu.fill, precond_par->symbilu.runtime );
+    }
     printf("%%    iterations: %4lld\n", (long long) solver_par->numiter );
     printf("%%    SpMV-count: %4lld\n", (long long) solver_par->spmv_count );
+    if ( solver_par->iter_bytes > 0.0 ) {
+        printf("%%    memory traffic per iteration: %.4f MB\n",
+                solver_par->iter_bytes / 1e6 );
+        if ( solver_par->runtime > 0.0 ) {
+            printf("%%    achieved bandwidth: %.2f GB/s\n",
+                    solver_par->iter_bytes * solver_par->numiter
+                    / solver_par->runtime / 1e9 );
+        }
+    }
     printf("%%    exact final residual: %e\n"
            "%%    runtime: %.4f sec\n",
             solver_par->final_res, solver_par->runtime);
@@ -517,10 +545,12 @@ magma_ssolverinfo_init(
     solver_par->runtime         = 0.;
     solver_par->numiter = 0;
     solver_par->spmv_count = 0;
+    solver_par->iter_bytes = 0.;
     precond_par->numiter = 0;
     precond_par->spmv_count = 0;
     precond_par->runtime       = 0.;
     precond_par->setuptime  = 0.;
+    precond_par->symbilu.levels = 0;
     solver_par->res_vec = NULL;
     solver_par->timing = NULL;
     solver_par->eigenvectors = NULL;
@@ -609,6 +639,10 @@ magma_ssolverinfo_init(
     precond_par->L_dgraphindegree_bak = NULL;
     precond_par->U_dgraphindegree_bak = NULL;
 
+    precond_par->ncolors = 0;
+    precond_par->color_ptr = NULL;
+    precond_par->perm = NULL;
+
 cleanup:
     if( info != 0 ){
         magma_free( solver_par->timing );
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/control/magma_zutil_sparse.cpp, normal z -> s, Wed Feb 22 15:21:44 2023
+       @generated from sparse/control/magma_zutil_sparse.cpp, normal z -> s, Sun Oct 18 06:07:02 2026
 
        @author Hartwig Anzt
 
@@ -42,10 +42,20 @@ static const char *usage_sparse =
 " --mscale      Possibility to scale the original matrix:\n"
 "               NOSCALE   no scaling\n"
 "               UNITDIAG   symmetric scaling to unit diagonal\n"
+" --reorder     Possibility to reorder the matrix symmetrically before solving:\n"
+"               NONE      original order\n"
+"               RCM       reverse Cuthill-McKee (bandwidth reduction)\n"
+"               ND        nested dissection (fill reduction)\n"
+" --binary      Matrices are MAGMA binary CSR files instead of Matrix Market.\n"
+" --cpu         Run the solver on the host (CG, BICGSTAB, GMRES, IDR, QMR,\n"
+"               TFQMR; preconditioner JACOBI, GS, SGS, SOR, SSOR or NONE).\n"
+"               CGMERGE, BICGSTABMERGE,\n"
+"               IDRMERGE and TFQMR use fused host kernels.\n"
 " --precond x   Possibility to choose a preconditioner:\n"
 "               CG, BICGSTAB, GMRES, LOBPCG, JACOBI,\n"
 "               BAITER, IDR, CGS, TFQMR, QMR, BICG\n"
-"               BOMBARDMENT, ITERREF, ILU, PARILU, PARILUT, NONE.\n"
+"               BOMBARDMENT, ITERREF, ILU, PARILU, PARILUT,\n"
+"               GS, SGS, SOR, SSOR (multicolor smoothers), NONE.\n"
 "                   --patol atol  Absolute residual stopping criterion for preconditioner.\n"
 "                   --prtol rtol  Relative residual stopping criterion for preconditioner.\n"
 "                   --piters k    Iteration count for iterative preconditioner.\n"
@@ -53,6 +63,8 @@ static const char *usage_sparse =
 "                   --triolver k  Solver for triangular ILU factors: e.g. CUSOLVE, JACOBI, ISAI.\n"
 "                   --ppattern k  Pattern used for ISAI preconditioner.\n"
 "                   --psweeps x   Number of iterative ParILU sweeps.\n"
+"                   --pomega x    Relaxation parameter in (0,2) for SOR and SSOR.\n"
+"                   --pcoloring x Graph coloring for GS, SGS, SOR, SSOR: GREEDY, JP.\n"
 " --trisolver   Possibility to choose a triangular solver for ILU preconditioning: \n"
 "               e.g. CUSOLVE, ISPTRSV, JACOBI, VBJACOBI, ISAI.\n"
 " --ppattern k  Possibility to choose a pattern for the trisolver: ISAI(k) or Block Jacobi.\n"
@@ -114,6 +126,9 @@ magma_sparse_opts(
     opts->input_location = Magma_CPU;
     opts->output_location = Magma_CPU;
     opts->scaling = Magma_NOSCALE;
+    opts->reorder = Magma_NOREORDER;
+    opts->binary = 0;
+    opts->compute_location = Magma_DEV;
     #if defined(PRECISION_z) | defined(PRECISION_d)
         opts->solver_par.atol = 1e-16;
         opts->solver_par.rtol = 1e-10;
@@ -141,6 +156,8 @@ magma_sparse_opts(
     opts->precond_par.sweeps = 5;
     opts->precond_par.maxiter = 1;
     opts->precond_par.pattern = 1;
+    opts->precond_par.omega = 1.0;
+    opts->precond_par.coloring = Magma_JPCOLOR;
     opts->solver_par.solver = Magma_CGMERGE;
     
     printf( usage_sparse_short, argv[0] );
@@ -189,6 +206,20 @@ magma_sparse_opts(
             else {
                 printf( "%%error: invalid scaling, use default.\n" );
             }
+        } else if ( strcmp("--reorder", argv[i]) == 0 && i+1 < argc ) {
+            i++;
+            if ( strcmp("NONE", argv[i]) == 0 ) {
+                opts->reorder = Magma_NOREORDER;
+            }
+            else if ( strcmp("RCM", argv[i]) == 0 ) {
+                opts->reorder = Magma_RCM;
+            }
+            else if ( strcmp("ND", argv[i]) == 0 ) {
+                opts->reorder = Magma_ND;
+            }
+            else {
+                printf( "%%error: invalid reordering, use default.\n" );
+            }
         } else if ( strcmp("--solver", argv[i]) == 0 && i+1 < argc ) {
             i++;
             if ( strcmp("CG", argv[i]) == 0 ) {
@@ -351,6 +382,18 @@ magma_sparse_opts(
             else if ( strcmp("ISAI", argv[i]) == 0 ) {
                 opts->precond_par.solver = Magma_ISAI;
             }
+            else if ( strcmp("GS", argv[i]) == 0 ) {
+                opts->precond_par.solver = Magma_GS;
+            }
+            else if ( strcmp("SGS", argv[i]) == 0 ) {
+                opts->precond_par.solver = Magma_SGS;
+            }
+            else if ( strcmp("SOR", argv[i]) == 0 ) {
+                opts->precond_par.solver = Magma_SOR;
+            }
+            else if ( strcmp("SSOR", argv[i]) == 0 ) {
+                opts->precond_par.solver = Magma_SSOR;
+            }
             else if ( strcmp("NONE", argv[i]) == 0 ) {
                 opts->precond_par.solver = Magma_NONE;
             }
@@ -421,6 +464,19 @@ magma_sparse_opts(
             opts->precond_par.pattern = atoi( argv[++i] );
         } else if ( strcmp("--psweeps", argv[i]) == 0 && i+1 < argc ) {
             opts->precond_par.sweeps = atoi( argv[++i] );
+        } else if ( strcmp("--pomega", argv[i]) == 0 && i+1 < argc ) {
+            opts->precond_par.omega = atof( argv[++i] );
+        } else if ( strcmp("--pcoloring", argv[i]) == 0 && i+1 < argc ) {
+            i++;
+            if ( strcmp("GREEDY", argv[i]) == 0 ) {
+                opts->precond_par.coloring = Magma_GREEDYCOLOR;
+            }
+            else if ( strcmp("JP", argv[i]) == 0 ) {
+                opts->precond_par.coloring = Magma_JPCOLOR;
+            }
+            else {
+                printf( "%%error: invalid coloring, use default.\n" );
+            }
         } else if ( strcmp("--plevels", argv[i]) == 0 && i+1 < argc ) {
             opts->precond_par.levels = atoi( argv[++i] );
         } else if ( strcmp("--blocksize", argv[i]) == 0 && i+1 < argc ) {
@@ -439,6 +495,10 @@ magma_sparse_opts(
             opts->solver_par.num_eigenvalues = atoi( argv[++i] );
         } else if ( strcmp("--version", argv[i]) == 0 && i+1 < argc ) {
             opts->solver_par.version = atoi( argv[++i] );
+        } else if ( strcmp("--binary", argv[i]) == 0 ) {
+            opts->binary = 1;
+        } else if ( strcmp("--cpu", argv[i]) == 0 ) {
+            opts->compute_location = Magma_CPU;
         }
         // ----- usage
         else if ( strcmp("-h",     argv[i]) == 0 ||
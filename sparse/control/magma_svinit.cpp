@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/control/magma_zvinit.cpp, normal z -> s, Wed Feb 22 15:21:48 2023
+       @generated from sparse/control/magma_zvinit.cpp, normal z -> s, Sun Oct 18 04:59:01 2026
        @author Hartwig Anzt
 */
 #include "magmasparse_internal.h"
@@ -93,6 +93,9 @@ magma_svinit(
     x->ld = num_rows;
     if ( mem_loc == Magma_CPU ) {
         CHECK( magma_smalloc_cpu( &x->val, x->nnz ));
+        // same static schedule as the host BLAS-1 kernels, so each thread
+        // first touches (places on its NUMA node) the part it works on
+        #pragma omp parallel for schedule(static)
         for( magma_int_t i=0; i<x->nnz; i++) {
              x->val[i] = values;
         }
@@ -93,6 +93,9 @@ magma_zvinit(
     x->ld = num_rows;
     if ( mem_loc == Magma_CPU ) {
         CHECK( magma_zmalloc_cpu( &x->val, x->nnz ));
+        // same static schedule as the host BLAS-1 kernels, so each thread
+        // first touches (places on its NUMA node) the part it works on
+        #pragma omp parallel for schedule(static)
         for( magma_int_t i=0; i<x->nnz; i++) {
              x->val[i] = values;
         }
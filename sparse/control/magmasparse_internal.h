@@ -74,6 +74,44 @@ magma_int_t cusparse2magma_error( cusparseStatus_t status );
     } while(0)
 
 
+/**
+    Header of the MAGMA binary CSR container, written by
+    magma_[sdcz]write_csr_binary and read by magma_[sdcz]_csr_binary.
+
+    The header is followed by the row pointer, column index and value
+    sections, each starting at a MAGMA_BINARY_ALIGN byte aligned offset
+    recorded in the header. All data is stored in native byte order;
+    byte_order lets readers reject files written on a machine with a
+    different one.
+    ********************************************************************/
+#define MAGMA_BINARY_MAGIC        "MAGMACSR"
+#define MAGMA_BINARY_VERSION      1
+#define MAGMA_BINARY_BYTE_ORDER   0x01020304
+#define MAGMA_BINARY_ALIGN        64
+#define MAGMA_BINARY_HEADER_SIZE  128
+
+typedef struct magma_binary_header
+{
+    char     magic[8];          // MAGMA_BINARY_MAGIC, not null terminated
+    int32_t  version;           // MAGMA_BINARY_VERSION
+    int32_t  byte_order;        // MAGMA_BINARY_BYTE_ORDER in native order
+    int32_t  precision;         // 's', 'd', 'c', or 'z'
+    int32_t  index_size;        // sizeof(magma_index_t)
+    int32_t  value_size;        // size of one value in bytes
+    int32_t  storage_type;      // magma_storage_t
+    int32_t  sym;               // magma_symmetry_t
+    int32_t  fill_mode;         // magma_uplo_t
+    int64_t  num_rows;
+    int64_t  num_cols;
+    int64_t  nnz;
+    int64_t  row_offset;        // byte offset of the num_rows+1 row pointers
+    int64_t  col_offset;        // byte offset of the nnz column indices
+    int64_t  val_offset;        // byte offset of the nnz values
+    int64_t  file_size;
+    int32_t  reserved[8];
+} magma_binary_header;
+
+
 #ifdef __cplusplus
 } // extern C
 #endif
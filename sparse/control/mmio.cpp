@@ -8,6 +8,13 @@
 #include "magmasparse_internal.h"
 #include "magmasparse_mmio.h"
 
+#if ! defined( _WIN32 ) && ! defined( _WIN64 )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 int mm_read_unsymmetric_sparse(
     const char *fname, 
     magma_index_t *M_, 
@@ -541,3 +548,131 @@ void mm_snprintf_typecode( char *buffer, size_t buflen, MM_typecode matcode )
 
     snprintf( buffer, buflen, "%s %s %s %s", types[0], types[1], types[2], types[3] );
 }
+
+
+/******************** memory-mapped, parallel body parsing ********************/
+
+int mm_map_file( const char *fname, mm_file_map *map )
+{
+    map->data   = NULL;
+    map->size   = 0;
+    map->mapped = 0;
+
+#if ! defined( _WIN32 ) && ! defined( _WIN64 )
+    int fd = open( fname, O_RDONLY );
+    if ( fd < 0 )
+        return MM_COULD_NOT_READ_FILE;
+
+    struct stat st;
+    if ( fstat( fd, &st ) != 0 || st.st_size <= 0 ) {
+        close( fd );
+        return MM_PREMATURE_EOF;
+    }
+    map->size = (size_t) st.st_size;
+
+    // map the file only if it ends with a newline; otherwise the parsers
+    // would need a terminator past the end of the mapping
+    char last = 0;
+    if ( pread( fd, &last, 1, st.st_size-1 ) == 1 && last == '\n' ) {
+        void *ptr = mmap( NULL, map->size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        if ( ptr != MAP_FAILED ) {
+            #ifdef MADV_WILLNEED
+            madvise( ptr, map->size, MADV_WILLNEED );
+            #endif
+            map->data   = (char*) ptr;
+            map->mapped = 1;
+        }
+    }
+    close( fd );
+    if ( map->mapped )
+        return 0;
+#endif
+
+    // fallback: read the whole file into a newline-terminated buffer
+    FILE *f = fopen( fname, "rb" );
+    if ( f == NULL )
+        return MM_COULD_NOT_READ_FILE;
+    fseek( f, 0, SEEK_END );
+    long size = ftell( f );
+    fseek( f, 0, SEEK_SET );
+    if ( size <= 0 ) {
+        fclose( f );
+        return MM_PREMATURE_EOF;
+    }
+    map->data = (char*) malloc( size + 2 );
+    if ( map->data == NULL ) {
+        fclose( f );
+        return MAGMA_ERR_HOST_ALLOC;
+    }
+    map->size = fread( map->data, 1, size, f );
+    fclose( f );
+    if ( map->size == 0 || map->data[ map->size-1 ] != '\n' ) {
+        map->data[ map->size++ ] = '\n';
+    }
+    map->data[ map->size ] = '\0';
+    return 0;
+}
+
+
+void mm_unmap_file( mm_file_map *map )
+{
+    if ( map->data != NULL ) {
+#if ! defined( _WIN32 ) && ! defined( _WIN64 )
+        if ( map->mapped )
+            munmap( map->data, map->size );
+        else
+#endif
+            free( map->data );
+    }
+    map->data   = NULL;
+    map->size   = 0;
+    map->mapped = 0;
+}
+
+
+int mm_partition_entries(
+    const char *begin,
+    const char *end,
+    int nparts,
+    const char **part_begin,
+    magma_index_t *part_start )
+{
+    size_t chunk = (size_t)(end - begin) / nparts;
+
+    // chunk boundaries, each moved forward to the start of the next line
+    part_begin[0] = begin;
+    for( int k=1; k < nparts; k++ ) {
+        const char *p = begin + k*chunk;
+        if ( p < part_begin[k-1] ) {
+            p = part_begin[k-1];
+        }
+        if ( p > begin && p < end && p[-1] != '\n' ) {
+            p = (const char*) memchr( p, '\n', end - p );
+            p = (p == NULL) ? end : p+1;
+        }
+        part_begin[k] = p;
+    }
+    part_begin[nparts] = end;
+
+    // count the non-blank lines of every chunk
+    #pragma omp parallel for schedule(static, 1)
+    for( int k=0; k < nparts; k++ ) {
+        const char *p = part_begin[k];
+        const char *stop = part_begin[k+1];
+        magma_index_t count = 0;
+        while ( p < stop ) {
+            p = mm_skip_blanks( p );
+            if ( *p != '\n' )
+                count++;
+            p = (const char*) memchr( p, '\n', stop - p );
+            p = (p == NULL) ? stop : p+1;
+        }
+        part_start[k+1] = count;
+    }
+
+    part_start[0] = 0;
+    for( int k=0; k < nparts; k++ ) {
+        part_start[k+1] += part_start[k];
+    }
+    return 0;
+}
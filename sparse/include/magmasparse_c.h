@@ -5,7 +5,7 @@
  Univ. of Colorado, Denver
  @date February 2023
 
- @generated from sparse/include/magmasparse_z.h, normal z -> c, Wed Feb 22 15:22:07 2023
+ @generated from sparse/include/magmasparse_z.h, normal z -> c, Sun Oct 18 06:06:07 2026
  @author Hartwig Anzt
 */
 
@@ -97,6 +97,17 @@ magma_c_csr_mtx(
     const char *filename,
     magma_queue_t queue );
 
+magma_int_t 
+magma_c_csr_binary( 
+    magma_c_matrix *A, 
+    const char *filename,
+    magma_queue_t queue );
+
+magma_int_t 
+magma_cmunmap( 
+    magma_c_matrix *A, 
+    magma_queue_t queue );
+
 magma_int_t 
 magma_ccsrset( 
     magma_int_t m, 
@@ -441,6 +452,41 @@ magma_csymbilu(
     magma_c_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_csymbilu_stats(
+    magma_c_matrix *A,
+    magma_int_t levels,
+    magma_c_matrix *L,
+    magma_c_matrix *U,
+    magma_symbilu_stats *stats,
+    magma_queue_t queue );
+
+magma_int_t
+magma_csymbolic_ilu(
+    const magma_int_t levfill,
+    const magma_int_t n,
+    magma_int_t *nzl,
+    magma_int_t *nzu,
+    const magma_index_t *ia,
+    const magma_index_t *ja,
+    magma_index_t *ial,
+    magma_index_t *jal,
+    magma_index_t *iau,
+    magma_index_t *jau );
+
+magma_int_t
+magma_csymbolic_ilu_list(
+    const magma_int_t levfill,
+    const magma_int_t n,
+    magma_int_t *nzl,
+    magma_int_t *nzu,
+    const magma_index_t *ia,
+    const magma_index_t *ja,
+    magma_index_t *ial,
+    magma_index_t *jal,
+    magma_index_t *iau,
+    magma_index_t *jau );
+
 
 magma_int_t 
 magma_cwrite_csr_mtx( 
@@ -449,6 +495,12 @@ magma_cwrite_csr_mtx(
  const char *filename,
     magma_queue_t queue );
 
+magma_int_t 
+magma_cwrite_csr_binary( 
+    magma_c_matrix A,
+    const char *filename,
+    magma_queue_t queue );
+
 magma_int_t 
 magma_cwrite_vector( 
     magma_c_matrix A,
@@ -1178,6 +1230,14 @@ magma_cparilut_residuals(
     magma_c_matrix *L_new,
     magma_queue_t queue );
 
+magma_int_t
+magma_cparilut_residual_norm(
+    magma_c_matrix A,
+    magma_c_matrix L,
+    magma_c_matrix U,
+    float *res,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cparilut_residuals_transpose(
     magma_c_matrix A,
@@ -1250,6 +1310,13 @@ magma_cparict(
     magma_c_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_cparict_update(
+    magma_c_matrix A,
+    magma_c_preconditioner *precond,
+    magma_int_t updates,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cparict_cpu(
     magma_c_matrix A,
@@ -1264,6 +1331,13 @@ magma_cparilut(
     magma_c_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_cparilut_update(
+    magma_c_matrix A,
+    magma_c_preconditioner *precond,
+    magma_int_t updates,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cparilut_cpu(
     magma_c_matrix A,
@@ -1443,6 +1517,22 @@ magma_csampleselect_approx_nodp(
     magma_int_t *tmp_size,
     magma_queue_t queue );
 
+magma_int_t
+magma_csampleselect_cpu(
+    magma_int_t total_size,
+    magma_int_t subset_size,
+    magmaFloatComplex *val,
+    float *thrs,
+    magma_queue_t queue );
+
+magma_int_t
+magma_csampleselect_approx_cpu(
+    magma_int_t total_size,
+    magma_int_t subset_size,
+    magmaFloatComplex *val,
+    float *thrs,
+    magma_queue_t queue );
+
 
 // ISAI preconditioner
 
@@ -1484,6 +1574,15 @@ magma_cmbackinsert_batched(
     magmaFloatComplex *rhs,    
     magma_queue_t queue );
 
+magma_int_t
+magma_cisai_generator_cpu(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_c_matrix L,
+    magma_c_matrix *M,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cmprepare_batched_gpu(
     magma_uplo_t uplotype,
@@ -1603,11 +1702,305 @@ magma_ccsr_sort_gpu(
     magma_c_matrix *A,
     magma_queue_t queue);
 
+magma_int_t
+magma_ccsr_sort_rows(
+    magma_int_t num_rows,
+    const magma_index_t *row,
+    magma_index_t *col,
+    magmaFloatComplex *val,
+    magma_queue_t queue );
+
 // #endif
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE function definitions / Data on CPU
 */
 
+magmaFloatComplex
+magma_cdotc_cpu(
+    magma_int_t n,
+    const magmaFloatComplex *x,
+    const magmaFloatComplex *y );
+
+void
+magma_cdotc2_cpu(
+    magma_int_t n,
+    const magmaFloatComplex *v0,
+    const magmaFloatComplex *w0,
+    const magmaFloatComplex *v1,
+    const magmaFloatComplex *w1,
+    magmaFloatComplex *skp );
+
+magma_int_t
+magma_cmdotc_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    const magmaFloatComplex *v,
+    const magmaFloatComplex *r,
+    magmaFloatComplex *skp );
+
+void
+magma_cmaxpy_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    magmaFloatComplex alpha,
+    const magmaFloatComplex *v,
+    const magmaFloatComplex *c,
+    magmaFloatComplex beta,
+    magmaFloatComplex *y );
+
+float
+magma_scnrm2_cpu(
+    magma_int_t n,
+    const magmaFloatComplex *x );
+
+void
+magma_caxpby_cpu(
+    magma_int_t n,
+    magmaFloatComplex alpha,
+    const magmaFloatComplex *x,
+    magmaFloatComplex beta,
+    magmaFloatComplex *y );
+
+void
+magma_ccopy_cpu(
+    magma_int_t n,
+    const magmaFloatComplex *x,
+    magmaFloatComplex *y );
+
+void
+magma_cdiagscal_cpu(
+    magma_int_t n,
+    const magmaFloatComplex *d,
+    const magmaFloatComplex *b,
+    magmaFloatComplex *x );
+
+float
+magma_cmergebytes_cpu(
+    magma_c_matrix A );
+
+void
+magma_ccgmerge_spmv_cpu(
+    magma_c_matrix A,
+    magmaFloatComplex beta,
+    const magmaFloatComplex *r,
+    const magmaFloatComplex *p,
+    magmaFloatComplex *pn,
+    magmaFloatComplex *q,
+    magmaFloatComplex *skp );
+
+void
+magma_ccgmerge_xr_cpu(
+    magma_int_t n,
+    magmaFloatComplex alpha,
+    const magmaFloatComplex *p,
+    const magmaFloatComplex *q,
+    magmaFloatComplex *x,
+    magmaFloatComplex *r,
+    magmaFloatComplex *skp );
+
+void
+magma_cbicgmerge_spmv1_cpu(
+    magma_c_matrix A,
+    magmaFloatComplex beta,
+    magmaFloatComplex omega,
+    const magmaFloatComplex *r,
+    const magmaFloatComplex *rr,
+    const magmaFloatComplex *p,
+    const magmaFloatComplex *v,
+    magmaFloatComplex *pn,
+    magmaFloatComplex *vn,
+    magmaFloatComplex *skp );
+
+void
+magma_cbicgmerge_spmv2_cpu(
+    magma_c_matrix A,
+    magmaFloatComplex alpha,
+    const magmaFloatComplex *r,
+    const magmaFloatComplex *v,
+    magmaFloatComplex *s,
+    magmaFloatComplex *t,
+    magmaFloatComplex *skp );
+
+void
+magma_cbicgmerge_xr_cpu(
+    magma_int_t n,
+    magmaFloatComplex alpha,
+    magmaFloatComplex omega,
+    const magmaFloatComplex *p,
+    const magmaFloatComplex *s,
+    const magmaFloatComplex *t,
+    const magmaFloatComplex *rr,
+    magmaFloatComplex *x,
+    magmaFloatComplex *r,
+    magmaFloatComplex *skp );
+
+void
+magma_ctfqmrmerge_1_cpu(
+    magma_int_t n,
+    magma_int_t odd,
+    magmaFloatComplex alpha,
+    magmaFloatComplex sigma,
+    const magmaFloatComplex *v,
+    const magmaFloatComplex *Au,
+    const magmaFloatComplex *u_m,
+    const magmaFloatComplex *r_tld,
+    magmaFloatComplex *u_mp1,
+    magmaFloatComplex *w,
+    magmaFloatComplex *d,
+    magmaFloatComplex *Ad,
+    magmaFloatComplex *skp );
+
+void
+magma_ctfqmrmerge_2_cpu(
+    magma_int_t n,
+    magma_int_t even,
+    magmaFloatComplex eta,
+    magmaFloatComplex beta,
+    const magmaFloatComplex *d,
+    const magmaFloatComplex *Ad,
+    const magmaFloatComplex *w,
+    const magmaFloatComplex *u_m,
+    const magmaFloatComplex *Au,
+    magmaFloatComplex *x,
+    magmaFloatComplex *r,
+    magmaFloatComplex *u_mp1,
+    magmaFloatComplex *v,
+    magmaFloatComplex *skp );
+
+void
+magma_ctfqmrmerge_spmv_cpu(
+    magma_c_matrix A,
+    magma_int_t even,
+    const magmaFloatComplex *u_mp1,
+    const magmaFloatComplex *r_tld,
+    magmaFloatComplex *Au,
+    magmaFloatComplex *v,
+    magmaFloatComplex *skp );
+
+magma_int_t
+magma_cidrmerge_spmv_cpu(
+    magma_c_matrix A,
+    magma_int_t s,
+    const magmaFloatComplex *P,
+    magma_int_t dots,
+    const magmaFloatComplex *x,
+    magmaFloatComplex *y,
+    magmaFloatComplex *skp );
+
+void
+magma_cidrmerge_update_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    const magmaFloatComplex *alpha,
+    magmaFloatComplex beta,
+    const magmaFloatComplex *G,
+    const magmaFloatComplex *U,
+    magmaFloatComplex *g,
+    magmaFloatComplex *u,
+    magmaFloatComplex *r,
+    magmaFloatComplex *x,
+    const magmaFloatComplex *rs,
+    magmaFloatComplex *skp );
+
+void
+magma_cidrmerge_dir_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    magmaFloatComplex omega,
+    const magmaFloatComplex *c,
+    const magmaFloatComplex *r,
+    const magmaFloatComplex *G,
+    const magmaFloatComplex *U,
+    magmaFloatComplex *u );
+
+void
+magma_cidrmerge_smooth_cpu(
+    magma_int_t n,
+    magmaFloatComplex gamma,
+    const magmaFloatComplex *r,
+    const magmaFloatComplex *x,
+    magmaFloatComplex *rs,
+    magmaFloatComplex *xs,
+    magmaFloatComplex *skp );
+
+magma_int_t
+magma_cjacobisetup_diagscal_cpu(
+    magma_c_matrix A, magma_c_matrix *d,
+    magma_queue_t queue );
+
+magma_int_t
+magma_c_precondsetup_cpu(
+    magma_c_matrix A,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_c_applyprecond_cpu(
+    magma_trans_t trans,
+    magma_c_matrix b,
+    magma_c_matrix *x,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ccg_cpu(
+    magma_c_matrix A, magma_c_matrix b, magma_c_matrix *x,
+    magma_c_solver_par *solver_par,
+    magma_c_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cbicgstab_cpu(
+    magma_c_matrix A, magma_c_matrix b, magma_c_matrix *x,
+    magma_c_solver_par *solver_par,
+    magma_c_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cfgmres_cpu(
+    magma_c_matrix A, magma_c_matrix b, magma_c_matrix *x,
+    magma_c_solver_par *solver_par,
+    magma_c_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cidr_cpu(
+    magma_c_matrix A, magma_c_matrix b, magma_c_matrix *x,
+    magma_c_solver_par *solver_par,
+    magma_c_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cqmr_cpu(
+    magma_c_matrix A, magma_c_matrix b, magma_c_matrix *x,
+    magma_c_solver_par *solver_par,
+    magma_c_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ccg_merge_cpu(
+    magma_c_matrix A, magma_c_matrix b, magma_c_matrix *x,
+    magma_c_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cbicgstab_merge_cpu(
+    magma_c_matrix A, magma_c_matrix b, magma_c_matrix *x,
+    magma_c_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ctfqmr_merge_cpu(
+    magma_c_matrix A, magma_c_matrix b, magma_c_matrix *x,
+    magma_c_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cidr_merge_cpu(
+    magma_c_matrix A, magma_c_matrix b, magma_c_matrix *x,
+    magma_c_solver_par *solver_par,
+    magma_queue_t queue );
+
 
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE supernodal and RCM reordering
@@ -1628,6 +2021,43 @@ magma_cmvarsizeblockstruct(
     magma_c_matrix *A,
     magma_queue_t queue );
 
+magma_int_t
+magma_cmreorder(
+    magma_c_matrix A,
+    magma_reorder_t order,
+    magma_index_t **perm,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cmpermute(
+    magma_c_matrix A,
+    const magma_index_t *perm,
+    magma_c_matrix *B,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cvpermute(
+    magma_c_matrix x,
+    const magma_index_t *perm,
+    magma_c_matrix *y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cvpermute_inverse(
+    magma_c_matrix x,
+    const magma_index_t *perm,
+    magma_c_matrix *y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cmcolor(
+    magma_c_matrix A,
+    magma_coloring_t method,
+    magma_int_t *ncolors,
+    magma_index_t **perm,
+    magma_index_t **color_ptr,
+    magma_queue_t queue );
+
 
 
 /* ////////////////////////////////////////////////////////////////////////////
@@ -2260,6 +2690,42 @@ magma_cbajac_csr_overlap(
     magma_c_matrix *x,
     magma_queue_t queue );
 
+// multicolor Gauss-Seidel / SOR
+
+magma_int_t
+magma_cmcsorsetup(
+    magma_c_matrix A,
+    magma_location_t location,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cmcsor_smooth(
+    magma_c_matrix b,
+    magma_c_matrix *x,
+    magma_int_t sweeps,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cmcsor(
+    magma_c_matrix b,
+    magma_c_matrix *x,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cmcsor_sweep(
+    magma_int_t first,
+    magma_int_t last,
+    magmaFloatComplex omega,
+    magma_c_matrix M,
+    magma_c_matrix d,
+    magma_index_t *perm,
+    magma_c_matrix b,
+    magma_c_matrix *x,
+    magma_queue_t queue );
+
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE utility function definitions
 */
@@ -2296,6 +2762,64 @@ magma_c_spmv_shift(
     magma_c_matrix y,
     magma_queue_t queue );
 
+magma_int_t
+magma_c_spmv_cpu(
+    magmaFloatComplex alpha, 
+    magma_c_matrix A, 
+    magma_c_matrix x, 
+    magmaFloatComplex beta, 
+    magma_c_matrix y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cmfirsttouch_cpu(
+    magma_c_matrix *A,
+    magma_queue_t queue );
+
+magma_int_t
+magma_c_spmv_shift_cpu(
+    magmaFloatComplex alpha, 
+    magma_c_matrix A, 
+    magmaFloatComplex lambda,
+    magma_c_matrix x, 
+    magmaFloatComplex beta, 
+    magma_int_t offset, 
+    magma_int_t blocksize,
+    magma_index_t *add_rows, 
+    magma_c_matrix y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_c_spmm_cpu(
+    magmaFloatComplex alpha, 
+    magma_c_matrix A,
+    magma_c_matrix B,
+    magma_c_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_c_spmm_symbolic_cpu(
+    magma_c_matrix A,
+    magma_c_matrix B,
+    magma_c_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_c_spmm_numeric_cpu(
+    magmaFloatComplex alpha,
+    magma_c_matrix A,
+    magma_c_matrix B,
+    magma_c_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_c_spmm_rap_cpu(
+    magma_c_matrix R,
+    magma_c_matrix A,
+    magma_c_matrix P,
+    magma_c_matrix *Ac,
+    magma_queue_t queue );
+
 magma_int_t
 magma_ccuspmm(
     magma_c_matrix A, 
@@ -5,7 +5,7 @@
  Univ. of Colorado, Denver
  @date February 2023
 
- @generated from sparse/include/magmasparse_z.h, normal z -> d, Wed Feb 22 15:22:07 2023
+ @generated from sparse/include/magmasparse_z.h, normal z -> d, Sun Oct 18 06:06:07 2026
  @author Hartwig Anzt
 */
 
@@ -97,6 +97,17 @@ magma_d_csr_mtx(
     const char *filename,
     magma_queue_t queue );
 
+magma_int_t 
+magma_d_csr_binary( 
+    magma_d_matrix *A, 
+    const char *filename,
+    magma_queue_t queue );
+
+magma_int_t 
+magma_dmunmap( 
+    magma_d_matrix *A, 
+    magma_queue_t queue );
+
 magma_int_t 
 magma_dcsrset( 
     magma_int_t m, 
@@ -441,6 +452,41 @@ magma_dsymbilu(
     magma_d_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_dsymbilu_stats(
+    magma_d_matrix *A,
+    magma_int_t levels,
+    magma_d_matrix *L,
+    magma_d_matrix *U,
+    magma_symbilu_stats *stats,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dsymbolic_ilu(
+    const magma_int_t levfill,
+    const magma_int_t n,
+    magma_int_t *nzl,
+    magma_int_t *nzu,
+    const magma_index_t *ia,
+    const magma_index_t *ja,
+    magma_index_t *ial,
+    magma_index_t *jal,
+    magma_index_t *iau,
+    magma_index_t *jau );
+
+magma_int_t
+magma_dsymbolic_ilu_list(
+    const magma_int_t levfill,
+    const magma_int_t n,
+    magma_int_t *nzl,
+    magma_int_t *nzu,
+    const magma_index_t *ia,
+    const magma_index_t *ja,
+    magma_index_t *ial,
+    magma_index_t *jal,
+    magma_index_t *iau,
+    magma_index_t *jau );
+
 
 magma_int_t 
 magma_dwrite_csr_mtx( 
@@ -449,6 +495,12 @@ magma_dwrite_csr_mtx(
  const char *filename,
     magma_queue_t queue );
 
+magma_int_t 
+magma_dwrite_csr_binary( 
+    magma_d_matrix A,
+    const char *filename,
+    magma_queue_t queue );
+
 magma_int_t 
 magma_dwrite_vector( 
     magma_d_matrix A,
@@ -1178,6 +1230,14 @@ magma_dparilut_residuals(
     magma_d_matrix *L_new,
     magma_queue_t queue );
 
+magma_int_t
+magma_dparilut_residual_norm(
+    magma_d_matrix A,
+    magma_d_matrix L,
+    magma_d_matrix U,
+    double *res,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dparilut_residuals_transpose(
     magma_d_matrix A,
@@ -1250,6 +1310,13 @@ magma_dparict(
     magma_d_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_dparict_update(
+    magma_d_matrix A,
+    magma_d_preconditioner *precond,
+    magma_int_t updates,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dparict_cpu(
     magma_d_matrix A,
@@ -1264,6 +1331,13 @@ magma_dparilut(
     magma_d_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_dparilut_update(
+    magma_d_matrix A,
+    magma_d_preconditioner *precond,
+    magma_int_t updates,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dparilut_cpu(
     magma_d_matrix A,
@@ -1443,6 +1517,22 @@ magma_dsampleselect_approx_nodp(
     magma_int_t *tmp_size,
     magma_queue_t queue );
 
+magma_int_t
+magma_dsampleselect_cpu(
+    magma_int_t total_size,
+    magma_int_t subset_size,
+    double *val,
+    double *thrs,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dsampleselect_approx_cpu(
+    magma_int_t total_size,
+    magma_int_t subset_size,
+    double *val,
+    double *thrs,
+    magma_queue_t queue );
+
 
 // ISAI preconditioner
 
@@ -1484,6 +1574,15 @@ magma_dmbackinsert_batched(
     double *rhs,    
     magma_queue_t queue );
 
+magma_int_t
+magma_disai_generator_cpu(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_d_matrix L,
+    magma_d_matrix *M,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dmprepare_batched_gpu(
     magma_uplo_t uplotype,
@@ -1603,11 +1702,305 @@ magma_dcsr_sort_gpu(
     magma_d_matrix *A,
     magma_queue_t queue);
 
+magma_int_t
+magma_dcsr_sort_rows(
+    magma_int_t num_rows,
+    const magma_index_t *row,
+    magma_index_t *col,
+    double *val,
+    magma_queue_t queue );
+
 // #endif
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE function definitions / Data on CPU
 */
 
+double
+magma_ddot_cpu(
+    magma_int_t n,
+    const double *x,
+    const double *y );
+
+void
+magma_ddot2_cpu(
+    magma_int_t n,
+    const double *v0,
+    const double *w0,
+    const double *v1,
+    const double *w1,
+    double *skp );
+
+magma_int_t
+magma_dmdotc_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    const double *v,
+    const double *r,
+    double *skp );
+
+void
+magma_dmaxpy_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    double alpha,
+    const double *v,
+    const double *c,
+    double beta,
+    double *y );
+
+double
+magma_dnrm2_cpu(
+    magma_int_t n,
+    const double *x );
+
+void
+magma_daxpby_cpu(
+    magma_int_t n,
+    double alpha,
+    const double *x,
+    double beta,
+    double *y );
+
+void
+magma_dcopy_cpu(
+    magma_int_t n,
+    const double *x,
+    double *y );
+
+void
+magma_ddiagscal_cpu(
+    magma_int_t n,
+    const double *d,
+    const double *b,
+    double *x );
+
+double
+magma_dmergebytes_cpu(
+    magma_d_matrix A );
+
+void
+magma_dcgmerge_spmv_cpu(
+    magma_d_matrix A,
+    double beta,
+    const double *r,
+    const double *p,
+    double *pn,
+    double *q,
+    double *skp );
+
+void
+magma_dcgmerge_xr_cpu(
+    magma_int_t n,
+    double alpha,
+    const double *p,
+    const double *q,
+    double *x,
+    double *r,
+    double *skp );
+
+void
+magma_dbicgmerge_spmv1_cpu(
+    magma_d_matrix A,
+    double beta,
+    double omega,
+    const double *r,
+    const double *rr,
+    const double *p,
+    const double *v,
+    double *pn,
+    double *vn,
+    double *skp );
+
+void
+magma_dbicgmerge_spmv2_cpu(
+    magma_d_matrix A,
+    double alpha,
+    const double *r,
+    const double *v,
+    double *s,
+    double *t,
+    double *skp );
+
+void
+magma_dbicgmerge_xr_cpu(
+    magma_int_t n,
+    double alpha,
+    double omega,
+    const double *p,
+    const double *s,
+    const double *t,
+    const double *rr,
+    double *x,
+    double *r,
+    double *skp );
+
+void
+magma_dtfqmrmerge_1_cpu(
+    magma_int_t n,
+    magma_int_t odd,
+    double alpha,
+    double sigma,
+    const double *v,
+    const double *Au,
+    const double *u_m,
+    const double *r_tld,
+    double *u_mp1,
+    double *w,
+    double *d,
+    double *Ad,
+    double *skp );
+
+void
+magma_dtfqmrmerge_2_cpu(
+    magma_int_t n,
+    magma_int_t even,
+    double eta,
+    double beta,
+    const double *d,
+    const double *Ad,
+    const double *w,
+    const double *u_m,
+    const double *Au,
+    double *x,
+    double *r,
+    double *u_mp1,
+    double *v,
+    double *skp );
+
+void
+magma_dtfqmrmerge_spmv_cpu(
+    magma_d_matrix A,
+    magma_int_t even,
+    const double *u_mp1,
+    const double *r_tld,
+    double *Au,
+    double *v,
+    double *skp );
+
+magma_int_t
+magma_didrmerge_spmv_cpu(
+    magma_d_matrix A,
+    magma_int_t s,
+    const double *P,
+    magma_int_t dots,
+    const double *x,
+    double *y,
+    double *skp );
+
+void
+magma_didrmerge_update_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    const double *alpha,
+    double beta,
+    const double *G,
+    const double *U,
+    double *g,
+    double *u,
+    double *r,
+    double *x,
+    const double *rs,
+    double *skp );
+
+void
+magma_didrmerge_dir_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    double omega,
+    const double *c,
+    const double *r,
+    const double *G,
+    const double *U,
+    double *u );
+
+void
+magma_didrmerge_smooth_cpu(
+    magma_int_t n,
+    double gamma,
+    const double *r,
+    const double *x,
+    double *rs,
+    double *xs,
+    double *skp );
+
+magma_int_t
+magma_djacobisetup_diagscal_cpu(
+    magma_d_matrix A, magma_d_matrix *d,
+    magma_queue_t queue );
+
+magma_int_t
+magma_d_precondsetup_cpu(
+    magma_d_matrix A,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_d_applyprecond_cpu(
+    magma_trans_t trans,
+    magma_d_matrix b,
+    magma_d_matrix *x,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dcg_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dbicgstab_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dfgmres_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_didr_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dqmr_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dcg_merge_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dbicgstab_merge_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dtfqmr_merge_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_didr_merge_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_queue_t queue );
+
 
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE supernodal and RCM reordering
@@ -1628,6 +2021,43 @@ magma_dmvarsizeblockstruct(
     magma_d_matrix *A,
     magma_queue_t queue );
 
+magma_int_t
+magma_dmreorder(
+    magma_d_matrix A,
+    magma_reorder_t order,
+    magma_index_t **perm,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dmpermute(
+    magma_d_matrix A,
+    const magma_index_t *perm,
+    magma_d_matrix *B,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dvpermute(
+    magma_d_matrix x,
+    const magma_index_t *perm,
+    magma_d_matrix *y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dvpermute_inverse(
+    magma_d_matrix x,
+    const magma_index_t *perm,
+    magma_d_matrix *y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dmcolor(
+    magma_d_matrix A,
+    magma_coloring_t method,
+    magma_int_t *ncolors,
+    magma_index_t **perm,
+    magma_index_t **color_ptr,
+    magma_queue_t queue );
+
 
 
 /* ////////////////////////////////////////////////////////////////////////////
@@ -2260,6 +2690,42 @@ magma_dbajac_csr_overlap(
     magma_d_matrix *x,
     magma_queue_t queue );
 
+// multicolor Gauss-Seidel / SOR
+
+magma_int_t
+magma_dmcsorsetup(
+    magma_d_matrix A,
+    magma_location_t location,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dmcsor_smooth(
+    magma_d_matrix b,
+    magma_d_matrix *x,
+    magma_int_t sweeps,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dmcsor(
+    magma_d_matrix b,
+    magma_d_matrix *x,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dmcsor_sweep(
+    magma_int_t first,
+    magma_int_t last,
+    double omega,
+    magma_d_matrix M,
+    magma_d_matrix d,
+    magma_index_t *perm,
+    magma_d_matrix b,
+    magma_d_matrix *x,
+    magma_queue_t queue );
+
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE utility function definitions
 */
@@ -2296,6 +2762,64 @@ magma_d_spmv_shift(
     magma_d_matrix y,
     magma_queue_t queue );
 
+magma_int_t
+magma_d_spmv_cpu(
+    double alpha, 
+    magma_d_matrix A, 
+    magma_d_matrix x, 
+    double beta, 
+    magma_d_matrix y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dmfirsttouch_cpu(
+    magma_d_matrix *A,
+    magma_queue_t queue );
+
+magma_int_t
+magma_d_spmv_shift_cpu(
+    double alpha, 
+    magma_d_matrix A, 
+    double lambda,
+    magma_d_matrix x, 
+    double beta, 
+    magma_int_t offset, 
+    magma_int_t blocksize,
+    magma_index_t *add_rows, 
+    magma_d_matrix y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_d_spmm_cpu(
+    double alpha, 
+    magma_d_matrix A,
+    magma_d_matrix B,
+    magma_d_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_d_spmm_symbolic_cpu(
+    magma_d_matrix A,
+    magma_d_matrix B,
+    magma_d_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_d_spmm_numeric_cpu(
+    double alpha,
+    magma_d_matrix A,
+    magma_d_matrix B,
+    magma_d_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_d_spmm_rap_cpu(
+    magma_d_matrix R,
+    magma_d_matrix A,
+    magma_d_matrix P,
+    magma_d_matrix *Ac,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dcuspmm(
     magma_d_matrix A, 
@@ -6,6 +6,7 @@
 *
 */
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "magma_v2.h"
 #include "magmasparse.h"
@@ -141,5 +142,154 @@ int mm_read_unsymmetric_sparse(const char *fname, magma_index_t *M_,
         double **val_, magma_index_t **I_, magma_index_t **J_);
 
 
+/******************** memory-mapped, parallel body parsing ******************
+
+   mm_map_file maps a whole file read-only (or reads it into a buffer where
+   mmap is not available). The data is guaranteed to end with '\n', so the
+   inline parsers below never run past the end of the mapping: they stop
+   at the first character that cannot be part of the current token, and
+   none of them crosses a newline.
+
+   mm_partition_entries splits [begin, end) into nparts chunks on line
+   boundaries and counts the entries (non-blank lines) in each chunk, so
+   that the chunks can be parsed independently into preallocated arrays.
+   part_begin has nparts+1 entries, part_start has nparts+1 entries and
+   holds the exclusive prefix sum of the entry counts.
+
+ ***********************************************************************/
+
+typedef struct mm_file_map
+{
+    char   *data;
+    size_t  size;
+    int     mapped;     /* 1: data is a mmap view, 0: data is malloc'ed */
+} mm_file_map;
+
+int  mm_map_file( const char *fname, mm_file_map *map );
+void mm_unmap_file( mm_file_map *map );
+int  mm_partition_entries( const char *begin, const char *end, int nparts,
+        const char **part_begin, magma_index_t *part_start );
+
+
+static inline const char* mm_skip_blanks( const char *p )
+{
+    while ( *p == ' ' || *p == '\t' || *p == '\r' )
+        ++p;
+    return p;
+}
+
+static inline const char* mm_next_line( const char *p )
+{
+    while ( *p != '\n' )
+        ++p;
+    return p+1;
+}
+
+static inline magma_index_t mm_parse_index( const char **ptr )
+{
+    const char *p = mm_skip_blanks( *ptr );
+    magma_index_t sign = 1, val = 0;
+    if ( *p == '-' ) {
+        sign = -1;
+        ++p;
+    } else if ( *p == '+' ) {
+        ++p;
+    }
+    while ( *p >= '0' && *p <= '9' ) {
+        val = 10*val + (*p - '0');
+        ++p;
+    }
+    *ptr = p;
+    return sign*val;
+}
+
+/* Parses a floating point number. If the decimal mantissa is at most 2^53
+   and the decimal exponent is in [-22, 22], both are exact in double, so
+   the single multiplication or division below is correctly rounded
+   (Clinger's fast path); everything else goes through strtod. */
+static inline double mm_parse_double( const char **ptr )
+{
+    static const double mm_pow10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+    const char *start = mm_skip_blanks( *ptr );
+    const char *p = start;
+    int negative = 0, digits = 0, exp10 = 0, any = 0;
+    unsigned long long mant = 0;
+
+    if ( *p == '-' ) {
+        negative = 1;
+        ++p;
+    } else if ( *p == '+' ) {
+        ++p;
+    }
+    for( ; *p >= '0' && *p <= '9'; ++p ) {
+        any = 1;
+        if ( mant != 0 || *p != '0' ) {
+            if ( digits < 19 ) {
+                mant = 10*mant + (*p - '0');
+            } else {
+                exp10++;
+            }
+            digits++;
+        }
+    }
+    if ( *p == '.' ) {
+        for( ++p; *p >= '0' && *p <= '9'; ++p ) {
+            any = 1;
+            if ( mant != 0 || *p != '0' ) {
+                if ( digits < 19 ) {
+                    mant = 10*mant + (*p - '0');
+                    exp10--;
+                }
+                digits++;
+            } else {
+                exp10--;
+            }
+        }
+    }
+    if ( any && (*p == 'e' || *p == 'E') ) {
+        const char *q = p+1;
+        int esign = 1, e = 0;
+        if ( *q == '-' ) {
+            esign = -1;
+            ++q;
+        } else if ( *q == '+' ) {
+            ++q;
+        }
+        if ( *q >= '0' && *q <= '9' ) {
+            for( ; *q >= '0' && *q <= '9'; ++q ) {
+                if ( e < 100000 )
+                    e = 10*e + (*q - '0');
+            }
+            exp10 += esign*e;
+            p = q;
+        }
+    }
+    if ( any && digits <= 19 && mant <= (1ULL << 53) &&
+         exp10 >= -22 && exp10 <= 22 ) {
+        double val = (double) mant;
+        val = (exp10 < 0) ? val / mm_pow10[-exp10] : val * mm_pow10[exp10];
+        *ptr = p;
+        return negative ? -val : val;
+    }
+    if ( *start == '\n' ) {
+        *ptr = start;
+        return 0.;
+    }
+    char *stop;
+    double val = strtod( start, &stop );
+    *ptr = stop;
+    return val;
+}
+
+/* single precision readers parse in double and round once */
+static inline float mm_parse_float( const char **ptr )
+{
+    return (float) mm_parse_double( ptr );
+}
+
+
 
 #endif
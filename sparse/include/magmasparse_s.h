@@ -5,7 +5,7 @@
  Univ. of Colorado, Denver
  @date February 2023
 
- @generated from sparse/include/magmasparse_z.h, normal z -> s, Wed Feb 22 15:22:06 2023
+ @generated from sparse/include/magmasparse_z.h, normal z -> s, Sun Oct 18 06:06:07 2026
  @author Hartwig Anzt
 */
 
@@ -97,6 +97,17 @@ magma_s_csr_mtx(
     const char *filename,
     magma_queue_t queue );
 
+magma_int_t 
+magma_s_csr_binary( 
+    magma_s_matrix *A, 
+    const char *filename,
+    magma_queue_t queue );
+
+magma_int_t 
+magma_smunmap( 
+    magma_s_matrix *A, 
+    magma_queue_t queue );
+
 magma_int_t 
 magma_scsrset( 
     magma_int_t m, 
@@ -441,6 +452,41 @@ magma_ssymbilu(
     magma_s_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_ssymbilu_stats(
+    magma_s_matrix *A,
+    magma_int_t levels,
+    magma_s_matrix *L,
+    magma_s_matrix *U,
+    magma_symbilu_stats *stats,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ssymbolic_ilu(
+    const magma_int_t levfill,
+    const magma_int_t n,
+    magma_int_t *nzl,
+    magma_int_t *nzu,
+    const magma_index_t *ia,
+    const magma_index_t *ja,
+    magma_index_t *ial,
+    magma_index_t *jal,
+    magma_index_t *iau,
+    magma_index_t *jau );
+
+magma_int_t
+magma_ssymbolic_ilu_list(
+    const magma_int_t levfill,
+    const magma_int_t n,
+    magma_int_t *nzl,
+    magma_int_t *nzu,
+    const magma_index_t *ia,
+    const magma_index_t *ja,
+    magma_index_t *ial,
+    magma_index_t *jal,
+    magma_index_t *iau,
+    magma_index_t *jau );
+
 
 magma_int_t 
 magma_swrite_csr_mtx( 
@@ -449,6 +495,12 @@ magma_swrite_csr_mtx(
  const char *filename,
     magma_queue_t queue );
 
+magma_int_t 
+magma_swrite_csr_binary( 
+    magma_s_matrix A,
+    const char *filename,
+    magma_queue_t queue );
+
 magma_int_t 
 magma_swrite_vector( 
     magma_s_matrix A,
@@ -1178,6 +1230,14 @@ magma_sparilut_residuals(
     magma_s_matrix *L_new,
     magma_queue_t queue );
 
+magma_int_t
+magma_sparilut_residual_norm(
+    magma_s_matrix A,
+    magma_s_matrix L,
+    magma_s_matrix U,
+    float *res,
+    magma_queue_t queue );
+
 magma_int_t
 magma_sparilut_residuals_transpose(
     magma_s_matrix A,
@@ -1250,6 +1310,13 @@ magma_sparict(
     magma_s_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_sparict_update(
+    magma_s_matrix A,
+    magma_s_preconditioner *precond,
+    magma_int_t updates,
+    magma_queue_t queue );
+
 magma_int_t
 magma_sparict_cpu(
     magma_s_matrix A,
@@ -1264,6 +1331,13 @@ magma_sparilut(
     magma_s_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_sparilut_update(
+    magma_s_matrix A,
+    magma_s_preconditioner *precond,
+    magma_int_t updates,
+    magma_queue_t queue );
+
 magma_int_t
 magma_sparilut_cpu(
     magma_s_matrix A,
@@ -1443,6 +1517,22 @@ magma_ssampleselect_approx_nodp(
     magma_int_t *tmp_size,
     magma_queue_t queue );
 
+magma_int_t
+magma_ssampleselect_cpu(
+    magma_int_t total_size,
+    magma_int_t subset_size,
+    float *val,
+    float *thrs,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ssampleselect_approx_cpu(
+    magma_int_t total_size,
+    magma_int_t subset_size,
+    float *val,
+    float *thrs,
+    magma_queue_t queue );
+
 
 // ISAI preconditioner
 
@@ -1484,6 +1574,15 @@ magma_smbackinsert_batched(
     float *rhs,    
     magma_queue_t queue );
 
+magma_int_t
+magma_sisai_generator_cpu(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_s_matrix L,
+    magma_s_matrix *M,
+    magma_queue_t queue );
+
 magma_int_t
 magma_smprepare_batched_gpu(
     magma_uplo_t uplotype,
@@ -1603,11 +1702,305 @@ magma_scsr_sort_gpu(
     magma_s_matrix *A,
     magma_queue_t queue);
 
+magma_int_t
+magma_scsr_sort_rows(
+    magma_int_t num_rows,
+    const magma_index_t *row,
+    magma_index_t *col,
+    float *val,
+    magma_queue_t queue );
+
 // #endif
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE function definitions / Data on CPU
 */
 
+float
+magma_sdot_cpu(
+    magma_int_t n,
+    const float *x,
+    const float *y );
+
+void
+magma_sdot2_cpu(
+    magma_int_t n,
+    const float *v0,
+    const float *w0,
+    const float *v1,
+    const float *w1,
+    float *skp );
+
+magma_int_t
+magma_smdotc_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    const float *v,
+    const float *r,
+    float *skp );
+
+void
+magma_smaxpy_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    float alpha,
+    const float *v,
+    const float *c,
+    float beta,
+    float *y );
+
+float
+magma_snrm2_cpu(
+    magma_int_t n,
+    const float *x );
+
+void
+magma_saxpby_cpu(
+    magma_int_t n,
+    float alpha,
+    const float *x,
+    float beta,
+    float *y );
+
+void
+magma_scopy_cpu(
+    magma_int_t n,
+    const float *x,
+    float *y );
+
+void
+magma_sdiagscal_cpu(
+    magma_int_t n,
+    const float *d,
+    const float *b,
+    float *x );
+
+float
+magma_smergebytes_cpu(
+    magma_s_matrix A );
+
+void
+magma_scgmerge_spmv_cpu(
+    magma_s_matrix A,
+    float beta,
+    const float *r,
+    const float *p,
+    float *pn,
+    float *q,
+    float *skp );
+
+void
+magma_scgmerge_xr_cpu(
+    magma_int_t n,
+    float alpha,
+    const float *p,
+    const float *q,
+    float *x,
+    float *r,
+    float *skp );
+
+void
+magma_sbicgmerge_spmv1_cpu(
+    magma_s_matrix A,
+    float beta,
+    float omega,
+    const float *r,
+    const float *rr,
+    const float *p,
+    const float *v,
+    float *pn,
+    float *vn,
+    float *skp );
+
+void
+magma_sbicgmerge_spmv2_cpu(
+    magma_s_matrix A,
+    float alpha,
+    const float *r,
+    const float *v,
+    float *s,
+    float *t,
+    float *skp );
+
+void
+magma_sbicgmerge_xr_cpu(
+    magma_int_t n,
+    float alpha,
+    float omega,
+    const float *p,
+    const float *s,
+    const float *t,
+    const float *rr,
+    float *x,
+    float *r,
+    float *skp );
+
+void
+magma_stfqmrmerge_1_cpu(
+    magma_int_t n,
+    magma_int_t odd,
+    float alpha,
+    float sigma,
+    const float *v,
+    const float *Au,
+    const float *u_m,
+    const float *r_tld,
+    float *u_mp1,
+    float *w,
+    float *d,
+    float *Ad,
+    float *skp );
+
+void
+magma_stfqmrmerge_2_cpu(
+    magma_int_t n,
+    magma_int_t even,
+    float eta,
+    float beta,
+    const float *d,
+    const float *Ad,
+    const float *w,
+    const float *u_m,
+    const float *Au,
+    float *x,
+    float *r,
+    float *u_mp1,
+    float *v,
+    float *skp );
+
+void
+magma_stfqmrmerge_spmv_cpu(
+    magma_s_matrix A,
+    magma_int_t even,
+    const float *u_mp1,
+    const float *r_tld,
+    float *Au,
+    float *v,
+    float *skp );
+
+magma_int_t
+magma_sidrmerge_spmv_cpu(
+    magma_s_matrix A,
+    magma_int_t s,
+    const float *P,
+    magma_int_t dots,
+    const float *x,
+    float *y,
+    float *skp );
+
+void
+magma_sidrmerge_update_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    const float *alpha,
+    float beta,
+    const float *G,
+    const float *U,
+    float *g,
+    float *u,
+    float *r,
+    float *x,
+    const float *rs,
+    float *skp );
+
+void
+magma_sidrmerge_dir_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    float omega,
+    const float *c,
+    const float *r,
+    const float *G,
+    const float *U,
+    float *u );
+
+void
+magma_sidrmerge_smooth_cpu(
+    magma_int_t n,
+    float gamma,
+    const float *r,
+    const float *x,
+    float *rs,
+    float *xs,
+    float *skp );
+
+magma_int_t
+magma_sjacobisetup_diagscal_cpu(
+    magma_s_matrix A, magma_s_matrix *d,
+    magma_queue_t queue );
+
+magma_int_t
+magma_s_precondsetup_cpu(
+    magma_s_matrix A,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_s_applyprecond_cpu(
+    magma_trans_t trans,
+    magma_s_matrix b,
+    magma_s_matrix *x,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_scg_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sbicgstab_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sfgmres_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sidr_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sqmr_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_scg_merge_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sbicgstab_merge_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_stfqmr_merge_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sidr_merge_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_queue_t queue );
+
 
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE supernodal and RCM reordering
@@ -1628,6 +2021,43 @@ magma_smvarsizeblockstruct(
     magma_s_matrix *A,
     magma_queue_t queue );
 
+magma_int_t
+magma_smreorder(
+    magma_s_matrix A,
+    magma_reorder_t order,
+    magma_index_t **perm,
+    magma_queue_t queue );
+
+magma_int_t
+magma_smpermute(
+    magma_s_matrix A,
+    const magma_index_t *perm,
+    magma_s_matrix *B,
+    magma_queue_t queue );
+
+magma_int_t
+magma_svpermute(
+    magma_s_matrix x,
+    const magma_index_t *perm,
+    magma_s_matrix *y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_svpermute_inverse(
+    magma_s_matrix x,
+    const magma_index_t *perm,
+    magma_s_matrix *y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_smcolor(
+    magma_s_matrix A,
+    magma_coloring_t method,
+    magma_int_t *ncolors,
+    magma_index_t **perm,
+    magma_index_t **color_ptr,
+    magma_queue_t queue );
+
 
 
 /* ////////////////////////////////////////////////////////////////////////////
@@ -2260,6 +2690,42 @@ magma_sbajac_csr_overlap(
     magma_s_matrix *x,
     magma_queue_t queue );
 
+// multicolor Gauss-Seidel / SOR
+
+magma_int_t
+magma_smcsorsetup(
+    magma_s_matrix A,
+    magma_location_t location,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_smcsor_smooth(
+    magma_s_matrix b,
+    magma_s_matrix *x,
+    magma_int_t sweeps,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_smcsor(
+    magma_s_matrix b,
+    magma_s_matrix *x,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_smcsor_sweep(
+    magma_int_t first,
+    magma_int_t last,
+    float omega,
+    magma_s_matrix M,
+    magma_s_matrix d,
+    magma_index_t *perm,
+    magma_s_matrix b,
+    magma_s_matrix *x,
+    magma_queue_t queue );
+
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE utility function definitions
 */
@@ -2296,6 +2762,64 @@ magma_s_spmv_shift(
     magma_s_matrix y,
     magma_queue_t queue );
 
+magma_int_t
+magma_s_spmv_cpu(
+    float alpha, 
+    magma_s_matrix A, 
+    magma_s_matrix x, 
+    float beta, 
+    magma_s_matrix y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_smfirsttouch_cpu(
+    magma_s_matrix *A,
+    magma_queue_t queue );
+
+magma_int_t
+magma_s_spmv_shift_cpu(
+    float alpha, 
+    magma_s_matrix A, 
+    float lambda,
+    magma_s_matrix x, 
+    float beta, 
+    magma_int_t offset, 
+    magma_int_t blocksize,
+    magma_index_t *add_rows, 
+    magma_s_matrix y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_s_spmm_cpu(
+    float alpha, 
+    magma_s_matrix A,
+    magma_s_matrix B,
+    magma_s_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_s_spmm_symbolic_cpu(
+    magma_s_matrix A,
+    magma_s_matrix B,
+    magma_s_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_s_spmm_numeric_cpu(
+    float alpha,
+    magma_s_matrix A,
+    magma_s_matrix B,
+    magma_s_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_s_spmm_rap_cpu(
+    magma_s_matrix R,
+    magma_s_matrix A,
+    magma_s_matrix P,
+    magma_s_matrix *Ac,
+    magma_queue_t queue );
+
 magma_int_t
 magma_scuspmm(
     magma_s_matrix A, 
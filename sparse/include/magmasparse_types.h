@@ -500,6 +500,7 @@ typedef struct magma_s_vector
         double *eigenvalues;                 // feedback: array containing eigenvalues
         magmaDoubleComplex_ptr eigenvectors; // feedback: array containing eigenvectors on DEV
         magma_int_t info;                    // feedback: did the solver converge etc.
+        real_Double_t iter_bytes;            // feedback: estimated bytes moved per iteration, 0 if not tracked
 
         //---------------------------------
         // the input for verbose is:
@@ -537,6 +538,7 @@ typedef struct magma_s_vector
         float *eigenvalues;                 // feedback: array containing eigenvalues
         magmaFloatComplex_ptr eigenvectors; // feedback: array containing eigenvectors on DEV
         magma_int_t info;                   // feedback: did the solver converge etc.
+        real_Double_t iter_bytes;           // feedback: estimated bytes moved per iteration, 0 if not tracked
 
         //---------------------------------
         // the input for verbose is:
@@ -574,6 +576,7 @@ typedef struct magma_s_vector
         double *eigenvalues;          // feedback: array containing eigenvalues
         magmaDouble_ptr eigenvectors; // feedback: array containing eigenvectors on DEV
         magma_int_t info;             // feedback: did the solver converge etc.
+        real_Double_t iter_bytes;     // feedback: estimated bytes moved per iteration, 0 if not tracked
 
         //---------------------------------
         // the input for verbose is:
@@ -611,6 +614,7 @@ typedef struct magma_s_vector
         float *eigenvalues;          // feedback: array containing eigenvalues
         magmaFloat_ptr eigenvectors; // feedback: array containing eigenvectors on DEV
         magma_int_t info;            // feedback: did the solver converge etc.
+        real_Double_t iter_bytes;    // feedback: estimated bytes moved per iteration, 0 if not tracked
 
         //---------------------------------
         // the input for verbose is:
@@ -627,6 +631,19 @@ typedef struct magma_s_vector
         //--------------------------------
     } magma_s_solver_par;
 
+    //************         symbolic factorization statistics       ***************//
+
+    typedef struct magma_symbilu_stats
+    {
+        magma_int_t levels;             // level of fill
+        magma_int_t nnz;                // nonzeros of A
+        magma_int_t nnzl;               // nonzeros of the L pattern
+        magma_int_t nnzu;               // nonzeros of the U pattern
+        double fill;                    // (nnzl + nnzu) / nnz
+        real_Double_t runtime;          // symbolic setup time
+    } magma_symbilu_stats;
+
+
     //************            preconditioner parameters       ********************//
 
 #if CUDA_VERSION >= 12000
@@ -670,6 +687,7 @@ typedef struct magma_solve_info_t
         double final_res;
         real_Double_t runtime;   // feedback: preconditioner runtime needed
         real_Double_t setuptime; // feedback: preconditioner setup time needed
+        magma_symbilu_stats symbilu; // feedback: symbolic ILU(k) fill, if levels > 0
         magma_z_matrix M;
         magma_z_matrix L;
         magma_z_matrix LT;
@@ -695,6 +713,11 @@ typedef struct magma_solve_info_t
         magma_index_t *L_dgraphindegree_bak; // for sync-free trisolve
         magma_index_t *U_dgraphindegree;     // for sync-free trisolve
         magma_index_t *U_dgraphindegree_bak; // for sync-free trisolve
+        magma_int_t ncolors;                 // multicolor GS/SOR: number of colors
+        magma_index_t *color_ptr;            // multicolor GS/SOR: first row of every color in M, CPU
+        magma_index_t *perm;                 // multicolor GS/SOR: original row of every row of M
+        magma_coloring_t coloring;           // multicolor GS/SOR: coloring algorithm
+        double omega;                        // multicolor GS/SOR: relaxation parameter
 
         /* was merge conflict, assume master */
         magma_ilu_info_t cuinfoILU;
@@ -731,6 +754,7 @@ typedef struct magma_solve_info_t
         float final_res;
         real_Double_t runtime;   // feedback: preconditioner runtime needed
         real_Double_t setuptime; // feedback: preconditioner setup time needed
+        magma_symbilu_stats symbilu; // feedback: symbolic ILU(k) fill, if levels > 0
         magma_c_matrix M;
         magma_c_matrix L;
         magma_c_matrix LT;
@@ -756,6 +780,11 @@ typedef struct magma_solve_info_t
         magma_index_t *L_dgraphindegree_bak; // for sync-free trisolve
         magma_index_t *U_dgraphindegree;     // for sync-free trisolve
         magma_index_t *U_dgraphindegree_bak; // for sync-free trisolve
+        magma_int_t ncolors;                 // multicolor GS/SOR: number of colors
+        magma_index_t *color_ptr;            // multicolor GS/SOR: first row of every color in M, CPU
+        magma_index_t *perm;                 // multicolor GS/SOR: original row of every row of M
+        magma_coloring_t coloring;           // multicolor GS/SOR: coloring algorithm
+        double omega;                        // multicolor GS/SOR: relaxation parameter
 
         magma_ilu_info_t cuinfoILU;
         magma_solve_info_t cuinfoL;
@@ -791,6 +820,7 @@ typedef struct magma_solve_info_t
         double final_res;
         real_Double_t runtime;   // feedback: preconditioner runtime needed
         real_Double_t setuptime; // feedback: preconditioner setup time needed
+        magma_symbilu_stats symbilu; // feedback: symbolic ILU(k) fill, if levels > 0
         magma_d_matrix M;
         magma_d_matrix L;
         magma_d_matrix LT;
@@ -816,6 +846,11 @@ typedef struct magma_solve_info_t
         magma_index_t *L_dgraphindegree_bak; // for sync-free trisolve
         magma_index_t *U_dgraphindegree;     // for sync-free trisolve
         magma_index_t *U_dgraphindegree_bak; // for sync-free trisolve
+        magma_int_t ncolors;                 // multicolor GS/SOR: number of colors
+        magma_index_t *color_ptr;            // multicolor GS/SOR: first row of every color in M, CPU
+        magma_index_t *perm;                 // multicolor GS/SOR: original row of every row of M
+        magma_coloring_t coloring;           // multicolor GS/SOR: coloring algorithm
+        double omega;                        // multicolor GS/SOR: relaxation parameter
 
         magma_ilu_info_t cuinfoILU;
         magma_solve_info_t cuinfoL;
@@ -851,6 +886,7 @@ typedef struct magma_solve_info_t
         float final_res;
         real_Double_t runtime;   // feedback: preconditioner runtime needed
         real_Double_t setuptime; // feedback: preconditioner setup time needed
+        magma_symbilu_stats symbilu; // feedback: symbolic ILU(k) fill, if levels > 0
         magma_s_matrix M;
         magma_s_matrix L;
         magma_s_matrix LT;
@@ -876,6 +912,11 @@ typedef struct magma_solve_info_t
         magma_index_t *L_dgraphindegree_bak; // for sync-free trisolve
         magma_index_t *U_dgraphindegree;     // for sync-free trisolve
         magma_index_t *U_dgraphindegree_bak; // for sync-free trisolve
+        magma_int_t ncolors;                 // multicolor GS/SOR: number of colors
+        magma_index_t *color_ptr;            // multicolor GS/SOR: first row of every color in M, CPU
+        magma_index_t *perm;                 // multicolor GS/SOR: original row of every row of M
+        magma_coloring_t coloring;           // multicolor GS/SOR: coloring algorithm
+        double omega;                        // multicolor GS/SOR: relaxation parameter
 
         magma_ilu_info_t cuinfoILU;
         magma_solve_info_t cuinfoL;
@@ -911,6 +952,8 @@ typedef struct magma_solve_info_t
         magma_location_t input_location;
         magma_location_t output_location;
         magma_scale_t scaling;
+        magma_reorder_t reorder;
+        magma_int_t binary;
     } magma_zopts;
 
     typedef struct magma_copts
@@ -927,6 +970,8 @@ typedef struct magma_solve_info_t
         magma_location_t input_location;
         magma_location_t output_location;
         magma_scale_t scaling;
+        magma_reorder_t reorder;
+        magma_int_t binary;
     } magma_copts;
 
     typedef struct magma_dopts
@@ -943,6 +988,8 @@ typedef struct magma_solve_info_t
         magma_location_t input_location;
         magma_location_t output_location;
         magma_scale_t scaling;
+        magma_reorder_t reorder;
+        magma_int_t binary;
     } magma_dopts;
 
     typedef struct magma_sopts
@@ -959,6 +1006,8 @@ typedef struct magma_solve_info_t
         magma_location_t input_location;
         magma_location_t output_location;
         magma_scale_t scaling;
+        magma_reorder_t reorder;
+        magma_int_t binary;
     } magma_sopts;
 
 #ifdef __cplusplus
@@ -97,6 +97,17 @@ magma_z_csr_mtx(
     const char *filename,
     magma_queue_t queue );
 
+magma_int_t 
+magma_z_csr_binary( 
+    magma_z_matrix *A, 
+    const char *filename,
+    magma_queue_t queue );
+
+magma_int_t 
+magma_zmunmap( 
+    magma_z_matrix *A, 
+    magma_queue_t queue );
+
 magma_int_t 
 magma_zcsrset( 
     magma_int_t m, 
@@ -441,6 +452,41 @@ magma_zsymbilu(
     magma_z_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_zsymbilu_stats(
+    magma_z_matrix *A,
+    magma_int_t levels,
+    magma_z_matrix *L,
+    magma_z_matrix *U,
+    magma_symbilu_stats *stats,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zsymbolic_ilu(
+    const magma_int_t levfill,
+    const magma_int_t n,
+    magma_int_t *nzl,
+    magma_int_t *nzu,
+    const magma_index_t *ia,
+    const magma_index_t *ja,
+    magma_index_t *ial,
+    magma_index_t *jal,
+    magma_index_t *iau,
+    magma_index_t *jau );
+
+magma_int_t
+magma_zsymbolic_ilu_list(
+    const magma_int_t levfill,
+    const magma_int_t n,
+    magma_int_t *nzl,
+    magma_int_t *nzu,
+    const magma_index_t *ia,
+    const magma_index_t *ja,
+    magma_index_t *ial,
+    magma_index_t *jal,
+    magma_index_t *iau,
+    magma_index_t *jau );
+
 
 magma_int_t 
 magma_zwrite_csr_mtx( 
@@ -449,6 +495,12 @@ magma_zwrite_csr_mtx(
  const char *filename,
     magma_queue_t queue );
 
+magma_int_t 
+magma_zwrite_csr_binary( 
+    magma_z_matrix A,
+    const char *filename,
+    magma_queue_t queue );
+
 magma_int_t 
 magma_zwrite_vector( 
     magma_z_matrix A,
@@ -1178,6 +1230,14 @@ magma_zparilut_residuals(
     magma_z_matrix *L_new,
     magma_queue_t queue );
 
+magma_int_t
+magma_zparilut_residual_norm(
+    magma_z_matrix A,
+    magma_z_matrix L,
+    magma_z_matrix U,
+    double *res,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zparilut_residuals_transpose(
     magma_z_matrix A,
@@ -1250,6 +1310,13 @@ magma_zparict(
     magma_z_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_zparict_update(
+    magma_z_matrix A,
+    magma_z_preconditioner *precond,
+    magma_int_t updates,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zparict_cpu(
     magma_z_matrix A,
@@ -1264,6 +1331,13 @@ magma_zparilut(
     magma_z_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_zparilut_update(
+    magma_z_matrix A,
+    magma_z_preconditioner *precond,
+    magma_int_t updates,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zparilut_cpu(
     magma_z_matrix A,
@@ -1443,6 +1517,22 @@ magma_zsampleselect_approx_nodp(
     magma_int_t *tmp_size,
     magma_queue_t queue );
 
+magma_int_t
+magma_zsampleselect_cpu(
+    magma_int_t total_size,
+    magma_int_t subset_size,
+    magmaDoubleComplex *val,
+    double *thrs,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zsampleselect_approx_cpu(
+    magma_int_t total_size,
+    magma_int_t subset_size,
+    magmaDoubleComplex *val,
+    double *thrs,
+    magma_queue_t queue );
+
 
 // ISAI preconditioner
 
@@ -1484,6 +1574,15 @@ magma_zmbackinsert_batched(
     magmaDoubleComplex *rhs,    
     magma_queue_t queue );
 
+magma_int_t
+magma_zisai_generator_cpu(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_z_matrix L,
+    magma_z_matrix *M,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zmprepare_batched_gpu(
     magma_uplo_t uplotype,
@@ -1603,11 +1702,305 @@ magma_zcsr_sort_gpu(
     magma_z_matrix *A,
     magma_queue_t queue);
 
+magma_int_t
+magma_zcsr_sort_rows(
+    magma_int_t num_rows,
+    const magma_index_t *row,
+    magma_index_t *col,
+    magmaDoubleComplex *val,
+    magma_queue_t queue );
+
 // #endif
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE function definitions / Data on CPU
 */
 
+magmaDoubleComplex
+magma_zdotc_cpu(
+    magma_int_t n,
+    const magmaDoubleComplex *x,
+    const magmaDoubleComplex *y );
+
+void
+magma_zdotc2_cpu(
+    magma_int_t n,
+    const magmaDoubleComplex *v0,
+    const magmaDoubleComplex *w0,
+    const magmaDoubleComplex *v1,
+    const magmaDoubleComplex *w1,
+    magmaDoubleComplex *skp );
+
+magma_int_t
+magma_zmdotc_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    const magmaDoubleComplex *v,
+    const magmaDoubleComplex *r,
+    magmaDoubleComplex *skp );
+
+void
+magma_zmaxpy_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    magmaDoubleComplex alpha,
+    const magmaDoubleComplex *v,
+    const magmaDoubleComplex *c,
+    magmaDoubleComplex beta,
+    magmaDoubleComplex *y );
+
+double
+magma_dznrm2_cpu(
+    magma_int_t n,
+    const magmaDoubleComplex *x );
+
+void
+magma_zaxpby_cpu(
+    magma_int_t n,
+    magmaDoubleComplex alpha,
+    const magmaDoubleComplex *x,
+    magmaDoubleComplex beta,
+    magmaDoubleComplex *y );
+
+void
+magma_zcopy_cpu(
+    magma_int_t n,
+    const magmaDoubleComplex *x,
+    magmaDoubleComplex *y );
+
+void
+magma_zdiagscal_cpu(
+    magma_int_t n,
+    const magmaDoubleComplex *d,
+    const magmaDoubleComplex *b,
+    magmaDoubleComplex *x );
+
+double
+magma_zmergebytes_cpu(
+    magma_z_matrix A );
+
+void
+magma_zcgmerge_spmv_cpu(
+    magma_z_matrix A,
+    magmaDoubleComplex beta,
+    const magmaDoubleComplex *r,
+    const magmaDoubleComplex *p,
+    magmaDoubleComplex *pn,
+    magmaDoubleComplex *q,
+    magmaDoubleComplex *skp );
+
+void
+magma_zcgmerge_xr_cpu(
+    magma_int_t n,
+    magmaDoubleComplex alpha,
+    const magmaDoubleComplex *p,
+    const magmaDoubleComplex *q,
+    magmaDoubleComplex *x,
+    magmaDoubleComplex *r,
+    magmaDoubleComplex *skp );
+
+void
+magma_zbicgmerge_spmv1_cpu(
+    magma_z_matrix A,
+    magmaDoubleComplex beta,
+    magmaDoubleComplex omega,
+    const magmaDoubleComplex *r,
+    const magmaDoubleComplex *rr,
+    const magmaDoubleComplex *p,
+    const magmaDoubleComplex *v,
+    magmaDoubleComplex *pn,
+    magmaDoubleComplex *vn,
+    magmaDoubleComplex *skp );
+
+void
+magma_zbicgmerge_spmv2_cpu(
+    magma_z_matrix A,
+    magmaDoubleComplex alpha,
+    const magmaDoubleComplex *r,
+    const magmaDoubleComplex *v,
+    magmaDoubleComplex *s,
+    magmaDoubleComplex *t,
+    magmaDoubleComplex *skp );
+
+void
+magma_zbicgmerge_xr_cpu(
+    magma_int_t n,
+    magmaDoubleComplex alpha,
+    magmaDoubleComplex omega,
+    const magmaDoubleComplex *p,
+    const magmaDoubleComplex *s,
+    const magmaDoubleComplex *t,
+    const magmaDoubleComplex *rr,
+    magmaDoubleComplex *x,
+    magmaDoubleComplex *r,
+    magmaDoubleComplex *skp );
+
+void
+magma_ztfqmrmerge_1_cpu(
+    magma_int_t n,
+    magma_int_t odd,
+    magmaDoubleComplex alpha,
+    magmaDoubleComplex sigma,
+    const magmaDoubleComplex *v,
+    const magmaDoubleComplex *Au,
+    const magmaDoubleComplex *u_m,
+    const magmaDoubleComplex *r_tld,
+    magmaDoubleComplex *u_mp1,
+    magmaDoubleComplex *w,
+    magmaDoubleComplex *d,
+    magmaDoubleComplex *Ad,
+    magmaDoubleComplex *skp );
+
+void
+magma_ztfqmrmerge_2_cpu(
+    magma_int_t n,
+    magma_int_t even,
+    magmaDoubleComplex eta,
+    magmaDoubleComplex beta,
+    const magmaDoubleComplex *d,
+    const magmaDoubleComplex *Ad,
+    const magmaDoubleComplex *w,
+    const magmaDoubleComplex *u_m,
+    const magmaDoubleComplex *Au,
+    magmaDoubleComplex *x,
+    magmaDoubleComplex *r,
+    magmaDoubleComplex *u_mp1,
+    magmaDoubleComplex *v,
+    magmaDoubleComplex *skp );
+
+void
+magma_ztfqmrmerge_spmv_cpu(
+    magma_z_matrix A,
+    magma_int_t even,
+    const magmaDoubleComplex *u_mp1,
+    const magmaDoubleComplex *r_tld,
+    magmaDoubleComplex *Au,
+    magmaDoubleComplex *v,
+    magmaDoubleComplex *skp );
+
+magma_int_t
+magma_zidrmerge_spmv_cpu(
+    magma_z_matrix A,
+    magma_int_t s,
+    const magmaDoubleComplex *P,
+    magma_int_t dots,
+    const magmaDoubleComplex *x,
+    magmaDoubleComplex *y,
+    magmaDoubleComplex *skp );
+
+void
+magma_zidrmerge_update_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    const magmaDoubleComplex *alpha,
+    magmaDoubleComplex beta,
+    const magmaDoubleComplex *G,
+    const magmaDoubleComplex *U,
+    magmaDoubleComplex *g,
+    magmaDoubleComplex *u,
+    magmaDoubleComplex *r,
+    magmaDoubleComplex *x,
+    const magmaDoubleComplex *rs,
+    magmaDoubleComplex *skp );
+
+void
+magma_zidrmerge_dir_cpu(
+    magma_int_t n,
+    magma_int_t k,
+    magmaDoubleComplex omega,
+    const magmaDoubleComplex *c,
+    const magmaDoubleComplex *r,
+    const magmaDoubleComplex *G,
+    const magmaDoubleComplex *U,
+    magmaDoubleComplex *u );
+
+void
+magma_zidrmerge_smooth_cpu(
+    magma_int_t n,
+    magmaDoubleComplex gamma,
+    const magmaDoubleComplex *r,
+    const magmaDoubleComplex *x,
+    magmaDoubleComplex *rs,
+    magmaDoubleComplex *xs,
+    magmaDoubleComplex *skp );
+
+magma_int_t
+magma_zjacobisetup_diagscal_cpu(
+    magma_z_matrix A, magma_z_matrix *d,
+    magma_queue_t queue );
+
+magma_int_t
+magma_z_precondsetup_cpu(
+    magma_z_matrix A,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_z_applyprecond_cpu(
+    magma_trans_t trans,
+    magma_z_matrix b,
+    magma_z_matrix *x,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zcg_cpu(
+    magma_z_matrix A, magma_z_matrix b, magma_z_matrix *x,
+    magma_z_solver_par *solver_par,
+    magma_z_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zbicgstab_cpu(
+    magma_z_matrix A, magma_z_matrix b, magma_z_matrix *x,
+    magma_z_solver_par *solver_par,
+    magma_z_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zfgmres_cpu(
+    magma_z_matrix A, magma_z_matrix b, magma_z_matrix *x,
+    magma_z_solver_par *solver_par,
+    magma_z_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zidr_cpu(
+    magma_z_matrix A, magma_z_matrix b, magma_z_matrix *x,
+    magma_z_solver_par *solver_par,
+    magma_z_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zqmr_cpu(
+    magma_z_matrix A, magma_z_matrix b, magma_z_matrix *x,
+    magma_z_solver_par *solver_par,
+    magma_z_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zcg_merge_cpu(
+    magma_z_matrix A, magma_z_matrix b, magma_z_matrix *x,
+    magma_z_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zbicgstab_merge_cpu(
+    magma_z_matrix A, magma_z_matrix b, magma_z_matrix *x,
+    magma_z_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ztfqmr_merge_cpu(
+    magma_z_matrix A, magma_z_matrix b, magma_z_matrix *x,
+    magma_z_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zidr_merge_cpu(
+    magma_z_matrix A, magma_z_matrix b, magma_z_matrix *x,
+    magma_z_solver_par *solver_par,
+    magma_queue_t queue );
+
 
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE supernodal and RCM reordering
@@ -1628,6 +2021,43 @@ magma_zmvarsizeblockstruct(
     magma_z_matrix *A,
     magma_queue_t queue );
 
+magma_int_t
+magma_zmreorder(
+    magma_z_matrix A,
+    magma_reorder_t order,
+    magma_index_t **perm,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zmpermute(
+    magma_z_matrix A,
+    const magma_index_t *perm,
+    magma_z_matrix *B,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zvpermute(
+    magma_z_matrix x,
+    const magma_index_t *perm,
+    magma_z_matrix *y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zvpermute_inverse(
+    magma_z_matrix x,
+    const magma_index_t *perm,
+    magma_z_matrix *y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zmcolor(
+    magma_z_matrix A,
+    magma_coloring_t method,
+    magma_int_t *ncolors,
+    magma_index_t **perm,
+    magma_index_t **color_ptr,
+    magma_queue_t queue );
+
 
 
 /* ////////////////////////////////////////////////////////////////////////////
@@ -2260,6 +2690,42 @@ magma_zbajac_csr_overlap(
     magma_z_matrix *x,
     magma_queue_t queue );
 
+// multicolor Gauss-Seidel / SOR
+
+magma_int_t
+magma_zmcsorsetup(
+    magma_z_matrix A,
+    magma_location_t location,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zmcsor_smooth(
+    magma_z_matrix b,
+    magma_z_matrix *x,
+    magma_int_t sweeps,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zmcsor(
+    magma_z_matrix b,
+    magma_z_matrix *x,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zmcsor_sweep(
+    magma_int_t first,
+    magma_int_t last,
+    magmaDoubleComplex omega,
+    magma_z_matrix M,
+    magma_z_matrix d,
+    magma_index_t *perm,
+    magma_z_matrix b,
+    magma_z_matrix *x,
+    magma_queue_t queue );
+
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE utility function definitions
 */
@@ -2296,6 +2762,64 @@ magma_z_spmv_shift(
     magma_z_matrix y,
     magma_queue_t queue );
 
+magma_int_t
+magma_z_spmv_cpu(
+    magmaDoubleComplex alpha, 
+    magma_z_matrix A, 
+    magma_z_matrix x, 
+    magmaDoubleComplex beta, 
+    magma_z_matrix y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zmfirsttouch_cpu(
+    magma_z_matrix *A,
+    magma_queue_t queue );
+
+magma_int_t
+magma_z_spmv_shift_cpu(
+    magmaDoubleComplex alpha, 
+    magma_z_matrix A, 
+    magmaDoubleComplex lambda,
+    magma_z_matrix x, 
+    magmaDoubleComplex beta, 
+    magma_int_t offset, 
+    magma_int_t blocksize,
+    magma_index_t *add_rows, 
+    magma_z_matrix y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_z_spmm_cpu(
+    magmaDoubleComplex alpha, 
+    magma_z_matrix A,
+    magma_z_matrix B,
+    magma_z_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_z_spmm_symbolic_cpu(
+    magma_z_matrix A,
+    magma_z_matrix B,
+    magma_z_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_z_spmm_numeric_cpu(
+    magmaDoubleComplex alpha,
+    magma_z_matrix A,
+    magma_z_matrix B,
+    magma_z_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_z_spmm_rap_cpu(
+    magma_z_matrix R,
+    magma_z_matrix A,
+    magma_z_matrix P,
+    magma_z_matrix *Ac,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zcuspmm(
     magma_z_matrix A, 
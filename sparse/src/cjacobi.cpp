@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zjacobi.cpp, normal z -> c, Wed Feb 22 15:21:54 2023
+       @generated from sparse/src/zjacobi.cpp, normal z -> c, Sun Oct 18 03:18:38 2026
 */
 
 #include "magmasparse_internal.h"
@@ -350,6 +350,75 @@ cleanup:
 }
 
 
+/**
+    Purpose
+    -------
+
+    Host variant of magma_cjacobisetup_diagscal: returns a vector d in
+    host memory containing the inverse diagonal elements of a CSR matrix
+    in host memory.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                input matrix A in CSR format on the CPU
+
+    @param[in,out]
+    d           magma_c_matrix*
+                vector with inverse diagonal elements
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_c
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cjacobisetup_diagscal_cpu(
+    magma_c_matrix A, magma_c_matrix *d,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_int_t zero_row = -1;
+
+    if ( A.memory_location != Magma_CPU ||
+         ( A.storage_type != Magma_CSR && A.storage_type != Magma_CSRCOO ) ) {
+        printf( "error: format not supported.\n" );
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
+    CHECK( magma_cvinit( d, Magma_CPU, A.num_rows, 1, MAGMA_C_ZERO, queue ));
+
+    #pragma omp parallel for
+    for( magma_int_t rowindex=0; rowindex < A.num_rows; rowindex++ ) {
+        for( magma_int_t i=A.row[rowindex]; i < A.row[rowindex+1]; i++ ) {
+            if ( A.col[i] == rowindex ) {
+                d->val[rowindex] = MAGMA_C_ONE / A.val[i];
+                break;
+            }
+        }
+    }
+    for( magma_int_t rowindex=0; rowindex < A.num_rows; rowindex++ ) {
+        if ( MAGMA_C_EQUAL( d->val[rowindex], MAGMA_C_ZERO ) ) {
+            zero_row = rowindex;
+            break;
+        }
+    }
+    if ( zero_row >= 0 ) {
+        printf(" error: zero diagonal element in row %d!\n", int(zero_row));
+        magma_cmfree( d, queue );
+        info = MAGMA_ERR_BADPRECOND;
+    }
+
+cleanup:
+    return info;
+}
+
+
 
 /**
     Purpose
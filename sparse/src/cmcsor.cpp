@@ -0,0 +1,315 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @generated from sparse/src/zmcsor.cpp, normal z -> c, Sun Oct 18 03:59:12 2026
+       @author Hartwig Anzt
+
+       Multicolor Gauss-Seidel, symmetric Gauss-Seidel, SOR and SSOR.
+       The rows of A are stored in color order in precond->M, so every color
+       is one parallel sweep over contiguous rows. Vectors stay in the
+       original order, row k of M updates entry perm[k].
+*/
+#include "magmasparse_internal.h"
+
+
+/*******************************************************************************
+    Host version of magma_cmcsor_sweep.
+*/
+static void
+magma_cmcsor_sweep_cpu(
+    magma_int_t first,
+    magma_int_t last,
+    magmaFloatComplex omega,
+    magma_c_matrix M,
+    magma_c_matrix d,
+    const magma_index_t *perm,
+    magma_c_matrix b,
+    magma_c_matrix *x )
+{
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t k=first; k < last; k++ ) {
+        magma_index_t i = perm[k];
+        magmaFloatComplex r = b.val[i];
+        for( magma_int_t j=M.row[k]; j < M.row[k+1]; j++ ) {
+            r -= M.val[j] * x->val[ M.col[j] ];
+        }
+        x->val[i] += omega * d.val[k] * r;
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Prepares the multicolor Gauss-Seidel type smoothers Magma_GS, Magma_SGS,
+    Magma_SOR and Magma_SSOR: colors the graph of A with precond->coloring,
+    stores the rows of A in color order in precond->M and their inverse
+    diagonal entries in precond->d.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                square system matrix in any format and memory location
+
+    @param[in]
+    location    magma_location_t
+                memory location in which the smoother is applied
+
+    @param[in,out]
+    precond     magma_c_preconditioner*
+                preconditioner
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_cgepr
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cmcsorsetup(
+    magma_c_matrix A,
+    magma_location_t location,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_c_matrix hA={Magma_CSR}, CSRA={Magma_CSR}, hM={Magma_CSR}, hd={Magma_CSR};
+    magma_index_t *order = NULL, *color_ptr = NULL, *dperm = NULL;
+    magma_int_t ncolors = 0;
+    magma_int_t n = A.num_rows;
+
+    if ( precond->coloring != Magma_GREEDYCOLOR ) {
+        precond->coloring = Magma_JPCOLOR;
+    }
+    if ( ! ( precond->omega > 0.0 && precond->omega < 2.0 ) ) {
+        printf( "%% warning: relaxation parameter outside (0,2), use 1.0.\n" );
+        precond->omega = 1.0;
+    }
+
+    CHECK( magma_cmtransfer( A, &hA, A.memory_location, Magma_CPU, queue ));
+    CHECK( magma_cmconvert( hA, &CSRA, hA.storage_type, Magma_CSR, queue ));
+    CHECK( magma_cmcolor( CSRA, precond->coloring, &ncolors, &order, &color_ptr, queue ));
+
+    // rows in color order, columns unchanged
+    hM.storage_type = Magma_CSR;
+    hM.memory_location = Magma_CPU;
+    hM.num_rows = n;
+    hM.num_cols = n;
+    hM.nnz = CSRA.nnz;
+    hM.true_nnz = CSRA.nnz;
+    CHECK( magma_index_malloc_cpu( &hM.row, n+1 ));
+    CHECK( magma_index_malloc_cpu( &hM.col, CSRA.nnz ));
+    CHECK( magma_cmalloc_cpu( &hM.val, CSRA.nnz ));
+    CHECK( magma_cvinit( &hd, Magma_CPU, n, 1, MAGMA_C_ZERO, queue ));
+    hM.row[0] = 0;
+    for( magma_int_t k=0; k < n; k++ ) {
+        hM.row[k+1] = hM.row[k] + CSRA.row[ order[k]+1 ] - CSRA.row[ order[k] ];
+    }
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for( magma_int_t k=0; k < n; k++ ) {
+        magma_index_t i = order[k];
+        magma_index_t l = hM.row[k];
+        for( magma_int_t j=CSRA.row[i]; j < CSRA.row[i+1]; j++ ) {
+            hM.col[l] = CSRA.col[j];
+            hM.val[l] = CSRA.val[j];
+            if ( CSRA.col[j] == i && CSRA.val[j] != MAGMA_C_ZERO ) {
+                hd.val[k] = MAGMA_C_ONE / CSRA.val[j];
+            }
+            l++;
+        }
+    }
+    for( magma_int_t k=0; k < n; k++ ) {
+        if ( hd.val[k] == MAGMA_C_ZERO ) {
+            printf( " error: zero diagonal element in row %d!\n", int(order[k]) );
+            info = MAGMA_ERR_BADPRECOND;
+            goto cleanup;
+        }
+    }
+
+    if ( location == Magma_DEV ) {
+        CHECK( magma_cmtransfer( hM, &precond->M, Magma_CPU, Magma_DEV, queue ));
+        CHECK( magma_cmtransfer( hd, &precond->d, Magma_CPU, Magma_DEV, queue ));
+        CHECK( magma_index_malloc( &dperm, n ));
+        magma_index_setvector( n, order, 1, dperm, 1, queue );
+        magma_free_cpu( order );
+        order = dperm;
+        dperm = NULL;
+    } else {
+        precond->M = hM;
+        precond->d = hd;
+        hM = {Magma_CSR};
+        hd = {Magma_CSR};
+    }
+    precond->perm = order;
+    precond->color_ptr = color_ptr;
+    precond->ncolors = ncolors;
+    order = NULL;
+    color_ptr = NULL;
+
+cleanup:
+    if ( info != 0 ) {
+        magma_free_cpu( order );
+    }
+    magma_free( dperm );
+    magma_free_cpu( color_ptr );
+    magma_cmfree( &hA, queue );
+    magma_cmfree( &CSRA, queue );
+    magma_cmfree( &hM, queue );
+    magma_cmfree( &hd, queue );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Applies sweeps steps of the multicolor smoother set up by
+    magma_cmcsorsetup to A x = b, starting from the given x:
+
+    Magma_GS    forward Gauss-Seidel
+    Magma_SOR   forward SOR with precond->omega
+    Magma_SGS   forward and backward Gauss-Seidel
+    Magma_SSOR  forward and backward SOR with precond->omega
+
+    b and x are single vectors in the memory location of the smoother.
+
+    Arguments
+    ---------
+
+    @param[in]
+    b           magma_c_matrix
+                right-hand side
+
+    @param[in,out]
+    x           magma_c_matrix*
+                iteration vector
+
+    @param[in]
+    sweeps      magma_int_t
+                number of smoothing steps
+
+    @param[in]
+    precond     magma_c_preconditioner*
+                preconditioner
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_cgepr
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cmcsor_smooth(
+    magma_c_matrix b,
+    magma_c_matrix *x,
+    magma_int_t sweeps,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_int_t nc = precond->ncolors;
+    magma_index_t *cptr = precond->color_ptr;
+    magma_int_t symmetric = ( precond->solver == Magma_SGS ||
+                              precond->solver == Magma_SSOR );
+    magmaFloatComplex omega = ( precond->solver == Magma_SOR ||
+                                 precond->solver == Magma_SSOR ) ?
+                               MAGMA_C_MAKE( precond->omega, 0.0 ) : MAGMA_C_ONE;
+
+    if ( cptr == NULL ) {
+        printf( "error: multicolor smoother not set up.\n" );
+        info = MAGMA_ERR_BADPRECOND;
+        goto cleanup;
+    }
+
+    for( magma_int_t s=0; s < sweeps; s++ ) {
+        for( magma_int_t c=0; c < nc; c++ ) {
+            if ( precond->M.memory_location == Magma_CPU ) {
+                magma_cmcsor_sweep_cpu( cptr[c], cptr[c+1], omega, precond->M,
+                                        precond->d, precond->perm, b, x );
+            } else {
+                CHECK( magma_cmcsor_sweep( cptr[c], cptr[c+1], omega, precond->M,
+                                           precond->d, precond->perm, b, x, queue ));
+            }
+        }
+        for( magma_int_t c=nc-1; c >= 0 && symmetric; c-- ) {
+            if ( precond->M.memory_location == Magma_CPU ) {
+                magma_cmcsor_sweep_cpu( cptr[c], cptr[c+1], omega, precond->M,
+                                        precond->d, precond->perm, b, x );
+            } else {
+                CHECK( magma_cmcsor_sweep( cptr[c], cptr[c+1], omega, precond->M,
+                                           precond->d, precond->perm, b, x, queue ));
+            }
+        }
+    }
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Applies the multicolor smoother as preconditioner: x = M^{-1} b with
+    precond->maxiter sweeps starting from x = 0. For Magma_SGS and
+    Magma_SSOR the preconditioner is symmetric if A is symmetric.
+
+    Arguments
+    ---------
+
+    @param[in]
+    b           magma_c_matrix
+                right-hand side
+
+    @param[out]
+    x           magma_c_matrix*
+                preconditioned vector
+
+    @param[in]
+    precond     magma_c_preconditioner*
+                preconditioner
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_cgepr
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cmcsor(
+    magma_c_matrix b,
+    magma_c_matrix *x,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_int_t n = b.num_rows;
+
+    if ( precond->M.memory_location == Magma_CPU ) {
+        for( magma_int_t i=0; i < n; i++ ) {
+            x->val[i] = MAGMA_C_ZERO;
+        }
+    } else {
+        magmablas_claset( MagmaFull, n, 1, MAGMA_C_ZERO, MAGMA_C_ZERO,
+                          x->dval, n, queue );
+    }
+    CHECK( magma_cmcsor_smooth( b, x, max( 1, precond->maxiter ), precond, queue ));
+
+cleanup:
+    return info;
+}
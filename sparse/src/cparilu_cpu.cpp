@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparilu_cpu.cpp, normal z -> c, Wed Feb 22 15:21:58 2023
+       @generated from sparse/src/zparilu_cpu.cpp, normal z -> c, Sun Oct 18 06:54:12 2026
 */
 
 #include "magmasparse_internal.h"
@@ -78,7 +78,7 @@ magma_cparilu_cpu(
 
     // in case using fill-in
     if (precond->levels > 0) {
-        CHECK(magma_csymbilu(&hA, precond->levels, &hAL, &hAUT,  queue));
+        CHECK(magma_csymbilu_stats(&hA, precond->levels, &hAL, &hAUT, &precond->symbilu, queue));
         magma_cmfree(&hAL, queue);
         magma_cmfree(&hAUT, queue);
     }
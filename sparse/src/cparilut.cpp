@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparilut.cpp, normal z -> c, Wed Feb 22 15:21:59 2023
+       @generated from sparse/src/zparilut.cpp, normal z -> c, Sun Oct 18 06:54:12 2026
 */
 
 #include "magmasparse_internal.h"
@@ -25,59 +25,77 @@
   #define hipblasComplex hipFloatComplex
 #endif
 
+#ifdef _OPENMP
 /***************************************************************************//**
     Purpose
     -------
+    Moves the factors of a previous ParILUT setup in precond to the host,
+    as the initial guess of magma_cparilut_update: L, and U transposed,
+    both with row index. Frees the data of precond computed from them,
+    including the ISAI matrices and the transposed factors;
+    it is set up again from the updated factors.
+*******************************************************************************/
+static magma_int_t
+magma_cparilut_warmstart(
+    magma_c_preconditioner *precond,
+    magma_c_matrix *L,
+    magma_c_matrix *U,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_c_matrix UT={Magma_CSR};
+
+    CHECK( magma_cmtransfer( precond->L, L, precond->L.memory_location, Magma_CPU, queue ));
+    CHECK( magma_cmtransfer( precond->U, &UT, precond->U.memory_location, Magma_CPU, queue ));
+    CHECK( magma_cmtranspose( UT, U, queue ));
+    L->rowidx = NULL;
+    U->rowidx = NULL;
+    CHECK( magma_cmatrix_addrowindex( L, queue ));
+    CHECK( magma_cmatrix_addrowindex( U, queue ));
+
+    magma_cmfree( &precond->L, queue );
+    magma_cmfree( &precond->U, queue );
+    magma_cmfree( &precond->LD, queue );
+    magma_cmfree( &precond->UD, queue );
+    magma_cmfree( &precond->d, queue );
+    magma_cmfree( &precond->d2, queue );
+    magma_cmfree( &precond->work1, queue );
+    magma_cmfree( &precond->work2, queue );
+    magma_trisolve_free( &precond->cuinfoL );
+    magma_trisolve_free( &precond->cuinfoU );
+    if( precond->LT.nnz > 0 ){
+        magma_cmfree( &precond->LT, queue );
+        magma_cmfree( &precond->UT, queue );
+        magma_cmfree( &precond->LDT, queue );
+        magma_cmfree( &precond->UDT, queue );
+        magma_trisolve_free( &precond->cuinfoLT );
+        magma_trisolve_free( &precond->cuinfoUT );
+    }
 
-    Prepares the iterative threshold Incomplete LU preconditioner. The strategy
-    is interleaving a parallel fixed-point iteration that approximates an
-    incomplete factorization for a given nonzero pattern with a procedure that
-    adaptively changes the pattern. Much of this new algorithm has fine-grained
-    parallelism, and we show that it can efficiently exploit the compute power
-    of shared memory architectures.
-
-    This is the routine used in the publication by Anzt, Chow, Dongarra:
-    ''ParILUT - A new parallel threshold ILU factorization''
-    submitted to SIAM SISC in 2017.
-
-    This function requires OpenMP, and is only available if OpenMP is activated.
-    
-    The parameter list is:
-    
-    precond.sweeps : number of ParILUT steps
-    precond.atol   : absolute fill ratio (1.0 keeps nnz constant)
-    precond.rtol   : how many candidates are added to the sparsity pattern
-                        * 1.0 one per row
-                        * < 1.0 a fraction of those
-                        * > 1.0 all candidates
-
-    Arguments
-    ---------
-
-    @param[in]
-    A           magma_c_matrix
-                input matrix A
-
-    @param[in]
-    b           magma_c_matrix
-                input RHS b
-
-    @param[in,out]
-    precond     magma_c_preconditioner*
-                preconditioner parameters
+cleanup:
+    magma_cmfree( &UT, queue );
+    return info;
+}
+#endif
 
-    @param[in]
-    queue       magma_queue_t
-                Queue to execute in.
 
-    @ingroup magmasparse_cgepr
+/***************************************************************************//**
+    Purpose
+    -------
+    ParILUT iterations of magma_cparilut and magma_cparilut_update.
+    The initial guess is the lower and upper triangular part of A, or,
+    if warmstart, the factors in precond. In the latter case, the number of
+    nonzeros of the factors is kept, the ILU residual norm before and
+    after the iterations is returned in precond->init_res and
+    precond->final_res, and the ISAI matrices and transposed factors of
+    the setup are computed again.
 *******************************************************************************/
-extern "C"
-magma_int_t
-magma_cparilut(
+static magma_int_t
+magma_cparilut_iterate(
     magma_c_matrix A,
-    magma_c_matrix b,
     magma_c_preconditioner *precond,
+    magma_int_t sweeps,
+    bool warmstart,
     magma_queue_t queue )
 {
     magma_int_t info = 0;
@@ -104,6 +122,8 @@ magma_cparilut(
 
     magma_int_t num_threads, timing = 1; // print timing
     magma_int_t L0nnz, U0nnz;
+    float fill = precond->atol;
+    bool transposed = false;
 
     #pragma omp parallel
     {
@@ -114,61 +134,77 @@ magma_cparilut(
     CHECK( magma_cmtransfer( A, &hA, A.memory_location, Magma_CPU, queue ));
     CHECK( magma_cmtransfer( A, &A0, A.memory_location, Magma_CPU, queue ));
 
+    if( warmstart ){
+        // start from the previous factors, and keep their number of nonzeros;
+        // the candidates come from the pattern of A
+        transposed = ( precond->LT.nnz > 0 );
+        CHECK( magma_cparilut_warmstart( precond, &L, &U, queue ));
+        CHECK( magma_cmatrix_tril( hA, &L0, queue ));
+        CHECK( magma_cmatrix_triu( hA, &U0, queue ));
+        CHECK( magma_cmtransfer( L0, &oneL, Magma_CPU, Magma_CPU, queue ));
+        L0nnz = L.nnz;
+        U0nnz = U.nnz;
+        fill = 1.0;
+        CHECK( magma_cparilut_residual_norm( A0, L, U, &precond->init_res, queue ));
+        // adapt the values to the new A before changing the pattern
+        CHECK( magma_cparilut_sweep_sync( &A0, &L, &U, queue ) );
+    } else {
         // in case using fill-in
-    if( precond->levels > 0 ){
-        CHECK( magma_csymbilu( &hA, precond->levels, &hL, &hU , queue ));
-    }
-    magma_cmfree(&hU, queue );
-    magma_cmfree(&hL, queue );
-    L.diagorder_type = Magma_VALUE;
-    magma_cmatrix_tril( hA, &L, queue );
-    magma_cmtranspose(hA, &hAT, queue );
-    U.diagorder_type = Magma_UNITY;
-    magma_cmatrix_tril( hAT, &U, queue );
-    for ( magma_int_t z=0; z<U.num_rows; z++ ){
-        U.val[U.row[z+1]-1] = MAGMA_C_ONE;        
-    }
+        if( precond->levels > 0 ){
+            CHECK( magma_csymbilu_stats( &hA, precond->levels, &hL, &hU, &precond->symbilu, queue ));
+        }
+        magma_cmfree(&hU, queue );
+        magma_cmfree(&hL, queue );
+        L.diagorder_type = Magma_VALUE;
+        magma_cmatrix_tril( hA, &L, queue );
+        magma_cmtranspose(hA, &hAT, queue );
+        U.diagorder_type = Magma_UNITY;
+        magma_cmatrix_tril( hAT, &U, queue );
+        for ( magma_int_t z=0; z<U.num_rows; z++ ){
+            U.val[U.row[z+1]-1] = MAGMA_C_ONE;        
+        }
 
-    CHECK( magma_cmtranspose( U, &UT, queue) );
-    L.rowidx = NULL;
-    UT.rowidx = NULL;
-    magma_cmatrix_addrowindex( &L, queue ); 
-    magma_cmatrix_addrowindex( &U, queue ); 
-    //CHECK( magma_cparilut_sweep( &A0, &L, &UT, queue ) );
-    //CHECK( magma_cparilut_sweep( &A0, &L, &UT, queue ) );
-    //CHECK( magma_cparilut_sweep( &A0, &L, &UT, queue ) );
-    //CHECK( magma_cparilut_sweep( &A0, &L, &UT, queue ) );
-    //CHECK( magma_cparilut_sweep( &A0, &L, &UT, queue ) );
-    L0nnz=L.nnz;
-    U0nnz=U.nnz;
+        CHECK( magma_cmtranspose( U, &UT, queue) );
+        L.rowidx = NULL;
+        UT.rowidx = NULL;
+        magma_cmatrix_addrowindex( &L, queue ); 
+        magma_cmatrix_addrowindex( &U, queue ); 
+        //CHECK( magma_cparilut_sweep( &A0, &L, &UT, queue ) );
+        //CHECK( magma_cparilut_sweep( &A0, &L, &UT, queue ) );
+        //CHECK( magma_cparilut_sweep( &A0, &L, &UT, queue ) );
+        //CHECK( magma_cparilut_sweep( &A0, &L, &UT, queue ) );
+        //CHECK( magma_cparilut_sweep( &A0, &L, &UT, queue ) );
+        L0nnz=L.nnz;
+        U0nnz=U.nnz;
         
-    // need only lower triangular
-    magma_cmfree(&U, queue );
-    CHECK( magma_cmtranspose( UT, &U, queue) );
-    CHECK( magma_cmtransfer( L, &L0, A.memory_location, Magma_CPU, queue ));
-    CHECK( magma_cmtransfer( L, &oneL, A.memory_location, Magma_CPU, queue ));
-    CHECK( magma_cmtransfer( UT, &U0, A.memory_location, Magma_CPU, queue ));
-    magma_cmatrix_addrowindex( &U, queue );
-    magma_cmfree(&UT, queue );
+        // need only lower triangular
+        magma_cmfree(&U, queue );
+        CHECK( magma_cmtranspose( UT, &U, queue) );
+        CHECK( magma_cmtransfer( L, &L0, A.memory_location, Magma_CPU, queue ));
+        CHECK( magma_cmtransfer( L, &oneL, A.memory_location, Magma_CPU, queue ));
+        CHECK( magma_cmtransfer( UT, &U0, A.memory_location, Magma_CPU, queue ));
+        magma_cmatrix_addrowindex( &U, queue );
+        magma_cmfree(&UT, queue );
+    }
     //magma_free_cpu( UT.row ); UT.row = NULL;
     //magma_free_cpu( UT.list ); UT.list = NULL;
     //CHECK( magma_cparilut_create_collinkedlist( U, &UT, queue) );
 
     if (timing == 1) {
-        printf("ilut_fill_ratio = %.6f;\n\n", precond->atol ); 
+        printf("ilut_fill_ratio = %.6f;\n\n", fill ); 
         
         printf("performance_%d = [\n%%iter L.nnz U.nnz    ILU-Norm     candidat  resid     ILU-norm  selectad  add       transp1   sweep1    selectrm  remove    sweep2    transp2   total       accum\n", (int) num_threads);
     }
 
     //##########################################################################
 
-    for( magma_int_t iters =0; iters<precond->sweeps; iters++ ) {
+    for( magma_int_t iters =0; iters<sweeps; iters++ ) {
     t_rm=0.0; t_add=0.0; t_res=0.0; t_sweep1=0.0; t_sweep2=0.0; t_cand=0.0;
                         t_transpose1=0.0; t_transpose2=0.0; t_selectrm=0.0;
                         t_selectadd=0.0; t_nrm=0.0; t_total = 0.0;
      
-        num_rmL = max( (L_new.nnz-L0nnz*(1+precond->atol*(iters+1)/precond->sweeps)), 0 );
-        num_rmU = max( (U_new.nnz-U0nnz*(1+precond->atol*(iters+1)/precond->sweeps)), 0 );
+        num_rmL = max( (L_new.nnz-L0nnz*(1+fill*(iters+1)/sweeps)), 0 );
+        num_rmU = max( (U_new.nnz-U0nnz*(1+fill*(iters+1)/sweeps)), 0 );
         // magma_free_cpu( UT.row ); UT.row = NULL;
         // magma_free_cpu( UT.list ); UT.list = NULL;
         // CHECK( magma_cparilut_create_collinkedlist( U, &UT, queue) );
@@ -293,15 +329,8 @@ magma_cparilut(
         end = magma_sync_wtime( queue ); t_selectadd+=end-start;
         
         start = magma_sync_wtime( queue );
-        #pragma omp parallel        
-        for(int row=0; row<hL.num_rows; row++){
-            magma_cindexsort( &hL.col[hL.row[row]], 0, hL.row[row+1]-hL.row[row]-1, queue );
-        }
-
-        #pragma omp parallel  
-        for(int row=0; row<hL.num_rows; row++){
-            magma_cindexsort( &hU.col[hU.row[row]], 0, hU.row[row+1]-hU.row[row]-1, queue );
-        }
+        CHECK( magma_ccsr_sort( &hL, queue ));
+        CHECK( magma_ccsr_sort( &hU, queue ));
         CHECK( magma_cmatrix_cup(  L, oneL, &L_new, queue ) );   
         CHECK( magma_cmatrix_cup(  U, oneU, &U_new, queue ) );
         //magma_cmatrix_addrowindex( &U, queue );
@@ -320,8 +349,8 @@ magma_cparilut(
         
          CHECK( magma_cparilut_sweep_sync( &A0, &L_new, &U_new, queue ) );
         end = magma_sync_wtime( queue ); t_sweep1+=end-start;
-        num_rmL = max( (L_new.nnz-L0nnz*(1+(precond->atol-1.)*(iters+1)/precond->sweeps)), 0 );
-        num_rmU = max( (U_new.nnz-U0nnz*(1+(precond->atol-1.)*(iters+1)/precond->sweeps)), 0 );
+        num_rmL = max( (L_new.nnz-L0nnz*(1+(fill-1.)*(iters+1)/sweeps)), 0 );
+        num_rmU = max( (U_new.nnz-U0nnz*(1+(fill-1.)*(iters+1)/sweeps)), 0 );
         start = magma_sync_wtime( queue );
         // pre-select: ignore the diagonal entries
         magma_cparilut_preselect( 0, &L_new, &oneL, queue );
@@ -419,6 +448,14 @@ magma_cparilut(
     if (timing == 1) {
         printf("]; \n");
     }
+
+    if( warmstart ){
+        CHECK( magma_cparilut_residual_norm( A0, L, U, &precond->final_res, queue ));
+        if (timing == 1) {
+            printf("%% ParILUT update: ILU residual norm %.4e -> %.4e\n",
+                    precond->init_res, precond->final_res );
+        }
+    }
     //##########################################################################
 
 
@@ -449,7 +486,23 @@ magma_cparilut(
         CHECK( magma_cvinit( &precond->work2, Magma_DEV, hA.num_rows, 1, MAGMA_C_ZERO, queue ));
     }
 
-    if( precond->trisolver == Magma_JACOBI && precond->pattern == 1 ){
+    if( warmstart && ( precond->trisolver == Magma_ISAI ||
+                       precond->trisolver == Magma_JACOBI ||
+                       precond->trisolver == Magma_VBJACOBI ) ){
+        // the ISAI matrices of the previous factors, set up again
+        // as in magma_c_precondsetup
+        info = magma_ciluisaisetup_lower( precond->L, precond->L, &precond->LD, queue );
+        if( info == 0 ){
+            info = magma_ciluisaisetup_upper( precond->U, precond->U, &precond->UD, queue );
+        }
+        if( info == Magma_CUSOLVE ){
+            precond->trisolver = Magma_CUSOLVE;
+            info = 0;
+        }
+        if( info != 0 ){
+            goto cleanup;
+        }
+    } else if( precond->trisolver == Magma_JACOBI && precond->pattern == 1 ){
         // dirty workaround for Jacobi trisolves....
         magma_cmfree( &hL, queue );
         magma_cmfree( &hU, queue );
@@ -474,6 +527,17 @@ magma_cparilut(
         CHECK( magma_cmtransfer( hAT, &(precond->UD), Magma_CPU, Magma_DEV, queue ));
     }
 
+    if( transposed ){
+        // the transposed factors for the solvers using A^T
+        CHECK( magma_ccumilusetup_transpose( A, precond, queue ));
+        if( precond->trisolver == Magma_ISAI ||
+            precond->trisolver == Magma_JACOBI ||
+            precond->trisolver == Magma_VBJACOBI ){
+            CHECK( magma_cmtranspose( precond->LD, &precond->LDT, queue ));
+            CHECK( magma_cmtranspose( precond->UD, &precond->UDT, queue ));
+        }
+    }
+
     cleanup:
 
     cusparseDestroy( cusparseHandle );
@@ -499,3 +563,120 @@ magma_cparilut(
 #endif
     return info;
 }
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Prepares the iterative threshold Incomplete LU preconditioner. The strategy
+    is interleaving a parallel fixed-point iteration that approximates an
+    incomplete factorization for a given nonzero pattern with a procedure that
+    adaptively changes the pattern. Much of this new algorithm has fine-grained
+    parallelism, and we show that it can efficiently exploit the compute power
+    of shared memory architectures.
+
+    This is the routine used in the publication by Anzt, Chow, Dongarra:
+    ''ParILUT - A new parallel threshold ILU factorization''
+    submitted to SIAM SISC in 2017.
+
+    This function requires OpenMP, and is only available if OpenMP is activated.
+    
+    The parameter list is:
+    
+    precond.sweeps : number of ParILUT steps
+    precond.atol   : absolute fill ratio (1.0 keeps nnz constant)
+    precond.rtol   : how many candidates are added to the sparsity pattern
+                        * 1.0 one per row
+                        * < 1.0 a fraction of those
+                        * > 1.0 all candidates
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_c_matrix
+                input RHS b
+
+    @param[in,out]
+    precond     magma_c_preconditioner*
+                preconditioner parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_cgepr
+*******************************************************************************/
+extern "C"
+magma_int_t
+magma_cparilut(
+    magma_c_matrix A,
+    magma_c_matrix b,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue )
+{
+    return magma_cparilut_iterate( A, precond, precond->sweeps, false, queue );
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Updates an existing ParILUT preconditioner after the values of A changed,
+    with the sparsity pattern of A unchanged. The factors of the previous
+    setup are the initial guess: they are adapted to the new values by one
+    sweep on their pattern, followed by the given number of ParILUT steps
+    (candidate addition, sweep, removal, sweep), which keep their number of
+    nonzeros. With updates = 0, only the pattern is kept, as in
+    magma_cpariluupdate. This is much cheaper than magma_cparilut from
+    scratch if the values changed little.
+
+    The preconditioner may come from magma_cparilut, magma_cparilut_cpu or
+    magma_cparilut_gpu, e.g., from magma_c_precondsetup with Magma_PARILUT:
+    all of them leave L and U as CSR on the device in precond->L and
+    precond->U. The triangular solve data, the ISAI matrices, and the
+    transposed factors are set up again as by magma_c_precondsetup.
+
+    The Frobenius norm of the ILU residual A - LU on the pattern of A before
+    and after the update is returned in precond->init_res and
+    precond->final_res.
+
+    This function requires OpenMP, and is only available if OpenMP is activated.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                input matrix A, current target system
+
+    @param[in,out]
+    precond     magma_c_preconditioner*
+                ParILUT preconditioner to update
+
+    @param[in]
+    updates     magma_int_t
+                number of ParILUT steps, may be 0
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_cgepr
+*******************************************************************************/
+extern "C"
+magma_int_t
+magma_cparilut_update(
+    magma_c_matrix A,
+    magma_c_preconditioner *precond,
+    magma_int_t updates,
+    magma_queue_t queue )
+{
+    return magma_cparilut_iterate( A, precond, updates, true, queue );
+}
@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparilut_gpu.cpp, normal z -> c, Wed Feb 22 15:21:59 2023
+       @generated from sparse/src/zparilut_gpu.cpp, normal z -> c, Sun Oct 18 06:54:13 2026
 */
 
 #include "magmasparse_internal.h"
@@ -96,7 +96,7 @@ magma_cparilut_gpu(
     
     // in case using fill-in
     if (precond->levels > 0) {
-        CHECK(magma_csymbilu(&hA, precond->levels, &hL, &hU , queue));
+        CHECK(magma_csymbilu_stats(&hA, precond->levels, &hL, &hU, &precond->symbilu, queue));
         magma_cmfree(&hU, queue);
         magma_cmfree(&hL, queue);
     }
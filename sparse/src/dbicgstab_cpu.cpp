@@ -0,0 +1,257 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Hartwig Anzt
+
+       @generated from sparse/src/zbicgstab_cpu.cpp, normal z -> d, Sun Oct 18 03:18:38 2026
+*/
+
+#include "magmasparse_internal.h"
+
+#define RTOLERANCE     lapackf77_dlamch( "E" )
+#define ATOLERANCE     lapackf77_dlamch( "E" )
+
+
+/**
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a general N-by-N matrix.
+    This is a CPU implementation of the preconditioned Biconjugate
+    Gradient Stabilized method: A, b and x are in host memory.
+    <t,s> and <t,t> share one sweep, as do <r,r> and the next <rr,r>.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_d_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_d_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_d_solver_par*
+                solver parameters
+
+    @param[in]
+    precond_par magma_d_preconditioner*
+                preconditioner set up with magma_d_precondsetup_cpu,
+                or NULL for no preconditioning
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgesv
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dbicgstab_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    // prepare solver feedback
+    solver_par->solver = ( precond_par == NULL ) ? Magma_BICGSTAB : Magma_PBICGSTAB;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+
+    // some useful variables
+    double c_zero = MAGMA_D_ZERO;
+    double c_one  = MAGMA_D_ONE;
+
+    magma_int_t dofs = A.num_rows*b.num_cols;
+
+    // workspace
+    magma_d_matrix r={Magma_CSR}, rr={Magma_CSR}, p={Magma_CSR}, v={Magma_CSR}, s={Magma_CSR}, t={Magma_CSR}, y={Magma_CSR}, z={Magma_CSR};
+    CHECK( magma_dvinit( &r, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &rr,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &p, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &v, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &s, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &t, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &y, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &z, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+
+    // solver variables
+    double alpha, beta, omega, rho_old, rho_new;
+    double skp[2];
+    double nom0, r0, res, nomb;
+    res=0;
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+
+    // solver setup
+    magma_dcopy_cpu( dofs, b.val, r.val );                              // r = b
+    CHECK( magma_d_spmv( -c_one, A, *x, c_one, r, queue ));             // r = r - A x
+    magma_dcopy_cpu( dofs, r.val, rr.val );                             // rr = r
+    magma_ddot2_cpu( dofs, r.val, r.val, rr.val, r.val, skp );
+    nom0 = sqrt( MAGMA_D_REAL( skp[0] ) );
+    rho_new = skp[1];                                                   // rho = <rr,r>
+    omega = alpha = c_one;
+    solver_par->init_res = nom0;
+
+    nomb = magma_dnrm2_cpu( dofs, b.val );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    if ( (r0 = nomb * solver_par->rtol) < ATOLERANCE ){
+        r0 = ATOLERANCE;
+    }
+
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < r0 ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    tempo1 = magma_wtime();
+
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+
+        if ( solver_par->numiter == 1 ) {
+            magma_dcopy_cpu( dofs, r.val, p.val );                      // p = r
+        } else {
+            beta = rho_new/rho_old * alpha/omega;   // beta=rho/rho_old *alpha/omega
+            if( magma_d_isnan_inf( beta ) ){
+                info = MAGMA_DIVERGENCE;
+                break;
+            }
+            magma_daxpby_cpu( dofs, -omega, v.val, c_one, p.val );      // p = p-omega*v
+            magma_daxpby_cpu( dofs, c_one, r.val, beta, p.val );        // p = r+beta*p
+        }
+
+        // preconditioner
+        CHECK( magma_d_applyprecond_cpu( MagmaNoTrans, p, &y, precond_par, queue ));  // y = M p
+
+        CHECK( magma_d_spmv( c_one, A, y, c_zero, v, queue ));          // v = Ay
+        solver_par->spmv_count++;
+        alpha = rho_new / magma_ddot_cpu( dofs, rr.val, v.val );
+        if( magma_d_isnan_inf( alpha ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+        magma_dcopy_cpu( dofs, r.val, s.val );                          // s=r
+        magma_daxpby_cpu( dofs, -alpha, v.val, c_one, s.val );          // s=s-alpha*v
+
+        // preconditioner
+        CHECK( magma_d_applyprecond_cpu( MagmaNoTrans, s, &z, precond_par, queue ));  // z = M s
+
+        CHECK( magma_d_spmv( c_one, A, z, c_zero, t, queue ));          // t=Az
+        solver_par->spmv_count++;
+        // omega = <t,s>/<t,t>
+        magma_ddot2_cpu( dofs, t.val, s.val, t.val, t.val, skp );
+        omega = skp[0] / skp[1];
+
+        magma_daxpby_cpu( dofs, alpha, y.val, c_one, x->val );          // x=x+alpha*y
+        if( magma_d_isnan_inf( omega ) ){
+            res = magma_dnrm2_cpu( dofs, s.val );
+            if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+                info = MAGMA_SUCCESS;
+            } else {
+                info = MAGMA_DIVERGENCE;
+            }
+            break;
+        }
+        magma_daxpby_cpu( dofs, omega, z.val, c_one, x->val );          // x=x+omega*z
+
+        magma_dcopy_cpu( dofs, s.val, r.val );                          // r=s
+        magma_daxpby_cpu( dofs, -omega, t.val, c_one, r.val );          // r=r-omega*t
+        rho_old = rho_new;
+        magma_ddot2_cpu( dofs, r.val, r.val, rr.val, r.val, skp );     // <r,r>, <rr,r>
+        res = sqrt( MAGMA_D_REAL( skp[0] ) );
+        rho_new = skp[1];
+
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            info = MAGMA_SUCCESS;
+            break;
+        }
+    }
+    while ( solver_par->numiter+1 <= solver_par->maxiter );
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    double residual;
+    magma_dcopy_cpu( dofs, b.val, r.val );
+    CHECK( magma_d_spmv( -c_one, A, *x, c_one, r, queue ));
+    residual = magma_dnrm2_cpu( dofs, r.val );
+    solver_par->final_res = residual;
+    solver_par->iter_res = res;
+
+    if ( solver_par->numiter < solver_par->maxiter && info == MAGMA_SUCCESS ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    magma_dmfree(&r, queue );
+    magma_dmfree(&rr, queue );
+    magma_dmfree(&p, queue );
+    magma_dmfree(&v, queue );
+    magma_dmfree(&s, queue );
+    magma_dmfree(&t, queue );
+    magma_dmfree(&y, queue );
+    magma_dmfree(&z, queue );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_dbicgstab_cpu */
@@ -0,0 +1,267 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Hartwig Anzt
+
+       @generated from sparse/src/zbicgstab_merge_cpu.cpp, normal z -> d, Sun Oct 18 03:33:42 2026
+*/
+
+#include "magmasparse_internal.h"
+
+#define RTOLERANCE     lapackf77_dlamch( "E" )
+#define ATOLERANCE     lapackf77_dlamch( "E" )
+
+
+/**
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a general N-by-N matrix.
+    This is a CPU implementation of the Biconjugate Gradient Stabilized
+    method in variant, where multiple operations are merged into one sweep
+    over memory: each SpMV forms its input vector on the fly and computes
+    the dot products needed next, the solution and residual updates are
+    fused with <r,r> and <rr,r>. An iteration takes three sweeps.
+
+    A is used in CSR or SELLP, other formats are converted to CSR once.
+    The estimated bytes moved per iteration are returned in
+    solver_par->iter_bytes.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_d_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_d_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_d_solver_par*
+                solver parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgesv
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dbicgstab_merge_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    // prepare solver feedback
+    solver_par->solver = Magma_BICGSTABMERGE;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+    solver_par->iter_bytes = 0.0;
+
+    // some useful variables
+    double c_zero = MAGMA_D_ZERO;
+    double c_one  = MAGMA_D_ONE;
+
+    magma_int_t n = A.num_rows;
+    magma_int_t convert = 0;
+
+    // workspace, p/pn and v/vn are swapped every iteration
+    magma_d_matrix Ah={Magma_CSR}, r={Magma_CSR}, rr={Magma_CSR}, p={Magma_CSR},
+                   pn={Magma_CSR}, v={Magma_CSR}, vn={Magma_CSR}, s={Magma_CSR},
+                   t={Magma_CSR}, tmp={Magma_CSR};
+
+    // solver variables
+    double alpha, beta, omega, rho_old, rho_new;
+    double skp[2];
+    double nom0, r0, res, nomb;
+    res=0;
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+
+    if ( A.storage_type == Magma_CSR || A.storage_type == Magma_SELLP ) {
+        Ah = A;
+    } else {
+        CHECK( magma_dmconvert( A, &Ah, A.storage_type, Magma_CSR, queue ));
+        convert = 1;
+    }
+    CHECK( magma_dvinit( &r, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_dvinit( &rr,Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_dvinit( &p, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_dvinit( &pn,Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_dvinit( &v, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_dvinit( &vn,Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_dvinit( &s, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_dvinit( &t, Magma_CPU, n, 1, c_zero, queue ));
+
+    // two SpMVs, gathers r, p, v and r, v, rr read, pn, vn, s, t written,
+    // then p, s, t, rr, r read, x updated and r written
+    solver_par->iter_bytes = 2.0 * magma_dmergebytes_cpu( Ah )
+                             + 17.0 * n * sizeof(double);
+
+    // solver setup
+    magma_dcopy_cpu( n, b.val, r.val );                                 // r = b
+    CHECK( magma_d_spmv( -c_one, Ah, *x, c_one, r, queue ));            // r = r - A x
+    magma_dcopy_cpu( n, r.val, rr.val );                                // rr = r
+    magma_ddot2_cpu( n, r.val, r.val, rr.val, r.val, skp );
+    nom0 = sqrt( MAGMA_D_REAL( skp[0] ) );
+    rho_new = skp[1];                                                   // rho = <rr,r>
+    rho_old = omega = alpha = c_one;
+    beta = c_zero;                                                      // p = 0, v = 0
+    solver_par->init_res = nom0;
+
+    nomb = magma_dnrm2_cpu( n, b.val );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    if ( (r0 = nomb * solver_par->rtol) < ATOLERANCE ){
+        r0 = ATOLERANCE;
+    }
+
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < r0 ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    tempo1 = magma_wtime();
+
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+
+        if ( solver_par->numiter > 1 ) {
+            beta = rho_new/rho_old * alpha/omega;   // beta=rho/rho_old *alpha/omega
+            if( magma_d_isnan_inf( beta ) ){
+                info = MAGMA_DIVERGENCE;
+                break;
+            }
+        }
+
+        // pn = r + beta (p - omega v), vn = A pn, <rr,vn>
+        magma_dbicgmerge_spmv1_cpu( Ah, beta, omega, r.val, rr.val, p.val, v.val,
+                                    pn.val, vn.val, skp );
+        solver_par->spmv_count++;
+        tmp = p; p = pn; pn = tmp;
+        tmp = v; v = vn; vn = tmp;
+        alpha = rho_new / skp[0];
+        if( magma_d_isnan_inf( alpha ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+
+        // s = r - alpha v, t = A s, omega = <t,s>/<t,t>
+        magma_dbicgmerge_spmv2_cpu( Ah, alpha, r.val, v.val, s.val, t.val, skp );
+        solver_par->spmv_count++;
+        omega = skp[0] / skp[1];
+
+        if( magma_d_isnan_inf( omega ) ){
+            magma_daxpby_cpu( n, alpha, p.val, c_one, x->val );         // x=x+alpha*p
+            res = magma_dnrm2_cpu( n, s.val );
+            if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+                info = MAGMA_SUCCESS;
+            } else {
+                info = MAGMA_DIVERGENCE;
+            }
+            break;
+        }
+
+        // x = x + alpha p + omega s, r = s - omega t, <r,r>, <rr,r>
+        magma_dbicgmerge_xr_cpu( n, alpha, omega, p.val, s.val, t.val, rr.val,
+                                 x->val, r.val, skp );
+        rho_old = rho_new;
+        res = sqrt( MAGMA_D_REAL( skp[0] ) );
+        rho_new = skp[1];
+
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            info = MAGMA_SUCCESS;
+            break;
+        }
+    }
+    while ( solver_par->numiter+1 <= solver_par->maxiter );
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    double residual;
+    magma_dcopy_cpu( n, b.val, r.val );
+    CHECK( magma_d_spmv( -c_one, Ah, *x, c_one, r, queue ));
+    residual = magma_dnrm2_cpu( n, r.val );
+    solver_par->final_res = residual;
+    solver_par->iter_res = res;
+
+    if ( solver_par->numiter < solver_par->maxiter && info == MAGMA_SUCCESS ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    if ( convert ) {
+        magma_dmfree(&Ah, queue );
+    }
+    magma_dmfree(&r, queue );
+    magma_dmfree(&rr, queue );
+    magma_dmfree(&p, queue );
+    magma_dmfree(&pn, queue );
+    magma_dmfree(&v, queue );
+    magma_dmfree(&vn, queue );
+    magma_dmfree(&s, queue );
+    magma_dmfree(&t, queue );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_dbicgstab_merge_cpu */
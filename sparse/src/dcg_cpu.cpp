@@ -0,0 +1,217 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Hartwig Anzt
+
+       @generated from sparse/src/zcg_cpu.cpp, normal z -> d, Sun Oct 18 03:18:38 2026
+*/
+
+#include "magmasparse_internal.h"
+
+#define RTOLERANCE     lapackf77_dlamch( "E" )
+#define ATOLERANCE     lapackf77_dlamch( "E" )
+
+
+/*******************************************************************************
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a real symmetric N-by-N positive definite matrix A.
+    This is a CPU implementation of the preconditioned Conjugate
+    Gradient method: A, b and x are in host memory, the SpMV is
+    magma_d_spmv_cpu and the vector updates are OpenMP parallel.
+    <r,h> and <r,r> are computed in one sweep.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_d_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_d_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_d_solver_par*
+                solver parameters
+
+    @param[in]
+    precond_par magma_d_preconditioner*
+                preconditioner set up with magma_d_precondsetup_cpu,
+                or NULL for no preconditioning
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dposv
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_dcg_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    // prepare solver feedback
+    solver_par->solver = ( precond_par == NULL ) ? Magma_CG : Magma_PCG;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+
+    // solver variables
+    double alpha, beta;
+    double nom0, r0,  res, nomb;
+    double den, gammanew, gammaold;
+    double skp[2];
+    // local variables
+    double c_zero = MAGMA_D_ZERO, c_one = MAGMA_D_ONE;
+
+    magma_int_t dofs = A.num_rows* b.num_cols;
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+
+    // CPU workspace
+    magma_d_matrix r={Magma_CSR}, p={Magma_CSR}, q={Magma_CSR}, h={Magma_CSR};
+    CHECK( magma_dvinit( &r, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &p, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &q, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &h, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+
+    // solver setup
+    magma_dcopy_cpu( dofs, b.val, r.val );                              // r = b
+    CHECK( magma_d_spmv( -c_one, A, *x, c_one, r, queue ));             // r = r - A x
+    nom0 = magma_dnrm2_cpu( dofs, r.val );
+
+    // preconditioner
+    CHECK( magma_d_applyprecond_cpu( MagmaNoTrans, r, &h, precond_par, queue ));      // h = M r
+    magma_dcopy_cpu( dofs, h.val, p.val );                              // p = h
+    gammaold = magma_ddot_cpu( dofs, r.val, h.val );                   // go = <r,h>
+
+    solver_par->init_res = nom0;
+    nomb = magma_dnrm2_cpu( dofs, b.val );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    if ( (r0 = nomb * solver_par->rtol) < ATOLERANCE ){
+        r0 = ATOLERANCE;
+    }
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = (real_Double_t)nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < r0 ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+    res = nom0;
+
+    tempo1 = magma_wtime();
+
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+
+        CHECK( magma_d_spmv( c_one, A, p, c_zero, q, queue ));         // q = A p
+        solver_par->spmv_count++;
+        den = magma_ddot_cpu( dofs, p.val, q.val );                    // den = <p,q>
+        // check positive definite
+        if ( MAGMA_D_ABS(den) <= 0.0 ) {
+            info = MAGMA_NONSPD;
+            goto cleanup;
+        }
+
+        alpha = gammaold / den;
+        magma_daxpby_cpu( dofs,  alpha, p.val, c_one, x->val );         // x = x + alpha p
+        magma_daxpby_cpu( dofs, -alpha, q.val, c_one, r.val );          // r = r - alpha q
+
+        // preconditioner
+        CHECK( magma_d_applyprecond_cpu( MagmaNoTrans, r, &h, precond_par, queue ));  // h = M r
+        magma_ddot2_cpu( dofs, r.val, h.val, r.val, r.val, skp );      // <r,h>, <r,r>
+        gammanew = skp[0];
+        res = sqrt( MAGMA_D_REAL( skp[1] ) );
+
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            break;
+        }
+
+        beta = gammanew / gammaold;                                     // beta = gn/go
+        magma_daxpby_cpu( dofs, c_one, h.val, beta, p.val );            // p = h + beta p
+        gammaold = gammanew;
+    }
+    while ( solver_par->numiter+1 <= solver_par->maxiter );
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    double residual;
+    magma_dcopy_cpu( dofs, b.val, r.val );
+    CHECK( magma_d_spmv( -c_one, A, *x, c_one, r, queue ));
+    residual = magma_dnrm2_cpu( dofs, r.val );
+    solver_par->iter_res = res;
+    solver_par->final_res = residual;
+
+    if ( solver_par->numiter < solver_par->maxiter ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    magma_dmfree(&r, queue );
+    magma_dmfree(&p, queue );
+    magma_dmfree(&q, queue );
+    magma_dmfree(&h, queue );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_dcg_cpu */
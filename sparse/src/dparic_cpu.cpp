@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparic_cpu.cpp, normal z -> d, Wed Feb 22 15:21:58 2023
+       @generated from sparse/src/zparic_cpu.cpp, normal z -> d, Sun Oct 18 06:54:12 2026
 */
 
 #include "magmasparse_internal.h"
@@ -77,7 +77,7 @@ magma_dparic_cpu(
 
     // in case using fill-in
     if (precond->levels > 0) {
-        CHECK(magma_dsymbilu(&hA, precond->levels, &hAL, &hAUT,  queue));
+        CHECK(magma_dsymbilu_stats(&hA, precond->levels, &hAL, &hAUT, &precond->symbilu, queue));
         magma_dmfree(&hAL, queue);
         magma_dmfree(&hAUT, queue);
     }
@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparict_cpu.cpp, normal z -> d, Wed Feb 22 15:21:59 2023
+       @generated from sparse/src/zparict_cpu.cpp, normal z -> d, Sun Oct 18 06:54:12 2026
 */
 
 #include "magmasparse_internal.h"
@@ -100,7 +100,7 @@ magma_dparict_cpu(
 
     // in case using fill-in
     if (precond->levels > 0) {
-        CHECK(magma_dsymbilu(&hA, precond->levels, &hL, &LT , queue));
+        CHECK(magma_dsymbilu_stats(&hA, precond->levels, &hL, &LT, &precond->symbilu, queue));
         magma_dmfree(&LT, queue);
     }
     
@@ -108,6 +108,9 @@ magma_dparict_cpu(
     CHECK(magma_dmtransfer(L, &L0, A.memory_location, Magma_CPU, queue));
     CHECK(magma_dmatrix_addrowindex(&L, queue)); 
     L0nnz=L.nnz;
+    // the diagonal of tril(A) is not that of a Cholesky factor; without
+    // a sweep, the first candidates can give a zero diagonal
+    CHECK(magma_dparict_sweep_sync(&hA, &L, queue));
     
     if (timing == 1) {
         printf("ilut_fill_ratio = %.6f;\n\n", precond->atol); 
@@ -0,0 +1,352 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Hartwig Anzt
+
+       @generated from sparse/src/zqmr_cpu.cpp, normal z -> d, Sun Oct 18 03:26:03 2026
+*/
+
+#include "magmasparse_internal.h"
+
+#define RTOLERANCE     lapackf77_dlamch( "E" )
+#define ATOLERANCE     lapackf77_dlamch( "E" )
+
+
+/*******************************************************************************
+    v = y / rho, y = y / rho, w = wt / psi, z = z / psi in one sweep,
+    host counterpart of magma_dqmr_1.
+*/
+static void
+magma_dqmr_cpu_1(
+    magma_int_t n,
+    double rho,
+    double psi,
+    double *y,
+    double *z,
+    const double *wt,
+    double *v,
+    double *w )
+{
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        double ytmp = y[i] / rho;
+        y[i] = ytmp;
+        v[i] = ytmp;
+        z[i] = z[i] / psi;
+        w[i] = wt[i] / psi;
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a general real N-by-N matrix A.
+    This is a CPU implementation of the (right-preconditioned)
+    Quasi-Minimal Residual method (QMR): A, b and x are in host memory.
+    A^H is formed once on the host for the shadow recurrence.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_d_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_d_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_d_solver_par*
+                solver parameters
+
+    @param[in]
+    precond_par magma_d_preconditioner*
+                preconditioner set up with magma_d_precondsetup_cpu,
+                or NULL for no preconditioning
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgesv
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dqmr_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    // prepare solver feedback
+    solver_par->solver = ( precond_par == NULL ) ? Magma_QMR : Magma_PQMR;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+
+    // local variables
+    double c_zero = MAGMA_D_ZERO, c_one = MAGMA_D_ONE;
+    // solver variables
+    double nom0, r0, res=0, nomb;
+    double rho = c_one, rho1 = c_one, eta = -c_one , pds = c_one,
+                        thet = c_one, thet1 = c_one, epsilon = c_one,
+                        beta = c_one, delta = c_one, pde = c_one, rde = c_one,
+                        gamm = c_one, gamm1 = c_one, psi = c_one;
+    double skp[2];
+
+    magma_int_t dofs = A.num_rows* b.num_cols;
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+
+    // need to transpose the matrix
+    magma_d_matrix AT={Magma_CSR}, Ah1={Magma_CSR}, Ah2={Magma_CSR};
+
+    // CPU workspace
+    magma_d_matrix r={Magma_CSR}, v={Magma_CSR}, w={Magma_CSR}, wt={Magma_CSR},
+                    d={Magma_CSR}, s={Magma_CSR}, z={Magma_CSR}, q={Magma_CSR},
+                    p={Magma_CSR}, pt={Magma_CSR}, y={Magma_CSR}, yt={Magma_CSR};
+    CHECK( magma_dvinit( &r, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &v, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &w, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &wt,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &d, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &s, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &z, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &q, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &p, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &pt,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &y, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &yt,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+
+    // solver setup
+    magma_dcopy_cpu( dofs, b.val, r.val );                              // r = b
+    CHECK( magma_d_spmv( -c_one, A, *x, c_one, r, queue ));             // r = r - A x
+    nom0 = magma_dnrm2_cpu( dofs, r.val );
+    solver_par->init_res = nom0;
+    magma_dcopy_cpu( dofs, r.val, y.val );                              // y = r
+    magma_dcopy_cpu( dofs, r.val, wt.val );                             // wt = r
+    CHECK( magma_d_applyprecond_cpu( MagmaConjTrans, wt, &z, precond_par, queue )); // z = M' wt
+
+    // conjugate transpose of the matrix, formed on the host
+    CHECK( magma_dmconvert( A, &Ah1, A.storage_type, Magma_CSR, queue ));
+    CHECK( magma_dmtranspose( Ah1, &Ah2, queue ));
+    magma_dmfree(&Ah1, queue );
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t k=0; k < Ah2.nnz; k++ ) {
+        Ah2.val[k] = MAGMA_D_CONJ( Ah2.val[k] );
+    }
+    AT.blocksize = A.blocksize;
+    AT.alignment = A.alignment;
+    CHECK( magma_dmconvert( Ah2, &AT, Magma_CSR, A.storage_type, queue ));
+    magma_dmfree(&Ah2, queue );
+
+    nomb = magma_dnrm2_cpu( dofs, b.val );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    if ( (r0 = nomb * solver_par->rtol) < ATOLERANCE ){
+        r0 = ATOLERANCE;
+    }
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = (real_Double_t)nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < r0 ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    // psi = norm(z), rho = norm(y)
+    magma_ddot2_cpu( dofs, z.val, z.val, y.val, y.val, skp );
+    psi = magma_dsqrt( skp[0] );
+    rho = magma_dsqrt( skp[1] );
+    magma_dqmr_cpu_1( dofs, rho, psi, y.val, z.val, wt.val, v.val, w.val );
+
+    tempo1 = magma_wtime();
+
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+        if( magma_d_isnan_inf( rho ) || magma_d_isnan_inf( psi ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+
+            // delta = z' * y;
+        delta = magma_ddot_cpu( dofs, z.val, y.val );
+
+        if( magma_d_isnan_inf( delta ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+
+            // yt = M y
+        CHECK( magma_d_applyprecond_cpu( MagmaNoTrans, y, &yt, precond_par, queue ));
+
+        if( solver_par->numiter == 1 ){
+                // p = yt;
+                // q = z;
+            magma_dcopy_cpu( dofs, yt.val, p.val );
+            magma_dcopy_cpu( dofs, z.val, q.val );
+        }
+        else{
+            pde = psi * delta / epsilon;
+            rde = rho * MAGMA_D_CONJ(delta/epsilon);
+                // p = yt - pde * p;
+            magma_daxpby_cpu( dofs, c_one, yt.val, -pde, p.val );
+                // q = z - rde * q;
+            magma_daxpby_cpu( dofs, c_one, z.val, -rde, q.val );
+        }
+
+        CHECK( magma_d_spmv( c_one, A, p, c_zero, pt, queue ));
+        solver_par->spmv_count++;
+            // epsilon = q' * pt;
+        epsilon = magma_ddot_cpu( dofs, q.val, pt.val );
+        beta = epsilon / delta;
+
+        if( magma_d_isnan_inf( epsilon ) || magma_d_isnan_inf( beta ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+            // y = pt - beta * v;
+        magma_dcopy_cpu( dofs, pt.val, y.val );
+        magma_daxpby_cpu( dofs, -beta, v.val, c_one, y.val );
+
+            // wt = A' * q - beta' * w;
+        CHECK( magma_d_spmv( c_one, AT, q, c_zero, wt, queue ));
+        solver_par->spmv_count++;
+        magma_daxpby_cpu( dofs, -MAGMA_D_CONJ( beta ), w.val, c_one, wt.val );
+
+            // z = M' wt
+        CHECK( magma_d_applyprecond_cpu( MagmaConjTrans, wt, &z, precond_par, queue ));
+
+        rho1 = rho;
+            // rho = norm(y);
+        rho = MAGMA_D_MAKE( magma_dnrm2_cpu( dofs, y.val ), 0.0 );
+
+        thet1 = thet;
+        thet = rho / (gamm * MAGMA_D_MAKE( MAGMA_D_ABS(beta), 0.0 ));
+        gamm1 = gamm;
+
+        gamm = c_one / magma_dsqrt(c_one + thet*thet);
+        eta = - eta * rho1 * gamm * gamm / (beta * gamm1 * gamm1);
+
+        if( magma_d_isnan_inf( thet ) || magma_d_isnan_inf( gamm ) || magma_d_isnan_inf( eta ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+
+            // d = eta * p + (thet1 * gamm)^2 * d;
+            // s = eta * pt + (thet1 * gamm)^2 * s;
+        pds = ( solver_par->numiter == 1 ) ? c_zero : (thet1 * gamm) * (thet1 * gamm);
+        magma_daxpby_cpu( dofs, eta, p.val, pds, d.val );
+        magma_daxpby_cpu( dofs, eta, pt.val, pds, s.val );
+            // x = x + d;
+        magma_daxpby_cpu( dofs, c_one, d.val, c_one, x->val );
+            // r = r - s;
+        magma_daxpby_cpu( dofs, -c_one, s.val, c_one, r.val );
+
+            // psi = norm(z), res = norm(r)
+        magma_ddot2_cpu( dofs, z.val, z.val, r.val, r.val, skp );
+        psi = magma_dsqrt( skp[0] );
+        res = sqrt( MAGMA_D_REAL( skp[1] ) );
+
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        // v = y / rho
+        // y = y / rho
+        // w = wt / psi
+        // z = z / psi
+        magma_dqmr_cpu_1( dofs, rho, psi, y.val, z.val, wt.val, v.val, w.val );
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            info = MAGMA_SUCCESS;
+            break;
+        }
+    }
+    while ( solver_par->numiter+1 <= solver_par->maxiter );
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    double residual;
+    magma_dcopy_cpu( dofs, b.val, r.val );
+    CHECK( magma_d_spmv( -c_one, A, *x, c_one, r, queue ));
+    residual = magma_dnrm2_cpu( dofs, r.val );
+    solver_par->iter_res = res;
+    solver_par->final_res = residual;
+
+    if ( solver_par->numiter < solver_par->maxiter && info == MAGMA_SUCCESS ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    magma_dmfree(&r,  queue );
+    magma_dmfree(&v,  queue );
+    magma_dmfree(&w,  queue );
+    magma_dmfree(&wt, queue );
+    magma_dmfree(&d,  queue );
+    magma_dmfree(&s,  queue );
+    magma_dmfree(&z,  queue );
+    magma_dmfree(&q,  queue );
+    magma_dmfree(&p,  queue );
+    magma_dmfree(&pt, queue );
+    magma_dmfree(&y,  queue );
+    magma_dmfree(&yt, queue );
+    magma_dmfree(&AT, queue );
+    magma_dmfree(&Ah1, queue );
+    magma_dmfree(&Ah2, queue );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_dqmr_cpu */
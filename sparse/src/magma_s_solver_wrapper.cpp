@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/src/magma_z_solver_wrapper.cpp, normal z -> s, Wed Feb 22 15:22:00 2023
+       @generated from sparse/src/magma_z_solver_wrapper.cpp, normal z -> s, Sun Oct 18 03:33:43 2026
        @author Hartwig Anzt
 
 */
@@ -20,6 +20,10 @@
     system Ax = b. All linear algebra objects are expected to be on the device,
     the linear algebra objects are MAGMA-sparse specific structures 
     (dense matrix b, dense matrix x, sparse/dense matrix A).
+    If A, b and x are all in host memory, the CG, BiCGSTAB, GMRES, IDR,
+    QMR and TFQMR families run on the CPU instead; the preconditioner then
+    has to be set up with magma_s_precondsetup_cpu. The unpreconditioned
+    merged variants use the fused host kernels.
     The additional parameter zopts contains information about the solver
     and the preconditioner.
     * the type of solver
@@ -68,6 +72,53 @@ magma_s_solver(
         printf( "error: sparse RHS not yet supported.\n" );
         return MAGMA_ERR_NOT_SUPPORTED;
     }
+    if ( A.memory_location == Magma_CPU ) {
+        if ( b.memory_location != Magma_CPU || x->memory_location != Magma_CPU
+             || b.num_cols != 1 ) {
+            printf( "error: CPU solvers need A, b and x in host memory and 1 RHS.\n" );
+            return MAGMA_ERR_NOT_SUPPORTED;
+        }
+        switch( zopts->solver_par.solver ) {
+            case  Magma_CG:
+                    CHECK( magma_scg_cpu( A, b, x, &zopts->solver_par, NULL, queue )); break;
+            case  Magma_CGMERGE:
+                    CHECK( magma_scg_merge_cpu( A, b, x, &zopts->solver_par, queue )); break;
+            case  Magma_PCG:
+            case  Magma_PCGMERGE:
+                    CHECK( magma_scg_cpu( A, b, x, &zopts->solver_par, &zopts->precond_par, queue )); break;
+            case  Magma_BICGSTAB:
+                    CHECK( magma_sbicgstab_cpu( A, b, x, &zopts->solver_par, NULL, queue )); break;
+            case  Magma_BICGSTABMERGE:
+                    CHECK( magma_sbicgstab_merge_cpu( A, b, x, &zopts->solver_par, queue )); break;
+            case  Magma_PBICGSTAB:
+            case  Magma_PBICGSTABMERGE:
+                    CHECK( magma_sbicgstab_cpu( A, b, x, &zopts->solver_par, &zopts->precond_par, queue )); break;
+            case  Magma_GMRES:
+                    CHECK( magma_sfgmres_cpu( A, b, x, &zopts->solver_par, NULL, queue )); break;
+            case  Magma_PGMRES:
+                    CHECK( magma_sfgmres_cpu( A, b, x, &zopts->solver_par, &zopts->precond_par, queue )); break;
+            case  Magma_IDR:
+                    CHECK( magma_sidr_cpu( A, b, x, &zopts->solver_par, NULL, queue )); break;
+            case  Magma_IDRMERGE:
+                    CHECK( magma_sidr_merge_cpu( A, b, x, &zopts->solver_par, queue )); break;
+            case  Magma_PIDR:
+            case  Magma_PIDRMERGE:
+                    CHECK( magma_sidr_cpu( A, b, x, &zopts->solver_par, &zopts->precond_par, queue )); break;
+            case  Magma_QMR:
+            case  Magma_QMRMERGE:
+                    CHECK( magma_sqmr_cpu( A, b, x, &zopts->solver_par, NULL, queue )); break;
+            case  Magma_PQMR:
+            case  Magma_PQMRMERGE:
+                    CHECK( magma_sqmr_cpu( A, b, x, &zopts->solver_par, &zopts->precond_par, queue )); break;
+            case  Magma_TFQMR:
+            case  Magma_TFQMRMERGE:
+                    CHECK( magma_stfqmr_merge_cpu( A, b, x, &zopts->solver_par, queue )); break;
+            default:
+                    printf("error: solver class not supported on the CPU.\n");
+                    info = MAGMA_ERR_NOT_SUPPORTED; break;
+        }
+        goto cleanup;
+    }
     if( b.num_cols == 1 ){
         switch( zopts->solver_par.solver ) {
             case  Magma_BICG:
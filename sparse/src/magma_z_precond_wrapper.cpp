@@ -87,6 +87,15 @@ magma_z_precond(
                 CHECK( magma_ztfqmr( A, b, x, &psolver_par, queue )); break;
         case  Magma_BAITERO:
                 CHECK( magma_zbaiter_overlap( A, b, x, &psolver_par, &pprecond, queue )); break;
+        case  Magma_GS:
+        case  Magma_SGS:
+        case  Magma_SOR:
+        case  Magma_SSOR:
+                // smoother: set up on first use, relax from the given x
+                if ( precond->color_ptr == NULL ) {
+                    CHECK( magma_zmcsorsetup( A, A.memory_location, precond, queue ));
+                }
+                CHECK( magma_zmcsor_smooth( b, x, max( 1, precond->maxiter ), precond, queue )); break;
         default:
                 CHECK( magma_zcg_res( A, b, x, &psolver_par, queue )); break;
     }
@@ -156,6 +165,10 @@ magma_z_precondsetup(
     if ( precond->solver == Magma_JACOBI ) {
         info = magma_zjacobisetup_diagscal( A, &(precond->d), queue );
     }
+    else if ( precond->solver == Magma_GS  || precond->solver == Magma_SGS ||
+              precond->solver == Magma_SOR || precond->solver == Magma_SSOR ) {
+        info = magma_zmcsorsetup( A, Magma_DEV, precond, queue );
+    }
     else if ( precond->solver == Magma_PASTIX ) {
         //info = magma_zpastixsetup( A, b, precond, queue );
         info = MAGMA_ERR_NOT_SUPPORTED;
@@ -339,6 +352,10 @@ magma_z_applyprecond(
     if ( precond->solver == Magma_JACOBI ) {
         CHECK( magma_zjacobi_diagscal( b.num_rows, precond->d, b, x, queue ));
     }
+    else if ( precond->solver == Magma_GS  || precond->solver == Magma_SGS ||
+              precond->solver == Magma_SOR || precond->solver == Magma_SSOR ) {
+        CHECK( magma_zmcsor( b, x, precond, queue ));
+    }
     else if ( precond->solver == Magma_PASTIX ) {
         //CHECK( magma_zapplypastix( b, x, precond, queue ));
         info = MAGMA_ERR_NOT_SUPPORTED;
@@ -431,6 +448,10 @@ magma_z_applyprecond_left(
         if ( precond->solver == Magma_JACOBI ) {
             CHECK( magma_zjacobi_diagscal( b.num_rows, precond->d, b, x, queue ));
         }
+        else if ( precond->solver == Magma_GS  || precond->solver == Magma_SGS ||
+                  precond->solver == Magma_SOR || precond->solver == Magma_SSOR ) {
+            CHECK( magma_zmcsor( b, x, precond, queue ));
+        }
         else if ( ( precond->solver == Magma_ILU ||
                     precond->solver == Magma_PARILU ) && 
                   ( precond->trisolver == Magma_CUSOLVE ||
@@ -487,6 +508,10 @@ magma_z_applyprecond_left(
         if ( precond->solver == Magma_JACOBI ) {
             CHECK( magma_zjacobi_diagscal( b.num_rows, precond->d, b, x, queue ));
         }
+        else if ( precond->solver == Magma_SGS || precond->solver == Magma_SSOR ) {
+            // symmetric for symmetric A
+            CHECK( magma_zmcsor( b, x, precond, queue ));
+        }
         else if ( ( precond->solver == Magma_ILU ||
                     precond->solver == Magma_PARILU ) && 
                   ( precond->trisolver == Magma_CUSOLVE ||
@@ -598,7 +623,9 @@ magma_z_applyprecond_right(
     zopts.solver_par.rtol = 1e-10;
     
     if( trans == MagmaNoTrans ) {
-        if ( precond->solver == Magma_JACOBI ) {
+        if ( precond->solver == Magma_JACOBI ||
+             precond->solver == Magma_GS  || precond->solver == Magma_SGS ||
+             precond->solver == Magma_SOR || precond->solver == Magma_SSOR ) {
             magma_zcopy( b.num_rows*b.num_cols, b.dval, 1, x->dval, 1, queue );    // x = b
         }
         else if ( ( precond->solver == Magma_ILU ||
@@ -658,7 +685,9 @@ magma_z_applyprecond_right(
             info = MAGMA_ERR_NOT_SUPPORTED;
         }
     } else if ( trans == MagmaTrans ){
-        if ( precond->solver == Magma_JACOBI ) {
+        if ( precond->solver == Magma_JACOBI ||
+             precond->solver == Magma_GS  || precond->solver == Magma_SGS ||
+             precond->solver == Magma_SOR || precond->solver == Magma_SSOR ) {
             magma_zcopy( b.num_rows*b.num_cols, b.dval, 1, x->dval, 1, queue );    // x = b
         }
         else if ( ( precond->solver == Magma_ILU ||
@@ -703,3 +732,156 @@ magma_z_applyprecond_right(
 cleanup:
     return info;
 }
+
+
+/**
+    Purpose
+    -------
+
+    Host variant of magma_z_precondsetup for the solvers running on the CPU.
+    Jacobi (diagonal scaling), the multicolor smoothers GS, SGS, SOR, SSOR
+    and no preconditioning are supported; all data is kept in host memory.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                sparse matrix A in CSR format on the CPU
+
+    @param[in,out]
+    precond     magma_z_preconditioner*
+                preconditioner
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_z_precondsetup_cpu(
+    magma_z_matrix A,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+
+    tempo1 = magma_wtime();
+
+    if( A.num_rows != A.num_cols ){
+        printf("%% warning: non-square matrix.\n");
+        printf("%% Fallback: no preconditioner.\n");
+        precond->solver = Magma_NONE;
+    }
+
+    if ( precond->solver == Magma_JACOBI ) {
+        CHECK( magma_zjacobisetup_diagscal_cpu( A, &(precond->d), queue ));
+    }
+    else if ( precond->solver == Magma_GS  || precond->solver == Magma_SGS ||
+              precond->solver == Magma_SOR || precond->solver == Magma_SSOR ) {
+        CHECK( magma_zmcsorsetup( A, Magma_CPU, precond, queue ));
+    }
+    else if ( precond->solver != Magma_NONE ) {
+        printf( "error: preconditioner type not supported on the CPU.\n" );
+        info = MAGMA_ERR_NOT_SUPPORTED;
+    }
+
+    tempo2 = magma_wtime();
+    precond->setuptime = tempo2-tempo1;
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Applies the preconditioner set up by magma_z_precondsetup_cpu to a
+    vector in host memory: x = D^{-1} b for Jacobi, precond->maxiter
+    multicolor sweeps from x = 0 for the Gauss-Seidel family, x = b otherwise.
+    A NULL preconditioner is the identity. The transposed GS and SOR
+    sweeps are not supported; SGS and SSOR are symmetric for symmetric A.
+
+    Arguments
+    ---------
+
+    @param[in]
+    trans       magma_trans_t
+                apply the preconditioner (MagmaNoTrans), its transpose
+                (MagmaTrans) or its conjugate transpose (MagmaConjTrans)
+
+    @param[in]
+    b           magma_z_matrix
+                input vector b on the CPU
+
+    @param[in,out]
+    x           magma_z_matrix*
+                output vector x on the CPU
+
+    @param[in,out]
+    precond     magma_z_preconditioner*
+                preconditioner
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_z_applyprecond_cpu(
+    magma_trans_t trans,
+    magma_z_matrix b,
+    magma_z_matrix *x,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_int_t dofs = b.num_rows*b.num_cols;
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+
+    tempo1 = magma_wtime();
+
+    if ( precond == NULL || precond->solver == Magma_NONE ) {
+        magma_zcopy_cpu( dofs, b.val, x->val );
+    }
+    else if ( precond->solver == Magma_JACOBI &&
+              precond->d.memory_location == Magma_CPU &&
+              precond->d.val != NULL ) {
+        if ( trans == MagmaConjTrans ) {
+            #pragma omp parallel for schedule(static)
+            for( magma_int_t i=0; i < dofs; i++ ) {
+                x->val[i] = MAGMA_Z_CONJ( precond->d.val[i] ) * b.val[i];
+            }
+        } else {
+            magma_zdiagscal_cpu( dofs, precond->d.val, b.val, x->val );
+        }
+    }
+    else if ( ( precond->solver == Magma_SGS || precond->solver == Magma_SSOR ||
+                ( trans == MagmaNoTrans && ( precond->solver == Magma_GS ||
+                                             precond->solver == Magma_SOR ) ) ) &&
+              precond->M.memory_location == Magma_CPU ) {
+        info = magma_zmcsor( b, x, precond, queue );
+    }
+    else {
+        printf( "error: preconditioner type not supported on the CPU.\n" );
+        info = MAGMA_ERR_NOT_SUPPORTED;
+    }
+
+    tempo2 = magma_wtime();
+    if ( precond != NULL ) {
+        precond->runtime += tempo2-tempo1;
+    }
+
+    return info;
+}
@@ -0,0 +1,217 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Hartwig Anzt
+
+       @generated from sparse/src/zcg_cpu.cpp, normal z -> s, Sun Oct 18 03:18:38 2026
+*/
+
+#include "magmasparse_internal.h"
+
+#define RTOLERANCE     lapackf77_slamch( "E" )
+#define ATOLERANCE     lapackf77_slamch( "E" )
+
+
+/*******************************************************************************
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a real symmetric N-by-N positive definite matrix A.
+    This is a CPU implementation of the preconditioned Conjugate
+    Gradient method: A, b and x are in host memory, the SpMV is
+    magma_s_spmv_cpu and the vector updates are OpenMP parallel.
+    <r,h> and <r,r> are computed in one sweep.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_s_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_s_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_s_solver_par*
+                solver parameters
+
+    @param[in]
+    precond_par magma_s_preconditioner*
+                preconditioner set up with magma_s_precondsetup_cpu,
+                or NULL for no preconditioning
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sposv
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_scg_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    // prepare solver feedback
+    solver_par->solver = ( precond_par == NULL ) ? Magma_CG : Magma_PCG;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+
+    // solver variables
+    float alpha, beta;
+    float nom0, r0,  res, nomb;
+    float den, gammanew, gammaold;
+    float skp[2];
+    // local variables
+    float c_zero = MAGMA_S_ZERO, c_one = MAGMA_S_ONE;
+
+    magma_int_t dofs = A.num_rows* b.num_cols;
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+
+    // CPU workspace
+    magma_s_matrix r={Magma_CSR}, p={Magma_CSR}, q={Magma_CSR}, h={Magma_CSR};
+    CHECK( magma_svinit( &r, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &p, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &q, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &h, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+
+    // solver setup
+    magma_scopy_cpu( dofs, b.val, r.val );                              // r = b
+    CHECK( magma_s_spmv( -c_one, A, *x, c_one, r, queue ));             // r = r - A x
+    nom0 = magma_snrm2_cpu( dofs, r.val );
+
+    // preconditioner
+    CHECK( magma_s_applyprecond_cpu( MagmaNoTrans, r, &h, precond_par, queue ));      // h = M r
+    magma_scopy_cpu( dofs, h.val, p.val );                              // p = h
+    gammaold = magma_sdot_cpu( dofs, r.val, h.val );                   // go = <r,h>
+
+    solver_par->init_res = nom0;
+    nomb = magma_snrm2_cpu( dofs, b.val );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    if ( (r0 = nomb * solver_par->rtol) < ATOLERANCE ){
+        r0 = ATOLERANCE;
+    }
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = (real_Double_t)nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < r0 ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+    res = nom0;
+
+    tempo1 = magma_wtime();
+
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+
+        CHECK( magma_s_spmv( c_one, A, p, c_zero, q, queue ));         // q = A p
+        solver_par->spmv_count++;
+        den = magma_sdot_cpu( dofs, p.val, q.val );                    // den = <p,q>
+        // check positive definite
+        if ( MAGMA_S_ABS(den) <= 0.0 ) {
+            info = MAGMA_NONSPD;
+            goto cleanup;
+        }
+
+        alpha = gammaold / den;
+        magma_saxpby_cpu( dofs,  alpha, p.val, c_one, x->val );         // x = x + alpha p
+        magma_saxpby_cpu( dofs, -alpha, q.val, c_one, r.val );          // r = r - alpha q
+
+        // preconditioner
+        CHECK( magma_s_applyprecond_cpu( MagmaNoTrans, r, &h, precond_par, queue ));  // h = M r
+        magma_sdot2_cpu( dofs, r.val, h.val, r.val, r.val, skp );      // <r,h>, <r,r>
+        gammanew = skp[0];
+        res = sqrt( MAGMA_S_REAL( skp[1] ) );
+
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            break;
+        }
+
+        beta = gammanew / gammaold;                                     // beta = gn/go
+        magma_saxpby_cpu( dofs, c_one, h.val, beta, p.val );            // p = h + beta p
+        gammaold = gammanew;
+    }
+    while ( solver_par->numiter+1 <= solver_par->maxiter );
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    float residual;
+    magma_scopy_cpu( dofs, b.val, r.val );
+    CHECK( magma_s_spmv( -c_one, A, *x, c_one, r, queue ));
+    residual = magma_snrm2_cpu( dofs, r.val );
+    solver_par->iter_res = res;
+    solver_par->final_res = residual;
+
+    if ( solver_par->numiter < solver_par->maxiter ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    magma_smfree(&r, queue );
+    magma_smfree(&p, queue );
+    magma_smfree(&q, queue );
+    magma_smfree(&h, queue );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_scg_cpu */
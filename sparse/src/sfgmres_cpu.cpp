@@ -0,0 +1,317 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Hartwig Anzt
+
+       @generated from sparse/src/zfgmres_cpu.cpp, normal z -> s, Sun Oct 18 03:18:38 2026
+*/
+#include "magmasparse_internal.h"
+
+#define PRECISION_s
+
+// simulate 2-D arrays at the cost of some arithmetic
+#define V(i) (V.val+(i)*dofs)
+#define W(i) (W.val+(i)*dofs)
+#define H(i,j) (H[(j)*m1+(i)])
+
+
+#define RTOLERANCE     lapackf77_slamch( "E" )
+#define ATOLERANCE     lapackf77_slamch( "E" )
+
+
+static void
+GeneratePlaneRotation(float dx, float dy, float *cs, float *sn)
+{
+#if defined(PRECISION_s) | defined(PRECISION_d)
+    if (dy == MAGMA_S_ZERO) {
+        *cs = MAGMA_S_ONE;
+        *sn = MAGMA_S_ZERO;
+    } else if (MAGMA_S_ABS((dy)) > MAGMA_S_ABS((dx))) {
+        float temp = dx / dy;
+        *sn = MAGMA_S_ONE / magma_ssqrt( ( MAGMA_S_ONE + temp*temp));
+        *cs = temp * (*sn);
+    } else {
+        float temp = dy / dx;
+        *cs = MAGMA_S_ONE / magma_ssqrt( ( MAGMA_S_ONE + temp*temp ));
+        *sn = temp * (*cs);
+    }
+#else
+    real_Double_t rho = sqrt(MAGMA_S_REAL(MAGMA_S_CONJ(dx)*dx + MAGMA_S_CONJ(dy)*dy));
+    *cs = dx / rho;
+    *sn = dy / rho;
+#endif
+}
+
+static void ApplyPlaneRotation(float *dx, float *dy, float cs, float sn)
+{
+#if defined(PRECISION_s) | defined(PRECISION_d)
+      float temp = (*dx);
+      *dx =  cs * (*dx) + sn * (*dy);
+      *dy = -sn * temp + cs * (*dy);
+#else
+    float temp  =  MAGMA_S_CONJ(cs) * (*dx) +  MAGMA_S_CONJ(sn) * (*dy);
+    *dy = -(sn) * (*dx) + cs * (*dy);
+    *dx = temp;
+#endif
+}
+
+
+/**
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a real sparse matrix stored in host memory.
+    X and B are real vectors stored in host memory.
+    This is a CPU implementation of the right-preconditioned flexible GMRES.
+    The Arnoldi vectors are orthogonalized with classical Gram-Schmidt and
+    one reorthogonalization; each pass computes all projections with one
+    fused sweep (magma_smdotc_cpu) and subtracts them with another
+    (magma_smaxpy_cpu).
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                descriptor for matrix A
+
+    @param[in]
+    b           magma_s_matrix
+                RHS b vector
+
+    @param[in,out]
+    x           magma_s_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_s_solver_par*
+                solver parameters
+
+    @param[in]
+    precond_par magma_s_preconditioner*
+                preconditioner set up with magma_s_precondsetup_cpu,
+                or NULL for no preconditioning
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgesv
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_sfgmres_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    magma_int_t dofs = A.num_rows;
+
+    // prepare solver feedback
+    solver_par->solver = ( precond_par == NULL ) ? Magma_GMRES : Magma_PGMRES;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+
+    magma_int_t dim = solver_par->restart;
+    magma_int_t m1 = dim+1; // used inside H macro
+    magma_int_t i, j, k;
+    float beta;
+
+    float rel_resid = 1.0, resid0=1, r0=0.0, betanom = 0.0, nomb;
+
+    magma_s_matrix v_t={Magma_CSR}, w_t={Magma_CSR}, V={Magma_CSR}, W={Magma_CSR};
+    v_t.memory_location = Magma_CPU;
+    v_t.num_rows = dofs;
+    v_t.num_cols = 1;
+    v_t.nnz = dofs;
+    v_t.val = NULL;
+    v_t.storage_type = Magma_DENSE;
+    v_t.major = MagmaColMajor;
+    w_t = v_t;
+
+    float *H={0}, *s={0}, *cs={0}, *sn={0}, *h={0};
+
+    CHECK( magma_smalloc_cpu( &H, (dim+1)*dim ));
+    CHECK( magma_smalloc_cpu( &s,  dim+1 ));
+    CHECK( magma_smalloc_cpu( &cs, dim ));
+    CHECK( magma_smalloc_cpu( &sn, dim ));
+    CHECK( magma_smalloc_cpu( &h,  dim+1 ));
+
+    CHECK( magma_svinit( &V, Magma_CPU, dofs*(dim+1), 1, MAGMA_S_ZERO, queue ));
+    CHECK( magma_svinit( &W, Magma_CPU, dofs*dim, 1, MAGMA_S_ZERO, queue ));
+
+    nomb = magma_snrm2_cpu( dofs, b.val );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    if ( (r0 = nomb * solver_par->rtol) < ATOLERANCE ){
+        r0 = ATOLERANCE;
+    }
+
+    tempo1 = magma_wtime();
+    do
+    {
+        // compute initial residual and its norm
+        v_t.val = V(0);
+        magma_scopy_cpu( dofs, b.val, V(0) );                           // V(0) = b
+        CHECK( magma_s_spmv( -MAGMA_S_ONE, A, *x, MAGMA_S_ONE, v_t, queue )); // V(0) -= A x
+        solver_par->numiter++;
+        solver_par->spmv_count++;
+        beta = MAGMA_S_MAKE( magma_snrm2_cpu( dofs, V(0) ), 0.0 );    // beta = norm(V(0))
+        if( magma_s_isnan_inf( beta ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+
+        if (solver_par->numiter == 1){
+            solver_par->init_res = MAGMA_S_REAL( beta );
+            resid0 = MAGMA_S_REAL( beta );
+            if ( solver_par->verbose > 0 ) {
+                solver_par->res_vec[0] = (real_Double_t) resid0;
+                solver_par->timing[0] = 0.0;
+            }
+            if ( resid0 < r0 ) {
+                solver_par->final_res = solver_par->init_res;
+                solver_par->iter_res = solver_par->init_res;
+                info = MAGMA_SUCCESS;
+                goto cleanup;
+            }
+        }
+
+        magma_saxpby_cpu( dofs, MAGMA_S_ONE/beta, V(0), MAGMA_S_ZERO, V(0) ); // V(0) = V(0)/beta
+
+        for (i = 1; i < dim+1; i++)
+            s[i] = MAGMA_S_ZERO;
+        s[0] = beta;
+
+        i = -1;
+        do {
+            i++;
+
+            // W(i) = M V(i)
+            v_t.val = V(i);
+            w_t.val = W(i);
+            CHECK( magma_s_applyprecond_cpu( MagmaNoTrans, v_t, &w_t, precond_par, queue ));
+
+            // V(i+1) = A W(i)
+            v_t.val = V(i+1);
+            CHECK( magma_s_spmv( MAGMA_S_ONE, A, w_t, MAGMA_S_ZERO, v_t, queue ));
+            solver_par->numiter++;
+            solver_par->spmv_count++;
+
+            // classical Gram-Schmidt, twice
+            CHECK( magma_smdotc_cpu( dofs, i+1, V(0), V(i+1), h ));
+            magma_smaxpy_cpu( dofs, i+1, -MAGMA_S_ONE, V(0), h, MAGMA_S_ONE, V(i+1) );
+            for (k = 0; k <= i; k++)
+                H(k, i) = h[k];
+            CHECK( magma_smdotc_cpu( dofs, i+1, V(0), V(i+1), h ));
+            magma_smaxpy_cpu( dofs, i+1, -MAGMA_S_ONE, V(0), h, MAGMA_S_ONE, V(i+1) );
+            for (k = 0; k <= i; k++)
+                H(k, i) += h[k];
+
+            H(i+1, i) = MAGMA_S_MAKE( magma_snrm2_cpu( dofs, V(i+1) ), 0. ); // H(i+1,i) = ||r||
+            // V(i+1) = V(i+1) / H(i+1, i)
+            magma_saxpby_cpu( dofs, MAGMA_S_ONE/H(i+1, i), V(i+1), MAGMA_S_ZERO, V(i+1) );
+
+            for (k = 0; k < i; k++)
+                ApplyPlaneRotation(&H(k,i), &H(k+1,i), cs[k], sn[k]);
+
+            GeneratePlaneRotation(H(i,i), H(i+1,i), &cs[i], &sn[i]);
+            ApplyPlaneRotation(&H(i,i), &H(i+1,i), cs[i], sn[i]);
+            ApplyPlaneRotation(&s[i], &s[i+1], cs[i], sn[i]);
+
+            betanom = MAGMA_S_ABS( s[i+1] );
+            rel_resid = betanom / nomb;
+            if ( solver_par->verbose > 0 ) {
+                tempo2 = magma_wtime();
+                if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                    solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                            = (real_Double_t) betanom;
+                    solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                            = (real_Double_t) tempo2-tempo1;
+                }
+            }
+            if (rel_resid <= solver_par->rtol || betanom <= solver_par->atol ){
+                info = MAGMA_SUCCESS;
+                break;
+            }
+        }
+        while (i+1 < dim && solver_par->numiter+1 <= solver_par->maxiter);
+
+        // solve upper triangular system in place
+        for (j = i; j >= 0; j--)
+        {
+            s[j] /= H(j,j);
+            for (k = j-1; k >= 0; k--)
+                s[k] -= H(k,j) * s[j];
+        }
+
+        // update the solution: x = x + W s
+        magma_smaxpy_cpu( dofs, i+1, MAGMA_S_ONE, W(0), s, MAGMA_S_ONE, x->val );
+    }
+    while (rel_resid > solver_par->rtol && betanom > solver_par->atol
+                && solver_par->numiter+1 <= solver_par->maxiter);
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    float residual;
+    v_t.val = V(0);
+    magma_scopy_cpu( dofs, b.val, V(0) );
+    CHECK( magma_s_spmv( -MAGMA_S_ONE, A, *x, MAGMA_S_ONE, v_t, queue ));
+    residual = magma_snrm2_cpu( dofs, V(0) );
+    solver_par->iter_res = betanom;
+    solver_par->final_res = residual;
+
+    if ( solver_par->numiter < solver_par->maxiter && info == MAGMA_SUCCESS ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) betanom;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) betanom;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    magma_free_cpu(s);
+    magma_free_cpu(cs);
+    magma_free_cpu(sn);
+    magma_free_cpu(H);
+    magma_free_cpu(h);
+
+    magma_smfree( &V, queue);
+    magma_smfree( &W, queue);
+
+    solver_par->info = info;
+    return info;
+} /* magma_sfgmres_cpu */
@@ -0,0 +1,473 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Hartwig Anzt
+       @author Eduardo Ponce
+       @author Stephen Wood
+
+       @generated from sparse/src/zidr_merge_cpu.cpp, normal z -> s, Sun Oct 18 03:33:43 2026
+*/
+
+#include "magmasparse_internal.h"
+
+#define RTOLERANCE     lapackf77_slamch( "E" )
+#define ATOLERANCE     lapackf77_slamch( "E" )
+
+// simulate 2-D arrays at the cost of some arithmetic
+#define P(i) (P.val+(i)*n)
+#define G(i) (G.val+(i)*n)
+#define U(i) (U.val+(i)*n)
+#define M(i,j) (M[(j)*s+(i)])
+
+
+/*******************************************************************************
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a general real N-by-N matrix A.
+    This is a CPU implementation of the Induced Dimension Reduction method
+    with residual smoothing in variant, where multiple operations are
+    merged into one sweep over memory. The SpMV G(:,k) = A U(:,k) also
+    computes all projections P' G(:,k), the bi-orthogonalization against
+    G(:,0:k) is then a small triangular solve with M(0:k,0:k) instead of
+    k sweeps, and one sweep applies it to G(:,k) and U(:,k) together with
+    the x and r updates and the smoothing dot products.
+
+    A is used in CSR or SELLP, other formats are converted to CSR once.
+    The estimated bytes moved per iteration are returned in
+    solver_par->iter_bytes.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_s_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_s_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_s_solver_par*
+                solver parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgesv
+*******************************************************************************/
+
+
+extern "C" magma_int_t
+magma_sidr_merge_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    // prepare solver feedback
+    solver_par->solver = Magma_IDRMERGE;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+    solver_par->init_res = 0.0;
+    solver_par->final_res = 0.0;
+    solver_par->iter_res = 0.0;
+    solver_par->runtime = 0.0;
+    solver_par->iter_bytes = 0.0;
+
+    // constants
+    const float c_zero = MAGMA_S_ZERO;
+    const float c_one = MAGMA_S_ONE;
+    const float c_n_one = MAGMA_S_NEG_ONE;
+
+    // internal user parameters
+    const float angle = 0.7;          // [0-1]
+
+    // local variables
+    magma_int_t iseed[4] = {0, 0, 0, 1};
+    magma_int_t ione = 1;
+    magma_int_t n = A.num_rows;
+    magma_int_t dof, lwork, lapack_info;
+    magma_int_t s;
+    magma_int_t distr;
+    magma_int_t k, i, j, sk;
+    magma_int_t innerflag;
+    magma_int_t convert = 0;
+    float residual;
+    float nrmb;
+    float nrmr;
+    float nrmt;
+    float rho;
+    float om;
+    float gamma;
+    float mkk;
+    float skp[3];
+    float vbytes, abytes;
+
+    // matrices and vectors
+    magma_s_matrix Ah = {Magma_CSR};
+    magma_s_matrix xs = {Magma_CSR}, r = {Magma_CSR}, rs = {Magma_CSR};
+    magma_s_matrix P = {Magma_CSR}, G = {Magma_CSR}, U = {Magma_CSR};
+    magma_s_matrix t = {Magma_CSR};
+    float *M = NULL, *f = NULL, *c = NULL, *hbeta = NULL;
+    float *m = NULL, *alpha = NULL;
+    float *tau = NULL, *work = NULL;
+
+    // chronometry
+    real_Double_t tempo1, tempo2;
+
+    // shadow space dimension, see magma_sidr
+    s = 1;
+    if ( solver_par->restart != 50 ) {
+        if ( solver_par->restart > A.num_cols ) {
+            s = A.num_cols;
+        } else {
+            s = solver_par->restart;
+        }
+    }
+    solver_par->restart = s;
+
+    // set max iterations
+    solver_par->maxiter = min( 2 * A.num_cols, solver_par->maxiter );
+
+    // check if matrix A is square
+    if ( A.num_rows != A.num_cols ) {
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
+    if ( A.storage_type == Magma_CSR || A.storage_type == Magma_SELLP ) {
+        Ah = A;
+    } else {
+        CHECK( magma_smconvert( A, &Ah, A.storage_type, Magma_CSR, queue ));
+        convert = 1;
+    }
+
+    // |b|
+    nrmb = magma_snrm2_cpu( n, b.val );
+    if ( nrmb == 0.0 ) {
+        magma_saxpby_cpu( n, c_zero, b.val, c_zero, x->val );
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    // r = b - A x
+    CHECK( magma_svinit( &r, Magma_CPU, n, 1, c_zero, queue ));
+    magma_scopy_cpu( n, b.val, r.val );
+    CHECK( magma_s_spmv( c_n_one, Ah, *x, c_one, r, queue ));
+    nrmr = magma_snrm2_cpu( n, r.val );
+
+    // |r|
+    solver_par->init_res = nrmr;
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = (real_Double_t)nrmr;
+    }
+
+    // check if initial is guess good enough
+    if ( nrmr <= solver_par->atol ||
+        nrmr/nrmb <= solver_par->rtol ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    // P = randn(n, s)
+    CHECK( magma_svinit( &P, Magma_CPU, n, s, c_zero, queue ));
+    distr = 3;        // 1 = unif (0,1), 2 = unif (-1,1), 3 = normal (0,1)
+    dof = n * s;
+    lapackf77_slarnv( &distr, iseed, &dof, P.val );
+
+    // P = ortho(P), Householder QR on the host
+    lwork = n * s;
+    CHECK( magma_smalloc_cpu( &tau, s ));
+    CHECK( magma_smalloc_cpu( &work, lwork ));
+    lapackf77_sgeqrf( &n, &s, P.val, &n, tau, work, &lwork, &lapack_info );
+    lapackf77_sorgqr( &n, &s, &s, P.val, &n, tau, work, &lwork, &lapack_info );
+    if ( lapack_info != 0 ) {
+        info = MAGMA_ERR;
+        goto cleanup;
+    }
+
+    // smoothing solution and residual vectors
+    CHECK( magma_svinit( &xs, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_svinit( &rs, Magma_CPU, n, 1, c_zero, queue ));
+    magma_scopy_cpu( n, x->val, xs.val );
+    magma_scopy_cpu( n, r.val, rs.val );
+
+    // G(n,s) = 0, U(n,s) = 0
+    CHECK( magma_svinit( &G, Magma_CPU, n, s, c_zero, queue ));
+    CHECK( magma_svinit( &U, Magma_CPU, n, s, c_zero, queue ));
+
+    // M(s,s) = I
+    CHECK( magma_smalloc_cpu( &M, s*s ));
+    for ( k = 0; k < s*s; ++k ) {
+        M[k] = c_zero;
+    }
+    for ( k = 0; k < s; ++k ) {
+        M(k,k) = c_one;
+    }
+
+    // f = 0, c = 0, beta = 0
+    CHECK( magma_smalloc_cpu( &f, s ));
+    CHECK( magma_smalloc_cpu( &c, s ));
+    CHECK( magma_smalloc_cpu( &hbeta, s ));
+
+    // projections P' G(:,k) and bi-orthogonalization coefficients
+    CHECK( magma_smalloc_cpu( &m, s+3 ));
+    CHECK( magma_smalloc_cpu( &alpha, s ));
+
+    // t = 0
+    CHECK( magma_svinit( &t, Magma_CPU, n, 1, c_zero, queue ));
+
+    // bytes per iteration: f = P' r, then per shadow step the new direction,
+    // the SpMV with P, the update and the smoothing, then the omega step
+    vbytes = (float) n * sizeof(float);
+    abytes = magma_smergebytes_cpu( Ah );
+    solver_par->iter_bytes = (s + 1) * vbytes + abytes + 16.0 * vbytes;
+    for ( k = 0; k < s; ++k ) {
+        solver_par->iter_bytes += abytes
+                + ( 2*(s-k) + 2 + (s+2) + (2*k + 9) + 6 ) * vbytes;
+    }
+
+    //--------------START TIME---------------
+    // chronometry
+    tempo1 = magma_wtime();
+    if ( solver_par->verbose > 0 ) {
+        solver_par->timing[0] = 0.0;
+    }
+
+    om = MAGMA_S_ONE;
+    innerflag = 0;
+
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+
+        // new RHS for small systems
+        // f = P' r
+        CHECK( magma_smdotc_cpu( n, s, P.val, r.val, f ));
+
+        // shadow space loop
+        for ( k = 0; k < s; ++k ) {
+            sk = s - k;
+
+            // M(k:s,k:s) c(k:s) = f(k:s)
+            for ( i = k; i < s; ++i ) {
+                c[i] = f[i];
+            }
+            blasf77_strsv( MagmaLowerStr, MagmaNoTransStr, MagmaNonUnitStr,
+                           &sk, &M(k,k), &s, &c[k], &ione );
+
+            // U(:,k) = om * (r - G(:,k:s) c(k:s)) + U(:,k:s) c(k:s)
+            magma_sidrmerge_dir_cpu( n, sk, om, &c[k], r.val, G(k), U(k), U(k) );
+
+            // G(:,k) = A U(:,k), m = P' G(:,k)
+            CHECK( magma_sidrmerge_spmv_cpu( Ah, s, P.val, 0, U(k), G(k), m ));
+            solver_par->spmv_count++;
+
+            // bi-orthogonalize the new basis vectors:
+            // M(0:k,0:k) alpha = P(:,0:k)' G(:,k) gives the coefficients of
+            // the sequential projections against G(:,0:k)
+            for ( i = 0; i < k; ++i ) {
+                alpha[i] = m[i];
+            }
+            if ( k > 0 ) {
+                blasf77_strsv( MagmaLowerStr, MagmaNoTransStr, MagmaNonUnitStr,
+                               &k, M, &s, alpha, &ione );
+            }
+
+            // new column of M = P'G, first k-1 entries are zero
+            // M(k:s,k) = P(:,k:s)' G(:,k) - M(k:s,0:k) alpha
+            for ( i = k; i < s; ++i ) {
+                M(i,k) = m[i];
+                for ( j = 0; j < k; ++j ) {
+                    M(i,k) -= M(i,j) * alpha[j];
+                }
+            }
+
+            // check M(k,k) == 0
+            mkk = M(k,k);
+            if ( MAGMA_S_EQUAL(mkk, MAGMA_S_ZERO) ) {
+                innerflag = 1;
+                info = MAGMA_DIVERGENCE;
+                break;
+            }
+
+            // beta = f(k) / M(k,k)
+            hbeta[k] = f[k] / mkk;
+
+            // check for nan
+            if ( magma_s_isnan( hbeta[k] ) || magma_s_isinf( hbeta[k] )) {
+                innerflag = 1;
+                info = MAGMA_DIVERGENCE;
+                break;
+            }
+
+            // G(:,k) = G(:,k) - G(:,0:k) alpha, U(:,k) = U(:,k) - U(:,0:k) alpha,
+            // r = r - beta * G(:,k), x = x + beta * U(:,k)
+            // and the smoothing products (t' * rs), (t' * t) with t = rs - r
+            magma_sidrmerge_update_cpu( n, k, alpha, hbeta[k], G.val, U.val,
+                                        G(k), U(k), r.val, x->val, rs.val, skp );
+
+            // smoothing operation
+            // gamma = (t' * rs) / (t' * t)
+            gamma = skp[0] / skp[1];
+
+            // rs = rs - gamma * (rs - r), xs = xs - gamma * (xs - x)
+            magma_sidrmerge_smooth_cpu( n, gamma, r.val, x->val, rs.val, xs.val, skp );
+
+            // |rs|
+            nrmr = sqrt( MAGMA_S_REAL( skp[0] ) );
+
+            // store current timing and residual
+            if ( solver_par->verbose > 0 ) {
+                tempo2 = magma_wtime();
+                if ( (solver_par->numiter) % solver_par->verbose == 0 ) {
+                    solver_par->res_vec[(solver_par->numiter) / solver_par->verbose]
+                            = (real_Double_t)nrmr;
+                    solver_par->timing[(solver_par->numiter) / solver_par->verbose]
+                            = (real_Double_t)tempo2 - tempo1;
+                }
+            }
+
+            // check convergence
+            if ( nrmr <= solver_par->atol ||
+                nrmr/nrmb <= solver_par->rtol ) {
+                innerflag = 2;
+                info = MAGMA_SUCCESS;
+                break;
+            }
+
+            // non-last s iteration
+            if ( (k + 1) < s ) {
+                // f(k+1:s) = f(k+1:s) - beta * M(k+1:s,k)
+                for ( i = k+1; i < s; ++i ) {
+                    f[i] -= hbeta[k] * M(i,k);
+                }
+            }
+        }
+
+        // check convergence or iteration limit or invalid result of inner loop
+        if ( innerflag > 0 ) {
+            break;
+        }
+
+        // t = A r, |t|^2, t'r and |r|^2 in one sweep
+        CHECK( magma_sidrmerge_spmv_cpu( Ah, 0, NULL, 1, r.val, t.val, skp ));
+        solver_par->spmv_count++;
+
+        // computation of a new omega
+        nrmt = sqrt( MAGMA_S_REAL( skp[0] ) );
+        nrmr = sqrt( MAGMA_S_REAL( skp[2] ) );
+
+        // rho = abs(t' * r) / (|t| * |r|))
+        rho = MAGMA_D_ABS( MAGMA_S_REAL(skp[1]) / (nrmt * nrmr) );
+
+        // om = (t' * r) / (|t| * |t|)
+        om = skp[1] / (nrmt * nrmt);
+        if ( rho < angle ) {
+            om = (om * angle) / rho;
+        }
+        if ( MAGMA_S_EQUAL(om, MAGMA_S_ZERO) ) {
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+
+        // r = r - om * t, x = x + om * r
+        // and the smoothing products (t' * rs), (t' * t) with t = rs - r
+        magma_sidrmerge_update_cpu( n, 0, NULL, om, NULL, NULL,
+                                    t.val, r.val, r.val, x->val, rs.val, skp );
+
+        // smoothing operation
+        // gamma = (t' * rs) / (|t| * |t|)
+        gamma = skp[0] / skp[1];
+
+        // rs = rs - gamma * (rs - r), xs = xs - gamma * (xs - x)
+        magma_sidrmerge_smooth_cpu( n, gamma, r.val, x->val, rs.val, xs.val, skp );
+
+        // |rs|
+        nrmr = sqrt( MAGMA_S_REAL( skp[0] ) );
+
+        // store current timing and residual
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter) % solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter) / solver_par->verbose]
+                        = (real_Double_t)nrmr;
+                solver_par->timing[(solver_par->numiter) / solver_par->verbose]
+                        = (real_Double_t)tempo2 - tempo1;
+            }
+        }
+
+        // check convergence
+        if ( nrmr <= solver_par->atol ||
+            nrmr/nrmb <= solver_par->rtol ) {
+            info = MAGMA_SUCCESS;
+            break;
+        }
+    }
+    while ( solver_par->numiter + 1 <= solver_par->maxiter );
+
+    // x = xs
+    magma_scopy_cpu( n, xs.val, x->val );
+
+    // get last iteration timing
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t)tempo2 - tempo1;
+//--------------STOP TIME----------------
+
+    // get final stats
+    solver_par->iter_res = nrmr;
+    magma_scopy_cpu( n, b.val, r.val );
+    CHECK( magma_s_spmv( c_n_one, Ah, *x, c_one, r, queue ));
+    residual = magma_snrm2_cpu( n, r.val );
+    solver_par->final_res = residual;
+
+    // set solver conclusion
+    if ( info != MAGMA_SUCCESS && info != MAGMA_DIVERGENCE ) {
+        if ( solver_par->init_res > solver_par->final_res ) {
+            info = MAGMA_SLOW_CONVERGENCE;
+        }
+    }
+
+
+cleanup:
+    // free resources
+    if ( convert ) {
+        magma_smfree( &Ah, queue );
+    }
+    magma_smfree( &xs, queue );
+    magma_smfree( &rs, queue );
+    magma_smfree( &r, queue );
+    magma_smfree( &P, queue );
+    magma_smfree( &G, queue );
+    magma_smfree( &U, queue );
+    magma_smfree( &t, queue );
+    magma_free_cpu( M );
+    magma_free_cpu( f );
+    magma_free_cpu( c );
+    magma_free_cpu( hbeta );
+    magma_free_cpu( m );
+    magma_free_cpu( alpha );
+    magma_free_cpu( tau );
+    magma_free_cpu( work );
+
+    solver_par->info = info;
+    return info;
+    /* magma_sidr_merge_cpu */
+}
@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparict.cpp, normal z -> s, Wed Feb 22 15:21:59 2023
+       @generated from sparse/src/zparict.cpp, normal z -> s, Sun Oct 18 06:54:12 2026
 */
 
 #include "magmasparse_internal.h"
@@ -27,50 +27,70 @@
 #endif
 
 
+#ifdef _OPENMP
 /***************************************************************************//**
     Purpose
     -------
+    Moves the factor of a previous ParICT setup in precond to the host,
+    with row index, as the initial guess of magma_sparict_update.
+    Frees the data of precond computed from it, including the ISAI
+    matrices and the transposed factors;
+    it is set up again from the updated factor.
+*******************************************************************************/
+static magma_int_t
+magma_sparict_warmstart(
+    magma_s_preconditioner *precond,
+    magma_s_matrix *L,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
 
-    Prepares the iterative threshold Incomplete Cholesky preconditioner. 
-    The strategy is interleaving a parallel fixed-point iteration that 
-    approximates an incomplete factorization for a given nonzero pattern with a 
-    procedure that adaptively changes the pattern. Much of this new algorithm 
-    has fine-grained parallelism, and we show that it can efficiently exploit 
-    the compute power of shared memory architectures.
-
-    This is the routine used in the publication by Anzt, Chow, Dongarra:
-    ''ParILUT - A new parallel threshold ILU factorization''
-    submitted to SIAM SISC in 2016.
-
-    This function requires OpenMP, and is only available if OpenMP is activated.
-
-    Arguments
-    ---------
-
-    @param[in]
-    A           magma_s_matrix
-                input matrix A
-
-    @param[in]
-    b           magma_s_matrix
-                input RHS b
+    CHECK( magma_smtransfer( precond->M, L, precond->M.memory_location, Magma_CPU, queue ));
+    L->rowidx = NULL;
+    CHECK( magma_smatrix_addrowindex( L, queue ));
+
+    magma_smfree( &precond->M, queue );
+    magma_smfree( &precond->L, queue );
+    magma_smfree( &precond->U, queue );
+    magma_smfree( &precond->LD, queue );
+    magma_smfree( &precond->UD, queue );
+    magma_smfree( &precond->d, queue );
+    magma_smfree( &precond->d2, queue );
+    magma_smfree( &precond->work1, queue );
+    magma_smfree( &precond->work2, queue );
+    magma_trisolve_free( &precond->cuinfoL );
+    magma_trisolve_free( &precond->cuinfoU );
+    if( precond->LT.nnz > 0 ){
+        magma_smfree( &precond->LT, queue );
+        magma_smfree( &precond->UT, queue );
+        magma_smfree( &precond->LDT, queue );
+        magma_smfree( &precond->UDT, queue );
+        magma_trisolve_free( &precond->cuinfoLT );
+        magma_trisolve_free( &precond->cuinfoUT );
+    }
 
-    @param[in,out]
-    precond     magma_s_preconditioner*
-                preconditioner parameters
+cleanup:
+    return info;
+}
+#endif
 
-    @param[in]
-    queue       magma_queue_t
-                Queue to execute in.
 
-    @ingroup magmasparse_sgepr
+/***************************************************************************//**
+    Purpose
+    -------
+    ParICT iterations of magma_sparict and magma_sparict_update.
+    The initial guess is the lower triangular part of A, or, if warmstart,
+    the factor in precond. In the latter case, the number of nonzeros of the
+    factor is kept, the IC residual norm before and after the iterations
+    is returned in precond->init_res and precond->final_res, and the ISAI
+    matrices and transposed factors of the setup are computed again.
 *******************************************************************************/
-extern "C"
-magma_int_t
-magma_sparict(
+static magma_int_t
+magma_sparict_iterate(
     magma_s_matrix A,
-    magma_s_matrix b,
     magma_s_preconditioner *precond,
+    magma_int_t sweeps,
+    bool warmstart,
     magma_queue_t queue )
 {
     magma_int_t info = 0;
@@ -93,6 +113,8 @@ magma_sparict(
 
     magma_int_t num_threads, timing = 1; // print timing
     magma_int_t L0nnz;
+    float fill = precond->atol;
+    bool transposed = false;
 
     #pragma omp parallel
     {
@@ -103,44 +125,56 @@ magma_sparict(
     CHECK( magma_smtransfer( A, &hA, A.memory_location, Magma_CPU, queue ));
     CHECK( magma_smtransfer( A, &A0, A.memory_location, Magma_CPU, queue ));
 
+    if( warmstart ){
+        // start from the previous factor, and keep its number of nonzeros;
+        // the candidates come from the pattern of A
+        transposed = ( precond->LT.nnz > 0 );
+        CHECK( magma_sparict_warmstart( precond, &L, queue ));
+        CHECK( magma_smatrix_tril( hA, &L0, queue ));
+        L0nnz = L.nnz;
+        fill = 1.0;
+        CHECK( magma_sparilut_residual_norm( A0, L, L, &precond->init_res, queue ));
+        // adapt the values to the new A before changing the pattern
+        CHECK( magma_sparict_sweep_sync( &A0, &L, queue ) );
+    } else {
         // in case using fill-in
-    if( precond->levels > 0 ){
-        CHECK( magma_ssymbilu( &hA, precond->levels, &hL, &hU , queue ));
-    }
-    magma_smfree(&hU, queue );
-    L.diagorder_type = Magma_VALUE;
-    magma_smatrix_tril( hA, &L, queue );
-    L.rowidx = NULL;
-    magma_smatrix_addrowindex( &L, queue ); 
-    L0nnz=L.nnz;
+        if( precond->levels > 0 ){
+            CHECK( magma_ssymbilu_stats( &hA, precond->levels, &hL, &hU, &precond->symbilu, queue ));
+        }
+        magma_smfree(&hU, queue );
+        L.diagorder_type = Magma_VALUE;
+        magma_smatrix_tril( hA, &L, queue );
+        L.rowidx = NULL;
+        magma_smatrix_addrowindex( &L, queue ); 
+        L0nnz=L.nnz;
+        // as in magma_sparict_cpu, a sweep on the pattern of A first
+        CHECK( magma_sparict_sweep_sync( &A0, &L, queue ) );
         
-    // need only lower triangular
-    CHECK( magma_smtransfer( L, &L0, A.memory_location, Magma_CPU, queue ));
+        // need only lower triangular
+        CHECK( magma_smtransfer( L, &L0, A.memory_location, Magma_CPU, queue ));
+    }
     
     if (timing == 1) {
-        printf("ilut_fill_ratio = %.6f;\n\n", precond->atol ); 
+        printf("ilut_fill_ratio = %.6f;\n\n", fill ); 
 
         printf("performance_%d = [\n%%iter L.nnz U.nnz    ILU-Norm     candidat  resid     ILU-norm  selectad  add       transp1   sweep1    selectrm  remove    sweep2    transp2   total       accum\n", (int) num_threads);
     }
 
     //##########################################################################
 
-    for( magma_int_t iters =0; iters<precond->sweeps; iters++ ) {
+    for( magma_int_t iters =0; iters<sweeps; iters++ ) {
     t_rm=0.0; t_add=0.0; t_res=0.0; t_sweep1=0.0; t_sweep2=0.0; t_cand=0.0;
                         t_transpose1=0.0; t_transpose2=0.0; t_selectrm=0.0;
                         t_selectadd=0.0; t_nrm=0.0; t_total = 0.0;
      
-        num_rmL = max( (L_new.nnz-L0nnz*(1+precond->atol*(iters+1)/precond->sweeps)), 0 );
+        num_rmL = max( (L_new.nnz-L0nnz*(1+fill*(iters+1)/sweeps)), 0 );
         start = magma_sync_wtime( queue );
         magma_smfree(&LT, queue );
         magma_scsrcoo_transpose( L, &LT, queue );
         end = magma_sync_wtime( queue ); t_transpose1+=end-start;
         start = magma_sync_wtime( queue ); 
         magma_sparict_candidates( L0, L, LT, &hL, queue );
-        #pragma omp parallel        
-        for(int row=0; row<hL.num_rows; row++){
-            magma_sindexsort( &hL.col[hL.row[row]], 0, hL.row[row+1]-hL.row[row]-1, queue );
-        }
+        CHECK( magma_scsr_sort( &hL, queue ));
         end = magma_sync_wtime( queue ); t_cand=+end-start;
         
         start = magma_sync_wtime( queue );
@@ -159,7 +193,7 @@ magma_sparict(
         start = magma_sync_wtime( queue );
          CHECK( magma_sparict_sweep_sync( &A0, &L_new, queue ) );
         end = magma_sync_wtime( queue ); t_sweep1+=end-start;
-        num_rmL = max( (L_new.nnz-L0nnz*(1+(precond->atol-1.)*(iters+1)/precond->sweeps)), 0 );
+        num_rmL = max( (L_new.nnz-L0nnz*(1+(fill-1.)*(iters+1)/sweeps)), 0 );
         start = magma_sync_wtime( queue );
         magma_sparilut_preselect( 0, &L_new, &oneL, queue );
         //#pragma omp parallel
@@ -195,6 +229,14 @@ magma_sparict(
     if (timing == 1) {
         printf("]; \n");
     }
+
+    if( warmstart ){
+        CHECK( magma_sparilut_residual_norm( A0, L, L, &precond->final_res, queue ));
+        if (timing == 1) {
+            printf("%% ParICT update: IC residual norm %.4e -> %.4e\n",
+                    precond->init_res, precond->final_res );
+        }
+    }
     //##########################################################################
 
 
@@ -210,12 +252,15 @@ magma_sparict(
     CHECK(magma_strisolve_analysis(precond->M, &precond->cuinfoL, false, false, false, queue));
     CHECK(magma_strisolve_analysis(precond->M, &precond->cuinfoU, false, false, true, queue));
     
-    if( precond->trisolver != 0 && precond->trisolver != Magma_CUSOLVE ){
-        //prepare for iterative solves
-        
-        // copy the matrix to precond->L and (transposed) to precond->U
+    if( warmstart || ( precond->trisolver != 0 && precond->trisolver != Magma_CUSOLVE )){
+        // copy the matrix to precond->L and (transposed) to precond->U;
+        // magma_sparict_cpu keeps them also for cuSOLVE
         CHECK( magma_smtransfer(precond->M, &(precond->L), Magma_DEV, Magma_DEV, queue ));
         CHECK( magma_smtranspose( precond->L, &(precond->U), queue ));
+    }
+
+    if( precond->trisolver != 0 && precond->trisolver != Magma_CUSOLVE ){
+        //prepare for iterative solves
         
         // extract the diagonal of L into precond->d
         CHECK( magma_sjacobisetup_diagscal( precond->L, &precond->d, queue ));
@@ -226,7 +271,23 @@ magma_sparict(
         CHECK( magma_svinit( &precond->work2, Magma_DEV, hA.num_rows, 1, MAGMA_S_ZERO, queue ));
     }
 
-    if( precond->trisolver == Magma_JACOBI && precond->pattern == 1 ){
+    if( warmstart && ( precond->trisolver == Magma_ISAI ||
+                       precond->trisolver == Magma_JACOBI ||
+                       precond->trisolver == Magma_VBJACOBI ) ){
+        // the ISAI matrices of the previous factor, set up again
+        // as magma_s_precondsetup does for ParILUT
+        info = magma_siluisaisetup_lower( precond->L, precond->L, &precond->LD, queue );
+        if( info == 0 ){
+            info = magma_siluisaisetup_upper( precond->U, precond->U, &precond->UD, queue );
+        }
+        if( info == Magma_CUSOLVE ){
+            precond->trisolver = Magma_CUSOLVE;
+            info = 0;
+        }
+        if( info != 0 ){
+            goto cleanup;
+        }
+    } else if( precond->trisolver == Magma_JACOBI && precond->pattern == 1 ){
         // dirty workaround for Jacobi trisolves....
         magma_smfree( &hL, queue );
         CHECK( magma_smtransfer( precond->L, &hL, Magma_DEV, Magma_CPU , queue ));
@@ -240,6 +301,17 @@ magma_sparict(
 
     }
 
+    if( transposed ){
+        // the transposed factors for the solvers using A^T
+        CHECK( magma_scumilusetup_transpose( A, precond, queue ));
+        if( precond->trisolver == Magma_ISAI ||
+            precond->trisolver == Magma_JACOBI ||
+            precond->trisolver == Magma_VBJACOBI ){
+            CHECK( magma_smtranspose( precond->LD, &precond->LDT, queue ));
+            CHECK( magma_smtranspose( precond->UD, &precond->UDT, queue ));
+        }
+    }
+
     cleanup:
     magma_smfree( &hA, queue );
     magma_smfree( &hAT, queue );
@@ -252,3 +324,109 @@ magma_sparict(
 #endif
     return info;
 }
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Prepares the iterative threshold Incomplete Cholesky preconditioner. 
+    The strategy is interleaving a parallel fixed-point iteration that 
+    approximates an incomplete factorization for a given nonzero pattern with a 
+    procedure that adaptively changes the pattern. Much of this new algorithm 
+    has fine-grained parallelism, and we show that it can efficiently exploit 
+    the compute power of shared memory architectures.
+
+    This is the routine used in the publication by Anzt, Chow, Dongarra:
+    ''ParILUT - A new parallel threshold ILU factorization''
+    submitted to SIAM SISC in 2016.
+
+    This function requires OpenMP, and is only available if OpenMP is activated.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_s_matrix
+                input RHS b
+
+    @param[in,out]
+    precond     magma_s_preconditioner*
+                preconditioner parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgepr
+*******************************************************************************/
+extern "C"
+magma_int_t
+magma_sparict(
+    magma_s_matrix A,
+    magma_s_matrix b,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue )
+{
+    return magma_sparict_iterate( A, precond, precond->sweeps, false, queue );
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Updates an existing ParICT preconditioner after the values of A changed,
+    with the sparsity pattern of A unchanged. The factor of the previous
+    setup is the initial guess: it is adapted to the new values by one
+    sweep on its pattern, followed by the given number of ParICT steps
+    (candidate addition, sweep, removal, sweep), which keep its number of
+    nonzeros. With updates = 0, only the pattern is kept.
+
+    The preconditioner may come from magma_sparict or magma_sparict_cpu,
+    e.g., from magma_s_precondsetup with Magma_PARICT: both leave the factor
+    as CSR on the device in precond->M. The triangular solve data, the ISAI
+    matrices, and the transposed factors are set up again as by
+    magma_s_precondsetup.
+
+    The Frobenius norm of the residual A - LL^T on the pattern of A before
+    and after the update is returned in precond->init_res and
+    precond->final_res.
+
+    This function requires OpenMP, and is only available if OpenMP is activated.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                input matrix A, current target system
+
+    @param[in,out]
+    precond     magma_s_preconditioner*
+                ParICT preconditioner to update
+
+    @param[in]
+    updates     magma_int_t
+                number of ParICT steps, may be 0
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgepr
+*******************************************************************************/
+extern "C"
+magma_int_t
+magma_sparict_update(
+    magma_s_matrix A,
+    magma_s_preconditioner *precond,
+    magma_int_t updates,
+    magma_queue_t queue )
+{
+    return magma_sparict_iterate( A, precond, updates, true, queue );
+}
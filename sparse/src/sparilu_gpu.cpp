@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparilu_gpu.cpp, normal z -> s, Wed Feb 22 15:21:58 2023
+       @generated from sparse/src/zparilu_gpu.cpp, normal z -> s, Sun Oct 18 06:54:12 2026
 */
 
 #include "magmasparse_internal.h"
@@ -72,7 +72,7 @@ magma_sparilu_gpu(
 
     // in case using fill-in
     if (precond->levels > 0) {
-        CHECK(magma_ssymbilu(&hA, precond->levels, &hAL, &hAUT,  queue));
+        CHECK(magma_ssymbilu_stats(&hA, precond->levels, &hAL, &hAUT, &precond->symbilu, queue));
         magma_smfree(&hAL, queue);
         magma_smfree(&hAUT, queue);
     }
@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparilut_cpu.cpp, normal z -> s, Wed Feb 22 15:21:59 2023
+       @generated from sparse/src/zparilut_cpu.cpp, normal z -> s, Sun Oct 18 06:54:13 2026
 */
 
 #include "magmasparse_internal.h"
@@ -104,7 +104,7 @@ magma_sparilut_cpu(
     
     // in case using fill-in
     if (precond->levels > 0) {
-        CHECK(magma_ssymbilu(&hA, precond->levels, &hL, &hU , queue));
+        CHECK(magma_ssymbilu_stats(&hA, precond->levels, &hL, &hU, &precond->symbilu, queue));
         magma_smfree(&hU, queue);
         magma_smfree(&hL, queue);
     }
@@ -130,67 +130,85 @@ magma_sparilut_cpu(
 
     //##########################################################################
 
+    magma_region_begin("parilut_cpu");
     for (magma_int_t iters =0; iters<precond->sweeps; iters++) {
         t_rm=0.0; t_add=0.0; t_res=0.0; t_sweep1=0.0; t_sweep2=0.0; t_cand=0.0;
         t_transpose1=0.0; t_transpose2=0.0;  t_selectrm=0.0; t_sort = 0;
         t_sort=0.0; t_nrm=0.0; t_total = 0.0;
      
         // step 1: transpose U
+        magma_region_begin("transpose");
         start = magma_sync_wtime(queue);
         magma_smfree(&UT, queue);
         CHECK(magma_scsrcoo_transpose(U, &UT, queue));
         end = magma_sync_wtime(queue); t_transpose1+=end-start;
+        magma_region_end("transpose");
         
         
         // step 2: find candidates
+        magma_region_begin("candidates");
         start = magma_sync_wtime(queue);
         CHECK(magma_sparilut_candidates(L0, U0, L, UT, &hL, &hU, queue));
         end = magma_sync_wtime(queue); t_cand=+end-start;
+        magma_region_end("candidates");
         
         
         // step 3: compute residuals (optional when adding all candidates)
+        magma_region_begin("residuals");
         start = magma_sync_wtime(queue);
         CHECK(magma_sparilut_residuals(hA, L, U, &hL, queue));
         CHECK(magma_sparilut_residuals(hA, L, U, &hU, queue));
         end = magma_sync_wtime(queue); t_res=+end-start;
+        magma_region_end("residuals");
+        magma_region_begin("norm");
         start = magma_sync_wtime(queue);
         CHECK(magma_smatrix_abssum(hL, &sumL, queue));
         CHECK(magma_smatrix_abssum(hU, &sumU, queue));
         sum = sumL + sumU;
         end = magma_sync_wtime(queue); t_nrm+=end-start;
+        magma_region_end("norm");
         CHECK(magma_smatrix_swap(&hL, &oneL, queue));
         magma_smfree(&hL, queue);
         
         
         // step 4: sort candidates
+        magma_region_begin("sort");
         start = magma_sync_wtime(queue);
         CHECK(magma_scsr_sort(&hL, queue));
         CHECK(magma_scsr_sort(&hU, queue));
         end = magma_sync_wtime(queue); t_sort+=end-start;
+        magma_region_end("sort");
         
         
         // step 5: transpose candidates
+        magma_region_begin("transpose_candidates");
         start = magma_sync_wtime(queue);
         magma_scsrcoo_transpose(hU, &oneU, queue);
         end = magma_sync_wtime(queue); t_transpose2+=end-start;
+        magma_region_end("transpose_candidates");
         
         
         // step 6: add candidates
+        magma_region_begin("add");
         start = magma_sync_wtime(queue);
         CHECK(magma_smatrix_cup(L, oneL, &L_new, queue));   
         CHECK(magma_smatrix_cup(U, oneU, &U_new, queue));
         end = magma_sync_wtime(queue); t_add=+end-start;
+        magma_region_end("add");
         magma_smfree(&oneL, queue);
         magma_smfree(&oneU, queue);
        
         
         // step 7: sweep
+        magma_region_begin("sweep1");
         start = magma_sync_wtime(queue);
         CHECK(magma_sparilut_sweep_sync(&hA, &L_new, &U_new, queue));
         end = magma_sync_wtime(queue); t_sweep1+=end-start;
+        magma_region_end("sweep1");
         
         
         // step 8: select threshold to remove elements
+        magma_region_begin("select_threshold");
         start = magma_sync_wtime(queue);
         num_rmL = max((L_new.nnz-L0nnz*(1+(precond->atol-1.)
             *(iters+1)/precond->sweeps)), 0);
@@ -214,9 +232,11 @@ magma_sparilut_cpu(
         magma_smfree(&oneL, queue);
         magma_smfree(&oneU, queue);
         end = magma_sync_wtime(queue); t_selectrm=end-start;
+        magma_region_end("select_threshold");
 
         
         // step 9: remove elements
+        magma_region_begin("remove");
         start = magma_sync_wtime(queue);
         CHECK(magma_sparilut_thrsrm(1, &L_new, &thrsL, queue));
         CHECK(magma_sparilut_thrsrm(1, &U_new, &thrsU, queue));
@@ -225,12 +245,15 @@ magma_sparilut_cpu(
         magma_smfree(&L_new, queue);
         magma_smfree(&U_new, queue);
         end = magma_sync_wtime(queue); t_rm=end-start;
+        magma_region_end("remove");
         
         
         // step 10: sweep
+        magma_region_begin("sweep2");
         start = magma_sync_wtime(queue);
         CHECK(magma_sparilut_sweep_sync(&hA, &L, &U, queue));
         end = magma_sync_wtime(queue); t_sweep2+=end-start;
+        magma_region_end("sweep2");
         
         if (timing == 1) {
             t_total = t_transpose1+ t_cand+ t_res+ t_sort+ t_transpose2+ t_add+ t_sweep1+ t_selectrm+ t_rm+ t_sweep2;
@@ -243,6 +266,8 @@ magma_sparilut_cpu(
         }
     }
 
+    magma_region_end("parilut_cpu");
+
     if (timing == 1) {
         printf("]; \n");
         fflush(stdout);
@@ -270,6 +295,7 @@ magma_sparilut_cpu(
     }
 
 cleanup:
+    magma_region_end("parilut_cpu");
     magma_smfree(&hA, queue);
     magma_smfree(&hAT, queue);
     magma_smfree(&L, queue);
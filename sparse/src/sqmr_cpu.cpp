@@ -0,0 +1,352 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Hartwig Anzt
+
+       @generated from sparse/src/zqmr_cpu.cpp, normal z -> s, Sun Oct 18 03:26:03 2026
+*/
+
+#include "magmasparse_internal.h"
+
+#define RTOLERANCE     lapackf77_slamch( "E" )
+#define ATOLERANCE     lapackf77_slamch( "E" )
+
+
+/*******************************************************************************
+    v = y / rho, y = y / rho, w = wt / psi, z = z / psi in one sweep,
+    host counterpart of magma_sqmr_1.
+*/
+static void
+magma_sqmr_cpu_1(
+    magma_int_t n,
+    float rho,
+    float psi,
+    float *y,
+    float *z,
+    const float *wt,
+    float *v,
+    float *w )
+{
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i < n; i++ ) {
+        float ytmp = y[i] / rho;
+        y[i] = ytmp;
+        v[i] = ytmp;
+        z[i] = z[i] / psi;
+        w[i] = wt[i] / psi;
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a general real N-by-N matrix A.
+    This is a CPU implementation of the (right-preconditioned)
+    Quasi-Minimal Residual method (QMR): A, b and x are in host memory.
+    A^H is formed once on the host for the shadow recurrence.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_s_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_s_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_s_solver_par*
+                solver parameters
+
+    @param[in]
+    precond_par magma_s_preconditioner*
+                preconditioner set up with magma_s_precondsetup_cpu,
+                or NULL for no preconditioning
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgesv
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_sqmr_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    // prepare solver feedback
+    solver_par->solver = ( precond_par == NULL ) ? Magma_QMR : Magma_PQMR;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+
+    // local variables
+    float c_zero = MAGMA_S_ZERO, c_one = MAGMA_S_ONE;
+    // solver variables
+    float nom0, r0, res=0, nomb;
+    float rho = c_one, rho1 = c_one, eta = -c_one , pds = c_one,
+                        thet = c_one, thet1 = c_one, epsilon = c_one,
+                        beta = c_one, delta = c_one, pde = c_one, rde = c_one,
+                        gamm = c_one, gamm1 = c_one, psi = c_one;
+    float skp[2];
+
+    magma_int_t dofs = A.num_rows* b.num_cols;
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+
+    // need to transpose the matrix
+    magma_s_matrix AT={Magma_CSR}, Ah1={Magma_CSR}, Ah2={Magma_CSR};
+
+    // CPU workspace
+    magma_s_matrix r={Magma_CSR}, v={Magma_CSR}, w={Magma_CSR}, wt={Magma_CSR},
+                    d={Magma_CSR}, s={Magma_CSR}, z={Magma_CSR}, q={Magma_CSR},
+                    p={Magma_CSR}, pt={Magma_CSR}, y={Magma_CSR}, yt={Magma_CSR};
+    CHECK( magma_svinit( &r, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &v, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &w, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &wt,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &d, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &s, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &z, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &q, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &p, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &pt,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &y, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &yt,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+
+    // solver setup
+    magma_scopy_cpu( dofs, b.val, r.val );                              // r = b
+    CHECK( magma_s_spmv( -c_one, A, *x, c_one, r, queue ));             // r = r - A x
+    nom0 = magma_snrm2_cpu( dofs, r.val );
+    solver_par->init_res = nom0;
+    magma_scopy_cpu( dofs, r.val, y.val );                              // y = r
+    magma_scopy_cpu( dofs, r.val, wt.val );                             // wt = r
+    CHECK( magma_s_applyprecond_cpu( MagmaConjTrans, wt, &z, precond_par, queue )); // z = M' wt
+
+    // conjugate transpose of the matrix, formed on the host
+    CHECK( magma_smconvert( A, &Ah1, A.storage_type, Magma_CSR, queue ));
+    CHECK( magma_smtranspose( Ah1, &Ah2, queue ));
+    magma_smfree(&Ah1, queue );
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t k=0; k < Ah2.nnz; k++ ) {
+        Ah2.val[k] = MAGMA_S_CONJ( Ah2.val[k] );
+    }
+    AT.blocksize = A.blocksize;
+    AT.alignment = A.alignment;
+    CHECK( magma_smconvert( Ah2, &AT, Magma_CSR, A.storage_type, queue ));
+    magma_smfree(&Ah2, queue );
+
+    nomb = magma_snrm2_cpu( dofs, b.val );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    if ( (r0 = nomb * solver_par->rtol) < ATOLERANCE ){
+        r0 = ATOLERANCE;
+    }
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = (real_Double_t)nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < r0 ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    // psi = norm(z), rho = norm(y)
+    magma_sdot2_cpu( dofs, z.val, z.val, y.val, y.val, skp );
+    psi = magma_ssqrt( skp[0] );
+    rho = magma_ssqrt( skp[1] );
+    magma_sqmr_cpu_1( dofs, rho, psi, y.val, z.val, wt.val, v.val, w.val );
+
+    tempo1 = magma_wtime();
+
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+        if( magma_s_isnan_inf( rho ) || magma_s_isnan_inf( psi ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+
+            // delta = z' * y;
+        delta = magma_sdot_cpu( dofs, z.val, y.val );
+
+        if( magma_s_isnan_inf( delta ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+
+            // yt = M y
+        CHECK( magma_s_applyprecond_cpu( MagmaNoTrans, y, &yt, precond_par, queue ));
+
+        if( solver_par->numiter == 1 ){
+                // p = yt;
+                // q = z;
+            magma_scopy_cpu( dofs, yt.val, p.val );
+            magma_scopy_cpu( dofs, z.val, q.val );
+        }
+        else{
+            pde = psi * delta / epsilon;
+            rde = rho * MAGMA_S_CONJ(delta/epsilon);
+                // p = yt - pde * p;
+            magma_saxpby_cpu( dofs, c_one, yt.val, -pde, p.val );
+                // q = z - rde * q;
+            magma_saxpby_cpu( dofs, c_one, z.val, -rde, q.val );
+        }
+
+        CHECK( magma_s_spmv( c_one, A, p, c_zero, pt, queue ));
+        solver_par->spmv_count++;
+            // epsilon = q' * pt;
+        epsilon = magma_sdot_cpu( dofs, q.val, pt.val );
+        beta = epsilon / delta;
+
+        if( magma_s_isnan_inf( epsilon ) || magma_s_isnan_inf( beta ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+            // y = pt - beta * v;
+        magma_scopy_cpu( dofs, pt.val, y.val );
+        magma_saxpby_cpu( dofs, -beta, v.val, c_one, y.val );
+
+            // wt = A' * q - beta' * w;
+        CHECK( magma_s_spmv( c_one, AT, q, c_zero, wt, queue ));
+        solver_par->spmv_count++;
+        magma_saxpby_cpu( dofs, -MAGMA_S_CONJ( beta ), w.val, c_one, wt.val );
+
+            // z = M' wt
+        CHECK( magma_s_applyprecond_cpu( MagmaConjTrans, wt, &z, precond_par, queue ));
+
+        rho1 = rho;
+            // rho = norm(y);
+        rho = MAGMA_S_MAKE( magma_snrm2_cpu( dofs, y.val ), 0.0 );
+
+        thet1 = thet;
+        thet = rho / (gamm * MAGMA_S_MAKE( MAGMA_S_ABS(beta), 0.0 ));
+        gamm1 = gamm;
+
+        gamm = c_one / magma_ssqrt(c_one + thet*thet);
+        eta = - eta * rho1 * gamm * gamm / (beta * gamm1 * gamm1);
+
+        if( magma_s_isnan_inf( thet ) || magma_s_isnan_inf( gamm ) || magma_s_isnan_inf( eta ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+
+            // d = eta * p + (thet1 * gamm)^2 * d;
+            // s = eta * pt + (thet1 * gamm)^2 * s;
+        pds = ( solver_par->numiter == 1 ) ? c_zero : (thet1 * gamm) * (thet1 * gamm);
+        magma_saxpby_cpu( dofs, eta, p.val, pds, d.val );
+        magma_saxpby_cpu( dofs, eta, pt.val, pds, s.val );
+            // x = x + d;
+        magma_saxpby_cpu( dofs, c_one, d.val, c_one, x->val );
+            // r = r - s;
+        magma_saxpby_cpu( dofs, -c_one, s.val, c_one, r.val );
+
+            // psi = norm(z), res = norm(r)
+        magma_sdot2_cpu( dofs, z.val, z.val, r.val, r.val, skp );
+        psi = magma_ssqrt( skp[0] );
+        res = sqrt( MAGMA_S_REAL( skp[1] ) );
+
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        // v = y / rho
+        // y = y / rho
+        // w = wt / psi
+        // z = z / psi
+        magma_sqmr_cpu_1( dofs, rho, psi, y.val, z.val, wt.val, v.val, w.val );
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            info = MAGMA_SUCCESS;
+            break;
+        }
+    }
+    while ( solver_par->numiter+1 <= solver_par->maxiter );
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    float residual;
+    magma_scopy_cpu( dofs, b.val, r.val );
+    CHECK( magma_s_spmv( -c_one, A, *x, c_one, r, queue ));
+    residual = magma_snrm2_cpu( dofs, r.val );
+    solver_par->iter_res = res;
+    solver_par->final_res = residual;
+
+    if ( solver_par->numiter < solver_par->maxiter && info == MAGMA_SUCCESS ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    magma_smfree(&r,  queue );
+    magma_smfree(&v,  queue );
+    magma_smfree(&w,  queue );
+    magma_smfree(&wt, queue );
+    magma_smfree(&d,  queue );
+    magma_smfree(&s,  queue );
+    magma_smfree(&z,  queue );
+    magma_smfree(&q,  queue );
+    magma_smfree(&p,  queue );
+    magma_smfree(&pt, queue );
+    magma_smfree(&y,  queue );
+    magma_smfree(&yt, queue );
+    magma_smfree(&AT, queue );
+    magma_smfree(&Ah1, queue );
+    magma_smfree(&Ah2, queue );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_sqmr_cpu */
@@ -0,0 +1,267 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Hartwig Anzt
+
+       @precisions normal z -> s d c
+*/
+
+#include "magmasparse_internal.h"
+
+#define RTOLERANCE     lapackf77_dlamch( "E" )
+#define ATOLERANCE     lapackf77_dlamch( "E" )
+
+
+/**
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a general N-by-N matrix.
+    This is a CPU implementation of the Biconjugate Gradient Stabilized
+    method in variant, where multiple operations are merged into one sweep
+    over memory: each SpMV forms its input vector on the fly and computes
+    the dot products needed next, the solution and residual updates are
+    fused with <r,r> and <rr,r>. An iteration takes three sweeps.
+
+    A is used in CSR or SELLP, other formats are converted to CSR once.
+    The estimated bytes moved per iteration are returned in
+    solver_par->iter_bytes.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_z_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_z_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_z_solver_par*
+                solver parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgesv
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zbicgstab_merge_cpu(
+    magma_z_matrix A, magma_z_matrix b, magma_z_matrix *x,
+    magma_z_solver_par *solver_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    // prepare solver feedback
+    solver_par->solver = Magma_BICGSTABMERGE;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+    solver_par->iter_bytes = 0.0;
+
+    // some useful variables
+    magmaDoubleComplex c_zero = MAGMA_Z_ZERO;
+    magmaDoubleComplex c_one  = MAGMA_Z_ONE;
+
+    magma_int_t n = A.num_rows;
+    magma_int_t convert = 0;
+
+    // workspace, p/pn and v/vn are swapped every iteration
+    magma_z_matrix Ah={Magma_CSR}, r={Magma_CSR}, rr={Magma_CSR}, p={Magma_CSR},
+                   pn={Magma_CSR}, v={Magma_CSR}, vn={Magma_CSR}, s={Magma_CSR},
+                   t={Magma_CSR}, tmp={Magma_CSR};
+
+    // solver variables
+    magmaDoubleComplex alpha, beta, omega, rho_old, rho_new;
+    magmaDoubleComplex skp[2];
+    double nom0, r0, res, nomb;
+    res=0;
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+
+    if ( A.storage_type == Magma_CSR || A.storage_type == Magma_SELLP ) {
+        Ah = A;
+    } else {
+        CHECK( magma_zmconvert( A, &Ah, A.storage_type, Magma_CSR, queue ));
+        convert = 1;
+    }
+    CHECK( magma_zvinit( &r, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &rr,Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &p, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &pn,Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &v, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &vn,Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &s, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &t, Magma_CPU, n, 1, c_zero, queue ));
+
+    // two SpMVs, gathers r, p, v and r, v, rr read, pn, vn, s, t written,
+    // then p, s, t, rr, r read, x updated and r written
+    solver_par->iter_bytes = 2.0 * magma_zmergebytes_cpu( Ah )
+                             + 17.0 * n * sizeof(magmaDoubleComplex);
+
+    // solver setup
+    magma_zcopy_cpu( n, b.val, r.val );                                 // r = b
+    CHECK( magma_z_spmv( -c_one, Ah, *x, c_one, r, queue ));            // r = r - A x
+    magma_zcopy_cpu( n, r.val, rr.val );                                // rr = r
+    magma_zdotc2_cpu( n, r.val, r.val, rr.val, r.val, skp );
+    nom0 = sqrt( MAGMA_Z_REAL( skp[0] ) );
+    rho_new = skp[1];                                                   // rho = <rr,r>
+    rho_old = omega = alpha = c_one;
+    beta = c_zero;                                                      // p = 0, v = 0
+    solver_par->init_res = nom0;
+
+    nomb = magma_dznrm2_cpu( n, b.val );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    if ( (r0 = nomb * solver_par->rtol) < ATOLERANCE ){
+        r0 = ATOLERANCE;
+    }
+
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < r0 ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    tempo1 = magma_wtime();
+
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+
+        if ( solver_par->numiter > 1 ) {
+            beta = rho_new/rho_old * alpha/omega;   // beta=rho/rho_old *alpha/omega
+            if( magma_z_isnan_inf( beta ) ){
+                info = MAGMA_DIVERGENCE;
+                break;
+            }
+        }
+
+        // pn = r + beta (p - omega v), vn = A pn, <rr,vn>
+        magma_zbicgmerge_spmv1_cpu( Ah, beta, omega, r.val, rr.val, p.val, v.val,
+                                    pn.val, vn.val, skp );
+        solver_par->spmv_count++;
+        tmp = p; p = pn; pn = tmp;
+        tmp = v; v = vn; vn = tmp;
+        alpha = rho_new / skp[0];
+        if( magma_z_isnan_inf( alpha ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+
+        // s = r - alpha v, t = A s, omega = <t,s>/<t,t>
+        magma_zbicgmerge_spmv2_cpu( Ah, alpha, r.val, v.val, s.val, t.val, skp );
+        solver_par->spmv_count++;
+        omega = skp[0] / skp[1];
+
+        if( magma_z_isnan_inf( omega ) ){
+            magma_zaxpby_cpu( n, alpha, p.val, c_one, x->val );         // x=x+alpha*p
+            res = magma_dznrm2_cpu( n, s.val );
+            if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+                info = MAGMA_SUCCESS;
+            } else {
+                info = MAGMA_DIVERGENCE;
+            }
+            break;
+        }
+
+        // x = x + alpha p + omega s, r = s - omega t, <r,r>, <rr,r>
+        magma_zbicgmerge_xr_cpu( n, alpha, omega, p.val, s.val, t.val, rr.val,
+                                 x->val, r.val, skp );
+        rho_old = rho_new;
+        res = sqrt( MAGMA_Z_REAL( skp[0] ) );
+        rho_new = skp[1];
+
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            info = MAGMA_SUCCESS;
+            break;
+        }
+    }
+    while ( solver_par->numiter+1 <= solver_par->maxiter );
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    double residual;
+    magma_zcopy_cpu( n, b.val, r.val );
+    CHECK( magma_z_spmv( -c_one, Ah, *x, c_one, r, queue ));
+    residual = magma_dznrm2_cpu( n, r.val );
+    solver_par->final_res = residual;
+    solver_par->iter_res = res;
+
+    if ( solver_par->numiter < solver_par->maxiter && info == MAGMA_SUCCESS ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    if ( convert ) {
+        magma_zmfree(&Ah, queue );
+    }
+    magma_zmfree(&r, queue );
+    magma_zmfree(&rr, queue );
+    magma_zmfree(&p, queue );
+    magma_zmfree(&pn, queue );
+    magma_zmfree(&v, queue );
+    magma_zmfree(&vn, queue );
+    magma_zmfree(&s, queue );
+    magma_zmfree(&t, queue );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_zbicgstab_merge_cpu */
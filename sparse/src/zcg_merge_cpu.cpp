@@ -0,0 +1,227 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Hartwig Anzt
+
+       @precisions normal z -> s d c
+*/
+
+#include "magmasparse_internal.h"
+
+#define RTOLERANCE     lapackf77_dlamch( "E" )
+#define ATOLERANCE     lapackf77_dlamch( "E" )
+
+
+/**
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a complex Hermitian N-by-N positive definite matrix A.
+    This is a CPU implementation of the Conjugate Gradient method in variant,
+    where multiple operations are merged into one sweep over memory:
+    the search direction update is fused with the SpMV and <p,q>,
+    the solution and residual updates with <r,r>. Each iteration reads
+    A once and the vectors twice.
+
+    A is used in CSR or SELLP, other formats are converted to CSR once.
+    The estimated bytes moved per iteration are returned in
+    solver_par->iter_bytes.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_z_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_z_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_z_solver_par*
+                solver parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zposv
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zcg_merge_cpu(
+    magma_z_matrix A, magma_z_matrix b, magma_z_matrix *x,
+    magma_z_solver_par *solver_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    // prepare solver feedback
+    solver_par->solver = Magma_CGMERGE;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+    solver_par->iter_bytes = 0.0;
+
+    // solver variables
+    magmaDoubleComplex alpha, beta, den;
+    double nom0, r0, res, nomb, rho, rho_new;
+    magmaDoubleComplex skp[1];
+    // local variables
+    magmaDoubleComplex c_zero = MAGMA_Z_ZERO, c_one = MAGMA_Z_ONE;
+
+    magma_int_t n = A.num_rows;
+    magma_int_t convert = 0;
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+
+    // CPU workspace, p and pn are swapped every iteration
+    magma_z_matrix Ah={Magma_CSR}, r={Magma_CSR}, p={Magma_CSR}, pn={Magma_CSR},
+                   q={Magma_CSR}, tmp={Magma_CSR};
+
+    if ( A.storage_type == Magma_CSR || A.storage_type == Magma_SELLP ) {
+        Ah = A;
+    } else {
+        CHECK( magma_zmconvert( A, &Ah, A.storage_type, Magma_CSR, queue ));
+        convert = 1;
+    }
+    CHECK( magma_zvinit( &r,  Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &p,  Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &pn, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &q,  Magma_CPU, n, 1, c_zero, queue ));
+
+    // SpMV, r and p gathered, pn and q written, then p, q, x, r, r
+    solver_par->iter_bytes = magma_zmergebytes_cpu( Ah )
+                             + 10.0 * n * sizeof(magmaDoubleComplex);
+
+    // solver setup
+    magma_zcopy_cpu( n, b.val, r.val );                                 // r = b
+    CHECK( magma_z_spmv( -c_one, Ah, *x, c_one, r, queue ));            // r = r - A x
+    nom0 = magma_dznrm2_cpu( n, r.val );
+    rho = nom0 * nom0;
+    beta = c_zero;                                                      // p = 0
+
+    solver_par->init_res = nom0;
+    nomb = magma_dznrm2_cpu( n, b.val );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    if ( (r0 = nomb * solver_par->rtol) < ATOLERANCE ){
+        r0 = ATOLERANCE;
+    }
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = (real_Double_t)nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < r0 ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+    res = nom0;
+
+    tempo1 = magma_wtime();
+
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+
+        // pn = r + beta p, q = A pn, den = <pn,q>
+        magma_zcgmerge_spmv_cpu( Ah, beta, r.val, p.val, pn.val, q.val, skp );
+        solver_par->spmv_count++;
+        tmp = p; p = pn; pn = tmp;
+        den = skp[0];
+        // check positive definite
+        if ( MAGMA_Z_ABS(den) <= 0.0 ) {
+            info = MAGMA_NONSPD;
+            goto cleanup;
+        }
+
+        // x = x + alpha p, r = r - alpha q, <r,r>
+        alpha = MAGMA_Z_MAKE( rho, 0.0 ) / den;
+        magma_zcgmerge_xr_cpu( n, alpha, p.val, q.val, x->val, r.val, skp );
+        rho_new = MAGMA_Z_REAL( skp[0] );
+        res = sqrt( rho_new );
+
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            break;
+        }
+
+        beta = MAGMA_Z_MAKE( rho_new / rho, 0.0 );
+        rho = rho_new;
+    }
+    while ( solver_par->numiter+1 <= solver_par->maxiter );
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    double residual;
+    magma_zcopy_cpu( n, b.val, r.val );
+    CHECK( magma_z_spmv( -c_one, Ah, *x, c_one, r, queue ));
+    residual = magma_dznrm2_cpu( n, r.val );
+    solver_par->iter_res = res;
+    solver_par->final_res = residual;
+
+    if ( solver_par->numiter < solver_par->maxiter ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    if ( convert ) {
+        magma_zmfree(&Ah, queue );
+    }
+    magma_zmfree(&r, queue );
+    magma_zmfree(&p, queue );
+    magma_zmfree(&pn, queue );
+    magma_zmfree(&q, queue );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_zcg_merge_cpu */
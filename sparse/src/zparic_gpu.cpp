@@ -78,7 +78,7 @@ magma_zparic_gpu(
 
     // in case using fill-in
     if (precond->levels > 0) {
-        CHECK(magma_zsymbilu(&hA, precond->levels, &hAL, &hAUT,  queue));
+        CHECK(magma_zsymbilu_stats(&hA, precond->levels, &hAL, &hAUT, &precond->symbilu, queue));
         magma_zmfree(&hAL, queue);
         magma_zmfree(&hAUT, queue);
     }
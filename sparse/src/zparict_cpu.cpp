@@ -100,7 +100,7 @@ magma_zparict_cpu(
 
     // in case using fill-in
     if (precond->levels > 0) {
-        CHECK(magma_zsymbilu(&hA, precond->levels, &hL, &LT , queue));
+        CHECK(magma_zsymbilu_stats(&hA, precond->levels, &hL, &LT, &precond->symbilu, queue));
         magma_zmfree(&LT, queue);
     }
     
@@ -108,6 +108,9 @@ magma_zparict_cpu(
     CHECK(magma_zmtransfer(L, &L0, A.memory_location, Magma_CPU, queue));
     CHECK(magma_zmatrix_addrowindex(&L, queue)); 
     L0nnz=L.nnz;
+    // the diagonal of tril(A) is not that of a Cholesky factor; without
+    // a sweep, the first candidates can give a zero diagonal
+    CHECK(magma_zparict_sweep_sync(&hA, &L, queue));
     
     if (timing == 1) {
         printf("ilut_fill_ratio = %.6f;\n\n", precond->atol); 
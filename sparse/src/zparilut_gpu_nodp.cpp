@@ -98,7 +98,7 @@ magma_zparilut_gpu_nodp(
     
     // in case using fill-in
     if (precond->levels > 0) {
-        CHECK(magma_zsymbilu(&hA, precond->levels, &hL, &hU , queue));
+        CHECK(magma_zsymbilu_stats(&hA, precond->levels, &hL, &hU, &precond->symbilu, queue));
         magma_zmfree(&hU, queue);
         magma_zmfree(&hL, queue);
     }
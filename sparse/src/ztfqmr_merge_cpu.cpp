@@ -0,0 +1,297 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Hartwig Anzt
+
+       @precisions normal z -> s d c
+*/
+
+#include "magmasparse_internal.h"
+
+#define RTOLERANCE     lapackf77_dlamch( "E" )
+#define ATOLERANCE     lapackf77_dlamch( "E" )
+
+
+/**
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a complex matrix A.
+    This is a CPU implementation of the transpose-free Quasi-Minimal Residual
+    method (TFQMR) in variant, where multiple operations are merged into one
+    sweep over memory. Each half step takes three sweeps: the w, d and Ad
+    updates with <w,w> and <r_tld,w>, the x and r updates with <r,r> and
+    the next u, and the SpMV with the v update and <r_tld,v>. u_m and u_mp1
+    are swapped instead of copied. The inner products take r_tld as the
+    conjugated argument, so alpha and beta are also correct for complex A.
+
+    A is used in CSR or SELLP, other formats are converted to CSR once.
+    The estimated bytes moved per iteration are returned in
+    solver_par->iter_bytes.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_z_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_z_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_z_solver_par*
+                solver parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgesv
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_ztfqmr_merge_cpu(
+    magma_z_matrix A, magma_z_matrix b, magma_z_matrix *x,
+    magma_z_solver_par *solver_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    // prepare solver feedback
+    solver_par->solver = Magma_TFQMRMERGE;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+    solver_par->iter_bytes = 0.0;
+
+    // local variables
+    magmaDoubleComplex c_zero = MAGMA_Z_ZERO, c_one = MAGMA_Z_ONE;
+    // solver variables
+    double nom0, r0, res, nomb;
+    magmaDoubleComplex rho = c_one, rho_l = c_one, eta = c_zero , c = c_zero ,
+                        theta = c_zero , tau = c_zero, alpha = c_one, beta = c_zero,
+                        sigma = c_zero, vr = c_one;
+    magmaDoubleComplex skp[2];
+
+    magma_int_t n = A.num_rows;
+    magma_int_t convert = 0;
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+
+    // CPU workspace
+    magma_z_matrix Ah={Magma_CSR}, r={Magma_CSR}, r_tld={Magma_CSR},
+                    d={Magma_CSR}, w={Magma_CSR}, v={Magma_CSR},
+                    u_mp1={Magma_CSR}, u_m={Magma_CSR}, Au={Magma_CSR},
+                    Ad={Magma_CSR}, tmp={Magma_CSR};
+
+    if ( A.storage_type == Magma_CSR || A.storage_type == Magma_SELLP ) {
+        Ah = A;
+    } else {
+        CHECK( magma_zmconvert( A, &Ah, A.storage_type, Magma_CSR, queue ));
+        convert = 1;
+    }
+    CHECK( magma_zvinit( &r, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &u_mp1,Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &r_tld,Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &u_m, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &v, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &d, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &w, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &Ad, Magma_CPU, n, 1, c_zero, queue ));
+    CHECK( magma_zvinit( &Au, Magma_CPU, n, 1, c_zero, queue ));
+
+    // two half steps with one SpMV each, the vector sweeps read or write
+    // 11 + 6 + 2 (odd) and 9 + 12 + 5 (even) vectors
+    solver_par->iter_bytes = 2.0 * magma_zmergebytes_cpu( Ah )
+                             + 45.0 * n * sizeof(magmaDoubleComplex);
+
+    // solver setup
+    magma_zcopy_cpu( n, b.val, r.val );                                 // r = b
+    CHECK( magma_z_spmv( -c_one, Ah, *x, c_one, r, queue ));            // r = r - A x
+    nom0 = magma_dznrm2_cpu( n, r.val );
+    solver_par->init_res = nom0;
+    magma_zcopy_cpu( n, r.val, r_tld.val );
+    magma_zcopy_cpu( n, r.val, w.val );
+    magma_zcopy_cpu( n, r.val, u_m.val );
+    CHECK( magma_z_spmv( c_one, Ah, u_m, c_zero, v, queue ));           // v = A u
+    magma_zcopy_cpu( n, v.val, Au.val );
+    nomb = magma_dznrm2_cpu( n, b.val );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    if ( (r0 = nomb * solver_par->rtol) < ATOLERANCE ){
+        r0 = ATOLERANCE;
+    }
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = (real_Double_t)nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < r0 ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    magma_zdotc2_cpu( n, r_tld.val, r.val, r_tld.val, v.val, skp );
+    rho = skp[0];
+    tau = magma_zsqrt( rho );
+    rho_l = rho;
+    vr = skp[1];                                                        // <r_tld,v>
+
+    tempo1 = magma_wtime();
+
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+
+        // first half step
+        alpha = rho / vr;
+        sigma = theta * theta / alpha * eta;
+
+        // u_mp1 = u_m - alpha v, w, d, Ad, <w,w>, <r_tld,w>
+        magma_ztfqmrmerge_1_cpu( n, 1, alpha, sigma, v.val, Au.val, u_m.val,
+                                 r_tld.val, u_mp1.val, w.val, d.val, Ad.val, skp );
+
+        theta = magma_zsqrt( skp[0] ) / tau;
+        c = c_one / magma_zsqrt( c_one + theta*theta );
+        tau = tau * theta *c;
+        eta = c * c * alpha;
+        sigma = theta * theta / alpha * eta;
+
+        // x = x + eta d, r = r - eta Ad, <r,r>
+        magma_ztfqmrmerge_2_cpu( n, 0, eta, beta, d.val, Ad.val, w.val, u_m.val,
+                                 Au.val, x->val, r.val, u_mp1.val, v.val, skp );
+        res = sqrt( MAGMA_Z_REAL( skp[0] ) );
+
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            info = MAGMA_SUCCESS;
+            break;
+        }
+
+        // Au = A u_mp1, u_m = u_mp1
+        magma_ztfqmrmerge_spmv_cpu( Ah, 0, u_mp1.val, r_tld.val, Au.val, v.val, skp );
+        solver_par->spmv_count++;
+        tmp = u_m; u_m = u_mp1; u_mp1 = tmp;
+
+        // second half step
+        // w, d, Ad, <w,w>, <r_tld,w>
+        magma_ztfqmrmerge_1_cpu( n, 0, alpha, sigma, v.val, Au.val, u_m.val,
+                                 r_tld.val, u_mp1.val, w.val, d.val, Ad.val, skp );
+
+        theta = magma_zsqrt( skp[0] ) / tau;
+        c = c_one / magma_zsqrt( c_one + theta*theta );
+        tau = tau * theta *c;
+        eta = c * c * alpha;
+
+        rho = skp[1];
+        beta = rho / rho_l;
+        rho_l = rho;
+
+        // x = x + eta d, r = r - eta Ad, <r,r>,
+        // u_mp1 = w + beta u_m, v = beta (Au + beta v)
+        magma_ztfqmrmerge_2_cpu( n, 1, eta, beta, d.val, Ad.val, w.val, u_m.val,
+                                 Au.val, x->val, r.val, u_mp1.val, v.val, skp );
+        res = sqrt( MAGMA_Z_REAL( skp[0] ) );
+
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            info = MAGMA_SUCCESS;
+            break;
+        }
+
+        // Au = A u_mp1, v = v + Au, <r_tld,v>, u_m = u_mp1
+        magma_ztfqmrmerge_spmv_cpu( Ah, 1, u_mp1.val, r_tld.val, Au.val, v.val, skp );
+        solver_par->spmv_count++;
+        vr = skp[0];
+        tmp = u_m; u_m = u_mp1; u_mp1 = tmp;
+    }
+    while ( solver_par->numiter+1 <= solver_par->maxiter );
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    double residual;
+    magma_zcopy_cpu( n, b.val, r.val );
+    CHECK( magma_z_spmv( -c_one, Ah, *x, c_one, r, queue ));
+    residual = magma_dznrm2_cpu( n, r.val );
+    solver_par->iter_res = res;
+    solver_par->final_res = residual;
+
+    if ( solver_par->numiter < solver_par->maxiter ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    if ( convert ) {
+        magma_zmfree(&Ah, queue );
+    }
+    magma_zmfree(&r, queue );
+    magma_zmfree(&r_tld, queue );
+    magma_zmfree(&d, queue );
+    magma_zmfree(&w, queue );
+    magma_zmfree(&v, queue );
+    magma_zmfree(&u_m, queue );
+    magma_zmfree(&u_mp1, queue );
+    magma_zmfree(&Au, queue );
+    magma_zmfree(&Ad, queue );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_ztfqmr_merge_cpu */
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/testing/testing_zio.cpp, normal z -> c, Wed Feb 22 15:22:01 2023
+       @generated from sparse/testing/testing_zio.cpp, normal z -> c, Sun Oct 18 02:47:30 2026
        @author Hartwig Anzt
 */
 
@@ -39,9 +39,9 @@ int main(  int argc, char** argv )
     magma_queue_t queue=NULL;
     magma_queue_create( 0, &queue );
     
-    real_Double_t res;
+    real_Double_t res, start, end;
     magma_c_matrix A={Magma_CSR}, A2={Magma_CSR}, 
-    A3={Magma_CSR}, A4={Magma_CSR}, A5={Magma_CSR};
+    A3={Magma_CSR}, A4={Magma_CSR}, A5={Magma_CSR}, A6={Magma_CSR};
     
     int i=1;
     TESTING_CHECK( magma_cparse_opts( argc, argv, &zopts, &i, queue ));
@@ -52,7 +52,15 @@ int main(  int argc, char** argv )
             magma_int_t laplace_size = atoi( argv[i] );
             TESTING_CHECK( magma_cm_5stencil(  laplace_size, &A, queue ));
         } else {                        // file-matrix test
-            TESTING_CHECK( magma_c_csr_mtx( &A,  argv[i], queue ));
+            start = magma_wtime();
+            if ( zopts.binary ) {
+                TESTING_CHECK( magma_c_csr_binary( &A,  argv[i], queue ));
+            } else {
+                TESTING_CHECK( magma_c_csr_mtx( &A,  argv[i], queue ));
+            }
+            end = magma_wtime();
+            printf("%% read %lld nonzeros in %.4f seconds: %.2f M nonzeros/s\n",
+                    (long long) A.nnz, end-start, A.nnz / (end-start) / 1e6 );
         }
 
         printf("%% matrix info: %lld-by-%lld with %lld nonzeros\n",
@@ -64,10 +72,24 @@ int main(  int argc, char** argv )
         // write to file
         TESTING_CHECK( magma_cwrite_csrtomtx( A, filename, queue ));
         // read from file
+        start = magma_wtime();
         TESTING_CHECK( magma_c_csr_mtx( &A2, filename, queue ));
+        end = magma_wtime();
+        printf("%% read %lld nonzeros in %.4f seconds: %.2f M nonzeros/s\n",
+                (long long) A2.nnz, end-start, A2.nnz / (end-start) / 1e6 );
 
         // delete temporary matrix
         unlink( filename );
+
+        // same round trip through the binary CSR container
+        const char *binfilename = "testmatrix.bin";
+        TESTING_CHECK( magma_cwrite_csr_binary( A, binfilename, queue ));
+        start = magma_wtime();
+        TESTING_CHECK( magma_c_csr_binary( &A6, binfilename, queue ));
+        end = magma_wtime();
+        printf("%% read %lld nonzeros in %.4f seconds: %.2f M nonzeros/s\n",
+                (long long) A6.nnz, end-start, A6.nnz / (end-start) / 1e6 );
+        unlink( binfilename );
                 
         //visualize
         printf("A2:\n");
@@ -102,10 +124,18 @@ int main(  int argc, char** argv )
         else
             printf("%% tester matrix interface:  failed\n");
 
-        magma_cmfree(&A, queue );
+        TESTING_CHECK( magma_cmdiff( A, A6, &res, queue ));
+        printf("%% ||A-B||_F = %8.2e\n", res);
+        if ( res < .000001 )
+            printf("%% tester binary IO:  ok\n");
+        else
+            printf("%% tester binary IO:  failed\n");
+
+        magma_cmunmap(&A, queue );
         magma_cmfree(&A2, queue );
         magma_cmfree(&A4, queue );
         magma_cmfree(&A5, queue );
+        magma_cmunmap(&A6, queue );
 
         i++;
     }
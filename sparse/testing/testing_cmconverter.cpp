@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/testing/testing_zmconverter.cpp, normal z -> c, Wed Feb 22 15:22:02 2023
+       @generated from sparse/testing/testing_zmconverter.cpp, normal z -> c, Sun Oct 18 02:53:24 2026
        @author Hartwig Anzt
 */
 
@@ -34,9 +34,9 @@ int main(  int argc, char** argv )
     magma_queue_t queue=NULL;
     magma_queue_create( 0, &queue );
 
-    real_Double_t res;
+    real_Double_t res, start, end;
     magma_c_matrix Z={Magma_CSR}, Z2={Magma_CSR}, A={Magma_CSR}, A2={Magma_CSR}, 
-    AT={Magma_CSR}, AT2={Magma_CSR}, B={Magma_CSR};
+    AT={Magma_CSR}, AT2={Magma_CSR}, B={Magma_CSR}, C={Magma_CSR}, C2={Magma_CSR};
     int i=1;
     TESTING_CHECK( magma_cparse_opts( argc, argv, &zopts, &i, queue ));
 
@@ -127,6 +127,24 @@ int main(  int argc, char** argv )
         else
             printf("%% LUmerge tester:  failed\n");
 
+        // CSR5 conversion time
+        start = magma_wtime();
+        TESTING_CHECK( magma_cmconvert( Z, &C, Magma_CSR, Magma_CSR5, queue ));
+        end = magma_wtime();
+        printf("%% CSR to CSR5 conversion: %.4f seconds: %.2f M nonzeros/s\n",
+                end-start, Z.nnz / (end-start) / 1e6 );
+        start = magma_wtime();
+        TESTING_CHECK( magma_cmconvert( C, &C2, Magma_CSR5, Magma_CSR, queue ));
+        end = magma_wtime();
+        printf("%% CSR5 to CSR conversion: %.4f seconds: %.2f M nonzeros/s\n",
+                end-start, Z.nnz / (end-start) / 1e6 );
+        TESTING_CHECK( magma_cmdiff( Z, C2, &res, queue));
+        printf("%% ||Z-C2||_F = %8.2e\n", res);
+        if ( res < .000001 )
+            printf("%% CSR5 conversion tester:  ok\n");
+        else
+            printf("%% CSR5 conversion tester:  failed\n");
+
         magma_cmfree(&A, queue );
         magma_cmfree(&A2, queue );
         magma_cmfree(&AT, queue );
@@ -134,6 +152,8 @@ int main(  int argc, char** argv )
         magma_cmfree(&B, queue );
         magma_cmfree(&Z2, queue );
         magma_cmfree(&Z, queue );
+        magma_cmfree(&C, queue );
+        magma_cmfree(&C2, queue );
 
         i++;
     }
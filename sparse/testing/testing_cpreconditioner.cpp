@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/testing/testing_zpreconditioner.cpp, normal z -> c, Wed Feb 22 15:22:04 2023
+       @generated from sparse/testing/testing_zpreconditioner.cpp, normal z -> c, Sun Oct 18 06:34:24 2026
        @author Hartwig Anzt
 */
 
@@ -18,6 +18,7 @@
 // includes, project
 #include "magma_v2.h"
 #include "magmasparse.h"
+#include "magma_operators.h"
 #include "testings.h"
 
 
@@ -51,6 +52,120 @@ int main(  int argc, char** argv )
 
     TESTING_CHECK( magma_csolverinfo_init( &zopts.solver_par, &zopts.precond_par, queue ));
 
+    // the host ISAI generator has to match magma_cmprepare_batched,
+    // magma_cmtrisolve_batched, magma_cmbackinsert_batched (systems up to 32)
+    // and a dense triangular solve of every system (also larger systems).
+    // Row j of L has the elements j - j%band .. j, so the ISAI pattern
+    // (the transpose) has systems of every size up to band.
+    {
+        const magma_uplo_t uplos[] = { MagmaLower, MagmaUpper };
+        const magma_trans_t transs[] = { MagmaNoTrans, MagmaTrans, MagmaConjTrans };
+        const magma_diag_t diags[] = { MagmaNonUnit, MagmaUnit };
+        const magma_int_t bands[] = { 32, 48 };
+        const magma_int_t n = 500, warpsize = 32, ione = 1;
+        float tol = 100 * lapackf77_slamch("E");
+        magma_index_t *sizes, *locations;
+        magmaFloatComplex *trisystems, *rhs, *T;
+        TESTING_CHECK( magma_index_malloc_cpu( &sizes, n ));
+        TESTING_CHECK( magma_index_malloc_cpu( &locations, n*warpsize ));
+        TESTING_CHECK( magma_cmalloc_cpu( &trisystems, n*warpsize*warpsize ));
+        TESTING_CHECK( magma_cmalloc_cpu( &rhs, n*warpsize ));
+        TESTING_CHECK( magma_cmalloc_cpu( &T, 48*48 ));
+
+        for( magma_int_t ib=0; ib < 2; ib++ ) {
+            magma_int_t band = bands[ ib ];
+            magma_c_matrix L={Magma_CSR}, U={Magma_CSR};
+            L.memory_location = Magma_CPU;
+            L.num_rows = L.num_cols = n;
+            TESTING_CHECK( magma_index_malloc_cpu( &L.row, n+1 ));
+            L.row[0] = 0;
+            for( magma_int_t j=0; j < n; j++ ) {
+                L.row[j+1] = L.row[j] + j % band + 1;
+            }
+            L.nnz = L.row[n];
+            TESTING_CHECK( magma_index_malloc_cpu( &L.col, L.nnz ));
+            TESTING_CHECK( magma_cmalloc_cpu( &L.val, L.nnz ));
+            for( magma_int_t j=0; j < n; j++ ) {
+                for( magma_int_t k=L.row[j]; k < L.row[j+1]; k++ ) {
+                    L.col[k] = j - (L.row[j+1]-1 - k);
+                    L.val[k] = MAGMA_C_MAKE( 0.2*rand()/RAND_MAX - 0.1,
+                                             0.2*rand()/RAND_MAX - 0.1 );
+                }
+                L.val[ L.row[j+1]-1 ] = MAGMA_C_MAKE( 1.0 + (float) rand()/RAND_MAX, 0.0 );
+            }
+            TESTING_CHECK( magma_cmtranspose( L, &U, queue ));
+
+            for( magma_int_t iu=0; iu < 2; iu++ ) {
+            for( magma_int_t it=0; it < 3; it++ ) {
+            for( magma_int_t id=0; id < 2; id++ ) {
+                magma_uplo_t uplo = uplos[ iu ];
+                magma_c_matrix Tri = ( uplo == MagmaLower ) ? L : U;
+                magma_c_matrix M={Magma_CSR}, Mref={Magma_CSR};
+                magma_int_t maxsize = 0;
+                float err = 0.0, err_ref = 0.0, nrm = 0.0;
+                // the ISAI pattern, in transpose fashion: U for L, L for U
+                TESTING_CHECK( magma_cmtransfer( ( uplo == MagmaLower ) ? U : L, &M,
+                                                 Magma_CPU, Magma_CPU, queue ));
+                TESTING_CHECK( magma_cmtransfer( M, &Mref, Magma_CPU, Magma_CPU, queue ));
+                TESTING_CHECK( magma_cisai_generator_cpu( uplo, transs[ it ], diags[ id ],
+                                                          Tri, &M, queue ));
+                if ( band <= warpsize ) {
+                    // magma_cmprepare_batched takes the factor col-major
+                    magma_c_matrix TriC = ( uplo == MagmaLower ) ? U : L;
+                    TESTING_CHECK( magma_cmprepare_batched( uplo, transs[ it ], diags[ id ],
+                                   TriC, Mref, sizes, locations, trisystems, rhs, queue ));
+                    TESTING_CHECK( magma_cmtrisolve_batched( uplo, transs[ it ], diags[ id ],
+                                   TriC, Mref, sizes, locations, trisystems, rhs, queue ));
+                    TESTING_CHECK( magma_cmbackinsert_batched( uplo, transs[ it ], diags[ id ],
+                                   &Mref, sizes, locations, trisystems, rhs, queue ));
+                    for( magma_int_t k=0; k < M.nnz; k++ ) {
+                        err_ref = max( err_ref, MAGMA_C_ABS( M.val[k] - Mref.val[k] ));
+                    }
+                }
+                // dense triangular solve of every system
+                for( magma_int_t r=0; r < M.num_rows; r++ ) {
+                    const magma_index_t *loc = M.col + M.row[r];
+                    magma_int_t size = M.row[r+1] - M.row[r];
+                    maxsize = max( maxsize, size );
+                    for( magma_int_t k=0; k < size*size; k++ ) {
+                        T[k] = MAGMA_C_ZERO;
+                    }
+                    for( magma_int_t c=0; c < size; c++ ) {
+                        for( magma_int_t k=Tri.row[ loc[c] ]; k < Tri.row[ loc[c]+1 ]; k++ ) {
+                            for( magma_int_t q=0; q < size; q++ ) {
+                                if ( Tri.col[k] == loc[q] ) {
+                                    T[ q*size + c ] = Tri.val[k];
+                                }
+                            }
+                        }
+                        rhs[c] = MAGMA_C_ZERO;
+                    }
+                    rhs[ uplo == MagmaLower ? 0 : size-1 ] = MAGMA_C_ONE;
+                    blasf77_ctrsv( lapack_uplo_const( uplo ), lapack_trans_const( transs[ it ] ),
+                                   lapack_diag_const( diags[ id ] ), &size, T, &size, rhs, &ione );
+                    for( magma_int_t c=0; c < size; c++ ) {
+                        err = max( err, MAGMA_C_ABS( M.val[ M.row[r] + c ] - rhs[c] ));
+                        nrm = max( nrm, MAGMA_C_ABS( rhs[c] ));
+                    }
+                }
+                bool okay = ( err <= tol * nrm && err_ref <= tol * nrm );
+                printf("%% host ISAI %s %s %s, systems up to %lld: error %.2e.  Tester ISAI:  %s\n",
+                        lapack_uplo_const( uplo ), lapack_trans_const( transs[ it ] ),
+                        lapack_diag_const( diags[ id ] ), (long long) maxsize,
+                        max( err, err_ref ) / nrm, okay ? "ok" : "failed" );
+                magma_cmfree( &M, queue );
+                magma_cmfree( &Mref, queue );
+            }}}
+            magma_cmfree( &L, queue );
+            magma_cmfree( &U, queue );
+        }
+        magma_free_cpu( sizes );
+        magma_free_cpu( locations );
+        magma_free_cpu( trisystems );
+        magma_free_cpu( rhs );
+        magma_free_cpu( T );
+    }
+
     while( i < argc ) {
         if ( strcmp("LAPLACE2D", argv[i]) == 0 && i+1 < argc ) {   // Laplace test
             i++;
@@ -63,6 +178,47 @@ int main(  int argc, char** argv )
         printf( "\n%% matrix info: %lld-by-%lld with %lld nonzeros\n\n",
                 (long long) A.num_rows, (long long) A.num_cols, (long long) A.nnz );
 
+        // the parallel symbolic ILU(k) has to give the same pattern
+        // as the sequential linked-list version
+        for( magma_int_t levels=1; levels <= 3; levels++ ) {
+            magma_int_t storage = A.nnz/2*(2*levels+50);
+            magma_int_t nzl = storage, nzu = storage, nzl2 = storage, nzu2 = storage;
+            magma_index_t *ial, *jal, *iau, *jau, *ial2, *jal2, *iau2, *jau2;
+            TESTING_CHECK( magma_index_malloc_cpu( &ial,  A.num_rows+1 ));
+            TESTING_CHECK( magma_index_malloc_cpu( &iau,  A.num_rows+1 ));
+            TESTING_CHECK( magma_index_malloc_cpu( &ial2, A.num_rows+1 ));
+            TESTING_CHECK( magma_index_malloc_cpu( &iau2, A.num_rows+1 ));
+            TESTING_CHECK( magma_index_malloc_cpu( &jal,  storage ));
+            TESTING_CHECK( magma_index_malloc_cpu( &jau,  storage ));
+            TESTING_CHECK( magma_index_malloc_cpu( &jal2, storage ));
+            TESTING_CHECK( magma_index_malloc_cpu( &jau2, storage ));
+            TESTING_CHECK( magma_csymbolic_ilu( levels, A.num_rows, &nzl, &nzu,
+                                                A.row, A.col, ial, jal, iau, jau ));
+            TESTING_CHECK( magma_csymbolic_ilu_list( levels, A.num_rows, &nzl2, &nzu2,
+                                                     A.row, A.col, ial2, jal2, iau2, jau2 ));
+            bool okay = ( nzl == nzl2 && nzu == nzu2 );
+            for( magma_int_t j=0; okay && j <= A.num_rows; j++ ) {
+                okay = ( ial[j] == ial2[j] && iau[j] == iau2[j] );
+            }
+            for( magma_int_t j=0; okay && j < nzl; j++ ) {
+                okay = ( jal[j] == jal2[j] );
+            }
+            for( magma_int_t j=0; okay && j < nzu; j++ ) {
+                okay = ( jau[j] == jau2[j] );
+            }
+            printf("%% symbolic ILU(%lld): nnz(L) = %lld, nnz(U) = %lld.  Tester pattern:  %s\n",
+                    (long long) levels, (long long) nzl, (long long) nzu,
+                    okay ? "ok" : "failed" );
+            magma_free_cpu( ial  );
+            magma_free_cpu( jal  );
+            magma_free_cpu( iau  );
+            magma_free_cpu( jau  );
+            magma_free_cpu( ial2 );
+            magma_free_cpu( jal2 );
+            magma_free_cpu( iau2 );
+            magma_free_cpu( jau2 );
+        }
+
 
         // for the eigensolver case
         zopts.solver_par.ev_length = A.num_rows;
@@ -71,6 +227,26 @@ int main(  int argc, char** argv )
         // scale matrix
         TESTING_CHECK( magma_cmscale( &A, zopts.scaling, queue ));
 
+        // the synchronous ParILUT sweeps on the ILU(0) pattern,
+        // starting from tril(A) and triu(A), have to reduce ||A - LU||
+        {
+            magma_c_matrix L={Magma_CSR}, U={Magma_CSR}, AT={Magma_CSR};
+            float res0, res;
+            TESTING_CHECK( magma_cmatrix_tril( A, &L, queue ));
+            TESTING_CHECK( magma_cmtranspose( A, &AT, queue ));
+            TESTING_CHECK( magma_cmatrix_tril( AT, &U, queue ));
+            TESTING_CHECK( magma_cparilut_residual_norm( A, L, U, &res0, queue ));
+            for( magma_int_t s=0; s < 5; s++ ) {
+                TESTING_CHECK( magma_cparilut_sweep_sync( &A, &L, &U, queue ));
+            }
+            TESTING_CHECK( magma_cparilut_residual_norm( A, L, U, &res, queue ));
+            printf("%% ParILUT sync sweeps: ||A-LU|| = %.2e -> %.2e.  Tester sweep:  %s\n",
+                    res0, res, ( res < res0 ) ? "ok" : "failed" );
+            magma_cmfree( &L, queue );
+            magma_cmfree( &U, queue );
+            magma_cmfree( &AT, queue );
+        }
+
         TESTING_CHECK( magma_cmconvert( A, &B, Magma_CSR, zopts.output_format, queue ));
         TESTING_CHECK( magma_cmtransfer( B, &dB, Magma_CPU, Magma_DEV, queue ));
 
@@ -82,6 +258,7 @@ int main(  int argc, char** argv )
         TESTING_CHECK( magma_cvinit( &x2, Magma_DEV, A.num_cols, 1, zero, queue ));
                         
         //preconditioner
+        magma_solver_type precond_type = zopts.precond_par.solver;
         TESTING_CHECK( magma_c_precondsetup( dB, b, &zopts.solver_par, &zopts.precond_par, queue ) );
         
         float residual;
@@ -110,8 +287,25 @@ int main(  int argc, char** argv )
         }
         TESTING_CHECK( magma_cresidual( dB, b, x2, &residual, queue ));
         printf("%.8e  %.8e\n", tempo2-tempo1, residual );
-        
-        
+
+        if ( zopts.precond_par.solver == Magma_GS  || zopts.precond_par.solver == Magma_SGS ||
+             zopts.precond_par.solver == Magma_SOR || zopts.precond_par.solver == Magma_SSOR ) {
+            printf("%%runtime and residual of the multicolor smoother (%lld colors) per sweep:\n",
+                    (long long) zopts.precond_par.ncolors );
+            magmablas_claset( MagmaFull, A.num_cols, 1, zero, zero, t.dval, A.num_cols, queue );
+            for( magma_int_t s=0; s < 10; s++ ) {
+                tempo1 = magma_sync_wtime( queue );
+                info = magma_cmcsor_smooth( b, &t, 1, &zopts.precond_par, queue );
+                tempo2 = magma_sync_wtime( queue );
+                if( info != 0 ){
+                    printf("error: smoother returned: %s (%lld).\n",
+                            magma_strerror( info ), (long long) info );
+                }
+                TESTING_CHECK( magma_cresidual( dB, b, t, &residual, queue ));
+                printf("%.8e  %.8e\n", tempo2-tempo1, residual );
+            }
+        }
+
         printf("];\n");
         
         info = magma_c_applyprecond_left( MagmaNoTrans, dB, b, &t, &zopts.precond_par, queue ); 
@@ -123,6 +317,38 @@ int main(  int argc, char** argv )
         
         magma_csolverinfo( &zopts.solver_par, &zopts.precond_par, queue );
 
+        // the update of a ParILUT or ParICT preconditioner to a perturbed A
+        // has to reduce the residual of the previous factors, and leave
+        // a preconditioner that can be applied
+        if ( precond_type == Magma_PARILUT || precond_type == Magma_PARICT ) {
+            magma_c_matrix Ap={Magma_CSR}, dAp={Magma_CSR};
+            // a larger diagonal keeps A symmetric positive definite
+            TESTING_CHECK( magma_cmtransfer( A, &Ap, Magma_CPU, Magma_CPU, queue ));
+            for( magma_int_t row=0; row < Ap.num_rows; row++ ) {
+                for( magma_int_t j=Ap.row[row]; j < Ap.row[row+1]; j++ ) {
+                    if ( Ap.col[j] == row ) {
+                        Ap.val[j] = MAGMA_C_MUL( Ap.val[j], MAGMA_C_MAKE( 1.1, 0.0 ));
+                    }
+                }
+            }
+            TESTING_CHECK( magma_cmtransfer( Ap, &dAp, Magma_CPU, Magma_DEV, queue ));
+            if ( precond_type == Magma_PARILUT ) {
+                info = magma_cparilut_update( dAp, &zopts.precond_par, 1, queue );
+            } else {
+                info = magma_cparict_update( dAp, &zopts.precond_par, 1, queue );
+            }
+            if ( info == 0 ) {
+                info = magma_c_applyprecond_left( MagmaNoTrans, dAp, b, &t, &zopts.precond_par, queue );
+            }
+            printf("%% %s update: residual %.2e -> %.2e.  Tester update:  %s\n",
+                    ( precond_type == Magma_PARILUT ) ? "ParILUT" : "ParICT",
+                    zopts.precond_par.init_res, zopts.precond_par.final_res,
+                    ( info == 0 && zopts.precond_par.final_res < zopts.precond_par.init_res )
+                    ? "ok" : "failed" );
+            magma_cmfree( &Ap, queue );
+            magma_cmfree( &dAp, queue );
+        }
+
         magma_cmfree(&dB, queue );
         magma_cmfree(&B, queue );
         magma_cmfree(&A, queue );
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/testing/testing_zsolver.cpp, normal z -> c, Wed Feb 22 15:22:03 2023
+       @generated from sparse/testing/testing_zsolver.cpp, normal z -> c, Sun Oct 18 04:59:02 2026
        @author Hartwig Anzt
 */
 
@@ -36,7 +36,9 @@ int main(  int argc, char** argv )
     
     // magmaFloatComplex zero = MAGMA_C_MAKE(0.0, 0.0);
     magma_c_matrix A={Magma_CSR}, B={Magma_CSR}, dB={Magma_CSR};
-    magma_c_matrix x={Magma_CSR}, b={Magma_CSR};
+    magma_c_matrix x={Magma_CSR}, b={Magma_CSR}, Abin={Magma_CSR};
+    magma_c_matrix PA={Magma_CSR};
+    magma_index_t *perm = NULL;
     
     int i=1;
     TESTING_CHECK( magma_cparse_opts( argc, argv, &zopts, &i, queue ));
@@ -50,6 +52,10 @@ int main(  int argc, char** argv )
             i++;
             magma_int_t laplace_size = atoi( argv[i] );
             TESTING_CHECK( magma_cm_5stencil(  laplace_size, &A, queue ));
+        } else if ( zopts.binary ) {    // binary file-matrix test
+            // A aliases the mapping until scaling replaces it
+            TESTING_CHECK( magma_c_csr_binary( &Abin,  argv[i], queue ));
+            A = Abin;
         } else {                        // file-matrix test
             TESTING_CHECK( magma_c_csr_mtx( &A,  argv[i], queue ));
         }
@@ -60,9 +66,20 @@ int main(  int argc, char** argv )
 
         // scale matrix
         TESTING_CHECK( magma_cmscale( &A, zopts.scaling, queue ));
+
+        // reorder matrix, the solution is mapped back after the solve
+        if ( zopts.reorder != Magma_NOREORDER ) {
+            TESTING_CHECK( magma_cmreorder( A, zopts.reorder, &perm, queue ));
+            TESTING_CHECK( magma_cmpermute( A, perm, &PA, queue ));
+            magma_cmfree(&A, queue );
+            A = PA;
+            PA = {Magma_CSR};
+        }
         
         // preconditioner
-        if ( zopts.solver_par.solver != Magma_ITERREF ) {
+        if ( zopts.compute_location == Magma_CPU ) {
+            TESTING_CHECK( magma_c_precondsetup_cpu( A, &zopts.precond_par, queue ) );
+        } else if ( zopts.solver_par.solver != Magma_ITERREF ) {
             TESTING_CHECK( magma_c_precondsetup( A, b, &zopts.solver_par, &zopts.precond_par, queue ) );
         }
 
@@ -80,20 +97,33 @@ int main(  int argc, char** argv )
         printf("%%============================================================================%%\n");
         printf("];\n");
 
-        TESTING_CHECK( magma_cmtransfer( B, &dB, Magma_CPU, Magma_DEV, queue ));
+        if ( zopts.compute_location == Magma_CPU ) {
+            // host solve: A, b and x stay in CPU memory;
+            // B's rows are placed on the NUMA node of the thread using them
+            TESTING_CHECK( magma_cmfirsttouch_cpu( &B, queue ));
+            TESTING_CHECK( magma_cvinit_rand( &b, Magma_CPU, A.num_rows, 1, queue ));
+            TESTING_CHECK( magma_cvinit_rand( &x, Magma_CPU, A.num_cols, 1, queue ));
 
-        // vectors and initial guess
-        TESTING_CHECK( magma_cvinit_rand( &b, Magma_DEV, A.num_rows, 1, queue ));
-        //magma_cvinit( &x, Magma_DEV, A.num_cols, 1, one, queue );
-        //magma_c_spmv( one, dB, x, zero, b, queue );                 //  b = A x
-        //magma_cmfree(&x, queue );
-        TESTING_CHECK( magma_cvinit_rand( &x, Magma_DEV, A.num_cols, 1, queue ));
-        
-        info = magma_c_solver( dB, b, &x, &zopts, queue );
+            info = magma_c_solver( B, b, &x, &zopts, queue );
+        } else {
+            TESTING_CHECK( magma_cmtransfer( B, &dB, Magma_CPU, Magma_DEV, queue ));
+
+            // vectors and initial guess
+            TESTING_CHECK( magma_cvinit_rand( &b, Magma_DEV, A.num_rows, 1, queue ));
+            //magma_cvinit( &x, Magma_DEV, A.num_cols, 1, one, queue );
+            //magma_c_spmv( one, dB, x, zero, b, queue );                 //  b = A x
+            //magma_cmfree(&x, queue );
+            TESTING_CHECK( magma_cvinit_rand( &x, Magma_DEV, A.num_cols, 1, queue ));
+
+            info = magma_c_solver( dB, b, &x, &zopts, queue );
+        }
         if( info != 0 ) {
             printf("%%error: solver returned: %s (%lld).\n",
                     magma_strerror( info ), (long long) info );
         }
+        if ( perm != NULL ) {
+            TESTING_CHECK( magma_cvpermute_inverse( x, perm, &x, queue ));
+        }
         printf("convergence = [\n");
         magma_csolverinfo( &zopts.solver_par, &zopts.precond_par, queue );
         printf("];\n\n");
@@ -111,8 +141,11 @@ int main(  int argc, char** argv )
         magma_cmfree(&dB, queue );
         magma_cmfree(&B, queue );
         magma_cmfree(&A, queue );
+        magma_cmunmap(&Abin, queue );
         magma_cmfree(&x, queue );
         magma_cmfree(&b, queue );
+        magma_free_cpu( perm );
+        perm = NULL;
         i++;
     }
 
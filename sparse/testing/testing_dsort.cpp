@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/testing/testing_zsort.cpp, normal z -> d, Wed Feb 22 15:22:02 2023
+       @generated from sparse/testing/testing_zsort.cpp, normal z -> d, Sun Oct 18 06:11:06 2026
        @author Hartwig Anzt
 */
 
@@ -39,7 +39,7 @@ int main(  int argc, char** argv )
     magma_index_t *x=NULL;
     double *y=NULL;
     
-    magma_d_matrix A={Magma_CSR};
+    magma_d_matrix A={Magma_CSR}, B={Magma_CSR};
 
     TESTING_CHECK( magma_index_malloc_cpu( &x, n ));
     printf("unsorted:\n");
@@ -87,7 +87,70 @@ int main(  int argc, char** argv )
     printf("\n\n");
 
     magma_free_cpu( y );
-    
+
+    // synthetic CSR with rows for every sort method: sorting network,
+    // insertion sort, radix sort (> 64) and the parallel merge (> 65536),
+    // with many duplicate column indices. The value of every element is
+    // its column index, so the pairing can be checked after the sort.
+    {
+        const magma_int_t nrows = 5;
+        const magma_int_t len[ nrows ] = { 10, 50, 1000, 70000, 140001 };
+        magma_int_t ncols = 100000, errors = 0;
+        magma_index_t *count=NULL;
+        B.storage_type = Magma_CSR;
+        B.memory_location = Magma_CPU;
+        B.num_rows = nrows;
+        B.num_cols = ncols;
+        B.nnz = 0;
+        for( magma_int_t row=0; row < nrows; row++ ){
+            B.nnz += len[ row ];
+        }
+        TESTING_CHECK( magma_index_malloc_cpu( &B.row, nrows+1 ));
+        TESTING_CHECK( magma_index_malloc_cpu( &B.col, B.nnz ));
+        TESTING_CHECK( magma_dmalloc_cpu( &B.val, B.nnz ));
+        TESTING_CHECK( magma_index_malloc_cpu( &count, nrows*ncols ));
+        for( magma_int_t j=0; j < nrows*ncols; j++ ){
+            count[j] = 0;
+        }
+        B.row[0] = 0;
+        for( magma_int_t row=0; row < nrows; row++ ){
+            B.row[row+1] = B.row[row] + len[ row ];
+            // about two elements per column index in the long rows
+            magma_int_t range = max( 2, min( ncols, len[ row ] / 2 ));
+            for( magma_int_t j=B.row[row]; j < B.row[row+1]; j++ ){
+                B.col[j] = rand() % range;
+                B.val[j] = MAGMA_D_MAKE( (double) B.col[j], 0.0 );
+                count[ row*ncols + B.col[j] ]++;
+            }
+        }
+        TESTING_CHECK( magma_dcsr_sort( &B, queue ));
+        for( magma_int_t row=0; row < nrows; row++ ){
+            for( magma_int_t j=B.row[row]; j < B.row[row+1]; j++ ){
+                if ( j > B.row[row] && B.col[j] < B.col[j-1] ) {
+                    errors++;
+                }
+                if ( B.col[j] < 0 || B.col[j] >= ncols ||
+                     ! MAGMA_D_EQUAL( B.val[j], MAGMA_D_MAKE( (double) B.col[j], 0.0 ))) {
+                    errors++;
+                }
+                else {
+                    count[ row*ncols + B.col[j] ]--;
+                }
+            }
+        }
+        for( magma_int_t j=0; j < nrows*ncols; j++ ){
+            if ( count[j] != 0 ) {
+                errors++;
+            }
+        }
+        if ( errors == 0 )
+            printf("%% tester CSR sort long rows:  ok\n");
+        else
+            printf("%% tester CSR sort long rows:  failed\n");
+        magma_free_cpu( count );
+        magma_dmfree( &B, queue );
+    }
+
     i=1;
     while( i < argc ) {
         if ( strcmp("LAPLACE2D", argv[i]) == 0 && i+1 < argc ) {   // Laplace test
@@ -111,6 +174,32 @@ int main(  int argc, char** argv )
         }
         printf("\n\n");
         magma_free_cpu( x );
+
+        // shuffle every row, then sort the rows again
+        TESTING_CHECK( magma_dmtransfer( A, &B, Magma_CPU, Magma_CPU, queue ));
+        for( magma_int_t row=0; row < B.num_rows; row++ ){
+            for( magma_int_t j=B.row[row+1]-1; j > B.row[row]; j-- ){
+                magma_int_t k = B.row[row] + rand() % (j - B.row[row] + 1);
+                magma_index_t tmpc = B.col[j];
+                double tmpv = B.val[j];
+                B.col[j] = B.col[k];
+                B.val[j] = B.val[k];
+                B.col[k] = tmpc;
+                B.val[k] = tmpv;
+            }
+        }
+        TESTING_CHECK( magma_dcsr_sort( &B, queue ));
+        magma_int_t errors = 0;
+        for( magma_int_t j=0; j < A.nnz; j++ ){
+            if ( B.col[j] != A.col[j] || ! MAGMA_D_EQUAL( B.val[j], A.val[j] )) {
+                errors++;
+            }
+        }
+        if ( errors == 0 )
+            printf("%% tester CSR sort:  ok\n");
+        else
+            printf("%% tester CSR sort:  failed\n");
+        magma_dmfree(&B, queue);
         magma_dmfree(&A, queue);
         
         i++;
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/testing/testing_zspmm.cpp, normal z -> d, Wed Feb 22 15:22:03 2023
+       @generated from sparse/testing/testing_zspmm.cpp, normal z -> d, Sun Oct 18 06:07:38 2026
        @author Hartwig Anzt
 */
 
@@ -328,6 +328,124 @@ int main(  int argc, char** argv )
         cusparseHandle = NULL;
         //#endif
 
+
+        // sparse matrix-matrix product C = A * A on the host
+        {
+            magma_d_matrix hC={Magma_CSR}, hS={Magma_CSR}, dC={Magma_CSR};
+            magma_d_matrix hP={Magma_CSR}, hR={Magma_CSR}, hAc={Magma_CSR};
+            real_Double_t products = 0.0;
+            for( magma_int_t k=0; k < hA.num_rows; k++ ) {
+                for( magma_int_t l=hA.row[k]; l < hA.row[k+1]; l++ ) {
+                    products += hA.row[ hA.col[l]+1 ] - hA.row[ hA.col[l] ];
+                }
+            }
+            FLOPS = 2.0*products/1e9;
+
+            start = magma_wtime();
+            TESTING_CHECK( magma_d_spmm_cpu( c_one, hA, hA, &hC, queue ));
+            end = magma_wtime();
+            printf( " > MAGMA host SpGEMM: %.2e seconds %.2e GFLOP/s    (A*A, nnz %lld).\n",
+                    end-start, FLOPS/(end-start), (long long) hC.nnz );
+            start = magma_wtime();
+            TESTING_CHECK( magma_d_spmm_symbolic_cpu( hA, hA, &hS, queue ));
+            end = magma_wtime();
+            printf( " > MAGMA host SpGEMM: %.2e seconds                  (symbolic).\n",
+                    end-start );
+            start = magma_wtime();
+            TESTING_CHECK( magma_d_spmm_numeric_cpu( c_one, hA, hA, &hS, queue ));
+            end = magma_wtime();
+            printf( " > MAGMA host SpGEMM: %.2e seconds %.2e GFLOP/s    (numeric).\n",
+                    end-start, FLOPS/(end-start) );
+
+            // compare against the device product
+            TESTING_CHECK( magma_d_spmm( c_one, dA, dA, &dC, queue ));
+            magma_dmfree( &hcheck, queue );
+            TESTING_CHECK( magma_dmtransfer( dC, &hcheck, Magma_DEV, Magma_CPU, queue ));
+            // the symbolic + numeric product has to match the one-pass one
+            magma_int_t errors = ( hS.nnz == hC.nnz ) ? 0 : 1;
+            for( magma_int_t k=0; errors == 0 && k <= m; k++ ) {
+                errors += ( hS.row[k] != hC.row[k] );
+            }
+            res = 0.0;
+            for( magma_int_t k=0; errors == 0 && k < hC.nnz; k++ ) {
+                errors += ( hS.col[k] != hC.col[k] );
+                res = res + MAGMA_D_ABS( MAGMA_D_SUB( hS.val[k], hC.val[k] ));
+            }
+            for( magma_int_t k=0; k < hC.nnz && hcheck.nnz == hC.nnz; k++ ) {
+                res = res + MAGMA_D_ABS( MAGMA_D_SUB( hcheck.val[k], hC.val[k] ));
+            }
+            printf("%% |C_host-C_dev| = %8.2e\n", res);
+            if ( res < accuracy * hC.nnz && hcheck.nnz == hC.nnz && errors == 0 )
+                printf("%% tester host SpGEMM:  ok\n");
+            else
+                printf("%% tester host SpGEMM:  failed\n");
+
+            // Galerkin product R * A * P with aggregates of 4 consecutive rows
+            magma_int_t nc = magma_ceildiv( m, 4 );
+            hP.storage_type = hR.storage_type = Magma_CSR;
+            hP.memory_location = hR.memory_location = Magma_CPU;
+            hP.num_rows = hR.num_cols = m;
+            hP.num_cols = hR.num_rows = nc;
+            hP.nnz = hR.nnz = m;
+            TESTING_CHECK( magma_index_malloc_cpu( &hP.row, m+1 ));
+            TESTING_CHECK( magma_index_malloc_cpu( &hP.col, m ));
+            TESTING_CHECK( magma_dmalloc_cpu( &hP.val, m ));
+            TESTING_CHECK( magma_index_malloc_cpu( &hR.row, nc+1 ));
+            TESTING_CHECK( magma_index_malloc_cpu( &hR.col, m ));
+            TESTING_CHECK( magma_dmalloc_cpu( &hR.val, m ));
+            for( magma_int_t k=0; k < m; k++ ) {
+                hP.row[k] = k;
+                hP.col[k] = k/4;
+                hP.val[k] = c_one;
+                hR.col[k] = k;
+                hR.val[k] = c_one;
+            }
+            hP.row[m] = m;
+            for( magma_int_t k=0; k <= nc; k++ ) {
+                hR.row[k] = min( 4*k, m );
+            }
+            start = magma_wtime();
+            TESTING_CHECK( magma_d_spmm_rap_cpu( hR, hA, hP, &hAc, queue ));
+            end = magma_wtime();
+            printf( " > MAGMA host SpGEMM: %.2e seconds                  (R*A*P, %lld-by-%lld with %lld nonzeros).\n",
+                    end-start, (long long) hAc.num_rows, (long long) hAc.num_cols,
+                    (long long) hAc.nnz );
+
+            // every entry a_ij of A adds to entry (i/4, j/4) of Ac, and
+            // these are all entries of Ac; so subtracting them leaves zero
+            errors = ( hAc.num_rows == nc && hAc.num_cols == nc ) ? 0 : 1;
+            for( magma_int_t i=0; errors == 0 && i < m; i++ ) {
+                for( magma_int_t l=hA.row[i]; l < hA.row[i+1]; l++ ) {
+                    magma_int_t k = hAc.row[ i/4 ];
+                    while ( k < hAc.row[ i/4+1 ] && hAc.col[k] != hA.col[l]/4 ) {
+                        k++;
+                    }
+                    if ( k == hAc.row[ i/4+1 ] ) {
+                        errors++;
+                        break;
+                    }
+                    hAc.val[k] = MAGMA_D_SUB( hAc.val[k], hA.val[l] );
+                }
+            }
+            res = 0.0;
+            for( magma_int_t k=0; errors == 0 && k < hAc.nnz; k++ ) {
+                res = res + MAGMA_D_ABS( hAc.val[k] );
+            }
+            printf("%% |R*A*P - sum of aggregates| = %8.2e\n", res);
+            if ( res < accuracy * hA.nnz && errors == 0 )
+                printf("%% tester host RAP:  ok\n");
+            else
+                printf("%% tester host RAP:  failed\n");
+
+            magma_dmfree( &hcheck, queue );
+            magma_dmfree( &hC, queue );
+            magma_dmfree( &hS, queue );
+            magma_dmfree( &dC, queue );
+            magma_dmfree( &hP, queue );
+            magma_dmfree( &hR, queue );
+            magma_dmfree( &hAc, queue );
+        }
+
         printf("\n\n");
 
         // free CPU memory
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date February 2023
 
-       @generated from sparse/testing/testing_zspmv.cpp, normal z -> d, Wed Feb 22 15:22:03 2023
+       @generated from sparse/testing/testing_zspmv.cpp, normal z -> d, Sun Oct 18 03:09:33 2026
        @author Hartwig Anzt
 */
 
@@ -229,6 +229,24 @@ int main(  int argc, char** argv )
             ref = ref + MAGMA_D_ABS(hrefvec.val[k]);
         }
 
+        // SpMV on CPU (CSR)
+        magma_dmfree( &hx, queue );
+        TESTING_CHECK( magma_dvinit( &hx, Magma_CPU, hA.num_rows, 1, c_one, queue ));
+        start = magma_wtime();
+        for (j=0; j < 200; j++) {
+            TESTING_CHECK( magma_d_spmv( c_one, hA, hx, c_zero, hy, queue ));
+        }
+        end = magma_wtime();
+        res = 0.0;
+        for(magma_int_t k=0; k < hA.num_rows; k++ ){
+            res = res + MAGMA_D_ABS(hy.val[k] - hrefvec.val[k]);
+        }
+        res = ref == 0 ? res : res / ref;
+        printf( "%% > MAGMA: %.2e seconds %.2e GFLOP/s    (host CSR).\n",
+                                        (end-start)/200, FLOPS*200/(end-start) );
+        printf("%% |x-y|_F/|y| = %8.2e Tester spmv host CSR:  %s\n",
+                res, (res < accuracy ? "ok" : "failed") );
+
         // convert to ELL and copy to GPU
         TESTING_CHECK( magma_dmconvert(  hA, &hA_ELL, Magma_CSR, Magma_ELL, queue ));
         TESTING_CHECK( magma_dmtransfer( hA_ELL, &dA_ELL, Magma_CPU, Magma_DEV, queue ));
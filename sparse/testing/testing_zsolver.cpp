@@ -36,7 +36,9 @@ int main(  int argc, char** argv )
     
     // magmaDoubleComplex zero = MAGMA_Z_MAKE(0.0, 0.0);
     magma_z_matrix A={Magma_CSR}, B={Magma_CSR}, dB={Magma_CSR};
-    magma_z_matrix x={Magma_CSR}, b={Magma_CSR};
+    magma_z_matrix x={Magma_CSR}, b={Magma_CSR}, Abin={Magma_CSR};
+    magma_z_matrix PA={Magma_CSR};
+    magma_index_t *perm = NULL;
     
     int i=1;
     TESTING_CHECK( magma_zparse_opts( argc, argv, &zopts, &i, queue ));
@@ -50,6 +52,10 @@ int main(  int argc, char** argv )
             i++;
             magma_int_t laplace_size = atoi( argv[i] );
             TESTING_CHECK( magma_zm_5stencil(  laplace_size, &A, queue ));
+        } else if ( zopts.binary ) {    // binary file-matrix test
+            // A aliases the mapping until scaling replaces it
+            TESTING_CHECK( magma_z_csr_binary( &Abin,  argv[i], queue ));
+            A = Abin;
         } else {                        // file-matrix test
             TESTING_CHECK( magma_z_csr_mtx( &A,  argv[i], queue ));
         }
@@ -60,9 +66,20 @@ int main(  int argc, char** argv )
 
         // scale matrix
         TESTING_CHECK( magma_zmscale( &A, zopts.scaling, queue ));
+
+        // reorder matrix, the solution is mapped back after the solve
+        if ( zopts.reorder != Magma_NOREORDER ) {
+            TESTING_CHECK( magma_zmreorder( A, zopts.reorder, &perm, queue ));
+            TESTING_CHECK( magma_zmpermute( A, perm, &PA, queue ));
+            magma_zmfree(&A, queue );
+            A = PA;
+            PA = {Magma_CSR};
+        }
         
         // preconditioner
-        if ( zopts.solver_par.solver != Magma_ITERREF ) {
+        if ( zopts.compute_location == Magma_CPU ) {
+            TESTING_CHECK( magma_z_precondsetup_cpu( A, &zopts.precond_par, queue ) );
+        } else if ( zopts.solver_par.solver != Magma_ITERREF ) {
             TESTING_CHECK( magma_z_precondsetup( A, b, &zopts.solver_par, &zopts.precond_par, queue ) );
         }
 
@@ -80,20 +97,33 @@ int main(  int argc, char** argv )
         printf("%%============================================================================%%\n");
         printf("];\n");
 
-        TESTING_CHECK( magma_zmtransfer( B, &dB, Magma_CPU, Magma_DEV, queue ));
+        if ( zopts.compute_location == Magma_CPU ) {
+            // host solve: A, b and x stay in CPU memory;
+            // B's rows are placed on the NUMA node of the thread using them
+            TESTING_CHECK( magma_zmfirsttouch_cpu( &B, queue ));
+            TESTING_CHECK( magma_zvinit_rand( &b, Magma_CPU, A.num_rows, 1, queue ));
+            TESTING_CHECK( magma_zvinit_rand( &x, Magma_CPU, A.num_cols, 1, queue ));
 
-        // vectors and initial guess
-        TESTING_CHECK( magma_zvinit_rand( &b, Magma_DEV, A.num_rows, 1, queue ));
-        //magma_zvinit( &x, Magma_DEV, A.num_cols, 1, one, queue );
-        //magma_z_spmv( one, dB, x, zero, b, queue );                 //  b = A x
-        //magma_zmfree(&x, queue );
-        TESTING_CHECK( magma_zvinit_rand( &x, Magma_DEV, A.num_cols, 1, queue ));
-        
-        info = magma_z_solver( dB, b, &x, &zopts, queue );
+            info = magma_z_solver( B, b, &x, &zopts, queue );
+        } else {
+            TESTING_CHECK( magma_zmtransfer( B, &dB, Magma_CPU, Magma_DEV, queue ));
+
+            // vectors and initial guess
+            TESTING_CHECK( magma_zvinit_rand( &b, Magma_DEV, A.num_rows, 1, queue ));
+            //magma_zvinit( &x, Magma_DEV, A.num_cols, 1, one, queue );
+            //magma_z_spmv( one, dB, x, zero, b, queue );                 //  b = A x
+            //magma_zmfree(&x, queue );
+            TESTING_CHECK( magma_zvinit_rand( &x, Magma_DEV, A.num_cols, 1, queue ));
+
+            info = magma_z_solver( dB, b, &x, &zopts, queue );
+        }
         if( info != 0 ) {
             printf("%%error: solver returned: %s (%lld).\n",
                     magma_strerror( info ), (long long) info );
         }
+        if ( perm != NULL ) {
+            TESTING_CHECK( magma_zvpermute_inverse( x, perm, &x, queue ));
+        }
         printf("convergence = [\n");
         magma_zsolverinfo( &zopts.solver_par, &zopts.precond_par, queue );
         printf("];\n\n");
@@ -111,8 +141,11 @@ int main(  int argc, char** argv )
         magma_zmfree(&dB, queue );
         magma_zmfree(&B, queue );
         magma_zmfree(&A, queue );
+        magma_zmunmap(&Abin, queue );
         magma_zmfree(&x, queue );
         magma_zmfree(&b, queue );
+        magma_free_cpu( perm );
+        perm = NULL;
         i++;
     }
 
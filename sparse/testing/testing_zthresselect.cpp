@@ -64,10 +64,25 @@ int main(  int argc, char** argv )
                 count++;    
             }
         }
-        printf("%% m n thrs count absolute-acc relative-acc time-gpu m n thrs count absolute-acc relative-acc time-cpu\n");
+        printf("%% m n thrs count absolute-acc relative-acc time-gpu m n thrs count absolute-acc relative-acc time-cpu-sampleselect m n thrs count absolute-acc relative-acc time-cpu\n");
 
         printf( " %10d  %10d  %.8e  %10d %.4e %.4e\t\t %.3e", m, n, thrs, count, fabs(1.0-(float)count/(float)n), fabs((float)(n-count)/(float)m), t_gpu );
         
+        // host sample select, leaves val unchanged
+        start = magma_wtime();
+        for(int i=0; i<10; i++)
+            TESTING_CHECK(magma_zsampleselect_cpu(m, n, val, &thrs, queue));
+        end = magma_wtime();
+        t_cpu = (end-start) / 10.0;
+        count = 0;
+        for(int z=0; z<m; z++) {
+            if (MAGMA_Z_ABS(val[z])<thrs) {
+                count++;    
+            }
+        }
+        
+        printf( " %10d  %10d  %.8e  %10d %.4e %.4e\t\t %.3e", m, n, thrs, count, fabs(1.0-(float)count/(float)n), fabs((float)(n-count)/(float)m), t_cpu );
+        
         // cpu reference for comparison
         A.nnz = m;
         A.val = val;
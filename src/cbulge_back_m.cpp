@@ -9,12 +9,13 @@
        @author Stan Tomov
        @author Raffaele Solca
        
-       @generated from src/zbulge_back_m.cpp, normal z -> c, Wed Feb 22 15:19:37 2023
+       @generated from src/zbulge_back_m.cpp, normal z -> c, Sun Oct 18 05:04:37 2026
 
  */
 #include "magma_internal.h"
 #include "magma_bulge.h"
 #include "magma_cbulge.h"
+#include "thread_queue.hpp"
 
 #ifndef MAGMA_NOAFFINITY
 #include "affinity.h"
@@ -113,6 +114,21 @@ public:
 };
 
 
+/******************************************************************************/
+// Runs one thread's part of magma_capplyQ_m_parallel_section on a worker.
+class magma_capplyQ_m_task: public magma_task
+{
+public:
+    magma_capplyQ_m_task( magma_capplyQ_m_id_data* in_arg ):
+        arg( in_arg ) {}
+
+    virtual void run() { magma_capplyQ_m_parallel_section( arg ); }
+
+private:
+    magma_capplyQ_m_id_data* arg;
+};
+
+
 /******************************************************************************/
 extern "C" magma_int_t
 magma_cbulge_back_m(
@@ -126,8 +142,8 @@ magma_cbulge_back_m(
     magmaFloatComplex *T, magma_int_t ldt,
     magma_int_t* info)
 {
-    magma_int_t threads = magma_get_parallel_numthreads();
-    magma_int_t mklth   = magma_get_lapack_numthreads();
+    magma_thread_budget_t budget;
+    magma_int_t threads = magma_thread_budget_acquire( -1, &budget );
     magma_set_lapack_numthreads(1);
 
     real_Double_t timeaplQ2=0.0;
@@ -170,34 +186,23 @@ magma_cbulge_back_m(
         magma_capplyQ_m_id_data* arg;
         magma_malloc_cpu((void**) &arg, threads*sizeof(magma_capplyQ_m_id_data));
 
-        pthread_t* thread_id;
-        magma_malloc_cpu((void**) &thread_id, threads*sizeof(pthread_t));
-
-        pthread_attr_t thread_attr;
-
         // ===============================
-        // relaunch thread to apply Q
+        // apply Q on threads-1 workers from the persistent pool and the
+        // calling thread. Each worker takes one task and waits in the
+        // barrier, so all tasks run concurrently on distinct workers.
         // ===============================
-        // Set one thread per core
-        pthread_attr_init(&thread_attr);
-        pthread_attr_setscope(&thread_attr, PTHREAD_SCOPE_SYSTEM);
-        pthread_setconcurrency( (unsigned)threads );
-
-        // Launch threads
+        magma_thread_queue workers;
+        workers.launch( threads-1 );
         for (magma_int_t thread = 1; thread < threads; thread++) {
             arg[thread] = magma_capplyQ_m_id_data(thread, &data_applyQ);
-            pthread_create(&thread_id[thread], &thread_attr, magma_capplyQ_m_parallel_section, &arg[thread]);
+            workers.push_task( new magma_capplyQ_m_task( &arg[thread] ));
         }
         arg[0] = magma_capplyQ_m_id_data(0, &data_applyQ);
         magma_capplyQ_m_parallel_section(&arg[0]);
 
-        // Wait for completion
-        for (magma_int_t thread = 1; thread < threads; thread++) {
-            void *exitcodep;
-            pthread_join(thread_id[thread], &exitcodep);
-        }
+        // Wait for completion; workers return to the pool
+        workers.quit();
 
-        magma_free_cpu(thread_id);
         magma_free_cpu(arg);
 
         /*============================
@@ -209,7 +214,7 @@ magma_cbulge_back_m(
 
     timeaplQ2 = magma_wtime()-timeaplQ2;
 
-    magma_set_lapack_numthreads(mklth);
+    magma_thread_budget_release( &budget );
     return MAGMA_SUCCESS;
 }
 
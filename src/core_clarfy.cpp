@@ -7,11 +7,96 @@
 
        @author Azzam Haidar
   
-       @generated from src/core_zlarfy.cpp, normal z -> c, Wed Feb 22 15:19:38 2023
+       @generated from src/core_zlarfy.cpp, normal z -> c, Sun Oct 18 04:44:21 2026
 */
 #include "magma_internal.h"
 #include "magma_bulge.h"
 
+/******************************************************************************/
+// Fused chemv + cher2 on the n-by-n window of the band, which is small
+// (n <= nb), so library calls dominate. A is read twice: once for
+// X = tau A V, which computes the dot and axpy of a column together,
+// and once for the rank 2 update. Both passes do two columns at a time,
+// so each X(i), V(i) is loaded once per pair of columns.
+// N > 0 is the compile time size for common band widths, N = 0 uses n.
+template< magma_int_t N >
+static void
+magma_clarfy_kernel(
+    magma_int_t n_,
+    magmaFloatComplex *A, magma_int_t lda,
+    const magmaFloatComplex *V, magmaFloatComplex tau,
+    magmaFloatComplex *work)
+{
+    const magma_int_t n = (N > 0 ? N : n_);
+    const magmaFloatComplex c_zero = MAGMA_C_ZERO;
+    const magmaFloatComplex c_half = MAGMA_C_HALF;
+    magmaFloatComplex dtmp, a0, a1, t0, t1, s0, s1;
+    magma_int_t j;
+
+    /* X = AVtau, using the lower triangle of A */
+    #pragma omp simd
+    for (magma_int_t i = 0; i < n; ++i) {
+        work[i] = c_zero;
+    }
+    for (j = 0; j+1 < n; j += 2) {
+        const magmaFloatComplex *A0 = A + j*lda;
+        const magmaFloatComplex *A1 = A0 + lda;
+        t0 = tau * V[j];
+        t1 = tau * V[j+1];
+        s0 = MAGMA_C_CONJ( A0[j+1] ) * V[j+1];
+        s1 = c_zero;
+        work[j]   += t0 * MAGMA_C_REAL( A0[j] );
+        work[j+1] += t0 * A0[j+1] + t1 * MAGMA_C_REAL( A1[j+1] );
+        for (magma_int_t i = j+2; i < n; ++i) {
+            a0 = A0[i];
+            a1 = A1[i];
+            work[i] += t0 * a0 + t1 * a1;
+            s0 += MAGMA_C_CONJ( a0 ) * V[i];
+            s1 += MAGMA_C_CONJ( a1 ) * V[i];
+        }
+        work[j]   += tau * s0;
+        work[j+1] += tau * s1;
+    }
+    if (j < n) {
+        work[j] += tau * V[j] * MAGMA_C_REAL( A[j + j*lda] );
+    }
+
+    /* compute W = X - 1/2 V X'V tau */
+    dtmp = c_zero;
+    for (magma_int_t i = 0; i < n; ++i) {
+        dtmp += MAGMA_C_CONJ( work[i] ) * V[i];
+    }
+    dtmp = -dtmp * c_half * tau;
+    #pragma omp simd
+    for (magma_int_t i = 0; i < n; ++i) {
+        work[i] += dtmp * V[i];
+    }
+
+    /* A = A - W V' - V W', diagonal stays real */
+    for (j = 0; j+1 < n; j += 2) {
+        magmaFloatComplex *A0 = A + j*lda;
+        magmaFloatComplex *A1 = A0 + lda;
+        t0 = MAGMA_C_CONJ( V[j] );
+        s0 = MAGMA_C_CONJ( work[j] );
+        t1 = MAGMA_C_CONJ( V[j+1] );
+        s1 = MAGMA_C_CONJ( work[j+1] );
+        A0[j]   = MAGMA_C_MAKE( MAGMA_C_REAL( A0[j] - work[j]*t0 - V[j]*s0 ), 0. );
+        A0[j+1] -= work[j+1]*t0 + V[j+1]*s0;
+        A1[j+1] = MAGMA_C_MAKE( MAGMA_C_REAL( A1[j+1] - work[j+1]*t1 - V[j+1]*s1 ), 0. );
+        #pragma omp simd
+        for (magma_int_t i = j+2; i < n; ++i) {
+            A0[i] -= work[i]*t0 + V[i]*s0;
+            A1[i] -= work[i]*t1 + V[i]*s1;
+        }
+    }
+    if (j < n) {
+        magmaFloatComplex *A0 = A + j*lda;
+        A0[j] = MAGMA_C_MAKE( MAGMA_C_REAL( A0[j] - work[j]*MAGMA_C_CONJ( V[j] )
+                                                  - V[j]*MAGMA_C_CONJ( work[j] )), 0. );
+    }
+}
+
+
 /***************************************************************************//**
  *
  * @ingroup magma_larfy
@@ -60,30 +145,10 @@ magma_clarfy(
     /*
     work (workspace) float complex array, dimension n
     */
-
-    const magma_int_t ione = 1;
-    const magmaFloatComplex c_zero   =  MAGMA_C_ZERO;
-    const magmaFloatComplex c_neg_one=  MAGMA_C_NEG_ONE;
-    const magmaFloatComplex c_half   =  MAGMA_C_HALF;
-    magmaFloatComplex dtmp;
-
-    /* X = AVtau */
-    blasf77_chemv("L",&n, TAU, A, &lda, V, &ione, &c_zero, work, &ione);
-
-    /* compute dtmp= X'*V */
-    dtmp = magma_cblas_cdotc(n, work, ione, V, ione);
-    /*
-    dtmp = c_zero;
-    for (magma_int_t j = 0; j < n; j++)
-        dtmp = dtmp + MAGMA_C_CONJ(work[j]) * V[j];
-    */
-
-    /* compute 1/2 X'*V*t = 1/2*dtmp*tau  */
-    dtmp = -dtmp * c_half * (*TAU);
-
-    /* compute W=X-1/2VX'Vt = X - dtmp*V */
-    blasf77_caxpy(&n, &dtmp, V, &ione, work, &ione);
-
-    /* performs the symmetric rank 2 operation A := alpha*x*y' + alpha*y*x' + A */
-    blasf77_cher2("L", &n, &c_neg_one, work, &ione, V, &ione, A, &lda);
+    switch (n) {
+        case 16: magma_clarfy_kernel<16>( n, A, lda, V, *TAU, work ); break;
+        case 32: magma_clarfy_kernel<32>( n, A, lda, V, *TAU, work ); break;
+        case 64: magma_clarfy_kernel<64>( n, A, lda, V, *TAU, work ); break;
+        default: magma_clarfy_kernel<0> ( n, A, lda, V, *TAU, work ); break;
+    }
 }
@@ -7,11 +7,96 @@
 
        @author Azzam Haidar
   
-       @generated from src/core_zlarfy.cpp, normal z -> d, Wed Feb 22 15:19:38 2023
+       @generated from src/core_zlarfy.cpp, normal z -> d, Sun Oct 18 04:44:21 2026
 */
 #include "magma_internal.h"
 #include "magma_bulge.h"
 
+/******************************************************************************/
+// Fused dsymv + dsyr2 on the n-by-n window of the band, which is small
+// (n <= nb), so library calls dominate. A is read twice: once for
+// X = tau A V, which computes the dot and axpy of a column together,
+// and once for the rank 2 update. Both passes do two columns at a time,
+// so each X(i), V(i) is loaded once per pair of columns.
+// N > 0 is the compile time size for common band widths, N = 0 uses n.
+template< magma_int_t N >
+static void
+magma_dlarfy_kernel(
+    magma_int_t n_,
+    double *A, magma_int_t lda,
+    const double *V, double tau,
+    double *work)
+{
+    const magma_int_t n = (N > 0 ? N : n_);
+    const double c_zero = MAGMA_D_ZERO;
+    const double c_half = MAGMA_D_HALF;
+    double dtmp, a0, a1, t0, t1, s0, s1;
+    magma_int_t j;
+
+    /* X = AVtau, using the lower triangle of A */
+    #pragma omp simd
+    for (magma_int_t i = 0; i < n; ++i) {
+        work[i] = c_zero;
+    }
+    for (j = 0; j+1 < n; j += 2) {
+        const double *A0 = A + j*lda;
+        const double *A1 = A0 + lda;
+        t0 = tau * V[j];
+        t1 = tau * V[j+1];
+        s0 = MAGMA_D_CONJ( A0[j+1] ) * V[j+1];
+        s1 = c_zero;
+        work[j]   += t0 * MAGMA_D_REAL( A0[j] );
+        work[j+1] += t0 * A0[j+1] + t1 * MAGMA_D_REAL( A1[j+1] );
+        for (magma_int_t i = j+2; i < n; ++i) {
+            a0 = A0[i];
+            a1 = A1[i];
+            work[i] += t0 * a0 + t1 * a1;
+            s0 += MAGMA_D_CONJ( a0 ) * V[i];
+            s1 += MAGMA_D_CONJ( a1 ) * V[i];
+        }
+        work[j]   += tau * s0;
+        work[j+1] += tau * s1;
+    }
+    if (j < n) {
+        work[j] += tau * V[j] * MAGMA_D_REAL( A[j + j*lda] );
+    }
+
+    /* compute W = X - 1/2 V X'V tau */
+    dtmp = c_zero;
+    for (magma_int_t i = 0; i < n; ++i) {
+        dtmp += MAGMA_D_CONJ( work[i] ) * V[i];
+    }
+    dtmp = -dtmp * c_half * tau;
+    #pragma omp simd
+    for (magma_int_t i = 0; i < n; ++i) {
+        work[i] += dtmp * V[i];
+    }
+
+    /* A = A - W V' - V W', diagonal stays real */
+    for (j = 0; j+1 < n; j += 2) {
+        double *A0 = A + j*lda;
+        double *A1 = A0 + lda;
+        t0 = MAGMA_D_CONJ( V[j] );
+        s0 = MAGMA_D_CONJ( work[j] );
+        t1 = MAGMA_D_CONJ( V[j+1] );
+        s1 = MAGMA_D_CONJ( work[j+1] );
+        A0[j]   = MAGMA_D_MAKE( MAGMA_D_REAL( A0[j] - work[j]*t0 - V[j]*s0 ), 0. );
+        A0[j+1] -= work[j+1]*t0 + V[j+1]*s0;
+        A1[j+1] = MAGMA_D_MAKE( MAGMA_D_REAL( A1[j+1] - work[j+1]*t1 - V[j+1]*s1 ), 0. );
+        #pragma omp simd
+        for (magma_int_t i = j+2; i < n; ++i) {
+            A0[i] -= work[i]*t0 + V[i]*s0;
+            A1[i] -= work[i]*t1 + V[i]*s1;
+        }
+    }
+    if (j < n) {
+        double *A0 = A + j*lda;
+        A0[j] = MAGMA_D_MAKE( MAGMA_D_REAL( A0[j] - work[j]*MAGMA_D_CONJ( V[j] )
+                                                  - V[j]*MAGMA_D_CONJ( work[j] )), 0. );
+    }
+}
+
+
 /***************************************************************************//**
  *
  * @ingroup magma_larfy
@@ -60,30 +145,10 @@ magma_dlarfy(
     /*
     work (workspace) double real array, dimension n
     */
-
-    const magma_int_t ione = 1;
-    const double c_zero   =  MAGMA_D_ZERO;
-    const double c_neg_one=  MAGMA_D_NEG_ONE;
-    const double c_half   =  MAGMA_D_HALF;
-    double dtmp;
-
-    /* X = AVtau */
-    blasf77_dsymv("L",&n, TAU, A, &lda, V, &ione, &c_zero, work, &ione);
-
-    /* compute dtmp= X'*V */
-    dtmp = magma_cblas_ddot(n, work, ione, V, ione);
-    /*
-    dtmp = c_zero;
-    for (magma_int_t j = 0; j < n; j++)
-        dtmp = dtmp + MAGMA_D_CONJ(work[j]) * V[j];
-    */
-
-    /* compute 1/2 X'*V*t = 1/2*dtmp*tau  */
-    dtmp = -dtmp * c_half * (*TAU);
-
-    /* compute W=X-1/2VX'Vt = X - dtmp*V */
-    blasf77_daxpy(&n, &dtmp, V, &ione, work, &ione);
-
-    /* performs the symmetric rank 2 operation A := alpha*x*y' + alpha*y*x' + A */
-    blasf77_dsyr2("L", &n, &c_neg_one, work, &ione, V, &ione, A, &lda);
+    switch (n) {
+        case 16: magma_dlarfy_kernel<16>( n, A, lda, V, *TAU, work ); break;
+        case 32: magma_dlarfy_kernel<32>( n, A, lda, V, *TAU, work ); break;
+        case 64: magma_dlarfy_kernel<64>( n, A, lda, V, *TAU, work ); break;
+        default: magma_dlarfy_kernel<0> ( n, A, lda, V, *TAU, work ); break;
+    }
 }
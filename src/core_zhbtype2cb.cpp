@@ -17,6 +17,96 @@
 #define V(m)     (V + (m))
 #define TAU(m)   (TAU + (m))
 
+/******************************************************************************/
+// Fused kernel for the lem-by-len block C = A(J1:J2, st:ed).
+// Applies the right reflector (V1, tau1) from the top block, eliminates the
+// first column of the created bulge into (V2, TAU2), and applies V2 from the
+// left. The right and left updates of columns st+1:ed are done together,
+// one column at a time, so the block is read twice instead of four times.
+// N > 0 is the compile time size when lem == len, N = 0 uses lem and len.
+template< magma_int_t N >
+static void
+magma_zhbtype2cb_kernel(
+    magma_int_t lem_, magma_int_t len_,
+    magmaDoubleComplex *C, magma_int_t ldc,
+    const magmaDoubleComplex *V1, magmaDoubleComplex tau1,
+    magmaDoubleComplex *V2, magmaDoubleComplex *TAU2,
+    magmaDoubleComplex *work)
+{
+    const magma_int_t lem = (N > 0 ? N : lem_);
+    const magma_int_t len = (N > 0 ? N : len_);
+    const magma_int_t ione = 1;
+    const magmaDoubleComplex c_zero = MAGMA_Z_ZERO;
+    const magmaDoubleComplex c_one  = MAGMA_Z_ONE;
+    magmaDoubleComplex ctmp = c_zero, tmp, dot;
+
+    /* work = C V1 */
+    #pragma omp simd
+    for (magma_int_t i = 0; i < lem; ++i) {
+        work[i] = c_zero;
+    }
+    magma_int_t j;
+    for (j = 0; j+1 < len; j += 2) {
+        const magmaDoubleComplex *C0 = C + j*ldc;
+        const magmaDoubleComplex *C1 = C0 + ldc;
+        tmp = V1[j];
+        dot = V1[j+1];
+        #pragma omp simd
+        for (magma_int_t i = 0; i < lem; ++i) {
+            work[i] += C0[i] * tmp + C1[i] * dot;
+        }
+    }
+    if (j < len) {
+        const magmaDoubleComplex *C0 = C + j*ldc;
+        tmp = V1[j];
+        #pragma omp simd
+        for (magma_int_t i = 0; i < lem; ++i) {
+            work[i] += C0[i] * tmp;
+        }
+    }
+
+    /* Apply remaining right to col st */
+    tmp = -tau1 * MAGMA_Z_CONJ( V1[0] );
+    #pragma omp simd
+    for (magma_int_t i = 0; i < lem; ++i) {
+        C[i] += work[i] * tmp;
+    }
+
+    if ( lem > 1 ) {
+        /* Remove the first column of the created bulge */
+        *V2 = c_one;
+        memcpy( V2+1, C+1, (lem-1)*sizeof(magmaDoubleComplex) );
+        memset( C+1, 0, (lem-1)*sizeof(magmaDoubleComplex) );
+
+        /* Eliminate the col at st */
+        magma_int_t lem1 = lem;
+        lapackf77_zlarfg( &lem1, C, V2+1, &ione, TAU2 );
+        ctmp = MAGMA_Z_CONJ( *TAU2 );
+    }
+
+    /* Apply right, then left on each of the cols st+1:ed */
+    for (j = 1; j < len; ++j) {
+        magmaDoubleComplex *Cj = C + j*ldc;
+        tmp = -tau1 * MAGMA_Z_CONJ( V1[j] );
+        #pragma omp simd
+        for (magma_int_t i = 0; i < lem; ++i) {
+            Cj[i] += work[i] * tmp;
+        }
+        if ( lem > 1 ) {
+            dot = c_zero;
+            for (magma_int_t i = 0; i < lem; ++i) {
+                dot += MAGMA_Z_CONJ( V2[i] ) * Cj[i];
+            }
+            dot = -ctmp * dot;
+            #pragma omp simd
+            for (magma_int_t i = 0; i < lem; ++i) {
+                Cj[i] += V2[i] * dot;
+            }
+        }
+    }
+}
+
+
 /***************************************************************************//**
  *
  * @ingroup magma_hbtype2cb
@@ -107,12 +197,9 @@ magma_zhbtype2cb(magma_int_t n, magma_int_t nb,
                 magma_int_t Vblksiz, magma_int_t wantz,
                 magmaDoubleComplex *work)
 {
-    magmaDoubleComplex ctmp;
     magma_int_t J1, J2, len, lem, ldx;
-    magma_int_t vpos, taupos;
+    magma_int_t vpos, taupos, vpos2, taupos2;
     //magma_int_t blkid, tpos;
-    magma_int_t ione = 1;
-    const magmaDoubleComplex c_one    =  MAGMA_Z_ONE;
 
     if ( wantz == 0 ) {
         vpos   = (sweep%2)*n + st;
@@ -128,39 +215,44 @@ magma_zhbtype2cb(magma_int_t n, magma_int_t nb,
     len = ed-st+1;
     lem = J2-J1+1;
 
-    if ( lem > 0 ) {
-        /* Apply remaining right commming from the top block */
-        lapackf77_zlarfx("R", &lem, &len, V(vpos), TAU(taupos), A(J1, st), &ldx, work);
+    if ( lem <= 0 ) {
+        return;
     }
 
+    vpos2   = vpos;
+    taupos2 = taupos;
     if ( lem > 1 ) {
         if ( wantz == 0 ) {
-            vpos   = (sweep%2)*n + J1;
-            taupos = (sweep%2)*n + J1;
+            vpos2   = (sweep%2)*n + J1;
+            taupos2 = (sweep%2)*n + J1;
         } else {
-            magma_bulge_findVTAUpos(n, nb, Vblksiz, sweep, J1, ldv, &vpos, &taupos);
+            magma_bulge_findVTAUpos(n, nb, Vblksiz, sweep, J1, ldv, &vpos2, &taupos2);
             //findVTpos(n,nb,Vblksiz,sweep,J1, &vpos, &taupos, &tpos, &blkid);
         }
+    }
 
-        /* Remove the first column of the created bulge */
-        *V(vpos)  = c_one;
-        
-        //magma_int_t lem2=lem-1;
-        //blasf77_zcopy( &lem2, A(ed+2, st), &ione, V(vpos+1), &ione );
-        memcpy(V(vpos+1), A(J1+1, st), (lem-1)*sizeof(magmaDoubleComplex));
-        memset(A(J1+1, st), 0, (lem-1)*sizeof(magmaDoubleComplex));
-
-        /* Eliminate the col at st */
-        lapackf77_zlarfg( &lem, A(J1, st), V(vpos+1), &ione, TAU(taupos) );
-
-        /*
-         * Apply left on A(J1:J2,st+1:ed)
-         * We decrease len because we start at col st+1 instead of st.
-         * col st is the col that has been revomved;
-         */
-        len = len-1;
-        ctmp = MAGMA_Z_CONJ(*TAU(taupos));
-        lapackf77_zlarfx("L", &lem, &len, V(vpos),  &ctmp, A(J1, st+1), &ldx, work);
+    /*
+     * Apply remaining right commming from the top block on A(J1:J2,st:ed),
+     * eliminate the col at st, and apply left on A(J1:J2,st+1:ed).
+     * col st is the col that has been removed.
+     */
+    switch ( lem == len ? len : 0 ) {
+        case 16:
+            magma_zhbtype2cb_kernel<16>( lem, len, A(J1, st), ldx, V(vpos), *TAU(taupos),
+                                         V(vpos2), TAU(taupos2), work );
+            break;
+        case 32:
+            magma_zhbtype2cb_kernel<32>( lem, len, A(J1, st), ldx, V(vpos), *TAU(taupos),
+                                         V(vpos2), TAU(taupos2), work );
+            break;
+        case 64:
+            magma_zhbtype2cb_kernel<64>( lem, len, A(J1, st), ldx, V(vpos), *TAU(taupos),
+                                         V(vpos2), TAU(taupos2), work );
+            break;
+        default:
+            magma_zhbtype2cb_kernel<0>( lem, len, A(J1, st), ldx, V(vpos), *TAU(taupos),
+                                        V(vpos2), TAU(taupos2), work );
+            break;
     }
 }
 
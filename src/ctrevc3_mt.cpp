@@ -8,12 +8,12 @@
        @author Mark Gates
        @author Azzam Haidar
        
-       @generated from src/ztrevc3_mt.cpp, normal z -> c, Wed Feb 22 15:19:41 2023
+       @generated from src/ztrevc3_mt.cpp, normal z -> c, Sun Oct 18 05:02:18 2026
 */
-#include "thread_queue.hpp"
+#include "task_graph.hpp"
 #include "magma_timer.h"
 
-#include "magma_internal.h"  // after thread.hpp, so max, min are defined
+#include "magma_internal.h"  // after task_graph.hpp, so max, min are defined
 
 #define COMPLEX
 
@@ -130,6 +130,47 @@ private:
 };
 
 
+// ---------------------------------------------
+// normalizes back-transformed vectors in W and copies them to V (on CPU)
+class magma_cnormalize_task: public magma_task
+{
+public:
+    magma_cnormalize_task(
+        magma_int_t in_n, magma_int_t in_ncol,
+        magmaFloatComplex *in_W, magma_int_t in_ldw,
+        magmaFloatComplex *in_V, magma_int_t in_ldv
+    ):
+        n   ( in_n    ),
+        ncol( in_ncol ),
+        W   ( in_W    ),
+        ldw ( in_ldw  ),
+        V   ( in_V    ),
+        ldv ( in_ldv  )
+    {}
+    
+    virtual void run()
+    {
+        const magma_int_t ione = 1;
+        magma_int_t ii;
+        float remax;
+        for( magma_int_t k=0; k < ncol; ++k ) {
+            ii = blasf77_icamax( &n, &W[k*ldw], &ione ) - 1;
+            remax = 1. / MAGMA_C_ABS1( W[ii + k*ldw] );
+            blasf77_csscal( &n, &remax, &W[k*ldw], &ione );
+        }
+        lapackf77_clacpy( "F", &n, &ncol, W, &ldw, V, &ldv );
+    }
+    
+private:
+    magma_int_t   n;
+    magma_int_t   ncol;
+    magmaFloatComplex *W;
+    magma_int_t   ldw;
+    magmaFloatComplex *V;
+    magma_int_t   ldv;
+};
+
+
 /***************************************************************************//**
     Purpose
     -------
@@ -387,21 +428,24 @@ magma_int_t magma_ctrevc3_mt(
     }
 
     // launch threads -- each single-threaded MKL
-    magma_int_t nthread = magma_get_parallel_numthreads();
-    magma_int_t lapack_nthread = magma_get_lapack_numthreads();
+    magma_thread_budget_t budget;
+    magma_int_t nthread = magma_thread_budget_acquire( -1, &budget );
     magma_set_lapack_numthreads( 1 );
-    magma_thread_queue queue;
-    queue.launch( nthread );
-    //printf( "nthread %lld, %lld\n", (long long) nthread, (long long) lapack_nthread );
+    magma_task_graph graph;
+    graph.launch( nthread );
     
-    // gemm_nb = N/thread, rounded up to multiple of 16,
-    // but avoid multiples of page size, e.g., 512*8 bytes = 4096.
-    magma_int_t gemm_nb = magma_roundup( magma_ceildiv( n, nthread ), 16 );
-    if ( gemm_nb % 512 == 0 ) {
-        gemm_nb += 32;
-    }
+    // gemm_nb is about N/thread, see magma_get_trevc3_gemm_nb
+    magma_int_t gemm_nb = magma_get_trevc3_gemm_nb( n, nthread );
     
-    magma_timer_t time_total=0, time_trsv=0, time_gemm=0, time_gemv=0, time_trsv_sum=0, time_gemm_sum=0, time_gemv_sum=0;
+    // Tasks declare the columns of work they access, so the graph orders
+    // each solve after the GEMM that last read its column, and each GEMM
+    // after the solves of its block, without barriers in between.
+    // Column k of the solves is region work(0,k); block row i of the GEMM
+    // output is region work(i,nb+1). The master acquires a column before
+    // it writes the right-hand side there.
+    std::vector< magma_task_dep > deps( max( nb, magma_ceildiv( n, gemm_nb )) + 1 );
+    
+    magma_timer_t time_total=0, time_trsv=0, time_gemv=0, time_trsv_sum=0, time_gemv_sum=0;
     timer_start( time_total );
 
     if ( rightv ) {
@@ -428,6 +472,7 @@ magma_int_t magma_ctrevc3_mt(
 
             // --------------------------------------------------------
             // Complex right eigenvector
+            graph.acquire({ magma_write( work(0,iv) ) });
             *work(ki,iv) = c_one;
 
             // Form right-hand side.
@@ -438,17 +483,18 @@ magma_int_t magma_ctrevc3_mt(
             // Solve upper triangular system:
             // [ T(1:ki-1,1:ki-1) - T(ki,ki) ]*X = scale*work.
             if ( ki > 0 ) {
-                queue.push_task( new magma_clatrsd_task(
+                graph.insert_task( new magma_clatrsd_task(
                     MagmaUpper, MagmaNoTrans, MagmaNonUnit, MagmaTrue,
                     ki, T, ldt, *T(ki,ki),
-                    work(0,iv), work(ki,iv), rwork ));
+                    work(0,iv), work(ki,iv), rwork ),
+                    { magma_write( work(0,iv) ) });
             }
 
             // Copy the vector x or Q*x to VR and normalize.
             if ( ! over ) {
                 // ------------------------------
                 // no back-transform: copy x to VR and normalize
-                queue.sync();
+                graph.acquire({ magma_read( work(0,iv) ) });
                 n2 = ki+1;
                 blasf77_ccopy( &n2, work(0,iv), &ione, VR(0,is), &ione );
 
@@ -463,7 +509,7 @@ magma_int_t magma_ctrevc3_mt(
             else if ( version == 1 ) {
                 // ------------------------------
                 // version 1: back-transform each vector with GEMV, Q*x.
-                queue.sync();
+                graph.acquire({ magma_read( work(0,iv) ) });
                 time_trsv_sum += timer_stop( time_trsv );
                 timer_start( time_gemv );
                 if ( ki > 0 ) {
@@ -490,34 +536,35 @@ magma_int_t magma_ctrevc3_mt(
                 // When the number of vectors stored reaches nb,
                 // or if this was last vector, do the GEMM
                 if ( (iv == 1) || (ki == 0) ) {
-                    queue.sync();
-                    time_trsv_sum += timer_stop( time_trsv );
-                    timer_start( time_gemm );
                     nb2 = nb-iv+1;
                     n2  = ki+nb-iv+1;
                     
-                    // split gemm into multiple tasks, each doing one block row
+                    // split gemm into multiple tasks, each doing one block row;
+                    // each reads columns iv:nb and writes its block row
+                    for( k = iv; k <= nb; ++k ) {
+                        deps[ k-iv ] = magma_read( work(0,k) );
+                    }
                     for( i=0; i < n; i += gemm_nb ) {
                         magma_int_t ib = min( gemm_nb, n-i );
-                        queue.push_task( new cgemm_task(
+                        deps[ nb2 ] = magma_write( work(i,nb+1) );
+                        graph.insert_task( new cgemm_task(
                             MagmaNoTrans, MagmaNoTrans, ib, nb2, n2, c_one,
                             VR(i,0), ldvr,
                             work(0,iv   ), n, c_zero,
-                            work(i,nb+iv), n ));
+                            work(i,nb+iv), n ),
+                            nb2+1, &deps[0] );
                     }
-                    queue.sync();
-                    time_gemm_sum += timer_stop( time_gemm );
                     
-                    // normalize vectors
+                    // normalize vectors, after all block rows
                     // TODO if somev, should copy vectors individually to correct location.
-                    for( k = iv; k <= nb; ++k ) {
-                        ii = blasf77_icamax( &n, work(0,nb+k), &ione ) - 1;
-                        remax = 1. / MAGMA_C_ABS1( *work(ii,nb+k) );
-                        blasf77_csscal( &n, &remax, work(0,nb+k), &ione );
+                    k = 0;
+                    for( i=0; i < n; i += gemm_nb ) {
+                        deps[ k++ ] = magma_write( work(i,nb+1) );
                     }
-                    lapackf77_clacpy( "F", &n, &nb2, work(0,nb+iv), &n, VR(0,ki), &ldvr );
+                    graph.insert_task( new magma_cnormalize_task(
+                        n, nb2, work(0,nb+iv), n, VR(0,ki), ldvr ),
+                        k, &deps[0] );
                     iv = nb;
-                    timer_start( time_trsv );
                 }
                 else {
                     iv -= 1;
@@ -527,11 +574,12 @@ magma_int_t magma_ctrevc3_mt(
             is -= 1;
         }
     }
-    timer_stop( time_trsv );
+    graph.wait();
+    time_trsv_sum += timer_stop( time_trsv );
     
     timer_stop( time_total );
-    timer_printf( "trevc trsv %.4f, gemm %.4f, gemv %.4f, total %.4f\n",
-                  time_trsv_sum, time_gemm_sum, time_gemv_sum, time_total );
+    timer_printf( "trevc trsv+gemm %.4f, gemv %.4f, total %.4f\n",
+                  time_trsv_sum, time_gemv_sum, time_total );
 
     if ( leftv ) {
         // ============================================================
@@ -552,6 +600,7 @@ magma_int_t magma_ctrevc3_mt(
         
             // --------------------------------------------------------
             // Complex left eigenvector
+            graph.acquire({ magma_write( work(0,iv) ) });
             *work(ki,iv) = c_one;
         
             // Form right-hand side.
@@ -564,17 +613,18 @@ magma_int_t magma_ctrevc3_mt(
             // TODO what happens with T(k,k) - lambda is small? Used to have < smin test.
             if ( ki < n-1 ) {
                 n2 = n-ki-1;
-                queue.push_task( new magma_clatrsd_task(
+                graph.insert_task( new magma_clatrsd_task(
                     MagmaUpper, MagmaConjTrans, MagmaNonUnit, MagmaTrue,
                     n2, T(ki+1,ki+1), ldt, *T(ki,ki),
-                    work(ki+1,iv), work(ki,iv), rwork ));
+                    work(ki+1,iv), work(ki,iv), rwork ),
+                    { magma_write( work(0,iv) ) });
             }
             
             // Copy the vector x or Q*x to VL and normalize.
             if ( ! over ) {
                 // ------------------------------
                 // no back-transform: copy x to VL and normalize
-                queue.sync();
+                graph.acquire({ magma_read( work(0,iv) ) });
                 n2 = n-ki;
                 blasf77_ccopy( &n2, work(ki,iv), &ione, VL(ki,is), &ione );
         
@@ -589,7 +639,7 @@ magma_int_t magma_ctrevc3_mt(
             else if ( version == 1 ) {
                 // ------------------------------
                 // version 1: back-transform each vector with GEMV, Q*x.
-                queue.sync();
+                graph.acquire({ magma_read( work(0,iv) ) });
                 if ( ki < n-1 ) {
                     n2 = n-ki-1;
                     blasf77_cgemv( "n", &n, &n2, &c_one,
@@ -614,26 +664,31 @@ magma_int_t magma_ctrevc3_mt(
                 // When the number of vectors stored reaches nb,
                 // or if this was last vector, do the GEMM
                 if ( (iv == nb) || (ki == n-1) ) {
-                    queue.sync();
                     n2 = n-(ki+1)+iv;
                     
-                    // split gemm into multiple tasks, each doing one block row
+                    // split gemm into multiple tasks, each doing one block row;
+                    // each reads columns 1:iv and writes its block row
+                    for( k=1; k <= iv; ++k ) {
+                        deps[ k-1 ] = magma_read( work(0,k) );
+                    }
                     for( i=0; i < n; i += gemm_nb ) {
                         magma_int_t ib = min( gemm_nb, n-i );
-                        queue.push_task( new cgemm_task(
+                        deps[ iv ] = magma_write( work(i,nb+1) );
+                        graph.insert_task( new cgemm_task(
                             MagmaNoTrans, MagmaNoTrans, ib, iv, n2, c_one,
                             VL(i,ki-iv+1), ldvl,
                             work(ki-iv+1,1), n, c_zero,
-                            work(i,nb+1), n ));
+                            work(i,nb+1), n ),
+                            iv+1, &deps[0] );
                     }
-                    queue.sync();
-                    // normalize vectors
-                    for( k=1; k <= iv; ++k ) {
-                        ii = blasf77_icamax( &n, work(0,nb+k), &ione ) - 1;
-                        remax = 1. / MAGMA_C_ABS1( *work(ii,nb+k) );
-                        blasf77_csscal( &n, &remax, work(0,nb+k), &ione );
+                    // normalize vectors, after all block rows
+                    k = 0;
+                    for( i=0; i < n; i += gemm_nb ) {
+                        deps[ k++ ] = magma_write( work(i,nb+1) );
                     }
-                    lapackf77_clacpy( "F", &n, &iv, work(0,nb+1), &n, VL(0,ki-iv+1), &ldvl );
+                    graph.insert_task( new magma_cnormalize_task(
+                        n, iv, work(0,nb+1), n, VL(0,ki-iv+1), ldvl ),
+                        k, &deps[0] );
                     iv = 1;
                 }
                 else {
@@ -646,8 +701,8 @@ magma_int_t magma_ctrevc3_mt(
     }
     
     // close down threads
-    queue.quit();
-    magma_set_lapack_numthreads( lapack_nthread );
+    graph.quit();
+    magma_thread_budget_release( &budget );
     
     return *info;
 }  // End of CTREVC
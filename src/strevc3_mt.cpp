@@ -8,12 +8,12 @@
        @author Mark Gates
        @author Azzam Haidar
 
-       @generated from src/dtrevc3_mt.cpp, normal d -> s, Wed Feb 22 15:19:41 2023
+       @generated from src/dtrevc3_mt.cpp, normal d -> s, Sun Oct 18 05:02:18 2026
 */
-#include "thread_queue.hpp"
+#include "task_graph.hpp"
 #include "magma_timer.h"
 
-#include "magma_internal.h"  // after thread.hpp, so max, min are defined
+#include "magma_internal.h"  // after task_graph.hpp, so max, min are defined
 
 #define REAL
 
@@ -111,6 +111,67 @@ private:
 };
 
 
+// ---------------------------------------------
+// normalizes back-transformed vectors in W and copies them to V (on CPU).
+// iscomplex[k] is 0 for a real eigenvector,
+// 1 and -1 for the first and second vectors of a conjugate pair.
+class magma_snormalize_task: public magma_task
+{
+public:
+    magma_snormalize_task(
+        magma_int_t in_n, magma_int_t in_ncol,
+        const magma_int_t *in_iscomplex,
+        float *in_W, magma_int_t in_ldw,
+        float *in_V, magma_int_t in_ldv
+    ):
+        n        ( in_n    ),
+        ncol     ( in_ncol ),
+        iscomplex( in_iscomplex, in_iscomplex + in_ncol ),
+        W        ( in_W    ),
+        ldw      ( in_ldw  ),
+        V        ( in_V    ),
+        ldv      ( in_ldv  )
+    {}
+    
+    virtual void run()
+    {
+        const magma_int_t ione = 1;
+        magma_int_t ii;
+        float emax, remax = 1;
+        for( magma_int_t k=0; k < ncol; ++k ) {
+            if ( iscomplex[k] == 0 ) {
+                // real eigenvector
+                ii = blasf77_isamax( &n, &W[k*ldw], &ione ) - 1;  // subtract 1; ii is 0-based
+                remax = 1. / fabsf( W[ii + k*ldw] );
+            }
+            else if ( iscomplex[k] == 1 ) {
+                // first eigenvector of conjugate pair
+                emax = 0.;
+                for( ii=0; ii < n; ++ii ) {
+                    emax = max( emax, fabsf( W[ii + k*ldw] )
+                                    + fabsf( W[ii + (k+1)*ldw] ) );
+                }
+                remax = 1. / emax;
+            // else if iscomplex[k] == -1
+            //     second eigenvector of conjugate pair
+            //     reuse same remax as previous k
+            }
+            blasf77_sscal( &n, &remax, &W[k*ldw], &ione );
+        }
+        lapackf77_slacpy( "F", &n, &ncol, W, &ldw, V, &ldv );
+    }
+    
+private:
+    magma_int_t   n;
+    magma_int_t   ncol;
+    std::vector< magma_int_t > iscomplex;
+    float       *W;
+    magma_int_t   ldw;
+    float       *V;
+    magma_int_t   ldv;
+};
+
+
 /***************************************************************************//**
     Purpose
     -------
@@ -372,11 +433,13 @@ magma_int_t magma_strevc3_mt(
         return *info;
     }
     
-    // Use blocked version (2) if sufficient workspace.
+    // Use blocked version (2) of back-transform if sufficient workspace.
     // Requires 1 vector for 1-norms, and 2*nb vectors for x and Q*x.
+    // As in LAPACK, only for back-transform; without it,
+    // vectors are copied to VR, VL directly.
     // Zero-out the workspace to avoid potential NaN propagation.
     nb = 2;
-    if ( lwork >= n + 2*n*nbmin ) {
+    if ( over && lwork >= n + 2*n*nbmin ) {
         version = 2;
         nb = (lwork - n) / (2*n);
         nb = min( nb, nbmax );
@@ -398,21 +461,24 @@ magma_int_t magma_strevc3_mt(
     }
         
     // launch threads -- each single-threaded MKL
-    magma_int_t nthread = magma_get_parallel_numthreads();
-    magma_int_t lapack_nthread = magma_get_lapack_numthreads();
+    magma_thread_budget_t budget;
+    magma_int_t nthread = magma_thread_budget_acquire( -1, &budget );
     magma_set_lapack_numthreads( 1 );
-    magma_thread_queue queue;
-    queue.launch( nthread );
-    //printf( "nthread %lld, %lld\n", (long long) nthread, (long long) lapack_nthread );
+    magma_task_graph graph;
+    graph.launch( nthread );
     
-    // gemm_nb = N/thread, rounded up to multiple of 16,
-    // but avoid multiples of page size, e.g., 512*8 bytes = 4096.
-    magma_int_t gemm_nb = magma_roundup( magma_ceildiv( n, nthread ), 16 );
-    if ( gemm_nb % 512 == 0 ) {
-        gemm_nb += 32;
-    }
+    // gemm_nb is about N/thread, see magma_get_trevc3_gemm_nb
+    magma_int_t gemm_nb = magma_get_trevc3_gemm_nb( n, nthread );
+    
+    // Tasks declare the columns of work they access, so the graph orders
+    // each solve after the GEMM that last read its column, and each GEMM
+    // after the solves of its block, without barriers in between.
+    // Column k of the solves is region work(0,k); block row i of the GEMM
+    // output is region work(i,nb+1). The master acquires columns before
+    // it writes them.
+    std::vector< magma_task_dep > deps( max( nb, magma_ceildiv( n, gemm_nb )) + 1 );
     
-    magma_timer_t time_total=0, time_trsv=0, time_gemm=0, time_gemv=0, time_trsv_sum=0, time_gemm_sum=0, time_gemv_sum=0;
+    magma_timer_t time_total=0, time_trsv=0, time_gemv=0, time_trsv_sum=0, time_gemv_sum=0;
     timer_start( time_total );
 
     // Index ip is used to specify the real or complex eigenvalue:
@@ -474,14 +540,16 @@ magma_int_t magma_strevc3_mt(
                 // Real right eigenvector
                 // Solve upper quasi-triangular system:
                 // [ T(0:ki-1,0:ki-1) - wr ]*X = -T(0:ki-1,ki)
-                queue.push_task( new magma_slaqtrsd_task(
-                    MagmaNoTrans, ki+1, T(0,0), ldt, work(0,iv), n, work(0,0) ));
+                graph.acquire({ magma_write( work(0,iv) ) });
+                graph.insert_task( new magma_slaqtrsd_task(
+                    MagmaNoTrans, ki+1, T(0,0), ldt, work(0,iv), n, work(0,0) ),
+                    { magma_write( work(0,iv) ) });
                 
                 // Copy the vector x or Q*x to VR and normalize.
                 if ( ! over ) {
                     // ------------------------------
                     // no back-transform: copy x to VR and normalize.
-                    queue.sync();
+                    graph.acquire({ magma_read( work(0,iv) ) });
                     n2 = ki+1;
                     blasf77_scopy( &n2, work(0,iv), &ione, VR(0,is), &ione );
 
@@ -496,7 +564,7 @@ magma_int_t magma_strevc3_mt(
                 else if ( version == 1 ) {
                     // ------------------------------
                     // version 1: back-transform each vector with GEMV, Q*x.
-                    queue.sync();
+                    graph.acquire({ magma_read( work(0,iv) ) });
                     time_trsv_sum += timer_stop( time_trsv );
                     timer_start( time_gemv );
                     if ( ki > 0 ) {
@@ -528,14 +596,16 @@ magma_int_t magma_strevc3_mt(
                 // Complex right eigenvector
                 // Solve upper quasi-triangular system:
                 // [ T(0:ki-2,0:ki-2) - (wr+i*wi) ]*x = u
-                queue.push_task( new magma_slaqtrsd_task(
-                    MagmaNoTrans, ki+1, T(0,0), ldt, work(0,iv-1), n, work(0,0) ));
+                graph.acquire({ magma_write( work(0,iv-1) ), magma_write( work(0,iv) ) });
+                graph.insert_task( new magma_slaqtrsd_task(
+                    MagmaNoTrans, ki+1, T(0,0), ldt, work(0,iv-1), n, work(0,0) ),
+                    { magma_write( work(0,iv-1) ), magma_write( work(0,iv) ) });
 
                 // Copy the vector x or Q*x to VR and normalize.
                 if ( ! over ) {
                     // ------------------------------
                     // no back-transform: copy x to VR and normalize.
-                    queue.sync();
+                    graph.acquire({ magma_read( work(0,iv-1) ), magma_read( work(0,iv) ) });
                     n2 = ki+1;
                     blasf77_scopy( &n2, work(0,iv-1), &ione, VR(0,is-1), &ione );
                     blasf77_scopy( &n2, work(0,iv  ), &ione, VR(0,is  ), &ione );
@@ -556,7 +626,7 @@ magma_int_t magma_strevc3_mt(
                 else if ( version == 1 ) {
                     // ------------------------------
                     // version 1: back-transform each vector with GEMV, Q*x.
-                    queue.sync();
+                    graph.acquire({ magma_read( work(0,iv-1) ), magma_read( work(0,iv) ) });
                     time_trsv_sum += timer_stop( time_trsv );
                     timer_start( time_gemv );
                     if ( ki > 1 ) {
@@ -615,52 +685,35 @@ magma_int_t magma_strevc3_mt(
                 // When the number of vectors stored reaches nb-1 or nb,
                 // or if this was last vector, do the GEMM
                 if ( (iv <= 2) || (ki2 == 0) ) {
-                    queue.sync();
-                    time_trsv_sum += timer_stop( time_trsv );
-                    timer_start( time_gemm );
                     nb2 = nb-iv+1;
                     n2  = ki2+nb-iv+1;
                     
-                    // split gemm into multiple tasks, each doing one block row
+                    // split gemm into multiple tasks, each doing one block row;
+                    // each reads columns iv:nb and writes its block row
+                    for( k=iv; k <= nb; ++k ) {
+                        deps[ k-iv ] = magma_read( work(0,k) );
+                    }
                     for( i=0; i < n; i += gemm_nb ) {
                         magma_int_t ib = min( gemm_nb, n-i );
-                        queue.push_task( new sgemm_task(
+                        deps[ nb2 ] = magma_write( work(i,nb+1) );
+                        graph.insert_task( new sgemm_task(
                             MagmaNoTrans, MagmaNoTrans, ib, nb2, n2, c_one,
                             VR(i,0), ldvr,
                             work(0,iv), n, c_zero,
-                            work(i,nb+iv), n ));
+                            work(i,nb+iv), n ),
+                            nb2+1, &deps[0] );
                     }
-                    queue.sync();
-                    time_gemm_sum += timer_stop( time_gemm );
 
-                    // normalize vectors
+                    // normalize vectors, after all block rows
                     // TODO if somev, should copy vectors individually to correct location.
-                    for( k=iv; k <= nb; ++k ) {
-                        if ( iscomplex[k] == 0 ) {
-                            // real eigenvector
-                            ii = blasf77_isamax( &n, work(0,nb+k), &ione ) - 1;  // subtract 1; ii is 0-based
-                            remax = c_one / fabsf( *work(ii,nb+k) );
-                        }
-                        else if ( iscomplex[k] == 1 ) {
-                            // first eigenvector of conjugate pair
-                            emax = c_zero;
-                            for( ii=0; ii < n; ++ii ) {
-                                emax = max( emax, fabsf( *work(ii,nb+k  ) )
-                                                + fabsf( *work(ii,nb+k+1) ) );
-                            }
-                            remax = c_one / emax;
-                        // else if iscomplex[k] == -1
-                        //     second eigenvector of conjugate pair
-                        //     reuse same remax as previous k
-                        }
-                        blasf77_sscal( &n, &remax, work(0,nb+k), &ione );
+                    k = 0;
+                    for( i=0; i < n; i += gemm_nb ) {
+                        deps[ k++ ] = magma_write( work(i,nb+1) );
                     }
-                    nb2 = nb-iv+1;
-                    lapackf77_slacpy( "F", &n, &nb2,
-                                      work(0,nb+iv), &n,
-                                      VR(0,ki2), &ldvr );
+                    graph.insert_task( new magma_snormalize_task(
+                        n, nb2, &iscomplex[iv], work(0,nb+iv), n, VR(0,ki2), ldvr ),
+                        k, &deps[0] );
                     iv = nb;
-                    timer_start( time_trsv );
                 }
                 else {
                     iv -= 1;
@@ -673,11 +726,12 @@ magma_int_t magma_strevc3_mt(
             }
         }
     }
-    timer_stop( time_trsv );
+    graph.wait();
+    time_trsv_sum += timer_stop( time_trsv );
     
     timer_stop( time_total );
-    timer_printf( "trevc trsv %.4f, gemm %.4f, gemv %.4f, total %.4f\n",
-                  time_trsv_sum, time_gemm_sum, time_gemv_sum, time_total );
+    timer_printf( "trevc trsv+gemm %.4f, gemv %.4f, total %.4f\n",
+                  time_trsv_sum, time_gemv_sum, time_total );
 
     if ( leftv ) {
         // ============================================================
@@ -721,14 +775,16 @@ magma_int_t magma_strevc3_mt(
                 // Real left eigenvector
                 // Solve transposed quasi-triangular system:
                 // [ T(ki+1:n,ki+1:n) - wr ]**T * X = -T(ki+1:n,ki)
-                queue.push_task( new magma_slaqtrsd_task(
-                    MagmaTrans, n-ki, T(ki,ki), ldt, work(ki,iv), n, work(ki,0) ));
+                graph.acquire({ magma_write( work(0,iv) ) });
+                graph.insert_task( new magma_slaqtrsd_task(
+                    MagmaTrans, n-ki, T(ki,ki), ldt, work(ki,iv), n, work(ki,0) ),
+                    { magma_write( work(0,iv) ) });
     
                 // Copy the vector x or Q*x to VL and normalize.
                 if ( ! over ) {
                     // ------------------------------
                     // no back-transform: copy x to VL and normalize.
-                    queue.sync();
+                    graph.acquire({ magma_read( work(0,iv) ) });
                     n2 = n-ki;
                     blasf77_scopy( &n2, work(ki,iv), &ione, VL(ki,is), &ione );
     
@@ -743,7 +799,7 @@ magma_int_t magma_strevc3_mt(
                 else if ( version == 1 ) {
                     // ------------------------------
                     // version 1: back-transform each vector with GEMV, Q*x.
-                    queue.sync();
+                    graph.acquire({ magma_read( work(0,iv) ) });
                     if ( ki < n-1 ) {
                         n2 = n-ki-1;
                         blasf77_sgemv( "n", &n, &n2, &c_one,
@@ -772,14 +828,16 @@ magma_int_t magma_strevc3_mt(
                 // Complex left eigenvector
                 // Solve transposed quasi-triangular system:
                 // [ T(ki+2:n,ki+2:n)**T - (wr-i*wi) ]*X = V
-                queue.push_task( new magma_slaqtrsd_task(
-                    MagmaTrans, n-ki, T(ki,ki), ldt, work(ki,iv), n, work(ki,0) ));
+                graph.acquire({ magma_write( work(0,iv) ), magma_write( work(0,iv+1) ) });
+                graph.insert_task( new magma_slaqtrsd_task(
+                    MagmaTrans, n-ki, T(ki,ki), ldt, work(ki,iv), n, work(ki,0) ),
+                    { magma_write( work(0,iv) ), magma_write( work(0,iv+1) ) });
     
                 // Copy the vector x or Q*x to VL and normalize.
                 if ( ! over ) {
                     // ------------------------------
                     // no back-transform: copy x to VL and normalize.
-                    queue.sync();
+                    graph.acquire({ magma_read( work(0,iv) ), magma_read( work(0,iv+1) ) });
                     n2 = n-ki;
                     blasf77_scopy( &n2, work(ki,iv  ), &ione, VL(ki,is  ), &ione );
                     blasf77_scopy( &n2, work(ki,iv+1), &ione, VL(ki,is+1), &ione );
@@ -800,7 +858,7 @@ magma_int_t magma_strevc3_mt(
                 else if ( version == 1 ) {
                     // ------------------------------
                     // version 1: back-transform each vector with GEMV, Q*x.
-                    queue.sync();
+                    graph.acquire({ magma_read( work(0,iv) ), magma_read( work(0,iv+1) ) });
                     if ( ki < n-2 ) {
                         n2 = n-ki-2;
                         blasf77_sgemv( "n", &n, &n2, &c_one,
@@ -856,43 +914,31 @@ magma_int_t magma_strevc3_mt(
                 // When the number of vectors stored reaches nb-1 or nb,
                 // or if this was last vector, do the GEMM
                 if ( (iv >= nb-1) || (ki2 == n-1) ) {
-                    queue.sync();
                     n2 = n-(ki2+1)+iv;
                     
-                    // split gemm into multiple tasks, each doing one block row
+                    // split gemm into multiple tasks, each doing one block row;
+                    // each reads columns 1:iv and writes its block row
+                    for( k=1; k <= iv; ++k ) {
+                        deps[ k-1 ] = magma_read( work(0,k) );
+                    }
                     for( i=0; i < n; i += gemm_nb ) {
                         magma_int_t ib = min( gemm_nb, n-i );
-                        queue.push_task( new sgemm_task(
+                        deps[ iv ] = magma_write( work(i,nb+1) );
+                        graph.insert_task( new sgemm_task(
                             MagmaNoTrans, MagmaNoTrans, ib, iv, n2, c_one,
                             VL(i,ki2-iv+1), ldvl,
                             work(ki2-iv+1,1), n, c_zero,
-                            work(i,nb+1), n ));
+                            work(i,nb+1), n ),
+                            iv+1, &deps[0] );
                     }
-                    queue.sync();
-                    // normalize vectors
-                    for( k=1; k <= iv; ++k ) {
-                        if ( iscomplex[k] == 0 ) {
-                            // real eigenvector
-                            ii = blasf77_isamax( &n, work(0,nb+k), &ione ) - 1;  // subtract 1; ii is 0-based
-                            remax = c_one / fabsf( *work(ii,nb+k) );
-                        }
-                        else if ( iscomplex[k] == 1) {
-                            // first eigenvector of conjugate pair
-                            emax = c_zero;
-                            for( ii=0; ii < n; ++ii ) {
-                                emax = max( emax, fabsf( *work(ii,nb+k  ) )
-                                                + fabsf( *work(ii,nb+k+1) ) );
-                            }
-                            remax = c_one / emax;
-                        // else if iscomplex[k] == -1
-                        //     second eigenvector of conjugate pair
-                        //     reuse same remax as previous k
-                        }
-                        blasf77_sscal( &n, &remax, work(0,nb+k), &ione );
+                    // normalize vectors, after all block rows
+                    k = 0;
+                    for( i=0; i < n; i += gemm_nb ) {
+                        deps[ k++ ] = magma_write( work(i,nb+1) );
                     }
-                    lapackf77_slacpy( "F", &n, &iv,
-                                      work(0,nb+1), &n,
-                                      VL(0,ki2-iv+1), &ldvl );
+                    graph.insert_task( new magma_snormalize_task(
+                        n, iv, &iscomplex[1], work(0,nb+1), n, VL(0,ki2-iv+1), ldvl ),
+                        k, &deps[0] );
                     iv = 1;
                 }
                 else {
@@ -908,8 +954,8 @@ magma_int_t magma_strevc3_mt(
     }
     
     // close down threads
-    queue.quit();
-    magma_set_lapack_numthreads( lapack_nthread );
+    graph.quit();
+    magma_thread_budget_release( &budget );
     
     return *info;
 }  // end of STREVC3
@@ -0,0 +1,289 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Mark Gates
+
+       @generated from testing/testing_ztune_cpu.cpp, normal z -> c, Sun Oct 18 06:55:49 2026
+
+*/
+
+// includes, system
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// includes, project
+#include "magma_v2.h"
+#include "magma_lapack.h"
+#include "testings.h"
+#include "../control/magma_threadsetting.h"  // internal header
+#include "../control/magma_tune.h"           // internal header
+
+#define COMPLEX
+
+
+/******************************************************************************/
+// Time of cheevdx_2stage on A, with the current tuning; min over niter runs.
+// Workspace is queried each time, as it depends on magma_get_cbulge_nb.
+static real_Double_t time_eig(
+    magma_opts& opts, magma_int_t N, magmaFloatComplex* h_A, magma_int_t lda )
+{
+    magmaFloatComplex *h_R, *h_work;
+    #ifdef COMPLEX
+    float *rwork;
+    magma_int_t lrwork;
+    #endif
+    float *w;
+    magma_int_t *iwork;
+    magma_int_t lwork, liwork, Nfound, info;
+    magma_int_t threads = magma_get_parallel_numthreads();
+
+    magma_cheevdx_getworksize( N, threads, (opts.jobz == MagmaVec),
+                               &lwork,
+                               #ifdef COMPLEX
+                               &lrwork,
+                               #endif
+                               &liwork );
+
+    TESTING_CHECK( magma_smalloc_cpu( &w,     N      ));
+    TESTING_CHECK( magma_imalloc_cpu( &iwork, liwork ));
+    TESTING_CHECK( magma_cmalloc_pinned( &h_R,    lda*N ));
+    TESTING_CHECK( magma_cmalloc_pinned( &h_work, lwork ));
+    #ifdef COMPLEX
+    TESTING_CHECK( magma_smalloc_pinned( &rwork, lrwork ));
+    #endif
+
+    real_Double_t time = -1;
+    for( int iter = 0; iter < opts.niter; ++iter ) {
+        lapackf77_clacpy( MagmaFullStr, &N, &N, h_A, &lda, h_R, &lda );
+        real_Double_t t = magma_wtime();
+        magma_cheevdx_2stage( opts.jobz, MagmaRangeAll, opts.uplo, N,
+                              h_R, lda,
+                              0, 0, 0, 0,
+                              &Nfound, w,
+                              h_work, lwork,
+                              #ifdef COMPLEX
+                              rwork, lrwork,
+                              #endif
+                              iwork, liwork,
+                              &info );
+        t = magma_wtime() - t;
+        if (info != 0) {
+            printf("magma_cheevdx_2stage returned error %lld: %s.\n",
+                   (long long) info, magma_strerror( info ));
+        }
+        if ( time < 0 || t < time ) {
+            time = t;
+        }
+    }
+
+    magma_free_cpu( w     );
+    magma_free_cpu( iwork );
+    magma_free_pinned( h_R    );
+    magma_free_pinned( h_work );
+    #ifdef COMPLEX
+    magma_free_pinned( rwork );
+    #endif
+    return time;
+}
+
+
+/******************************************************************************/
+// Time of ctrevc3_mt back-transforming the eigenvectors of upper triangular T,
+// with the current tuning; min over niter runs.
+static real_Double_t time_trevc(
+    magma_opts& opts, magma_int_t N, magmaFloatComplex* T, magma_int_t ldt )
+{
+    const magmaFloatComplex c_zero = MAGMA_C_ZERO;
+    const magmaFloatComplex c_one  = MAGMA_C_ONE;
+
+    magmaFloatComplex *VR, *work;
+    #ifdef COMPLEX
+    float *rwork;
+    #endif
+    magma_int_t mout, info;
+    magma_int_t ldvr  = ldt;
+    magma_int_t lwork = N + 2*N*256;  // largest nb in trevc3_mt
+
+    TESTING_CHECK( magma_cmalloc_cpu( &VR,   ldvr*N ));
+    TESTING_CHECK( magma_cmalloc_cpu( &work, lwork  ));
+    #ifdef COMPLEX
+    TESTING_CHECK( magma_smalloc_cpu( &rwork, N ));
+    #endif
+
+    real_Double_t time = -1;
+    for( int iter = 0; iter < opts.niter; ++iter ) {
+        lapackf77_claset( "F", &N, &N, &c_zero, &c_one, VR, &ldvr );
+        real_Double_t t = magma_wtime();
+        magma_ctrevc3_mt( MagmaRight, MagmaBacktransVec, NULL, N,
+                          T, ldt, NULL, 1, VR, ldvr, N, &mout,
+                          work, lwork,
+                          #ifdef COMPLEX
+                          rwork,
+                          #endif
+                          &info );
+        t = magma_wtime() - t;
+        if (info != 0) {
+            printf("magma_ctrevc3_mt returned error %lld: %s.\n",
+                   (long long) info, magma_strerror( info ));
+        }
+        if ( time < 0 || t < time ) {
+            time = t;
+        }
+    }
+
+    magma_free_cpu( VR   );
+    magma_free_cpu( work );
+    #ifdef COMPLEX
+    magma_free_cpu( rwork );
+    #endif
+    return time;
+}
+
+
+/******************************************************************************/
+// Sets each candidate value of query name for sizes (m, n), times it,
+// and keeps the fastest in the tuning cache; device and threads as for
+// magma_tune_set.
+// The current value (cached or built-in) is timed first.
+template< typename F >
+static magma_int_t sweep(
+    const char* name, magma_int_t device, magma_int_t threads,
+    magma_int_t m, magma_int_t n, magma_int_t default_value,
+    const magma_int_t* candidates, magma_int_t ncandidates, F time_func )
+{
+    magma_int_t best = default_value;
+    real_Double_t best_time = -1;
+    for( magma_int_t i = -1; i < ncandidates; ++i ) {
+        magma_int_t value = (i < 0 ? default_value : candidates[i]);
+        if ( i >= 0 && value == default_value ) {
+            continue;
+        }
+        magma_tune_set( name, device, threads, m, n, value );
+        real_Double_t time = time_func();
+        printf( "%5lld   %-36s %6lld%s   %10.4f\n",
+                (long long) n, name, (long long) value,
+                (i < 0 ? " (current)" : "          "), time );
+        if ( best_time < 0 || time < best_time ) {
+            best = value;
+            best_time = time;
+        }
+    }
+    magma_tune_set( name, device, threads, m, n, best );
+    printf( "%5lld   %-36s %6lld   best\n", (long long) n, name, (long long) best );
+    fflush( stdout );
+    return best;
+}
+
+
+/* ////////////////////////////////////////////////////////////////////////////
+   -- Tunes the CPU-bound block sizes of cheevdx_2stage and ctrevc3_mt,
+   for the sizes given by -N, and saves them in the tuning cache,
+   $MAGMA_TUNE_CACHE (default $HOME/.magma_tune), for this CPU model
+   and number of threads ($MAGMA_NUM_THREADS); cbulge_nb and cbulge_gcperf
+   also for this GPU architecture.
+   Each candidate is timed as the min over --niter runs.
+   magma_get_smlsize_divideconquer and magma_get_cbulge_gcperf do not
+   depend on the size; they are tuned for the largest N, with -JV only.
+*/
+int main( int argc, char** argv)
+{
+    TESTING_CHECK( magma_init() );
+    magma_print_environment();
+
+    magmaFloatComplex *h_A, *T;
+    magma_int_t N, Nmax, lda, i, j;
+    magma_int_t ione = 1;
+    magma_int_t ISEED[4] = {0,0,0,1};
+    int status = 0;
+
+    magma_opts opts;
+    opts.parse_opts( argc, argv );
+
+    magma_int_t threads = magma_get_parallel_numthreads();
+    printf("%% jobz = %s, uplo = %s, threads %lld\n",
+           lapack_vec_const(opts.jobz), lapack_uplo_const(opts.uplo),
+           (long long) threads );
+
+    const magma_int_t bulge_nb[]    = { 32, 48, 64, 96, 128 };
+    const magma_int_t gemm_nb[]     = { 32, 64, 128, 256, 544 };
+    const magma_int_t smlsize[]     = { 32, 64, 128, 256 };
+    const magma_int_t gcperf[]      = { 10, 20, 37, 50, 100, 200 };
+    const magma_int_t nbulge_nb     = sizeof(bulge_nb) / sizeof(*bulge_nb);
+    const magma_int_t ngemm_nb      = sizeof(gemm_nb)  / sizeof(*gemm_nb);
+    const magma_int_t nsmlsize      = sizeof(smlsize)  / sizeof(*smlsize);
+    const magma_int_t ngcperf       = sizeof(gcperf)   / sizeof(*gcperf);
+
+    printf("%%   N   query                                 value             time (sec)\n");
+    printf("%%=========================================================================\n");
+    Nmax = 0;
+    for( int itest = 0; itest < opts.ntest; ++itest ) {
+        N   = opts.nsize[itest];
+        lda = N;
+        Nmax = max( Nmax, N );
+
+        TESTING_CHECK( magma_cmalloc_cpu( &h_A, lda*N ));
+        TESTING_CHECK( magma_cmalloc_cpu( &T,   lda*N ));
+        magma_generate_matrix( opts, N, N, h_A, lda );
+
+        // upper triangular T, as from the Schur form
+        magma_int_t n2 = lda*N;
+        lapackf77_clarnv( &ione, ISEED, &n2, T );
+        for( j=0; j < N; ++j ) {
+            for( i=j+1; i < N; ++i ) {
+                T[ i + j*lda ] = MAGMA_C_ZERO;
+            }
+        }
+
+        // warmup
+        time_eig( opts, N, h_A, lda );
+
+        sweep( "magma_get_cbulge_nb", 1, threads, 0, N,
+               magma_get_cbulge_nb( N, threads ), bulge_nb, nbulge_nb,
+               [&]() { return time_eig( opts, N, h_A, lda ); } );
+
+        sweep( "magma_get_trevc3_gemm_nb", 0, threads, 0, N,
+               magma_get_trevc3_gemm_nb( N, threads ), gemm_nb, ngemm_nb,
+               [&]() { return time_trevc( opts, N, T, lda ); } );
+
+        magma_free_cpu( h_A );
+        magma_free_cpu( T   );
+        printf( "\n" );
+    }
+
+    if ( opts.jobz == MagmaVec && Nmax > 0 ) {
+        N   = Nmax;
+        lda = N;
+        TESTING_CHECK( magma_cmalloc_cpu( &h_A, lda*N ));
+        magma_generate_matrix( opts, N, N, h_A, lda );
+
+        sweep( "magma_get_smlsize_divideconquer", 0, 0, 0, 0,
+               magma_get_smlsize_divideconquer(), smlsize, nsmlsize,
+               [&]() { return time_eig( opts, N, h_A, lda ); } );
+
+        sweep( "magma_get_cbulge_gcperf", 1, 0, 0, 0,
+               magma_get_cbulge_gcperf(), gcperf, ngcperf,
+               [&]() { return time_eig( opts, N, h_A, lda ); } );
+
+        magma_free_cpu( h_A );
+    }
+    else {
+        printf( "%% skipping size-independent queries; they need -JV\n" );
+    }
+
+    magma_int_t info = magma_tune_save();
+    if ( info != MAGMA_SUCCESS ) {
+        printf( "magma_tune_save returned error %lld: %s.\n",
+                (long long) info, magma_strerror( info ));
+        status += 1;
+    }
+
+    opts.cleanup();
+    TESTING_CHECK( magma_finalize() );
+    return status;
+}
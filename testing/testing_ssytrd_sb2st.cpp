@@ -0,0 +1,177 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Mark Gates
+
+       @generated from testing/testing_zhetrd_hb2st.cpp, normal z -> s, Sun Oct 18 04:36:44 2026
+
+*/
+
+// includes, system
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// includes, project
+#include "magma_v2.h"
+#include "magma_lapack.h"
+#include "magma_bulge.h"
+#include "testings.h"
+#include "../control/magma_threadsetting.h"  // internal header
+
+#define REAL
+
+/* ////////////////////////////////////////////////////////////////////////////
+   -- Testing ssytrd_sb2st, the band to tridiagonal reduction (2nd stage of
+   ssyevdx_2stage), which runs on the CPU only.
+   Compares with LAPACK ssbtrd; the check compares the eigenvalues of both
+   tridiagonal matrices.
+   The number of threads is $MAGMA_NUM_THREADS; the number of kernels per
+   task (grsiz) is $MAGMA_BULGE_GRSIZ, see magma_bulge_get_grsiz.
+*/
+int main( int argc, char** argv)
+{
+    TESTING_CHECK( magma_init() );
+    magma_print_environment();
+
+    real_Double_t    cpu_time, magma_time;
+    float *h_A, *h_R, *V, *TAU, *T, *work;
+    float          *diag, *offdiag, *diag_ref, *offdiag_ref;
+    float           error, wmax;
+    magma_int_t N, nb, lda, Vblksiz, ldv, ldt, blkcnt, sizTAU2, sizT2, sizV2;
+    magma_int_t i, j, ione = 1, info;
+    magma_int_t ISEED[4] = {0,0,0,1};
+    int status = 0;
+
+    magma_opts opts;
+    opts.parse_opts( argc, argv );
+
+    float tol = opts.tolerance * lapackf77_slamch("E");
+    magma_int_t threads = magma_get_parallel_numthreads();
+    magma_int_t wantz   = (opts.jobz == MagmaVec);
+
+    printf("%% jobz = %s (T's computed if vectors), threads %lld\n",
+           lapack_vec_const(opts.jobz), (long long) threads );
+    printf("%%   N    nb  grsiz   CPU ssbtrd (sec)   MAGMA sb2st (sec)   |w - w_ref| / (N |w_ref|)\n");
+    printf("%%===========================================================================\n");
+    for( int itest = 0; itest < opts.ntest; ++itest ) {
+        for( int iter = 0; iter < opts.niter; ++iter ) {
+            N  = opts.nsize[itest];
+            nb = opts.nb;
+            if ( nb <= 0 ) {
+                nb = magma_get_sbulge_nb( N, threads );
+            }
+            nb = max( 1, min( nb, N-1 ));
+            Vblksiz = magma_get_sbulge_vblksiz( N, nb, threads );
+            ldv = nb + Vblksiz;
+            ldt = Vblksiz;
+            magma_sbulge_getstg2size( N, nb, wantz, Vblksiz, ldv, ldt,
+                                      &blkcnt, &sizTAU2, &sizT2, &sizV2 );
+            magma_bulge_getlwstg1( N, nb, &lda );
+
+            TESTING_CHECK( magma_smalloc_cpu( &h_A,  lda*N ));
+            TESTING_CHECK( magma_smalloc_cpu( &h_R,  lda*N ));
+            TESTING_CHECK( magma_smalloc_cpu( &V,    max( 1, sizV2   )));
+            TESTING_CHECK( magma_smalloc_cpu( &TAU,  max( 1, sizTAU2 )));
+            TESTING_CHECK( magma_smalloc_cpu( &T,    max( 1, sizT2   )));
+            TESTING_CHECK( magma_smalloc_cpu( &work, N ));
+            TESTING_CHECK( magma_smalloc_cpu( &diag,        N ));
+            TESTING_CHECK( magma_smalloc_cpu( &offdiag,     N ));
+            TESTING_CHECK( magma_smalloc_cpu( &diag_ref,    N ));
+            TESTING_CHECK( magma_smalloc_cpu( &offdiag_ref, N ));
+
+            /* ====================================================================
+               Initialize the matrix: random symmetric band of width nb,
+               in lower band storage, A(i,j) = h_A[ (i-j) + j*lda ]
+               =================================================================== */
+            memset( h_A, 0, lda*N*sizeof(float) );
+            for( j=0; j < N; ++j ) {
+                magma_int_t len = min( nb+1, N-j );
+                lapackf77_slarnv( &ione, ISEED, &len, &h_A[ j*lda ] );
+                h_A[ j*lda ] = MAGMA_S_MAKE( MAGMA_S_REAL( h_A[ j*lda ] ), 0. );
+            }
+            lapackf77_slacpy( MagmaFullStr, &lda, &N, h_A, &lda, h_R, &lda );
+
+            /* ====================================================================
+               Performs operation using MAGMA
+               =================================================================== */
+            magma_time = magma_wtime();
+            magma_ssytrd_sb2st( MagmaLower, N, nb, Vblksiz, h_R, lda, diag, offdiag,
+                                V, ldv, TAU, wantz, T, ldt );
+            magma_time = magma_wtime() - magma_time;
+
+            /* =====================================================================
+               Performs operation using LAPACK
+               =================================================================== */
+            if ( opts.lapack || opts.check ) {
+                lapackf77_slacpy( MagmaFullStr, &lda, &N, h_A, &lda, h_R, &lda );
+                cpu_time = magma_wtime();
+                lapackf77_ssbtrd( "N", "L", &N, &nb, h_R, &lda, diag_ref, offdiag_ref,
+                                  NULL, &ione, work, &info );
+                cpu_time = magma_wtime() - cpu_time;
+                if (info != 0) {
+                    printf("lapackf77_ssbtrd returned error %lld: %s.\n",
+                           (long long) info, magma_strerror( info ));
+                }
+            }
+
+            /* =====================================================================
+               Check the result: both tridiagonals have the eigenvalues of A
+               =================================================================== */
+            if ( opts.check ) {
+                lapackf77_ssterf( &N, diag,     offdiag,     &info );
+                lapackf77_ssterf( &N, diag_ref, offdiag_ref, &info );
+                error = 0.;
+                wmax  = 0.;
+                for( i=0; i < N; ++i ) {
+                    error = max( error, fabs( diag[i] - diag_ref[i] ));
+                    wmax  = max( wmax,  fabs( diag_ref[i] ));
+                }
+                error /= N * wmax;
+            }
+
+            /* =====================================================================
+               Print performance and error.
+               =================================================================== */
+            printf("%5lld %5lld  %5lld", (long long) N, (long long) nb,
+                   (long long) magma_bulge_get_grsiz( N, nb, threads ));
+            if ( opts.lapack ) {
+                printf("   %16.4f", cpu_time );
+            } else {
+                printf("   %16s", "---" );
+            }
+            printf("   %17.4f", magma_time );
+            if ( opts.check ) {
+                printf("   %8.2e   %s\n", error, (error < tol ? "ok" : "failed") );
+                status += ! (error < tol);
+            } else {
+                printf("     ---\n");
+            }
+
+            magma_free_cpu( h_A  );
+            magma_free_cpu( h_R  );
+            magma_free_cpu( V    );
+            magma_free_cpu( TAU  );
+            magma_free_cpu( T    );
+            magma_free_cpu( work );
+            magma_free_cpu( diag        );
+            magma_free_cpu( offdiag     );
+            magma_free_cpu( diag_ref    );
+            magma_free_cpu( offdiag_ref );
+
+            fflush( stdout );
+        }
+        if ( opts.niter > 1 ) {
+            printf( "\n" );
+        }
+    }
+
+    opts.cleanup();
+    TESTING_CHECK( magma_finalize() );
+    return status;
+}
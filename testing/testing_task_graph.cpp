@@ -0,0 +1,211 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Mark Gates
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+// tests internal class magma_task_graph,
+// so include task_graph.hpp and magma_internal.h instead of magma_v2.h
+#include "../control/task_graph.hpp"
+#include "../control/magma_internal.h"  // after task_graph.hpp, so max, min are defined
+
+
+/******************************************************************************/
+// warn( condition ) is like assert, but doesn't abort. Also counts number of failures.
+magma_int_t gFailures = 0;
+
+void warn_helper( int cond, const char* str, const char* file, int line )
+{
+    if ( ! cond ) {
+        printf( "*** testing_task_graph error: %s:%d: assertion %s failed\n", file, line, str );
+        gFailures += 1;
+    }
+}
+
+#define warn(x) warn_helper( (x), #x, __FILE__, __LINE__ )
+
+
+/******************************************************************************/
+// Task of a random sequential program on an array of cells:
+// cell[out] = f( id, cell[in0], cell[in1] ), with some busy work.
+// Executing the program with the graph must give the same cells as
+// executing it in order.
+struct program_op
+{
+    magma_int_t in0, in1, out, work;
+};
+
+static void do_op( const program_op& op, magma_int_t id, magma_int_t* cell )
+{
+    volatile double x = 1.0;
+    for( magma_int_t i=0; i < op.work; ++i ) {
+        x = x*0.999 + 0.001;
+    }
+    cell[ op.out ] = (cell[ op.in0 ]*31 + cell[ op.in1 ]*17 + id) % 1000003;
+}
+
+class op_task: public magma_task
+{
+public:
+    op_task( const program_op& in_op, magma_int_t in_id, magma_int_t* in_cell ):
+        op( in_op ), id( in_id ), cell( in_cell ) {}
+
+    virtual void run() { do_op( op, id, cell ); }
+
+private:
+    program_op   op;
+    magma_int_t  id;
+    magma_int_t* cell;
+};
+
+
+/******************************************************************************/
+void test_program( magma_int_t nthread, magma_int_t window )
+{
+    printf( "%%=====================================================================\n%s( nthread %lld, window %lld )\n",
+            __func__, (long long) nthread, (long long) window );
+
+    const magma_int_t ncell = 64, nop = 20000;
+    std::vector< program_op > ops( nop );
+    srand( 42 );
+    for( magma_int_t k=0; k < nop; ++k ) {
+        ops[k].in0  = rand() % ncell;
+        ops[k].in1  = rand() % ncell;
+        ops[k].out  = rand() % ncell;
+        ops[k].work = rand() % 200;
+    }
+
+    // serial reference
+    std::vector< magma_int_t > ref( ncell ), cell( ncell );
+    for( magma_int_t i=0; i < ncell; ++i ) {
+        ref[i]  = i;
+        cell[i] = i;
+    }
+    for( magma_int_t k=0; k < nop; ++k ) {
+        do_op( ops[k], k, &ref[0] );
+    }
+
+    // graph, with an acquire in the middle
+    magma_task_graph graph;
+    graph.launch( nthread, window );
+    std::vector< magma_int_t > mid( ncell );
+    for( magma_int_t k=0; k < nop; ++k ) {
+        if ( k == nop/2 ) {
+            // every cell as the serial program has it after nop/2 ops
+            for( magma_int_t i=0; i < ncell; ++i ) {
+                graph.acquire( { magma_read( &cell[i] ) });
+                mid[i] = cell[i];
+            }
+        }
+        graph.insert_task( new op_task( ops[k], k, &cell[0] ),
+                           { magma_read( &cell[ ops[k].in0 ] ),
+                             magma_read( &cell[ ops[k].in1 ] ),
+                             magma_write( &cell[ ops[k].out ] ) });
+    }
+    graph.wait();
+
+    std::vector< magma_int_t > half( ncell );
+    for( magma_int_t i=0; i < ncell; ++i ) {
+        half[i] = i;
+    }
+    for( magma_int_t k=0; k < nop/2; ++k ) {
+        do_op( ops[k], k, &half[0] );
+    }
+    magma_int_t bad = 0, bad_mid = 0;
+    for( magma_int_t i=0; i < ncell; ++i ) {
+        bad     += (cell[i] != ref[i]);
+        bad_mid += (mid[i] != half[i]);
+    }
+    warn( bad == 0 );
+    warn( bad_mid == 0 );
+}
+
+
+/******************************************************************************/
+class empty_task: public magma_task
+{
+public:
+    virtual void run() {}
+};
+
+
+// tasks/sec for independent tasks and for an nt x nt wavefront,
+// where task (i,j) depends on (i-1,j) and (i,j-1)
+void test_throughput( magma_int_t nthread )
+{
+    printf( "%%=====================================================================\n%s( nthread %lld )\n",
+            __func__, (long long) nthread );
+
+    magma_task_graph graph;
+    graph.launch( nthread, 4096 );
+
+    const magma_int_t ntask = 100000;
+    std::vector< char > cells( ntask );
+    double time = magma_wtime();
+    for( magma_int_t k=0; k < ntask; ++k ) {
+        graph.insert_task( new empty_task(), { magma_write( &cells[k] ) });
+    }
+    graph.wait();
+    time = magma_wtime() - time;
+    printf( "independent  %9lld tasks  %11.3e tasks/sec\n", (long long) ntask, ntask / time );
+
+    const magma_int_t nt = 300;
+    std::vector< char > tiles( nt*nt );
+    time = magma_wtime();
+    for( magma_int_t i=0; i < nt; ++i ) {
+        for( magma_int_t j=0; j < nt; ++j ) {
+            magma_task_dep deps[3];
+            magma_int_t ndep = 0;
+            deps[ ndep++ ] = magma_write( &tiles[ i*nt + j ] );
+            if ( i > 0 ) deps[ ndep++ ] = magma_read( &tiles[ (i-1)*nt + j ] );
+            if ( j > 0 ) deps[ ndep++ ] = magma_read( &tiles[ i*nt + j-1 ] );
+            graph.insert_task( new empty_task(), ndep, deps );
+        }
+    }
+    graph.wait();
+    time = magma_wtime() - time;
+    printf( "wavefront    %9lld tasks  %11.3e tasks/sec\n", (long long) nt*nt, nt*nt / time );
+}
+
+
+/******************************************************************************/
+int main( int argc, char** argv )
+{
+    magma_init();
+
+    magma_int_t max_nthread = magma_get_parallel_numthreads();
+    for( int i = 1; i < argc; ++i ) {
+        if ( strcmp( "--nthread", argv[i] ) == 0 && i+1 < argc ) {
+            max_nthread = atoi( argv[++i] );
+        }
+        else {
+            printf( "usage: %s [--nthread max_threads]\n", argv[0] );
+            return 1;
+        }
+    }
+    max_nthread = max( 1, max_nthread );
+
+    test_program( 1, 0 );
+    test_program( max_nthread, 0 );
+    test_program( max_nthread, 16 );
+    test_throughput( max_nthread );
+
+    if ( gFailures > 0 ) {
+        printf( "\n*** %lld tests failed.\n", (long long) gFailures );
+    }
+    else {
+        printf( "\nAll tests passed.\n" );
+    }
+
+    magma_finalize();
+    return 0;
+}
@@ -0,0 +1,390 @@
+/*
+    -- MAGMA (version 2.7.1) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date February 2023
+
+       @author Mark Gates
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <atomic>
+#include <queue>
+
+// tests internal class magma_thread_queue,
+// so include thread_queue.hpp and magma_internal.h instead of magma_v2.h
+#include "../control/thread_queue.hpp"
+#include "../control/magma_internal.h"  // after thread_queue.hpp, so max, min are defined
+
+
+/******************************************************************************/
+// warn( condition ) is like assert, but doesn't abort. Also counts number of failures.
+magma_int_t gFailures = 0;
+
+void warn_helper( int cond, const char* str, const char* file, int line )
+{
+    if ( ! cond ) {
+        printf( "*** testing_thread_queue error: %s:%d: assertion %s failed\n", file, line, str );
+        gFailures += 1;
+    }
+}
+
+#define warn(x) warn_helper( (x), #x, __FILE__, __LINE__ )
+
+
+/******************************************************************************/
+// Unit of work: a short dependent loop, so the cost is known and not optimized away.
+std::atomic< magma_int_t > gCount( 0 );
+
+static void do_work( magma_int_t work )
+{
+    volatile double x = 1.0;
+    for( magma_int_t i=0; i < work; ++i ) {
+        x = x*0.999 + 0.001;
+    }
+    gCount += 1;
+}
+
+
+/******************************************************************************/
+// Reference: a single std::queue behind one mutex and two condition variables,
+// with tasks allocated by plain new, as in magma_thread_queue of MAGMA 2.7.1.
+class mutex_task
+{
+public:
+    mutex_task( magma_int_t in_work ): work( in_work ) {}
+    void run() { do_work( work ); }
+private:
+    magma_int_t work;
+};
+
+class mutex_queue
+{
+public:
+    mutex_queue( magma_int_t in_nthread ):
+        quit_flag( false ), ntask( 0 ), nthread( in_nthread )
+    {
+        pthread_mutex_init( &mutex, NULL );
+        pthread_cond_init( &cond, NULL );
+        pthread_cond_init( &cond_ntask, NULL );
+        threads = new pthread_t[ nthread ];
+        for( magma_int_t i=0; i < nthread; ++i ) {
+            pthread_create( &threads[i], NULL, thread_main, this );
+        }
+    }
+
+    ~mutex_queue()
+    {
+        pthread_mutex_lock( &mutex );
+        quit_flag = true;
+        pthread_cond_broadcast( &cond );
+        pthread_mutex_unlock( &mutex );
+        for( magma_int_t i=0; i < nthread; ++i ) {
+            pthread_join( threads[i], NULL );
+        }
+        delete[] threads;
+        pthread_mutex_destroy( &mutex );
+        pthread_cond_destroy( &cond );
+        pthread_cond_destroy( &cond_ntask );
+    }
+
+    void push_task( mutex_task* task )
+    {
+        pthread_mutex_lock( &mutex );
+        q.push( task );
+        ntask += 1;
+        pthread_cond_broadcast( &cond );
+        pthread_mutex_unlock( &mutex );
+    }
+
+    void sync()
+    {
+        pthread_mutex_lock( &mutex );
+        while( ntask > 0 ) {
+            pthread_cond_wait( &cond_ntask, &mutex );
+        }
+        pthread_mutex_unlock( &mutex );
+    }
+
+private:
+    static void* thread_main( void* arg )
+    {
+        mutex_queue* queue = (mutex_queue*) arg;
+        while( true ) {
+            mutex_task* task = NULL;
+            pthread_mutex_lock( &queue->mutex );
+            while( queue->q.empty() && ! queue->quit_flag ) {
+                pthread_cond_wait( &queue->cond, &queue->mutex );
+            }
+            if ( ! queue->q.empty() ) {
+                task = queue->q.front();
+                queue->q.pop();
+            }
+            pthread_mutex_unlock( &queue->mutex );
+            if ( task == NULL ) {
+                break;
+            }
+            task->run();
+            delete task;
+            pthread_mutex_lock( &queue->mutex );
+            queue->ntask -= 1;
+            pthread_cond_broadcast( &queue->cond_ntask );
+            pthread_mutex_unlock( &queue->mutex );
+        }
+        return NULL;
+    }
+
+    std::queue< mutex_task* > q;
+    bool            quit_flag;
+    magma_int_t     ntask;
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    pthread_cond_t  cond_ntask;
+    pthread_t*      threads;
+    magma_int_t     nthread;
+};
+
+
+/******************************************************************************/
+class work_task: public magma_task
+{
+public:
+    work_task( magma_int_t in_work ): work( in_work ) {}
+    virtual void run() { do_work( work ); }
+private:
+    magma_int_t work;
+};
+
+
+// pushes nchild work tasks from inside a worker, exercising the workers' own deques
+class spawn_task: public magma_task
+{
+public:
+    spawn_task( magma_thread_queue* in_queue, magma_int_t in_nchild, magma_int_t in_work ):
+        queue( in_queue ), nchild( in_nchild ), work( in_work ) {}
+
+    virtual void run()
+    {
+        for( magma_int_t i=0; i < nchild; ++i ) {
+            queue->push_task( new work_task( work ));
+        }
+        do_work( work );
+    }
+private:
+    magma_thread_queue* queue;
+    magma_int_t nchild;
+    magma_int_t work;
+};
+
+
+/******************************************************************************/
+// tasks/sec of the reference mutex queue
+double bench_mutex( magma_int_t nthread, magma_int_t ntask, magma_int_t work )
+{
+    mutex_queue queue( nthread );
+    gCount = 0;
+    double time = magma_wtime();
+    for( magma_int_t i=0; i < ntask; ++i ) {
+        queue.push_task( new mutex_task( work ));
+    }
+    queue.sync();
+    time = magma_wtime() - time;
+    warn( gCount == ntask );
+    return ntask / time;
+}
+
+
+// tasks/sec of magma_thread_queue
+double bench_magma( magma_int_t nthread, magma_int_t ntask, magma_int_t work )
+{
+    magma_thread_queue queue;
+    queue.launch( nthread );
+    gCount = 0;
+    double time = magma_wtime();
+    for( magma_int_t i=0; i < ntask; ++i ) {
+        queue.push_task( new work_task( work ));
+    }
+    queue.sync();
+    time = magma_wtime() - time;
+    warn( gCount == ntask );
+    return ntask / time;
+}
+
+
+/******************************************************************************/
+void test_throughput( magma_int_t ntask, magma_int_t max_nthread )
+{
+    printf( "%%=====================================================================\n%s\n", __func__ );
+    printf( "%% ntask %lld; tasks/sec for the reference mutex queue and magma_thread_queue\n",
+            (long long) ntask );
+    printf( "%% threads    work   mutex queue   magma queue   speedup\n" );
+    printf( "%%======================================================\n" );
+    const magma_int_t works[] = { 0, 100, 1000, 10000 };
+    for( magma_int_t nthread = 1; nthread <= max_nthread; nthread *= 2 ) {
+        for( size_t w=0; w < sizeof(works)/sizeof(works[0]); ++w ) {
+            double rate_mutex = bench_mutex( nthread, ntask, works[w] );
+            double rate_magma = bench_magma( nthread, ntask, works[w] );
+            printf( "%9lld  %6lld   %11.3e   %11.3e   %7.2f\n",
+                    (long long) nthread, (long long) works[w],
+                    rate_mutex, rate_magma, rate_magma / rate_mutex );
+        }
+        if ( nthread < max_nthread && 2*nthread > max_nthread ) {
+            nthread = max_nthread/2;  // finish with max_nthread
+        }
+    }
+}
+
+
+/******************************************************************************/
+// tasks pushed by workers, repeated sync, quit with pending tasks
+void test_semantics( magma_int_t max_nthread )
+{
+    printf( "%%=====================================================================\n%s\n", __func__ );
+    magma_thread_queue queue;
+    queue.launch( max_nthread );
+
+    // several rounds of push and sync
+    for( magma_int_t round=0; round < 10; ++round ) {
+        gCount = 0;
+        for( magma_int_t i=0; i < 1000; ++i ) {
+            queue.push_task( new work_task( round*10 ));
+        }
+        queue.sync();
+        warn( gCount == 1000 );
+    }
+
+    // workers push subtasks; sync waits for them too
+    gCount = 0;
+    for( magma_int_t i=0; i < 100; ++i ) {
+        queue.push_task( new spawn_task( &queue, 50, 10 ));
+    }
+    queue.sync();
+    warn( gCount == 100*51 );
+
+    // quit runs all remaining tasks before the threads exit
+    gCount = 0;
+    for( magma_int_t i=0; i < 1000; ++i ) {
+        queue.push_task( new work_task( 100 ));
+    }
+    queue.quit();
+    warn( gCount == 1000 );
+    queue.quit();  // second quit does nothing
+}
+
+
+/******************************************************************************/
+static void* empty_main( void* arg )
+{
+    return NULL;
+}
+
+
+// launches a queue, runs a few rounds of tasks, and quits, nround times
+struct relaunch_args
+{
+    magma_int_t nthread;
+    magma_int_t nround;
+};
+
+static void* relaunch_main( void* arg )
+{
+    relaunch_args* args = (relaunch_args*) arg;
+    for( magma_int_t round=0; round < args->nround; ++round ) {
+        magma_thread_queue queue;
+        queue.launch( args->nthread );
+        for( magma_int_t i=0; i < 100; ++i ) {
+            queue.push_task( new work_task( 10 ));
+        }
+        queue.quit();
+    }
+    return NULL;
+}
+
+
+/******************************************************************************/
+// Repeated launch and quit reuse workers from the pool, instead of creating
+// threads. Queues launched concurrently from several threads get their own
+// workers.
+void test_relaunch( magma_int_t max_nthread )
+{
+    printf( "%%=====================================================================\n%s\n", __func__ );
+    const magma_int_t nround = 1000;
+
+    // reference: create and join max_nthread threads per round
+    pthread_t* threads = new pthread_t[ max_nthread ];
+    double time_create = magma_wtime();
+    for( magma_int_t round=0; round < nround; ++round ) {
+        for( magma_int_t i=0; i < max_nthread; ++i ) {
+            pthread_create( &threads[i], NULL, empty_main, NULL );
+        }
+        for( magma_int_t i=0; i < max_nthread; ++i ) {
+            pthread_join( threads[i], NULL );
+        }
+    }
+    time_create = (magma_wtime() - time_create) / nround;
+    delete[] threads;
+
+    relaunch_args args = { max_nthread, nround };
+    gCount = 0;
+    double time_launch = magma_wtime();
+    relaunch_main( &args );
+    time_launch = (magma_wtime() - time_launch) / nround;
+    warn( gCount == 100*nround );
+
+    printf( "%% threads   create+join (us)   launch+100 tasks+quit (us)\n" );
+    printf( "%9lld   %16.2f   %26.2f\n",
+            (long long) max_nthread, time_create*1e6, time_launch*1e6 );
+
+    // concurrent queues, each on its part of the threads
+    const magma_int_t nqueue = 4;
+    pthread_t callers[ nqueue ];
+    relaunch_args part = { max( 1, max_nthread / nqueue ), 100 };
+    gCount = 0;
+    for( magma_int_t q=0; q < nqueue; ++q ) {
+        pthread_create( &callers[q], NULL, relaunch_main, &part );
+    }
+    for( magma_int_t q=0; q < nqueue; ++q ) {
+        pthread_join( callers[q], NULL );
+    }
+    warn( gCount == nqueue*100*part.nround );
+}
+
+
+/******************************************************************************/
+int main( int argc, char** argv )
+{
+    magma_init();
+
+    magma_int_t ntask = 100000;
+    magma_int_t max_nthread = magma_get_parallel_numthreads();
+    for( int i = 1; i < argc; ++i ) {
+        if ( strcmp( "-n", argv[i] ) == 0 && i+1 < argc ) {
+            ntask = atoi( argv[++i] );
+        }
+        else if ( strcmp( "--nthread", argv[i] ) == 0 && i+1 < argc ) {
+            max_nthread = atoi( argv[++i] );
+        }
+        else {
+            printf( "usage: %s [-n ntask] [--nthread max_threads]\n", argv[0] );
+            return 1;
+        }
+    }
+    max_nthread = max( 1, max_nthread );
+
+    test_semantics( max_nthread );
+    test_relaunch( max_nthread );
+    test_throughput( ntask, max_nthread );
+
+    if ( gFailures > 0 ) {
+        printf( "\n*** %lld tests failed.\n", (long long) gFailures );
+    }
+    else {
+        printf( "\nAll tests passed.\n" );
+    }
+
+    magma_finalize();
+    return 0;
+}